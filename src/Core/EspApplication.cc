@@ -8,30 +8,74 @@ namespace esp
   EspApplication::EspApplication(EspApplicationParams params) : m_running(true)
 
   {
-    // create (alloc and init) window
-    m_window = EspWindow::create(new EspWindow::WindowData(params.m_title,
-                                                           params.m_width,
-                                                           params.m_height,
-                                                           params.m_disable_cursor,
-                                                           params.m_presentation_mode));
-    m_window->set_events_manager_fun(ESP_BIND_EVENT_FOR_FUN(EspApplication::events_manager));
-
-    // create (alloc and init) timer
+    // create (alloc and init) window, there is none in headless mode
+    if (!params.m_headless)
+    {
+      m_window = EspWindow::create(new EspWindow::WindowData(params.m_title,
+                                                             params.m_width,
+                                                             params.m_height,
+                                                             params.m_disable_cursor,
+                                                             params.m_presentation_mode));
+      m_window->set_events_manager_fun(ESP_BIND_EVENT_FOR_FUN(EspApplication::events_manager));
+    }
+
+    // create (alloc and init) timer and frame limiter
     m_timer = Timer::create();
+    if (params.m_pace_to_display && m_window)
+    {
+      // unknown refresh rate leaves the frames unlimited
+      bool fifo       = params.m_presentation_mode == EspPresentationMode::ESP_PRESENT_MODE_FIFO_KHR;
+      m_frame_limiter = FrameLimiter::create(static_cast<float>(m_window->get_refresh_rate()), fifo);
+    }
+    else { m_frame_limiter = FrameLimiter::create(params.m_target_frame_rate); }
+
+    // optional, created before other systems so their initialization is measured as well
+    if (params.m_cpu_profiling)
+    {
+      m_profiler = Profiler::create(params.m_cpu_trace_path, params.m_frame_histogram_path);
+      ESP_PROFILE_THREAD("Main");
+    }
+
+    // create job system, so every other system can use it
+    uint32_t job_workers = params.m_job_workers ? params.m_job_workers : JobSystem::get_default_worker_count();
+    m_job_system         = JobSystem::create(job_workers);
+#if ESP_PROFILING
+    if (m_profiler)
+    {
+      JobSystem::set_profiling_hook({ [](const char* name, uint32_t) { Profiler::begin_zone(name); },
+                                      [](const char*, uint32_t) { Profiler::end_zone(); } });
+    }
+#endif
 
     // set temporary m_renderer struct
-    m_debug_messenger           = EspDebugMessenger::create();
-    m_renderer.m_render_context = EspRenderContext::build(*m_window);
+    m_debug_messenger = EspDebugMessenger::create();
+    if (params.m_headless)
+    {
+      m_renderer.m_render_context = EspRenderContext::build_headless(params.m_width,
+                                                                     params.m_height,
+                                                                     params.m_pipeline_cache_path,
+                                                                     params.m_frames_in_flight);
+    }
+    else
+    {
+      m_renderer.m_render_context =
+          EspRenderContext::build(*m_window, params.m_pipeline_cache_path, params.m_frames_in_flight);
+    }
     m_debug_messenger->init();
 
-    m_renderer.m_work_orchestrator = EspWorkOrchestrator::build(params.m_presentation_mode);
+    m_renderer.m_work_orchestrator = EspWorkOrchestrator::build(params.m_presentation_mode, params.m_frame_pacing);
     m_renderer.m_jobs              = EspJob::build();
 
     // create basic systems
-    m_resource_system = ResourceSystem::create(s_asset_base_path);
-    m_texture_system  = TextureSystem::create();
-    m_shader_system   = ShaderSystem::create();
-    m_material_system = MaterialSystem::create();
+    m_pipeline_compiler = EspPipelineCompiler::create();
+    m_resource_system   = ResourceSystem::create(s_asset_base_path);
+    m_texture_system    = TextureSystem::create();
+    m_shader_system     = ShaderSystem::create();
+    m_material_system   = MaterialSystem::create();
+
+    // optional, materials created before it wouldn't be bindless
+    if (params.m_bindless_textures) { m_bindless_textures = EspBindlessTextures::create(); }
+    if (params.m_gpu_profiling) { m_gpu_profiler = EspGpuProfiler::create(params.m_gpu_trace_path); }
 
     // create (alloc and init) layer stacks
     m_layer_stack = new LayerStack();
@@ -43,12 +87,24 @@ namespace esp
     // before making free other resources.
     m_renderer.done_all_jobs();
 
+    auto& frame_stats = m_frame_limiter->get_stats();
+    ESP_CORE_INFO("{} frames took {:.2f} ms on average (standard deviation {:.2f} ms), {} missed their deadline.",
+                  frame_stats.m_frame_count,
+                  frame_stats.m_mean_frame_time,
+                  frame_stats.get_standard_deviation(),
+                  frame_stats.m_missed_deadlines);
+
     // [1] resources from layers should be deleted because they may depend on
     // other resources allocated by Application.
     delete m_layer_stack;
 
-    // [2] terminate all systems
+    // [2] terminate all systems, job system first as pending jobs may still use the other ones
+    m_job_system->terminate();
+    m_pipeline_compiler->terminate();
     m_material_system->terminate();
+    if (m_bindless_textures) { m_bindless_textures->terminate(); }
+    if (m_gpu_profiler) { m_gpu_profiler->terminate(); }
+    if (m_profiler) { m_profiler->terminate(); }
     m_shader_system->terminate();
     m_texture_system->terminate();
     m_resource_system->terminate();
@@ -58,7 +114,7 @@ namespace esp
     m_renderer.terminate();
 
     // [4] Window instance has to be killed
-    m_window->terminate();
+    if (m_window) { m_window->terminate(); }
 
     // the last one is Application context to be killed (implicitely)
   }
@@ -67,10 +123,13 @@ namespace esp
   {
     while (m_running)
     {
+      // sleeps until the next frame is due instead of spinning
+      m_frame_limiter->wait();
       m_timer->tick();
-      if (m_timer->get_dt() < ESP_MIN_FRAME_RATE) continue;
       m_timer->reset();
 
+      ESP_PROFILE_SCOPE("EspApplication::run");
+
       this->update(m_timer->get_dt());
       if (!m_running) break;
 
@@ -78,12 +137,16 @@ namespace esp
 
       for (auto layer : *m_layer_stack)
       {
+        ESP_PROFILE_SCOPE("Layer::update");
         layer->update(m_timer->get_dt());
       }
 
       m_renderer.m_work_orchestrator->end_frame();
 
-      m_window->update();
+      if (m_window) { m_window->update(); }
+
+      // collects zones of all threads, the frame's own zone is collected with the next one
+      Profiler::end_frame();
     }
   }
 
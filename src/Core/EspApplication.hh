@@ -11,12 +11,18 @@
 #include "EspApplicationParams.hh"
 #include "EspWindow.hh"
 #include "Events/WindowEvent.hh"
+#include "Jobs/JobSystem.hh"
 #include "Layers/Layer.hh"
 #include "Layers/LayerStack.hh"
 #include "RenderAPI/EspDebugMessenger.hh"
 #include "RenderAPI/EspRenderContext.hh"
+#include "RenderAPI/Resources/EspBindlessTextures.hh"
+#include "RenderAPI/Work/EspGpuProfiler.hh"
 #include "RenderAPI/Work/EspJob.hh"
 #include "RenderAPI/Work/EspWorkOrchestrator.hh"
+#include "RenderAPI/Worker/EspPipelineCompiler.hh"
+#include "Utils/FrameLimiter.hh"
+#include "Utils/Profiler.hh"
 #include "Utils/Timer.hh"
 
 namespace esp
@@ -29,10 +35,16 @@ namespace esp
     std::unique_ptr<EspApplicationContext> m_context;
     std::unique_ptr<EspWindow> m_window;
     std::unique_ptr<Timer> m_timer;
+    std::unique_ptr<FrameLimiter> m_frame_limiter;
+    std::unique_ptr<Profiler> m_profiler;
+    std::unique_ptr<JobSystem> m_job_system;
 
     std::unique_ptr<EspDebugMessenger> m_debug_messenger;
+    std::unique_ptr<EspPipelineCompiler> m_pipeline_compiler;
     std::unique_ptr<ResourceSystem> m_resource_system;
     std::unique_ptr<TextureSystem> m_texture_system;
+    std::unique_ptr<EspBindlessTextures> m_bindless_textures;
+    std::unique_ptr<EspGpuProfiler> m_gpu_profiler;
     std::unique_ptr<ShaderSystem> m_shader_system;
     std::unique_ptr<MaterialSystem> m_material_system;
 
@@ -93,6 +105,10 @@ namespace esp
     /// @brief Handle event by the event manager.
     /// @param e Event to be handled.
     void events_manager(Event& e);
+
+    /// @brief Returns frame times measured by the frame limiter, e.g. to report missed deadlines.
+    /// @return Frame times measured so far.
+    inline const FrameLimiterStats& get_frame_stats() const { return m_frame_limiter->get_stats(); }
   };
 
   /* This function is defined by CLIENT */
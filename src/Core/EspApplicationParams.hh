@@ -19,6 +19,16 @@ namespace esp
     ESP_PRESENT_MODE_FIFO_KHR = 2,
   };
 
+  /// @brief Represents how far the CPU may get ahead of the GPU
+  enum EspFramePacingMode
+  {
+    /// @brief CPU records a new frame as long as one of the frames in flight is free. Gives the best throughput.
+    ESP_FRAME_PACING_THROUGHPUT = 0,
+    /// @brief CPU waits for the previous frame before recording a new one, so input is sampled as late as possible.
+    /// Trades throughput for latency, as the CPU and the GPU don't work on different frames at once.
+    ESP_FRAME_PACING_LOW_LATENCY = 1,
+  };
+
   /// @brief Application set up parameters.
   struct EspApplicationParams
   {
@@ -32,6 +42,39 @@ namespace esp
     bool m_disable_cursor = false;
     /// @brief Presentation mode used for displaying images to the screen
     EspPresentationMode m_presentation_mode = EspPresentationMode::ESP_PRESENT_MODE_FIFO_KHR;
+    /// @brief Number of worker threads of the job system. 0 means one less than number of hardware threads.
+    uint32_t m_job_workers = 0;
+    /// @brief File where compiled pipelines are kept between runs. Empty path disables the file.
+    fs::path m_pipeline_cache_path = "pipeline_cache.bin";
+    /// @brief Keeps textures of all materials in one array indexed by bindless shaders (EspBindlessTextures). Ignored
+    /// if the device doesn't support it.
+    bool m_bindless_textures = false;
+    /// @brief Number of frames the CPU may record while the GPU still works on the previous ones. Clamped to 1-4.
+    uint32_t m_frames_in_flight = 2;
+    /// @brief How far the CPU may get ahead of the GPU.
+    EspFramePacingMode m_frame_pacing = EspFramePacingMode::ESP_FRAME_PACING_THROUGHPUT;
+    /// @brief Renders into offscreen images of m_width x m_height without creating a window or a swap chain, e.g. on
+    /// servers or in CI. Finished frames are passed to EspWorkOrchestrator::set_readback_callback(). The application
+    /// stops when m_running is cleared.
+    bool m_headless = false;
+    /// @brief Measures GPU time of render plans and other profiler scopes (EspGpuProfiler). Ignored if the device
+    /// can't write timestamps.
+    bool m_gpu_profiling = false;
+    /// @brief File GPU timings of every frame are written to in Chrome trace format. Empty path disables the file.
+    fs::path m_gpu_trace_path = {};
+    /// @brief Frames per second the application loop is limited to, without busy-waiting. 0 disables the limit.
+    float m_target_frame_rate = 60.f;
+    /// @brief Paces frames to the display instead of m_target_frame_rate. With ESP_PRESENT_MODE_FIFO_KHR presentation
+    /// already waits for the display, so frames are only measured, other modes are limited to the monitor's refresh
+    /// rate. Ignored in headless mode.
+    bool m_pace_to_display = false;
+    /// @brief Measures frame times and CPU zones of ESP_PROFILE_SCOPE() (Profiler). Zones are compiled out in release
+    /// unless ESP_PROFILING is enabled, the frame time histogram is kept in every build.
+    bool m_cpu_profiling = false;
+    /// @brief File CPU zones are written to in Chrome trace format. Empty path disables the file.
+    fs::path m_cpu_trace_path = {};
+    /// @brief File the frame time histogram is written to on exit, as CSV. Empty path disables the file.
+    fs::path m_frame_histogram_path = {};
   };
 
 } // namespace esp
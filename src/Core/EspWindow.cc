@@ -72,6 +72,16 @@ namespace esp
 
   void EspWindow::update() { glfwPollEvents(); }
 
+  uint32_t EspWindow::get_refresh_rate() const
+  {
+    auto monitor = glfwGetWindowMonitor(m_window);
+    if (!monitor) { monitor = glfwGetPrimaryMonitor(); }
+    if (!monitor) { return 0; }
+
+    auto mode = glfwGetVideoMode(monitor);
+    return mode ? static_cast<uint32_t>(mode->refreshRate) : 0;
+  }
+
   void EspWindow::set_callbacks()
   {
     /* set callbacks for glfw events */
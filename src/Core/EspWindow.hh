@@ -88,6 +88,10 @@ namespace esp
     /// @return Window's height.
     inline uint32_t get_height() { return m_data->m_height; }
 
+    /// @brief Returns refresh rate of the monitor showing the window (the primary one for windowed mode).
+    /// @return Refresh rate in Hz. 0 if it's unknown.
+    uint32_t get_refresh_rate() const;
+
     /// @brief Returns pointer to the window.
     /// @return Pointer to the window.
     inline GLFWwindow* get_window() const { return m_window; }
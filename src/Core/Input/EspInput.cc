@@ -6,6 +6,9 @@ namespace esp
 {
   bool EspInput::is_key_pressed(int keycode)
   {
+    // there is no window in headless mode
+    if (!EspWindow::get_instance()) { return false; }
+
     auto window = EspWindow::get_instance()->get_window();
     auto state  = glfwGetKey(window, keycode);
 
@@ -14,6 +17,8 @@ namespace esp
 
   bool EspInput::is_mouse_button_pressed(int button)
   {
+    if (!EspWindow::get_instance()) { return false; }
+
     auto window = EspWindow::get_instance()->get_window();
     auto state  = glfwGetMouseButton(window, button);
 
@@ -22,6 +27,8 @@ namespace esp
 
   float EspInput::get_mouse_x()
   {
+    if (!EspWindow::get_instance()) { return 0.0f; }
+
     auto window = EspWindow::get_instance()->get_window();
     double x_pos, y_pos;
 
@@ -32,6 +39,8 @@ namespace esp
 
   float EspInput::get_mouse_y()
   {
+    if (!EspWindow::get_instance()) { return 0.0f; }
+
     auto window = EspWindow::get_instance()->get_window();
     double x_pos, y_pos;
 
@@ -0,0 +1,262 @@
+#include "JobSystem.hh"
+
+// number of failed steal rounds before a worker goes to sleep
+static constexpr uint32_t SPIN_COUNT = 64;
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  JobSystem* JobSystem::s_instance                 = nullptr;
+  thread_local uint32_t JobSystem::s_worker_index = 0;
+
+  JobSystem::JobSystem(uint32_t worker_count)
+  {
+    if (JobSystem::s_instance != nullptr) { throw std::runtime_error("The job system instance already exists!"); }
+
+    JobSystem::s_instance = this;
+
+    // queue 0 belongs to the main thread (and to any thread that isn't a worker)
+    for (uint32_t i = 0; i <= worker_count; i++)
+    {
+      m_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    for (uint32_t i = 1; i <= worker_count; i++)
+    {
+      m_workers.emplace_back(&JobSystem::worker_loop, this, i);
+    }
+  }
+
+  JobSystem::~JobSystem()
+  {
+    if (s_instance) { terminate(); }
+  }
+
+  std::unique_ptr<JobSystem> JobSystem::create(uint32_t worker_count)
+  {
+    auto job_system = std::unique_ptr<JobSystem>(new JobSystem(worker_count));
+
+    ESP_CORE_TRACE("Job system initialized with {} workers.", worker_count);
+
+    return job_system;
+  }
+
+  void JobSystem::terminate()
+  {
+    // workers leave only when there is nothing left to do
+    {
+      std::lock_guard<std::mutex> lock(m_sleep_mutex);
+      m_running = false;
+    }
+    m_wake_up.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+      worker.join();
+    }
+    m_workers.clear();
+
+    // jobs pushed by the main thread after the workers left
+    while (try_execute_one(0)) {}
+
+    JobSystem::s_instance = nullptr;
+    ESP_CORE_TRACE("Job system shutdown.");
+  }
+
+  void JobSystem::run(JobFunction function, JobCounter* counter, const char* name)
+  {
+    if (counter) { counter->m_value++; }
+
+    Job job = { std::move(function), counter, name };
+    if (s_instance) { s_instance->push(std::move(job)); }
+    else { execute(job); }
+  }
+
+  void JobSystem::run_after(JobCounter& dependency, JobFunction function, JobCounter* counter, const char* name)
+  {
+    if (counter) { counter->m_value++; }
+
+    Job job = { std::move(function), counter, name };
+    {
+      // the counter is decremented under the same lock, so the job can't be missed by finish()
+      std::lock_guard<std::mutex> lock(dependency.m_mutex);
+      if (dependency.m_value > 0)
+      {
+        dependency.m_continuations.push_back(std::move(job));
+        return;
+      }
+    }
+
+    if (s_instance) { s_instance->push(std::move(job)); }
+    else { execute(job); }
+  }
+
+  void JobSystem::wait(JobCounter& counter)
+  {
+    while (counter.m_value > 0)
+    {
+      if (!s_instance || !s_instance->try_execute_one(s_worker_index)) { std::this_thread::yield(); }
+    }
+
+    // finish() may still hold the lock after the last decrement, the counter can't be destroyed before it's released
+    std::lock_guard<std::mutex> lock(counter.m_mutex);
+  }
+
+  void JobSystem::parallel_for(uint32_t count,
+                               uint32_t batch_size,
+                               const std::function<void(uint32_t begin, uint32_t end)>& function,
+                               const char* name)
+  {
+    if (count == 0) { return; }
+    batch_size = std::max(batch_size, 1u);
+
+    JobCounter counter;
+    for (uint32_t begin = 0; begin < count; begin += batch_size)
+    {
+      uint32_t end = std::min(begin + batch_size, count);
+      run([&function, begin, end]() { function(begin, end); }, &counter, name);
+    }
+
+    wait(counter);
+  }
+
+  void JobSystem::set_profiling_hook(JobProfilingHook hook)
+  {
+    ESP_ASSERT(s_instance != nullptr, "The job system doesn't exist!")
+    s_instance->m_profiling_hook = std::move(hook);
+  }
+
+  uint32_t JobSystem::get_thread_count()
+  {
+    return s_instance ? static_cast<uint32_t>(s_instance->m_queues.size()) : 1;
+  }
+
+  JobSystemStats JobSystem::get_stats()
+  {
+    if (!s_instance) { return {}; }
+    return { s_instance->m_executed.load(), s_instance->m_stolen.load() };
+  }
+
+  uint32_t JobSystem::get_default_worker_count()
+  {
+    uint32_t hardware_threads = std::thread::hardware_concurrency();
+    return hardware_threads > 1 ? hardware_threads - 1 : 1;
+  }
+
+  void JobSystem::push(Job job)
+  {
+    auto& queue = *m_queues[s_worker_index];
+    {
+      std::lock_guard<std::mutex> lock(queue.m_mutex);
+      queue.m_jobs.push_back(std::move(job));
+    }
+    m_pending++;
+
+    // sleeping counter is increased before a worker checks for pending jobs, so either the worker sees the job or
+    // the job is followed by a notification
+    if (m_sleeping > 0)
+    {
+      std::lock_guard<std::mutex> lock(m_sleep_mutex);
+      m_wake_up.notify_one();
+    }
+  }
+
+  bool JobSystem::try_execute_one(uint32_t index)
+  {
+    Job job;
+    bool found = false;
+
+    // own queue is used as a stack - the newest job has the hottest data
+    {
+      auto& queue = *m_queues[index];
+      std::lock_guard<std::mutex> lock(queue.m_mutex);
+      if (!queue.m_jobs.empty())
+      {
+        job = std::move(queue.m_jobs.back());
+        queue.m_jobs.pop_back();
+        found = true;
+      }
+    }
+
+    // other queues are used as FIFOs - the oldest jobs usually spawn the most work
+    for (size_t i = 1; !found && i < m_queues.size(); i++)
+    {
+      auto& queue = *m_queues[(index + i) % m_queues.size()];
+      std::lock_guard<std::mutex> lock(queue.m_mutex);
+      if (!queue.m_jobs.empty())
+      {
+        job = std::move(queue.m_jobs.front());
+        queue.m_jobs.pop_front();
+        found = true;
+        m_stolen++;
+      }
+    }
+
+    if (!found) { return false; }
+
+    m_pending--;
+    execute(job);
+    return true;
+  }
+
+  void JobSystem::worker_loop(uint32_t index)
+  {
+    s_worker_index = index;
+    ESP_PROFILE_THREAD("Job worker " + std::to_string(index));
+
+    uint32_t failed_rounds = 0;
+    while (true)
+    {
+      if (try_execute_one(index))
+      {
+        failed_rounds = 0;
+        continue;
+      }
+
+      if (!m_running && m_pending <= 0) { break; }
+
+      if (++failed_rounds < SPIN_COUNT)
+      {
+        std::this_thread::yield();
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(m_sleep_mutex);
+      m_sleeping++;
+      m_wake_up.wait(lock, [this]() { return m_pending > 0 || !m_running; });
+      m_sleeping--;
+      failed_rounds = 0;
+    }
+  }
+
+  void JobSystem::execute(Job& job)
+  {
+    auto* hook = s_instance ? &s_instance->m_profiling_hook : nullptr;
+    if (hook && hook->m_on_begin) { hook->m_on_begin(job.m_name, s_worker_index); }
+
+    job.m_function();
+
+    if (hook && hook->m_on_end) { hook->m_on_end(job.m_name, s_worker_index); }
+    if (s_instance) { s_instance->m_executed++; }
+
+    if (job.m_counter) { finish(*job.m_counter); }
+  }
+
+  void JobSystem::finish(JobCounter& counter)
+  {
+    std::vector<Job> ready;
+    {
+      std::lock_guard<std::mutex> lock(counter.m_mutex);
+      if (--counter.m_value == 0) { ready.swap(counter.m_continuations); }
+    }
+
+    for (auto& job : ready)
+    {
+      if (s_instance) { s_instance->push(std::move(job)); }
+      else { execute(job); }
+    }
+  }
+} // namespace esp
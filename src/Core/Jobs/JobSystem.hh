@@ -0,0 +1,174 @@
+#ifndef CORE_JOBS_JOB_SYSTEM_HH
+#define CORE_JOBS_JOB_SYSTEM_HH
+
+#include "esppch.hh"
+
+// std
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace esp
+{
+  class JobCounter;
+
+  using JobFunction = std::function<void()>;
+
+  /// @brief Single unit of work executed by the JobSystem.
+  struct Job
+  {
+    /// @brief Work to be done.
+    JobFunction m_function;
+    /// @brief Counter decremented after the job is done, may be nullptr.
+    JobCounter* m_counter = nullptr;
+    /// @brief Name passed to the profiling hook.
+    const char* m_name = "job";
+  };
+
+  /// @brief Number of unfinished jobs. Jobs can wait for it or be scheduled to start when it reaches zero.
+  class JobCounter
+  {
+   private:
+    std::atomic<uint32_t> m_value = 0;
+    std::mutex m_mutex;
+    std::vector<Job> m_continuations;
+
+   public:
+    /// @brief Creates counter with no unfinished jobs.
+    JobCounter() = default;
+    /// @brief Default destructor. Counter mustn't be destroyed before JobSystem::wait() returns.
+    ~JobCounter() = default;
+
+    PREVENT_COPY(JobCounter);
+
+    /// @brief Returns number of unfinished jobs.
+    /// @return Number of unfinished jobs.
+    inline uint32_t get_value() const { return m_value.load(); }
+
+    friend class JobSystem;
+  };
+
+  /// @brief Callbacks invoked on the executing thread around every job.
+  struct JobProfilingHook
+  {
+    /// @brief Called before the job starts.
+    std::function<void(const char* name, uint32_t worker_index)> m_on_begin;
+    /// @brief Called after the job finished.
+    std::function<void(const char* name, uint32_t worker_index)> m_on_end;
+  };
+
+  /// @brief Counters describing work done by the JobSystem since it was created.
+  struct JobSystemStats
+  {
+    /// @brief Number of executed jobs.
+    uint64_t m_executed = 0;
+    /// @brief Number of jobs taken from other thread's queue.
+    uint64_t m_stolen = 0;
+  };
+
+  /// @brief Work-stealing scheduler of CPU jobs. Every worker thread (and the thread that created the system) owns a
+  /// queue. Jobs are pushed to the queue of the submitting thread and popped from its back, idle threads steal from
+  /// the front of other queues. Waiting threads execute jobs instead of blocking. (Not to be confused with EspJob,
+  /// which records GPU commands.)
+  ///
+  /// When the system doesn't exist all jobs are executed immediately on the calling thread.
+  class JobSystem
+  {
+   private:
+    struct WorkerQueue
+    {
+      std::mutex m_mutex;
+      std::deque<Job> m_jobs;
+    };
+
+    static JobSystem* s_instance;
+    static thread_local uint32_t s_worker_index;
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+
+    std::atomic<int32_t> m_pending  = 0;
+    std::atomic<int32_t> m_sleeping = 0;
+    std::atomic<bool> m_running     = true;
+    std::mutex m_sleep_mutex;
+    std::condition_variable m_wake_up;
+
+    std::atomic<uint64_t> m_executed = 0;
+    std::atomic<uint64_t> m_stolen   = 0;
+
+    JobProfilingHook m_profiling_hook;
+
+    JobSystem(uint32_t worker_count);
+
+   public:
+    /// @brief Terminates JobSystem.
+    ~JobSystem();
+
+    PREVENT_COPY(JobSystem);
+
+    /// @brief Creates JobSystem singleton instance and starts worker threads.
+    /// @param worker_count Number of worker threads. By default one less than number of hardware threads, because
+    /// the main thread executes jobs as well.
+    /// @return Unique pointer to JobSystem instance.
+    static std::unique_ptr<JobSystem> create(uint32_t worker_count = get_default_worker_count());
+
+    /// @brief Finishes all pending jobs, stops worker threads and destroys JobSystem instance.
+    void terminate();
+
+    /// @brief Schedules job.
+    /// @param function Work to be done.
+    /// @param counter Counter incremented now and decremented when the job is done, may be nullptr.
+    /// @param name Name passed to the profiling hook.
+    static void run(JobFunction function, JobCounter* counter = nullptr, const char* name = "job");
+    /// @brief Schedules job that starts when the dependency counter reaches zero.
+    /// @param dependency Counter of jobs that have to finish first.
+    /// @param function Work to be done.
+    /// @param counter Counter incremented now and decremented when the job is done, may be nullptr.
+    /// @param name Name passed to the profiling hook.
+    static void run_after(JobCounter& dependency,
+                          JobFunction function,
+                          JobCounter* counter = nullptr,
+                          const char* name    = "job");
+    /// @brief Executes other jobs until the counter reaches zero.
+    /// @param counter Counter to wait for.
+    static void wait(JobCounter& counter);
+    /// @brief Splits range into batches, executes them as jobs and waits for all of them.
+    /// @param count Number of elements.
+    /// @param batch_size Number of elements processed by a single job.
+    /// @param function Called with [begin, end) range of every batch.
+    /// @param name Name passed to the profiling hook.
+    static void parallel_for(uint32_t count,
+                             uint32_t batch_size,
+                             const std::function<void(uint32_t begin, uint32_t end)>& function,
+                             const char* name = "parallel_for");
+
+    /// @brief Sets callbacks invoked around every job. Shouldn't be changed while jobs are running.
+    /// @param hook Profiling callbacks.
+    static void set_profiling_hook(JobProfilingHook hook);
+
+    /// @brief Returns number of threads executing jobs (workers and the main thread).
+    /// @return Number of threads executing jobs. 1 if JobSystem doesn't exist.
+    static uint32_t get_thread_count();
+    /// @brief Returns index of the calling thread. 0 for the main thread and threads that aren't workers.
+    /// @return Index of the calling thread.
+    inline static uint32_t get_worker_index() { return s_worker_index; }
+    /// @brief Returns statistics of the JobSystem.
+    /// @return Statistics of the JobSystem.
+    static JobSystemStats get_stats();
+    /// @brief Returns number of workers used when none is given.
+    /// @return One less than number of hardware threads (at least 1).
+    static uint32_t get_default_worker_count();
+
+   private:
+    void push(Job job);
+    bool try_execute_one(uint32_t index);
+    void worker_loop(uint32_t index);
+
+    static void execute(Job& job);
+    static void finish(JobCounter& counter);
+  };
+} // namespace esp
+
+#endif // CORE_JOBS_JOB_SYSTEM_HH
@@ -5,13 +5,33 @@
 
 namespace esp
 {
-  std::unique_ptr<EspRenderContext> EspRenderContext::build(EspWindow& window)
+  std::unique_ptr<EspRenderContext> EspRenderContext::build(EspWindow& window,
+                                                           const fs::path& pipeline_cache_path,
+                                                           uint32_t frames_in_flight)
   {
     /* ---------------------------------------------------------*/
     /* ------------- PLATFORM DEPENDENT ------------------------*/
     /* ---------------------------------------------------------*/
 #if ESP_USE_VULKAN
-    auto context = VulkanContext::create(window);
+    auto context = VulkanContext::create(window, pipeline_cache_path, frames_in_flight);
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+
+    return context;
+  }
+
+  std::unique_ptr<EspRenderContext> EspRenderContext::build_headless(uint32_t width,
+                                                                    uint32_t height,
+                                                                    const fs::path& pipeline_cache_path,
+                                                                    uint32_t frames_in_flight)
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    auto context = VulkanContext::create_headless(width, height, pipeline_cache_path, frames_in_flight);
 #else
 #error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
 #endif
@@ -21,7 +21,14 @@ namespace esp
 
     /* -------------------------- STATIC METHODS --------------------------- */
    public:
-    static std::unique_ptr<EspRenderContext> build(EspWindow& window);
+    static std::unique_ptr<EspRenderContext> build(EspWindow& window,
+                                                   const fs::path& pipeline_cache_path = {},
+                                                   uint32_t frames_in_flight          = 2);
+    // Builds context without a window and a swap chain. Frames are rendered into offscreen images of given size.
+    static std::unique_ptr<EspRenderContext> build_headless(uint32_t width,
+                                                            uint32_t height,
+                                                            const fs::path& pipeline_cache_path = {},
+                                                            uint32_t frames_in_flight          = 2);
   };
 
   void render_context_glfw_hints();
@@ -37,6 +37,7 @@ namespace esp
     virtual inline uint32_t get_height() const { return m_height; }
     virtual inline glm::vec3 get_clear_color() const { return m_clear_color; }
     virtual inline EspSampleCountFlag get_sample_count_flag() { return m_sample_count_flag; }
+    virtual inline EspBlockFormat get_format() const { return m_format; }
 
     virtual std::shared_ptr<EspTexture> use_as_texture() const = 0;
 
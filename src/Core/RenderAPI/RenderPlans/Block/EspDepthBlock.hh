@@ -38,6 +38,7 @@ namespace esp
     virtual inline uint32_t get_height() const { return m_height; }
     virtual inline EspSampleCountFlag get_sample_count_flag() { return m_sample_count_flag; }
     virtual inline EspImageUsageFlag get_image_usage_flag() { return m_image_usage_flag; }
+    virtual inline EspDepthBlockFormat get_format() const { return m_format; }
 
     /* -------------------------- STATIC METHODS --------------------------- */
    public:
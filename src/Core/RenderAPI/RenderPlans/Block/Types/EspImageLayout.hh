@@ -13,6 +13,7 @@ namespace esp
   enum class EspImageLayout
   {
     ESP_IMAGE_LAYOUT_UNDEFINED                = 0,
+    ESP_IMAGE_LAYOUT_GENERAL                  = 1,
     ESP_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL = 2,
     ESP_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL = 5,
     ESP_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL     = 6,
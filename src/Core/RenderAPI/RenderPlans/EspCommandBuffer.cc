@@ -29,6 +29,20 @@ namespace esp
         static_cast<VulkanCommandBufferId*>(command_buffer_id.get())->m_command_buffer);
 #else
 #error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    //     /* ---------------------------------------------------------*/
+  }
+
+  void EspCommandBuffer::end_secondary(EspCommandBufferId* command_buffer_id)
+  {
+    //     /* ---------------------------------------------------------*/
+    //     /* ------------- PLATFORM DEPENDENT ------------------------*/
+    //     /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    VulkanWorkOrchestrator::end_secondary_command_buffer(
+        static_cast<VulkanCommandBufferId*>(command_buffer_id)->m_command_buffer);
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
 #endif
     //     /* ---------------------------------------------------------*/
   }
@@ -15,6 +15,10 @@ namespace esp
    public:
     static std::unique_ptr<EspCommandBufferId> begin_only_once();
     static void end_only_once(std::unique_ptr<EspCommandBufferId> command_buffer_id);
+
+    // Secondary command buffers are begun by EspRenderPlan::begin_secondary() on the recording thread. They are
+    // owned by the calling thread's command pool and stay valid until the same frame index is begun again.
+    static void end_secondary(EspCommandBufferId* command_buffer_id);
   };
 } // namespace esp
 
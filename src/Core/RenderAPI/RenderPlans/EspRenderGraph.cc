@@ -0,0 +1,460 @@
+#include "EspRenderGraph.hh"
+
+#include "Platform/Vulkan/RenderPlans/VulkanRenderGraph.hh"
+
+// signatures
+static bool is_write(esp::EspRenderGraphAccess access);
+static uint64_t align_up(uint64_t value, uint64_t alignment);
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  EspRenderGraphPass& EspRenderGraphPass::write(EspRenderGraphResource resource)
+  {
+    m_uses.push_back({ resource, EspRenderGraphAccess::ESP_ACCESS_COLOR_ATTACHMENT });
+    return *this;
+  }
+
+  EspRenderGraphPass& EspRenderGraphPass::write_depth(EspRenderGraphResource resource)
+  {
+    m_uses.push_back({ resource, EspRenderGraphAccess::ESP_ACCESS_DEPTH_ATTACHMENT });
+    return *this;
+  }
+
+  EspRenderGraphPass& EspRenderGraphPass::read(EspRenderGraphResource resource)
+  {
+    m_uses.push_back({ resource, EspRenderGraphAccess::ESP_ACCESS_SHADER_READ });
+    return *this;
+  }
+
+  EspRenderGraphPass& EspRenderGraphPass::read_transfer(EspRenderGraphResource resource)
+  {
+    m_uses.push_back({ resource, EspRenderGraphAccess::ESP_ACCESS_TRANSFER_READ });
+    return *this;
+  }
+
+  EspRenderGraphPass& EspRenderGraphPass::set_side_effects()
+  {
+    m_side_effects = true;
+    return *this;
+  }
+
+  EspRenderGraphPass& EspRenderGraphPass::enable_secondary_contents()
+  {
+    m_secondary_contents = true;
+    return *this;
+  }
+} // namespace esp
+
+namespace esp
+{
+  std::unique_ptr<EspRenderGraph> EspRenderGraph::create()
+  {
+    //     /* ---------------------------------------------------------*/
+    //     /* ------------- PLATFORM DEPENDENT ------------------------*/
+    //     /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    return std::make_unique<VulkanRenderGraph>();
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    //     /* ---------------------------------------------------------*/
+  }
+
+  EspRenderGraphResource EspRenderGraph::import_block(std::shared_ptr<EspBlock> block,
+                                                      EspRenderGraphAccess initial_access,
+                                                      EspRenderGraphAccess final_access)
+  {
+    Resource resource;
+    resource.m_transient      = false;
+    resource.m_block          = std::move(block);
+    resource.m_initial_access = initial_access;
+    resource.m_final_access   = final_access;
+    return add_resource(std::move(resource));
+  }
+
+  EspRenderGraphResource EspRenderGraph::import_depth_block(std::shared_ptr<EspDepthBlock> depth_block,
+                                                            EspRenderGraphAccess initial_access,
+                                                            EspRenderGraphAccess final_access)
+  {
+    Resource resource;
+    resource.m_transient      = false;
+    resource.m_desc.m_depth   = true;
+    resource.m_depth_block    = std::move(depth_block);
+    resource.m_initial_access = initial_access;
+    resource.m_final_access   = final_access;
+    return add_resource(std::move(resource));
+  }
+
+  EspRenderGraphResource EspRenderGraph::create_block(EspBlockFormat format,
+                                                      uint32_t width,
+                                                      uint32_t height,
+                                                      glm::vec3 clear_color)
+  {
+    Resource resource;
+    resource.m_transient          = true;
+    resource.m_desc.m_format      = format;
+    resource.m_desc.m_width       = width;
+    resource.m_desc.m_height      = height;
+    resource.m_desc.m_clear_color = clear_color;
+    return add_resource(std::move(resource));
+  }
+
+  EspRenderGraphResource EspRenderGraph::create_depth_block(EspDepthBlockFormat format, uint32_t width, uint32_t height)
+  {
+    Resource resource;
+    resource.m_transient           = true;
+    resource.m_desc.m_depth        = true;
+    resource.m_desc.m_depth_format = format;
+    resource.m_desc.m_width        = width;
+    resource.m_desc.m_height       = height;
+    return add_resource(std::move(resource));
+  }
+
+  EspRenderGraphPass& EspRenderGraph::add_pass(const std::string& name, std::function<void(EspRenderPlan*)> record)
+  {
+    ESP_ASSERT(!m_compiled, "Passes can't be added to a compiled render graph");
+
+    m_passes.push_back(std::make_unique<EspRenderGraphPass>(name, std::move(record)));
+    return *m_passes.back();
+  }
+
+  void EspRenderGraph::compile()
+  {
+    ESP_ASSERT(!m_compiled, "The render graph is already compiled");
+
+    std::vector<bool> executed;
+    cull(executed);
+
+    for (uint32_t i = 0; i < m_passes.size(); i++)
+    {
+      if (!executed[i]) { continue; }
+
+      int step = static_cast<int>(m_steps.size());
+      m_steps.push_back({ m_passes[i].get() });
+
+      for (auto& use : m_passes[i]->m_uses)
+      {
+        auto& resource = m_resources[use.m_resource];
+        if (resource.m_first_step < 0) { resource.m_first_step = step; }
+        resource.m_last_step = step;
+
+        if (use.m_access == EspRenderGraphAccess::ESP_ACCESS_SHADER_READ) { resource.m_desc.m_sampled = true; }
+        if (use.m_access == EspRenderGraphAccess::ESP_ACCESS_TRANSFER_READ) { resource.m_desc.m_transfer_src = true; }
+      }
+    }
+
+    compute_barriers();
+    place_transients();
+    build_plans();
+
+    m_stats.m_passes        = static_cast<uint32_t>(m_passes.size());
+    m_stats.m_culled_passes = static_cast<uint32_t>(m_passes.size() - m_steps.size());
+    m_compiled              = true;
+
+    ESP_CORE_INFO("Render graph: {} of {} passes executed, {} barriers in {} batches (plans alone: {}), {} transient "
+                  "blocks in {} B (without aliasing: {} B)",
+                  m_steps.size(),
+                  m_stats.m_passes,
+                  m_stats.m_barriers,
+                  m_stats.m_barrier_batches,
+                  m_stats.m_plan_barriers,
+                  m_stats.m_transient_blocks,
+                  m_stats.m_transient_memory,
+                  m_stats.m_unaliased_transient_memory);
+  }
+
+  void EspRenderGraph::execute()
+  {
+    ESP_ASSERT(m_compiled, "The render graph has to be compiled before it's executed");
+
+    for (auto& step : m_steps)
+    {
+      if (!step.m_barriers.empty()) { record_barriers(step.m_barriers); }
+
+      if (step.m_plan)
+      {
+        step.m_plan->begin_plan();
+        step.m_pass->m_record(step.m_plan.get());
+        step.m_plan->end_plan();
+      }
+      else { step.m_pass->m_record(nullptr); }
+    }
+
+    if (!m_final_barriers.empty()) { record_barriers(m_final_barriers); }
+  }
+
+  std::shared_ptr<EspBlock> EspRenderGraph::get_block(EspRenderGraphResource resource) const
+  {
+    return m_resources[resource].m_block;
+  }
+
+  std::shared_ptr<EspDepthBlock> EspRenderGraph::get_depth_block(EspRenderGraphResource resource) const
+  {
+    return m_resources[resource].m_depth_block;
+  }
+
+  std::vector<std::string> EspRenderGraph::get_executed_passes() const
+  {
+    std::vector<std::string> names;
+    for (auto& step : m_steps)
+    {
+      names.push_back(step.m_pass->m_name);
+    }
+    return names;
+  }
+
+  EspRenderGraphResource EspRenderGraph::add_resource(Resource resource)
+  {
+    ESP_ASSERT(!m_compiled, "Blocks can't be added to a compiled render graph");
+
+    m_resources.push_back(std::move(resource));
+    return static_cast<EspRenderGraphResource>(m_resources.size() - 1);
+  }
+
+  void EspRenderGraph::cull(std::vector<bool>& executed)
+  {
+    // imported blocks outlive the graph, transient ones are needed only if an executed pass uses them
+    std::vector<bool> needed(m_resources.size());
+    for (uint32_t i = 0; i < m_resources.size(); i++)
+    {
+      needed[i] = !m_resources[i].m_transient;
+    }
+
+    executed.assign(m_passes.size(), false);
+    for (int i = static_cast<int>(m_passes.size()) - 1; i >= 0; i--)
+    {
+      auto& pass = *m_passes[i];
+
+      bool execute = pass.m_side_effects;
+      for (auto& use : pass.m_uses)
+      {
+        if (use.m_resource >= m_resources.size())
+        {
+          ESP_CORE_ERROR("Pass {} uses unknown block {}", pass.m_name, use.m_resource);
+          throw std::runtime_error("Pass uses unknown block");
+        }
+        if (is_write(use.m_access) && needed[use.m_resource]) { execute = true; }
+      }
+      if (!execute) { continue; }
+
+      // writes keep contents of earlier passes, so passes writing the block before are needed too
+      executed[i] = true;
+      for (auto& use : pass.m_uses)
+      {
+        needed[use.m_resource] = true;
+      }
+    }
+  }
+
+  void EspRenderGraph::compute_barriers()
+  {
+    std::vector<EspRenderGraphAccess> accesses(m_resources.size());
+    std::vector<bool> has_contents(m_resources.size());
+    for (uint32_t i = 0; i < m_resources.size(); i++)
+    {
+      accesses[i]     = m_resources[i].m_initial_access;
+      has_contents[i] = accesses[i] != EspRenderGraphAccess::ESP_ACCESS_NONE;
+    }
+
+    for (auto& step : m_steps)
+    {
+      auto& pass = *step.m_pass;
+      for (uint32_t i = 0; i < pass.m_uses.size(); i++)
+      {
+        auto& use      = pass.m_uses[i];
+        auto& resource = m_resources[use.m_resource];
+
+        for (uint32_t j = 0; j < i; j++)
+        {
+          if (pass.m_uses[j].m_resource == use.m_resource)
+          {
+            ESP_CORE_ERROR("Pass {} uses block {} more than once", pass.m_name, use.m_resource);
+            throw std::runtime_error("Pass uses block more than once");
+          }
+        }
+        if ((use.m_access == EspRenderGraphAccess::ESP_ACCESS_COLOR_ATTACHMENT && resource.m_desc.m_depth) ||
+            (use.m_access == EspRenderGraphAccess::ESP_ACCESS_DEPTH_ATTACHMENT && !resource.m_desc.m_depth))
+        {
+          ESP_CORE_ERROR("Pass {} uses block {} as a wrong attachment", pass.m_name, use.m_resource);
+          throw std::runtime_error("Pass uses block as a wrong attachment");
+        }
+
+        bool write = is_write(use.m_access);
+        if (!write && !has_contents[use.m_resource])
+        {
+          ESP_CORE_ERROR("Pass {} reads block {} before anything writes it", pass.m_name, use.m_resource);
+          throw std::runtime_error("Pass reads block before anything writes it");
+        }
+
+        if (use.m_access == EspRenderGraphAccess::ESP_ACCESS_COLOR_ATTACHMENT)
+        {
+          step.m_color_loads.push_back(has_contents[use.m_resource]);
+        }
+        if (use.m_access == EspRenderGraphAccess::ESP_ACCESS_DEPTH_ATTACHMENT)
+        {
+          if (step.m_has_depth)
+          {
+            ESP_CORE_ERROR("Pass {} has more than one depth attachment", pass.m_name);
+            throw std::runtime_error("Pass has more than one depth attachment");
+          }
+          step.m_has_depth  = true;
+          step.m_depth_load = has_contents[use.m_resource];
+        }
+
+        // reads of the same kind don't depend on each other, writes have to wait for previous ones
+        if (write || accesses[use.m_resource] != use.m_access)
+        {
+          step.m_barriers.push_back({ use.m_resource,
+                                      resource.m_desc.m_depth,
+                                      accesses[use.m_resource],
+                                      use.m_access,
+                                      !has_contents[use.m_resource] });
+        }
+
+        accesses[use.m_resource]     = use.m_access;
+        has_contents[use.m_resource] = true;
+
+        m_stats.m_plan_barriers += write ? 2 : 1;
+      }
+
+      m_stats.m_barriers += static_cast<uint32_t>(step.m_barriers.size());
+      if (!step.m_barriers.empty()) { m_stats.m_barrier_batches++; }
+    }
+
+    for (uint32_t i = 0; i < m_resources.size(); i++)
+    {
+      auto& resource = m_resources[i];
+      if (resource.m_transient || resource.m_final_access == EspRenderGraphAccess::ESP_ACCESS_NONE ||
+          resource.m_final_access == accesses[i])
+      {
+        continue;
+      }
+
+      m_final_barriers.push_back(
+          { i, resource.m_desc.m_depth, accesses[i], resource.m_final_access, !has_contents[i] });
+    }
+
+    m_stats.m_barriers += static_cast<uint32_t>(m_final_barriers.size());
+    if (!m_final_barriers.empty()) { m_stats.m_barrier_batches++; }
+  }
+
+  void EspRenderGraph::place_transients()
+  {
+    std::vector<std::vector<EspRenderGraphResource>> heap_resources;
+    for (uint32_t i = 0; i < m_resources.size(); i++)
+    {
+      auto& resource = m_resources[i];
+      if (!resource.m_transient || resource.m_first_step < 0) { continue; }
+
+      resource.m_requirements = create_transient(i, resource.m_desc);
+
+      uint32_t heap = 0;
+      while (heap < m_heaps.size() && m_heaps[heap].m_memory_type_bits != resource.m_requirements.m_memory_type_bits)
+      {
+        heap++;
+      }
+      if (heap == m_heaps.size())
+      {
+        m_heaps.push_back({ resource.m_requirements.m_memory_type_bits, 0 });
+        heap_resources.emplace_back();
+      }
+
+      resource.m_heap = heap;
+      heap_resources[heap].push_back(i);
+    }
+
+    for (uint32_t heap = 0; heap < m_heaps.size(); heap++)
+    {
+      // the largest blocks are placed first, each at the lowest offset not used by blocks living at the same time
+      auto& resources = heap_resources[heap];
+      std::stable_sort(resources.begin(),
+                       resources.end(),
+                       [this](EspRenderGraphResource a, EspRenderGraphResource b)
+                       { return m_resources[a].m_requirements.m_size > m_resources[b].m_requirements.m_size; });
+
+      std::vector<EspRenderGraphResource> placed;
+      for (auto id : resources)
+      {
+        auto& resource = m_resources[id];
+        auto size      = resource.m_requirements.m_size;
+        auto alignment = std::max<uint64_t>(resource.m_requirements.m_alignment, 1);
+
+        std::vector<EspRenderGraphResource> overlapping;
+        for (auto other_id : placed)
+        {
+          auto& other = m_resources[other_id];
+          if (other.m_first_step <= resource.m_last_step && resource.m_first_step <= other.m_last_step)
+          {
+            overlapping.push_back(other_id);
+          }
+        }
+        std::sort(overlapping.begin(),
+                  overlapping.end(),
+                  [this](EspRenderGraphResource a, EspRenderGraphResource b)
+                  { return m_resources[a].m_offset < m_resources[b].m_offset; });
+
+        uint64_t offset = 0;
+        for (auto other_id : overlapping)
+        {
+          auto& other = m_resources[other_id];
+          if (align_up(offset, alignment) + size <= other.m_offset) { break; }
+          offset = std::max(offset, other.m_offset + other.m_requirements.m_size);
+        }
+
+        resource.m_offset    = align_up(offset, alignment);
+        m_heaps[heap].m_size = std::max(m_heaps[heap].m_size, resource.m_offset + size);
+        placed.push_back(id);
+
+        m_stats.m_transient_blocks++;
+        m_stats.m_unaliased_transient_memory += size;
+      }
+
+      m_stats.m_transient_memory += m_heaps[heap].m_size;
+    }
+
+    if (m_stats.m_transient_blocks > 0) { bind_transients(m_heaps); }
+  }
+
+  void EspRenderGraph::build_plans()
+  {
+    for (auto& step : m_steps)
+    {
+      if (step.m_color_loads.empty() && !step.m_has_depth) { continue; }
+
+      step.m_plan = create_plan();
+      for (auto& use : step.m_pass->m_uses)
+      {
+        if (use.m_access == EspRenderGraphAccess::ESP_ACCESS_COLOR_ATTACHMENT)
+        {
+          step.m_plan->add_block(m_resources[use.m_resource].m_block);
+        }
+        if (use.m_access == EspRenderGraphAccess::ESP_ACCESS_DEPTH_ATTACHMENT)
+        {
+          step.m_plan->add_depth_block(m_resources[use.m_resource].m_depth_block);
+        }
+      }
+
+      step.m_plan->set_name(step.m_pass->m_name);
+      step.m_plan->enable_secondary_contents(step.m_pass->m_secondary_contents);
+      step.m_plan->enable_external_barriers(true);
+      step.m_plan->set_load_contents(step.m_color_loads, step.m_depth_load);
+      step.m_plan->build();
+    }
+  }
+} // namespace esp
+
+/* --------------------------------------------------------- */
+/* ------------------ HELPFUL FUNCTIONS -------------------- */
+/* --------------------------------------------------------- */
+
+static bool is_write(esp::EspRenderGraphAccess access)
+{
+  return access == esp::EspRenderGraphAccess::ESP_ACCESS_COLOR_ATTACHMENT ||
+      access == esp::EspRenderGraphAccess::ESP_ACCESS_DEPTH_ATTACHMENT;
+}
+
+static uint64_t align_up(uint64_t value, uint64_t alignment) { return (value + alignment - 1) / alignment * alignment; }
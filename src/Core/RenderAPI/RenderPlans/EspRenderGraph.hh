@@ -0,0 +1,336 @@
+#ifndef CORE_RENDER_API_ESP_RENDER_GRAPH_HH
+#define CORE_RENDER_API_ESP_RENDER_GRAPH_HH
+
+#include "esppch.hh"
+
+#include "Core/RenderAPI/RenderPlans/Block/EspBlock.hh"
+#include "Core/RenderAPI/RenderPlans/Block/EspDepthBlock.hh"
+#include "Core/RenderAPI/RenderPlans/EspRenderPlan.hh"
+
+// std
+#include <functional>
+
+namespace esp
+{
+  /// @brief Handle of a block used by passes of a render graph.
+  using EspRenderGraphResource = uint32_t;
+
+  /// @brief The way a pass uses a block. Every access has its own image layout.
+  enum class EspRenderGraphAccess
+  {
+    /// @brief Contents of the block don't matter.
+    ESP_ACCESS_NONE,
+    /// @brief The block is a color attachment of the pass.
+    ESP_ACCESS_COLOR_ATTACHMENT,
+    /// @brief The depth block is the depth attachment of the pass.
+    ESP_ACCESS_DEPTH_ATTACHMENT,
+    /// @brief The block is sampled by fragment shaders.
+    ESP_ACCESS_SHADER_READ,
+    /// @brief The block is a source of copies (e.g. EspJob::copy_image).
+    ESP_ACCESS_TRANSFER_READ,
+  };
+
+  /// @brief Transition of a block recorded before a pass.
+  struct EspRenderGraphBarrier
+  {
+    /// @brief Block to be transitioned.
+    EspRenderGraphResource m_resource;
+    /// @brief True if the block is a depth block.
+    bool m_depth;
+    /// @brief Access of previous commands. ESP_ACCESS_NONE if the block wasn't used by the graph yet.
+    EspRenderGraphAccess m_src_access;
+    /// @brief Access of the pass.
+    EspRenderGraphAccess m_dst_access;
+    /// @brief True if contents of the block are discarded (the pass clears it or its memory was used by another
+    /// transient block).
+    bool m_discard;
+  };
+
+  /// @brief Description of a block created by the graph.
+  struct EspTransientBlockDesc
+  {
+    bool m_depth = false;
+    EspBlockFormat m_format;
+    EspDepthBlockFormat m_depth_format;
+    uint32_t m_width;
+    uint32_t m_height;
+    glm::vec3 m_clear_color;
+
+    /// @brief True if a pass samples the block.
+    bool m_sampled = false;
+    /// @brief True if a pass copies from the block.
+    bool m_transfer_src = false;
+  };
+
+  /// @brief Memory requirements of a transient block.
+  struct EspTransientRequirements
+  {
+    uint64_t m_size;
+    uint64_t m_alignment;
+    /// @brief Memory types the block can be placed in. Blocks are aliased only with blocks of the same types.
+    uint32_t m_memory_type_bits;
+  };
+
+  /// @brief Memory shared by transient blocks.
+  struct EspTransientHeap
+  {
+    uint32_t m_memory_type_bits;
+    uint64_t m_size;
+  };
+
+  /// @brief Results of compilation of a render graph.
+  struct EspRenderGraphStats
+  {
+    /// @brief Number of passes added to the graph.
+    uint32_t m_passes = 0;
+    /// @brief Number of passes which aren't executed, as nothing uses what they write.
+    uint32_t m_culled_passes = 0;
+    /// @brief Number of block transitions recorded per frame.
+    uint32_t m_barriers = 0;
+    /// @brief Number of pipeline barrier commands the transitions are batched into.
+    uint32_t m_barrier_batches = 0;
+    /// @brief Number of transitions render plans would record on their own: one per block at the beginning of every
+    /// pass and one per attachment at its end.
+    uint32_t m_plan_barriers = 0;
+    /// @brief Number of transient blocks used by executed passes.
+    uint32_t m_transient_blocks = 0;
+    /// @brief Memory of transient blocks in bytes.
+    uint64_t m_transient_memory = 0;
+    /// @brief Memory transient blocks would take without aliasing in bytes.
+    uint64_t m_unaliased_transient_memory = 0;
+  };
+
+  /// @brief Pass of a render graph. Blocks it writes are attachments of its render plan, in the order they were added.
+  class EspRenderGraphPass
+  {
+    friend class EspRenderGraph;
+
+    /* -------------------------- FIELDS ----------------------------------- */
+   private:
+    struct Use
+    {
+      EspRenderGraphResource m_resource;
+      EspRenderGraphAccess m_access;
+    };
+
+    std::string m_name;
+    std::function<void(EspRenderPlan*)> m_record;
+    std::vector<Use> m_uses;
+
+    bool m_side_effects       = false;
+    bool m_secondary_contents = false;
+
+    /* -------------------------- METHODS ---------------------------------- */
+   public:
+    EspRenderGraphPass(const std::string& name, std::function<void(EspRenderPlan*)> record) :
+        m_name{ name }, m_record{ std::move(record) }
+    {
+    }
+
+    /// @brief Renders into a block. The first pass writing it clears it, the following ones keep its contents.
+    /// @param resource Block used as the next color attachment.
+    /// @return Reference to the pass.
+    EspRenderGraphPass& write(EspRenderGraphResource resource);
+    /// @brief Uses a depth block as the depth attachment. The first pass writing it clears it.
+    /// @param resource Depth block.
+    /// @return Reference to the pass.
+    EspRenderGraphPass& write_depth(EspRenderGraphResource resource);
+    /// @brief Samples a block in fragment shaders.
+    /// @param resource Block or depth block.
+    /// @return Reference to the pass.
+    EspRenderGraphPass& read(EspRenderGraphResource resource);
+    /// @brief Copies from a block.
+    /// @param resource Block or depth block.
+    /// @return Reference to the pass.
+    EspRenderGraphPass& read_transfer(EspRenderGraphResource resource);
+
+    /// @brief Marks the pass as doing something outside of the graph (e.g. writing the swap chain image), so it is
+    /// never culled.
+    /// @return Reference to the pass.
+    EspRenderGraphPass& set_side_effects();
+    /// @brief Enables secondary contents of the pass's render plan (see EspRenderPlan::enable_secondary_contents).
+    /// @return Reference to the pass.
+    EspRenderGraphPass& enable_secondary_contents();
+
+    inline const std::string& get_name() const { return m_name; }
+  };
+
+  /// @brief Orders render plans by the blocks they use. Passes declare blocks they write and read, compile() turns
+  /// them into render plans and the transitions between them:
+  ///
+  /// - passes whose blocks aren't used by later passes, aren't imported and don't have side effects are culled,
+  /// - a block is transitioned only when its layout changes or it's written again, transitions before a pass are
+  ///   recorded by a single barrier,
+  /// - transient blocks are created by the graph and ones not used at the same time share memory.
+  ///
+  /// Passes are executed in the order they were added. Blocks created outside of the graph are imported with their
+  /// layout before and after the graph. The graph can't be changed after compile(), when the sizes change it has to
+  /// be built again.
+  class EspRenderGraph
+  {
+    /* -------------------------- FIELDS ----------------------------------- */
+   protected:
+    struct Resource
+    {
+      bool m_transient;
+      EspTransientBlockDesc m_desc;
+      std::shared_ptr<EspBlock> m_block;
+      std::shared_ptr<EspDepthBlock> m_depth_block;
+
+      EspRenderGraphAccess m_initial_access = EspRenderGraphAccess::ESP_ACCESS_NONE;
+      EspRenderGraphAccess m_final_access   = EspRenderGraphAccess::ESP_ACCESS_NONE;
+
+      // steps of the first and the last pass using the block, -1 if no executed pass uses it
+      int m_first_step = -1;
+      int m_last_step  = -1;
+
+      EspTransientRequirements m_requirements = {};
+      uint32_t m_heap                         = 0;
+      uint64_t m_offset                       = 0;
+    };
+
+    std::vector<Resource> m_resources;
+
+   private:
+    struct Step
+    {
+      EspRenderGraphPass* m_pass;
+      std::unique_ptr<EspRenderPlan> m_plan;
+      std::vector<EspRenderGraphBarrier> m_barriers;
+
+      // true for attachments keeping contents of earlier passes
+      std::vector<bool> m_color_loads;
+      bool m_has_depth  = false;
+      bool m_depth_load = false;
+    };
+
+    std::vector<std::unique_ptr<EspRenderGraphPass>> m_passes;
+
+    bool m_compiled = false;
+    std::vector<Step> m_steps;
+    std::vector<EspRenderGraphBarrier> m_final_barriers;
+    std::vector<EspTransientHeap> m_heaps;
+    EspRenderGraphStats m_stats;
+
+    /* -------------------------- METHODS ---------------------------------- */
+   public:
+    EspRenderGraph() = default;
+    virtual ~EspRenderGraph() {}
+
+    PREVENT_COPY(EspRenderGraph);
+
+    /// @brief Uses a block created outside of the graph. Imported blocks are kept, so passes writing them are never
+    /// culled.
+    /// @param block Block.
+    /// @param initial_access Access of the block before the graph. ESP_ACCESS_NONE if its contents don't matter.
+    /// @param final_access Access the block is left in after the graph. ESP_ACCESS_NONE leaves it as the last pass
+    /// used it.
+    /// @return Handle of the block.
+    EspRenderGraphResource import_block(
+        std::shared_ptr<EspBlock> block,
+        EspRenderGraphAccess initial_access = EspRenderGraphAccess::ESP_ACCESS_NONE,
+        EspRenderGraphAccess final_access   = EspRenderGraphAccess::ESP_ACCESS_SHADER_READ);
+    /// @brief Uses a depth block created outside of the graph.
+    /// @param depth_block Depth block.
+    /// @param initial_access Access of the block before the graph. ESP_ACCESS_NONE if its contents don't matter.
+    /// @param final_access Access the block is left in after the graph. ESP_ACCESS_NONE leaves it as the last pass
+    /// used it.
+    /// @return Handle of the depth block.
+    EspRenderGraphResource import_depth_block(
+        std::shared_ptr<EspDepthBlock> depth_block,
+        EspRenderGraphAccess initial_access = EspRenderGraphAccess::ESP_ACCESS_NONE,
+        EspRenderGraphAccess final_access   = EspRenderGraphAccess::ESP_ACCESS_NONE);
+
+    /// @brief Declares a single sampled block created by compile(). Its contents live only between the first and the
+    /// last pass using it.
+    /// @param format Format of the block.
+    /// @param width Width of the block.
+    /// @param height Height of the block.
+    /// @param clear_color Color the first pass writing the block clears it with.
+    /// @return Handle of the block.
+    EspRenderGraphResource create_block(EspBlockFormat format,
+                                        uint32_t width,
+                                        uint32_t height,
+                                        glm::vec3 clear_color = { 0.f, 0.f, 0.f });
+    /// @brief Declares a single sampled depth block created by compile().
+    /// @param format Format of the depth block.
+    /// @param width Width of the depth block.
+    /// @param height Height of the depth block.
+    /// @return Handle of the depth block.
+    EspRenderGraphResource create_depth_block(EspDepthBlockFormat format, uint32_t width, uint32_t height);
+
+    /// @brief Adds a pass executed after the passes added before.
+    /// @param name Name of the pass and its render plan.
+    /// @param record Function recording commands of the pass, called between begin_plan() and end_plan() of its
+    /// render plan. The plan is nullptr if the pass doesn't write any block.
+    /// @return Reference to the pass, valid as long as the graph.
+    EspRenderGraphPass& add_pass(const std::string& name, std::function<void(EspRenderPlan*)> record);
+
+    /// @brief Culls passes, computes transitions, creates transient blocks and builds render plans.
+    void compile();
+    /// @brief Records passes of the graph into the frame's command buffer.
+    void execute();
+
+    /// @brief Returns a block of the graph, e.g. to sample a transient block with use_as_texture().
+    /// @param resource Handle of the block.
+    /// @return The block. nullptr for transient blocks before compile() or when no executed pass uses them.
+    std::shared_ptr<EspBlock> get_block(EspRenderGraphResource resource) const;
+    /// @brief Returns a depth block of the graph.
+    /// @param resource Handle of the depth block.
+    /// @return The depth block. nullptr for transient blocks before compile() or when no executed pass uses them.
+    std::shared_ptr<EspDepthBlock> get_depth_block(EspRenderGraphResource resource) const;
+
+    /// @brief Returns results of compile().
+    /// @return Statistics of the graph.
+    inline const EspRenderGraphStats& get_stats() const { return m_stats; }
+    /// @brief Returns memory shared by transient blocks.
+    /// @return Heaps of transient blocks.
+    inline const std::vector<EspTransientHeap>& get_heaps() const { return m_heaps; }
+    /// @brief Returns passes which are executed.
+    /// @return Names of passes in order of execution.
+    std::vector<std::string> get_executed_passes() const;
+    /// @brief Returns transitions recorded before a pass.
+    /// @param step Index of the pass among executed passes.
+    /// @return Transitions recorded before the pass.
+    inline const std::vector<EspRenderGraphBarrier>& get_barriers(uint32_t step) const
+    {
+      return m_steps[step].m_barriers;
+    }
+    /// @brief Returns transitions of imported blocks recorded after the last pass.
+    /// @return Transitions recorded after the last pass.
+    inline const std::vector<EspRenderGraphBarrier>& get_final_barriers() const { return m_final_barriers; }
+
+    /* -------------------------- STATIC METHODS --------------------------- */
+   public:
+    /// @brief Creates a render graph of the graphic's API.
+    /// @return Unique pointer to the render graph.
+    static std::unique_ptr<EspRenderGraph> create();
+
+   protected:
+    /// @brief Creates a render plan of a pass.
+    /// @return Unique pointer to the render plan.
+    virtual std::unique_ptr<EspRenderPlan> create_plan() = 0;
+    /// @brief Creates a transient block's image without memory.
+    /// @param resource Handle of the block.
+    /// @param desc Description of the block.
+    /// @return Memory requirements of the image.
+    virtual EspTransientRequirements create_transient(EspRenderGraphResource resource,
+                                                      const EspTransientBlockDesc& desc) = 0;
+    /// @brief Allocates heaps and binds images of transient blocks to them at m_heap and m_offset of m_resources.
+    /// m_block or m_depth_block of every transient block used by executed passes has to be set.
+    /// @param heaps Heaps to be allocated.
+    virtual void bind_transients(const std::vector<EspTransientHeap>& heaps) = 0;
+    /// @brief Records transitions of blocks into the frame's command buffer.
+    /// @param barriers Transitions recorded at once.
+    virtual void record_barriers(const std::vector<EspRenderGraphBarrier>& barriers) = 0;
+
+   private:
+    EspRenderGraphResource add_resource(Resource resource);
+    void cull(std::vector<bool>& executed);
+    void compute_barriers();
+    void place_transients();
+    void build_plans();
+  };
+} // namespace esp
+
+#endif /* CORE_RENDER_API_ESP_RENDER_GRAPH_HH */
@@ -16,6 +16,12 @@ namespace esp
     /* -------------------------- METHODS ---------------------------------- */
    protected:
     EspImageLayout m_new_layout;
+    bool m_secondary_contents = false;
+    std::string m_name        = "Render plan";
+
+    bool m_external_barriers = false;
+    std::vector<bool> m_load_blocks;
+    bool m_load_depth_block = false;
 
    public:
     EspRenderPlan() : m_new_layout{ EspImageLayout::ESP_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL } {}
@@ -25,6 +31,23 @@ namespace esp
     virtual void add_depth_block(std::shared_ptr<EspDepthBlock> depth_block) = 0;
 
     inline virtual void set_new_layout(EspImageLayout new_layout) { m_new_layout = new_layout; }
+    // When enabled, rendering begun by begin_plan() can only contain secondary command buffers recorded with
+    // begin_secondary() and executed with execute_secondaries(). Commands can't be recorded inline then.
+    inline virtual void enable_secondary_contents(bool enable) { m_secondary_contents = enable; }
+    inline virtual bool has_secondary_contents() const { return m_secondary_contents; }
+    // Name of the plan's scope in GPU profiler results (EspGpuProfiler).
+    inline virtual void set_name(const std::string& name) { m_name = name; }
+    inline virtual const std::string& get_name() const { return m_name; }
+    // When enabled, begin_plan() and end_plan() don't transition the blocks, whoever uses the plan does
+    // (EspRenderGraph). Has to be set before build().
+    inline virtual void enable_external_barriers(bool enable) { m_external_barriers = enable; }
+    // Attachments to be loaded instead of cleared at the beginning of the plan, blocks in order they were added.
+    // Has to be set before build().
+    inline virtual void set_load_contents(const std::vector<bool>& blocks, bool depth_block)
+    {
+      m_load_blocks      = blocks;
+      m_load_depth_block = depth_block;
+    }
 
     virtual void set_command_buffer(EspCommandBufferId* id) = 0;
     virtual void build()                                    = 0;
@@ -32,6 +55,11 @@ namespace esp
     virtual void begin_plan() = 0;
     virtual void end_plan()   = 0;
 
+    // begin_secondary() can be called from any thread, each thread records into its own command pool.
+    // execute_secondaries() has to be called between begin_plan() and end_plan() on the plan's thread.
+    virtual EspCommandBufferId* begin_secondary()                                 = 0;
+    virtual void execute_secondaries(const std::vector<EspCommandBufferId*>& ids) = 0;
+
     /* -------------------------- STATIC METHODS --------------------------- */
    public:
     static std::unique_ptr<EspRenderPlan> create();
@@ -0,0 +1,192 @@
+#include "EspBindlessTextures.hh"
+
+#include "Platform/Vulkan/Uniforms/VulkanBindlessTextures.hh"
+
+// std
+#include <bit>
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  EspBindlessTextures* EspBindlessTextures::s_instance = nullptr;
+
+  EspBindlessTextures::EspBindlessTextures(uint32_t max_textures, uint32_t max_materials, uint32_t frames_in_flight) :
+      m_frames_in_flight{ frames_in_flight }, m_texture_slots{ max_textures }, m_material_slots{ max_materials },
+      m_textures(max_textures), m_materials(max_materials)
+  {
+    if (EspBindlessTextures::s_instance != nullptr)
+    {
+      throw std::runtime_error("The bindless textures instance already exists!");
+    }
+
+    EspBindlessTextures::s_instance = this;
+  }
+
+  EspBindlessTextures::~EspBindlessTextures()
+  {
+    if (s_instance == this) { s_instance = nullptr; }
+  }
+
+  std::unique_ptr<EspBindlessTextures> EspBindlessTextures::create(uint32_t max_textures, uint32_t max_materials)
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    auto bindless_textures = VulkanBindlessTextures::create(max_textures, max_materials);
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+
+    if (bindless_textures) { ESP_CORE_TRACE("Bindless textures initialized."); }
+    return bindless_textures;
+  }
+
+  void EspBindlessTextures::terminate()
+  {
+    if (s_instance != this) { return; }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ESP_CORE_TRACE("Bindless textures shutdown ({} textures, {} materials, {} texture requests).",
+                   m_stats.m_textures,
+                   m_stats.m_materials,
+                   m_stats.m_texture_requests);
+
+    EspBindlessTextures::s_instance = nullptr;
+
+    destroy();
+    m_textures.clear();
+    m_texture_indices.clear();
+  }
+
+  uint32_t EspBindlessTextures::add_material(
+      const std::unordered_map<EspTextureType, std::shared_ptr<EspTexture>>& textures)
+  {
+    if (!s_instance) { return INVALID_INDEX; }
+
+    std::lock_guard<std::mutex> lock(s_instance->m_mutex);
+
+    auto index = s_instance->m_material_slots.acquire();
+    if (index == INVALID_INDEX)
+    {
+      ESP_CORE_ERROR("Bindless material buffer is full.");
+      return INVALID_INDEX;
+    }
+
+    auto& material = s_instance->m_materials[index];
+    std::fill(std::begin(material.m_textures), std::end(material.m_textures), INVALID_INDEX);
+    for (const auto& [type, texture] : textures)
+    {
+      auto slot = std::countr_zero(static_cast<uint32_t>(type));
+      if (!texture || slot >= EspBindlessMaterial::MAX_TEXTURES) { continue; }
+
+      material.m_textures[slot] = s_instance->add_texture(texture);
+    }
+
+    s_instance->write_material(index, material);
+    s_instance->m_stats.m_materials++;
+
+    return index;
+  }
+
+  void EspBindlessTextures::release_material(uint32_t index)
+  {
+    if (!s_instance || index == INVALID_INDEX) { return; }
+
+    std::lock_guard<std::mutex> lock(s_instance->m_mutex);
+
+    for (auto texture_index : s_instance->m_materials[index].m_textures)
+    {
+      if (texture_index != INVALID_INDEX) { s_instance->release_texture(texture_index); }
+    }
+
+    s_instance->release_slot(s_instance->m_material_slots, index);
+    s_instance->m_stats.m_materials--;
+  }
+
+  void EspBindlessTextures::begin_frame()
+  {
+    if (!s_instance) { return; }
+
+    std::lock_guard<std::mutex> lock(s_instance->m_mutex);
+    s_instance->m_frame++;
+
+    for (auto* slots : { &s_instance->m_texture_slots, &s_instance->m_material_slots })
+    {
+      while (!slots->m_released.empty() && slots->m_released.front().m_reusable_frame <= s_instance->m_frame)
+      {
+        auto index = slots->m_released.front().m_index;
+        slots->m_released.pop_front();
+
+        // the GPU doesn't sample the texture anymore
+        if (slots == &s_instance->m_texture_slots) { s_instance->m_textures[index].m_texture.reset(); }
+        slots->m_free.push_back(index);
+      }
+    }
+  }
+
+  EspBindlessTexturesStats EspBindlessTextures::get_stats()
+  {
+    if (!s_instance) { return {}; }
+
+    std::lock_guard<std::mutex> lock(s_instance->m_mutex);
+    return s_instance->m_stats;
+  }
+
+  uint32_t EspBindlessTextures::add_texture(std::shared_ptr<EspTexture> texture)
+  {
+    m_stats.m_texture_requests++;
+
+    if (auto it = m_texture_indices.find(texture.get()); it != m_texture_indices.end())
+    {
+      m_textures[it->second].m_references++;
+      return it->second;
+    }
+
+    auto index = m_texture_slots.acquire();
+    if (index == INVALID_INDEX)
+    {
+      ESP_CORE_ERROR("Bindless texture array is full.");
+      return INVALID_INDEX;
+    }
+
+    write_texture(index, *texture);
+    m_texture_indices.insert({ texture.get(), index });
+    m_textures[index] = { std::move(texture), 1 };
+    m_stats.m_textures++;
+
+    return index;
+  }
+
+  void EspBindlessTextures::release_texture(uint32_t index)
+  {
+    auto& slot = m_textures[index];
+    if (--slot.m_references > 0) { return; }
+
+    // the texture is kept alive until the slot is reusable
+    m_texture_indices.erase(slot.m_texture.get());
+    release_slot(m_texture_slots, index);
+    m_stats.m_textures--;
+  }
+
+  void EspBindlessTextures::release_slot(SlotList& slots, uint32_t index)
+  {
+    slots.m_released.push_back({ index, m_frame + m_frames_in_flight });
+  }
+
+  uint32_t EspBindlessTextures::SlotList::acquire()
+  {
+    if (!m_free.empty())
+    {
+      auto index = m_free.back();
+      m_free.pop_back();
+      return index;
+    }
+
+    return m_next < m_capacity ? m_next++ : INVALID_INDEX;
+  }
+} // namespace esp
@@ -0,0 +1,163 @@
+#ifndef CORE_RENDER_API_ESP_BINDLESS_TEXTURES_HH
+#define CORE_RENDER_API_ESP_BINDLESS_TEXTURES_HH
+
+#include "esppch.hh"
+
+#include "Core/RenderAPI/Resources/EspTexture.hh"
+
+// std
+#include <deque>
+#include <mutex>
+
+namespace esp
+{
+  /// @brief Material as seen by bindless shaders. Materials are kept in one storage buffer indexed by the material
+  /// index pushed before the draw.
+  struct EspBindlessMaterial
+  {
+    /// @brief Maximal number of textures of a material.
+    static constexpr uint32_t MAX_TEXTURES = 8;
+
+    /// @brief Indices of textures in the bindless texture array. Entry i holds texture of EspTextureType with bit i
+    /// set. Unused entries are EspBindlessTextures::INVALID_INDEX.
+    uint32_t m_textures[MAX_TEXTURES];
+  };
+
+  /// @brief Counters describing the EspBindlessTextures.
+  struct EspBindlessTexturesStats
+  {
+    /// @brief Number of textures in the texture array.
+    uint32_t m_textures = 0;
+    /// @brief Number of materials in the material buffer.
+    uint32_t m_materials = 0;
+    /// @brief Number of textures added, including ones that were already in the array.
+    uint32_t m_texture_requests = 0;
+  };
+
+  /// @brief Bindless texture model. Every texture used by materials lives in one large, partially bound array of
+  /// textures and every material is a small struct of indices into it (EspBindlessMaterial), kept in a storage buffer.
+  /// Shaders declare both in one descriptor set, which is bound once per pipeline, and get index of the material from a
+  /// push uniform, so switching materials doesn't bind any descriptor set.
+  ///
+  /// Slots of released textures and materials are reused only after all frames in flight have finished, so the GPU
+  /// never reads a slot that was overwritten.
+  ///
+  /// It is optional. When the service doesn't exist, materials use their own uniform managers.
+  class EspBindlessTextures
+  {
+   public:
+    /// @brief Index of a texture or material that isn't in the bindless arrays.
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+    /// @brief Index of push uniform holding index of the material in bindless shaders. Push uniform 0 is used by
+    /// models for transformation of their nodes.
+    static constexpr uint32_t MATERIAL_PUSH_UNIFORM = 1;
+
+    /// @brief Default number of textures in the texture array.
+    static constexpr uint32_t DEFAULT_MAX_TEXTURES = 4096;
+    /// @brief Default number of materials in the material buffer.
+    static constexpr uint32_t DEFAULT_MAX_MATERIALS = 4096;
+
+   private:
+    struct TextureSlot
+    {
+      std::shared_ptr<EspTexture> m_texture;
+      uint32_t m_references = 0;
+    };
+
+    struct ReleasedSlot
+    {
+      uint32_t m_index;
+      uint64_t m_reusable_frame;
+    };
+
+    struct SlotList
+    {
+      uint32_t m_capacity;
+      uint32_t m_next = 0;
+      std::vector<uint32_t> m_free;
+      std::deque<ReleasedSlot> m_released;
+
+      uint32_t acquire();
+    };
+
+   protected:
+    static EspBindlessTextures* s_instance;
+
+   private:
+    uint32_t m_frames_in_flight;
+    uint64_t m_frame = 0;
+
+    std::mutex m_mutex;
+    SlotList m_texture_slots;
+    SlotList m_material_slots;
+    std::vector<TextureSlot> m_textures;
+    std::vector<EspBindlessMaterial> m_materials;
+    std::unordered_map<const EspTexture*, uint32_t> m_texture_indices;
+
+    EspBindlessTexturesStats m_stats;
+
+   protected:
+    /// @brief Creates empty texture array and material buffer.
+    /// @param max_textures Number of textures in the texture array.
+    /// @param max_materials Number of materials in the material buffer.
+    /// @param frames_in_flight Number of frames the GPU may be working on at once.
+    EspBindlessTextures(uint32_t max_textures, uint32_t max_materials, uint32_t frames_in_flight);
+
+   public:
+    /// @brief Terminates EspBindlessTextures.
+    virtual ~EspBindlessTextures();
+
+    PREVENT_COPY(EspBindlessTextures);
+
+    /// @brief Creates EspBindlessTextures singleton instance.
+    /// @param max_textures Number of textures in the texture array. Clamped to device's limits.
+    /// @param max_materials Number of materials in the material buffer.
+    /// @return Unique pointer to EspBindlessTextures instance. nullptr if the device doesn't support bindless textures.
+    static std::unique_ptr<EspBindlessTextures> create(uint32_t max_textures  = DEFAULT_MAX_TEXTURES,
+                                                       uint32_t max_materials = DEFAULT_MAX_MATERIALS);
+
+    /// @brief Releases all textures and destroys EspBindlessTextures instance. GPU has to be idle.
+    void terminate();
+
+    /// @brief Checks if bindless textures are used.
+    /// @return True if the instance exists. False otherwise.
+    static inline bool is_enabled() { return s_instance != nullptr; }
+
+    /// @brief Adds material and its textures to the bindless arrays. Textures shared by materials are added once.
+    /// Can be called from many threads.
+    /// @param textures Textures of the material.
+    /// @return Index of the material or INVALID_INDEX if there is no instance or no free slot.
+    static uint32_t add_material(const std::unordered_map<EspTextureType, std::shared_ptr<EspTexture>>& textures);
+    /// @brief Releases material and its textures. Slots are reused after all frames in flight have finished. Can be
+    /// called from many threads.
+    /// @param index Index of the material returned by add_material.
+    static void release_material(uint32_t index);
+
+    /// @brief Makes slots released by old frames reusable. Has to be called once per frame, after the GPU has finished
+    /// work of the previous frame with the same index.
+    static void begin_frame();
+
+    /// @brief Returns statistics of the EspBindlessTextures.
+    /// @return Statistics of the EspBindlessTextures.
+    static EspBindlessTexturesStats get_stats();
+
+   protected:
+    /// @brief Writes texture to the texture array.
+    /// @param index Index in the texture array.
+    /// @param texture Texture to be written.
+    virtual void write_texture(uint32_t index, EspTexture& texture) = 0;
+    /// @brief Writes material to the material buffer.
+    /// @param index Index in the material buffer.
+    /// @param material Material to be written.
+    virtual void write_material(uint32_t index, const EspBindlessMaterial& material) = 0;
+    /// @brief Destroys graphic's API objects.
+    virtual void destroy() = 0;
+
+   private:
+    uint32_t add_texture(std::shared_ptr<EspTexture> texture);
+    void release_texture(uint32_t index);
+    void release_slot(SlotList& slots, uint32_t index);
+  };
+} // namespace esp
+
+#endif // CORE_RENDER_API_ESP_BINDLESS_TEXTURES_HH
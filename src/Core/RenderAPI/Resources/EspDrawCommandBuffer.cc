@@ -0,0 +1,47 @@
+#include "EspDrawCommandBuffer.hh"
+
+#include "Platform/Vulkan/Resources/VulkanDrawCommandBuffer.hh"
+#include "Platform/Vulkan/VulkanDevice.hh"
+
+// std
+#include <cstring>
+
+namespace esp
+{
+  std::unique_ptr<EspDrawCommandBuffer> EspDrawCommandBuffer::create(uint32_t max_command_count)
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    auto draw_command_buffer = VulkanDrawCommandBuffer::create(max_command_count);
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+
+    draw_command_buffer->m_max_command_count = max_command_count;
+    return draw_command_buffer;
+  }
+
+  bool EspDrawCommandBuffer::is_gpu_count_supported()
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    return VulkanDevice::is_draw_indirect_count_supported();
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+  }
+
+  void EspDrawCommandBuffer::write(const EspDrawIndexedCommand* commands, uint32_t count)
+  {
+    ESP_ASSERT(count <= m_max_command_count, "Too many draw commands.")
+
+    std::memcpy(get_commands(), commands, count * sizeof(EspDrawIndexedCommand));
+    set_command_count(count);
+  }
+} // namespace esp
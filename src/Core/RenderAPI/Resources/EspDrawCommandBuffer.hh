@@ -0,0 +1,86 @@
+#ifndef RENDER_API_ESP_DRAW_COMMAND_BUFFER_HH
+#define RENDER_API_ESP_DRAW_COMMAND_BUFFER_HH
+
+#include "esppch.hh"
+
+#include "EspStorageBuffer.hh"
+
+namespace esp
+{
+  /// @brief Parameters of a single indexed draw read by the GPU. Has the same layout as
+  /// VkDrawIndexedIndirectCommand.
+  struct EspDrawIndexedCommand
+  {
+    /// @brief Number of indices to draw.
+    uint32_t m_index_count = 0;
+    /// @brief Number of instances to draw.
+    uint32_t m_instance_count = 1;
+    /// @brief Index of the first index in index buffer.
+    uint32_t m_first_index = 0;
+    /// @brief Value added to every index before reading vertex buffer.
+    int32_t m_vertex_offset = 0;
+    /// @brief Index of the first instance. Can be used by shaders to find per draw data.
+    uint32_t m_first_instance = 0;
+  };
+
+  /// @brief Interface for GPU's buffer of draw commands used by indirect draws. Every frame in flight has its own
+  /// copy of commands, so they can be rewritten while the previous frame is still rendered.
+  class EspDrawCommandBuffer
+  {
+   protected:
+    uint32_t m_max_command_count;
+
+   public:
+    /// @brief Creates draw command buffer for current graphic's API.
+    /// @param max_command_count Maximum number of commands in a single frame.
+    /// @return Unique pointer to instance of draw command buffer.
+    static std::unique_ptr<EspDrawCommandBuffer> create(uint32_t max_command_count);
+    /// @brief Checks if indirect draws with count read the count from the GPU's memory, so commands and their count
+    /// can be written by compute shaders. Otherwise the count set by the CPU is used.
+    /// @return True if the device supports indirect draws with count.
+    static bool is_gpu_count_supported();
+
+    EspDrawCommandBuffer(const EspDrawCommandBuffer&)            = delete;
+    EspDrawCommandBuffer& operator=(const EspDrawCommandBuffer&) = delete;
+
+    /// @brief Default constructor.
+    EspDrawCommandBuffer() = default;
+    /// @brief Virtual destructor.
+    virtual ~EspDrawCommandBuffer() = default;
+
+    /// @brief Returns commands of the current frame. They can be written directly, the GPU reads them when the
+    /// frame is submitted.
+    /// @return Pointer to array of max command count commands.
+    virtual EspDrawIndexedCommand* get_commands() = 0;
+    /// @brief Sets number of commands of the current frame drawn by indirect draws with count.
+    /// @param count Number of commands.
+    virtual void set_command_count(uint32_t count) = 0;
+    /// @brief Returns number of commands of the current frame.
+    /// @return Number of commands.
+    virtual uint32_t get_command_count() const = 0;
+
+    /// @brief Copies commands to the current frame and sets their count.
+    /// @param commands Array of commands.
+    /// @param count Number of commands in array.
+    void write(const EspDrawIndexedCommand* commands, uint32_t count);
+
+    /// @brief Returns commands of all frames in flight as a storage buffer, so compute shaders can write them.
+    /// @return Storage buffer of commands. Null if the buffer can't be written by shaders.
+    virtual EspStorageBuffer* get_command_storage() { return nullptr; }
+    /// @brief Returns command counts of all frames in flight as a storage buffer (array of uint32).
+    /// @return Storage buffer of counts. Null if the buffer can't be written by shaders.
+    virtual EspStorageBuffer* get_count_storage() { return nullptr; }
+    /// @brief Returns index of the current frame's first command in the command storage.
+    /// @return Index of the command.
+    virtual uint32_t get_first_command_index() const { return 0; }
+    /// @brief Returns index of the current frame's count in the count storage.
+    /// @return Index of the count.
+    virtual uint32_t get_count_index() const { return 0; }
+
+    /// @brief Returns maximum number of commands in a single frame.
+    /// @return Maximum number of commands.
+    inline uint32_t get_max_command_count() const { return m_max_command_count; }
+  };
+} // namespace esp
+
+#endif // RENDER_API_ESP_DRAW_COMMAND_BUFFER_HH
@@ -5,7 +5,7 @@ namespace esp
 {
   EspShader::EspShader(const std::string& name) : m_name(name), m_worker_builder(EspWorkerBuilder::create()) {}
 
-  std::shared_ptr<EspShader> EspShader::create(const std::string& name, std::unique_ptr<SpirvResource> spirv_resource)
+  std::shared_ptr<EspShader> EspShader::create(const std::string& name, std::shared_ptr<SpirvResource> spirv_resource)
   {
     /* ---------------------------------------------------------*/
     /* ------------- PLATFORM DEPENDENT ------------------------*/
@@ -40,13 +40,24 @@ namespace esp
     m_worker_builder->set_attachment_formats(formats);
   }
 
-  void EspShader::attach() { m_worker->attach(); }
+  void EspShader::attach() { get_attached_worker().attach(); }
+
+  void EspShader::attach(EspCommandBufferId* id) { get_attached_worker().attach(id); }
 
   void EspShader::set_vertex_layouts(std::vector<EspVertexLayout> vertex_layouts)
   {
+    if (!get_reflection().is_compatible(vertex_layouts))
+    {
+      ESP_CORE_ERROR("Vertex layouts of shader {} don't match its vertex shader.", m_name);
+    }
     m_worker_builder->set_vertex_layouts(std::move(vertex_layouts));
   }
 
+  void EspShader::set_vertex_layouts()
+  {
+    m_worker_builder->set_vertex_layouts({ get_reflection().get_vertex_layout() });
+  }
+
   void EspShader::set_specialization(const SpecializationConstantMap& spec_const_map)
   {
     m_worker_builder->set_specialization(spec_const_map);
@@ -54,16 +65,29 @@ namespace esp
 
   void EspShader::set_worker_layout(std::unique_ptr<EspUniformMetaData> uniforms_meta_data)
   {
+    m_bindless_ds = uniforms_meta_data->get_bindless_descriptor_set();
     m_worker_builder->set_worker_layout(std::move(uniforms_meta_data));
   }
 
-  void EspShader::only_attach() const { m_worker->only_attach(); }
+  void EspShader::set_worker_layout()
+  {
+    auto uniforms_meta_data = EspUniformMetaData::create();
+    if (!get_reflection().fill_uniform_meta_data(*uniforms_meta_data))
+    {
+      ESP_CORE_ERROR("Uniforms of shader {} can't be described by EspUniformMetaData.", m_name);
+      throw std::runtime_error("Uniforms of shader can't be described by EspUniformMetaData.");
+    }
+
+    set_worker_layout(std::move(uniforms_meta_data));
+  }
+
+  void EspShader::only_attach() const { get_attached_worker().only_attach(); }
 
   void EspShader::set_viewport(EspViewport viewport) { m_worker->set_viewport(viewport); }
 
   void EspShader::set_scissors(EspScissorRect scissor_rect) { m_worker->set_scissors(scissor_rect); }
 
-  void EspShader::only_attach(EspCommandBufferId* id) const { m_worker->only_attach(id); }
+  void EspShader::only_attach(EspCommandBufferId* id) const { get_attached_worker().only_attach(id); }
 
   void EspShader::set_viewport(EspCommandBufferId* id, EspViewport viewport) { m_worker->set_viewport(id, viewport); }
 
@@ -72,5 +96,29 @@ namespace esp
     m_worker->set_scissors(id, scissor_rect);
   }
 
-  void EspShader::build_worker() { m_worker = m_worker_builder->build_worker(); }
+  void EspShader::build_worker()
+  {
+    m_worker = m_worker_builder->build_worker();
+
+    if (is_bindless())
+    {
+      m_bindless_uniform_manager = m_worker->create_uniform_manager(m_bindless_ds, m_bindless_ds);
+      m_bindless_uniform_manager->build();
+    }
+  }
+
+  const void* EspShader::get_layout_id() const { return m_worker->get_layout_id(); }
+
+  bool EspShader::is_ready() const { return m_worker && m_worker->is_ready(); }
+
+  void EspShader::set_placeholder(std::shared_ptr<EspShader> placeholder) { m_placeholder = std::move(placeholder); }
+
+  const EspWorker& EspShader::get_attached_worker() const
+  {
+    if (m_worker->is_ready() || !m_placeholder || !m_placeholder->is_ready()) { return *m_worker; }
+
+    // uniforms are bound with this shader's layout, so an incompatible placeholder can't be used
+    if (m_placeholder->m_worker->get_layout_hash() != m_worker->get_layout_hash()) { return *m_worker; }
+    return *m_placeholder->m_worker;
+  }
 } // namespace esp
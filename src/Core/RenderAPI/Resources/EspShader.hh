@@ -14,10 +14,16 @@ namespace esp
    protected:
     EspShader(const std::string& name);
 
+    std::shared_ptr<SpirvResource> m_spirv_resource;
     std::unique_ptr<EspWorkerBuilder> m_worker_builder;
     std::unique_ptr<EspWorker> m_worker;
+    std::shared_ptr<EspShader> m_placeholder;
+    std::unique_ptr<EspUniformManager> m_bindless_uniform_manager;
+    int32_t m_bindless_ds = -1;
     std::string m_name;
 
+    const EspWorker& get_attached_worker() const;
+
    public:
     /// @brief Virtual destructor
     virtual ~EspShader() = default;
@@ -25,11 +31,15 @@ namespace esp
 
     /// @brief Creates Espshader with the spirv resource.
     /// @param name Name of the shader.
-    /// @param spirv_resource SpirvResource containing the shader code.
+    /// @param spirv_resource SpirvResource containing the shader code. It may be shared with other shaders.
     /// @return Shared pointer to uninitialized EspShader.
-    static std::shared_ptr<EspShader> create(const std::string& name, std::unique_ptr<SpirvResource> spirv_resource);
+    static std::shared_ptr<EspShader> create(const std::string& name, std::shared_ptr<SpirvResource> spirv_resource);
     /// @brief Attach shader to use it in next operations.
     void attach();
+    /// @brief Attach shader to use it in next operations recorded to the command buffer. Viewport and scissors are
+    /// set as well, because dynamic state isn't inherited by secondary command buffers.
+    /// @param id Command buffer the commands are recorded to.
+    void attach(EspCommandBufferId* id);
     /// @brief Creates an EspUniformManager that is bound to this shader.
     /// @param start_managed_ds Id of the first descriptor set that this uniform manager will manage.
     /// @param end_managed_ds Id of the last descriptor set that this uniform manager will manage.
@@ -45,9 +55,12 @@ namespace esp
     /// @brief Sets pipeline attachement formats.
     /// @param formats List of block formats.
     void set_attachment_formats(std::vector<EspBlockFormat> formats);
-    /// @brief Sets the layout of vertices that will be shader's input.
+    /// @brief Sets the layout of vertices that will be shader's input. Logs an error if it doesn't provide every input
+    /// of the vertex shader.
     /// @param vertex_layouts List of structures describing each input.
     void set_vertex_layouts(std::vector<EspVertexLayout> vertex_layouts);
+    /// @brief Sets the layout of vertices reflected from the vertex shader. All inputs are interleaved in binding 0.
+    void set_vertex_layouts();
     /// @brief Sets specialization constant values for specific shader stages.
     /// @param spec_const_map Map containing specialzation constant data for shader stages.
     void set_specialization(const SpecializationConstantMap& spec_const_map);
@@ -55,6 +68,18 @@ namespace esp
     /// constants.
     /// @param uniforms_meta_data Object with data needed to configure uniforms.
     void set_worker_layout(std::unique_ptr<EspUniformMetaData> uniforms_meta_data);
+    /// @brief Sets uniform metadata reflected from all shader stages.
+    void set_worker_layout();
+    /// @brief Checks if the shader uses the descriptor set of EspBindlessTextures.
+    /// @return True if the shader is bindless. False otherwise.
+    inline bool is_bindless() const { return m_bindless_ds != -1; }
+    /// @brief Returns uniform manager binding the descriptor set of EspBindlessTextures. It is shared by all draws of
+    /// the shader, as material index is pushed to push uniform EspBindlessTextures::MATERIAL_PUSH_UNIFORM.
+    /// @return Pointer to the uniform manager. nullptr if the shader isn't bindless or its worker isn't built.
+    inline const EspUniformManager* get_bindless_uniform_manager() const { return m_bindless_uniform_manager.get(); }
+    /// @brief Returns interface of shader stages reflected from SPIR-V code.
+    /// @return Reference to SpirvReflection.
+    inline const SpirvReflection& get_reflection() const { return m_spirv_resource->get_reflection(); }
 
     void only_attach() const;
     void set_viewport(EspViewport viewport);
@@ -64,8 +89,18 @@ namespace esp
     void set_viewport(EspCommandBufferId* id, EspViewport viewport);
     void set_scissors(EspCommandBufferId* id, EspScissorRect scissor_rect);
 
-    /// @brief
+    /// @brief Schedules compilation of the shader's pipeline. Shaders with the same pipeline state share one pipeline.
     void build_worker();
+    /// @brief Returns identity of the shader's pipeline layout, which is shared by shaders with the same uniforms.
+    /// @return Identity of the layout. Shaders returning the same value keep each other's descriptor sets bound.
+    const void* get_layout_id() const;
+    /// @brief Checks if the shader's pipeline is compiled.
+    /// @return True if the shader can be attached without waiting. False otherwise.
+    bool is_ready() const;
+    /// @brief Sets shader attached instead of this one until its pipeline is compiled. The placeholder has to use
+    /// the same vertex layouts. If its worker layout differs, attaching waits for the compilation.
+    /// @param placeholder Shader with an already compiled pipeline.
+    void set_placeholder(std::shared_ptr<EspShader> placeholder);
   };
 } // namespace esp
 
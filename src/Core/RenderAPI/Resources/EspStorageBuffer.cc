@@ -0,0 +1,21 @@
+#include "EspStorageBuffer.hh"
+
+#include "Platform/Vulkan/Resources/VulkanStorageBuffer.hh"
+
+namespace esp
+{
+  std::unique_ptr<EspStorageBuffer> EspStorageBuffer::create(uint32_t size, void* data)
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    auto storage_buffer = VulkanStorageBuffer::create(size, data);
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+
+    return storage_buffer;
+  }
+} // namespace esp
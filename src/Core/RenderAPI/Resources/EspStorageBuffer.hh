@@ -0,0 +1,44 @@
+#ifndef RENDER_API_ESP_STORAGE_BUFFER_HH
+#define RENDER_API_ESP_STORAGE_BUFFER_HH
+
+#include "esppch.hh"
+
+namespace esp
+{
+  /// @brief Buffer in GPU's memory read and written by shaders, e.g. by compute shaders culling objects or skinning
+  /// vertices. It can be the source of indirect dispatches as well.
+  class EspStorageBuffer
+  {
+   protected:
+    uint32_t m_size;
+
+   public:
+    /// @brief Creates storage buffer for current graphic's API.
+    /// @param size Size of the buffer in bytes.
+    /// @param data Raw pointer to initial data of size bytes. Contents are undefined if it's null.
+    /// @return Unique pointer to instance of storage buffer.
+    static std::unique_ptr<EspStorageBuffer> create(uint32_t size, void* data = nullptr);
+
+    EspStorageBuffer(const EspStorageBuffer&)            = delete;
+    EspStorageBuffer& operator=(const EspStorageBuffer&) = delete;
+
+    /// @brief Default constructor.
+    EspStorageBuffer() = default;
+    /// @brief Virtual destructor.
+    virtual ~EspStorageBuffer() = default;
+
+    /// @brief Copies data to the buffer through a staging buffer. The copy is recorded into the command buffer of the
+    /// current frame, so it has to be called outside of render plans. Shaders of later commands see the data. Outside
+    /// of frames (e.g. while loading) the copy is submitted on its own and finished before returning.
+    /// @param offset Offset in the buffer in bytes.
+    /// @param size Size of the data in bytes.
+    /// @param data Raw pointer to the data.
+    virtual void update(uint32_t offset, uint32_t size, const void* data) = 0;
+
+    /// @brief Returns size of the buffer.
+    /// @return Size in bytes.
+    inline uint32_t get_size() const { return m_size; }
+  };
+} // namespace esp
+
+#endif // RENDER_API_ESP_STORAGE_BUFFER_HH
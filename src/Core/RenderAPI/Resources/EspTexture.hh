@@ -129,6 +129,8 @@ namespace esp
     uint32_t mip_levels = 1;
 
     bool as_cubemap = false;
+    // texture can be bound as a storage image, cubemaps can't
+    bool storage = false;
   };
 
   /// @brief Texture stored on the GPU.
@@ -0,0 +1,142 @@
+#include "EspDescriptorAllocator.hh"
+
+// std
+#include <chrono>
+
+namespace esp
+{
+  EspDescriptorAllocator::EspDescriptorAllocator(uint32_t frames_in_flight) :
+      m_frames_in_flight{ frames_in_flight }, m_frame_chains(frames_in_flight)
+  {
+  }
+
+  void EspDescriptorAllocator::terminate()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    ESP_CORE_TRACE("Descriptor allocator shutdown ({} pools, {} sets allocated, {} reused, {} dropped, {} per-frame, "
+                   "{:.2f} ms).",
+                   m_stats.m_pools_created,
+                   m_stats.m_sets_allocated,
+                   m_stats.m_sets_reused,
+                   m_stats.m_sets_dropped,
+                   m_stats.m_frame_sets_allocated,
+                   m_stats.m_allocation_time_ms);
+
+    for (auto pool : m_long_lived_chain.m_pools)
+    {
+      destroy_pool(pool);
+    }
+    for (auto& chain : m_frame_chains)
+    {
+      for (auto pool : chain.m_pools)
+      {
+        destroy_pool(pool);
+      }
+    }
+
+    m_long_lived_chain = {};
+    m_frame_chains     = std::vector<PoolChain>(m_frames_in_flight);
+    m_free_sets.clear();
+  }
+
+  uint64_t EspDescriptorAllocator::allocate(uint64_t layout)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // sets of the same layout are interchangeable, so freed ones are reused without touching the pools
+    if (auto it = m_free_sets.find(layout); it != m_free_sets.end() && !it->second.empty())
+    {
+      auto& free_sets = it->second;
+      if (free_sets.front().m_reusable_frame <= m_frame)
+      {
+        auto set = free_sets.front().m_set;
+        free_sets.pop_front();
+        m_stats.m_sets_reused++;
+        return set;
+      }
+    }
+
+    auto set = allocate_from(m_long_lived_chain, layout);
+    m_stats.m_sets_allocated++;
+    return set;
+  }
+
+  void EspDescriptorAllocator::free(uint64_t layout, uint64_t set)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_free_sets[layout].push_back({ set, m_frame + m_frames_in_flight });
+  }
+
+  void EspDescriptorAllocator::release_layout(uint64_t layout)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (auto it = m_free_sets.find(layout); it != m_free_sets.end())
+    {
+      m_stats.m_sets_dropped += static_cast<uint32_t>(it->second.size());
+      m_free_sets.erase(it);
+    }
+  }
+
+  uint64_t EspDescriptorAllocator::allocate_frame(uint64_t layout)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto set = allocate_from(m_frame_chains[m_frame_index], layout);
+    m_stats.m_frame_sets_allocated++;
+    return set;
+  }
+
+  void EspDescriptorAllocator::begin_frame(uint32_t frame_index)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_frame++;
+    m_frame_index = frame_index;
+
+    auto& chain = m_frame_chains[frame_index];
+    for (uint32_t i = 0; i < chain.m_pools.size() && i <= chain.m_current; i++)
+    {
+      reset_pool(chain.m_pools[i]);
+    }
+    chain.m_current = 0;
+  }
+
+  EspDescriptorAllocatorStats EspDescriptorAllocator::get_stats()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+  }
+
+  uint64_t EspDescriptorAllocator::allocate_from(PoolChain& chain, uint64_t layout)
+  {
+    auto start = std::chrono::steady_clock::now();
+
+    uint64_t set = 0;
+    while (!set)
+    {
+      if (chain.m_current == chain.m_pools.size())
+      {
+        chain.m_pools.push_back(create_pool(chain.m_next_size));
+        chain.m_next_size = std::min(chain.m_next_size * 2, MAX_POOL_SIZE);
+        m_stats.m_pools_created++;
+
+        set = allocate_set(chain.m_pools.back(), layout);
+        if (!set)
+        {
+          ESP_CORE_ERROR("Descriptor set doesn't fit into an empty pool!");
+          throw std::runtime_error("Descriptor set doesn't fit into an empty pool!");
+        }
+        break;
+      }
+
+      set = allocate_set(chain.m_pools[chain.m_current], layout);
+      if (!set) { chain.m_current++; }
+    }
+
+    m_stats.m_allocation_time_ms +=
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return set;
+  }
+} // namespace esp
@@ -0,0 +1,132 @@
+#ifndef CORE_RENDER_API_ESP_DESCRIPTOR_ALLOCATOR_HH
+#define CORE_RENDER_API_ESP_DESCRIPTOR_ALLOCATOR_HH
+
+#include "esppch.hh"
+
+// std
+#include <deque>
+#include <mutex>
+
+namespace esp
+{
+  /// @brief Counters describing the EspDescriptorAllocator since it was created.
+  struct EspDescriptorAllocatorStats
+  {
+    /// @brief Number of pools created.
+    uint32_t m_pools_created = 0;
+    /// @brief Number of long-lived sets allocated from pools.
+    uint32_t m_sets_allocated = 0;
+    /// @brief Number of long-lived sets served by a freed set.
+    uint32_t m_sets_reused = 0;
+    /// @brief Number of freed sets forgotten because their layout was destroyed.
+    uint32_t m_sets_dropped = 0;
+    /// @brief Number of per-frame sets allocated.
+    uint32_t m_frame_sets_allocated = 0;
+    /// @brief Time spent allocating sets, including pool creation, in milliseconds.
+    double m_allocation_time_ms = 0;
+  };
+
+  /// @brief Shared allocator of descriptor sets. Sets are allocated from chains of pools that grow when they run out of
+  /// space, so many uniform managers share few pools.
+  ///
+  /// Long-lived sets are returned to per-layout free-lists and reused once the GPU can't use them anymore. Free-lists
+  /// are keyed by the layout's handle, so they have to be released before the layout is destroyed. Per-frame sets are
+  /// allocated from the frame's own chain, which is reset in bulk when the frame begins again.
+  ///
+  /// Graphic's API objects are passed as opaque handles, platforms implement creation of pools and sets.
+  class EspDescriptorAllocator
+  {
+   public:
+    /// @brief Number of sets in the first pool of a chain.
+    static constexpr uint32_t MIN_POOL_SIZE = 64;
+    /// @brief Maximal number of sets in a pool. Every next pool of a chain is twice as big until this size.
+    static constexpr uint32_t MAX_POOL_SIZE = 4096;
+
+   private:
+    struct PoolChain
+    {
+      std::vector<uint64_t> m_pools;
+      uint32_t m_current   = 0;
+      uint32_t m_next_size = MIN_POOL_SIZE;
+    };
+
+    struct FreeSet
+    {
+      uint64_t m_set;
+      uint64_t m_reusable_frame;
+    };
+
+    uint32_t m_frames_in_flight;
+    uint32_t m_frame_index = 0;
+    uint64_t m_frame       = 0;
+
+    std::mutex m_mutex;
+    PoolChain m_long_lived_chain;
+    std::vector<PoolChain> m_frame_chains;
+    std::unordered_map<uint64_t, std::deque<FreeSet>> m_free_sets;
+
+    EspDescriptorAllocatorStats m_stats;
+
+   public:
+    /// @brief Creates allocator without any pools.
+    /// @param frames_in_flight Number of frames the GPU may be working on at once.
+    EspDescriptorAllocator(uint32_t frames_in_flight);
+    /// @brief Destroys allocator. Pools have to be destroyed with terminate() before.
+    virtual ~EspDescriptorAllocator() = default;
+
+    PREVENT_COPY(EspDescriptorAllocator);
+
+    /// @brief Logs statistics and destroys all pools, which frees all sets.
+    void terminate();
+
+    /// @brief Allocates set living until it is freed. Can be called from many threads.
+    /// @param layout Handle of the set's layout.
+    /// @return Handle of the set.
+    uint64_t allocate(uint64_t layout);
+    /// @brief Returns long-lived set to the allocator. It is reused after all frames in flight have finished, so the
+    /// set can still be used by submitted work. Can be called from many threads.
+    /// @param layout Handle of the set's layout.
+    /// @param set Handle of the set.
+    void free(uint64_t layout, uint64_t set);
+    /// @brief Forgets freed sets of the layout, so a layout created later with the same handle doesn't get them. Has
+    /// to be called before the layout is destroyed, sets of the layout mustn't be freed afterwards. Forgotten sets
+    /// stay in their pools until terminate(). Can be called from many threads.
+    /// @param layout Handle of the set's layout.
+    void release_layout(uint64_t layout);
+
+    /// @brief Allocates set valid until the current frame index begins again. Can be called from many threads.
+    /// @param layout Handle of the set's layout.
+    /// @return Handle of the set.
+    uint64_t allocate_frame(uint64_t layout);
+    /// @brief Resets sets of the frame and makes freed sets of old frames reusable. Has to be called after the GPU has
+    /// finished work of the previous frame with the same index.
+    /// @param frame_index Index of the frame in flight that begins.
+    void begin_frame(uint32_t frame_index);
+
+    /// @brief Returns statistics of the allocator.
+    /// @return Statistics of the allocator.
+    EspDescriptorAllocatorStats get_stats();
+
+   protected:
+    /// @brief Creates pool.
+    /// @param max_sets Maximal number of sets in the pool.
+    /// @return Handle of the pool.
+    virtual uint64_t create_pool(uint32_t max_sets) = 0;
+    /// @brief Destroys pool.
+    /// @param pool Handle of the pool.
+    virtual void destroy_pool(uint64_t pool) = 0;
+    /// @brief Frees all sets allocated from the pool.
+    /// @param pool Handle of the pool.
+    virtual void reset_pool(uint64_t pool) = 0;
+    /// @brief Allocates set from the pool.
+    /// @param pool Handle of the pool.
+    /// @param layout Handle of the set's layout.
+    /// @return Handle of the set. 0 if the pool has run out of space.
+    virtual uint64_t allocate_set(uint64_t pool, uint64_t layout) = 0;
+
+   private:
+    uint64_t allocate_from(PoolChain& chain, uint64_t layout);
+  };
+} // namespace esp
+
+#endif // CORE_RENDER_API_ESP_DESCRIPTOR_ALLOCATOR_HH
@@ -0,0 +1,58 @@
+#include "EspUniformArena.hh"
+
+namespace esp
+{
+  EspUniformArena::EspUniformArena(uint64_t frame_size, uint64_t alignment, uint32_t frames_in_flight) :
+      m_frame_size{ (frame_size + alignment - 1) / alignment * alignment }, m_alignment{ alignment },
+      m_frames_in_flight{ frames_in_flight }
+  {
+    // dynamic offsets are 32-bit
+    ESP_ASSERT(get_size() < INVALID_OFFSET, "Uniform arena is too big for dynamic offsets")
+  }
+
+  void EspUniformArena::terminate()
+  {
+    auto stats = get_stats();
+    ESP_CORE_TRACE("Uniform arena shutdown ({} allocations, {} failed, peak {} of {} bytes per frame).",
+                   stats.m_allocations,
+                   stats.m_failed_allocations,
+                   stats.m_peak_frame_bytes,
+                   m_frame_size);
+
+    destroy();
+  }
+
+  uint32_t EspUniformArena::allocate(const void* data, uint32_t size)
+  {
+    auto aligned_size = (size + m_alignment - 1) / m_alignment * m_alignment;
+    auto head         = m_head.fetch_add(aligned_size, std::memory_order_relaxed);
+
+    if (head + aligned_size > m_frame_size)
+    {
+      // only the first allocation that doesn't fit is reported
+      if (head <= m_frame_size) { ESP_CORE_ERROR("Uniform arena is full ({} bytes per frame).", m_frame_size); }
+      m_failed_allocations.fetch_add(1, std::memory_order_relaxed);
+      return INVALID_OFFSET;
+    }
+
+    auto offset = m_frame_index * m_frame_size + head;
+    write(offset, data, size);
+    m_allocations.fetch_add(1, std::memory_order_relaxed);
+
+    return static_cast<uint32_t>(offset);
+  }
+
+  void EspUniformArena::begin_frame(uint32_t frame_index)
+  {
+    m_peak_frame_bytes = std::max(m_peak_frame_bytes, std::min(m_head.load(), m_frame_size));
+    m_frame_index      = frame_index;
+    m_head             = 0;
+  }
+
+  EspUniformArenaStats EspUniformArena::get_stats() const
+  {
+    return { m_allocations.load(),
+             m_failed_allocations.load(),
+             std::max(m_peak_frame_bytes, std::min(m_head.load(), m_frame_size)) };
+  }
+} // namespace esp
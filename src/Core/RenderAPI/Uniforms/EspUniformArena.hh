@@ -0,0 +1,89 @@
+#ifndef CORE_RENDER_API_ESP_UNIFORM_ARENA_HH
+#define CORE_RENDER_API_ESP_UNIFORM_ARENA_HH
+
+#include "esppch.hh"
+
+// std
+#include <atomic>
+
+namespace esp
+{
+  /// @brief Counters describing the EspUniformArena since it was created.
+  struct EspUniformArenaStats
+  {
+    /// @brief Number of successful allocations.
+    uint64_t m_allocations = 0;
+    /// @brief Number of allocations that didn't fit into the frame's region.
+    uint64_t m_failed_allocations = 0;
+    /// @brief The largest number of bytes used by a single frame.
+    uint64_t m_peak_frame_bytes = 0;
+  };
+
+  /// @brief Per-frame linear allocator of uniform data. One persistently mapped buffer is split into a region per frame
+  /// in flight. Allocations bump an atomic head inside the region of the current frame, so uploading per-object data
+  /// costs one copy and gives an offset to be bound as a dynamic offset. The region is reset as a whole when its frame
+  /// begins again.
+  ///
+  /// Platforms own the buffer and implement writing to it.
+  class EspUniformArena
+  {
+   public:
+    /// @brief Offset returned when data doesn't fit into the frame's region.
+    static constexpr uint32_t INVALID_OFFSET = UINT32_MAX;
+    /// @brief Default size of the region of a single frame in bytes.
+    static constexpr uint64_t DEFAULT_FRAME_SIZE = 4 * 1024 * 1024;
+
+   private:
+    uint64_t m_frame_size;
+    uint64_t m_alignment;
+    uint32_t m_frames_in_flight;
+    uint32_t m_frame_index = 0;
+
+    std::atomic<uint64_t> m_head               = 0;
+    std::atomic<uint64_t> m_allocations        = 0;
+    std::atomic<uint64_t> m_failed_allocations = 0;
+    uint64_t m_peak_frame_bytes                = 0;
+
+   public:
+    /// @brief Creates arena.
+    /// @param frame_size Size of the region of a single frame. Rounded up to the alignment.
+    /// @param alignment Alignment of every allocation, e.g. minimal offset alignment of dynamic uniform buffers.
+    /// @param frames_in_flight Number of frames the GPU may be working on at once.
+    EspUniformArena(uint64_t frame_size, uint64_t alignment, uint32_t frames_in_flight);
+    /// @brief Destroys arena. Graphic's API objects have to be destroyed with terminate() before.
+    virtual ~EspUniformArena() = default;
+
+    PREVENT_COPY(EspUniformArena);
+
+    /// @brief Logs statistics and destroys the buffer.
+    void terminate();
+
+    /// @brief Copies data to the region of the current frame. Can be called from many threads.
+    /// @param data Pointer to the data.
+    /// @param size Size of the data.
+    /// @return Offset of the data from the beginning of the buffer or INVALID_OFFSET if the region is full.
+    uint32_t allocate(const void* data, uint32_t size);
+    /// @brief Resets the region of the frame. Has to be called after the GPU has finished work of the previous frame
+    /// with the same index.
+    /// @param frame_index Index of the frame in flight that begins.
+    void begin_frame(uint32_t frame_index);
+
+    /// @brief Returns size of the whole buffer.
+    /// @return Size of the region of a single frame times number of frames in flight.
+    inline uint64_t get_size() const { return m_frame_size * m_frames_in_flight; }
+    /// @brief Returns statistics of the arena.
+    /// @return Statistics of the arena.
+    EspUniformArenaStats get_stats() const;
+
+   protected:
+    /// @brief Writes data to the buffer.
+    /// @param offset Offset from the beginning of the buffer.
+    /// @param data Pointer to the data.
+    /// @param size Size of the data.
+    virtual void write(uint64_t offset, const void* data, uint32_t size) = 0;
+    /// @brief Destroys graphic's API objects.
+    virtual void destroy() = 0;
+  };
+} // namespace esp
+
+#endif // CORE_RENDER_API_ESP_UNIFORM_ARENA_HH
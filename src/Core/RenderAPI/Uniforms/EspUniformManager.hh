@@ -6,6 +6,7 @@
 #include "Core/RenderAPI/RenderPlans/Block/EspBlock.hh"
 #include "Core/RenderAPI/RenderPlans/Block/EspDepthBlock.hh"
 #include "Core/RenderAPI/RenderPlans/EspCommandBuffer.hh"
+#include "Core/RenderAPI/Resources/EspStorageBuffer.hh"
 #include "Core/Resources/Systems/TextureSystem.hh"
 #include "EspUniformMetaData.hh"
 
@@ -21,12 +22,27 @@ namespace esp
     virtual void attach() const                       = 0;
     virtual void attach(EspCommandBufferId* id) const = 0;
 
+    // Binds the sets with the given offsets of dynamic buffer uniforms (ordered by set and binding) instead of the ones
+    // set by update_dynamic_buffer_uniform. Draws recorded later than their data is written, e.g. by RenderQueue, have
+    // to use these, as the offsets kept by the manager are overwritten by every update.
+    virtual void attach(const uint32_t* dynamic_offsets, uint32_t count) const                         = 0;
+    virtual void attach(EspCommandBufferId* id, const uint32_t* dynamic_offsets, uint32_t count) const = 0;
+
     virtual EspUniformManager& update_buffer_uniform(uint32_t set,
                                                      uint32_t binding,
                                                      uint64_t offset,
                                                      uint32_t size,
                                                      void* data) = 0;
 
+    // Copies data of a dynamic buffer uniform to the per-frame uniform arena and returns its dynamic offset, which is
+    // used by the next attach() and can be passed to attach(dynamic_offsets, count). Returns
+    // EspUniformArena::INVALID_OFFSET and keeps the previous offset if the arena is full. Offsets are valid until the
+    // end of the frame.
+    virtual uint32_t update_dynamic_buffer_uniform(uint32_t set, uint32_t binding, uint32_t size, void* data) = 0;
+
+    // Makes the next attach() use an offset returned by update_dynamic_buffer_uniform in the same frame.
+    virtual EspUniformManager& set_dynamic_offset(uint32_t set, uint32_t binding, uint32_t offset) = 0;
+
     virtual EspUniformManager& set_buffer_uniform(uint32_t set,
                                                   uint32_t binding,
                                                   uint64_t offset,
@@ -38,8 +54,31 @@ namespace esp
 
     virtual EspUniformManager& load_texture(uint32_t set, uint32_t binding, std::shared_ptr<EspTexture> texture) = 0;
 
-    virtual const EspUniformManager& update_push_uniform(uint32_t index, void* data) const             = 0;
-    virtual EspUniformManager& update_push_uniform(EspCommandBufferId* id, uint32_t index, void* data) = 0;
+    // Copies data to a storage buffer created by the manager through a staging buffer. Read only buffers are updated
+    // for the current frame, like buffer uniforms. It has to be called outside of render plans.
+    virtual EspUniformManager& update_storage_buffer(uint32_t set,
+                                                     uint32_t binding,
+                                                     uint32_t offset,
+                                                     uint32_t size,
+                                                     const void* data) = 0;
+
+    // Same as update_storage_buffer, but read only buffers of all frames in flight are updated.
+    virtual EspUniformManager& set_storage_buffer(uint32_t set,
+                                                  uint32_t binding,
+                                                  uint32_t offset,
+                                                  uint32_t size,
+                                                  const void* data) = 0;
+
+    // Buffer has to outlive the manager, all frames in flight use the same buffer.
+    virtual EspUniformManager& load_storage_buffer(uint32_t set, uint32_t binding, EspStorageBuffer* buffer) = 0;
+
+    // Texture has to be created as storage and be in general layout when it's used.
+    virtual EspUniformManager& load_storage_image(uint32_t set,
+                                                  uint32_t binding,
+                                                  std::shared_ptr<EspTexture> texture) = 0;
+
+    virtual const EspUniformManager& update_push_uniform(uint32_t index, void* data) const                   = 0;
+    virtual const EspUniformManager& update_push_uniform(EspCommandBufferId* id, uint32_t index, void* data) const = 0;
   };
 
 } // namespace esp
@@ -9,13 +9,23 @@ namespace esp
   {
     ESP_VTX_STAGE,
     ESP_FRAG_STAGE,
-    ESP_ALL_STAGES
+    ESP_ALL_STAGES,
+    ESP_COMPUTE_STAGE
   };
 
   enum class EspUniformType
   {
     ESP_BUFFER_UNIFORM,
+    ESP_DYNAMIC_BUFFER_UNIFORM,
     ESP_TEXTURE,
+    ESP_STORAGE_BUFFER,
+    ESP_STORAGE_IMAGE,
+  };
+
+  enum class EspStorageBufferAccess
+  {
+    ESP_READ_ONLY,
+    ESP_READ_WRITE
   };
 
   struct EspUniformMetaData
@@ -24,19 +34,48 @@ namespace esp
     // Current descriptor set counter.
     int32_t m_current_ds_counter = -1;
 
+    // Index of the bindless descriptor set. -1 if there is none.
+    int32_t m_bindless_ds = -1;
+
    public:
     virtual ~EspUniformMetaData() {}
 
     virtual EspUniformMetaData& establish_descriptor_set() = 0;
 
+    // Establishes descriptor set holding textures and materials of EspBindlessTextures. No uniforms can be added to it.
+    virtual EspUniformMetaData& establish_bindless_descriptor_set() = 0;
+
     virtual EspUniformMetaData& add_buffer_uniform(EspUniformShaderStage stage,
                                                    uint32_t size_of_data_chunk,
                                                    uint32_t count_of_data_chunks = 1) = 0;
 
+    // Buffer uniform whose data lives in the per-frame uniform arena. It has no buffer of its own, data is bound by a
+    // dynamic offset returned by EspUniformManager::update_dynamic_buffer_uniform.
+    virtual EspUniformMetaData& add_dynamic_buffer_uniform(EspUniformShaderStage stage,
+                                                           uint32_t size_of_data_chunk) = 0;
+
     virtual EspUniformMetaData& add_texture_uniform(EspUniformShaderStage stage, uint32_t count_of_textures = 1) = 0;
 
+    // Storage buffer for data too large for a buffer uniform, e.g. instance arrays or light lists. If
+    // size_of_data_chunk isn't 0, the manager creates a device local buffer of count_of_data_chunks chunks, filled
+    // through a staging buffer by EspUniformManager::update_storage_buffer. Read only buffers have a copy per frame in
+    // flight, read-write ones are shared by all frames, so data written by shaders persists. Otherwise
+    // count_of_data_chunks buffers are bound by EspUniformManager::load_storage_buffer.
+    virtual EspUniformMetaData& add_storage_buffer_uniform(
+        EspUniformShaderStage stage,
+        uint32_t size_of_data_chunk   = 0,
+        uint32_t count_of_data_chunks = 1,
+        EspStorageBufferAccess access = EspStorageBufferAccess::ESP_READ_WRITE) = 0;
+
+    // Image read and written by shaders without a sampler, in general layout. Textures are bound by
+    // EspUniformManager::load_storage_image.
+    virtual EspUniformMetaData& add_storage_image_uniform(EspUniformShaderStage stage,
+                                                          uint32_t count_of_images = 1) = 0;
+
     virtual EspUniformMetaData& add_push_uniform(EspUniformShaderStage stage, uint32_t offset, uint32_t size) = 0;
 
+    inline int32_t get_bindless_descriptor_set() const { return m_bindless_ds; }
+
     static std::unique_ptr<EspUniformMetaData> create();
   };
 
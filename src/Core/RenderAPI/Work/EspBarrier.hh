@@ -0,0 +1,88 @@
+#ifndef RENDER_API_ESP_BARRIER_HH
+#define RENDER_API_ESP_BARRIER_HH
+
+#include "esppch.hh"
+
+namespace esp
+{
+  // dependencies of commands on earlier commands of the same command buffer, which use storage buffers and images
+  enum class EspBarrier
+  {
+    // writes of compute shaders are visible to next dispatches
+    ESP_BARRIER_COMPUTE_TO_COMPUTE,
+    // commands written by compute shaders are visible to indirect draws and dispatches
+    ESP_BARRIER_COMPUTE_TO_INDIRECT,
+    // writes of compute shaders are visible to vertex input and vertex shaders
+    ESP_BARRIER_COMPUTE_TO_VERTEX,
+    // writes of compute shaders are visible to fragment shaders
+    ESP_BARRIER_COMPUTE_TO_FRAGMENT,
+    // clears and copies are visible to compute shaders
+    ESP_BARRIER_TRANSFER_TO_COMPUTE,
+    // rendering is finished before compute shaders overwrite what it reads or writes
+    ESP_BARRIER_GRAPHICS_TO_COMPUTE,
+  };
+
+  using EspBarrierStageFlags = uint32_t;
+
+  // groups of pipeline stages a barrier waits for or blocks
+  enum EspBarrierStage : EspBarrierStageFlags
+  {
+    ESP_BARRIER_STAGE_TRANSFER   = 0x01,
+    ESP_BARRIER_STAGE_COMPUTE    = 0x02,
+    ESP_BARRIER_STAGE_INDIRECT   = 0x04,
+    ESP_BARRIER_STAGE_VERTEX     = 0x08,
+    ESP_BARRIER_STAGE_FRAGMENT   = 0x10,
+    ESP_BARRIER_STAGE_ATTACHMENT = 0x20,
+  };
+
+  /// @brief Stages which command buffers of compute only queues (e.g. the async compute one) can use.
+  inline constexpr EspBarrierStageFlags ESP_COMPUTE_QUEUE_STAGES =
+      ESP_BARRIER_STAGE_TRANSFER | ESP_BARRIER_STAGE_COMPUTE | ESP_BARRIER_STAGE_INDIRECT;
+
+  /// @brief Stages a barrier waits for (source) and stages which wait for the barrier (destination).
+  struct EspBarrierScope
+  {
+    EspBarrierStageFlags m_src_stages;
+    EspBarrierStageFlags m_dst_stages;
+  };
+
+  /// @brief Returns stages synchronized by the barrier.
+  /// @param barrier Barrier to be recorded.
+  /// @return Source and destination stages of the barrier.
+  inline constexpr EspBarrierScope esp_barrier_scope(EspBarrier barrier)
+  {
+    switch (barrier)
+    {
+    case EspBarrier::ESP_BARRIER_COMPUTE_TO_INDIRECT:
+      return { ESP_BARRIER_STAGE_COMPUTE, ESP_BARRIER_STAGE_INDIRECT };
+
+    case EspBarrier::ESP_BARRIER_COMPUTE_TO_VERTEX:
+      return { ESP_BARRIER_STAGE_COMPUTE, ESP_BARRIER_STAGE_VERTEX };
+
+    case EspBarrier::ESP_BARRIER_COMPUTE_TO_FRAGMENT:
+      return { ESP_BARRIER_STAGE_COMPUTE, ESP_BARRIER_STAGE_FRAGMENT };
+
+    case EspBarrier::ESP_BARRIER_TRANSFER_TO_COMPUTE:
+      return { ESP_BARRIER_STAGE_TRANSFER, ESP_BARRIER_STAGE_COMPUTE };
+
+    case EspBarrier::ESP_BARRIER_GRAPHICS_TO_COMPUTE:
+      return { ESP_BARRIER_STAGE_VERTEX | ESP_BARRIER_STAGE_FRAGMENT | ESP_BARRIER_STAGE_ATTACHMENT,
+               ESP_BARRIER_STAGE_COMPUTE };
+
+    default:
+      return { ESP_BARRIER_STAGE_COMPUTE, ESP_BARRIER_STAGE_COMPUTE };
+    }
+  }
+
+  /// @brief Checks if the barrier can be recorded into command buffers of compute only queues. Barriers involving
+  /// graphics stages have to be recorded into the frame's command buffer instead.
+  /// @param barrier Barrier to be recorded.
+  /// @return True if the barrier uses only ESP_COMPUTE_QUEUE_STAGES.
+  inline constexpr bool esp_barrier_is_compute_queue_compatible(EspBarrier barrier)
+  {
+    auto scope = esp_barrier_scope(barrier);
+    return ((scope.m_src_stages | scope.m_dst_stages) & ~ESP_COMPUTE_QUEUE_STAGES) == 0;
+  }
+} // namespace esp
+
+#endif // RENDER_API_ESP_BARRIER_HH
@@ -0,0 +1,102 @@
+#include "EspDeletionQueue.hh"
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  EspDeletionQueue* EspDeletionQueue::s_instance = nullptr;
+
+  EspDeletionQueue::EspDeletionQueue()
+  {
+    if (EspDeletionQueue::s_instance != nullptr)
+    {
+      throw std::runtime_error("The deletion queue instance already exists!");
+    }
+
+    EspDeletionQueue::s_instance = this;
+  }
+
+  EspDeletionQueue::~EspDeletionQueue() { terminate(); }
+
+  std::unique_ptr<EspDeletionQueue> EspDeletionQueue::create()
+  {
+    return std::unique_ptr<EspDeletionQueue>{ new EspDeletionQueue() };
+  }
+
+  void EspDeletionQueue::terminate()
+  {
+    if (s_instance != this) { return; }
+
+    // objects deferred by the destructions below are destroyed right away
+    EspDeletionQueue::s_instance = nullptr;
+    collect(UINT64_MAX);
+
+    ESP_CORE_TRACE("Deletion queue shutdown ({} destructions deferred, at most {} waiting at once).",
+                   m_stats.m_deferred,
+                   m_stats.m_peak_pending);
+  }
+
+  void EspDeletionQueue::begin_frame(uint64_t frame_value, uint64_t completed_value)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_frame_value = frame_value;
+    }
+
+    collect(completed_value);
+  }
+
+  void EspDeletionQueue::defer(std::function<void()> destroy)
+  {
+    if (!s_instance)
+    {
+      destroy();
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(s_instance->m_mutex);
+    s_instance->m_deletions.push_back({ s_instance->m_frame_value, std::move(destroy) });
+
+    auto& stats = s_instance->m_stats;
+    stats.m_deferred++;
+    stats.m_peak_pending = std::max<uint64_t>(stats.m_peak_pending, s_instance->m_deletions.size());
+  }
+
+  size_t EspDeletionQueue::get_pending_count()
+  {
+    if (!s_instance) { return 0; }
+
+    std::lock_guard<std::mutex> lock(s_instance->m_mutex);
+    return s_instance->m_deletions.size();
+  }
+
+  EspDeletionQueueStats EspDeletionQueue::get_stats()
+  {
+    if (!s_instance) { return {}; }
+
+    std::lock_guard<std::mutex> lock(s_instance->m_mutex);
+    return s_instance->m_stats;
+  }
+
+  void EspDeletionQueue::collect(uint64_t completed_value)
+  {
+    std::vector<std::function<void()>> destructions;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      while (!m_deletions.empty() && m_deletions.front().m_frame_value <= completed_value)
+      {
+        destructions.push_back(std::move(m_deletions.front().m_destroy));
+        m_deletions.pop_front();
+      }
+      m_stats.m_destroyed += destructions.size();
+    }
+
+    // outside of the lock, destructors of owned objects may defer more destructions
+    for (auto& destroy : destructions)
+    {
+      destroy();
+    }
+  }
+} // namespace esp
@@ -0,0 +1,82 @@
+#ifndef CORE_RENDER_API_ESP_DELETION_QUEUE_HH
+#define CORE_RENDER_API_ESP_DELETION_QUEUE_HH
+
+#include "esppch.hh"
+
+// std
+#include <deque>
+#include <mutex>
+
+namespace esp
+{
+  /// @brief Counters describing the EspDeletionQueue since it was created.
+  struct EspDeletionQueueStats
+  {
+    /// @brief Number of destructions deferred.
+    uint64_t m_deferred = 0;
+    /// @brief Number of deferred destructions already done.
+    uint64_t m_destroyed = 0;
+    /// @brief The largest number of destructions waiting at once.
+    uint64_t m_peak_pending = 0;
+  };
+
+  /// @brief Defers destruction of graphic's API objects until the GPU has finished every frame that could have used
+  /// them. A destruction deferred while frame n is recorded (or after it was submitted) is done once the GPU signals
+  /// value n of the frame pacer, so resources can be released mid-session without waiting for the device to idle.
+  ///
+  /// Without an instance, e.g. after the renderer was terminated, destructions are done right away.
+  class EspDeletionQueue
+  {
+   private:
+    struct Deletion
+    {
+      uint64_t m_frame_value;
+      std::function<void()> m_destroy;
+    };
+
+    static EspDeletionQueue* s_instance;
+
+    std::mutex m_mutex;
+    // frame values never decrease, so the queue stays sorted
+    std::deque<Deletion> m_deletions;
+    uint64_t m_frame_value = 0;
+
+    EspDeletionQueueStats m_stats;
+
+   public:
+    /// @brief Creates EspDeletionQueue singleton instance.
+    /// @return Unique pointer to EspDeletionQueue instance.
+    static std::unique_ptr<EspDeletionQueue> create();
+    /// @brief Terminates EspDeletionQueue.
+    ~EspDeletionQueue();
+
+    PREVENT_COPY(EspDeletionQueue);
+
+    /// @brief Does every waiting destruction and destroys EspDeletionQueue instance. GPU has to be idle.
+    void terminate();
+
+    /// @brief Does destructions of finished frames. Has to be called once per frame, after the frame pacer has begun
+    /// the frame.
+    /// @param frame_value Value of the frame that begins.
+    /// @param completed_value Value of the newest frame the GPU has finished.
+    void begin_frame(uint64_t frame_value, uint64_t completed_value);
+
+    /// @brief Defers destruction until the GPU has finished the current frame. Can be called from many threads.
+    /// @param destroy Function destroying graphic's API objects.
+    static void defer(std::function<void()> destroy);
+
+    /// @brief Returns number of destructions waiting for the GPU.
+    /// @return Number of waiting destructions. 0 if there is no instance.
+    static size_t get_pending_count();
+    /// @brief Returns statistics of the EspDeletionQueue.
+    /// @return Statistics of the EspDeletionQueue.
+    static EspDeletionQueueStats get_stats();
+
+   private:
+    EspDeletionQueue();
+
+    void collect(uint64_t completed_value);
+  };
+} // namespace esp
+
+#endif // CORE_RENDER_API_ESP_DELETION_QUEUE_HH
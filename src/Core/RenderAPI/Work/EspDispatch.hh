@@ -0,0 +1,18 @@
+#ifndef RENDER_API_ESP_DISPATCH_HH
+#define RENDER_API_ESP_DISPATCH_HH
+
+#include "esppch.hh"
+
+namespace esp
+{
+  /// @brief Returns number of work groups covering all invocations.
+  /// @param invocation_count Number of invocations along an axis (e.g. elements or pixels).
+  /// @param local_size Local size of the compute shader along the axis.
+  /// @return Number of work groups along the axis.
+  inline constexpr uint32_t esp_group_count(uint32_t invocation_count, uint32_t local_size)
+  {
+    return invocation_count / local_size + (invocation_count % local_size != 0);
+  }
+} // namespace esp
+
+#endif // RENDER_API_ESP_DISPATCH_HH
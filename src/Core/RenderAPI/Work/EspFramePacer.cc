@@ -0,0 +1,56 @@
+#include "EspFramePacer.hh"
+
+// std
+#include <chrono>
+
+namespace esp
+{
+  EspFramePacer::EspFramePacer(uint32_t frames_in_flight, EspFramePacingMode mode) :
+      m_frames_in_flight{ clamp_frames_in_flight(frames_in_flight) }, m_mode{ mode }
+  {
+  }
+
+  uint32_t EspFramePacer::clamp_frames_in_flight(uint32_t frames_in_flight)
+  {
+    auto clamped = std::clamp<uint32_t>(frames_in_flight, 1, MAX_FRAMES_IN_FLIGHT);
+    if (clamped != frames_in_flight)
+    {
+      ESP_CORE_WARN("{} frames in flight aren't supported, {} are used.", frames_in_flight, clamped);
+    }
+
+    return clamped;
+  }
+
+  void EspFramePacer::terminate()
+  {
+    ESP_CORE_TRACE("Frame pacer shutdown ({} frames, {} waited for the GPU for {:.2f} ms in total).",
+                   m_stats.m_frames,
+                   m_stats.m_waits,
+                   m_stats.m_wait_time);
+
+    destroy();
+  }
+
+  uint32_t EspFramePacer::begin_frame()
+  {
+    auto next_value = m_frame_value + 1;
+
+    uint64_t wait_value = next_value > m_frames_in_flight ? next_value - m_frames_in_flight : 0;
+    if (m_mode == ESP_FRAME_PACING_LOW_LATENCY && next_value > 1) { wait_value = next_value - 1; }
+
+    if (wait_value > 0 && query_completed_value() < wait_value)
+    {
+      auto start = std::chrono::steady_clock::now();
+      wait_for_value(wait_value);
+
+      m_stats.m_waits++;
+      m_stats.m_wait_time +=
+          std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    m_frame_value = next_value;
+    m_stats.m_frames++;
+
+    return get_frame_index();
+  }
+} // namespace esp
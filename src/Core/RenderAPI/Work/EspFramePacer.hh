@@ -0,0 +1,99 @@
+#ifndef CORE_RENDER_API_ESP_FRAME_PACER_HH
+#define CORE_RENDER_API_ESP_FRAME_PACER_HH
+
+#include "esppch.hh"
+
+#include "Core/EspApplicationParams.hh"
+
+namespace esp
+{
+  /// @brief Counters describing the EspFramePacer since it was created.
+  struct EspFramePacerStats
+  {
+    /// @brief Number of frames begun.
+    uint64_t m_frames = 0;
+    /// @brief Number of frames that had to wait for the GPU.
+    uint64_t m_waits = 0;
+    /// @brief Time spent waiting for the GPU in milliseconds.
+    double m_wait_time = 0.0;
+  };
+
+  /// @brief Decides when the CPU may begin recording a new frame. Every frame gets a value that grows by one and is
+  /// signaled by the GPU once the frame's work is done, so lifetime of per-frame resources can be expressed with these
+  /// values instead of the index of the frame in flight.
+  ///
+  /// Frame n may begin once frame n - frames in flight has finished. In ESP_FRAME_PACING_LOW_LATENCY mode it waits for
+  /// frame n - 1 instead, so the CPU never records a frame while the GPU renders an earlier one, whatever the number of
+  /// frames in flight. The pacer waits only when the CPU is ahead, never when the GPU has already caught up.
+  ///
+  /// Platforms signal the values and implement waiting for them.
+  class EspFramePacer
+  {
+   public:
+    /// @brief Upper bound of the number of frames in flight.
+    static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 4;
+
+   private:
+    uint32_t m_frames_in_flight;
+    EspFramePacingMode m_mode;
+    uint64_t m_frame_value = 0;
+
+    EspFramePacerStats m_stats;
+
+   public:
+    /// @brief Creates pacer.
+    /// @param frames_in_flight Number of frames the GPU may be working on at once. Clamped to 1-MAX_FRAMES_IN_FLIGHT.
+    /// @param mode How far the CPU may get ahead of the GPU.
+    EspFramePacer(uint32_t frames_in_flight, EspFramePacingMode mode);
+    /// @brief Destroys pacer. Graphic's API objects have to be destroyed with terminate() before.
+    virtual ~EspFramePacer() = default;
+
+    PREVENT_COPY(EspFramePacer);
+
+    /// @brief Logs statistics and destroys graphic's API objects.
+    void terminate();
+
+    /// @brief Waits until the GPU is far enough behind and begins the next frame.
+    /// @return Index of the frame in flight that begins.
+    uint32_t begin_frame();
+
+    /// @brief Returns the value signaled when the current frame is finished.
+    /// @return Value of the current frame. 0 before the first frame.
+    inline uint64_t get_frame_value() const { return m_frame_value; }
+    /// @brief Returns index of the current frame in flight.
+    /// @return Index of the current frame in flight.
+    inline uint32_t get_frame_index() const
+    {
+      return m_frame_value ? static_cast<uint32_t>((m_frame_value - 1) % m_frames_in_flight) : 0;
+    }
+    /// @brief Returns value of the newest frame the GPU has finished.
+    /// @return Value of the newest finished frame.
+    inline uint64_t get_completed_value() { return query_completed_value(); }
+    /// @brief Returns number of frames in flight.
+    /// @return Number of frames the GPU may be working on at once.
+    inline uint32_t get_frames_in_flight() const { return m_frames_in_flight; }
+    /// @brief Returns pacing mode.
+    /// @return How far the CPU may get ahead of the GPU.
+    inline EspFramePacingMode get_mode() const { return m_mode; }
+    /// @brief Returns statistics of the pacer.
+    /// @return Statistics of the pacer.
+    inline const EspFramePacerStats& get_stats() const { return m_stats; }
+
+    /// @brief Clamps number of frames in flight to the supported range and warns if it had to be changed.
+    /// @param frames_in_flight Requested number of frames in flight.
+    /// @return Number of frames in flight between 1 and MAX_FRAMES_IN_FLIGHT.
+    static uint32_t clamp_frames_in_flight(uint32_t frames_in_flight);
+
+   protected:
+    /// @brief Returns value of the newest frame the GPU has finished without waiting.
+    /// @return Value of the newest finished frame.
+    virtual uint64_t query_completed_value() = 0;
+    /// @brief Blocks until the GPU finishes the frame.
+    /// @param value Value of the frame.
+    virtual void wait_for_value(uint64_t value) = 0;
+    /// @brief Destroys graphic's API objects.
+    virtual void destroy() = 0;
+  };
+} // namespace esp
+
+#endif // CORE_RENDER_API_ESP_FRAME_PACER_HH
@@ -0,0 +1,262 @@
+#include "EspGpuProfiler.hh"
+
+#include "Platform/Vulkan/Work/VulkanGpuProfiler.hh"
+
+// std
+#include <iomanip>
+
+// signatures
+static std::string escape_json(const std::string& text);
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  EspGpuProfiler* EspGpuProfiler::s_instance = nullptr;
+
+  EspGpuProfiler::EspGpuProfiler(uint32_t frames_in_flight, bool statistics_supported) :
+      m_statistics_supported{ statistics_supported }, m_slots(frames_in_flight)
+  {
+    if (EspGpuProfiler::s_instance != nullptr)
+    {
+      throw std::runtime_error("The GPU profiler instance already exists!");
+    }
+
+    EspGpuProfiler::s_instance = this;
+  }
+
+  EspGpuProfiler::~EspGpuProfiler()
+  {
+    if (s_instance == this) { s_instance = nullptr; }
+  }
+
+  std::unique_ptr<EspGpuProfiler> EspGpuProfiler::create(const fs::path& trace_path)
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    auto profiler = VulkanGpuProfiler::create();
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+
+    if (profiler)
+    {
+      if (!trace_path.empty()) { profiler->open_trace(trace_path); }
+      ESP_CORE_TRACE("GPU profiler initialized.");
+    }
+    return profiler;
+  }
+
+  void EspGpuProfiler::terminate()
+  {
+    if (s_instance != this) { return; }
+
+    // the GPU is idle, so frames still in flight can be resolved (oldest first)
+    std::vector<uint32_t> recorded_slots;
+    for (uint32_t i = 0; i < m_slots.size(); i++)
+    {
+      if (m_slots[i].m_recorded) { recorded_slots.push_back(i); }
+    }
+    std::sort(recorded_slots.begin(),
+              recorded_slots.end(),
+              [this](uint32_t a, uint32_t b) { return m_slots[a].m_frame_value < m_slots[b].m_frame_value; });
+    for (auto frame_index : recorded_slots)
+    {
+      resolve(frame_index);
+    }
+
+    if (m_trace.is_open()) { m_trace << "\n]}\n"; }
+    m_trace.close();
+
+    if (m_ignored_scopes > 0)
+    {
+      ESP_CORE_WARN("GPU profiler ignored {} scopes above the limit of {} per frame.", m_ignored_scopes, MAX_SCOPES);
+    }
+    ESP_CORE_TRACE("GPU profiler shutdown.");
+
+    EspGpuProfiler::s_instance = nullptr;
+    destroy();
+  }
+
+  void EspGpuProfiler::open_trace(const fs::path& trace_path)
+  {
+    m_trace.open(trace_path, std::ios::out | std::ios::trunc);
+    if (!m_trace)
+    {
+      ESP_CORE_ERROR("Cannot open GPU trace file {}.", trace_path.string());
+      return;
+    }
+
+    m_trace << "{\"traceEvents\":[\n";
+    m_trace << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"GPU\"}}";
+  }
+
+  void EspGpuProfiler::begin_frame(uint32_t frame_index, uint64_t frame_value)
+  {
+    if (!s_instance) { return; }
+
+    // the frame pacer has waited for the previous frame with this index, so its results are available
+    s_instance->resolve(frame_index);
+
+    auto& slot         = s_instance->m_slots[frame_index];
+    slot.m_frame_value = frame_value;
+    slot.m_recorded    = true;
+    slot.m_scopes.clear();
+
+    s_instance->m_frame_index = frame_index;
+    s_instance->m_recording   = true;
+    s_instance->m_open_scopes.clear();
+
+    s_instance->reset_queries(frame_index);
+    s_instance->write_timestamp(frame_index, 0, false);
+  }
+
+  void EspGpuProfiler::end_frame()
+  {
+    if (!s_instance || !s_instance->m_recording) { return; }
+
+    if (!s_instance->m_open_scopes.empty())
+    {
+      ESP_CORE_WARN("{} GPU profiler scopes weren't ended before the end of the frame.",
+                    s_instance->m_open_scopes.size());
+      while (!s_instance->m_open_scopes.empty())
+      {
+        end_scope();
+      }
+    }
+
+    s_instance->write_timestamp(s_instance->m_frame_index, 1, true);
+    s_instance->m_recording = false;
+  }
+
+  void EspGpuProfiler::begin_scope(const std::string& name)
+  {
+    if (!s_instance || !s_instance->m_recording) { return; }
+
+    auto& open_scopes = s_instance->m_open_scopes;
+    auto& scopes      = s_instance->m_slots[s_instance->m_frame_index].m_scopes;
+    if (scopes.size() == MAX_SCOPES)
+    {
+      // still pushed, so the matching end_scope() is ignored as well
+      s_instance->m_ignored_scopes++;
+      open_scopes.push_back(IGNORED_SCOPE);
+      return;
+    }
+
+    auto index      = static_cast<uint32_t>(scopes.size());
+    bool statistics = s_instance->m_statistics_supported && open_scopes.empty();
+    scopes.push_back({ name, static_cast<uint32_t>(open_scopes.size()), statistics });
+    open_scopes.push_back(index);
+
+    s_instance->write_timestamp(s_instance->m_frame_index, 2 + 2 * index, false);
+    if (statistics) { s_instance->begin_statistics(s_instance->m_frame_index, index); }
+  }
+
+  void EspGpuProfiler::end_scope()
+  {
+    if (!s_instance || !s_instance->m_recording || s_instance->m_open_scopes.empty()) { return; }
+
+    auto index = s_instance->m_open_scopes.back();
+    s_instance->m_open_scopes.pop_back();
+    if (index == IGNORED_SCOPE) { return; }
+
+    auto& scope = s_instance->m_slots[s_instance->m_frame_index].m_scopes[index];
+    if (scope.m_statistics) { s_instance->end_statistics(s_instance->m_frame_index, index); }
+    s_instance->write_timestamp(s_instance->m_frame_index, 3 + 2 * index, true);
+  }
+
+  EspGpuFrameTimings EspGpuProfiler::get_last_frame_timings()
+  {
+    if (!s_instance) { return {}; }
+
+    std::lock_guard<std::mutex> lock(s_instance->m_mutex);
+    return s_instance->m_last_frame;
+  }
+
+  void EspGpuProfiler::resolve(uint32_t frame_index)
+  {
+    auto& slot = m_slots[frame_index];
+    if (!slot.m_recorded) { return; }
+    slot.m_recorded = false;
+
+    std::vector<double> timestamps;
+    auto count = static_cast<uint32_t>(2 + 2 * slot.m_scopes.size());
+    if (!read_timestamps(frame_index, count, timestamps))
+    {
+      ESP_CORE_WARN("GPU timings of frame {} aren't available.", slot.m_frame_value);
+      return;
+    }
+
+    EspGpuFrameTimings frame;
+    frame.m_frame_value = slot.m_frame_value;
+    frame.m_frame_time  = (timestamps[1] - timestamps[0]) / 1e6;
+
+    for (uint32_t i = 0; i < slot.m_scopes.size(); i++)
+    {
+      auto& scope = slot.m_scopes[i];
+
+      EspGpuScopeTiming timing;
+      timing.m_name  = scope.m_name;
+      timing.m_depth = scope.m_depth;
+      timing.m_begin = (timestamps[2 + 2 * i] - timestamps[0]) / 1e6;
+      timing.m_time  = (timestamps[3 + 2 * i] - timestamps[2 + 2 * i]) / 1e6;
+      if (scope.m_statistics) { timing.m_has_statistics = read_statistics(frame_index, i, timing.m_statistics); }
+
+      frame.m_scopes.push_back(std::move(timing));
+    }
+
+    if (m_trace.is_open()) { write_trace(frame, timestamps[0]); }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_last_frame = std::move(frame);
+  }
+
+  void EspGpuProfiler::write_trace(const EspGpuFrameTimings& frame, double frame_begin)
+  {
+    // timestamps are in microseconds since the first resolved frame
+    if (m_trace_origin < 0.0) { m_trace_origin = frame_begin; }
+    double frame_ts = (frame_begin - m_trace_origin) / 1e3;
+
+    m_trace << std::fixed << std::setprecision(3);
+    m_trace << ",\n{\"name\":\"Frame\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":" << frame_ts
+            << ",\"dur\":" << frame.m_frame_time * 1e3 << ",\"args\":{\"frame\":" << frame.m_frame_value << "}}";
+
+    for (auto& scope : frame.m_scopes)
+    {
+      m_trace << ",\n{\"name\":\"" << escape_json(scope.m_name) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":"
+              << frame_ts + scope.m_begin * 1e3 << ",\"dur\":" << scope.m_time * 1e3 << ",\"args\":{";
+      if (scope.m_has_statistics)
+      {
+        auto& statistics = scope.m_statistics;
+        m_trace << "\"vertices\":" << statistics.m_input_assembly_vertices
+                << ",\"primitives\":" << statistics.m_input_assembly_primitives
+                << ",\"vertex_invocations\":" << statistics.m_vertex_shader_invocations
+                << ",\"clipped_primitives\":" << statistics.m_clipping_primitives
+                << ",\"fragment_invocations\":" << statistics.m_fragment_shader_invocations;
+      }
+      m_trace << "}}";
+    }
+  }
+} // namespace esp
+
+/* --------------------------------------------------------- */
+/* ------------------ HELPFUL FUNCTIONS -------------------- */
+/* --------------------------------------------------------- */
+
+static std::string escape_json(const std::string& text)
+{
+  std::string escaped;
+  escaped.reserve(text.size());
+  for (char c : text)
+  {
+    if (c == '"' || c == '\\') { escaped.push_back('\\'); }
+    if (static_cast<unsigned char>(c) < 0x20) { continue; }
+    escaped.push_back(c);
+  }
+  return escaped;
+}
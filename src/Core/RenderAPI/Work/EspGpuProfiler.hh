@@ -0,0 +1,194 @@
+#ifndef CORE_RENDER_API_ESP_GPU_PROFILER_HH
+#define CORE_RENDER_API_ESP_GPU_PROFILER_HH
+
+#include "esppch.hh"
+
+// std
+#include <fstream>
+#include <mutex>
+
+namespace esp
+{
+  /// @brief Pipeline statistics of a profiler scope.
+  struct EspPipelineStatistics
+  {
+    /// @brief Number of vertices read by the input assembler.
+    uint64_t m_input_assembly_vertices = 0;
+    /// @brief Number of primitives read by the input assembler.
+    uint64_t m_input_assembly_primitives = 0;
+    /// @brief Number of vertex shader invocations.
+    uint64_t m_vertex_shader_invocations = 0;
+    /// @brief Number of primitives output by the clipping stage.
+    uint64_t m_clipping_primitives = 0;
+    /// @brief Number of fragment shader invocations.
+    uint64_t m_fragment_shader_invocations = 0;
+  };
+
+  /// @brief GPU timing of a profiler scope.
+  struct EspGpuScopeTiming
+  {
+    /// @brief Name given to the scope.
+    std::string m_name;
+    /// @brief Number of scopes the scope is nested in.
+    uint32_t m_depth = 0;
+    /// @brief Time between the beginning of the frame and the beginning of the scope in milliseconds.
+    double m_begin = 0.0;
+    /// @brief Duration of the scope in milliseconds.
+    double m_time = 0.0;
+    /// @brief True if m_statistics were collected. Only outermost scopes have them.
+    bool m_has_statistics = false;
+    /// @brief Pipeline statistics of the scope.
+    EspPipelineStatistics m_statistics;
+  };
+
+  /// @brief GPU timings of a frame.
+  struct EspGpuFrameTimings
+  {
+    /// @brief Value of the frame (see EspFramePacer). 0 if no frame was resolved yet.
+    uint64_t m_frame_value = 0;
+    /// @brief Time between the first and the last command of the frame in milliseconds.
+    double m_frame_time = 0.0;
+    /// @brief Scopes of the frame in order they were begun.
+    std::vector<EspGpuScopeTiming> m_scopes;
+  };
+
+  /// @brief Measures how long named scopes of a frame take on the GPU. Every frame in flight has its own timestamp and
+  /// pipeline statistics queries, which are read once the frame pacer lets the frame index be reused, so reading the
+  /// results never waits for the GPU. Results are one frame in flight old.
+  ///
+  /// Render plans are profiled automatically, other scopes can be added with begin_scope() and end_scope() while the
+  /// frame is recorded. Scopes are recorded into the primary command buffer of the frame, so they can't be begun while
+  /// a secondary command buffer is recorded or inside a render plan with secondary contents. Pipeline statistics can't
+  /// be nested, so only outermost scopes get them.
+  ///
+  /// It is optional. When the instance doesn't exist, scopes aren't recorded.
+  class EspGpuProfiler
+  {
+   public:
+    /// @brief Maximal number of scopes of a frame. Scopes above it are ignored.
+    static constexpr uint32_t MAX_SCOPES = 128;
+    /// @brief Number of timestamps of a frame in flight: the frame's beginning and end and both ends of every scope.
+    static constexpr uint32_t MAX_TIMESTAMPS = 2 + 2 * MAX_SCOPES;
+
+   private:
+    struct Scope
+    {
+      std::string m_name;
+      uint32_t m_depth;
+      bool m_statistics;
+    };
+
+    struct FrameSlot
+    {
+      uint64_t m_frame_value = 0;
+      bool m_recorded        = false;
+      std::vector<Scope> m_scopes;
+    };
+
+    static constexpr uint32_t IGNORED_SCOPE = UINT32_MAX;
+
+   protected:
+    static EspGpuProfiler* s_instance;
+
+   private:
+    bool m_statistics_supported;
+    std::vector<FrameSlot> m_slots;
+
+    uint32_t m_frame_index = 0;
+    bool m_recording       = false;
+    std::vector<uint32_t> m_open_scopes;
+    uint64_t m_ignored_scopes = 0;
+
+    std::mutex m_mutex;
+    EspGpuFrameTimings m_last_frame;
+
+    std::ofstream m_trace;
+    double m_trace_origin = -1.0;
+
+   protected:
+    /// @brief Creates profiler.
+    /// @param frames_in_flight Number of frames the GPU may be working on at once.
+    /// @param statistics_supported True if pipeline statistics can be collected.
+    EspGpuProfiler(uint32_t frames_in_flight, bool statistics_supported);
+
+   public:
+    /// @brief Terminates EspGpuProfiler.
+    virtual ~EspGpuProfiler();
+
+    PREVENT_COPY(EspGpuProfiler);
+
+    /// @brief Creates EspGpuProfiler singleton instance.
+    /// @param trace_path File the timings of every frame are written to, in Chrome trace format (chrome://tracing,
+    /// Perfetto). Empty path disables the file.
+    /// @return Unique pointer to EspGpuProfiler instance. nullptr if the device can't write timestamps.
+    static std::unique_ptr<EspGpuProfiler> create(const fs::path& trace_path = {});
+
+    /// @brief Resolves frames still in flight, closes the trace file and destroys EspGpuProfiler instance. GPU has to
+    /// be idle.
+    void terminate();
+
+    /// @brief Opens the trace file. Frames resolved from now on are written to it.
+    /// @param trace_path Path of the trace file.
+    void open_trace(const fs::path& trace_path);
+
+    /// @brief Checks if the GPU is profiled.
+    /// @return True if the instance exists. False otherwise.
+    static inline bool is_enabled() { return s_instance != nullptr; }
+
+    /// @brief Resolves the previous frame with the same index and starts measuring the frame. Has to be called once
+    /// per frame, after its primary command buffer has begun.
+    /// @param frame_index Index of the frame in flight.
+    /// @param frame_value Value of the frame.
+    static void begin_frame(uint32_t frame_index, uint64_t frame_value);
+    /// @brief Ends measuring the frame. Has to be called before its primary command buffer ends.
+    static void end_frame();
+
+    /// @brief Begins a named scope of the frame being recorded.
+    /// @param name Name of the scope.
+    static void begin_scope(const std::string& name);
+    /// @brief Ends the scope begun last.
+    static void end_scope();
+
+    /// @brief Returns timings of the newest resolved frame.
+    /// @return Timings of the newest resolved frame. Empty if there is no instance or no frame was resolved yet.
+    static EspGpuFrameTimings get_last_frame_timings();
+
+   protected:
+    /// @brief Resets queries of a frame in flight.
+    /// @param frame_index Index of the frame in flight.
+    virtual void reset_queries(uint32_t frame_index) = 0;
+    /// @brief Writes a timestamp.
+    /// @param frame_index Index of the frame in flight.
+    /// @param query Index of the timestamp within the frame.
+    /// @param end True if the timestamp is written after previous commands finish, false if before they start.
+    virtual void write_timestamp(uint32_t frame_index, uint32_t query, bool end) = 0;
+    /// @brief Begins pipeline statistics query of a scope.
+    /// @param frame_index Index of the frame in flight.
+    /// @param scope Index of the scope within the frame.
+    virtual void begin_statistics(uint32_t frame_index, uint32_t scope) = 0;
+    /// @brief Ends pipeline statistics query of a scope.
+    /// @param frame_index Index of the frame in flight.
+    /// @param scope Index of the scope within the frame.
+    virtual void end_statistics(uint32_t frame_index, uint32_t scope) = 0;
+    /// @brief Reads timestamps of a finished frame.
+    /// @param frame_index Index of the frame in flight.
+    /// @param count Number of timestamps to read.
+    /// @param timestamps Timestamps in nanoseconds.
+    /// @return True if all timestamps were available.
+    virtual bool read_timestamps(uint32_t frame_index, uint32_t count, std::vector<double>& timestamps) = 0;
+    /// @brief Reads pipeline statistics of a scope of a finished frame.
+    /// @param frame_index Index of the frame in flight.
+    /// @param scope Index of the scope within the frame.
+    /// @param statistics Pipeline statistics of the scope.
+    /// @return True if the statistics were available.
+    virtual bool read_statistics(uint32_t frame_index, uint32_t scope, EspPipelineStatistics& statistics) = 0;
+    /// @brief Destroys graphic's API objects.
+    virtual void destroy() = 0;
+
+   private:
+    void resolve(uint32_t frame_index);
+    void write_trace(const EspGpuFrameTimings& frame, double frame_begin);
+  };
+} // namespace esp
+
+#endif // CORE_RENDER_API_ESP_GPU_PROFILER_HH
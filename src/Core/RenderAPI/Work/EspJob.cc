@@ -98,6 +98,168 @@ namespace esp
     /* ---------------------------------------------------------*/
   }
 
+  void EspJob::draw_indexed_indirect(EspDrawCommandBuffer& buffer, uint32_t first_command, uint32_t draw_count)
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    VulkanJob::draw_indexed_indirect(buffer, first_command, draw_count);
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+  }
+
+  void EspJob::draw_indexed_indirect(EspCommandBufferId* id,
+                                     EspDrawCommandBuffer& buffer,
+                                     uint32_t first_command,
+                                     uint32_t draw_count)
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    VulkanJob::draw_indexed_indirect(id, buffer, first_command, draw_count);
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+  }
+
+  void EspJob::draw_indexed_indirect_count(EspDrawCommandBuffer& buffer)
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    VulkanJob::draw_indexed_indirect_count(buffer);
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+  }
+
+  void EspJob::draw_indexed_indirect_count(EspCommandBufferId* id, EspDrawCommandBuffer& buffer)
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    VulkanJob::draw_indexed_indirect_count(id, buffer);
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+  }
+
+  void EspJob::dispatch(uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z)
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    VulkanJob::dispatch(group_count_x, group_count_y, group_count_z);
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+  }
+
+  void EspJob::dispatch(EspCommandBufferId* id,
+                        uint32_t group_count_x,
+                        uint32_t group_count_y,
+                        uint32_t group_count_z)
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    VulkanJob::dispatch(id, group_count_x, group_count_y, group_count_z);
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+  }
+
+  void EspJob::dispatch_indirect(EspStorageBuffer& buffer, uint32_t offset)
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    VulkanJob::dispatch_indirect(buffer, offset);
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+  }
+
+  void EspJob::dispatch_indirect(EspCommandBufferId* id, EspStorageBuffer& buffer, uint32_t offset)
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    VulkanJob::dispatch_indirect(id, buffer, offset);
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+  }
+
+  void EspJob::clear_storage_buffer(EspStorageBuffer& buffer)
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    VulkanJob::clear_storage_buffer(buffer);
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+  }
+
+  void EspJob::clear_storage_buffer(EspCommandBufferId* id, EspStorageBuffer& buffer)
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    VulkanJob::clear_storage_buffer(id, buffer);
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+  }
+
+  void EspJob::barrier(EspBarrier barrier)
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    VulkanJob::barrier(barrier);
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+  }
+
+  void EspJob::barrier(EspCommandBufferId* id, EspBarrier barrier)
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    VulkanJob::barrier(id, barrier);
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+  }
+
   void EspJob::copy_image(EspCommandBufferId* id,
                           std::shared_ptr<EspTexture> src_texture,
                           EspImageLayout src_layout,
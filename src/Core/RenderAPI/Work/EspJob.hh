@@ -5,9 +5,13 @@
 
 #include "Core/RenderAPI/RenderPlans/Block/Types/EspImageLayout.hh"
 #include "Core/RenderAPI/RenderPlans/EspCommandBuffer.hh"
+#include "Core/RenderAPI/Resources/EspDrawCommandBuffer.hh"
 #include "Core/RenderAPI/Resources/EspImageCopy.hh"
 #include "Core/RenderAPI/Resources/EspImageSubresourceRange.hh"
+#include "Core/RenderAPI/Resources/EspStorageBuffer.hh"
 #include "Core/RenderAPI/Resources/EspTexture.hh"
+#include "EspBarrier.hh"
+#include "EspDispatch.hh"
 
 namespace esp
 {
@@ -36,6 +40,35 @@ namespace esp
                              uint32_t instance_count = 1,
                              uint32_t first_index    = 0);
 
+    // draws commands [first_command, first_command + draw_count) of the current frame
+    static void draw_indexed_indirect(EspDrawCommandBuffer& buffer, uint32_t first_command, uint32_t draw_count);
+    static void draw_indexed_indirect(EspCommandBufferId* id,
+                                      EspDrawCommandBuffer& buffer,
+                                      uint32_t first_command,
+                                      uint32_t draw_count);
+    // draws the number of commands stored in the buffer, so it can be written by the GPU
+    static void draw_indexed_indirect_count(EspDrawCommandBuffer& buffer);
+    static void draw_indexed_indirect_count(EspCommandBufferId* id, EspDrawCommandBuffer& buffer);
+
+    // dispatches compute worker attached before, it can't be called inside of a render plan, esp_group_count returns
+    // group counts covering given number of invocations
+    static void dispatch(uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z);
+    static void dispatch(EspCommandBufferId* id,
+                         uint32_t group_count_x,
+                         uint32_t group_count_y,
+                         uint32_t group_count_z);
+    // reads group counts from the buffer at offset, so they can be written by the GPU
+    static void dispatch_indirect(EspStorageBuffer& buffer, uint32_t offset = 0);
+    static void dispatch_indirect(EspCommandBufferId* id, EspStorageBuffer& buffer, uint32_t offset = 0);
+
+    // fills the buffer with zeros, e.g. to reset counters written by compute shaders
+    static void clear_storage_buffer(EspStorageBuffer& buffer);
+    static void clear_storage_buffer(EspCommandBufferId* id, EspStorageBuffer& buffer);
+
+    static void barrier(EspBarrier barrier);
+    // command buffers of compute only queues support only barriers passing esp_barrier_is_compute_queue_compatible
+    static void barrier(EspCommandBufferId* id, EspBarrier barrier);
+
     static void copy_image(EspCommandBufferId* id,
                            std::shared_ptr<EspTexture> src_texture,
                            EspImageLayout src_layout,
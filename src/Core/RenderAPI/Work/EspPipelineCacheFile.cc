@@ -0,0 +1,144 @@
+#include "EspPipelineCacheFile.hh"
+
+// std
+#include <cstring>
+
+namespace
+{
+  struct FileHeader
+  {
+    uint32_t m_magic;
+    uint32_t m_version;
+    uint32_t m_vendor_id;
+    uint32_t m_device_id;
+    uint32_t m_driver_version;
+    uint8_t m_cache_uuid[16];
+    uint64_t m_data_size;
+    uint64_t m_checksum;
+  };
+} // namespace
+
+// signatures
+static uint64_t fnv1a(const uint8_t* data, size_t size);
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  std::vector<uint8_t> EspPipelineCacheFile::serialize(const EspPipelineCacheIdentity& identity,
+                                                       const std::vector<uint8_t>& data)
+  {
+    FileHeader header = {};
+
+    header.m_magic          = MAGIC;
+    header.m_version        = VERSION;
+    header.m_vendor_id      = identity.m_vendor_id;
+    header.m_device_id      = identity.m_device_id;
+    header.m_driver_version = identity.m_driver_version;
+    header.m_data_size      = data.size();
+    header.m_checksum       = fnv1a(data.data(), data.size());
+    std::memcpy(header.m_cache_uuid, identity.m_cache_uuid.data(), sizeof(header.m_cache_uuid));
+
+    std::vector<uint8_t> file(sizeof(FileHeader) + data.size());
+    std::memcpy(file.data(), &header, sizeof(FileHeader));
+    if (!data.empty()) { std::memcpy(file.data() + sizeof(FileHeader), data.data(), data.size()); }
+
+    return file;
+  }
+
+  EspPipelineCacheFile::Status EspPipelineCacheFile::deserialize(const std::vector<uint8_t>& file,
+                                                                 const EspPipelineCacheIdentity& identity,
+                                                                 std::vector<uint8_t>& data)
+  {
+    if (file.size() < sizeof(FileHeader)) { return CORRUPTED; }
+
+    FileHeader header;
+    std::memcpy(&header, file.data(), sizeof(FileHeader));
+    if (header.m_magic != MAGIC) { return CORRUPTED; }
+    if (header.m_version != VERSION) { return INCOMPATIBLE; }
+
+    EspPipelineCacheIdentity file_identity = { header.m_vendor_id, header.m_device_id, header.m_driver_version };
+    std::memcpy(file_identity.m_cache_uuid.data(), header.m_cache_uuid, sizeof(header.m_cache_uuid));
+    if (file_identity != identity) { return INCOMPATIBLE; }
+
+    const uint8_t* payload = file.data() + sizeof(FileHeader);
+    if (header.m_data_size != file.size() - sizeof(FileHeader)) { return CORRUPTED; }
+    if (header.m_checksum != fnv1a(payload, header.m_data_size)) { return CORRUPTED; }
+
+    data.assign(payload, payload + header.m_data_size);
+    return OK;
+  }
+
+  EspPipelineCacheFile::Status EspPipelineCacheFile::load(const fs::path& path,
+                                                          const EspPipelineCacheIdentity& identity,
+                                                          std::vector<uint8_t>& data)
+  {
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    if (!stream.is_open()) { return MISSING; }
+
+    std::vector<uint8_t> file(static_cast<size_t>(stream.tellg()));
+    stream.seekg(0);
+    if (!stream.read(reinterpret_cast<char*>(file.data()), file.size())) { return MISSING; }
+
+    return deserialize(file, identity, data);
+  }
+
+  bool EspPipelineCacheFile::save(const fs::path& path,
+                                  const EspPipelineCacheIdentity& identity,
+                                  const std::vector<uint8_t>& data)
+  {
+    auto file    = serialize(identity, data);
+    fs::path tmp = path.string() + ".tmp";
+
+    {
+      std::ofstream stream(tmp, std::ios::binary | std::ios::trunc);
+      if (!stream.is_open()) { return false; }
+      if (!stream.write(reinterpret_cast<const char*>(file.data()), file.size())) { return false; }
+    }
+
+    std::error_code error;
+    fs::rename(tmp, path, error);
+    if (error)
+    {
+      fs::remove(tmp, error);
+      return false;
+    }
+
+    return true;
+  }
+
+  const char* EspPipelineCacheFile::to_string(Status status)
+  {
+    switch (status)
+    {
+    case OK:
+      return "OK";
+    case MISSING:
+      return "MISSING";
+    case CORRUPTED:
+      return "CORRUPTED";
+    case INCOMPATIBLE:
+      return "INCOMPATIBLE";
+    }
+
+    return "UNKNOWN";
+  }
+} // namespace esp
+
+/* --------------------------------------------------------- */
+/* ------------------ HELPFUL FUNCTIONS -------------------- */
+/* --------------------------------------------------------- */
+
+static uint64_t fnv1a(const uint8_t* data, size_t size)
+{
+  uint64_t hash = 14695981039346656037ull;
+  for (size_t i = 0; i < size; i++)
+  {
+    hash ^= data[i];
+    hash *= 1099511628211ull;
+  }
+
+  return hash;
+}
@@ -0,0 +1,83 @@
+#ifndef RENDER_API_ESP_PIPELINE_CACHE_FILE_HH
+#define RENDER_API_ESP_PIPELINE_CACHE_FILE_HH
+
+#include "esppch.hh"
+
+// std
+#include <array>
+
+namespace esp
+{
+  /// @brief Identity of the device and driver that produced pipeline cache data. Data produced by a different
+  /// identity is rejected, because drivers may crash on foreign caches.
+  struct EspPipelineCacheIdentity
+  {
+    /// @brief Vendor of the device.
+    uint32_t m_vendor_id = 0;
+    /// @brief Device of the vendor.
+    uint32_t m_device_id = 0;
+    /// @brief Version of the driver.
+    uint32_t m_driver_version = 0;
+    /// @brief UUID of the pipeline cache format used by the driver.
+    std::array<uint8_t, 16> m_cache_uuid = {};
+
+    bool operator==(const EspPipelineCacheIdentity& other) const = default;
+  };
+
+  /// @brief On-disk format of the pipeline cache. Data is prefixed with a header holding magic number, format
+  /// version, identity of the device and checksum of the data.
+  class EspPipelineCacheFile
+  {
+   public:
+    /// @brief Result of reading the pipeline cache file.
+    enum Status
+    {
+      /// @brief Data was read.
+      OK,
+      /// @brief File doesn't exist or can't be read.
+      MISSING,
+      /// @brief File is truncated, isn't a pipeline cache or its checksum doesn't match.
+      CORRUPTED,
+      /// @brief File was produced by a different device, driver or format version.
+      INCOMPATIBLE
+    };
+
+    static constexpr uint32_t MAGIC   = 0x43505345; // "ESPC"
+    static constexpr uint32_t VERSION = 1;
+
+    /// @brief Prefixes data with the header.
+    /// @param identity Identity of the device that produced data.
+    /// @param data Pipeline cache data.
+    /// @return Content of the file.
+    static std::vector<uint8_t> serialize(const EspPipelineCacheIdentity& identity, const std::vector<uint8_t>& data);
+    /// @brief Validates the header and extracts data.
+    /// @param file Content of the file.
+    /// @param identity Identity of the current device.
+    /// @param data Pipeline cache data. Set only if OK is returned.
+    /// @return OK, CORRUPTED or INCOMPATIBLE.
+    static Status deserialize(const std::vector<uint8_t>& file,
+                              const EspPipelineCacheIdentity& identity,
+                              std::vector<uint8_t>& data);
+
+    /// @brief Reads pipeline cache file.
+    /// @param path Path to the file.
+    /// @param identity Identity of the current device.
+    /// @param data Pipeline cache data. Set only if OK is returned.
+    /// @return Result of reading.
+    static Status load(const fs::path& path, const EspPipelineCacheIdentity& identity, std::vector<uint8_t>& data);
+    /// @brief Writes pipeline cache file. File is written under temporary name and renamed, so a crash during
+    /// saving never leaves a partial file.
+    /// @param path Path to the file.
+    /// @param identity Identity of the current device.
+    /// @param data Pipeline cache data.
+    /// @return True if the file was written. False otherwise.
+    static bool save(const fs::path& path, const EspPipelineCacheIdentity& identity, const std::vector<uint8_t>& data);
+
+    /// @brief Returns name of the status.
+    /// @param status Status to name.
+    /// @return Name of the status.
+    static const char* to_string(Status status);
+  };
+} // namespace esp
+
+#endif // RENDER_API_ESP_PIPELINE_CACHE_FILE_HH
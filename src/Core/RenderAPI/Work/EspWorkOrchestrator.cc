@@ -5,13 +5,14 @@
 
 namespace esp
 {
-  std::unique_ptr<EspWorkOrchestrator> EspWorkOrchestrator::build(EspPresentationMode presentation_mode)
+  std::unique_ptr<EspWorkOrchestrator> EspWorkOrchestrator::build(EspPresentationMode presentation_mode,
+                                                                 EspFramePacingMode frame_pacing)
   {
     /* ---------------------------------------------------------*/
     /* ------------- PLATFORM DEPENDENT ------------------------*/
     /* ---------------------------------------------------------*/
 #if ESP_USE_VULKAN
-    auto work_orchestrator = VulkanWorkOrchestrator::create(presentation_mode);
+    auto work_orchestrator = VulkanWorkOrchestrator::create(presentation_mode, frame_pacing);
 #else
 #error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
 #endif
@@ -44,4 +45,56 @@ namespace esp
 #endif
     /* ---------------------------------------------------------*/
   }
-} // namespace esp
\ No newline at end of file
+
+  void EspWorkOrchestrator::set_readback_callback(EspReadbackCallback callback)
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    VulkanWorkOrchestrator::set_readback_callback(std::move(callback));
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+  }
+
+  EspCommandBufferId* EspWorkOrchestrator::get_async_compute_command_buffer()
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    return VulkanAsyncCompute::get_command_buffer();
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+  }
+
+  bool EspWorkOrchestrator::is_async_compute_supported()
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    return VulkanAsyncCompute::is_async();
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+  }
+
+  void EspWorkOrchestrator::async_compute_after_previous_frame()
+  {
+    /* ---------------------------------------------------------*/
+    /* ------------- PLATFORM DEPENDENT ------------------------*/
+    /* ---------------------------------------------------------*/
+#if ESP_USE_VULKAN
+    VulkanAsyncCompute::wait_for_previous_frame();
+#else
+#error Unfortunatelly, only Vulkan is supported by Espert. Please, install Vulkan API.
+#endif
+    /* ---------------------------------------------------------*/
+  }
+} // namespace esp
@@ -4,11 +4,27 @@
 #include "Core/EspApplicationParams.hh"
 #include "Core/EspWindow.hh"
 #include "Core/Events/WindowEvent.hh"
+#include "Core/RenderAPI/RenderPlans/EspCommandBuffer.hh"
 
 #include "esppch.hh"
 
 namespace esp
 {
+  /// @brief Frame rendered in headless mode and copied to host memory.
+  struct EspFrameReadback
+  {
+    /// @brief Value of the frame, frames begun so far are counted from 1.
+    uint64_t m_frame_value;
+    /// @brief Width of the frame in pixels.
+    uint32_t m_width;
+    /// @brief Height of the frame in pixels.
+    uint32_t m_height;
+    /// @brief Tightly packed R8G8B8A8 pixels, rows from top to bottom. Valid only during the callback.
+    const uint8_t* m_pixels;
+  };
+
+  using EspReadbackCallback = std::function<void(const EspFrameReadback&)>;
+
   class EspWorkOrchestrator
   {
     /* -------------------------- METHODS ---------------------------------- */
@@ -19,18 +35,35 @@ namespace esp
     EspWorkOrchestrator(const EspWorkOrchestrator& other)            = delete;
     EspWorkOrchestrator& operator=(const EspWorkOrchestrator& other) = delete;
 
-    virtual void init(EspPresentationMode presentation_mode) = 0;
-    virtual void terminate()                                 = 0;
+    virtual void init(EspPresentationMode presentation_mode, EspFramePacingMode frame_pacing) = 0;
+    virtual void terminate()                                                                  = 0;
 
     virtual void begin_frame() = 0;
     virtual void end_frame()   = 0;
 
     static std::pair<uint32_t, uint32_t> get_swap_chain_extent();
     static float get_swap_chain_extent_aspect_ratio();
+    // Headless mode only. The callback gets every frame finished by the final render plan, in order, a few frames
+    // after it was submitted, so reading back never stalls the GPU. The last frames are delivered when the
+    // orchestrator terminates, which is after layers of the application were deleted.
+    static void set_readback_callback(EspReadbackCallback callback);
+
+    // Compute work of the current frame (culling, skinning, particles...) is recorded into this command buffer, from a
+    // single thread. On devices with a dedicated compute queue it's submitted there before the frame, and the frame
+    // waits for it only at stages which may consume its results, so it overlaps rendering of the previous frame.
+    // Otherwise it's submitted to the graphics queue right before the frame.
+    static EspCommandBufferId* get_async_compute_command_buffer();
+    // True if compute work runs on a dedicated compute queue.
+    static bool is_async_compute_supported();
+    // Compute work of the current frame starts after the previous frame is rendered. It has to be called before the
+    // work is recorded, when the work reads results of the previous frame or writes resources it reads.
+    static void async_compute_after_previous_frame();
 
     /* -------------------------- STATIC METHODS --------------------------- */
    public:
-    static std::unique_ptr<EspWorkOrchestrator> build(EspPresentationMode presentation_mode);
+    static std::unique_ptr<EspWorkOrchestrator> build(
+        EspPresentationMode presentation_mode,
+        EspFramePacingMode frame_pacing = EspFramePacingMode::ESP_FRAME_PACING_THROUGHPUT);
   };
 } // namespace esp
 
@@ -0,0 +1,30 @@
+#ifndef CORE_RENDER_API_ESP_COMPUTE_WORKER_HH
+#define CORE_RENDER_API_ESP_COMPUTE_WORKER_HH
+
+#include "esppch.hh"
+
+// Render API
+#include "Core/RenderAPI/RenderPlans/EspCommandBuffer.hh"
+#include "Core/RenderAPI/Uniforms/EspUniformManager.hh"
+
+namespace esp
+{
+  /// @brief Compute pipeline built by EspWorkerBuilder::build_compute_worker. Work is recorded outside of render plans,
+  /// by attaching the worker and its uniform manager, and calling EspJob::dispatch.
+  class EspComputeWorker
+  {
+    /* -------------------------- METHODS ---------------------------------- */
+   public:
+    virtual ~EspComputeWorker() {}
+
+    virtual bool is_ready() const = 0;
+
+    virtual void attach() const                       = 0;
+    virtual void attach(EspCommandBufferId* id) const = 0;
+
+    virtual std::unique_ptr<EspUniformManager> create_uniform_manager(int start_managed_ds = -1,
+                                                                      int end_managed_ds   = -1) const = 0;
+  };
+} // namespace esp
+
+#endif /* CORE_RENDER_API_ESP_COMPUTE_WORKER_HH */
@@ -0,0 +1,129 @@
+#include "EspPipelineCompiler.hh"
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  EspPipelineHandle::EspPipelineHandle(EspPipelineDestroyFunction destroy) : m_destroy{ std::move(destroy) } {}
+
+  EspPipelineHandle::~EspPipelineHandle()
+  {
+    wait();
+    if (m_pipeline && m_destroy) { m_destroy(m_pipeline); }
+  }
+
+  void EspPipelineHandle::wait()
+  {
+    if (!is_ready()) { JobSystem::wait(m_counter); }
+  }
+
+  uint64_t EspPipelineHandle::get()
+  {
+    wait();
+    if (m_error) { std::rethrow_exception(m_error); }
+
+    return m_pipeline;
+  }
+
+  EspPipelineCompiler* EspPipelineCompiler::s_instance = nullptr;
+
+  EspPipelineCompiler::EspPipelineCompiler()
+  {
+    if (EspPipelineCompiler::s_instance != nullptr)
+    {
+      throw std::runtime_error("The pipeline compiler instance already exists!");
+    }
+
+    EspPipelineCompiler::s_instance = this;
+  }
+
+  EspPipelineCompiler::~EspPipelineCompiler()
+  {
+    if (s_instance) { terminate(); }
+  }
+
+  std::unique_ptr<EspPipelineCompiler> EspPipelineCompiler::create()
+  {
+    auto pipeline_compiler = std::unique_ptr<EspPipelineCompiler>(new EspPipelineCompiler());
+
+    ESP_CORE_TRACE("Pipeline compiler initialized.");
+
+    return pipeline_compiler;
+  }
+
+  void EspPipelineCompiler::terminate()
+  {
+    ESP_CORE_TRACE("Pipeline compiler shutdown ({} requests, {} compiled, {} shared).",
+                   m_requests.load(),
+                   m_compiled.load(),
+                   m_shared.load());
+
+    EspPipelineCompiler::s_instance = nullptr;
+    m_pipelines.clear();
+  }
+
+  std::shared_ptr<EspPipelineHandle> EspPipelineCompiler::compile(uint64_t hash,
+                                                                  EspPipelineCreateFunction create,
+                                                                  EspPipelineDestroyFunction destroy)
+  {
+    if (!s_instance)
+    {
+      auto handle = std::make_shared<EspPipelineHandle>(std::move(destroy));
+      run(handle, std::move(create));
+      return handle;
+    }
+
+    s_instance->m_requests++;
+
+    std::shared_ptr<EspPipelineHandle> handle;
+    {
+      std::lock_guard<std::mutex> lock(s_instance->m_mutex);
+
+      // pipelines whose handles were all released are destroyed, their entries would only grow the map
+      std::erase_if(s_instance->m_pipelines, [](const auto& pipeline) { return pipeline.second.expired(); });
+
+      auto& entry = s_instance->m_pipelines[hash];
+      if (auto existing = entry.lock())
+      {
+        s_instance->m_shared++;
+        return existing;
+      }
+
+      handle = std::make_shared<EspPipelineHandle>(std::move(destroy));
+      entry  = handle;
+    }
+    s_instance->m_compiled++;
+
+    // the job keeps the handle alive, so the pipeline can't be destroyed before it's created
+    auto* counter = &handle->m_counter;
+    JobSystem::run([handle, create = std::move(create)]() { run(handle, create); }, counter, "pipeline_compile");
+    return handle;
+  }
+
+  EspPipelineCompilerStats EspPipelineCompiler::get_stats()
+  {
+    if (!s_instance) { return {}; }
+
+    std::lock_guard<std::mutex> lock(s_instance->m_mutex);
+    return { s_instance->m_requests.load(),
+             s_instance->m_compiled.load(),
+             s_instance->m_shared.load(),
+             (uint32_t)s_instance->m_pipelines.size() };
+  }
+
+  void EspPipelineCompiler::run(std::shared_ptr<EspPipelineHandle> handle, EspPipelineCreateFunction create)
+  {
+    try
+    {
+      handle->m_pipeline = create();
+    }
+    catch (...)
+    {
+      handle->m_error = std::current_exception();
+    }
+
+    handle->m_ready.store(true, std::memory_order_release);
+  }
+} // namespace esp
@@ -0,0 +1,117 @@
+#ifndef CORE_RENDER_API_ESP_PIPELINE_COMPILER_HH
+#define CORE_RENDER_API_ESP_PIPELINE_COMPILER_HH
+
+#include "esppch.hh"
+
+// Core
+#include "Core/Jobs/JobSystem.hh"
+
+// std
+#include <atomic>
+#include <exception>
+#include <mutex>
+
+namespace esp
+{
+  /// @brief Creates graphic's API pipeline object and returns its handle.
+  using EspPipelineCreateFunction = std::function<uint64_t()>;
+  /// @brief Destroys graphic's API pipeline object.
+  using EspPipelineDestroyFunction = std::function<void(uint64_t pipeline)>;
+
+  /// @brief Pipeline shared by all workers with the same pipeline state. It may still be compiled on a worker
+  /// thread, get() waits for it.
+  class EspPipelineHandle
+  {
+   private:
+    uint64_t m_pipeline = 0;
+    EspPipelineDestroyFunction m_destroy;
+    std::exception_ptr m_error;
+
+    std::atomic<bool> m_ready = false;
+    JobCounter m_counter;
+
+   public:
+    /// @brief Creates handle of a pipeline that isn't compiled yet.
+    /// @param destroy Function destroying the pipeline when the last reference is dropped.
+    EspPipelineHandle(EspPipelineDestroyFunction destroy);
+    /// @brief Waits for the compilation and destroys the pipeline.
+    ~EspPipelineHandle();
+
+    PREVENT_COPY(EspPipelineHandle);
+
+    /// @brief Checks if the pipeline can be used without waiting.
+    /// @return True if the compilation has finished. False otherwise.
+    inline bool is_ready() const { return m_ready.load(std::memory_order_acquire); }
+    /// @brief Waits for the compilation. The calling thread executes other jobs in the meantime.
+    void wait();
+    /// @brief Waits for the compilation and returns the pipeline. Rethrows error of the compilation.
+    /// @return Graphic's API pipeline handle.
+    uint64_t get();
+
+    friend class EspPipelineCompiler;
+  };
+
+  /// @brief Counters describing work done by the EspPipelineCompiler since it was created.
+  struct EspPipelineCompilerStats
+  {
+    /// @brief Number of requested pipelines.
+    uint32_t m_requests = 0;
+    /// @brief Number of compiled pipelines.
+    uint32_t m_compiled = 0;
+    /// @brief Number of requests served by pipeline that already existed.
+    uint32_t m_shared = 0;
+    /// @brief Number of tracked pipelines, entries of released ones are erased by the next request.
+    uint32_t m_tracked = 0;
+  };
+
+  /// @brief Service compiling pipelines on JobSystem workers. Pipelines are identified by hash of their whole state,
+  /// so identical requests share one pipeline.
+  ///
+  /// When the service doesn't exist pipelines are compiled immediately and aren't shared.
+  class EspPipelineCompiler
+  {
+   private:
+    static EspPipelineCompiler* s_instance;
+
+    std::mutex m_mutex;
+    std::unordered_map<uint64_t, std::weak_ptr<EspPipelineHandle>> m_pipelines;
+
+    std::atomic<uint32_t> m_requests = 0;
+    std::atomic<uint32_t> m_compiled = 0;
+    std::atomic<uint32_t> m_shared   = 0;
+
+    EspPipelineCompiler();
+
+   public:
+    /// @brief Terminates EspPipelineCompiler.
+    ~EspPipelineCompiler();
+
+    PREVENT_COPY(EspPipelineCompiler);
+
+    /// @brief Creates EspPipelineCompiler singleton instance.
+    /// @return Unique pointer to EspPipelineCompiler instance.
+    static std::unique_ptr<EspPipelineCompiler> create();
+
+    /// @brief Destroys EspPipelineCompiler instance. Already requested pipelines stay valid.
+    void terminate();
+
+    /// @brief Returns pipeline with the given state. If it doesn't exist, its compilation is scheduled as a job.
+    /// @param hash Hash of the whole pipeline state.
+    /// @param create Function creating the pipeline. Called on a worker thread, so everything it reads has to stay
+    /// alive until the pipeline is ready.
+    /// @param destroy Function destroying the pipeline.
+    /// @return Shared handle of the pipeline.
+    static std::shared_ptr<EspPipelineHandle> compile(uint64_t hash,
+                                                      EspPipelineCreateFunction create,
+                                                      EspPipelineDestroyFunction destroy);
+
+    /// @brief Returns statistics of the EspPipelineCompiler.
+    /// @return Statistics of the EspPipelineCompiler.
+    static EspPipelineCompilerStats get_stats();
+
+   private:
+    static void run(std::shared_ptr<EspPipelineHandle> handle, EspPipelineCreateFunction create);
+  };
+} // namespace esp
+
+#endif // CORE_RENDER_API_ESP_PIPELINE_COMPILER_HH
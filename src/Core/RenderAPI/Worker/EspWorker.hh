@@ -31,7 +31,16 @@ namespace esp
    public:
     virtual ~EspWorker() {}
 
-    virtual void attach() const = 0;
+    virtual bool is_ready() const = 0;
+
+    // Workers with equal hashes have compatible layouts, so their uniform managers can be used with each other.
+    virtual size_t get_layout_hash() const = 0;
+    // Workers with equal ids share the same layout object, so descriptor sets and push constants bound for one of them
+    // stay valid when the other one is attached.
+    virtual const void* get_layout_id() const = 0;
+
+    virtual void attach() const                        = 0;
+    virtual void attach(EspCommandBufferId* id) const = 0;
 
     virtual void only_attach() const                       = 0;
     virtual void set_viewport(EspViewport viewport)        = 0;
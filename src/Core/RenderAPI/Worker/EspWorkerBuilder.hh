@@ -10,6 +10,7 @@
 #include "Core/RenderAPI/Uniforms/EspUniformMetaData.hh"
 #include "Core/RenderAPI/Worker/Types/EspCompareOp.hh"
 #include "EspAttrFormat.hh"
+#include "EspComputeWorker.hh"
 #include "EspWorker.hh"
 
 // Resources
@@ -50,7 +51,8 @@ namespace esp
 
     virtual void set_attachment_formats(std::vector<EspBlockFormat> formats) = 0;
 
-    virtual void set_shaders(std::unique_ptr<SpirvResource> spirv_resource) = 0;
+    // Shader modules keep the resource alive, so its code isn't copied.
+    virtual void set_shaders(std::shared_ptr<SpirvResource> spirv_resource) = 0;
 
     virtual void set_specialization(const SpecializationConstantMap& spec_const_map) = 0;
 
@@ -59,6 +61,9 @@ namespace esp
 
     virtual std::unique_ptr<EspWorker> build_worker() = 0;
 
+    // Builds compute pipeline of the compute shader, only shaders, specialization and worker layout are used.
+    virtual std::unique_ptr<EspComputeWorker> build_compute_worker() = 0;
+
     /* -------------------------- STATIC METHODS --------------------------- */
    public:
     static std::unique_ptr<EspWorkerBuilder> create();
@@ -0,0 +1,367 @@
+#include "BoundingVolumeHierarchy.hh"
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  BoundingVolumeHierarchy::BoundingVolumeHierarchy(float margin) : m_margin{ margin } {}
+
+  int32_t BoundingVolumeHierarchy::insert(const AABB& aabb, uint32_t user_data)
+  {
+    int32_t leaf               = allocate_node();
+    m_nodes[leaf].m_aabb       = make_fat(aabb);
+    m_nodes[leaf].m_tight_aabb = aabb;
+    m_nodes[leaf].m_user_data  = user_data;
+    m_nodes[leaf].m_height     = 0;
+
+    insert_leaf(leaf);
+    m_leaf_count++;
+
+    return leaf;
+  }
+
+  void BoundingVolumeHierarchy::remove(int32_t proxy)
+  {
+    ESP_ASSERT(proxy >= 0 && proxy < static_cast<int32_t>(m_nodes.size()) && m_nodes[proxy].is_leaf(),
+               "Invalid BVH proxy")
+
+    remove_leaf(proxy);
+    free_node(proxy);
+    m_leaf_count--;
+  }
+
+  bool BoundingVolumeHierarchy::update(int32_t proxy, const AABB& aabb)
+  {
+    ESP_ASSERT(proxy >= 0 && proxy < static_cast<int32_t>(m_nodes.size()) && m_nodes[proxy].is_leaf(),
+               "Invalid BVH proxy")
+
+    auto& node        = m_nodes[proxy];
+    node.m_tight_aabb = aabb;
+
+    AABB fat_aabb = make_fat(aabb);
+    // keep the node while the object stays inside its fat box and the box isn't much bigger than needed
+    if (node.m_aabb.contains(aabb) && node.m_aabb.get_surface_area() <= 4.f * fat_aabb.get_surface_area())
+    {
+      return false;
+    }
+
+    remove_leaf(proxy);
+    m_nodes[proxy].m_aabb = fat_aabb;
+    insert_leaf(proxy);
+
+    return true;
+  }
+
+  void BoundingVolumeHierarchy::clear()
+  {
+    m_nodes.clear();
+    m_root       = NULL_NODE;
+    m_free_list  = NULL_NODE;
+    m_leaf_count = 0;
+  }
+
+  CullingStats BoundingVolumeHierarchy::query(const Frustum& frustum, std::vector<uint32_t>& visible) const
+  {
+    CullingStats stats = {};
+    stats.m_objects    = m_leaf_count;
+    if (m_root == NULL_NODE) { return stats; }
+
+    size_t first_visible = visible.size();
+    m_candidate_boxes.clear();
+    m_candidate_data.clear();
+
+    // negative entries (~index) mark subtrees that are known to be completely inside the frustum
+    m_stack.clear();
+    m_stack.push_back(m_root);
+    while (!m_stack.empty())
+    {
+      int32_t entry = m_stack.back();
+      m_stack.pop_back();
+
+      if (entry < 0)
+      {
+        auto& node = m_nodes[~entry];
+        if (node.is_leaf()) { visible.push_back(node.m_user_data); }
+        else
+        {
+          m_stack.push_back(~node.m_left);
+          m_stack.push_back(~node.m_right);
+        }
+        continue;
+      }
+
+      auto& node = m_nodes[entry];
+      stats.m_nodes_visited++;
+
+      auto intersection = frustum.classify(node.m_aabb);
+      if (intersection == Frustum::OUTSIDE) { continue; }
+
+      if (intersection == Frustum::INSIDE)
+      {
+        m_stack.push_back(~entry);
+        continue;
+      }
+
+      if (node.is_leaf())
+      {
+        m_candidate_boxes.push_back(node.m_tight_aabb);
+        m_candidate_data.push_back(node.m_user_data);
+      }
+      else
+      {
+        m_stack.push_back(node.m_left);
+        m_stack.push_back(node.m_right);
+      }
+    }
+
+    // leaves whose fat boxes cross frustum planes are tested with their exact boxes in SIMD batches
+    uint32_t candidate_count = static_cast<uint32_t>(m_candidate_boxes.size());
+    m_candidate_visible.resize(candidate_count);
+    frustum.cull(m_candidate_boxes.data(), candidate_count, m_candidate_visible.data());
+    for (uint32_t i = 0; i < candidate_count; i++)
+    {
+      if (m_candidate_visible[i]) { visible.push_back(m_candidate_data[i]); }
+    }
+
+    stats.m_boxes_tested = candidate_count;
+    stats.m_visible      = static_cast<uint32_t>(visible.size() - first_visible);
+    return stats;
+  }
+
+  int32_t BoundingVolumeHierarchy::allocate_node()
+  {
+    if (m_free_list == NULL_NODE)
+    {
+      m_nodes.emplace_back();
+      return static_cast<int32_t>(m_nodes.size() - 1);
+    }
+
+    int32_t index  = m_free_list;
+    m_free_list    = m_nodes[index].m_parent;
+    m_nodes[index] = {};
+    return index;
+  }
+
+  void BoundingVolumeHierarchy::free_node(int32_t index)
+  {
+    m_nodes[index]          = {};
+    m_nodes[index].m_parent = m_free_list;
+    m_free_list             = index;
+  }
+
+  void BoundingVolumeHierarchy::insert_leaf(int32_t leaf)
+  {
+    if (m_root == NULL_NODE)
+    {
+      m_root                 = leaf;
+      m_nodes[leaf].m_parent = NULL_NODE;
+      return;
+    }
+
+    // find the best sibling using surface area heuristic
+    AABB leaf_aabb = m_nodes[leaf].m_aabb;
+    int32_t index  = m_root;
+    while (!m_nodes[index].is_leaf())
+    {
+      auto& node  = m_nodes[index];
+      auto& left  = m_nodes[node.m_left];
+      auto& right = m_nodes[node.m_right];
+
+      float area          = node.m_aabb.get_surface_area();
+      float combined_area = AABB::merge(node.m_aabb, leaf_aabb).get_surface_area();
+
+      // cost of creating a new parent for this node and the leaf
+      float cost = 2.f * combined_area;
+      // minimum cost of pushing the leaf further down the tree
+      float inheritance_cost = 2.f * (combined_area - area);
+
+      auto descend_cost = [&](const Node& child)
+      {
+        float merged_area = AABB::merge(leaf_aabb, child.m_aabb).get_surface_area();
+        return (child.is_leaf() ? merged_area : merged_area - child.m_aabb.get_surface_area()) + inheritance_cost;
+      };
+
+      float cost_left  = descend_cost(left);
+      float cost_right = descend_cost(right);
+
+      if (cost < cost_left && cost < cost_right) { break; }
+      index = cost_left < cost_right ? node.m_left : node.m_right;
+    }
+
+    int32_t sibling    = index;
+    int32_t old_parent = m_nodes[sibling].m_parent;
+    int32_t new_parent = allocate_node();
+
+    m_nodes[new_parent].m_parent = old_parent;
+    m_nodes[new_parent].m_aabb   = AABB::merge(leaf_aabb, m_nodes[sibling].m_aabb);
+    m_nodes[new_parent].m_height = m_nodes[sibling].m_height + 1;
+    m_nodes[new_parent].m_left   = sibling;
+    m_nodes[new_parent].m_right  = leaf;
+
+    if (old_parent != NULL_NODE)
+    {
+      if (m_nodes[old_parent].m_left == sibling) { m_nodes[old_parent].m_left = new_parent; }
+      else { m_nodes[old_parent].m_right = new_parent; }
+    }
+    else { m_root = new_parent; }
+
+    m_nodes[sibling].m_parent = new_parent;
+    m_nodes[leaf].m_parent    = new_parent;
+
+    refit_ancestors(m_nodes[leaf].m_parent);
+  }
+
+  void BoundingVolumeHierarchy::remove_leaf(int32_t leaf)
+  {
+    if (leaf == m_root)
+    {
+      m_root = NULL_NODE;
+      return;
+    }
+
+    int32_t parent       = m_nodes[leaf].m_parent;
+    int32_t grand_parent = m_nodes[parent].m_parent;
+    int32_t sibling      = m_nodes[parent].m_left == leaf ? m_nodes[parent].m_right : m_nodes[parent].m_left;
+
+    if (grand_parent != NULL_NODE)
+    {
+      if (m_nodes[grand_parent].m_left == parent) { m_nodes[grand_parent].m_left = sibling; }
+      else { m_nodes[grand_parent].m_right = sibling; }
+      m_nodes[sibling].m_parent = grand_parent;
+      free_node(parent);
+
+      refit_ancestors(grand_parent);
+    }
+    else
+    {
+      m_root                    = sibling;
+      m_nodes[sibling].m_parent = NULL_NODE;
+      free_node(parent);
+    }
+  }
+
+  void BoundingVolumeHierarchy::refit_ancestors(int32_t index)
+  {
+    while (index != NULL_NODE)
+    {
+      index = balance(index);
+
+      auto& node    = m_nodes[index];
+      auto& left    = m_nodes[node.m_left];
+      auto& right   = m_nodes[node.m_right];
+      node.m_height = 1 + std::max(left.m_height, right.m_height);
+      node.m_aabb   = AABB::merge(left.m_aabb, right.m_aabb);
+
+      index = node.m_parent;
+    }
+  }
+
+  int32_t BoundingVolumeHierarchy::balance(int32_t index_a)
+  {
+    auto& a = m_nodes[index_a];
+    if (a.is_leaf() || a.m_height < 2) { return index_a; }
+
+    int32_t index_b = a.m_left;
+    int32_t index_c = a.m_right;
+    auto& b         = m_nodes[index_b];
+    auto& c         = m_nodes[index_c];
+
+    int32_t height_difference = c.m_height - b.m_height;
+
+    // rotate c up
+    if (height_difference > 1)
+    {
+      int32_t index_f = c.m_left;
+      int32_t index_g = c.m_right;
+      auto& f         = m_nodes[index_f];
+      auto& g         = m_nodes[index_g];
+
+      c.m_left   = index_a;
+      c.m_parent = a.m_parent;
+      a.m_parent = index_c;
+
+      if (c.m_parent != NULL_NODE)
+      {
+        if (m_nodes[c.m_parent].m_left == index_a) { m_nodes[c.m_parent].m_left = index_c; }
+        else { m_nodes[c.m_parent].m_right = index_c; }
+      }
+      else { m_root = index_c; }
+
+      if (f.m_height > g.m_height)
+      {
+        c.m_right  = index_f;
+        a.m_right  = index_g;
+        g.m_parent = index_a;
+        a.m_aabb   = AABB::merge(b.m_aabb, g.m_aabb);
+        c.m_aabb   = AABB::merge(a.m_aabb, f.m_aabb);
+        a.m_height = 1 + std::max(b.m_height, g.m_height);
+        c.m_height = 1 + std::max(a.m_height, f.m_height);
+      }
+      else
+      {
+        c.m_right  = index_g;
+        a.m_right  = index_f;
+        f.m_parent = index_a;
+        a.m_aabb   = AABB::merge(b.m_aabb, f.m_aabb);
+        c.m_aabb   = AABB::merge(a.m_aabb, g.m_aabb);
+        a.m_height = 1 + std::max(b.m_height, f.m_height);
+        c.m_height = 1 + std::max(a.m_height, g.m_height);
+      }
+
+      return index_c;
+    }
+
+    // rotate b up
+    if (height_difference < -1)
+    {
+      int32_t index_d = b.m_left;
+      int32_t index_e = b.m_right;
+      auto& d         = m_nodes[index_d];
+      auto& e         = m_nodes[index_e];
+
+      b.m_left   = index_a;
+      b.m_parent = a.m_parent;
+      a.m_parent = index_b;
+
+      if (b.m_parent != NULL_NODE)
+      {
+        if (m_nodes[b.m_parent].m_left == index_a) { m_nodes[b.m_parent].m_left = index_b; }
+        else { m_nodes[b.m_parent].m_right = index_b; }
+      }
+      else { m_root = index_b; }
+
+      if (d.m_height > e.m_height)
+      {
+        b.m_right  = index_d;
+        a.m_left   = index_e;
+        e.m_parent = index_a;
+        a.m_aabb   = AABB::merge(c.m_aabb, e.m_aabb);
+        b.m_aabb   = AABB::merge(a.m_aabb, d.m_aabb);
+        a.m_height = 1 + std::max(c.m_height, e.m_height);
+        b.m_height = 1 + std::max(a.m_height, d.m_height);
+      }
+      else
+      {
+        b.m_right  = index_e;
+        a.m_left   = index_d;
+        d.m_parent = index_a;
+        a.m_aabb   = AABB::merge(c.m_aabb, d.m_aabb);
+        b.m_aabb   = AABB::merge(a.m_aabb, e.m_aabb);
+        a.m_height = 1 + std::max(c.m_height, d.m_height);
+        b.m_height = 1 + std::max(a.m_height, e.m_height);
+      }
+
+      return index_b;
+    }
+
+    return index_a;
+  }
+
+  AABB BoundingVolumeHierarchy::make_fat(const AABB& aabb) const
+  {
+    glm::vec3 margin = (aabb.m_max - aabb.m_min) * m_margin + glm::vec3(MIN_FAT_MARGIN);
+    return { aabb.m_min - margin, aabb.m_max + margin };
+  }
+} // namespace esp
@@ -0,0 +1,115 @@
+#ifndef RENDERER_CULLING_BOUNDING_VOLUME_HIERARCHY_HH
+#define RENDERER_CULLING_BOUNDING_VOLUME_HIERARCHY_HH
+
+#include "esppch.hh"
+
+#include "Bounds.hh"
+#include "Frustum.hh"
+
+namespace esp
+{
+  /// @brief Counters describing the last frustum query.
+  struct CullingStats
+  {
+    /// @brief Number of objects in the hierarchy.
+    uint32_t m_objects = 0;
+    /// @brief Number of objects that passed the test.
+    uint32_t m_visible = 0;
+    /// @brief Number of hierarchy nodes tested against the frustum.
+    uint32_t m_nodes_visited = 0;
+    /// @brief Number of object boxes tested in the SIMD batches.
+    uint32_t m_boxes_tested = 0;
+  };
+
+  /// @brief Dynamic AABB tree. Leaves store enlarged (fat) boxes, so objects that move a little don't change the
+  /// tree. Objects that leave their fat box are reinserted and the tree is rebalanced with rotations.
+  class BoundingVolumeHierarchy
+  {
+   public:
+    static constexpr int32_t NULL_NODE = -1;
+
+   private:
+    static constexpr float MIN_FAT_MARGIN = .05f;
+
+    struct Node
+    {
+      AABB m_aabb;
+      AABB m_tight_aabb;
+      int32_t m_parent     = NULL_NODE; // next free node when node is on the free list
+      int32_t m_left       = NULL_NODE;
+      int32_t m_right      = NULL_NODE;
+      int32_t m_height     = -1;
+      uint32_t m_user_data = 0;
+
+      inline bool is_leaf() const { return m_left == NULL_NODE; }
+    };
+
+    std::vector<Node> m_nodes;
+    int32_t m_root        = NULL_NODE;
+    int32_t m_free_list   = NULL_NODE;
+    uint32_t m_leaf_count = 0;
+    float m_margin;
+
+    mutable std::vector<int32_t> m_stack;
+    mutable std::vector<AABB> m_candidate_boxes;
+    mutable std::vector<uint32_t> m_candidate_data;
+    mutable std::vector<uint8_t> m_candidate_visible;
+
+   public:
+    /// @brief Creates empty hierarchy.
+    /// @param margin Relative enlargement of leaf boxes (fraction of box size, with a small absolute minimum).
+    BoundingVolumeHierarchy(float margin = .1f);
+    /// @brief Default destructor.
+    ~BoundingVolumeHierarchy() = default;
+
+    PREVENT_COPY(BoundingVolumeHierarchy);
+
+    /// @brief Inserts object into hierarchy.
+    /// @param aabb Bounds of the object.
+    /// @param user_data Value returned by queries for this object.
+    /// @return Proxy used to update or remove the object.
+    int32_t insert(const AABB& aabb, uint32_t user_data);
+    /// @brief Removes object from hierarchy.
+    /// @param proxy Proxy returned by insert.
+    void remove(int32_t proxy);
+    /// @brief Updates bounds of the object. Tree is changed only if the object left its fat box.
+    /// @param proxy Proxy returned by insert.
+    /// @param aabb New bounds of the object.
+    /// @return True if the object was reinserted. False otherwise.
+    bool update(int32_t proxy, const AABB& aabb);
+    /// @brief Removes all objects.
+    void clear();
+
+    /// @brief Collects objects that may be visible inside the frustum.
+    /// @param frustum Frustum to test against.
+    /// @param visible Output vector. User data of visible objects is appended to it.
+    /// @return Statistics of the query.
+    CullingStats query(const Frustum& frustum, std::vector<uint32_t>& visible) const;
+
+    /// @brief Returns enlarged bounds stored for the object.
+    /// @param proxy Proxy returned by insert.
+    /// @return Enlarged bounds of the object.
+    inline const AABB& get_fat_aabb(int32_t proxy) const { return m_nodes[proxy].m_aabb; }
+    /// @brief Returns user data of the object.
+    /// @param proxy Proxy returned by insert.
+    /// @return User data of the object.
+    inline uint32_t get_user_data(int32_t proxy) const { return m_nodes[proxy].m_user_data; }
+    /// @brief Returns number of objects in hierarchy.
+    /// @return Number of objects.
+    inline uint32_t size() const { return m_leaf_count; }
+    /// @brief Returns height of the tree (0 for a single leaf, -1 for empty tree).
+    /// @return Height of the tree.
+    inline int32_t get_height() const { return m_root == NULL_NODE ? -1 : m_nodes[m_root].m_height; }
+
+   private:
+    int32_t allocate_node();
+    void free_node(int32_t index);
+    void insert_leaf(int32_t leaf);
+    void remove_leaf(int32_t leaf);
+    void refit_ancestors(int32_t index);
+    int32_t balance(int32_t index);
+    AABB make_fat(const AABB& aabb) const;
+  };
+} // namespace esp
+
+#endif // RENDERER_CULLING_BOUNDING_VOLUME_HIERARCHY_HH
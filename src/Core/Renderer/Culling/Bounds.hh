@@ -0,0 +1,112 @@
+#ifndef RENDERER_CULLING_BOUNDS_HH
+#define RENDERER_CULLING_BOUNDS_HH
+
+#include "esppch.hh"
+
+namespace esp
+{
+  /// @brief Axis aligned bounding box. Default constructed box is empty (invalid).
+  struct AABB
+  {
+    /// @brief Minimal corner of the box.
+    glm::vec3 m_min{ std::numeric_limits<float>::max() };
+    /// @brief Maximal corner of the box.
+    glm::vec3 m_max{ std::numeric_limits<float>::lowest() };
+
+    /// @brief Default constructor. Creates empty box.
+    AABB() = default;
+    /// @brief Constructor setting corners of the box.
+    /// @param min Minimal corner of the box.
+    /// @param max Maximal corner of the box.
+    AABB(glm::vec3 min, glm::vec3 max) : m_min{ min }, m_max{ max } {}
+
+    /// @brief Checks if box contains at least one point.
+    /// @return True if box isn't empty. False otherwise.
+    inline bool is_valid() const { return m_min.x <= m_max.x && m_min.y <= m_max.y && m_min.z <= m_max.z; }
+
+    /// @brief Grows the box so it contains the point.
+    /// @param point Point to be contained.
+    inline void expand(const glm::vec3& point)
+    {
+      m_min = glm::min(m_min, point);
+      m_max = glm::max(m_max, point);
+    }
+    /// @brief Grows the box so it contains the other box.
+    /// @param other Box to be contained.
+    inline void expand(const AABB& other)
+    {
+      m_min = glm::min(m_min, other.m_min);
+      m_max = glm::max(m_max, other.m_max);
+    }
+
+    /// @brief Returns center of the box.
+    /// @return Center of the box.
+    inline glm::vec3 get_center() const { return (m_min + m_max) * .5f; }
+    /// @brief Returns half of the box size along each axis.
+    /// @return Half of the box size.
+    inline glm::vec3 get_extents() const { return (m_max - m_min) * .5f; }
+    /// @brief Returns surface area of the box.
+    /// @return Surface area of the box.
+    inline float get_surface_area() const
+    {
+      glm::vec3 d = m_max - m_min;
+      return 2.f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    /// @brief Checks if the other box lies completely inside this box.
+    /// @param other Box to check.
+    /// @return True if the other box is contained. False otherwise.
+    inline bool contains(const AABB& other) const
+    {
+      return m_min.x <= other.m_min.x && m_min.y <= other.m_min.y && m_min.z <= other.m_min.z &&
+          other.m_max.x <= m_max.x && other.m_max.y <= m_max.y && other.m_max.z <= m_max.z;
+    }
+
+    /// @brief Calculates box that contains this box transformed by the matrix.
+    /// @param matrix Affine transformation.
+    /// @return Transformed box.
+    inline AABB transform(const glm::mat4& matrix) const
+    {
+      if (!is_valid()) { return *this; }
+
+      glm::vec3 center  = glm::vec3(matrix * glm::vec4(get_center(), 1.f));
+      glm::vec3 extents = get_extents();
+      glm::vec3 new_extents =
+          glm::abs(glm::vec3(matrix[0])) * extents.x + glm::abs(glm::vec3(matrix[1])) * extents.y +
+          glm::abs(glm::vec3(matrix[2])) * extents.z;
+
+      return { center - new_extents, center + new_extents };
+    }
+
+    /// @brief Returns box that contains both boxes.
+    /// @param a First box.
+    /// @param b Second box.
+    /// @return Box containing both boxes.
+    inline static AABB merge(const AABB& a, const AABB& b)
+    {
+      return { glm::min(a.m_min, b.m_min), glm::max(a.m_max, b.m_max) };
+    }
+  };
+
+  /// @brief Bounding sphere.
+  struct BoundingSphere
+  {
+    /// @brief Center of the sphere.
+    glm::vec3 m_center{ 0.f };
+    /// @brief Radius of the sphere. Negative for empty sphere.
+    float m_radius{ -1.f };
+
+    /// @brief Calculates sphere that contains this sphere transformed by the matrix.
+    /// @param matrix Affine transformation.
+    /// @return Transformed sphere.
+    inline BoundingSphere transform(const glm::mat4& matrix) const
+    {
+      float scale = std::max({ glm::length(glm::vec3(matrix[0])),
+                               glm::length(glm::vec3(matrix[1])),
+                               glm::length(glm::vec3(matrix[2])) });
+      return { glm::vec3(matrix * glm::vec4(m_center, 1.f)), m_radius * scale };
+    }
+  };
+} // namespace esp
+
+#endif // RENDERER_CULLING_BOUNDS_HH
@@ -0,0 +1,133 @@
+#include "Frustum.hh"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define ESP_CULLING_SSE 1
+#include <xmmintrin.h>
+#else
+#define ESP_CULLING_SSE 0
+#endif
+
+// signatures
+static glm::vec4 normalize_plane(const glm::vec4& plane);
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  Frustum::Frustum() { m_planes.fill(glm::vec4(0.f, 0.f, 0.f, 1.f)); }
+
+  Frustum::Frustum(const glm::mat4& view_projection)
+  {
+    // Gribb-Hartmann extraction, glm matrices are column major
+    auto row = [&](int i)
+    { return glm::vec4(view_projection[0][i], view_projection[1][i], view_projection[2][i], view_projection[3][i]); };
+
+    m_planes[0] = normalize_plane(row(3) + row(0)); // left
+    m_planes[1] = normalize_plane(row(3) - row(0)); // right
+    m_planes[2] = normalize_plane(row(3) + row(1)); // bottom
+    m_planes[3] = normalize_plane(row(3) - row(1)); // top
+    // -w <= z is used for near plane. It is exact for OpenGL style depth and conservative for [0, 1] depth.
+    m_planes[4] = normalize_plane(row(3) + row(2)); // near
+    m_planes[5] = normalize_plane(row(3) - row(2)); // far
+  }
+
+  Frustum::Intersection Frustum::classify(const AABB& aabb) const
+  {
+    glm::vec3 center  = aabb.get_center();
+    glm::vec3 extents = aabb.get_extents();
+
+    Intersection result = INSIDE;
+    for (auto& plane : m_planes)
+    {
+      glm::vec3 normal = glm::vec3(plane);
+      float distance   = glm::dot(normal, center) + plane.w;
+      float radius     = glm::dot(glm::abs(normal), extents);
+
+      if (distance + radius < 0.f) { return OUTSIDE; }
+      if (distance - radius < 0.f) { result = INTERSECTS; }
+    }
+
+    return result;
+  }
+
+  bool Frustum::intersects(const AABB& aabb) const { return classify(aabb) != OUTSIDE; }
+
+  bool Frustum::intersects(const BoundingSphere& sphere) const
+  {
+    for (auto& plane : m_planes)
+    {
+      if (glm::dot(glm::vec3(plane), sphere.m_center) + plane.w < -sphere.m_radius) { return false; }
+    }
+
+    return true;
+  }
+
+  uint32_t Frustum::cull(const AABB* boxes, uint32_t count, uint8_t* visible) const
+  {
+    uint32_t visible_count = 0;
+    uint32_t i             = 0;
+
+#if ESP_CULLING_SSE
+    const __m128 half = _mm_set1_ps(.5f);
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; i + 4 <= count; i += 4)
+    {
+      const AABB* b = boxes + i;
+
+      __m128 min_x = _mm_setr_ps(b[0].m_min.x, b[1].m_min.x, b[2].m_min.x, b[3].m_min.x);
+      __m128 min_y = _mm_setr_ps(b[0].m_min.y, b[1].m_min.y, b[2].m_min.y, b[3].m_min.y);
+      __m128 min_z = _mm_setr_ps(b[0].m_min.z, b[1].m_min.z, b[2].m_min.z, b[3].m_min.z);
+      __m128 max_x = _mm_setr_ps(b[0].m_max.x, b[1].m_max.x, b[2].m_max.x, b[3].m_max.x);
+      __m128 max_y = _mm_setr_ps(b[0].m_max.y, b[1].m_max.y, b[2].m_max.y, b[3].m_max.y);
+      __m128 max_z = _mm_setr_ps(b[0].m_max.z, b[1].m_max.z, b[2].m_max.z, b[3].m_max.z);
+
+      __m128 center_x  = _mm_mul_ps(_mm_add_ps(min_x, max_x), half);
+      __m128 center_y  = _mm_mul_ps(_mm_add_ps(min_y, max_y), half);
+      __m128 center_z  = _mm_mul_ps(_mm_add_ps(min_z, max_z), half);
+      __m128 extents_x = _mm_mul_ps(_mm_sub_ps(max_x, min_x), half);
+      __m128 extents_y = _mm_mul_ps(_mm_sub_ps(max_y, min_y), half);
+      __m128 extents_z = _mm_mul_ps(_mm_sub_ps(max_z, min_z), half);
+
+      __m128 outside = _mm_setzero_ps();
+      for (auto& plane : m_planes)
+      {
+        __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), center_x),
+                                                _mm_mul_ps(_mm_set1_ps(plane.y), center_y)),
+                                     _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.z), center_z), _mm_set1_ps(plane.w)));
+        __m128 radius   = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(std::abs(plane.x)), extents_x),
+                                              _mm_mul_ps(_mm_set1_ps(std::abs(plane.y)), extents_y)),
+                                   _mm_mul_ps(_mm_set1_ps(std::abs(plane.z)), extents_z));
+
+        outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+      }
+
+      int mask = _mm_movemask_ps(outside);
+      for (uint32_t k = 0; k < 4; k++)
+      {
+        visible[i + k] = ((mask >> k) & 1) ? 0 : 1;
+        visible_count += visible[i + k];
+      }
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+      visible[i] = intersects(boxes[i]) ? 1 : 0;
+      visible_count += visible[i];
+    }
+
+    return visible_count;
+  }
+} // namespace esp
+
+/* --------------------------------------------------------- */
+/* ------------------ HELPFUL FUNCTIONS -------------------- */
+/* --------------------------------------------------------- */
+static glm::vec4 normalize_plane(const glm::vec4& plane)
+{
+  float length = glm::length(glm::vec3(plane));
+  return length > 0.f ? plane / length : plane;
+}
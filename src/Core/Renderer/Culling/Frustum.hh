@@ -0,0 +1,61 @@
+#ifndef RENDERER_CULLING_FRUSTUM_HH
+#define RENDERER_CULLING_FRUSTUM_HH
+
+#include "esppch.hh"
+
+#include "Bounds.hh"
+
+namespace esp
+{
+  /// @brief View frustum described by six planes pointing inwards.
+  class Frustum
+  {
+   public:
+    /// @brief Result of the box and frustum test.
+    enum Intersection
+    {
+      OUTSIDE,
+      INTERSECTS,
+      INSIDE
+    };
+
+    static constexpr uint32_t PLANE_COUNT = 6;
+
+   private:
+    std::array<glm::vec4, PLANE_COUNT> m_planes;
+
+   public:
+    /// @brief Creates frustum that contains everything.
+    Frustum();
+    /// @brief Extracts planes of the frustum from view projection matrix.
+    /// @param view_projection Projection matrix multiplied by view matrix.
+    explicit Frustum(const glm::mat4& view_projection);
+
+    /// @brief Classifies box against the frustum.
+    /// @param aabb Box to test.
+    /// @return OUTSIDE, INSIDE or INTERSECTS.
+    Intersection classify(const AABB& aabb) const;
+    /// @brief Checks if box is at least partially inside the frustum.
+    /// @param aabb Box to test.
+    /// @return True if box may be visible. False otherwise.
+    bool intersects(const AABB& aabb) const;
+    /// @brief Checks if sphere is at least partially inside the frustum.
+    /// @param sphere Sphere to test.
+    /// @return True if sphere may be visible. False otherwise.
+    bool intersects(const BoundingSphere& sphere) const;
+
+    /// @brief Tests many boxes against the frustum. Boxes are processed 4 at a time with SIMD when it's available.
+    /// @param boxes Boxes to test.
+    /// @param count Number of boxes.
+    /// @param visible Output array of count values. 1 if box may be visible, 0 otherwise.
+    /// @return Number of visible boxes.
+    uint32_t cull(const AABB* boxes, uint32_t count, uint8_t* visible) const;
+
+    /// @brief Returns plane of the frustum. Order: left, right, bottom, top, near, far.
+    /// @param index Index of the plane.
+    /// @return Normalized plane equation (xyz - normal, w - distance).
+    inline const glm::vec4& get_plane(uint32_t index) const { return m_planes[index]; }
+  };
+} // namespace esp
+
+#endif // RENDERER_CULLING_FRUSTUM_HH
@@ -0,0 +1,115 @@
+#include "GpuIndirectDrawCuller.hh"
+#include "Core/RenderAPI/Work/EspJob.hh"
+#include "Core/RenderAPI/Worker/EspWorkerBuilder.hh"
+
+// SPIR-V of Core/Renderer/Culling/Shaders/indirect_cull.comp, generated by the build
+#include "indirect_cull.comp.h"
+
+namespace esp
+{
+  std::unique_ptr<GpuIndirectDrawCuller> GpuIndirectDrawCuller::create(uint32_t max_draw_count,
+                                                                       EspDrawCommandBuffer& draw_command_buffer)
+  {
+    ESP_ASSERT(is_supported(), "Draws can't be culled by the GPU, use IndirectDrawCuller instead.")
+
+    return std::unique_ptr<GpuIndirectDrawCuller>(new GpuIndirectDrawCuller(max_draw_count, draw_command_buffer));
+  }
+
+  bool GpuIndirectDrawCuller::is_supported() { return EspDrawCommandBuffer::is_gpu_count_supported(); }
+
+  GpuIndirectDrawCuller::GpuIndirectDrawCuller(uint32_t max_draw_count, EspDrawCommandBuffer& draw_command_buffer) :
+      m_draw_command_buffer{ draw_command_buffer }, m_max_draw_count{ max_draw_count }
+  {
+    ESP_ASSERT(max_draw_count > 0, "Culler needs space for at least one draw.")
+
+    SpirvData code(indirect_cull_comp, indirect_cull_comp + sizeof(indirect_cull_comp) / sizeof(uint32_t));
+
+    SpirvReflection reflection = {};
+    auto uniforms_meta_data    = EspUniformMetaData::create();
+    if (!reflection.add_stage(EspShaderStage::COMPUTE, code) || !reflection.fill_uniform_meta_data(*uniforms_meta_data))
+    {
+      ESP_CORE_ERROR("Could not reflect the indirect culling shader.");
+      throw std::runtime_error("Could not reflect the indirect culling shader.");
+    }
+    SpirvDataMap spirv_data_map = { { EspShaderStage::COMPUTE, std::move(code) } };
+    auto spirv_resource =
+        std::make_shared<SpirvResource>("indirect_cull", std::move(spirv_data_map), std::move(reflection));
+
+    auto builder = EspWorkerBuilder::create();
+    builder->set_shaders(std::move(spirv_resource));
+    builder->set_worker_layout(std::move(uniforms_meta_data));
+    m_worker = builder->build_compute_worker();
+
+    m_bounds   = EspStorageBuffer::create(max_draw_count * sizeof(indirect_cull_kernel::Bounds));
+    m_commands = EspStorageBuffer::create(max_draw_count * sizeof(EspDrawIndexedCommand));
+
+    // output buffers hold all frames in flight, the shader writes the current frame's part
+    m_uniform_manager = m_worker->create_uniform_manager();
+    m_uniform_manager->load_storage_buffer(0, 0, m_bounds.get());
+    m_uniform_manager->load_storage_buffer(0, 1, m_commands.get());
+    m_uniform_manager->load_storage_buffer(0, 2, m_draw_command_buffer.get_command_storage());
+    m_uniform_manager->load_storage_buffer(0, 3, m_draw_command_buffer.get_count_storage());
+    m_uniform_manager->build();
+  }
+
+  void GpuIndirectDrawCuller::upload(const IndirectDrawCuller& draws)
+  {
+    ESP_ASSERT(draws.size() <= m_max_draw_count, "Culler can't hold all the draws.")
+
+    m_draw_count = std::min(draws.size(), m_max_draw_count);
+    if (m_draw_count == 0) { return; }
+
+    std::vector<indirect_cull_kernel::Bounds> bounds(m_draw_count);
+    for (uint32_t i = 0; i < m_draw_count; i++)
+    {
+      bounds[i] = indirect_cull_kernel::pack_bounds(draws.get_bounds()[i]);
+    }
+
+    m_bounds->update(0, m_draw_count * sizeof(indirect_cull_kernel::Bounds), bounds.data());
+    m_commands->update(0, m_draw_count * sizeof(EspDrawIndexedCommand), draws.get_commands().data());
+  }
+
+  void GpuIndirectDrawCuller::cull(const Frustum& frustum)
+  {
+    auto push = prepare_cull(frustum);
+    if (m_draw_count == 0) { return; }
+
+    m_worker->attach();
+    m_uniform_manager->attach();
+    m_uniform_manager->update_push_uniform(0, &push);
+
+    EspJob::dispatch(esp_group_count(m_draw_count, LOCAL_SIZE), 1, 1);
+    EspJob::barrier(EspBarrier::ESP_BARRIER_COMPUTE_TO_INDIRECT);
+  }
+
+  void GpuIndirectDrawCuller::cull(EspCommandBufferId* id, const Frustum& frustum)
+  {
+    auto push = prepare_cull(frustum);
+    if (m_draw_count == 0) { return; }
+
+    m_worker->attach(id);
+    m_uniform_manager->attach(id);
+    m_uniform_manager->update_push_uniform(id, 0, &push);
+
+    EspJob::dispatch(id, esp_group_count(m_draw_count, LOCAL_SIZE), 1, 1);
+    EspJob::barrier(id, EspBarrier::ESP_BARRIER_COMPUTE_TO_INDIRECT);
+  }
+
+  GpuIndirectDrawCuller::CullPush GpuIndirectDrawCuller::prepare_cull(const Frustum& frustum)
+  {
+    // the shader counts visible draws up from zero, the count of the current frame isn't read by the GPU yet
+    m_draw_command_buffer.set_command_count(0);
+
+    CullPush push{};
+    for (uint32_t i = 0; i < Frustum::PLANE_COUNT; i++)
+    {
+      push.m_planes[i] = frustum.get_plane(i);
+    }
+    push.m_draw_count    = m_draw_count;
+    push.m_first_command = m_draw_command_buffer.get_first_command_index();
+    push.m_count_index   = m_draw_command_buffer.get_count_index();
+    push.m_max_count     = m_draw_command_buffer.get_max_command_count();
+
+    return push;
+  }
+} // namespace esp
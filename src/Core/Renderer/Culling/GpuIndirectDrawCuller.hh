@@ -0,0 +1,90 @@
+#ifndef RENDERER_CULLING_GPU_INDIRECT_DRAW_CULLER_HH
+#define RENDERER_CULLING_GPU_INDIRECT_DRAW_CULLER_HH
+
+#include "esppch.hh"
+
+#include "Core/RenderAPI/Resources/EspDrawCommandBuffer.hh"
+#include "Core/RenderAPI/Resources/EspStorageBuffer.hh"
+#include "Core/RenderAPI/Worker/EspComputeWorker.hh"
+#include "Frustum.hh"
+#include "IndirectCullKernel.hh"
+#include "IndirectDrawCuller.hh"
+
+namespace esp
+{
+  /// @brief Compute shader version of IndirectDrawCuller. Draws are uploaded to storage buffers once they change,
+  /// every frame a dispatch culls them against the frustum and compacts visible commands into the current frame of the
+  /// draw command buffer, together with their count. Draw them with EspJob::draw_indexed_indirect_count.
+  ///
+  /// The test and the compaction rule are shared with indirect_cull_kernel::run, the CPU reference of the shader.
+  /// Visible commands are packed, but their order isn't preserved. The count is written by the GPU, so it requires
+  /// EspDrawCommandBuffer::is_gpu_count_supported(), IndirectDrawCuller is the fallback on other devices.
+  class GpuIndirectDrawCuller
+  {
+   public:
+    /// @brief Local size of the culling shader.
+    static constexpr uint32_t LOCAL_SIZE = 64;
+
+   private:
+    // layout of the shader's push constant block
+    struct CullPush
+    {
+      glm::vec4 m_planes[Frustum::PLANE_COUNT];
+      uint32_t m_draw_count;
+      uint32_t m_first_command;
+      uint32_t m_count_index;
+      uint32_t m_max_count;
+    };
+
+    EspDrawCommandBuffer& m_draw_command_buffer;
+    uint32_t m_max_draw_count;
+    uint32_t m_draw_count = 0;
+
+    std::unique_ptr<EspStorageBuffer> m_bounds;
+    std::unique_ptr<EspStorageBuffer> m_commands;
+    std::unique_ptr<EspComputeWorker> m_worker;
+    std::unique_ptr<EspUniformManager> m_uniform_manager;
+
+   public:
+    /// @brief Creates culler writing commands to the buffer.
+    /// @param max_draw_count Maximum number of uploaded draws.
+    /// @param draw_command_buffer Buffer visible commands are written to. It has to outlive the culler.
+    /// @return Unique pointer to instance of the culler.
+    static std::unique_ptr<GpuIndirectDrawCuller> create(uint32_t max_draw_count,
+                                                         EspDrawCommandBuffer& draw_command_buffer);
+
+    /// @brief Checks if draws can be culled by the GPU.
+    /// @return True if the device can draw commands counted by the GPU.
+    static bool is_supported();
+
+    /// @brief Default destructor.
+    ~GpuIndirectDrawCuller() = default;
+
+    PREVENT_COPY(GpuIndirectDrawCuller);
+
+    /// @brief Copies draws of the CPU side list to the GPU. Has to be called outside of render plans, whenever the
+    /// draws change.
+    /// @param draws List of draws with bounds.
+    void upload(const IndirectDrawCuller& draws);
+
+    /// @brief Records culling of the uploaded draws into the command buffer of the current frame, followed by a
+    /// barrier making the commands visible to indirect draws. Has to be called outside of render plans.
+    /// @param frustum Frustum of the camera.
+    void cull(const Frustum& frustum);
+    /// @brief Same as above, but records into the given command buffer, e.g. the async compute one.
+    /// @param id Command buffer the culling is recorded into.
+    /// @param frustum Frustum of the camera.
+    void cull(EspCommandBufferId* id, const Frustum& frustum);
+
+    /// @brief Returns number of uploaded draws.
+    /// @return Number of draws.
+    inline uint32_t size() const { return m_draw_count; }
+
+   private:
+    GpuIndirectDrawCuller(uint32_t max_draw_count, EspDrawCommandBuffer& draw_command_buffer);
+
+    CullPush prepare_cull(const Frustum& frustum);
+  };
+} // namespace esp
+
+#endif // RENDERER_CULLING_GPU_INDIRECT_DRAW_CULLER_HH
@@ -0,0 +1,65 @@
+#ifndef RENDERER_CULLING_INDIRECT_CULL_KERNEL_HH
+#define RENDERER_CULLING_INDIRECT_CULL_KERNEL_HH
+
+#include "esppch.hh"
+
+#include "Bounds.hh"
+#include "Core/RenderAPI/Resources/EspDrawCommandBuffer.hh"
+#include "Frustum.hh"
+
+namespace esp::indirect_cull_kernel
+{
+  // the shared GLSL code is compiled as C++ with glm types and functions
+  using namespace glm;
+  using uint = uint32_t;
+
+#include "Shaders/indirect_cull.glsl"
+
+  /// @brief Bounds of a draw as read by indirect_cull.comp. vec3 is padded to 16 bytes in storage buffers.
+  struct Bounds
+  {
+    glm::vec4 m_min;
+    glm::vec4 m_max;
+  };
+
+  /// @brief Converts bounds to the layout read by the shader.
+  /// @param aabb World space bounds of the draw.
+  /// @return Bounds of the draw.
+  inline Bounds pack_bounds(const AABB& aabb) { return { glm::vec4(aabb.m_min, 1.f), glm::vec4(aabb.m_max, 1.f) }; }
+
+  /// @brief CPU reference of indirect_cull.comp. Runs invocations one after another, so commands are written in draw
+  /// order, the GPU writes the same commands in any order.
+  /// @param frustum Frustum of the camera.
+  /// @param bounds Bounds of the draws.
+  /// @param commands Commands of the draws.
+  /// @param draw_count Number of draws.
+  /// @param out_commands Output array of commands.
+  /// @param max_count Capacity of the output array.
+  /// @return Value of the counter, which may exceed the capacity.
+  inline uint32_t run(const Frustum& frustum,
+                      const Bounds* bounds,
+                      const EspDrawIndexedCommand* commands,
+                      uint32_t draw_count,
+                      EspDrawIndexedCommand* out_commands,
+                      uint32_t max_count)
+  {
+    glm::vec4 planes[Frustum::PLANE_COUNT];
+    for (uint32_t i = 0; i < Frustum::PLANE_COUNT; i++)
+    {
+      planes[i] = frustum.get_plane(i);
+    }
+
+    uint32_t counter = 0;
+    for (uint32_t index = 0; index < draw_count; index++)
+    {
+      if (!indirect_cull_is_visible(planes, bounds[index].m_min, bounds[index].m_max)) { continue; }
+
+      uint32_t slot = counter++;
+      if (indirect_cull_is_slot_written(slot, max_count)) { out_commands[slot] = commands[index]; }
+    }
+
+    return counter;
+  }
+} // namespace esp::indirect_cull_kernel
+
+#endif // RENDERER_CULLING_INDIRECT_CULL_KERNEL_HH
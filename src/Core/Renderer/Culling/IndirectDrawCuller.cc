@@ -0,0 +1,74 @@
+#include "IndirectDrawCuller.hh"
+#include "Core/Jobs/JobSystem.hh"
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  uint32_t IndirectDrawCuller::add(const AABB& bounds, const EspDrawIndexedCommand& command)
+  {
+    m_bounds.push_back(bounds);
+    m_commands.push_back(command);
+
+    return static_cast<uint32_t>(m_commands.size() - 1);
+  }
+
+  void IndirectDrawCuller::clear()
+  {
+    m_bounds.clear();
+    m_commands.clear();
+  }
+
+  uint32_t IndirectDrawCuller::cull(const Frustum& frustum, EspDrawIndexedCommand* commands, uint32_t max_count)
+  {
+    uint32_t count       = size();
+    uint32_t batch_count = (count + BATCH_SIZE - 1) / BATCH_SIZE;
+
+    m_visible.resize(count);
+    m_batch_offsets.resize(batch_count + 1);
+
+    // 1. visibility and number of visible draws of every batch
+    JobSystem::parallel_for(
+        count,
+        BATCH_SIZE,
+        [&](uint32_t begin, uint32_t end)
+        {
+          m_batch_offsets[begin / BATCH_SIZE + 1] =
+              frustum.cull(m_bounds.data() + begin, end - begin, m_visible.data() + begin);
+        },
+        "indirect_cull");
+
+    // 2. exclusive prefix sum - output offset of every batch
+    m_batch_offsets[0] = 0;
+    for (uint32_t batch = 1; batch <= batch_count; batch++)
+    {
+      m_batch_offsets[batch] += m_batch_offsets[batch - 1];
+    }
+
+    // 3. visible commands are scattered to their packed positions
+    JobSystem::parallel_for(
+        count,
+        BATCH_SIZE,
+        [&](uint32_t begin, uint32_t end)
+        {
+          uint32_t offset = m_batch_offsets[begin / BATCH_SIZE];
+          for (uint32_t i = begin; i < end && offset < max_count; i++)
+          {
+            if (m_visible[i]) { commands[offset++] = m_commands[i]; }
+          }
+        },
+        "indirect_compact");
+
+    return std::min(m_batch_offsets[batch_count], max_count);
+  }
+
+  uint32_t IndirectDrawCuller::cull(const Frustum& frustum, EspDrawCommandBuffer& buffer)
+  {
+    uint32_t count = cull(frustum, buffer.get_commands(), buffer.get_max_command_count());
+    buffer.set_command_count(count);
+
+    return count;
+  }
+} // namespace esp
@@ -0,0 +1,74 @@
+#ifndef RENDERER_CULLING_INDIRECT_DRAW_CULLER_HH
+#define RENDERER_CULLING_INDIRECT_DRAW_CULLER_HH
+
+#include "esppch.hh"
+
+#include "Bounds.hh"
+#include "Core/RenderAPI/Resources/EspDrawCommandBuffer.hh"
+#include "Frustum.hh"
+
+namespace esp
+{
+  /// @brief List of draws with bounds. Draws that survive the frustum test are written to the draw command buffer
+  /// packed and in insertion order, so all of them can be submitted with a single indirect draw.
+  ///
+  /// Works like a GPU compaction pass: batches are culled in parallel, an exclusive prefix sum of visible counts
+  /// gives every batch its output offset, then batches write their commands in parallel. GpuIndirectDrawCuller runs
+  /// the test in a compute shader instead, this class is the fallback on devices without indirect draws with count.
+  class IndirectDrawCuller
+  {
+   public:
+    static constexpr uint32_t BATCH_SIZE = 2048;
+
+   private:
+    std::vector<AABB> m_bounds;
+    std::vector<EspDrawIndexedCommand> m_commands;
+
+    std::vector<uint8_t> m_visible;
+    std::vector<uint32_t> m_batch_offsets;
+
+   public:
+    /// @brief Creates empty list.
+    IndirectDrawCuller() = default;
+    /// @brief Default destructor.
+    ~IndirectDrawCuller() = default;
+
+    PREVENT_COPY(IndirectDrawCuller);
+
+    /// @brief Adds draw to the list.
+    /// @param bounds World space bounds of the draw.
+    /// @param command Command written when the draw is visible.
+    /// @return Index of the draw.
+    uint32_t add(const AABB& bounds, const EspDrawIndexedCommand& command);
+    /// @brief Changes bounds of the draw.
+    /// @param index Index returned by add.
+    /// @param bounds New world space bounds of the draw.
+    inline void set_bounds(uint32_t index, const AABB& bounds) { m_bounds[index] = bounds; }
+    /// @brief Removes all draws.
+    void clear();
+
+    /// @brief Culls draws and writes visible commands packed into array.
+    /// @param frustum Frustum of the camera.
+    /// @param commands Output array of commands.
+    /// @param max_count Capacity of the output array. Visible draws that don't fit are skipped.
+    /// @return Number of written commands.
+    uint32_t cull(const Frustum& frustum, EspDrawIndexedCommand* commands, uint32_t max_count);
+    /// @brief Culls draws, writes visible commands to the current frame of the buffer and sets their count.
+    /// @param frustum Frustum of the camera.
+    /// @param buffer Draw command buffer.
+    /// @return Number of written commands.
+    uint32_t cull(const Frustum& frustum, EspDrawCommandBuffer& buffer);
+
+    /// @brief Returns number of draws.
+    /// @return Number of draws.
+    inline uint32_t size() const { return static_cast<uint32_t>(m_commands.size()); }
+    /// @brief Returns bounds of the draws, e.g. to upload them to GpuIndirectDrawCuller.
+    /// @return Vector of bounds ordered by index of the draw.
+    inline const std::vector<AABB>& get_bounds() const { return m_bounds; }
+    /// @brief Returns commands of the draws.
+    /// @return Vector of commands ordered by index of the draw.
+    inline const std::vector<EspDrawIndexedCommand>& get_commands() const { return m_commands; }
+  };
+} // namespace esp
+
+#endif // RENDERER_CULLING_INDIRECT_DRAW_CULLER_HH
@@ -0,0 +1,21 @@
+// Visibility test and compaction rule of indirect_cull.comp. The file is written in the subset of GLSL shared with C++
+// and glm, IndirectCullKernel.hh includes it as well, so the CPU reference used by tests runs exactly this code.
+
+// Same test as Frustum::classify: the box is culled if it lies completely behind any of the planes.
+bool indirect_cull_is_visible(const vec4 planes[6], vec4 min_corner, vec4 max_corner)
+{
+  vec3 center  = (vec3(min_corner) + vec3(max_corner)) * 0.5f;
+  vec3 extents = (vec3(max_corner) - vec3(min_corner)) * 0.5f;
+
+  for (int i = 0; i < 6; i++)
+  {
+    vec3 normal = vec3(planes[i]);
+    if (dot(normal, center) + planes[i].w + dot(abs(normal), extents) < 0.0f) { return false; }
+  }
+
+  return true;
+}
+
+// Visible draws take slots from an atomic counter, which may grow past the capacity. Indirect draws clamp the count
+// to the maximum draw count, so only commands in slots that fit are written.
+bool indirect_cull_is_slot_written(uint slot, uint max_count) { return slot < max_count; }
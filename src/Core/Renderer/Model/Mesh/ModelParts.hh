@@ -3,6 +3,7 @@
 
 #include "esppch.hh"
 
+#include "Core/Renderer/Culling/Bounds.hh"
 #include "Core/Resources/Systems/MaterialSystem.hh"
 
 namespace esp
@@ -25,6 +26,9 @@ namespace esp
     uint32_t m_index_count;
 
     std::shared_ptr<Material> m_material;
+
+    AABB m_aabb;
+    BoundingSphere m_sphere;
   };
 } // namespace esp
 
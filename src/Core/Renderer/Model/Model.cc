@@ -10,6 +10,9 @@
 
 #include <map>
 
+// signatures
+static void compute_mesh_bounds(esp::Mesh& mesh, const esp::Vertex* vertices, uint32_t vertex_count);
+
 namespace esp
 {
   std::shared_ptr<Material> Model::load_material(const aiMaterial* ai_material)
@@ -46,6 +49,27 @@ namespace esp
         std::count_if(m_nodes.begin(), m_nodes.end(), [](ModelNode* node) { return node->m_has_meshes; }) > 1;
   }
 
+  void Model::compute_bounds()
+  {
+    m_aabb = {};
+
+    auto add_node = [&](ModelNode* node)
+    {
+      for (auto mesh_idx : node->m_meshes)
+      {
+        m_aabb.expand(m_meshes[mesh_idx].m_aabb.transform(node->m_precomputed_transformation));
+      }
+    };
+
+    add_node(&m_root_node);
+    for (auto node : m_nodes)
+    {
+      add_node(node);
+    }
+
+    if (m_aabb.is_valid()) { m_sphere = { m_aabb.get_center(), glm::length(m_aabb.get_extents()) }; }
+  }
+
   void Model::precompute_transform_matrices(ModelNode* node, glm::mat4 prev_matrix)
   {
     node->m_precomputed_transformation = prev_matrix * node->m_transformation;
@@ -151,6 +175,8 @@ namespace esp
 
     if (mesh->HasBones()) { process_mesh_bones(vertex_bias, mesh, scene, vertex_buffer); }
 
+    compute_mesh_bounds(n_mesh, vertex_buffer.data() + vertex_bias, mesh->mNumVertices);
+
     uint32_t number_of_indices = 0;
     for (uint32_t face_idx = 0; face_idx < mesh->mNumFaces; face_idx++)
     {
@@ -199,6 +225,8 @@ namespace esp
 
   Model::Model(const std::string& path_to_model, ModelParams params) : m_bone_counter{ 0 }, m_params{ params }
   {
+    ESP_PROFILE_SCOPE("Model import");
+
     m_dir = path_to_model.substr(0, path_to_model.find_last_of('/'));
 
     Assimp::Importer importer;
@@ -234,6 +262,7 @@ namespace esp
 
     set_renderer_flags();
     precompute_transform_matrices(&m_root_node, glm::mat4(1));
+    compute_bounds();
   }
 
   Model::Model(std::vector<Vertex>& vertex_buffer,
@@ -248,6 +277,7 @@ namespace esp
     auto material = textures.empty() ? nullptr : MaterialSystem::acquire(textures, m_params.m_material_texture_layout);
     m_meshes.push_back(
         { .m_first_index = 0, .m_index_count = static_cast<uint32_t>(index_buffer.size()), .m_material = material });
+    compute_mesh_bounds(m_meshes.back(), vertex_buffer.data(), static_cast<uint32_t>(vertex_buffer.size()));
 
     std::vector<uint8_t> vertex_byte_buffer;
     m_params.parse_to_vertex_byte_buffer(vertex_buffer, vertex_byte_buffer);
@@ -257,6 +287,7 @@ namespace esp
 
     set_renderer_flags();
     precompute_transform_matrices(&m_root_node, glm::mat4(1));
+    compute_bounds();
   }
 
   Model::~Model()
@@ -269,3 +300,27 @@ namespace esp
     m_nodes.clear();
   }
 } // namespace esp
+
+/* --------------------------------------------------------- */
+/* ------------------ HELPFUL FUNCTIONS -------------------- */
+/* --------------------------------------------------------- */
+static void compute_mesh_bounds(esp::Mesh& mesh, const esp::Vertex* vertices, uint32_t vertex_count)
+{
+  mesh.m_aabb = {};
+  for (uint32_t i = 0; i < vertex_count; i++)
+  {
+    mesh.m_aabb.expand(vertices[i].m_position);
+  }
+
+  if (!mesh.m_aabb.is_valid()) { return; }
+
+  // sphere around the box center, shrunk to the farthest vertex
+  float radius_squared = 0.f;
+  glm::vec3 center     = mesh.m_aabb.get_center();
+  for (uint32_t i = 0; i < vertex_count; i++)
+  {
+    glm::vec3 d    = vertices[i].m_position - center;
+    radius_squared = std::max(radius_squared, glm::dot(d, d));
+  }
+  mesh.m_sphere = { center, std::sqrt(radius_squared) };
+}
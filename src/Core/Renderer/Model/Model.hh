@@ -36,6 +36,10 @@ namespace esp
     std::vector<Mesh> m_meshes;
     std::vector<ModelNode*> m_nodes;
 
+    // model space bounds of all meshes (in bind pose)
+    AABB m_aabb;
+    BoundingSphere m_sphere;
+
     std::map<std::string, BoneInfo> m_bone_info_map;
     uint32_t m_bone_counter;
 
@@ -65,6 +69,7 @@ namespace esp
                             std::vector<Vertex>& vertex_buffer);
 
     void set_renderer_flags();
+    void compute_bounds();
     void precompute_transform_matrices(ModelNode* node, glm::mat4 prev_matrix);
 
     std::shared_ptr<Material> load_material(const aiMaterial* ai_material);
@@ -85,6 +90,8 @@ namespace esp
     inline const ModelNode& get_root_node() const { return m_root_node; }
 
     inline bool has_many_mesh_nodes() { return m_has_many_mesh_nodes; }
+    inline const AABB& get_aabb() const { return m_aabb; }
+    inline const BoundingSphere& get_sphere() const { return m_sphere; }
 
     ModelIterator begin() { return ModelIterator(this); }
     ModelIterator end() { return ModelIterator(nullptr); }
@@ -0,0 +1,342 @@
+#include "RenderQueue.hh"
+
+#include "Core/Jobs/JobSystem.hh"
+#include "Core/RenderAPI/RenderPlans/EspRenderPlan.hh"
+#include "Core/RenderAPI/Resources/EspBindlessTextures.hh"
+#include "Core/RenderAPI/Resources/EspShader.hh"
+#include "Core/RenderAPI/Uniforms/EspUniformManager.hh"
+#include "Core/RenderAPI/Work/EspJob.hh"
+#include "Core/Renderer/Model/Model.hh"
+
+// signatures
+namespace
+{
+  class EspJobCommandSink : public esp::RenderQueueCommandSink
+  {
+   public:
+    void bind_shader(esp::EspShader& shader) override { shader.attach(); }
+    void bind_geometry(esp::Model& model) override
+    {
+      model.m_vertex_buffer->attach();
+      model.m_index_buffer->attach();
+    }
+    void bind_uniforms(const esp::EspUniformManager& manager) override { manager.attach(); }
+    void bind_uniforms(const esp::EspUniformManager& manager, uint32_t dynamic_offset) override
+    {
+      manager.attach(&dynamic_offset, 1);
+    }
+    void push_uniform(const esp::EspUniformManager& manager, void* data) override
+    {
+      manager.update_push_uniform(0, data);
+    }
+    void push_material(const esp::EspUniformManager& manager, uint32_t material_index) override
+    {
+      manager.update_push_uniform(esp::EspBindlessTextures::MATERIAL_PUSH_UNIFORM, &material_index);
+    }
+    void draw_indexed(uint32_t index_count, uint32_t first_index) override
+    {
+      esp::EspJob::draw_indexed(index_count, 1, first_index);
+    }
+  };
+
+  class EspCommandBufferSink : public esp::RenderQueueCommandSink
+  {
+   private:
+    esp::EspRenderPlan& m_plan;
+    esp::EspCommandBufferId* m_id = nullptr;
+
+   public:
+    EspCommandBufferSink(esp::EspRenderPlan& plan) : m_plan{ plan } {}
+
+    // secondary command buffer has to be begun on the thread that records it
+    void begin() override { m_id = m_plan.begin_secondary(); }
+    void end() override { esp::EspCommandBuffer::end_secondary(m_id); }
+    inline esp::EspCommandBufferId* get_id() const { return m_id; }
+
+    void bind_shader(esp::EspShader& shader) override { shader.attach(m_id); }
+    void bind_geometry(esp::Model& model) override
+    {
+      model.m_vertex_buffer->attach(m_id);
+      model.m_index_buffer->attach(m_id);
+    }
+    void bind_uniforms(const esp::EspUniformManager& manager) override { manager.attach(m_id); }
+    void bind_uniforms(const esp::EspUniformManager& manager, uint32_t dynamic_offset) override
+    {
+      manager.attach(m_id, &dynamic_offset, 1);
+    }
+    void push_uniform(const esp::EspUniformManager& manager, void* data) override
+    {
+      manager.update_push_uniform(m_id, 0, data);
+    }
+    void push_material(const esp::EspUniformManager& manager, uint32_t material_index) override
+    {
+      manager.update_push_uniform(m_id, esp::EspBindlessTextures::MATERIAL_PUSH_UNIFORM, &material_index);
+    }
+    void draw_indexed(uint32_t index_count, uint32_t first_index) override
+    {
+      esp::EspJob::draw_indexed(m_id, index_count, 1, first_index);
+    }
+  };
+} // namespace
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  void RenderQueue::begin()
+  {
+    m_items.clear();
+    m_entries.clear();
+    m_pipeline_ids.clear();
+    m_material_ids.clear();
+    m_sorted = false;
+  }
+
+  void RenderQueue::submit(const RenderQueueItem& item)
+  {
+    ESP_ASSERT(item.m_shader && item.m_model && item.m_uniform_manager, "Render queue item is incomplete")
+
+    uint16_t pipeline_id = get_id(m_pipeline_ids, item.m_shader);
+    uint16_t material_id = item.m_material ? get_id(m_material_ids, item.m_material) : 0;
+
+    m_entries.push_back({ make_sort_key(item.m_pass, pipeline_id, material_id, item.m_depth),
+                          static_cast<uint32_t>(m_items.size()) });
+    m_items.push_back(item);
+    m_sorted = false;
+  }
+
+  void RenderQueue::sort()
+  {
+    if (m_sorted) { return; }
+    m_sorted = true;
+
+    const size_t count = m_entries.size();
+    if (count < 2) { return; }
+    m_scratch.resize(count);
+
+    SortEntry* src = m_entries.data();
+    SortEntry* dst = m_scratch.data();
+
+    for (uint32_t shift = 0; shift < 64; shift += 8)
+    {
+      uint32_t histogram[256] = {};
+      for (size_t i = 0; i < count; i++)
+      {
+        histogram[(src[i].m_key >> shift) & 0xff]++;
+      }
+
+      // every key has the same digit - the pass wouldn't change the order
+      if (histogram[(src[0].m_key >> shift) & 0xff] == count) { continue; }
+
+      uint32_t offset = 0;
+      for (auto& bucket : histogram)
+      {
+        uint32_t bucket_size = bucket;
+        bucket               = offset;
+        offset += bucket_size;
+      }
+
+      for (size_t i = 0; i < count; i++)
+      {
+        dst[histogram[(src[i].m_key >> shift) & 0xff]++] = src[i];
+      }
+      std::swap(src, dst);
+    }
+
+    if (src != m_entries.data()) { std::copy(src, src + count, m_entries.data()); }
+  }
+
+  void RenderQueue::flush(RenderQueueCommandSink& sink)
+  {
+    sort();
+    m_stats = {};
+
+    sink.begin();
+    record(sink, 0, static_cast<uint32_t>(m_entries.size()), m_stats);
+    sink.end();
+  }
+
+  void RenderQueue::flush()
+  {
+    EspJobCommandSink sink;
+    flush(sink);
+  }
+
+  void RenderQueue::flush(const std::vector<RenderQueueCommandSink*>& sinks)
+  {
+    sort();
+    m_stats = {};
+
+    const uint32_t count       = static_cast<uint32_t>(m_entries.size());
+    const uint32_t range_count = static_cast<uint32_t>(sinks.size());
+    if (range_count == 0) { return; }
+
+    std::vector<RenderQueueStats> stats(range_count);
+    auto record_range = [&](uint32_t range)
+    {
+      uint32_t begin = static_cast<uint32_t>(static_cast<uint64_t>(count) * range / range_count);
+      uint32_t end   = static_cast<uint32_t>(static_cast<uint64_t>(count) * (range + 1) / range_count);
+
+      sinks[range]->begin();
+      record(*sinks[range], begin, end, stats[range]);
+      sinks[range]->end();
+    };
+
+    JobCounter counter;
+    for (uint32_t range = 1; range < range_count; range++)
+    {
+      JobSystem::run([&record_range, range]() { record_range(range); }, &counter, "RenderQueue::flush");
+    }
+    record_range(0);
+    JobSystem::wait(counter);
+
+    for (auto& range_stats : stats)
+    {
+      m_stats.m_draw_calls += range_stats.m_draw_calls;
+      m_stats.m_shader_binds += range_stats.m_shader_binds;
+      m_stats.m_geometry_binds += range_stats.m_geometry_binds;
+      m_stats.m_uniform_binds += range_stats.m_uniform_binds;
+      m_stats.m_material_binds += range_stats.m_material_binds;
+      m_stats.m_push_updates += range_stats.m_push_updates;
+      m_stats.m_material_pushes += range_stats.m_material_pushes;
+      m_stats.m_skipped_binds += range_stats.m_skipped_binds;
+    }
+  }
+
+  void RenderQueue::flush(EspRenderPlan& plan, uint32_t thread_count)
+  {
+    ESP_ASSERT(plan.has_secondary_contents(), "Render plan has to be begun with secondary contents")
+
+    m_stats = {};
+    if (m_entries.empty()) { return; }
+
+    // small ranges cost more in scheduling and state rebinding than they save
+    uint32_t range_count = (size() + MIN_DRAWS_PER_THREAD - 1) / MIN_DRAWS_PER_THREAD;
+    range_count          = std::clamp(range_count, 1u, std::max(thread_count, 1u));
+
+    std::vector<EspCommandBufferSink> sinks(range_count, EspCommandBufferSink(plan));
+    std::vector<RenderQueueCommandSink*> sink_ptrs(range_count);
+    for (uint32_t i = 0; i < range_count; i++)
+    {
+      sink_ptrs[i] = &sinks[i];
+    }
+
+    flush(sink_ptrs);
+
+    std::vector<EspCommandBufferId*> ids(range_count);
+    for (uint32_t i = 0; i < range_count; i++)
+    {
+      ids[i] = sinks[i].get_id();
+    }
+    plan.execute_secondaries(ids);
+  }
+
+  uint64_t RenderQueue::make_sort_key(uint8_t pass, uint16_t pipeline, uint16_t material, float depth)
+  {
+    // bit pattern of a non-negative float grows monotonically with its value, so the most significant bits
+    // of it can be used directly as a depth key
+    uint32_t depth_bits = 0;
+    if (depth > 0.f) { std::memcpy(&depth_bits, &depth, sizeof(float)); }
+    depth_bits >>= (32 - DEPTH_BITS);
+
+    return (static_cast<uint64_t>(pass) << (PIPELINE_BITS + MATERIAL_BITS + DEPTH_BITS)) |
+        (static_cast<uint64_t>(pipeline) << (MATERIAL_BITS + DEPTH_BITS)) |
+        (static_cast<uint64_t>(material) << DEPTH_BITS) | static_cast<uint64_t>(depth_bits);
+  }
+
+  void RenderQueue::record(RenderQueueCommandSink& sink, uint32_t begin, uint32_t end, RenderQueueStats& stats) const
+  {
+    EspShader* current_shader                        = nullptr;
+    const void* current_layout                       = nullptr;
+    Model* current_model                             = nullptr;
+    const EspUniformManager* current_uniform_manager = nullptr;
+    uint32_t current_dynamic_offset                  = RenderQueueItem::NO_OFFSET;
+    const EspUniformManager* current_material        = nullptr;
+    void* current_push_data                          = nullptr;
+    uint32_t current_material_index                  = UINT32_MAX;
+
+    for (uint32_t i = begin; i < end; i++)
+    {
+      auto& item = m_items[m_entries[i].m_index];
+
+      if (item.m_shader != current_shader)
+      {
+        sink.bind_shader(*item.m_shader);
+        stats.m_shader_binds++;
+        current_shader = item.m_shader;
+
+        // sets and push constants bound with the same pipeline layout stay valid, others have to be bound again
+        if (!item.m_layout || item.m_layout != current_layout)
+        {
+          current_uniform_manager = nullptr;
+          current_dynamic_offset  = RenderQueueItem::NO_OFFSET;
+          current_material        = nullptr;
+          current_push_data       = nullptr;
+          current_material_index  = UINT32_MAX;
+        }
+        current_layout = item.m_layout;
+      }
+      else { stats.m_skipped_binds++; }
+
+      if (item.m_model != current_model)
+      {
+        sink.bind_geometry(*item.m_model);
+        stats.m_geometry_binds++;
+        current_model = item.m_model;
+      }
+      else { stats.m_skipped_binds++; }
+
+      // draws sharing the manager are bound again if their data lives at another dynamic offset
+      if (item.m_uniform_manager != current_uniform_manager || item.m_dynamic_offset != current_dynamic_offset)
+      {
+        if (item.m_dynamic_offset != RenderQueueItem::NO_OFFSET)
+        {
+          sink.bind_uniforms(*item.m_uniform_manager, item.m_dynamic_offset);
+        }
+        else { sink.bind_uniforms(*item.m_uniform_manager); }
+        stats.m_uniform_binds++;
+        current_uniform_manager = item.m_uniform_manager;
+        current_dynamic_offset  = item.m_dynamic_offset;
+      }
+      else { stats.m_skipped_binds++; }
+
+      if (item.m_push_data && item.m_push_data != current_push_data)
+      {
+        sink.push_uniform(*item.m_uniform_manager, item.m_push_data);
+        stats.m_push_updates++;
+        current_push_data = item.m_push_data;
+      }
+
+      if (item.m_material_manager && item.m_material_manager != current_material)
+      {
+        sink.bind_uniforms(*item.m_material_manager);
+        stats.m_material_binds++;
+        current_material = item.m_material_manager;
+      }
+      else if (item.m_material_manager) { stats.m_skipped_binds++; }
+
+      if (item.m_material_index != UINT32_MAX && item.m_material_index != current_material_index)
+      {
+        sink.push_material(*item.m_uniform_manager, item.m_material_index);
+        stats.m_material_pushes++;
+        current_material_index = item.m_material_index;
+      }
+
+      sink.draw_indexed(item.m_index_count, item.m_first_index);
+      stats.m_draw_calls++;
+    }
+  }
+
+  uint16_t RenderQueue::get_id(std::unordered_map<const void*, uint16_t>& ids, const void* ptr)
+  {
+    auto it = ids.find(ptr);
+    if (it != ids.end()) { return it->second; }
+
+    // 0 is reserved for draws without material
+    uint16_t id = static_cast<uint16_t>(std::min<size_t>(ids.size() + 1, UINT16_MAX));
+    ids.insert({ ptr, id });
+    return id;
+  }
+} // namespace esp
@@ -0,0 +1,178 @@
+#ifndef RENDERER_RENDER_QUEUE_HH
+#define RENDERER_RENDER_QUEUE_HH
+
+#include "esppch.hh"
+
+namespace esp
+{
+  class EspShader;
+  class EspRenderPlan;
+  class Model;
+  class Material;
+  struct EspUniformManager;
+
+  /// @brief Single indexed draw submitted to the RenderQueue together with all state it needs.
+  struct RenderQueueItem
+  {
+    static constexpr uint32_t NO_OFFSET = UINT32_MAX;
+
+    /// @brief Pass the draw belongs to. Lower passes are emitted first.
+    uint8_t m_pass = 0;
+    /// @brief Distance from the camera. Used to order draws inside the same pipeline and material (front to back).
+    float m_depth = 0.f;
+
+    /// @brief Shader (pipeline) used by the draw.
+    EspShader* m_shader = nullptr;
+    /// @brief Pipeline layout of the shader (EspShader::get_layout_id). Descriptor sets and push constants stay bound
+    /// when the next shader has the same layout. If it's nullptr they are bound again after every shader change.
+    const void* m_layout = nullptr;
+    /// @brief Model whose vertex and index buffers are used by the draw.
+    Model* m_model = nullptr;
+    /// @brief Uniform manager of the model (per entity descriptor sets).
+    const EspUniformManager* m_uniform_manager = nullptr;
+    /// @brief Offset of the only dynamic buffer uniform of the model's uniform manager, returned by
+    /// EspUniformManager::update_dynamic_buffer_uniform. Lets draws sharing the manager use data of their own.
+    /// NO_OFFSET if the manager has no dynamic buffer uniforms.
+    uint32_t m_dynamic_offset = NO_OFFSET;
+    /// @brief Material of the mesh. Only used to group draws, may be nullptr.
+    const Material* m_material = nullptr;
+    /// @brief Uniform manager of the material (material descriptor set), may be nullptr.
+    const EspUniformManager* m_material_manager = nullptr;
+    /// @brief Data pushed to push uniform 0 before the draw, may be nullptr.
+    void* m_push_data = nullptr;
+    /// @brief Index of the material in EspBindlessTextures pushed before the draw. Used by bindless shaders instead of
+    /// the material's uniform manager, UINT32_MAX otherwise.
+    uint32_t m_material_index = UINT32_MAX;
+
+    /// @brief Number of indices to draw.
+    uint32_t m_index_count = 0;
+    /// @brief Index of the first index to draw.
+    uint32_t m_first_index = 0;
+  };
+
+  /// @brief Counters describing commands emitted by the last RenderQueue flush.
+  struct RenderQueueStats
+  {
+    /// @brief Number of draw calls.
+    uint32_t m_draw_calls = 0;
+    /// @brief Number of shader (pipeline) binds.
+    uint32_t m_shader_binds = 0;
+    /// @brief Number of vertex and index buffer binds.
+    uint32_t m_geometry_binds = 0;
+    /// @brief Number of model uniform manager binds.
+    uint32_t m_uniform_binds = 0;
+    /// @brief Number of material uniform manager binds.
+    uint32_t m_material_binds = 0;
+    /// @brief Number of push uniform updates.
+    uint32_t m_push_updates = 0;
+    /// @brief Number of bindless material index pushes.
+    uint32_t m_material_pushes = 0;
+    /// @brief Number of binds that were skipped because the state was already bound.
+    uint32_t m_skipped_binds = 0;
+  };
+
+  /// @brief Receives commands emitted by the RenderQueue. The default one forwards them to EspShader, Model,
+  /// EspUniformManager and EspJob. Custom sinks can be used to record or inspect the command stream.
+  class RenderQueueCommandSink
+  {
+   public:
+    virtual ~RenderQueueCommandSink() {}
+
+    // called on the recording thread before the first and after the last command of a range
+    virtual void begin() {}
+    virtual void end() {}
+
+    virtual void bind_shader(EspShader& shader)                                           = 0;
+    virtual void bind_geometry(Model& model)                                              = 0;
+    virtual void bind_uniforms(const EspUniformManager& manager)                          = 0;
+    virtual void bind_uniforms(const EspUniformManager& manager, uint32_t dynamic_offset) = 0;
+    virtual void push_uniform(const EspUniformManager& manager, void* data)               = 0;
+    virtual void draw_indexed(uint32_t index_count, uint32_t first_index)                 = 0;
+
+    // pushes index of the bindless material, only used by queues with bindless shaders
+    virtual void push_material(const EspUniformManager& manager, uint32_t material_index) {}
+  };
+
+  /// @brief Collects draws of a frame, orders them by 64-bit sort keys (pass, pipeline, material, depth) and emits
+  /// them skipping redundant state changes.
+  class RenderQueue
+  {
+   public:
+    static constexpr uint32_t PASS_BITS     = 8;
+    static constexpr uint32_t PIPELINE_BITS = 16;
+    static constexpr uint32_t MATERIAL_BITS = 16;
+    static constexpr uint32_t DEPTH_BITS    = 24;
+
+    /// @brief Smallest number of draws recorded by a single thread in parallel flush.
+    static constexpr uint32_t MIN_DRAWS_PER_THREAD = 256;
+
+   private:
+    struct SortEntry
+    {
+      uint64_t m_key;
+      uint32_t m_index;
+    };
+
+    std::vector<RenderQueueItem> m_items;
+    std::vector<SortEntry> m_entries;
+    std::vector<SortEntry> m_scratch;
+
+    std::unordered_map<const void*, uint16_t> m_pipeline_ids;
+    std::unordered_map<const void*, uint16_t> m_material_ids;
+
+    RenderQueueStats m_stats;
+    bool m_sorted = false;
+
+   public:
+    /// @brief Default constructor.
+    RenderQueue() = default;
+    /// @brief Default destructor.
+    ~RenderQueue() = default;
+
+    PREVENT_COPY(RenderQueue);
+
+    /// @brief Clears draws of the previous frame. Allocated memory is kept.
+    void begin();
+    /// @brief Adds draw to the queue and computes its sort key.
+    /// @param item Draw to be added.
+    void submit(const RenderQueueItem& item);
+    /// @brief Orders submitted draws by their sort keys (stable LSD radix sort).
+    void sort();
+    /// @brief Emits sorted draws to the sink. Sorts the queue if it wasn't sorted yet.
+    /// @param sink Receiver of the commands.
+    void flush(RenderQueueCommandSink& sink);
+    /// @brief Emits sorted draws to the current command buffer.
+    void flush();
+    /// @brief Splits sorted draws into contiguous ranges, one per sink, and emits every range as a separate job of the
+    /// JobSystem. Sinks don't share any bound state, so each range starts with binding its whole state.
+    /// @param sinks Receivers of the commands. The first one is used on the calling thread.
+    void flush(const std::vector<RenderQueueCommandSink*>& sinks);
+    /// @brief Records sorted draws into secondary command buffers on several threads and executes them in the render
+    /// plan in order. Plan has to be begun with secondary contents enabled.
+    /// @param plan Render plan the draws are executed in.
+    /// @param thread_count Maximum number of recording jobs.
+    void flush(EspRenderPlan& plan, uint32_t thread_count);
+
+    /// @brief Returns statistics of the last flush.
+    /// @return Statistics of the last flush.
+    inline const RenderQueueStats& get_stats() const { return m_stats; }
+    /// @brief Returns number of draws submitted since last begin.
+    /// @return Number of submitted draws.
+    inline uint32_t size() const { return static_cast<uint32_t>(m_items.size()); }
+
+    /// @brief Builds sort key. Pass occupies the most significant bits, then pipeline, material and depth.
+    /// @param pass Pass index.
+    /// @param pipeline Pipeline id.
+    /// @param material Material id.
+    /// @param depth Non-negative depth. Negative values are clamped to 0.
+    /// @return 64-bit sort key.
+    static uint64_t make_sort_key(uint8_t pass, uint16_t pipeline, uint16_t material, float depth);
+
+   private:
+    void record(RenderQueueCommandSink& sink, uint32_t begin, uint32_t end, RenderQueueStats& stats) const;
+
+    static uint16_t get_id(std::unordered_map<const void*, uint16_t>& ids, const void* ptr);
+  };
+} // namespace esp
+
+#endif // RENDERER_RENDER_QUEUE_HH
@@ -0,0 +1,32 @@
+#ifndef SCENE_COMPONENTS_BOUNDS_COMPONENT_HH
+#define SCENE_COMPONENTS_BOUNDS_COMPONENT_HH
+
+#include "esppch.hh"
+
+#include "Core/Renderer/Culling/BoundingVolumeHierarchy.hh"
+
+namespace esp
+{
+  /// @brief ECS component with world space bounds of an entity with ModelComponent. Maintained by Scene.
+  struct BoundsComponent
+  {
+   private:
+    AABB m_aabb;
+    BoundingSphere m_sphere;
+    glm::mat4 m_model_mat{ 0.f };
+    int32_t m_proxy{ BoundingVolumeHierarchy::NULL_NODE };
+    uint64_t m_frame{ 0 };
+
+   public:
+    /// @brief Returns world space bounding box.
+    /// @return World space bounding box.
+    inline const AABB& get_aabb() const { return m_aabb; }
+    /// @brief Returns world space bounding sphere.
+    /// @return World space bounding sphere.
+    inline const BoundingSphere& get_sphere() const { return m_sphere; }
+
+    friend class Scene;
+  };
+} // namespace esp
+
+#endif // SCENE_COMPONENTS_BOUNDS_COMPONENT_HH
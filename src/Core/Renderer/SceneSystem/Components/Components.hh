@@ -1,6 +1,7 @@
 #ifndef SCENE_COMPONENTS_HH
 #define SCENE_COMPONENTS_HH
 
+#include "BoundsComponent.hh"
 #include "ModelComponent.hh"
 #include "TagComponent.hh"
 #include "TransformComponent.hh"
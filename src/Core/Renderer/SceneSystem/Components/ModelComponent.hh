@@ -22,7 +22,8 @@ namespace esp
     /// @param shader Shared pointer to model's shader
     /// @param start_managed_ds_for_uniform_manager First descriptor set of model's uniform manager. 0 by default.
     /// @param end_managed_ds_for_uniform_manager Last descriptor set of model's uniform manager. 0 by default.
-    /// @param managed_ds_for_material_manager Descriptor set of model's material managers. 1 by default.
+    /// @param managed_ds_for_material_manager Descriptor set of model's material managers. 1 by default. Not used by
+    /// bindless shaders.
     ModelComponent(std::shared_ptr<Model>& model,
                    std::shared_ptr<EspShader>& shader,
                    int start_managed_ds_for_uniform_manager = 0,
@@ -35,6 +36,9 @@ namespace esp
           m_shader->create_uniform_manager(start_managed_ds_for_uniform_manager, end_managed_ds_for_uniform_manager);
       m_uniform_manager->build();
 
+      // bindless shaders get materials by index, so they don't need material managers
+      if (m_shader->is_bindless()) { return; }
+
       for (auto& mesh : m_model->m_meshes)
       {
         if (mesh.m_material && !m_material_managers.contains(mesh.m_material))
@@ -2,10 +2,8 @@
 #include "Components/Components.hh"
 #include "Entity.hh"
 
-#include "Core/RenderAPI/Work/EspJob.hh"
-
 // signatures
-static void draw_model(const esp::ModelComponent& model_component);
+static void submit_model(esp::RenderQueue& queue, const esp::ModelComponent& model_component, float depth);
 
 /* --------------------------------------------------------- */
 /* ---------------- CLASS IMPLEMENTATION ------------------- */
@@ -29,47 +27,184 @@ namespace esp
     return std::make_shared<Entity>(entity);
   }
 
-  void Scene::destroy_entity(Entity& entity) { m_registry.destroy(entity.m_handle); }
+  void Scene::destroy_entity(Entity& entity)
+  {
+    if (auto bounds = m_registry.try_get<BoundsComponent>(entity.m_handle))
+    {
+      if (bounds->m_proxy != BoundingVolumeHierarchy::NULL_NODE) { m_bvh.remove(bounds->m_proxy); }
+    }
+    m_registry.destroy(entity.m_handle);
+  }
 
   void Scene::draw()
+  {
+    ESP_PROFILE_SCOPE("Scene::draw");
+    prepare_render_queue();
+    m_render_queue.flush();
+  }
+
+  void Scene::draw(EspRenderPlan& plan, uint32_t thread_count)
+  {
+    ESP_PROFILE_SCOPE("Scene::draw");
+    prepare_render_queue();
+    m_render_queue.flush(plan, thread_count);
+  }
+
+  void Scene::prepare_render_queue()
   {
     // TODO: optimize by
-    //  - sorting shaders
     //  - grouping instances of the same model (add instancing)
-    auto view = get_view<ModelComponent>();
-    for (auto entity : view)
+    update_bounds();
+
+    m_render_queue.begin();
+
+    auto submit = [&](entt::entity entity)
+    {
+      auto& model_component = m_registry.get<ModelComponent>(entity);
+      auto& bounds          = m_registry.get<BoundsComponent>(entity);
+
+      float depth = 0.f;
+      if (s_current_camera)
+      {
+        depth = glm::distance(bounds.get_aabb().get_center(), s_current_camera->get_position());
+      }
+
+      submit_model(m_render_queue, model_component, depth);
+    };
+
+    if (s_current_camera && m_culling_enabled)
+    {
+      Frustum frustum(s_current_camera->get_projection() * s_current_camera->get_view());
+
+      m_visible_entities.clear();
+      m_culling_stats = m_bvh.query(frustum, m_visible_entities);
+      for (auto id : m_visible_entities)
+      {
+        submit(static_cast<entt::entity>(id));
+      }
+    }
+    else
+    {
+      auto view       = get_view<ModelComponent>();
+      m_culling_stats = { .m_objects = m_bvh.size(), .m_visible = m_bvh.size() };
+      for (auto entity : view)
+      {
+        submit(entity);
+      }
+    }
+
+    m_render_queue.sort();
+  }
+
+  void Scene::update_bounds()
+  {
+    m_frame++;
+
+    // entities attached to the scene graph are placed with their absolute transformation
+    m_root_node->act(action::Action<void(Node*)>(
+        [this](Node* node)
+        {
+          auto entity = node->get_entity();
+          if (entity && m_registry.all_of<ModelComponent>(entity->m_handle))
+          {
+            update_entity_bounds(entity->m_handle, node->get_model_mat());
+          }
+        }));
+
+    for (auto entity : m_registry.view<ModelComponent>())
     {
-      auto& model_component = view.get<ModelComponent>(entity);
-      draw_model(model_component);
+      auto bounds = m_registry.try_get<BoundsComponent>(entity);
+      if (bounds && bounds->m_frame == m_frame) { continue; }
+
+      auto transform = m_registry.try_get<TransformComponent>(entity);
+      update_entity_bounds(entity, transform ? transform->get_model_mat() : glm::mat4(1.f));
+    }
+
+    // entities that lost their ModelComponent
+    for (auto entity : m_registry.view<BoundsComponent>())
+    {
+      auto& bounds = m_registry.get<BoundsComponent>(entity);
+      if (bounds.m_frame == m_frame) { continue; }
+
+      m_bvh.remove(bounds.m_proxy);
+      m_registry.remove<BoundsComponent>(entity);
     }
   }
+
+  void Scene::update_entity_bounds(entt::entity entity, const glm::mat4& model_mat)
+  {
+    auto& bounds   = m_registry.get_or_emplace<BoundsComponent>(entity);
+    bounds.m_frame = m_frame;
+
+    // most of entities don't move, so the hierarchy is refitted only for the changed ones
+    if (bounds.m_proxy != BoundingVolumeHierarchy::NULL_NODE && bounds.m_model_mat == model_mat) { return; }
+
+    auto& model        = m_registry.get<ModelComponent>(entity).get_model();
+    bounds.m_model_mat = model_mat;
+    if (model.get_aabb().is_valid())
+    {
+      bounds.m_aabb   = model.get_aabb().transform(model_mat);
+      bounds.m_sphere = model.get_sphere().transform(model_mat);
+    }
+    else
+    {
+      glm::vec3 position = glm::vec3(model_mat[3]);
+      bounds.m_aabb      = { position, position };
+      bounds.m_sphere    = { position, 0.f };
+    }
+
+    if (bounds.m_proxy == BoundingVolumeHierarchy::NULL_NODE)
+    {
+      bounds.m_proxy = m_bvh.insert(bounds.m_aabb, entt::to_integral(entity));
+    }
+    else { m_bvh.update(bounds.m_proxy, bounds.m_aabb); }
+  }
 } // namespace esp
 
 /* --------------------------------------------------------- */
 /* ------------------ HELPFUL FUNCTIONS -------------------- */
 /* --------------------------------------------------------- */
-static void draw_model(const esp::ModelComponent& model_component)
+static void submit_model(esp::RenderQueue& queue, const esp::ModelComponent& model_component, float depth)
 {
-  model_component.get_shader().attach();
-
-  const auto& uniform_manager = model_component.get_uniform_manager();
-  uniform_manager.attach();
-
-  auto& model = model_component.get_model();
-  for (auto model_node : model)
+  auto& model             = model_component.get_model();
+  auto& shader            = model_component.get_shader();
+  auto& material_managers = model_component.get_material_managers();
+
+  esp::RenderQueueItem item = {};
+  item.m_depth              = depth;
+  item.m_shader             = &shader;
+  item.m_layout             = shader.get_layout_id();
+  item.m_model              = &model;
+  item.m_uniform_manager    = &model_component.get_uniform_manager();
+
+  // the ModelIterator binds the model buffers, so nodes are walked directly here and binding is left to the queue
+  auto submit_node = [&](esp::ModelNode* node)
   {
-    if (model.has_many_mesh_nodes())
-    {
-      uniform_manager.update_push_uniform(0, &(model_node.m_current_node->m_precomputed_transformation));
-    }
+    item.m_push_data = model.has_many_mesh_nodes() ? &(node->m_precomputed_transformation) : nullptr;
 
-    auto& material_managers = model_component.get_material_managers();
-    for (auto& mesh_idx : model_node.m_current_node->m_meshes)
+    for (auto& mesh_idx : node->m_meshes)
     {
       auto& mesh = model.m_meshes[mesh_idx];
 
-      if (mesh.m_material) { material_managers.at(mesh.m_material)->attach(); }
-      esp::EspJob::draw_indexed(mesh.m_index_count, 1, mesh.m_first_index);
+      item.m_material    = mesh.m_material.get();
+      item.m_index_count = mesh.m_index_count;
+      item.m_first_index = mesh.m_first_index;
+
+      // bindless set is bound once per pipeline and materials are selected by pushed index
+      if (shader.is_bindless())
+      {
+        item.m_material_manager = shader.get_bindless_uniform_manager();
+        item.m_material_index   = mesh.m_material ? mesh.m_material->get_bindless_index() : UINT32_MAX;
+      }
+      else { item.m_material_manager = mesh.m_material ? material_managers.at(mesh.m_material).get() : nullptr; }
+
+      queue.submit(item);
     }
+  };
+
+  submit_node(&model.m_root_node);
+  for (auto node : model.m_nodes)
+  {
+    if (node->m_has_meshes) { submit_node(node); }
   }
-}
\ No newline at end of file
+}
@@ -1,7 +1,10 @@
 #ifndef SCENE_SCENE_HH
 #define SCENE_SCENE_HH
 
+#include "Core/Jobs/JobSystem.hh"
 #include "Core/Renderer/Camera.hh"
+#include "Core/Renderer/Culling/BoundingVolumeHierarchy.hh"
+#include "Core/Renderer/RenderQueue.hh"
 #include "Node.hh"
 
 #include "esppch.hh"
@@ -20,6 +23,14 @@ namespace esp
     static Camera* s_current_camera;
     std::vector<std::shared_ptr<Camera>> m_cameras;
 
+    RenderQueue m_render_queue;
+
+    BoundingVolumeHierarchy m_bvh;
+    std::vector<uint32_t> m_visible_entities;
+    CullingStats m_culling_stats;
+    uint64_t m_frame{ 0 };
+    bool m_culling_enabled{ true };
+
    public:
     /// @brief Creates instance of a Scene.
     /// @return Shared pointer to instance of a Scene.
@@ -64,12 +75,33 @@ namespace esp
     /// @return Pointer to the current Camera.
     inline static Camera* get_current_camera() { return s_current_camera; }
 
-    /// @brief Draws each Node on scene graph that has ModelComponent
+    /// @brief Draws each Node on scene graph that has ModelComponent. Entities outside of the current Camera's
+    /// frustum are culled. Draws are sorted by shader, material and distance from the Camera to avoid redundant binds.
     void draw(); // TODO: move draw logic to Renderer class
+    /// @brief Draws the same way as draw(), but records the draws into secondary command buffers in parallel jobs.
+    /// Render plan has to be begun with secondary contents enabled.
+    /// @param plan Render plan the draws are executed in.
+    /// @param thread_count Maximum number of recording jobs.
+    void draw(EspRenderPlan& plan, uint32_t thread_count = JobSystem::get_thread_count());
+
+    /// @brief Turns frustum culling on or off.
+    /// @param enable True to cull entities outside of the current Camera's frustum.
+    inline void enable_culling(bool enable) { m_culling_enabled = enable; }
+    /// @brief Returns statistics of the last frustum culling.
+    /// @return Statistics of the last frustum culling.
+    inline const CullingStats& get_culling_stats() const { return m_culling_stats; }
+
+    /// @brief Returns statistics of the last draw.
+    /// @return Statistics of the last draw.
+    inline const RenderQueueStats& get_render_stats() const { return m_render_queue.get_stats(); }
 
    private:
     Scene() : m_root_node{ Node::create_root(this) } {}
 
+    void prepare_render_queue();
+    void update_bounds();
+    void update_entity_bounds(entt::entity entity, const glm::mat4& model_mat);
+
     friend class Entity;
   };
 } // namespace esp
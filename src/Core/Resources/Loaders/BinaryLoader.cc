@@ -6,6 +6,8 @@ namespace esp
 {
   std::unique_ptr<Resource> BinaryLoader::load(const fs::path& path, const ResourceParams& params)
   {
+    ESP_PROFILE_SCOPE("BinaryLoader::load");
+
     fs::path full_path = ResourceSystem::get_asset_base_path() / path;
     if (!fs::is_regular_file(fs::status(full_path)))
     {
@@ -7,6 +7,8 @@ namespace esp
 {
   std::unique_ptr<Resource> CubemapLoader::load(const fs::path& path, const ResourceParams& params)
   {
+    ESP_PROFILE_SCOPE("CubemapLoader::load");
+
     fs::path base_path = ResourceSystem::get_asset_base_path() / path;
 
     FaceResourceMap face_resource_map = {};
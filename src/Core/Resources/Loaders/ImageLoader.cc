@@ -13,6 +13,8 @@ namespace esp
 {
   std::unique_ptr<Resource> ImageLoader::load(const fs::path& path, const ResourceParams& params)
   {
+    ESP_PROFILE_SCOPE("ImageLoader::load");
+
     fs::path full_path = ResourceSystem::get_asset_base_path() / path;
     if (!fs::is_regular_file(fs::status(full_path)))
     {
@@ -14,10 +14,13 @@ namespace esp
 
   std::unique_ptr<Resource> SpirvLoader::load(const fs::path& path, const ResourceParams& params)
   {
+    ESP_PROFILE_SCOPE("SpirvLoader::load");
+
     fs::path spirv_base_path    = ResourceSystem::get_asset_base_path() / path;
     fs::path spirv_path         = spirv_base_path;
     auto spirv_params           = static_cast<const SpirvResourceParams&>(params);
     SpirvDataMap spirv_data_map = {};
+    SpirvReflection reflection  = {};
 
     for (auto type = EspShaderStage::VERTEX; type < EspShaderStage::ENUM_END; ++type)
     {
@@ -29,10 +32,18 @@ namespace esp
         ESP_CORE_ERROR("Could not load {} shader stage {}.", path.string(), esp_shader_stage_to_string(type));
         return nullptr;
       }
-      if (!data.empty()) { spirv_data_map.insert({ type, std::move(data) }); }
+      if (data.empty()) { continue; }
+
+      if (!reflection.add_stage(type, data))
+      {
+        ESP_CORE_ERROR("Could not reflect {} shader stage {}.", path.string(), esp_shader_stage_to_string(type));
+        return nullptr;
+      }
+      spirv_data_map.insert({ type, std::move(data) });
     }
 
-    return std::unique_ptr<Resource>(new SpirvResource(spirv_base_path, std::move(spirv_data_map)));
+    return std::unique_ptr<Resource>(
+        new SpirvResource(spirv_base_path, std::move(spirv_data_map), std::move(reflection)));
   }
 
   void SpirvLoader::unload(std::unique_ptr<Resource> resource) { resource.reset(nullptr); }
@@ -0,0 +1,239 @@
+#include "MipGenerator.hh"
+#include "Core/Jobs/JobSystem.hh"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define ESP_MIP_GENERATOR_SSE2 1
+#include <emmintrin.h>
+#else
+#define ESP_MIP_GENERATOR_SSE2 0
+#endif
+
+// number of destination rows filtered by a single job
+static constexpr uint32_t ROWS_PER_JOB = 32;
+
+// Lookup tables of sRGB transfer function. Encoding searches the linear values halfway between neighbouring 8-bit
+// codes, so it rounds exactly like round(linear_to_srgb(x) * 255).
+struct SrgbTables
+{
+  float m_to_linear[256];
+  float m_thresholds[255];
+};
+
+// signatures
+static float srgb_to_linear(float value);
+static const SrgbTables& get_srgb_tables();
+static uint8_t encode_srgb(const SrgbTables& tables, float linear);
+static void downsample_row_unorm(const uint8_t* row0, const uint8_t* row1, uint32_t src_width, uint8_t* dst);
+static void downsample_row_srgb(const uint8_t* row0, const uint8_t* row1, uint32_t src_width, uint8_t* dst);
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  uint32_t MipGenerator::get_mip_levels(uint32_t width, uint32_t height)
+  {
+    return static_cast<uint32_t>(std::floor(std::log2(std::max(std::max(width, height), 1u)))) + 1;
+  }
+
+  MipChain MipGenerator::generate(const uint8_t* pixels,
+                                  uint32_t width,
+                                  uint32_t height,
+                                  bool srgb,
+                                  uint32_t mip_levels)
+  {
+    ESP_PROFILE_FUNCTION();
+
+    auto max_levels = get_mip_levels(width, height);
+    mip_levels      = mip_levels == 0 ? max_levels : std::min(mip_levels, max_levels);
+
+    MipChain chain;
+    chain.m_srgb = srgb;
+
+    size_t size = 0;
+    for (uint32_t level = 0; level < mip_levels; level++)
+    {
+      chain.m_levels.push_back({ size, width, height });
+      size += static_cast<size_t>(width) * height * 4;
+
+      width  = std::max(width / 2, 1u);
+      height = std::max(height / 2, 1u);
+    }
+
+    chain.m_data.resize(size);
+    auto& base = chain.m_levels[0];
+    std::memcpy(chain.m_data.data(), pixels, static_cast<size_t>(base.m_width) * base.m_height * 4);
+
+    for (uint32_t level = 1; level < mip_levels; level++)
+    {
+      auto& src = chain.m_levels[level - 1];
+      downsample(chain.m_data.data() + src.m_offset,
+                 src.m_width,
+                 src.m_height,
+                 chain.m_data.data() + chain.m_levels[level].m_offset,
+                 srgb);
+    }
+
+    return chain;
+  }
+
+  std::vector<MipChain> MipGenerator::generate_batch(const std::vector<MipSource>& sources)
+  {
+    std::vector<MipChain> chains(sources.size());
+
+    JobSystem::parallel_for(
+        static_cast<uint32_t>(sources.size()),
+        1,
+        [&](uint32_t begin, uint32_t end)
+        {
+          for (uint32_t i = begin; i < end; i++)
+          {
+            auto& source = sources[i];
+            chains[i] =
+                generate(source.m_pixels, source.m_width, source.m_height, source.m_srgb, source.m_mip_levels);
+          }
+        },
+        "MipGenerator::generate_batch");
+
+    return chains;
+  }
+
+  void MipGenerator::downsample(const uint8_t* src, uint32_t src_width, uint32_t src_height, uint8_t* dst, bool srgb)
+  {
+    uint32_t dst_width  = std::max(src_width / 2, 1u);
+    uint32_t dst_height = std::max(src_height / 2, 1u);
+
+    JobSystem::parallel_for(
+        dst_height,
+        ROWS_PER_JOB,
+        [=](uint32_t begin, uint32_t end)
+        {
+          for (uint32_t y = begin; y < end; y++)
+          {
+            // a level one pixel high is only filtered horizontally
+            auto row0    = src + static_cast<size_t>(std::min(2 * y, src_height - 1)) * src_width * 4;
+            auto row1    = src + static_cast<size_t>(std::min(2 * y + 1, src_height - 1)) * src_width * 4;
+            auto dst_row = dst + static_cast<size_t>(y) * dst_width * 4;
+
+            if (srgb) { downsample_row_srgb(row0, row1, src_width, dst_row); }
+            else { downsample_row_unorm(row0, row1, src_width, dst_row); }
+          }
+        },
+        "MipGenerator::downsample");
+  }
+} // namespace esp
+
+/* --------------------------------------------------------- */
+/* ------------------ HELPFUL FUNCTIONS -------------------- */
+/* --------------------------------------------------------- */
+
+static float srgb_to_linear(float value)
+{
+  return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+static const SrgbTables& get_srgb_tables()
+{
+  static const SrgbTables tables = []()
+  {
+    SrgbTables tables;
+    for (uint32_t i = 0; i < 256; i++)
+    {
+      tables.m_to_linear[i] = srgb_to_linear(i / 255.f);
+    }
+    for (uint32_t i = 0; i < 255; i++)
+    {
+      tables.m_thresholds[i] = srgb_to_linear((i + 0.5f) / 255.f);
+    }
+    return tables;
+  }();
+
+  return tables;
+}
+
+static uint8_t encode_srgb(const SrgbTables& tables, float linear)
+{
+  return static_cast<uint8_t>(std::upper_bound(tables.m_thresholds, tables.m_thresholds + 255, linear) -
+                              tables.m_thresholds);
+}
+
+static void downsample_row_unorm(const uint8_t* row0, const uint8_t* row1, uint32_t src_width, uint8_t* dst)
+{
+  uint32_t dst_width = std::max(src_width / 2, 1u);
+  uint32_t x         = 0;
+
+#if ESP_MIP_GENERATOR_SSE2
+  // two destination pixels (four source pixels of both rows) per iteration, channels are summed as 16-bit integers
+  if (src_width >= 2)
+  {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i two  = _mm_set1_epi16(2);
+    for (; x + 2 <= dst_width; x += 2)
+    {
+      __m128i top    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8));
+      __m128i bottom = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8));
+
+      __m128i left  = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+      __m128i right = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+
+      // neighbouring source pixels are in the low and high halves of left and right
+      __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(left, right), _mm_unpackhi_epi64(left, right));
+      sum         = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + x * 4), _mm_packus_epi16(sum, sum));
+    }
+  }
+#endif
+
+  for (; x < dst_width; x++)
+  {
+    uint32_t x0 = std::min(2 * x, src_width - 1) * 4;
+    uint32_t x1 = std::min(2 * x + 1, src_width - 1) * 4;
+    for (uint32_t c = 0; c < 4; c++)
+    {
+      dst[x * 4 + c] = static_cast<uint8_t>((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) >> 2);
+    }
+  }
+}
+
+static void downsample_row_srgb(const uint8_t* row0, const uint8_t* row1, uint32_t src_width, uint8_t* dst)
+{
+  auto& tables       = get_srgb_tables();
+  uint32_t dst_width = std::max(src_width / 2, 1u);
+
+  for (uint32_t x = 0; x < dst_width; x++)
+  {
+    const uint8_t* pixels[4] = { row0 + std::min(2 * x, src_width - 1) * 4,
+                                 row0 + std::min(2 * x + 1, src_width - 1) * 4,
+                                 row1 + std::min(2 * x, src_width - 1) * 4,
+                                 row1 + std::min(2 * x + 1, src_width - 1) * 4 };
+
+    float linear[4];
+#if ESP_MIP_GENERATOR_SSE2
+    __m128 sum = _mm_setzero_ps();
+    for (auto pixel : pixels)
+    {
+      sum = _mm_add_ps(sum,
+                       _mm_setr_ps(tables.m_to_linear[pixel[0]],
+                                   tables.m_to_linear[pixel[1]],
+                                   tables.m_to_linear[pixel[2]],
+                                   0.f));
+    }
+    _mm_storeu_ps(linear, _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+#else
+    for (uint32_t c = 0; c < 3; c++)
+    {
+      linear[c] = 0.25f *
+          (tables.m_to_linear[pixels[0][c]] + tables.m_to_linear[pixels[1][c]] + tables.m_to_linear[pixels[2][c]] +
+           tables.m_to_linear[pixels[3][c]]);
+    }
+#endif
+
+    for (uint32_t c = 0; c < 3; c++)
+    {
+      dst[x * 4 + c] = encode_srgb(tables, linear[c]);
+    }
+    // alpha is linear
+    dst[x * 4 + 3] = static_cast<uint8_t>((pixels[0][3] + pixels[1][3] + pixels[2][3] + pixels[3][3] + 2) >> 2);
+  }
+}
@@ -0,0 +1,91 @@
+#ifndef ESPERT_CORE_RESOURCES_MIP_GENERATOR_HH
+#define ESPERT_CORE_RESOURCES_MIP_GENERATOR_HH
+
+#include "esppch.hh"
+
+namespace esp
+{
+  /// @brief Single level of MipChain.
+  struct MipLevel
+  {
+    /// @brief Offset of the first pixel of the level in MipChain::m_data in bytes.
+    size_t m_offset;
+    /// @brief Width of the level in pixels.
+    uint32_t m_width;
+    /// @brief Height of the level in pixels.
+    uint32_t m_height;
+  };
+
+  /// @brief RGBA8 image with all of its mip levels stored one after another, the base level first.
+  struct MipChain
+  {
+    /// @brief Pixels of every level.
+    std::vector<uint8_t> m_data;
+    /// @brief Levels of the chain.
+    std::vector<MipLevel> m_levels;
+    /// @brief True if color channels are sRGB encoded.
+    bool m_srgb = false;
+
+    /// @brief Returns pixels of a level.
+    /// @param level Index of the level.
+    /// @return Pointer to the first pixel of the level.
+    inline const uint8_t* get_level_data(uint32_t level) const { return m_data.data() + m_levels[level].m_offset; }
+  };
+
+  /// @brief Source image of MipGenerator::generate_batch().
+  struct MipSource
+  {
+    /// @brief RGBA8 pixels of the base level.
+    const uint8_t* m_pixels;
+    /// @brief Width of the base level in pixels.
+    uint32_t m_width;
+    /// @brief Height of the base level in pixels.
+    uint32_t m_height;
+    /// @brief True if color channels are sRGB encoded.
+    bool m_srgb = false;
+    /// @brief Number of levels to generate, 0 for the full chain.
+    uint32_t m_mip_levels = 0;
+  };
+
+  /// @brief Generates mip chains of RGBA8 images on the CPU, e.g. to bake them offline. Every level is a 2x2 box filter
+  /// of the previous one and its size is rounded down like the size of Vulkan mip levels, so the last row or column of
+  /// an odd sized level is skipped. Color channels of sRGB images are averaged in linear space and alpha is always
+  /// linear. Rows of a level are filtered in parallel by the JobSystem (if it exists) and SSE2 is used where it is
+  /// available.
+  class MipGenerator
+  {
+   public:
+    /// @brief Returns number of levels of the full mip chain.
+    /// @param width Width of the base level.
+    /// @param height Height of the base level.
+    /// @return Number of levels down to 1x1.
+    static uint32_t get_mip_levels(uint32_t width, uint32_t height);
+
+    /// @brief Generates mip chain of an image.
+    /// @param pixels RGBA8 pixels of the base level.
+    /// @param width Width of the base level.
+    /// @param height Height of the base level.
+    /// @param srgb True if color channels are sRGB encoded.
+    /// @param mip_levels Number of levels to generate (including the base one), 0 for the full chain.
+    /// @return Mip chain of the image.
+    static MipChain generate(const uint8_t* pixels,
+                             uint32_t width,
+                             uint32_t height,
+                             bool srgb           = false,
+                             uint32_t mip_levels = 0);
+    /// @brief Generates mip chains of many images in parallel.
+    /// @param sources Images to generate mip chains of.
+    /// @return Mip chains ordered as sources.
+    static std::vector<MipChain> generate_batch(const std::vector<MipSource>& sources);
+
+    /// @brief Filters level into the next one.
+    /// @param src RGBA8 pixels of the level.
+    /// @param src_width Width of the level.
+    /// @param src_height Height of the level.
+    /// @param dst RGBA8 pixels of the next level, max(1, src_width / 2) x max(1, src_height / 2) of them.
+    /// @param srgb True if color channels are sRGB encoded.
+    static void downsample(const uint8_t* src, uint32_t src_width, uint32_t src_height, uint8_t* dst, bool srgb);
+  };
+} // namespace esp
+
+#endif // ESPERT_CORE_RESOURCES_MIP_GENERATOR_HH
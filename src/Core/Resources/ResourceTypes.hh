@@ -6,6 +6,7 @@
 #include "Core/RenderAPI/Resources/EspCubemapFace.hh"
 #include "Core/RenderAPI/Resources/EspShaderStage.hh"
 #include "Core/Resources/ResourceUtils.hh"
+#include "Core/Resources/SpirvReflection.hh"
 
 namespace esp
 {
@@ -193,7 +194,9 @@ namespace esp
     /// @brief Constructor that sets resource path and data.
     /// @param path Relative path of resource.
     /// @param spirv_data_map Map of pairs of EspShaderStage and SpirvData.
-    SpirvResource(const fs::path& path, SpirvDataMap spirv_data_map) : Resource(path)
+    /// @param reflection Interface of all shader stages.
+    SpirvResource(const fs::path& path, SpirvDataMap spirv_data_map, SpirvReflection reflection) :
+        Resource(path), m_reflection(std::move(reflection))
     {
       m_spirv_data_map = std::move(spirv_data_map);
     }
@@ -214,7 +217,7 @@ namespace esp
     /// @param func Function handle that returns void and accepts EspShaderStage and reference to SPIR-V data.
     inline void enumerate_data(std::function<void(EspShaderStage stage, const SpirvData& spirv_data)> func)
     {
-      for (auto it : m_spirv_data_map)
+      for (const auto& it : m_spirv_data_map)
       {
         func(it.first, it.second);
       }
@@ -225,8 +228,13 @@ namespace esp
     /// @return True if data is avaliable for EsoShaderStage. False otherwise.
     inline bool is_stage_avaliable(EspShaderStage stage) { return m_spirv_data_map.contains(stage); }
 
+    /// @brief Returns interface of shader stages reflected from SPIR-V data.
+    /// @return Reference to SpirvReflection.
+    inline const SpirvReflection& get_reflection() const { return m_reflection; }
+
    private:
     SpirvDataMap m_spirv_data_map;
+    SpirvReflection m_reflection;
   };
 
   /// @brief Parameters that might affect loading process of SpirvResource.
@@ -0,0 +1,573 @@
+#include "SpirvReflection.hh"
+
+#include "Core/RenderAPI/Worker/EspWorkerBuilder.hh"
+
+// SPIR-V specification constants
+namespace spv
+{
+  static constexpr uint32_t MAGIC_NUMBER = 0x07230203;
+  static constexpr uint32_t HEADER_SIZE  = 5;
+
+  enum Op : uint32_t
+  {
+    OP_TYPE_BOOL          = 20,
+    OP_TYPE_INT           = 21,
+    OP_TYPE_FLOAT         = 22,
+    OP_TYPE_VECTOR        = 23,
+    OP_TYPE_MATRIX        = 24,
+    OP_TYPE_IMAGE         = 25,
+    OP_TYPE_SAMPLER       = 26,
+    OP_TYPE_SAMPLED_IMAGE = 27,
+    OP_TYPE_ARRAY         = 28,
+    OP_TYPE_RUNTIME_ARRAY = 29,
+    OP_TYPE_STRUCT        = 30,
+    OP_TYPE_POINTER       = 32,
+    OP_CONSTANT           = 43,
+    OP_SPEC_CONSTANT      = 50,
+    OP_VARIABLE           = 59,
+    OP_DECORATE           = 71,
+    OP_MEMBER_DECORATE    = 72,
+  };
+
+  enum Decoration : uint32_t
+  {
+    DECORATION_BLOCK          = 2,
+    DECORATION_BUFFER_BLOCK   = 3,
+    DECORATION_ARRAY_STRIDE   = 6,
+    DECORATION_MATRIX_STRIDE  = 7,
+    DECORATION_BUILT_IN       = 11,
+    DECORATION_NON_WRITABLE   = 24,
+    DECORATION_LOCATION       = 30,
+    DECORATION_BINDING        = 33,
+    DECORATION_DESCRIPTOR_SET = 34,
+    DECORATION_OFFSET         = 35,
+  };
+
+  enum StorageClass : uint32_t
+  {
+    STORAGE_CLASS_UNIFORM_CONSTANT = 0,
+    STORAGE_CLASS_INPUT            = 1,
+    STORAGE_CLASS_UNIFORM          = 2,
+    STORAGE_CLASS_PUSH_CONSTANT    = 9,
+    STORAGE_CLASS_STORAGE_BUFFER   = 12,
+  };
+} // namespace spv
+
+namespace
+{
+  struct SpirvMember
+  {
+    uint32_t m_offset        = 0;
+    uint32_t m_matrix_stride = 0;
+    bool m_built_in          = false;
+    bool m_non_writable      = false;
+  };
+
+  struct SpirvId
+  {
+    uint32_t m_opcode = 0;
+    std::vector<uint32_t> m_operands;
+
+    uint32_t m_set           = 0;
+    uint32_t m_binding       = 0;
+    uint32_t m_location      = 0;
+    uint32_t m_array_stride  = 0;
+    bool m_has_binding       = false;
+    bool m_has_location      = false;
+    bool m_built_in          = false;
+    bool m_block             = false;
+    bool m_buffer_block      = false;
+    bool m_non_writable      = false;
+    std::vector<SpirvMember> m_members;
+  };
+
+  using SpirvIds = std::vector<SpirvId>;
+} // namespace
+
+// signatures
+static bool parse_spirv(const std::vector<uint32_t>& code, SpirvIds& ids, std::vector<uint32_t>& variables);
+static uint32_t get_type_size(const SpirvIds& ids, uint32_t type_id, uint32_t matrix_stride = 0);
+static uint32_t get_array_length(const SpirvIds& ids, uint32_t type_id);
+static esp::EspAttrFormat get_attr_format(const SpirvIds& ids, uint32_t type_id);
+static esp::EspUniformShaderStage get_uniform_shader_stage(esp::EspShaderStageFlags stages);
+static bool is_read_only(const SpirvId& variable, const SpirvId& type);
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  bool SpirvReflection::add_stage(EspShaderStage stage, const std::vector<uint32_t>& code)
+  {
+    SpirvIds ids;
+    std::vector<uint32_t> variables;
+    if (!parse_spirv(code, ids, variables)) { return false; }
+
+    auto stage_flag = static_cast<EspShaderStageFlags>(stage);
+
+    // unsized array of textures makes the whole set bindless
+    for (auto variable_id : variables)
+    {
+      const auto& variable = ids[variable_id];
+      const auto& type     = ids[ids[variable.m_operands[0]].m_operands[1]];
+      if (variable.m_has_binding && type.m_opcode == spv::OP_TYPE_RUNTIME_ARRAY && !type.m_operands.empty() &&
+          ids[type.m_operands[0]].m_opcode == spv::OP_TYPE_SAMPLED_IMAGE && !is_bindless_set(variable.m_set))
+      {
+        m_bindless_sets.push_back(variable.m_set);
+      }
+    }
+
+    for (auto variable_id : variables)
+    {
+      const auto& variable = ids[variable_id];
+      const auto& pointer  = ids[variable.m_operands[0]];
+      auto storage_class   = variable.m_operands[1];
+      auto type_id         = pointer.m_operands[1];
+
+      // arrays of descriptors are described by their element type
+      uint32_t count = 1;
+      while (ids[type_id].m_opcode == spv::OP_TYPE_ARRAY || ids[type_id].m_opcode == spv::OP_TYPE_RUNTIME_ARRAY)
+      {
+        count *= get_array_length(ids, type_id);
+        type_id = ids[type_id].m_operands[0];
+      }
+      const auto& type = ids[type_id];
+
+      if (storage_class == spv::STORAGE_CLASS_PUSH_CONSTANT && type.m_opcode == spv::OP_TYPE_STRUCT)
+      {
+        uint32_t offset = UINT32_MAX;
+        for (const auto& member : type.m_members)
+        {
+          offset = std::min(offset, member.m_offset);
+        }
+        if (type.m_members.empty()) { continue; }
+
+        SpirvPushRange range = { offset, get_type_size(ids, type_id) - offset, stage_flag };
+        auto is_same_range   = [&range](const SpirvPushRange& other)
+        { return other.m_offset == range.m_offset && other.m_size == range.m_size; };
+
+        auto it = std::find_if(m_push_ranges.begin(), m_push_ranges.end(), is_same_range);
+        if (it != m_push_ranges.end()) { it->m_stages |= stage_flag; }
+        else { m_push_ranges.push_back(range); }
+      }
+      else if (storage_class == spv::STORAGE_CLASS_INPUT && stage == EspShaderStage::VERTEX)
+      {
+        if (!variable.m_has_location || variable.m_built_in || type.m_opcode == spv::OP_TYPE_STRUCT) { continue; }
+
+        m_vertex_inputs.push_back(
+            { variable.m_location, get_attr_format(ids, type_id), get_type_size(ids, type_id) * count });
+      }
+      else if (variable.m_has_binding)
+      {
+        if (is_bindless_set(variable.m_set)) { continue; }
+
+        SpirvBinding binding = { variable.m_set, variable.m_binding, EspUniformType::ESP_BUFFER_UNIFORM, 0, count, 0 };
+
+        if (storage_class == spv::STORAGE_CLASS_UNIFORM && type.m_block)
+        {
+          binding.m_size = get_type_size(ids, type_id);
+        }
+        else if (storage_class == spv::STORAGE_CLASS_UNIFORM_CONSTANT && type.m_opcode == spv::OP_TYPE_SAMPLED_IMAGE)
+        {
+          binding.m_type = EspUniformType::ESP_TEXTURE;
+        }
+        else if (storage_class == spv::STORAGE_CLASS_UNIFORM_CONSTANT && type.m_opcode == spv::OP_TYPE_IMAGE &&
+                 type.m_operands.size() > 5 && type.m_operands[5] == 2)
+        {
+          // images used without a sampler are storage images
+          binding.m_type = EspUniformType::ESP_STORAGE_IMAGE;
+        }
+        else if ((storage_class == spv::STORAGE_CLASS_STORAGE_BUFFER && type.m_block) ||
+                 (storage_class == spv::STORAGE_CLASS_UNIFORM && type.m_buffer_block))
+        {
+          binding.m_type      = EspUniformType::ESP_STORAGE_BUFFER;
+          binding.m_read_only = is_read_only(variable, type);
+
+          // size of an unsized array is only known to the user, who loads the buffer then
+          bool unsized = !type.m_operands.empty() && ids[type.m_operands.back()].m_opcode == spv::OP_TYPE_RUNTIME_ARRAY;
+          if (!unsized && count == 1) { binding.m_size = get_type_size(ids, type_id); }
+        }
+        else
+        {
+          ESP_CORE_WARN("Binding {} of set {} has unsupported descriptor type.", binding.m_binding, binding.m_set);
+          continue;
+        }
+
+        auto is_same_binding = [&binding](const SpirvBinding& other)
+        { return other.m_set == binding.m_set && other.m_binding == binding.m_binding; };
+
+        auto it = std::find_if(m_bindings.begin(), m_bindings.end(), is_same_binding);
+        if (it != m_bindings.end())
+        {
+          it->m_stages |= stage_flag;
+          it->m_read_only &= binding.m_read_only;
+        }
+        else
+        {
+          binding.m_stages = stage_flag;
+          m_bindings.push_back(binding);
+        }
+      }
+    }
+
+    // set may have been described by previous stages before it turned out to be bindless
+    std::erase_if(m_bindings, [this](const SpirvBinding& binding) { return is_bindless_set(binding.m_set); });
+    std::sort(m_bindless_sets.begin(), m_bindless_sets.end());
+
+    std::sort(m_bindings.begin(),
+              m_bindings.end(),
+              [](const SpirvBinding& a, const SpirvBinding& b)
+              { return a.m_set != b.m_set ? a.m_set < b.m_set : a.m_binding < b.m_binding; });
+    std::sort(m_vertex_inputs.begin(),
+              m_vertex_inputs.end(),
+              [](const SpirvVertexInput& a, const SpirvVertexInput& b) { return a.m_location < b.m_location; });
+
+    return true;
+  }
+
+  bool SpirvReflection::fill_uniform_meta_data(EspUniformMetaData& meta_data) const
+  {
+    int64_t current_set      = -1;
+    uint32_t current_binding = 0;
+
+    auto establish_bindless_sets = [&]()
+    {
+      while (is_bindless_set(current_set + 1))
+      {
+        meta_data.establish_bindless_descriptor_set();
+        current_set++;
+      }
+    };
+
+    for (const auto& binding : m_bindings)
+    {
+      if (binding.m_set != current_set)
+      {
+        establish_bindless_sets();
+        if (binding.m_set != current_set + 1)
+        {
+          ESP_CORE_ERROR("Descriptor set {} is missing in shader.", current_set + 1);
+          return false;
+        }
+
+        meta_data.establish_descriptor_set();
+        current_set     = binding.m_set;
+        current_binding = 0;
+      }
+
+      if (binding.m_binding != current_binding)
+      {
+        ESP_CORE_ERROR("Binding {} of descriptor set {} is missing in shader.", current_binding, current_set);
+        return false;
+      }
+      current_binding++;
+
+      auto stage = get_uniform_shader_stage(binding.m_stages);
+      if (binding.m_type == EspUniformType::ESP_TEXTURE) { meta_data.add_texture_uniform(stage, binding.m_count); }
+      else if (binding.m_type == EspUniformType::ESP_STORAGE_IMAGE)
+      {
+        meta_data.add_storage_image_uniform(stage, binding.m_count);
+      }
+      else if (binding.m_type == EspUniformType::ESP_STORAGE_BUFFER)
+      {
+        auto access = binding.m_read_only ? EspStorageBufferAccess::ESP_READ_ONLY
+                                          : EspStorageBufferAccess::ESP_READ_WRITE;
+        meta_data.add_storage_buffer_uniform(stage, binding.m_size, binding.m_count, access);
+      }
+      else { meta_data.add_buffer_uniform(stage, binding.m_size, binding.m_count); }
+    }
+    establish_bindless_sets();
+
+    for (const auto& range : m_push_ranges)
+    {
+      meta_data.add_push_uniform(get_uniform_shader_stage(range.m_stages), range.m_offset, range.m_size);
+    }
+
+    return true;
+  }
+
+  bool SpirvReflection::is_bindless_set(int64_t set) const
+  {
+    return std::find(m_bindless_sets.begin(), m_bindless_sets.end(), set) != m_bindless_sets.end();
+  }
+
+  EspVertexLayout SpirvReflection::get_vertex_layout(uint32_t binding) const
+  {
+    uint32_t size = 0;
+    std::vector<EspVertexAttribute> attributes;
+    for (const auto& input : m_vertex_inputs)
+    {
+      attributes.emplace_back(input.m_location, input.m_format, size);
+      size += input.m_size;
+    }
+
+    return EspVertexLayout(size, binding, ESP_VERTEX_INPUT_RATE_VERTEX, std::move(attributes));
+  }
+
+  bool SpirvReflection::is_compatible(const std::vector<EspVertexLayout>& vertex_layouts) const
+  {
+    for (const auto& input : m_vertex_inputs)
+    {
+      bool found = false;
+      for (const auto& layout : vertex_layouts)
+      {
+        for (const auto& attribute : layout.m_attrs)
+        {
+          found |= attribute.m_location == input.m_location && attribute.m_format == input.m_format;
+        }
+      }
+
+      if (!found)
+      {
+        ESP_CORE_ERROR("Vertex input at location {} isn't provided by vertex layouts.", input.m_location);
+        return false;
+      }
+    }
+
+    return true;
+  }
+} // namespace esp
+
+/* --------------------------------------------------------- */
+/* ------------------ HELPFUL FUNCTIONS -------------------- */
+/* --------------------------------------------------------- */
+
+static bool parse_spirv(const std::vector<uint32_t>& code, SpirvIds& ids, std::vector<uint32_t>& variables)
+{
+  if (code.size() < spv::HEADER_SIZE || code[0] != spv::MAGIC_NUMBER) { return false; }
+
+  // header's bound is greater than every id used in the module
+  ids.resize(code[3]);
+
+  for (size_t i = spv::HEADER_SIZE; i < code.size();)
+  {
+    uint32_t word_count = code[i] >> 16;
+    uint32_t opcode     = code[i] & 0xFFFF;
+    if (word_count == 0 || i + word_count > code.size()) { return false; }
+
+    const uint32_t* operands = &code[i + 1];
+    uint32_t operand_count   = word_count - 1;
+    i += word_count;
+
+    switch (opcode)
+    {
+    case spv::OP_DECORATE:
+    {
+      if (operand_count < 2 || operands[0] >= ids.size()) { return false; }
+
+      auto& id       = ids[operands[0]];
+      uint32_t value = operand_count > 2 ? operands[2] : 0;
+      switch (operands[1])
+      {
+      case spv::DECORATION_BLOCK:
+        id.m_block = true;
+        break;
+      case spv::DECORATION_BUFFER_BLOCK:
+        id.m_buffer_block = true;
+        break;
+      case spv::DECORATION_ARRAY_STRIDE:
+        id.m_array_stride = value;
+        break;
+      case spv::DECORATION_BUILT_IN:
+        id.m_built_in = true;
+        break;
+      case spv::DECORATION_NON_WRITABLE:
+        id.m_non_writable = true;
+        break;
+      case spv::DECORATION_LOCATION:
+        id.m_location     = value;
+        id.m_has_location = true;
+        break;
+      case spv::DECORATION_BINDING:
+        id.m_binding     = value;
+        id.m_has_binding = true;
+        break;
+      case spv::DECORATION_DESCRIPTOR_SET:
+        id.m_set = value;
+        break;
+      }
+      break;
+    }
+    case spv::OP_MEMBER_DECORATE:
+    {
+      if (operand_count < 3 || operands[0] >= ids.size()) { return false; }
+
+      auto& members = ids[operands[0]].m_members;
+      if (members.size() <= operands[1]) { members.resize(operands[1] + 1); }
+
+      auto& member   = members[operands[1]];
+      uint32_t value = operand_count > 3 ? operands[3] : 0;
+      switch (operands[2])
+      {
+      case spv::DECORATION_OFFSET:
+        member.m_offset = value;
+        break;
+      case spv::DECORATION_MATRIX_STRIDE:
+        member.m_matrix_stride = value;
+        break;
+      case spv::DECORATION_BUILT_IN:
+        member.m_built_in = true;
+        break;
+      case spv::DECORATION_NON_WRITABLE:
+        member.m_non_writable = true;
+        break;
+      }
+      break;
+    }
+    case spv::OP_TYPE_BOOL:
+    case spv::OP_TYPE_INT:
+    case spv::OP_TYPE_FLOAT:
+    case spv::OP_TYPE_VECTOR:
+    case spv::OP_TYPE_MATRIX:
+    case spv::OP_TYPE_IMAGE:
+    case spv::OP_TYPE_SAMPLER:
+    case spv::OP_TYPE_SAMPLED_IMAGE:
+    case spv::OP_TYPE_ARRAY:
+    case spv::OP_TYPE_RUNTIME_ARRAY:
+    case spv::OP_TYPE_STRUCT:
+    case spv::OP_TYPE_POINTER:
+    {
+      // result id is the first operand
+      if (operand_count < 1 || operands[0] >= ids.size()) { return false; }
+
+      auto& id    = ids[operands[0]];
+      id.m_opcode = opcode;
+      id.m_operands.assign(operands + 1, operands + operand_count);
+      break;
+    }
+    case spv::OP_CONSTANT:
+    case spv::OP_SPEC_CONSTANT:
+    case spv::OP_VARIABLE:
+    {
+      // result type precedes result id
+      if (operand_count < 2 || operands[1] >= ids.size()) { return false; }
+
+      auto& id    = ids[operands[1]];
+      id.m_opcode = opcode;
+      id.m_operands.assign({ operands[0] });
+      id.m_operands.insert(id.m_operands.end(), operands + 2, operands + operand_count);
+
+      if (opcode == spv::OP_VARIABLE) { variables.push_back(operands[1]); }
+      break;
+    }
+    }
+  }
+
+  // every variable has to point to a known type
+  for (auto variable_id : variables)
+  {
+    const auto& variable = ids[variable_id];
+    if (variable.m_operands.size() < 2 || variable.m_operands[0] >= ids.size()) { return false; }
+
+    const auto& pointer = ids[variable.m_operands[0]];
+    if (pointer.m_opcode != spv::OP_TYPE_POINTER || pointer.m_operands.size() < 2) { return false; }
+    if (pointer.m_operands[1] >= ids.size()) { return false; }
+  }
+
+  return true;
+}
+
+static uint32_t get_type_size(const SpirvIds& ids, uint32_t type_id, uint32_t matrix_stride)
+{
+  if (type_id >= ids.size()) { return 0; }
+
+  const auto& type = ids[type_id];
+  switch (type.m_opcode)
+  {
+  case spv::OP_TYPE_BOOL:
+    return 4;
+  case spv::OP_TYPE_INT:
+  case spv::OP_TYPE_FLOAT:
+    return type.m_operands[0] / 8;
+  case spv::OP_TYPE_VECTOR:
+    return get_type_size(ids, type.m_operands[0]) * type.m_operands[1];
+  case spv::OP_TYPE_MATRIX:
+  {
+    uint32_t column_size = matrix_stride ? matrix_stride : get_type_size(ids, type.m_operands[0]);
+    return column_size * type.m_operands[1];
+  }
+  case spv::OP_TYPE_ARRAY:
+  {
+    uint32_t stride = type.m_array_stride ? type.m_array_stride : get_type_size(ids, type.m_operands[0], matrix_stride);
+    return stride * get_array_length(ids, type_id);
+  }
+  case spv::OP_TYPE_STRUCT:
+  {
+    uint32_t size = 0;
+    for (size_t i = 0; i < type.m_operands.size(); i++)
+    {
+      SpirvMember member   = i < type.m_members.size() ? type.m_members[i] : SpirvMember{};
+      uint32_t member_size = get_type_size(ids, type.m_operands[i], member.m_matrix_stride);
+      size                 = std::max(size, member.m_offset + member_size);
+    }
+    return size;
+  }
+  default:
+    // runtime arrays and opaque types don't take space in blocks
+    return 0;
+  }
+}
+
+static uint32_t get_array_length(const SpirvIds& ids, uint32_t type_id)
+{
+  const auto& type = ids[type_id];
+  if (type.m_opcode != spv::OP_TYPE_ARRAY || type.m_operands.size() < 2) { return 0; }
+
+  // length is a constant (or specialization constant with its default value)
+  auto length_id = type.m_operands[1];
+  if (length_id >= ids.size() || ids[length_id].m_operands.size() < 2) { return 0; }
+  return ids[length_id].m_operands[1];
+}
+
+static esp::EspAttrFormat get_attr_format(const SpirvIds& ids, uint32_t type_id)
+{
+  uint32_t component_count = 1;
+  if (ids[type_id].m_opcode == spv::OP_TYPE_VECTOR)
+  {
+    component_count = ids[type_id].m_operands[1];
+    type_id         = ids[type_id].m_operands[0];
+  }
+
+  const auto& component = ids[type_id];
+  if (component.m_operands.empty() || component.m_operands[0] != 32 || component_count > 4)
+  {
+    return esp::ESP_FORMAT_UNDEFINED;
+  }
+
+  // 32-bit formats are ordered by component count, and then UINT, SINT and SFLOAT
+  uint32_t format = esp::ESP_FORMAT_R32_UINT + 3 * (component_count - 1);
+  if (component.m_opcode == spv::OP_TYPE_FLOAT) { format += 2; }
+  else if (component.m_opcode == spv::OP_TYPE_INT && component.m_operands[1]) { format += 1; }
+  else if (component.m_opcode != spv::OP_TYPE_INT) { return esp::ESP_FORMAT_UNDEFINED; }
+
+  return static_cast<esp::EspAttrFormat>(format);
+}
+
+static esp::EspUniformShaderStage get_uniform_shader_stage(esp::EspShaderStageFlags stages)
+{
+  if (stages == static_cast<esp::EspShaderStageFlags>(esp::EspShaderStage::VERTEX))
+  {
+    return esp::EspUniformShaderStage::ESP_VTX_STAGE;
+  }
+  if (stages == static_cast<esp::EspShaderStageFlags>(esp::EspShaderStage::FRAGMENT))
+  {
+    return esp::EspUniformShaderStage::ESP_FRAG_STAGE;
+  }
+  if (stages == static_cast<esp::EspShaderStageFlags>(esp::EspShaderStage::COMPUTE))
+  {
+    return esp::EspUniformShaderStage::ESP_COMPUTE_STAGE;
+  }
+  return esp::EspUniformShaderStage::ESP_ALL_STAGES;
+}
+
+static bool is_read_only(const SpirvId& variable, const SpirvId& type)
+{
+  // readonly blocks have every member decorated
+  if (variable.m_non_writable) { return true; }
+  if (type.m_operands.empty() || type.m_members.size() < type.m_operands.size()) { return false; }
+
+  return std::all_of(type.m_members.begin(),
+                     type.m_members.begin() + type.m_operands.size(),
+                     [](const SpirvMember& member) { return member.m_non_writable; });
+}
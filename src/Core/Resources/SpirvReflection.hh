@@ -0,0 +1,106 @@
+#ifndef ESPERT_CORE_RESOURCES_SPIRV_REFLECTION_HH
+#define ESPERT_CORE_RESOURCES_SPIRV_REFLECTION_HH
+
+#include "esppch.hh"
+
+#include "Core/RenderAPI/Resources/EspShaderStage.hh"
+#include "Core/RenderAPI/Uniforms/EspUniformMetaData.hh"
+#include "Core/RenderAPI/Worker/EspAttrFormat.hh"
+
+namespace esp
+{
+  struct EspVertexLayout;
+
+  /// @brief Descriptor binding used by shader code.
+  struct SpirvBinding
+  {
+    /// @brief Index of descriptor set.
+    uint32_t m_set;
+    /// @brief Binding within descriptor set.
+    uint32_t m_binding;
+    /// @brief Type of uniform.
+    EspUniformType m_type;
+    /// @brief Size of uniform block in bytes. 0 for textures and for storage buffers ending with an unsized array or
+    /// arrays of storage buffers, which are loaded by the user.
+    uint32_t m_size;
+    /// @brief Number of array elements.
+    uint32_t m_count;
+    /// @brief Stages using the binding.
+    EspShaderStageFlags m_stages;
+    /// @brief Storage buffer isn't written by any stage.
+    bool m_read_only;
+  };
+
+  /// @brief Push constant range used by shader code.
+  struct SpirvPushRange
+  {
+    /// @brief Offset of the first member of push constant block in bytes.
+    uint32_t m_offset;
+    /// @brief Size of push constant range in bytes.
+    uint32_t m_size;
+    /// @brief Stages using the range.
+    EspShaderStageFlags m_stages;
+  };
+
+  /// @brief Input of vertex shader.
+  struct SpirvVertexInput
+  {
+    /// @brief Location of input.
+    uint32_t m_location;
+    /// @brief Format of input.
+    EspAttrFormat m_format;
+    /// @brief Size of input in bytes.
+    uint32_t m_size;
+  };
+
+  /// @brief Interface of shader stages extracted from their SPIR-V code. It describes descriptor sets, push constants
+  /// and vertex inputs, so they don't have to be described by hand.
+  class SpirvReflection
+  {
+   private:
+    std::vector<SpirvBinding> m_bindings;
+    std::vector<uint32_t> m_bindless_sets;
+    std::vector<SpirvPushRange> m_push_ranges;
+    std::vector<SpirvVertexInput> m_vertex_inputs;
+
+   public:
+    /// @brief Adds interface of shader stage. Bindings used by many stages are merged.
+    /// @param stage Stage of shader code.
+    /// @param code SPIR-V code of the stage.
+    /// @return True if the code was reflected. False if it isn't valid SPIR-V.
+    bool add_stage(EspShaderStage stage, const std::vector<uint32_t>& code);
+
+    /// @brief Returns descriptor bindings sorted by set and binding.
+    /// @return Vector of descriptor bindings.
+    inline const std::vector<SpirvBinding>& get_bindings() const { return m_bindings; }
+    /// @brief Returns indices of descriptor sets with an unsized array of textures. They are described as the
+    /// descriptor set of EspBindlessTextures and their bindings aren't reflected.
+    /// @return Vector of set indices.
+    inline const std::vector<uint32_t>& get_bindless_sets() const { return m_bindless_sets; }
+    /// @brief Returns push constant ranges.
+    /// @return Vector of push constant ranges.
+    inline const std::vector<SpirvPushRange>& get_push_ranges() const { return m_push_ranges; }
+    /// @brief Returns inputs of vertex shader sorted by location.
+    /// @return Vector of vertex inputs.
+    inline const std::vector<SpirvVertexInput>& get_vertex_inputs() const { return m_vertex_inputs; }
+
+    /// @brief Describes reflected descriptor sets and push constants in uniform metadata. Sets and bindings have to be
+    /// numbered from 0 without gaps, as EspUniformMetaData numbers them in order.
+    /// @param meta_data Empty uniform metadata.
+    /// @return True if all uniforms were described. False otherwise.
+    bool fill_uniform_meta_data(EspUniformMetaData& meta_data) const;
+    /// @brief Creates vertex layout with all vertex inputs interleaved in one binding, ordered by location.
+    /// @param binding Binding of the vertex buffer.
+    /// @return Vertex layout matching the vertex shader.
+    EspVertexLayout get_vertex_layout(uint32_t binding = 0) const;
+    /// @brief Checks if vertex layouts provide every vertex input with matching format.
+    /// @param vertex_layouts Vertex layouts to be checked.
+    /// @return True if vertex layouts match the vertex shader. False otherwise.
+    bool is_compatible(const std::vector<EspVertexLayout>& vertex_layouts) const;
+
+   private:
+    bool is_bindless_set(int64_t set) const;
+  };
+} // namespace esp
+
+#endif // ESPERT_CORE_RESOURCES_SPIRV_REFLECTION_HH
@@ -5,6 +5,7 @@ namespace esp
   Material::Material(MaterialTexutresMap textures, std::vector<MaterialTextureLayout> layouts) :
       m_name(""), m_textures_map(std::move(textures)), m_material_texture_layouts(std::move(layouts))
   {
+    m_bindless_index = EspBindlessTextures::add_material(m_textures_map);
   }
 
   Material::Material(const std::string& name,
@@ -15,6 +16,8 @@ namespace esp
     m_name = name;
   }
 
+  Material::~Material() { EspBindlessTextures::release_material(m_bindless_index); }
+
   std::unique_ptr<EspUniformManager> Material::create_uniform_manager(std::shared_ptr<EspShader> shader) const
   {
     int start_ds = -1, end_ds = -1;
@@ -3,6 +3,7 @@
 
 #include "esppch.hh"
 
+#include "Core/RenderAPI/Resources/EspBindlessTextures.hh"
 #include "Core/RenderAPI/Resources/EspShader.hh"
 #include "Core/RenderAPI/Resources/EspTexture.hh"
 #include "Core/RenderAPI/Uniforms/EspUniformManager.hh"
@@ -39,20 +40,23 @@ namespace esp
     MaterialTexutresMap m_textures_map;
     std::vector<MaterialTextureLayout> m_material_texture_layouts;
     std::string m_name;
+    uint32_t m_bindless_index = EspBindlessTextures::INVALID_INDEX;
 
    public:
-    /// @brief Constructor without material name (cannot be acquired by name). Sets up underlying EspUniformManager.
+    /// @brief Constructor without material name (cannot be acquired by name). Sets up underlying EspUniformManager
+    /// and adds the material to EspBindlessTextures if they are enabled.
     /// @param textures Map of textures to use in material.
     /// @param layouts Information on textures' sets and bindings inside shader.
     Material(MaterialTexutresMap textures, std::vector<MaterialTextureLayout> layouts);
 
-    /// @brief Constructor with material name (can be acquired by name). Sets up underlying EspUniformManager.
+    /// @brief Constructor with material name (can be acquired by name). Sets up underlying EspUniformManager and adds
+    /// the material to EspBindlessTextures if they are enabled.
     /// @param textures Map of textures to use in material.
     /// @param layouts Information on textures' sets and bindings inside shader.
     Material(const std::string& name, MaterialTexutresMap textures, std::vector<MaterialTextureLayout> layouts);
 
-    /// @brief Default destructor.
-    ~Material() = default;
+    /// @brief Releases the material from EspBindlessTextures.
+    ~Material();
 
     PREVENT_COPY(Material);
 
@@ -81,6 +85,9 @@ namespace esp
     /// @brief Returns material's name.
     /// @return Material's name.
     inline const std::string get_name() const { return m_name; }
+    /// @brief Returns index of the material in EspBindlessTextures.
+    /// @return Index of the material or EspBindlessTextures::INVALID_INDEX if bindless textures aren't enabled.
+    inline uint32_t get_bindless_index() const { return m_bindless_index; }
   };
 
   using MaterialByTextureMap = std::unordered_map<std::vector<std::shared_ptr<EspTexture>>, std::shared_ptr<Material>>;
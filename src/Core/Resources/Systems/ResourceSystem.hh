@@ -124,9 +124,9 @@ namespace esp
                        typeid(r).name());
         return;
       }
-      auto msg = "Unloaded " + std::string(typeid(r).name()) + " " + resource->get_filename();
+      // arguments are formatted only if the message is logged
+      ESP_CORE_TRACE("Unloading {} {}.", typeid(r).name(), resource->get_filename());
       s_instance->m_loader_map.at(typeid(r))->unload(std::move(resource));
-      ESP_CORE_TRACE(msg);
     }
   };
 
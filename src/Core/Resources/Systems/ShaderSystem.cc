@@ -34,6 +34,7 @@ namespace esp
     ShaderSystem::s_instance = nullptr;
     ShaderMap empty_map      = {};
     m_shader_map.swap(empty_map);
+    m_spirv_map.clear();
     ESP_CORE_TRACE("Shader system shutdown.");
   }
 
@@ -63,18 +64,34 @@ namespace esp
     ESP_CORE_TRACE("Released shader {}.", name);
   }
 
+  void ShaderSystem::precompile(const std::string& name,
+                                const std::vector<SpecializationConstantMap>& permutations,
+                                const std::function<void(EspShader&)>& configure)
+  {
+    for (const auto& spec_const_map : permutations)
+    {
+      if (s_instance->m_shader_map.contains(std::make_pair(name, spec_const_map))) { continue; }
+
+      auto shader = load(name, spec_const_map);
+      if (shader == get_default_shader()) { continue; }
+
+      configure(*shader);
+      shader->build_worker();
+    }
+
+    ESP_CORE_TRACE("Scheduled compilation of {} permutations of shader {}.", permutations.size(), name);
+  }
+
   std::shared_ptr<EspShader> ShaderSystem::load(const std::string& name,
                                                 const SpecializationConstantMap& spec_const_map)
   {
-    SpirvResourceParams params;
-    auto resource = ResourceSystem::load<SpirvResource>(name, params);
-    if (!resource)
+    auto spirv_resource = load_spirv(name);
+    if (!spirv_resource)
     {
       ESP_CORE_ERROR("Could not load shader {}.", name);
       return get_default_shader();
     }
-    auto spirv_resource = unique_cast<SpirvResource>(std::move(resource));
-    auto shader         = EspShader::create(name, std::move(spirv_resource));
+    auto shader = EspShader::create(name, std::move(spirv_resource));
     shader->set_specialization(spec_const_map);
     auto key = std::make_pair(name, spec_const_map);
     s_instance->m_shader_map.insert({ key, shader });
@@ -82,6 +99,20 @@ namespace esp
     return shader;
   }
 
+  std::shared_ptr<SpirvResource> ShaderSystem::load_spirv(const std::string& name)
+  {
+    auto& entry = s_instance->m_spirv_map[name];
+    if (auto spirv_resource = entry.lock()) { return spirv_resource; }
+
+    SpirvResourceParams params;
+    auto resource = ResourceSystem::load<SpirvResource>(name, params);
+    if (!resource) { return nullptr; }
+
+    auto spirv_resource = std::shared_ptr<SpirvResource>(unique_cast<SpirvResource>(std::move(resource)));
+    entry               = spirv_resource;
+    return spirv_resource;
+  }
+
   std::shared_ptr<EspShader> ShaderSystem::get_default_shader()
   {
     return s_instance->m_shader_map.at(std::make_pair(s_instance->m_default_shader_name, SpecializationConstantMap()));
@@ -19,9 +19,13 @@ namespace esp
     ShaderMap m_shader_map;
     std::string m_default_shader_name = "Shaders/default";
 
+    /* SPIR-V sources shared by all permutations of a shader, kept alive by the shaders using them. */
+    std::unordered_map<std::string, std::weak_ptr<SpirvResource>> m_spirv_map;
+
     ShaderSystem();
 
     static std::shared_ptr<EspShader> load(const std::string& name, const SpecializationConstantMap& spec_const_map);
+    static std::shared_ptr<SpirvResource> load_spirv(const std::string& name);
 
    public:
     /// @brief Terminates ShaderSystem.
@@ -49,6 +53,16 @@ namespace esp
     /// @param spec_const_map Map containing values of specialisation constants for shader stages.
     static void release(const std::string& name, const SpecializationConstantMap& spec_const_map = {});
 
+    /// @brief Loads and configures shader permutations that weren't acquired yet and schedules compilation of their
+    /// pipelines, so they are compiled concurrently instead of on first use. Acquiring them later returns shaders
+    /// that are already configured.
+    /// @param name Name/relative path to shader sources (without any extensions).
+    /// @param permutations Maps containing values of specialisation constants of each permutation.
+    /// @param configure Function configuring the shader (layouts, attachments, etc.). It shouldn't call build_worker.
+    static void precompile(const std::string& name,
+                           const std::vector<SpecializationConstantMap>& permutations,
+                           const std::function<void(EspShader&)>& configure);
+
     /// @brief Returns default shader.
     /// @return Shared pointer to default shader.
     static std::shared_ptr<EspShader> get_default_shader();
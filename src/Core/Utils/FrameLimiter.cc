@@ -0,0 +1,102 @@
+#include "FrameLimiter.hh"
+
+// std
+#include <thread>
+
+// length of a single sleep, the deadline is approached in such steps
+static constexpr auto SLEEP_STEP = std::chrono::milliseconds(1);
+
+namespace esp
+{
+  std::unique_ptr<FrameLimiter> FrameLimiter::create(float target_frame_rate, bool paced_externally)
+  {
+    return std::unique_ptr<FrameLimiter>(new FrameLimiter(target_frame_rate, paced_externally));
+  }
+
+  void FrameLimiter::wait()
+  {
+    ESP_PROFILE_SCOPE("FrameLimiter::wait");
+
+    auto now = Clock::now();
+    if (!m_started)
+    {
+      m_started    = true;
+      m_last_frame = now;
+      m_deadline   = now + m_frame_time;
+      return;
+    }
+
+    // externally paced frames only jitter around the deadline, they miss it when they take a whole extra interval
+    bool limited   = m_frame_time > Clock::duration::zero();
+    auto tolerance = m_paced_externally ? m_frame_time / 2 : Clock::duration::zero();
+    bool missed    = limited && now > m_deadline + tolerance;
+    if (missed) { m_stats.m_missed_deadlines++; }
+    if (limited && !missed && !m_paced_externally)
+    {
+      sleep_until(m_deadline);
+      now = Clock::now();
+    }
+
+    add_frame(std::chrono::duration<double, std::milli>(now - m_last_frame).count());
+    m_last_frame = now;
+
+    // late frame starts a new cadence, so the following frames aren't rushed to catch up
+    m_deadline = (missed || m_paced_externally ? now : m_deadline) + m_frame_time;
+  }
+
+  void FrameLimiter::set_target_frame_rate(float target_frame_rate)
+  {
+    m_frame_time = target_frame_rate > 0.f ? std::chrono::duration_cast<Clock::duration>(
+                                                 std::chrono::duration<double>(1.0 / target_frame_rate))
+                                           : Clock::duration::zero();
+  }
+
+  void FrameLimiter::reset_stats()
+  {
+    m_stats         = {};
+    m_frame_time_m2 = 0.0;
+  }
+
+  FrameLimiter::FrameLimiter(float target_frame_rate, bool paced_externally) : m_paced_externally{ paced_externally }
+  {
+    set_target_frame_rate(target_frame_rate);
+  }
+
+  void FrameLimiter::sleep_until(Clock::time_point deadline)
+  {
+    // sleeping is imprecise, so it stops once the remaining time is within the expected length of a sleep step
+    while (true)
+    {
+      auto begin     = Clock::now();
+      auto remaining = std::chrono::duration<double>(deadline - begin).count();
+      if (remaining <= m_sleep_mean + std::sqrt(m_sleep_m2 / m_sleep_count)) { break; }
+
+      std::this_thread::sleep_for(SLEEP_STEP);
+
+      auto slept = std::chrono::duration<double>(Clock::now() - begin).count();
+      m_sleep_count++;
+      auto delta = slept - m_sleep_mean;
+      m_sleep_mean += delta / m_sleep_count;
+      m_sleep_m2 += delta * (slept - m_sleep_mean);
+    }
+
+    // the rest is too short to sleep, the thread still gives way to others
+    while (Clock::now() < deadline)
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  void FrameLimiter::add_frame(double frame_time)
+  {
+    // Welford's algorithm, so the variance doesn't need every frame time
+    m_stats.m_frame_count++;
+    auto delta = frame_time - m_stats.m_mean_frame_time;
+    m_stats.m_mean_frame_time += delta / m_stats.m_frame_count;
+    m_frame_time_m2 += delta * (frame_time - m_stats.m_mean_frame_time);
+
+    m_stats.m_frame_time_variance = m_frame_time_m2 / m_stats.m_frame_count;
+    m_stats.m_last_frame_time     = frame_time;
+    m_stats.m_max_frame_time      = std::max(m_stats.m_max_frame_time, frame_time);
+  }
+} // namespace esp
@@ -0,0 +1,98 @@
+#ifndef CORE_FRAME_LIMITER_HH
+#define CORE_FRAME_LIMITER_HH
+
+#include "esppch.hh"
+
+// std
+#include <chrono>
+
+namespace esp
+{
+  /// @brief Frame times measured by FrameLimiter.
+  struct FrameLimiterStats
+  {
+    /// @brief Number of measured frames.
+    uint64_t m_frame_count = 0;
+    /// @brief Number of frames which took longer than the target frame time.
+    uint64_t m_missed_deadlines = 0;
+    /// @brief Duration of the last frame in milliseconds.
+    double m_last_frame_time = 0.0;
+    /// @brief Mean frame time in milliseconds.
+    double m_mean_frame_time = 0.0;
+    /// @brief Variance of frame times in milliseconds squared.
+    double m_frame_time_variance = 0.0;
+    /// @brief Longest frame time in milliseconds.
+    double m_max_frame_time = 0.0;
+
+    /// @brief Returns standard deviation of frame times.
+    /// @return Standard deviation of frame times in milliseconds.
+    inline double get_standard_deviation() const { return std::sqrt(m_frame_time_variance); }
+  };
+
+  /// @brief Limits frame rate to the target without spinning a core. It sleeps in short steps until the remaining
+  /// time is close to the observed oversleep of the system, then yields until the deadline. Deadlines follow each other
+  /// by the target frame time, a frame finished after its deadline is counted as missed and starts a new cadence
+  /// instead of being caught up with.
+  class FrameLimiter
+  {
+   private:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::duration m_frame_time;
+    bool m_paced_externally;
+
+    bool m_started = false;
+    Clock::time_point m_deadline;
+    Clock::time_point m_last_frame;
+
+    // running mean and deviation of how long a sleep step really takes (seconds)
+    double m_sleep_mean    = 0.005;
+    double m_sleep_m2      = 0.0;
+    uint64_t m_sleep_count = 1;
+
+    FrameLimiterStats m_stats;
+    double m_frame_time_m2 = 0.0;
+
+   public:
+    /// @brief Creates instance of FrameLimiter.
+    /// @param target_frame_rate Frames per second. 0 disables the limit, frames are only measured.
+    /// @param paced_externally True if frames are already paced, e.g. by FIFO presentation. Frames are only measured
+    /// against the target then.
+    /// @return Unique pointer to created FrameLimiter.
+    static std::unique_ptr<FrameLimiter> create(float target_frame_rate, bool paced_externally = false);
+
+    PREVENT_COPY(FrameLimiter)
+
+    /// @brief Default destructor.
+    ~FrameLimiter() = default;
+
+    /// @brief Waits until the deadline of the next frame and measures the frame which has just finished. Has to be
+    /// called once per frame, before it starts.
+    void wait();
+
+    /// @brief Sets target frame rate. The current deadline is kept.
+    /// @param target_frame_rate Frames per second. 0 disables the limit.
+    void set_target_frame_rate(float target_frame_rate);
+    /// @brief Clears measured frame times.
+    void reset_stats();
+
+    /// @brief Returns target frame rate.
+    /// @return Frames per second. 0 if the frame rate isn't limited.
+    inline float get_target_frame_rate() const
+    {
+      if (m_frame_time == Clock::duration::zero()) { return 0.f; }
+      return 1.0 / std::chrono::duration<double>(m_frame_time).count();
+    }
+    /// @brief Returns frame times measured so far.
+    /// @return Frame times measured so far.
+    inline const FrameLimiterStats& get_stats() const { return m_stats; }
+
+   private:
+    FrameLimiter(float target_frame_rate, bool paced_externally);
+
+    void sleep_until(Clock::time_point deadline);
+    void add_frame(double frame_time);
+  };
+} // namespace esp
+
+#endif // CORE_FRAME_LIMITER_HH
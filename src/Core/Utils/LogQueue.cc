@@ -0,0 +1,152 @@
+#include "LogQueue.hh"
+#include "Profiler.hh"
+
+// std
+#include <bit>
+
+namespace esp
+{
+  LogQueue::LogQueue(size_t capacity)
+  {
+    capacity = std::bit_ceil(std::max<size_t>(capacity, 2));
+    m_slots  = std::make_unique<Slot[]>(capacity);
+    m_mask   = capacity - 1;
+
+    // slot i is free for the producer of position i
+    for (size_t i = 0; i < capacity; i++)
+    {
+      m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+    }
+
+    m_sink_thread = std::thread(&LogQueue::run, this);
+  }
+
+  LogQueue::~LogQueue()
+  {
+    m_running.store(false, std::memory_order_release);
+    m_signal.fetch_add(1, std::memory_order_release);
+    m_signal.notify_one();
+    m_sink_thread.join();
+  }
+
+  void LogQueue::flush()
+  {
+    // every claimed position is published, so the sink thread gets to all of them
+    size_t target  = m_enqueue_position.load(std::memory_order_acquire);
+    size_t written = m_written.load(std::memory_order_acquire);
+    while (written < target)
+    {
+      m_written.wait(written, std::memory_order_acquire);
+      written = m_written.load(std::memory_order_acquire);
+    }
+
+    spdlog::apply_all([](std::shared_ptr<spdlog::logger> category) { category->flush(); });
+  }
+
+  LogRecord* LogQueue::try_claim(size_t& position)
+  {
+    position = m_enqueue_position.load(std::memory_order_relaxed);
+    while (true)
+    {
+      auto& slot      = m_slots[position & m_mask];
+      size_t sequence = slot.m_sequence.load(std::memory_order_acquire);
+      auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+      if (difference == 0)
+      {
+        // on failure position is reloaded and the next slot is tried
+        if (m_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+        {
+          return &slot.m_record;
+        }
+      }
+      // the slot still holds the message of the previous lap, the ring is full
+      else if (difference < 0) { return nullptr; }
+      else { position = m_enqueue_position.load(std::memory_order_relaxed); }
+    }
+  }
+
+  void LogQueue::publish(size_t position)
+  {
+    m_slots[position & m_mask].m_sequence.store(position + 1, std::memory_order_release);
+
+    // the sink thread sleeps only when the ring is empty, waking it doesn't block the caller
+    m_signal.fetch_add(1, std::memory_order_release);
+    m_signal.notify_one();
+  }
+
+  void LogQueue::run()
+  {
+    ESP_PROFILE_THREAD("Log sink");
+
+    while (true)
+    {
+      // read before draining, so a message published in between changes it and the wait returns
+      uint32_t signal = m_signal.load(std::memory_order_acquire);
+      bool running    = m_running.load(std::memory_order_acquire);
+
+      if (write_pending()) { continue; }
+      if (!running) { break; }
+
+      m_signal.wait(signal, std::memory_order_acquire);
+    }
+  }
+
+  bool LogQueue::write_pending()
+  {
+    bool written = false;
+    while (true)
+    {
+      auto& slot = m_slots[m_dequeue_position & m_mask];
+      if (slot.m_sequence.load(std::memory_order_acquire) != m_dequeue_position + 1) { break; }
+
+      write(slot.m_record);
+
+      // frees the slot for the producer of the next lap
+      slot.m_sequence.store(m_dequeue_position + m_mask + 1, std::memory_order_release);
+      m_dequeue_position++;
+      written = true;
+    }
+
+    if (written)
+    {
+      m_written.store(m_dequeue_position, std::memory_order_release);
+      m_written.notify_all();
+    }
+    return written;
+  }
+
+  void LogQueue::write(LogRecord& record)
+  {
+    spdlog::memory_buf_t payload;
+    try
+    {
+      record.m_format_arguments(record, payload);
+    }
+    catch (const std::exception& e)
+    {
+      payload.clear();
+      fmt::format_to(fmt::appender(payload), "[failed to format \"{}\": {}]", record.m_format, e.what());
+    }
+
+    auto& category = *record.m_category;
+    spdlog::details::log_msg message(record.m_time,
+                                     spdlog::source_loc{},
+                                     category.name(),
+                                     record.m_level,
+                                     spdlog::string_view_t(payload.data(), payload.size()));
+    message.thread_id = record.m_thread_id;
+
+    for (auto& sink : category.sinks())
+    {
+      if (sink->should_log(record.m_level)) { sink->log(message); }
+    }
+    if (record.m_level >= category.flush_level())
+    {
+      for (auto& sink : category.sinks())
+      {
+        sink->flush();
+      }
+    }
+  }
+} // namespace esp
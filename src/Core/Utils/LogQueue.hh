@@ -0,0 +1,168 @@
+#ifndef ESPERT_CORE_LOG_QUEUE_HH
+#define ESPERT_CORE_LOG_QUEUE_HH
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+namespace esp
+{
+  /// @brief Copy of a log argument kept until the message is formatted. Strings are copied, as C strings and views
+  /// may point to buffers released before the sink thread reads them, other arguments are kept by value.
+  template<typename T>
+  using LogArgument = std::conditional_t<std::is_convertible_v<std::decay_t<T>, std::string_view>,
+                                         std::string,
+                                         std::decay_t<T>>;
+
+  /// @brief Checks if arguments can be copied into a LogRecord, so their message can be formatted later.
+  template<typename... Args>
+  inline constexpr bool is_log_deferrable_v = (std::is_constructible_v<LogArgument<Args>, Args&&> && ...);
+
+  /// @brief Message waiting in LogQueue. Keeps the format string and copies of the arguments, which are formatted
+  /// by the sink thread.
+  struct LogRecord
+  {
+    /// @brief Size of arguments stored in the record, larger ones are allocated on the heap.
+    static constexpr size_t ARGUMENTS_SIZE = 96;
+
+    /// @brief Category the message is written by. Categories live as long as the logger.
+    spdlog::logger* m_category;
+    /// @brief Level of the message.
+    spdlog::level::level_enum m_level;
+    /// @brief Time the message was logged.
+    spdlog::log_clock::time_point m_time;
+    /// @brief Thread the message was logged by.
+    size_t m_thread_id;
+    /// @brief Format string. Points to a string literal.
+    std::string_view m_format;
+    /// @brief Formats the arguments into the buffer and destroys them.
+    void (*m_format_arguments)(LogRecord& record, spdlog::memory_buf_t& buffer);
+    /// @brief Arguments, or a pointer to them if they don't fit.
+    alignas(std::max_align_t) std::byte m_arguments[ARGUMENTS_SIZE];
+  };
+
+  /// @brief Bounded lock-free multi-producer single-consumer ring of log messages, drained by a sink thread. Logging
+  /// threads only copy the format string and arguments into a slot, formatting and writing to the sinks of the
+  /// category happen on the sink thread. Messages logged while the ring is full are dropped and counted, so logging
+  /// never waits for the sinks.
+  class LogQueue
+  {
+   private:
+    struct Slot
+    {
+      std::atomic<size_t> m_sequence;
+      LogRecord m_record;
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_mask;
+
+    // claimed by producers with compare and swap
+    alignas(64) std::atomic<size_t> m_enqueue_position = 0;
+    // read only by the sink thread, other threads wait for m_written
+    alignas(64) size_t m_dequeue_position = 0;
+    std::atomic<size_t> m_written         = 0;
+
+    std::atomic<uint64_t> m_dropped = 0;
+    std::atomic<uint32_t> m_signal  = 0;
+    std::atomic<bool> m_running     = true;
+    std::thread m_sink_thread;
+
+   public:
+    /// @brief Creates the queue and starts its sink thread.
+    /// @param capacity Number of messages the queue can hold, rounded up to a power of two.
+    LogQueue(size_t capacity);
+    /// @brief Writes pending messages and stops the sink thread.
+    ~LogQueue();
+
+    LogQueue(const LogQueue&)            = delete;
+    LogQueue& operator=(const LogQueue&) = delete;
+
+    /// @brief Copies the message into the queue, the sink thread formats it. Has to be called only if category logs
+    /// the level.
+    /// @param category Category the message is written by.
+    /// @param level Level of the message.
+    /// @param format Format string. Has to outlive the queue, e.g. a string literal.
+    /// @param args Arguments of the message.
+    template<typename... Args>
+    void push(spdlog::logger& category, spdlog::level::level_enum level, std::string_view format, Args&&... args)
+    {
+      using Arguments = std::tuple<LogArgument<Args>...>;
+      constexpr bool IS_INLINE =
+          sizeof(Arguments) <= LogRecord::ARGUMENTS_SIZE && alignof(Arguments) <= alignof(std::max_align_t);
+
+      size_t position;
+      auto record = try_claim(position);
+      if (!record)
+      {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+
+      record->m_category         = &category;
+      record->m_level            = level;
+      record->m_time             = spdlog::log_clock::now();
+      record->m_thread_id        = spdlog::details::os::thread_id();
+      record->m_format           = format;
+      record->m_format_arguments = &format_arguments<Arguments, IS_INLINE>;
+      if constexpr (IS_INLINE) { new (record->m_arguments) Arguments(std::forward<Args>(args)...); }
+      else { *reinterpret_cast<Arguments**>(record->m_arguments) = new Arguments(std::forward<Args>(args)...); }
+
+      publish(position);
+    }
+
+    /// @brief Waits until messages pushed so far are written and flushes the sinks of all categories.
+    void flush();
+
+    /// @brief Returns number of messages dropped, because the queue was full.
+    /// @return Number of dropped messages.
+    inline uint64_t get_dropped_count() const { return m_dropped.load(std::memory_order_relaxed); }
+
+   private:
+    LogRecord* try_claim(size_t& position);
+    void publish(size_t position);
+
+    void run();
+    bool write_pending();
+    void write(LogRecord& record);
+
+    template<typename Arguments, bool IS_INLINE>
+    static void format_arguments(LogRecord& record, spdlog::memory_buf_t& buffer)
+    {
+      Arguments* arguments;
+      if constexpr (IS_INLINE) { arguments = std::launder(reinterpret_cast<Arguments*>(record.m_arguments)); }
+      else { arguments = *reinterpret_cast<Arguments**>(record.m_arguments); }
+
+      // arguments are destroyed even if formatting fails
+      struct Release
+      {
+        Arguments* m_arguments;
+        ~Release()
+        {
+          if constexpr (IS_INLINE) { m_arguments->~Arguments(); }
+          else { delete m_arguments; }
+        }
+      } release{ arguments };
+
+      std::apply(
+          [&](auto&... args)
+          {
+            fmt::vformat_to(fmt::appender(buffer),
+                            fmt::string_view(record.m_format.data(), record.m_format.size()),
+                            fmt::make_format_args(args...));
+          },
+          *arguments);
+    }
+  };
+} // namespace esp
+
+#endif // ESPERT_CORE_LOG_QUEUE_HH
@@ -1,3 +1,4 @@
+#include <spdlog/cfg/env.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
 #include "Logger.hh"
@@ -13,25 +14,71 @@ namespace esp
     Logger::s_instance = this;
   }
 
-  Logger::~Logger() { Logger::s_instance = nullptr; }
+  Logger::~Logger()
+  {
+    // the queue writes pending messages first, categories it refers to are released afterwards
+    if (m_queue)
+    {
+      auto dropped = m_queue->get_dropped_count();
+      m_queue.reset();
+      if (dropped > 0) { m_core_logger->warn("{} log messages were dropped, because the queue was full.", dropped); }
+    }
+
+    m_core_logger.reset();
+    m_client_logger.reset();
+    spdlog::shutdown();
+
+    Logger::s_instance = nullptr;
+  }
 
-  std::unique_ptr<Logger> Logger::create()
+  std::unique_ptr<Logger> Logger::create(bool async, size_t queue_size)
   {
     /* create singleton */
     auto logger = std::unique_ptr<Logger>{ new Logger() };
 
-    /* set pattern of messages */
+    /* set pattern of messages and default level, SPDLOG_LEVEL may override levels of categories */
     spdlog::set_pattern("%^[%T][%n]%$ : %v");
+    spdlog::set_level(spdlog::level::trace);
+    spdlog::cfg::load_env_levels();
 
-    /* set multithread logger for trace level */
-    logger->m_core_logger = spdlog::stdout_color_mt("Espert");
-    logger->m_core_logger->set_level(spdlog::level::trace);
+    /* single background thread keeps the order of messages */
+    if (async) { logger->m_queue = std::make_unique<LogQueue>(queue_size); }
+    logger->m_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
 
-    /* set multithread logger for client level */
-    logger->m_client_logger = spdlog::stdout_color_mt("Client");
-    logger->m_client_logger->set_level(spdlog::level::trace);
+    /* set multithread logger for core and client messages */
+    logger->m_core_logger   = create_category("Espert");
+    logger->m_client_logger = create_category("Client");
 
     ESP_CORE_INFO("Logger is created");
     return logger;
   }
+
+  std::shared_ptr<spdlog::logger> Logger::create_category(const std::string& name)
+  {
+    if (auto category = spdlog::get(name)) { return category; }
+
+    // in asynchronous mode messages are passed to the sink by the queue of the instance
+    auto category = std::make_shared<spdlog::logger>(name, s_instance->m_sink);
+
+    // applies the pattern and the level and registers the category
+    spdlog::initialize_logger(category);
+    category->flush_on(spdlog::level::err);
+    return category;
+  }
+
+  void Logger::set_level(const std::string& name, spdlog::level::level_enum level)
+  {
+    if (auto category = spdlog::get(name)) { category->set_level(level); }
+  }
+
+  void Logger::flush()
+  {
+    if (!s_instance) { return; }
+    if (s_instance->m_queue)
+    {
+      s_instance->m_queue->flush();
+      return;
+    }
+    spdlog::apply_all([](std::shared_ptr<spdlog::logger> category) { category->flush(); });
+  }
 } // namespace esp
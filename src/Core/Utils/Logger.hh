@@ -4,24 +4,110 @@
 #include <memory>
 #include <spdlog/spdlog.h>
 
+#include "LogQueue.hh"
+
+/* ################## COMPILE-TIME FILTERING ######################## */
+// messages below the level are compiled out, define it to one of SPDLOG_LEVEL_* to override the default
+#ifndef ESP_LOG_ACTIVE_LEVEL
+#ifdef NDEBUG
+#define ESP_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_OFF
+#else
+#define ESP_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+#endif
+/* ################################################################## */
+
 namespace esp
 {
-  /// @brief Logs messages to the console.
+  /// @brief Logs messages to the console. Every category (core, client and the ones created by create_category())
+  /// has its own level, which can be changed at runtime or with the SPDLOG_LEVEL environment variable, e.g.
+  /// SPDLOG_LEVEL=info,Espert=warn.
+  ///
+  /// In asynchronous mode log() copies the format string and the arguments into a lock-free queue (LogQueue), so the
+  /// calling thread doesn't format the message. A background thread formats it, applies the pattern and writes the line
+  /// to the sink. When the queue is full the message is dropped, so logging never waits for the sink. Messages below
+  /// the level of their category aren't copied at all.
+  ///
+  /// Arguments are copied when the message is logged and strings are copied whole, but views of other data (e.g.
+  /// fmt::join) are formatted later, so that data has to stay valid until flush(). Format strings have to be string
+  /// literals. Methods of the spdlog loggers returned by create_category() write on the calling thread.
   class Logger
   {
+   public:
+    /// @brief Default number of messages the queue of asynchronous mode can hold.
+    static constexpr size_t DEFAULT_QUEUE_SIZE = 8192;
+
    private:
     static Logger* s_instance;
 
    private:
     std::shared_ptr<spdlog::logger> m_core_logger;
     std::shared_ptr<spdlog::logger> m_client_logger;
+    spdlog::sink_ptr m_sink;
+    // null in synchronous mode
+    std::unique_ptr<LogQueue> m_queue;
 
     Logger();
 
    public:
-    /// @brief Destructor destroys instance of Logger.
+    /// @brief Destructor writes pending messages and destroys instance of Logger.
     ~Logger();
-    static std::unique_ptr<Logger> create();
+
+    /// @brief Creates Logger singleton instance.
+    /// @param async True if messages are written by a background thread.
+    /// @param queue_size Number of messages the queue of asynchronous mode can hold.
+    /// @return Unique pointer to Logger instance.
+    static std::unique_ptr<Logger> create(bool async = true, size_t queue_size = DEFAULT_QUEUE_SIZE);
+
+    /// @brief Returns logger of a category, creates it if it doesn't exist. Category loggers share the sink (and the
+    /// queue) of core and client loggers.
+    /// @param name Name of the category.
+    /// @return Logger of the category.
+    static std::shared_ptr<spdlog::logger> create_category(const std::string& name);
+    /// @brief Sets level of a category.
+    /// @param name Name of the category ("Espert" for core, "Client" for client messages).
+    /// @param level The least severe level which is logged.
+    static void set_level(const std::string& name, spdlog::level::level_enum level);
+    /// @brief Makes all categories write messages logged so far. In asynchronous mode it waits until the background
+    /// thread has written them.
+    static void flush();
+
+    /// @brief Logs message of a category. In asynchronous mode the message is formatted by the background thread,
+    /// unless some of the arguments can't be copied. Prefer the ESP_* macros.
+    /// @param category Category of the message.
+    /// @param level Level of the message.
+    /// @param format Format string.
+    /// @param args Arguments of the message.
+    template<typename... Args>
+    static void log(spdlog::logger& category,
+                    spdlog::level::level_enum level,
+                    spdlog::format_string_t<Args...> format,
+                    Args&&... args)
+    {
+      if (!category.should_log(level)) { return; }
+
+      if constexpr (is_log_deferrable_v<Args...>)
+      {
+        if (s_instance && s_instance->m_queue)
+        {
+          fmt::string_view format_view = format;
+          s_instance->m_queue->push(category,
+                                    level,
+                                    std::string_view(format_view.data(), format_view.size()),
+                                    std::forward<Args>(args)...);
+          return;
+        }
+      }
+      category.log(level, format, std::forward<Args>(args)...);
+    }
+    /// @brief Same as above, but the message is a single value, e.g. a string which isn't a literal.
+    /// @param category Category of the message.
+    /// @param level Level of the message.
+    /// @param message Value logged as the message.
+    template<typename T> static void log(spdlog::logger& category, spdlog::level::level_enum level, const T& message)
+    {
+      log(category, level, "{}", message);
+    }
 
     /// @brief Returns instance of Logger.
     /// @return Instance of Logger.
@@ -37,34 +123,44 @@ namespace esp
 } // namespace esp
 
 /* ################## LOGGER MACROS ################################# */
-#ifdef NDEBUG
-/* FOR CORE */
+#if ESP_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#define ESP_CORE_TRACE(...) esp::Logger::log(*esp::Logger::get_core_logger(), spdlog::level::trace, __VA_ARGS__)
+#define ESP_TRACE(...)      esp::Logger::log(*esp::Logger::get_client_logger(), spdlog::level::trace, __VA_ARGS__)
+#else
 #define ESP_CORE_TRACE(...)
-#define ESP_CORE_INFO(...)
-#define ESP_CORE_WARN(...)
-#define ESP_CORE_ERROR(...)
-#define ESP_CORE_CRITICAL(...)
-
-/* FOR CLIENT */
 #define ESP_TRACE(...)
+#endif
+
+#if ESP_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+#define ESP_CORE_INFO(...) esp::Logger::log(*esp::Logger::get_core_logger(), spdlog::level::info, __VA_ARGS__)
+#define ESP_INFO(...)      esp::Logger::log(*esp::Logger::get_client_logger(), spdlog::level::info, __VA_ARGS__)
+#else
+#define ESP_CORE_INFO(...)
 #define ESP_INFO(...)
+#endif
+
+#if ESP_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_WARN
+#define ESP_CORE_WARN(...) esp::Logger::log(*esp::Logger::get_core_logger(), spdlog::level::warn, __VA_ARGS__)
+#define ESP_WARN(...)      esp::Logger::log(*esp::Logger::get_client_logger(), spdlog::level::warn, __VA_ARGS__)
+#else
+#define ESP_CORE_WARN(...)
 #define ESP_WARN(...)
+#endif
+
+#if ESP_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_ERROR
+#define ESP_CORE_ERROR(...) esp::Logger::log(*esp::Logger::get_core_logger(), spdlog::level::err, __VA_ARGS__)
+#define ESP_ERROR(...)      esp::Logger::log(*esp::Logger::get_client_logger(), spdlog::level::err, __VA_ARGS__)
+#else
+#define ESP_CORE_ERROR(...)
 #define ESP_ERROR(...)
-#define ESP_CRITICAL(...)
+#endif
+
+#if ESP_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_CRITICAL
+#define ESP_CORE_CRITICAL(...) esp::Logger::log(*esp::Logger::get_core_logger(), spdlog::level::critical, __VA_ARGS__)
+#define ESP_CRITICAL(...)      esp::Logger::log(*esp::Logger::get_client_logger(), spdlog::level::critical, __VA_ARGS__)
 #else
-/* FOR CORE */
-#define ESP_CORE_TRACE(...)    esp::Logger::get_core_logger()->trace(__VA_ARGS__)
-#define ESP_CORE_INFO(...)     esp::Logger::get_core_logger()->info(__VA_ARGS__)
-#define ESP_CORE_WARN(...)     esp::Logger::get_core_logger()->warn(__VA_ARGS__)
-#define ESP_CORE_ERROR(...)    esp::Logger::get_core_logger()->error(__VA_ARGS__)
-#define ESP_CORE_CRITICAL(...) esp::Logger::get_core_logger()->critical(__VA_ARGS__)
-
-/* FOR CLIENT */
-#define ESP_TRACE(...)         esp::Logger::get_client_logger()->trace(__VA_ARGS__)
-#define ESP_INFO(...)          esp::Logger::get_client_logger()->info(__VA_ARGS__)
-#define ESP_WARN(...)          esp::Logger::get_client_logger()->warn(__VA_ARGS__)
-#define ESP_ERROR(...)         esp::Logger::get_client_logger()->error(__VA_ARGS__)
-#define ESP_CRITICAL(...)      esp::Logger::get_client_logger()->critical(__VA_ARGS__)
+#define ESP_CORE_CRITICAL(...)
+#define ESP_CRITICAL(...)
 #endif
 
 #endif // ESPERT_CORE_LOGGER_HH
@@ -0,0 +1,311 @@
+#include "Profiler.hh"
+#include "Logger.hh"
+
+// std
+#include <iomanip>
+
+// signatures
+static std::string escape_json(const char* text);
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  void FrameTimeHistogram::add(double frame_time)
+  {
+    auto bucket = static_cast<uint32_t>(std::max(frame_time, 0.0) / BUCKET_WIDTH);
+    m_buckets[std::min(bucket, BUCKET_COUNT - 1)]++;
+
+    m_min = m_frame_count == 0 ? frame_time : std::min(m_min, frame_time);
+    m_max = m_frame_count == 0 ? frame_time : std::max(m_max, frame_time);
+    m_total += frame_time;
+    m_frame_count++;
+  }
+
+  double FrameTimeHistogram::get_mean() const { return m_frame_count == 0 ? 0.0 : m_total / m_frame_count; }
+
+  double FrameTimeHistogram::get_percentile(double percentile) const
+  {
+    if (m_frame_count == 0) { return 0.0; }
+
+    auto frames    = static_cast<uint64_t>(std::ceil(std::clamp(percentile, 0.0, 1.0) * m_frame_count));
+    uint64_t count = 0;
+    for (uint32_t i = 0; i < BUCKET_COUNT - 1; i++)
+    {
+      count += m_buckets[i];
+      if (count >= std::max<uint64_t>(frames, 1)) { return std::min((i + 1) * BUCKET_WIDTH, m_max); }
+    }
+    return m_max;
+  }
+
+  std::atomic<Profiler*> Profiler::s_instance = nullptr;
+  std::mutex Profiler::s_threads_mutex;
+  std::vector<std::shared_ptr<Profiler::ThreadBuffer>> Profiler::s_threads;
+  thread_local Profiler::ThreadBuffer* Profiler::s_thread_buffer = nullptr;
+  thread_local std::string Profiler::s_thread_name;
+
+  Profiler::Profiler() : m_origin{ Clock::now() }
+  {
+    if (Profiler::s_instance != nullptr) { throw std::runtime_error("The profiler instance already exists!"); }
+
+    // zones left in the buffers by a previous instance would be measured from a different origin
+    {
+      std::lock_guard<std::mutex> lock(s_threads_mutex);
+      for (auto& thread : s_threads)
+      {
+        thread->m_tail.store(thread->m_head.load(std::memory_order_acquire), std::memory_order_release);
+        thread->m_dropped = 0;
+      }
+    }
+
+    Profiler::s_instance = this;
+  }
+
+  Profiler::~Profiler()
+  {
+    if (s_instance == this) { s_instance = nullptr; }
+  }
+
+  std::unique_ptr<Profiler> Profiler::create(const std::filesystem::path& trace_path,
+                                             const std::filesystem::path& histogram_path)
+  {
+    auto profiler              = std::unique_ptr<Profiler>(new Profiler());
+    profiler->m_histogram_path = histogram_path;
+
+    if (!trace_path.empty())
+    {
+      profiler->m_trace.open(trace_path, std::ios::out | std::ios::trunc);
+      if (profiler->m_trace)
+      {
+        profiler->m_trace << "{\"traceEvents\":[\n";
+        profiler->m_trace << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"CPU\"}}";
+      }
+      else { ESP_CORE_ERROR("Cannot open CPU trace file {}.", trace_path.string()); }
+    }
+
+    ESP_CORE_TRACE("Profiler initialized.");
+    return profiler;
+  }
+
+  void Profiler::terminate()
+  {
+    if (s_instance != this) { return; }
+    s_instance = nullptr;
+
+    collect();
+
+    uint64_t dropped = 0;
+    {
+      std::lock_guard<std::mutex> lock(s_threads_mutex);
+      for (auto& thread : s_threads)
+      {
+        dropped += thread->m_dropped.load();
+      }
+    }
+    if (dropped > 0)
+    {
+      ESP_CORE_WARN("Profiler dropped {} zones, end_frame() wasn't called often enough to collect them.", dropped);
+    }
+
+    if (m_trace.is_open()) { m_trace << "\n]}\n"; }
+    m_trace.close();
+
+    if (!m_histogram_path.empty()) { save_histogram(m_histogram_path); }
+
+    ESP_CORE_INFO("Frame times of {} frames: mean {:.2f} ms, p50 {:.1f} ms, p95 {:.1f} ms, p99 {:.1f} ms, max {:.2f} "
+                  "ms.",
+                  m_histogram.m_frame_count,
+                  m_histogram.get_mean(),
+                  m_histogram.get_percentile(0.5),
+                  m_histogram.get_percentile(0.95),
+                  m_histogram.get_percentile(0.99),
+                  m_histogram.m_max);
+    ESP_CORE_TRACE("Profiler shutdown.");
+  }
+
+  void Profiler::begin_zone(const char* name)
+  {
+    if (!s_instance.load(std::memory_order_relaxed)) { return; }
+
+    auto& buffer = get_thread_buffer();
+    if (buffer.m_depth < MAX_DEPTH) { buffer.m_open_zones[buffer.m_depth] = { name, now() }; }
+    buffer.m_depth++;
+  }
+
+  void Profiler::end_zone()
+  {
+    // zones begun before the profiler was created weren't pushed
+    auto* buffer = s_thread_buffer;
+    if (!buffer || buffer->m_depth == 0) { return; }
+
+    uint32_t depth = --buffer->m_depth;
+    if (depth >= MAX_DEPTH || !s_instance.load(std::memory_order_relaxed)) { return; }
+
+    auto head = buffer->m_head.load(std::memory_order_relaxed);
+    if (head - buffer->m_tail.load(std::memory_order_acquire) == RING_CAPACITY)
+    {
+      buffer->m_dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    auto& open_zone                      = buffer->m_open_zones[depth];
+    buffer->m_ring[head % RING_CAPACITY] = { open_zone.m_name, buffer->m_index, depth, open_zone.m_begin, now() };
+    buffer->m_head.store(head + 1, std::memory_order_release);
+  }
+
+  void Profiler::set_thread_name(const std::string& name)
+  {
+    s_thread_name = name;
+    if (!s_thread_buffer) { return; }
+
+    std::lock_guard<std::mutex> lock(s_threads_mutex);
+    s_thread_buffer->m_name = name;
+  }
+
+  void Profiler::end_frame()
+  {
+    auto* profiler = s_instance.load();
+    if (!profiler) { return; }
+
+    auto frame_end = now();
+    if (profiler->m_last_frame_end >= 0) { profiler->m_histogram.add((frame_end - profiler->m_last_frame_end) / 1e6); }
+    profiler->m_last_frame_end = frame_end;
+
+    profiler->collect();
+  }
+
+  std::vector<ProfilerZone> Profiler::get_frame_zones()
+  {
+    auto* profiler = s_instance.load();
+    if (!profiler) { return {}; }
+
+    return profiler->m_frame_zones;
+  }
+
+  FrameTimeHistogram Profiler::get_frame_time_histogram()
+  {
+    auto* profiler = s_instance.load();
+    if (!profiler) { return {}; }
+
+    return profiler->m_histogram;
+  }
+
+  void Profiler::write_histogram(const std::filesystem::path& path)
+  {
+    auto* profiler = s_instance.load();
+    if (!profiler) { return; }
+
+    profiler->save_histogram(path);
+  }
+
+  Profiler::ThreadBuffer& Profiler::get_thread_buffer()
+  {
+    if (s_thread_buffer) { return *s_thread_buffer; }
+
+    // first zone of the thread, the only time recording takes a lock
+    auto buffer = std::make_shared<ThreadBuffer>();
+    buffer->m_ring.resize(RING_CAPACITY);
+
+    std::lock_guard<std::mutex> lock(s_threads_mutex);
+    buffer->m_index = static_cast<uint32_t>(s_threads.size());
+    buffer->m_name  = s_thread_name.empty() ? "Thread " + std::to_string(buffer->m_index) : s_thread_name;
+    s_threads.push_back(buffer);
+
+    s_thread_buffer = buffer.get();
+    return *s_thread_buffer;
+  }
+
+  int64_t Profiler::now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+  }
+
+  void Profiler::collect()
+  {
+    auto origin = std::chrono::duration_cast<std::chrono::nanoseconds>(m_origin.time_since_epoch()).count();
+
+    m_frame_zones.clear();
+    {
+      std::lock_guard<std::mutex> lock(s_threads_mutex);
+      for (auto& thread : s_threads)
+      {
+        auto tail = thread->m_tail.load(std::memory_order_relaxed);
+        auto head = thread->m_head.load(std::memory_order_acquire);
+        for (; tail != head; tail++)
+        {
+          auto zone = thread->m_ring[tail % RING_CAPACITY];
+          zone.m_begin -= origin;
+          zone.m_end -= origin;
+          m_frame_zones.push_back(zone);
+        }
+        thread->m_tail.store(tail, std::memory_order_release);
+      }
+
+      if (m_trace.is_open())
+      {
+        for (; m_traced_threads < s_threads.size(); m_traced_threads++)
+        {
+          m_trace << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << m_traced_threads
+                  << ",\"args\":{\"name\":\"" << escape_json(s_threads[m_traced_threads]->m_name.c_str()) << "\"}}";
+        }
+      }
+    }
+
+    std::sort(m_frame_zones.begin(),
+              m_frame_zones.end(),
+              [](const ProfilerZone& a, const ProfilerZone& b) { return a.m_begin < b.m_begin; });
+
+    if (m_trace.is_open()) { write_trace(m_frame_zones); }
+  }
+
+  void Profiler::write_trace(const std::vector<ProfilerZone>& zones)
+  {
+    // timestamps are in microseconds since the profiler was created
+    m_trace << std::fixed << std::setprecision(3);
+    for (auto& zone : zones)
+    {
+      m_trace << ",\n{\"name\":\"" << escape_json(zone.m_name) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << zone.m_thread
+              << ",\"ts\":" << zone.m_begin / 1e3 << ",\"dur\":" << (zone.m_end - zone.m_begin) / 1e3 << "}";
+    }
+  }
+
+  void Profiler::save_histogram(const std::filesystem::path& path) const
+  {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file)
+    {
+      ESP_CORE_ERROR("Cannot open frame time histogram file {}.", path.string());
+      return;
+    }
+
+    // the last bucket ends with the longest frame
+    file << "begin_ms,end_ms,frames\n";
+    for (uint32_t i = 0; i < FrameTimeHistogram::BUCKET_COUNT; i++)
+    {
+      if (m_histogram.m_buckets[i] == 0) { continue; }
+
+      bool last = i == FrameTimeHistogram::BUCKET_COUNT - 1;
+      file << i * FrameTimeHistogram::BUCKET_WIDTH << ","
+           << (last ? m_histogram.m_max : (i + 1) * FrameTimeHistogram::BUCKET_WIDTH) << "," << m_histogram.m_buckets[i]
+           << "\n";
+    }
+  }
+} // namespace esp
+
+/* --------------------------------------------------------- */
+/* ------------------ HELPFUL FUNCTIONS -------------------- */
+/* --------------------------------------------------------- */
+
+static std::string escape_json(const char* text)
+{
+  std::string escaped;
+  for (; *text; text++)
+  {
+    if (*text == '"' || *text == '\\') { escaped.push_back('\\'); }
+    if (static_cast<unsigned char>(*text) < 0x20) { continue; }
+    escaped.push_back(*text);
+  }
+  return escaped;
+}
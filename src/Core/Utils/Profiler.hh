@@ -0,0 +1,215 @@
+#ifndef ESPERT_CORE_PROFILER_HH
+#define ESPERT_CORE_PROFILER_HH
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Utils.hh"
+
+/* ################## PROFILER MACROS ################################ */
+// zones are compiled out in release, unless the build enables them explicitly (ESP_PROFILING CMake option)
+#ifndef ESP_PROFILING
+#ifdef NDEBUG
+#define ESP_PROFILING 0
+#else
+#define ESP_PROFILING 1
+#endif
+#endif
+
+#define ESP_PROFILE_CONCAT_IMPL(a, b) a##b
+#define ESP_PROFILE_CONCAT(a, b)      ESP_PROFILE_CONCAT_IMPL(a, b)
+
+#if ESP_PROFILING
+/// Measures the rest of the enclosing scope. Name has to be a string literal.
+#define ESP_PROFILE_SCOPE(name)    esp::ProfilerScope ESP_PROFILE_CONCAT(esp_profile_scope_, __LINE__)(name)
+#define ESP_PROFILE_FUNCTION()     ESP_PROFILE_SCOPE(__FUNCTION__)
+#define ESP_PROFILE_THREAD(name)   esp::Profiler::set_thread_name(name)
+#else
+#define ESP_PROFILE_SCOPE(name)    ((void)0)
+#define ESP_PROFILE_FUNCTION()     ((void)0)
+#define ESP_PROFILE_THREAD(name)   ((void)0)
+#endif
+/* ################################################################## */
+
+namespace esp
+{
+  /// @brief Measured CPU zone.
+  struct ProfilerZone
+  {
+    /// @brief Name of the zone. Points to a string literal.
+    const char* m_name = nullptr;
+    /// @brief Index of the thread the zone was measured on, in order threads were first seen by the profiler.
+    uint32_t m_thread = 0;
+    /// @brief Number of zones the zone is nested in.
+    uint32_t m_depth = 0;
+    /// @brief Beginning of the zone in nanoseconds since the profiler was created.
+    int64_t m_begin = 0;
+    /// @brief End of the zone in nanoseconds since the profiler was created.
+    int64_t m_end = 0;
+  };
+
+  /// @brief Distribution of frame times in buckets of BUCKET_WIDTH milliseconds.
+  struct FrameTimeHistogram
+  {
+    /// @brief Width of a bucket in milliseconds.
+    static constexpr double BUCKET_WIDTH = 0.5;
+    /// @brief Number of buckets. The last one counts all frames longer than the others cover.
+    static constexpr uint32_t BUCKET_COUNT = 201;
+
+    /// @brief Number of frames in every bucket.
+    std::array<uint64_t, BUCKET_COUNT> m_buckets = {};
+    /// @brief Number of measured frames.
+    uint64_t m_frame_count = 0;
+    /// @brief Shortest frame time in milliseconds.
+    double m_min = 0.0;
+    /// @brief Longest frame time in milliseconds.
+    double m_max = 0.0;
+    /// @brief Sum of all frame times in milliseconds.
+    double m_total = 0.0;
+
+    /// @brief Adds frame to the histogram.
+    /// @param frame_time Frame time in milliseconds.
+    void add(double frame_time);
+    /// @brief Returns mean frame time.
+    /// @return Mean frame time in milliseconds. 0 if there are no frames.
+    double get_mean() const;
+    /// @brief Returns frame time not exceeded by given share of frames, e.g. 0.99 for the 99th percentile. It is the
+    /// upper edge of the bucket, so it's accurate to BUCKET_WIDTH.
+    /// @param percentile Share of frames between 0 and 1.
+    /// @return Frame time in milliseconds. 0 if there are no frames.
+    double get_percentile(double percentile) const;
+  };
+
+  /// @brief Measures CPU zones of every thread and frame times. Zones are written by their threads into own
+  /// single-producer single-consumer ring buffers without locking, and are collected at the end of every frame by the
+  /// thread calling end_frame(). Collected zones can be written to a Chrome trace file (chrome://tracing, Perfetto).
+  /// Zones which don't fit into the ring buffer before they are collected are dropped.
+  ///
+  /// Zones are measured with ESP_PROFILE_SCOPE() and only when the instance exists. The frame time histogram is kept
+  /// in every build, zone macros are compiled out in release unless ESP_PROFILING is defined.
+  class Profiler
+  {
+   public:
+    /// @brief Number of zones a thread can write between two collections.
+    static constexpr uint32_t RING_CAPACITY = 1 << 14;
+    /// @brief Maximal depth of nested zones. Deeper zones aren't measured.
+    static constexpr uint32_t MAX_DEPTH = 64;
+
+   private:
+    using Clock = std::chrono::steady_clock;
+
+    struct OpenZone
+    {
+      const char* m_name;
+      int64_t m_begin;
+    };
+
+    struct ThreadBuffer
+    {
+      uint32_t m_index;
+      std::string m_name;
+
+      // written only by the owning thread
+      std::vector<ProfilerZone> m_ring;
+      std::array<OpenZone, MAX_DEPTH> m_open_zones;
+      uint32_t m_depth = 0;
+
+      std::atomic<uint64_t> m_head    = 0;
+      std::atomic<uint64_t> m_tail    = 0;
+      std::atomic<uint64_t> m_dropped = 0;
+    };
+
+    static std::atomic<Profiler*> s_instance;
+
+    // thread buffers outlive both their threads and the profiler, so zones are never written into freed memory
+    static std::mutex s_threads_mutex;
+    static std::vector<std::shared_ptr<ThreadBuffer>> s_threads;
+    static thread_local ThreadBuffer* s_thread_buffer;
+    static thread_local std::string s_thread_name;
+
+    Clock::time_point m_origin;
+    int64_t m_last_frame_end = -1;
+
+    FrameTimeHistogram m_histogram;
+    std::vector<ProfilerZone> m_frame_zones;
+
+    std::ofstream m_trace;
+    uint32_t m_traced_threads = 0;
+    std::filesystem::path m_histogram_path;
+
+    Profiler();
+
+   public:
+    /// @brief Terminates Profiler.
+    ~Profiler();
+
+    PREVENT_COPY(Profiler);
+
+    /// @brief Creates Profiler singleton instance.
+    /// @param trace_path File the zones are written to, in Chrome trace format. Empty path disables the file.
+    /// @param histogram_path File the frame time histogram is written to on terminate, as CSV. Empty path disables
+    /// the file.
+    /// @return Unique pointer to Profiler instance.
+    static std::unique_ptr<Profiler> create(const std::filesystem::path& trace_path     = {},
+                                            const std::filesystem::path& histogram_path = {});
+
+    /// @brief Collects remaining zones, writes the histogram and closes the trace file. Zones begun by other threads
+    /// afterwards aren't measured.
+    void terminate();
+
+    /// @brief Begins zone on the calling thread. Prefer ESP_PROFILE_SCOPE().
+    /// @param name Name of the zone. Has to outlive the profiler, e.g. a string literal.
+    static void begin_zone(const char* name);
+    /// @brief Ends zone begun last on the calling thread.
+    static void end_zone();
+    /// @brief Names the calling thread in the trace. Its buffer is allocated with the first zone, so naming threads
+    /// is cheap when nothing is measured.
+    /// @param name Name of the thread.
+    static void set_thread_name(const std::string& name);
+
+    /// @brief Measures the frame time and collects zones of all threads. Has to be called once per frame by the
+    /// same thread.
+    static void end_frame();
+
+    /// @brief Returns zones collected by the last end_frame().
+    /// @return Zones collected by the last end_frame(), sorted by their beginning. Empty if there is no instance.
+    static std::vector<ProfilerZone> get_frame_zones();
+    /// @brief Returns histogram of frame times measured by end_frame().
+    /// @return Histogram of frame times. Empty if there is no instance.
+    static FrameTimeHistogram get_frame_time_histogram();
+    /// @brief Writes histogram of frame times as CSV with a row per non-empty bucket.
+    /// @param path Path of the file.
+    static void write_histogram(const std::filesystem::path& path);
+
+   private:
+    static ThreadBuffer& get_thread_buffer();
+    static int64_t now();
+
+    void collect();
+    void write_trace(const std::vector<ProfilerZone>& zones);
+    void save_histogram(const std::filesystem::path& path) const;
+  };
+
+  /// @brief Measures zone from its construction to its destruction.
+  class ProfilerScope
+  {
+   public:
+    /// @brief Begins zone.
+    /// @param name Name of the zone. Has to outlive the profiler, e.g. a string literal.
+    inline explicit ProfilerScope(const char* name) { Profiler::begin_zone(name); }
+    /// @brief Ends zone.
+    inline ~ProfilerScope() { Profiler::end_zone(); }
+
+    PREVENT_COPY(ProfilerScope);
+  };
+} // namespace esp
+
+#endif // ESPERT_CORE_PROFILER_HH
@@ -23,9 +23,8 @@
   }
 #endif
 
-#define ESP_MIN_FRAME_RATE 0.01666666666f // = 1/60s
-#define ESP_PI             3.14159265f    // = PI
-#define ESP_EPSILON        0.0001f
+#define ESP_PI      3.14159265f // = PI
+#define ESP_EPSILON 0.0001f
 
 #include <functional>
 #include <glm/glm.hpp>
@@ -18,10 +18,13 @@
 
 /* --------- Render API --------------------- */
 #include "Core/RenderAPI/RenderPlans/EspCommandBuffer.hh"
+#include "Core/RenderAPI/RenderPlans/EspRenderGraph.hh"
 #include "Core/RenderAPI/RenderPlans/EspRenderPlan.hh"
 #include "Core/RenderAPI/Resources/EspIndexBuffer.hh"
+#include "Core/RenderAPI/Resources/EspStorageBuffer.hh"
 #include "Core/RenderAPI/Resources/EspVertexBuffer.hh"
 #include "Core/RenderAPI/Uniforms/EspUniformMetaData.hh"
+#include "Core/RenderAPI/Worker/EspComputeWorker.hh"
 #include "Core/RenderAPI/Worker/EspWorker.hh"
 #include "Core/RenderAPI/Worker/EspWorkerBuilder.hh"
 
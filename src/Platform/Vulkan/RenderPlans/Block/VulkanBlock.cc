@@ -1,4 +1,5 @@
 #include "VulkanBlock.hh"
+#include "Core/RenderAPI/Work/EspDeletionQueue.hh"
 #include "Platform/Vulkan/Resources/VulkanTexture.hh"
 #include "Platform/Vulkan/VulkanDevice.hh"
 #include "Platform/Vulkan/VulkanResourceManager.hh"
@@ -10,10 +11,15 @@ namespace esp
 {
   void VulkanBlock::VulkanBlockBuffer::terminate()
   {
-    vkDestroyImageView(VulkanDevice::get_logical_device(), m_image_view, nullptr);
+    // frames in flight may still render to the image
+    EspDeletionQueue::defer(
+        [image_view = m_image_view, image = m_image, memory = m_image_memory]()
+        {
+          vkDestroyImageView(VulkanDevice::get_logical_device(), image_view, nullptr);
 
-    vkDestroyImage(VulkanDevice::get_logical_device(), m_image, nullptr);
-    vkFreeMemory(VulkanDevice::get_logical_device(), m_image_memory, nullptr);
+          vkDestroyImage(VulkanDevice::get_logical_device(), image, nullptr);
+          vkFreeMemory(VulkanDevice::get_logical_device(), memory, nullptr);
+        });
   }
 } // namespace esp
 
@@ -77,6 +83,21 @@ namespace esp
     }
   }
 
+  VulkanBlock::VulkanBlock(EspBlockFormat format,
+                           uint32_t width,
+                           uint32_t height,
+                           glm::vec3 clear_color,
+                           VkImage image) :
+      EspBlock{ format, EspSampleCountFlag::ESP_SAMPLE_COUNT_1_BIT, width, height, clear_color }
+  {
+    // freeing VK_NULL_HANDLE memory in terminate() does nothing
+    m_buffer.m_image        = image;
+    m_buffer.m_image_memory = VK_NULL_HANDLE;
+    m_buffer.m_image_view =
+        VulkanResourceManager::create_image_view(image, static_cast<VkFormat>(m_format), VK_IMAGE_ASPECT_COLOR_BIT, 1);
+    m_buffer_exist = true;
+  }
+
   std::shared_ptr<EspTexture> VulkanBlock::use_as_texture() const
   {
     return std::shared_ptr<EspTexture>{ VulkanTexture::create_from_block(this).release() };
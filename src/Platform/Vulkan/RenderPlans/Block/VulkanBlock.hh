@@ -37,6 +37,9 @@ namespace esp
                 uint32_t width,
                 uint32_t height,
                 glm::vec3 clear_color);
+    /// @brief Creates single sampled block of an image bound to memory owned by someone else (transient blocks of
+    /// EspRenderGraph). The block destroys only the image and its view.
+    VulkanBlock(EspBlockFormat format, uint32_t width, uint32_t height, glm::vec3 clear_color, VkImage image);
     virtual ~VulkanBlock();
 
     VulkanBlock(const VulkanBlock&)            = delete;
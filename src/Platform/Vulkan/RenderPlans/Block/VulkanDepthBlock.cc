@@ -1,5 +1,6 @@
 #include "VulkanDepthBlock.hh"
 
+#include "Core/RenderAPI/Work/EspDeletionQueue.hh"
 #include "Platform/Vulkan/VulkanDevice.hh"
 #include "Platform/Vulkan/VulkanResourceManager.hh"
 
@@ -7,10 +8,15 @@ namespace esp
 {
   void VulkanDepthBlock::VulkanDepthBlockBuffer::terminate()
   {
-    vkDestroyImageView(VulkanDevice::get_logical_device(), m_image_view, nullptr);
+    // frames in flight may still render to the image
+    EspDeletionQueue::defer(
+        [image_view = m_image_view, image = m_image, memory = m_image_memory]()
+        {
+          vkDestroyImageView(VulkanDevice::get_logical_device(), image_view, nullptr);
 
-    vkDestroyImage(VulkanDevice::get_logical_device(), m_image, nullptr);
-    vkFreeMemory(VulkanDevice::get_logical_device(), m_image_memory, nullptr);
+          vkDestroyImage(VulkanDevice::get_logical_device(), image, nullptr);
+          vkFreeMemory(VulkanDevice::get_logical_device(), memory, nullptr);
+        });
   }
 } // namespace esp
 
@@ -68,6 +74,22 @@ namespace esp
     m_need_layout_transition = true;
   }
 
+  VulkanDepthBlock::VulkanDepthBlock(EspDepthBlockFormat format,
+                                     EspImageUsageFlag image_usage_flag,
+                                     uint32_t width,
+                                     uint32_t height,
+                                     VkImage image) :
+      EspDepthBlock(format, EspSampleCountFlag::ESP_SAMPLE_COUNT_1_BIT, image_usage_flag, width, height)
+  {
+    // freeing VK_NULL_HANDLE memory in terminate() does nothing
+    m_buffer.m_image        = image;
+    m_buffer.m_image_memory = VK_NULL_HANDLE;
+    m_buffer.m_image_view =
+        VulkanResourceManager::create_image_view(image, static_cast<VkFormat>(m_format), VK_IMAGE_ASPECT_DEPTH_BIT, 1);
+
+    m_need_layout_transition = true;
+  }
+
   VulkanDepthBlock::~VulkanDepthBlock()
   {
     m_buffer.terminate();
@@ -35,6 +35,13 @@ namespace esp
                      EspImageUsageFlag image_usage_flag,
                      uint32_t width,
                      uint32_t height);
+    /// @brief Creates single sampled depth block of an image bound to memory owned by someone else (transient blocks
+    /// of EspRenderGraph). The block destroys only the image and its view.
+    VulkanDepthBlock(EspDepthBlockFormat format,
+                     EspImageUsageFlag image_usage_flag,
+                     uint32_t width,
+                     uint32_t height,
+                     VkImage image);
     virtual ~VulkanDepthBlock();
 
     VulkanDepthBlock(const VulkanDepthBlock&)            = delete;
@@ -11,8 +11,13 @@ namespace esp
   {
    public:
     VkCommandBuffer m_command_buffer;
+    // buffer is submitted to a queue without graphics support, so graphics stages can't be used
+    bool m_compute_only;
 
-    VulkanCommandBufferId(VkCommandBuffer command_buffer) : m_command_buffer{ command_buffer } {}
+    VulkanCommandBufferId(VkCommandBuffer command_buffer, bool compute_only = false) :
+        m_command_buffer{ command_buffer }, m_compute_only{ compute_only }
+    {
+    }
   };
 } // namespace esp
 
@@ -1,5 +1,7 @@
 #include "VulkanFinalRenderPlan.hh"
 
+#include "Core/RenderAPI/Work/EspDeletionQueue.hh"
+#include "Core/RenderAPI/Work/EspGpuProfiler.hh"
 #include "Platform/Vulkan/Work/VulkanSwapChain.hh"
 #include "Platform/Vulkan/Work/VulkanWorkOrchestrator.hh"
 
@@ -7,16 +9,24 @@ namespace esp
 {
   void VulkanFinalRenderPlan::VulkanColorBuffer::terminate()
   {
-    vkDestroyImageView(VulkanDevice::get_logical_device(), m_image_view, nullptr);
+    // frames in flight may still render to the image
+    EspDeletionQueue::defer(
+        [image_view = m_image_view, image = m_image, memory = m_image_memory]()
+        {
+          vkDestroyImageView(VulkanDevice::get_logical_device(), image_view, nullptr);
 
-    vkDestroyImage(VulkanDevice::get_logical_device(), m_image, nullptr);
-    vkFreeMemory(VulkanDevice::get_logical_device(), m_image_memory, nullptr);
+          vkDestroyImage(VulkanDevice::get_logical_device(), image, nullptr);
+          vkFreeMemory(VulkanDevice::get_logical_device(), memory, nullptr);
+        });
   }
 } // namespace esp
 
 namespace esp
 {
-  VulkanFinalRenderPlan::VulkanFinalRenderPlan(glm::vec3 clear_color) : m_clear_color{ clear_color } {}
+  VulkanFinalRenderPlan::VulkanFinalRenderPlan(glm::vec3 clear_color) : m_clear_color{ clear_color }
+  {
+    m_name = "Final render plan";
+  }
 
   VulkanFinalRenderPlan::~VulkanFinalRenderPlan()
   {
@@ -47,6 +57,7 @@ namespace esp
                                                                            1);
 
     m_color_buffer.is_enable = true;
+    m_sample_count           = static_cast<VkSampleCountFlagBits>(sample_count_flag);
   }
 
   void VulkanFinalRenderPlan::add_depth_block(std::shared_ptr<EspDepthBlock> depth_block)
@@ -59,10 +70,27 @@ namespace esp
     auto [width, height] = VulkanWorkOrchestrator::get_swap_chain_extent();
     m_width              = width;
     m_height             = height;
+
+    // info inherited by secondary command buffers
+    m_color_format = *(VulkanSwapChain::get_swap_chain_image_format());
+
+    m_inheritance_rendering_info       = {};
+    m_inheritance_rendering_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR;
+
+    m_inheritance_rendering_info.colorAttachmentCount    = 1;
+    m_inheritance_rendering_info.pColorAttachmentFormats = &m_color_format;
+    m_inheritance_rendering_info.rasterizationSamples    = m_sample_count;
+
+    if (m_depth_block)
+    {
+      m_inheritance_rendering_info.depthAttachmentFormat = static_cast<VkFormat>(m_depth_block->get_format());
+    }
   }
 
   void VulkanFinalRenderPlan::begin_plan()
   {
+    EspGpuProfiler::begin_scope(m_name);
+
     // transition color and depth images for drawing
     {
       // color attachement
@@ -163,6 +191,8 @@ namespace esp
       rendering_info.pStencilAttachment = VK_NULL_HANDLE;
     }
 
+    if (m_secondary_contents) { rendering_info.flags = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT; }
+
     VulkanWorkOrchestrator::begin_rendering(&rendering_info);
 
     // start recording commands (vkCmd).....
@@ -174,6 +204,30 @@ namespace esp
 
     VulkanWorkOrchestrator::end_rendering();
 
+    // offscreen target is copied to host memory instead of being presented
+    if (VulkanSwapChain::is_headless())
+    {
+      VulkanWorkOrchestrator::insert_image_memory_barrier_to_current_cmdbuffer(
+          VulkanSwapChain::get_current_image(),
+          VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+          VK_ACCESS_TRANSFER_READ_BIT,
+          VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+          VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+          VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+          VK_PIPELINE_STAGE_TRANSFER_BIT,
+          {
+              .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+              .baseMipLevel   = 0,
+              .levelCount     = 1,
+              .baseArrayLayer = 0,
+              .layerCount     = 1,
+          });
+
+      VulkanWorkOrchestrator::read_back_current_image();
+      EspGpuProfiler::end_scope();
+      return;
+    }
+
     // transition color image to presentation
     VulkanWorkOrchestrator::insert_image_memory_barrier_to_current_cmdbuffer(
         VulkanSwapChain::get_current_image(),
@@ -190,5 +244,18 @@ namespace esp
             .baseArrayLayer = 0,
             .layerCount     = 1,
         });
+
+    EspGpuProfiler::end_scope();
+  }
+
+  EspCommandBufferId* VulkanFinalRenderPlan::begin_secondary()
+  {
+    return VulkanWorkOrchestrator::begin_secondary_command_buffer(m_inheritance_rendering_info);
+  }
+
+  void VulkanFinalRenderPlan::execute_secondaries(const std::vector<EspCommandBufferId*>& ids)
+  {
+    VulkanWorkOrchestrator::execute_secondary_command_buffers(VulkanWorkOrchestrator::get_current_command_buffer(),
+                                                              ids);
   }
 } // namespace esp
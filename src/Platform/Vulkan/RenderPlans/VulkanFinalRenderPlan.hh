@@ -35,6 +35,10 @@ namespace esp
     uint32_t m_height;
     uint32_t m_width;
 
+    VkFormat m_color_format;
+    VkSampleCountFlagBits m_sample_count = VK_SAMPLE_COUNT_1_BIT;
+    VkCommandBufferInheritanceRenderingInfoKHR m_inheritance_rendering_info;
+
     const glm::vec3 m_clear_color;
     std::shared_ptr<VulkanDepthBlock> m_depth_block = nullptr;
 
@@ -56,6 +60,9 @@ namespace esp
 
     virtual void begin_plan() override;
     virtual void end_plan() override;
+
+    virtual EspCommandBufferId* begin_secondary() override;
+    virtual void execute_secondaries(const std::vector<EspCommandBufferId*>& ids) override;
   };
 } // namespace esp
 
@@ -0,0 +1,237 @@
+#include "VulkanRenderGraph.hh"
+
+#include "Core/RenderAPI/Work/EspDeletionQueue.hh"
+#include "Platform/Vulkan/RenderPlans/Block/VulkanBlock.hh"
+#include "Platform/Vulkan/RenderPlans/Block/VulkanDepthBlock.hh"
+#include "Platform/Vulkan/RenderPlans/VulkanRenderPlan.hh"
+#include "Platform/Vulkan/VulkanDevice.hh"
+#include "Platform/Vulkan/Work/VulkanWorkOrchestrator.hh"
+
+// stages of all accesses of the graph, contents of blocks without them may still be used by the previous frame or
+// by a transient block sharing their memory
+static constexpr VkPipelineStageFlags GRAPH_STAGES = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+    VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
+    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+static constexpr VkAccessFlags WRITE_ACCESSES =
+    VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+struct AccessInfo
+{
+  VkImageLayout m_layout;
+  VkPipelineStageFlags m_stages;
+  VkAccessFlags m_access;
+};
+
+// signatures
+static AccessInfo get_access_info(esp::EspRenderGraphAccess access);
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  VulkanRenderGraph::~VulkanRenderGraph()
+  {
+    // blocks destroy their images first, frames in flight may still render to them
+    for (auto& resource : m_resources)
+    {
+      resource.m_block       = nullptr;
+      resource.m_depth_block = nullptr;
+    }
+
+    EspDeletionQueue::defer(
+        [heap_memory = m_heap_memory]()
+        {
+          for (auto memory : heap_memory)
+          {
+            vkFreeMemory(VulkanDevice::get_logical_device(), memory, nullptr);
+          }
+        });
+  }
+
+  std::unique_ptr<EspRenderPlan> VulkanRenderGraph::create_plan() { return std::make_unique<VulkanRenderPlan>(); }
+
+  EspTransientRequirements VulkanRenderGraph::create_transient(EspRenderGraphResource resource,
+                                                               const EspTransientBlockDesc& desc)
+  {
+    VkImageUsageFlags usage = desc.m_depth ? VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT
+                                           : VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    if (desc.m_sampled) { usage |= VK_IMAGE_USAGE_SAMPLED_BIT; }
+    if (desc.m_transfer_src) { usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT; }
+    auto format = desc.m_depth ? static_cast<VkFormat>(desc.m_depth_format) : static_cast<VkFormat>(desc.m_format);
+
+    VkImageCreateInfo image_info{};
+    image_info.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    image_info.imageType     = VK_IMAGE_TYPE_2D;
+    image_info.extent.width  = desc.m_width;
+    image_info.extent.height = desc.m_height;
+    image_info.extent.depth  = 1;
+    image_info.mipLevels     = 1;
+    image_info.arrayLayers   = 1;
+    image_info.format        = format;
+    image_info.tiling        = VK_IMAGE_TILING_OPTIMAL;
+    image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    image_info.usage         = usage;
+    image_info.samples       = VK_SAMPLE_COUNT_1_BIT;
+    image_info.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+
+    VkImage image;
+    if (vkCreateImage(VulkanDevice::get_logical_device(), &image_info, nullptr, &image) != VK_SUCCESS)
+    {
+      ESP_CORE_ERROR("Failed to create transient image");
+      throw std::runtime_error("Failed to create transient image");
+    }
+
+    m_transient_images.resize(m_resources.size(), VK_NULL_HANDLE);
+    m_transient_images[resource] = image;
+
+    VkMemoryRequirements mem_requirements;
+    vkGetImageMemoryRequirements(VulkanDevice::get_logical_device(), image, &mem_requirements);
+
+    return { mem_requirements.size, mem_requirements.alignment, mem_requirements.memoryTypeBits };
+  }
+
+  void VulkanRenderGraph::bind_transients(const std::vector<EspTransientHeap>& heaps)
+  {
+    for (auto& heap : heaps)
+    {
+      VkMemoryAllocateInfo alloc_info{};
+      alloc_info.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+      alloc_info.allocationSize  = heap.m_size;
+      alloc_info.memoryTypeIndex = VulkanDevice::find_memory_type(heap.m_memory_type_bits,
+                                                                  VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+      VkDeviceMemory memory;
+      if (vkAllocateMemory(VulkanDevice::get_logical_device(), &alloc_info, nullptr, &memory) != VK_SUCCESS)
+      {
+        ESP_CORE_ERROR("Failed to allocate transient memory");
+        throw std::runtime_error("Failed to allocate transient memory");
+      }
+      m_heap_memory.push_back(memory);
+    }
+
+    for (uint32_t i = 0; i < m_transient_images.size(); i++)
+    {
+      auto image = m_transient_images[i];
+      if (image == VK_NULL_HANDLE) { continue; }
+
+      auto& resource = m_resources[i];
+      vkBindImageMemory(VulkanDevice::get_logical_device(), image, m_heap_memory[resource.m_heap], resource.m_offset);
+
+      auto& desc = resource.m_desc;
+      if (desc.m_depth)
+      {
+        auto usage = EspImageUsageFlag::ESP_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+        if (desc.m_sampled) { usage = usage | EspImageUsageFlag::ESP_IMAGE_USAGE_SAMPLED_BIT; }
+
+        resource.m_depth_block =
+            std::make_shared<VulkanDepthBlock>(desc.m_depth_format, usage, desc.m_width, desc.m_height, image);
+      }
+      else
+      {
+        resource.m_block =
+            std::make_shared<VulkanBlock>(desc.m_format, desc.m_width, desc.m_height, desc.m_clear_color, image);
+      }
+    }
+
+    // blocks own the images now
+    m_transient_images.clear();
+  }
+
+  void VulkanRenderGraph::record_barriers(const std::vector<EspRenderGraphBarrier>& barriers)
+  {
+    std::vector<VkImageMemoryBarrier> image_barriers;
+    VkPipelineStageFlags src_stages = 0;
+    VkPipelineStageFlags dst_stages = 0;
+
+    for (auto& barrier : barriers)
+    {
+      auto src = get_access_info(barrier.m_src_access);
+      auto dst = get_access_info(barrier.m_dst_access);
+
+      // discarded contents don't need a layout transition, only writes of earlier commands to be finished
+      if (barrier.m_discard)
+      {
+        src = { VK_IMAGE_LAYOUT_UNDEFINED, GRAPH_STAGES, WRITE_ACCESSES };
+      }
+
+      VkImageMemoryBarrier image_barrier = {};
+      image_barrier.sType                = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+      image_barrier.srcAccessMask        = src.m_access & WRITE_ACCESSES;
+      image_barrier.dstAccessMask        = dst.m_access;
+      image_barrier.oldLayout            = src.m_layout;
+      image_barrier.newLayout            = dst.m_layout;
+      image_barrier.srcQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
+      image_barrier.dstQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
+
+      if (barrier.m_depth)
+      {
+        auto block = std::static_pointer_cast<VulkanDepthBlock>(get_depth_block(barrier.m_resource));
+
+        image_barrier.subresourceRange = { VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, 1 };
+        image_barrier.image            = block->get_image();
+        image_barriers.push_back(image_barrier);
+        if (block->is_resolvable())
+        {
+          image_barrier.image = block->get_resolve_image();
+          image_barriers.push_back(image_barrier);
+        }
+      }
+      else
+      {
+        auto block = std::static_pointer_cast<VulkanBlock>(get_block(barrier.m_resource));
+
+        image_barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+        image_barrier.image            = block->get_image();
+        image_barriers.push_back(image_barrier);
+        if (block->is_resolvable())
+        {
+          image_barrier.image = block->get_resolve_image();
+          image_barriers.push_back(image_barrier);
+        }
+      }
+
+      src_stages |= src.m_stages;
+      dst_stages |= dst.m_stages;
+    }
+
+    vkCmdPipelineBarrier(VulkanWorkOrchestrator::get_current_command_buffer(),
+                         src_stages,
+                         dst_stages,
+                         0,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr,
+                         static_cast<uint32_t>(image_barriers.size()),
+                         image_barriers.data());
+  }
+} // namespace esp
+
+/* --------------------------------------------------------- */
+/* ------------------ HELPFUL FUNCTIONS -------------------- */
+/* --------------------------------------------------------- */
+
+static AccessInfo get_access_info(esp::EspRenderGraphAccess access)
+{
+  switch (access)
+  {
+  case esp::EspRenderGraphAccess::ESP_ACCESS_COLOR_ATTACHMENT:
+    return { VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+             VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+             VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT };
+  case esp::EspRenderGraphAccess::ESP_ACCESS_DEPTH_ATTACHMENT:
+    return { VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+             VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+             VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT };
+  case esp::EspRenderGraphAccess::ESP_ACCESS_SHADER_READ:
+    return { VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+             VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+             VK_ACCESS_SHADER_READ_BIT };
+  case esp::EspRenderGraphAccess::ESP_ACCESS_TRANSFER_READ:
+    return { VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT };
+  default:
+    return { VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0 };
+  }
+}
@@ -0,0 +1,36 @@
+#ifndef PLATFORM_VULKAN_RENDER_API_VULKAN_RENDER_GRAPH_HH
+#define PLATFORM_VULKAN_RENDER_API_VULKAN_RENDER_GRAPH_HH
+
+// libs
+#include "esppch.hh"
+
+// Render API
+#include "Core/RenderAPI/RenderPlans/EspRenderGraph.hh"
+
+namespace esp
+{
+  /// @brief Render graph recording its transitions with image memory barriers. Transient blocks are images bound to
+  /// shared device memory at offsets computed by EspRenderGraph.
+  class VulkanRenderGraph : public EspRenderGraph
+  {
+    /* -------------------------- FIELDS ----------------------------------- */
+   private:
+    // images of transient blocks until they are bound, indexed by handles of the blocks
+    std::vector<VkImage> m_transient_images;
+    std::vector<VkDeviceMemory> m_heap_memory;
+
+    /* -------------------------- METHODS ---------------------------------- */
+   public:
+    VulkanRenderGraph() = default;
+    virtual ~VulkanRenderGraph();
+
+   protected:
+    virtual std::unique_ptr<EspRenderPlan> create_plan() override;
+    virtual EspTransientRequirements create_transient(EspRenderGraphResource resource,
+                                                      const EspTransientBlockDesc& desc) override;
+    virtual void bind_transients(const std::vector<EspTransientHeap>& heaps) override;
+    virtual void record_barriers(const std::vector<EspRenderGraphBarrier>& barriers) override;
+  };
+} // namespace esp
+
+#endif /* PLATFORM_VULKAN_RENDER_API_VULKAN_RENDER_GRAPH_HH */
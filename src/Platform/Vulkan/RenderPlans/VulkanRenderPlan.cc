@@ -1,5 +1,6 @@
 #include "VulkanRenderPlan.hh"
 
+#include "Core/RenderAPI/Work/EspGpuProfiler.hh"
 #include "Platform/Vulkan/RenderPlans/VulkanCommandBuffer.hh"
 #include "Platform/Vulkan/Work/VulkanSwapChain.hh"
 #include "Platform/Vulkan/Work/VulkanWorkOrchestrator.hh"
@@ -136,10 +137,12 @@ namespace esp
     m_color_attachment_infos.resize(m_blocks.size());
     for (int i = 0; i < m_blocks.size(); i++)
     {
+      bool load = i < m_load_blocks.size() && m_load_blocks[i];
+
       m_color_attachment_infos[i].sType       = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
       m_color_attachment_infos[i].imageView   = m_blocks[i]->get_image_view();
       m_color_attachment_infos[i].imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-      m_color_attachment_infos[i].loadOp      = VK_ATTACHMENT_LOAD_OP_CLEAR;
+      m_color_attachment_infos[i].loadOp      = load ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_CLEAR;
       m_color_attachment_infos[i].storeOp     = VK_ATTACHMENT_STORE_OP_STORE;
 
       if (m_blocks[i]->is_resolvable())
@@ -162,11 +165,13 @@ namespace esp
 
     if (m_depth_block)
     {
+      auto depth_load_op = m_load_depth_block ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_CLEAR;
+
       m_depth_stencil_attachment_info                         = {};
       m_depth_stencil_attachment_info.sType                   = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
       m_depth_stencil_attachment_info.imageView               = m_depth_block->get_image_view();
       m_depth_stencil_attachment_info.imageLayout             = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-      m_depth_stencil_attachment_info.loadOp                  = VK_ATTACHMENT_LOAD_OP_CLEAR;
+      m_depth_stencil_attachment_info.loadOp                  = depth_load_op;
       m_depth_stencil_attachment_info.storeOp                 = VK_ATTACHMENT_STORE_OP_STORE;
       m_depth_stencil_attachment_info.clearValue.depthStencil = { 1.0f, 0 };
 
@@ -180,6 +185,27 @@ namespace esp
         m_depth_stencil_attachment_info.resolveMode        = VK_RESOLVE_MODE_SAMPLE_ZERO_BIT;
       }
     }
+
+    // ................................
+    // init info inherited by secondary command buffers
+    m_color_formats.resize(m_blocks.size());
+    for (int i = 0; i < m_blocks.size(); i++)
+    {
+      m_color_formats[i] = static_cast<VkFormat>(m_blocks[i]->get_format());
+    }
+
+    m_inheritance_rendering_info       = {};
+    m_inheritance_rendering_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR;
+
+    auto sample_count                                    = m_blocks[0]->get_sample_count_flag();
+    m_inheritance_rendering_info.colorAttachmentCount    = m_color_formats.size();
+    m_inheritance_rendering_info.pColorAttachmentFormats = m_color_formats.data();
+    m_inheritance_rendering_info.rasterizationSamples    = static_cast<VkSampleCountFlagBits>(sample_count);
+
+    if (m_depth_block)
+    {
+      m_inheritance_rendering_info.depthAttachmentFormat = static_cast<VkFormat>(m_depth_block->get_format());
+    }
   }
 
   void VulkanRenderPlan::set_command_buffer(EspCommandBufferId* id)
@@ -193,7 +219,13 @@ namespace esp
   void VulkanRenderPlan::begin_plan()
   {
     auto frame_idx = VulkanSwapChain::get_current_frame_index();
+
+    // plans recorded into their own command buffer aren't ordered with queries of the frame
+    m_profiled = m_out_command_buffers[frame_idx] == VulkanWorkOrchestrator::get_current_command_buffer();
+    if (m_profiled) { EspGpuProfiler::begin_scope(m_name); }
+
     // transition color and depth images for drawing
+    if (!m_external_barriers)
     {
       // color attachement
       vkCmdPipelineBarrier(m_out_command_buffers[frame_idx],
@@ -240,6 +272,7 @@ namespace esp
       }
     }
 
+    m_rendering_info.flags = m_secondary_contents ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT : 0;
     VulkanWorkOrchestrator::begin_rendering(m_out_command_buffers[frame_idx], &m_rendering_info);
 
     // start recording commands (vkCmd).....
@@ -252,33 +285,48 @@ namespace esp
     VulkanWorkOrchestrator::end_rendering(m_out_command_buffers[frame_idx]);
 
     // transition color image to presentation
-
-    vkCmdPipelineBarrier(m_out_command_buffers[frame_idx],
-                         m_end_src_stage_mask, // srcStageMask
-                         m_end_dst_stage_mask, // dstStageMask
-                         0,
-                         0,
-                         nullptr,
-                         0,
-                         nullptr,
-                         static_cast<uint32_t>(m_end_barriers_infos.size()), // imageMemoryBarrierCount
-                         m_end_barriers_infos.data()                         // pImageMemoryBarriers
-    );
-
-    if (m_depth_block &&
-        static_cast<bool>(m_depth_block->get_image_usage_flag() & EspImageUsageFlag::ESP_IMAGE_USAGE_SAMPLED_BIT))
+    if (!m_external_barriers)
     {
       vkCmdPipelineBarrier(m_out_command_buffers[frame_idx],
-                           VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, // srcStageMask TODO: change this mask
-                           VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, // dstStageMask TODO: change this mask
+                           m_end_src_stage_mask, // srcStageMask
+                           m_end_dst_stage_mask, // dstStageMask
                            0,
                            0,
                            nullptr,
                            0,
                            nullptr,
-                           1,                        // imageMemoryBarrierCount
-                           &m_depth_end_barrier_info // pImageMemoryBarriers
+                           static_cast<uint32_t>(m_end_barriers_infos.size()), // imageMemoryBarrierCount
+                           m_end_barriers_infos.data()                         // pImageMemoryBarriers
       );
+
+      if (m_depth_block &&
+          static_cast<bool>(m_depth_block->get_image_usage_flag() & EspImageUsageFlag::ESP_IMAGE_USAGE_SAMPLED_BIT))
+      {
+        vkCmdPipelineBarrier(m_out_command_buffers[frame_idx],
+                             VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, // srcStageMask TODO: change this mask
+                             VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, // dstStageMask TODO: change this mask
+                             0,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr,
+                             1,                        // imageMemoryBarrierCount
+                             &m_depth_end_barrier_info // pImageMemoryBarriers
+        );
+      }
     }
+
+    if (m_profiled) { EspGpuProfiler::end_scope(); }
+  }
+
+  EspCommandBufferId* VulkanRenderPlan::begin_secondary()
+  {
+    return VulkanWorkOrchestrator::begin_secondary_command_buffer(m_inheritance_rendering_info);
+  }
+
+  void VulkanRenderPlan::execute_secondaries(const std::vector<EspCommandBufferId*>& ids)
+  {
+    auto frame_idx = VulkanSwapChain::get_current_frame_index();
+    VulkanWorkOrchestrator::execute_secondary_command_buffers(m_out_command_buffers[frame_idx], ids);
   }
 } // namespace esp
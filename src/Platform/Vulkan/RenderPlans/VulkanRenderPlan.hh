@@ -31,10 +31,14 @@ namespace esp
     VkRenderingAttachmentInfoKHR m_depth_stencil_attachment_info;
     VkRenderingInfoKHR m_rendering_info;
 
+    std::vector<VkFormat> m_color_formats;
+    VkCommandBufferInheritanceRenderingInfoKHR m_inheritance_rendering_info;
+
     uint32_t m_height;
     uint32_t m_width;
 
     std::vector<VkCommandBuffer> m_out_command_buffers;
+    bool m_profiled = false;
 
     VkPipelineStageFlags m_end_src_stage_mask;
     VkPipelineStageFlags m_end_dst_stage_mask;
@@ -58,6 +62,9 @@ namespace esp
 
     virtual void begin_plan() override;
     virtual void end_plan() override;
+
+    virtual EspCommandBufferId* begin_secondary() override;
+    virtual void execute_secondaries(const std::vector<EspCommandBufferId*>& ids) override;
   };
 } // namespace esp
 
@@ -6,6 +6,7 @@
  */
 
 #include "VulkanBuffer.hh"
+#include "Core/RenderAPI/Work/EspDeletionQueue.hh"
 #include "Platform/Vulkan/VulkanDevice.hh"
 #include "Platform/Vulkan/VulkanResourceManager.hh"
 
@@ -81,8 +82,13 @@ namespace esp
   {
     unmap();
 
-    vkDestroyBuffer(VulkanDevice::get_logical_device(), m_buffer, nullptr);
-    vkFreeMemory(VulkanDevice::get_logical_device(), m_memory, nullptr);
+    // frames in flight may still read the buffer
+    EspDeletionQueue::defer(
+        [buffer = m_buffer, memory = m_memory]()
+        {
+          vkDestroyBuffer(VulkanDevice::get_logical_device(), buffer, nullptr);
+          vkFreeMemory(VulkanDevice::get_logical_device(), memory, nullptr);
+        });
   }
 
   /**
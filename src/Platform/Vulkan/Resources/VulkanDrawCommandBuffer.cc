@@ -0,0 +1,69 @@
+#include "VulkanDrawCommandBuffer.hh"
+
+static_assert(sizeof(esp::EspDrawIndexedCommand) == sizeof(VkDrawIndexedIndirectCommand),
+              "EspDrawIndexedCommand must have the same layout as VkDrawIndexedIndirectCommand.");
+
+namespace esp
+{
+  std::unique_ptr<VulkanDrawCommandBuffer> VulkanDrawCommandBuffer::create(uint32_t max_command_count)
+  {
+    ESP_ASSERT(max_command_count > 0, "Draw command buffer has to hold at least one command.")
+
+    auto draw_command_buffer = std::unique_ptr<VulkanDrawCommandBuffer>(new VulkanDrawCommandBuffer());
+
+    // storage buffers let compute shaders write the commands and their counts as well
+    draw_command_buffer->m_command_buffer = VulkanStorageBuffer::create_host_visible(
+        sizeof(VkDrawIndexedIndirectCommand) * max_command_count * VulkanSwapChain::get_frames_in_flight());
+    draw_command_buffer->m_count_buffer =
+        VulkanStorageBuffer::create_host_visible(sizeof(uint32_t) * VulkanSwapChain::get_frames_in_flight());
+
+    // the buffer is created before the base class knows its capacity
+    draw_command_buffer->m_max_command_count = max_command_count;
+    for (uint32_t frame = 0; frame < VulkanSwapChain::get_frames_in_flight(); frame++)
+    {
+      static_cast<uint32_t*>(draw_command_buffer->m_count_buffer->get_mapped_memory())[frame] = 0;
+    }
+
+    return draw_command_buffer;
+  }
+
+  EspDrawIndexedCommand* VulkanDrawCommandBuffer::get_commands()
+  {
+    return static_cast<EspDrawIndexedCommand*>(m_command_buffer->get_mapped_memory()) +
+        VulkanSwapChain::get_current_frame_index() * m_max_command_count;
+  }
+
+  void VulkanDrawCommandBuffer::set_command_count(uint32_t count)
+  {
+    ESP_ASSERT(count <= m_max_command_count, "Too many draw commands.")
+
+    uint32_t frame = VulkanSwapChain::get_current_frame_index();
+
+    // kept on the CPU side as well, so the count can be read without touching mapped memory
+    m_command_counts[frame] = count;
+
+    static_cast<uint32_t*>(m_count_buffer->get_mapped_memory())[frame] = count;
+  }
+
+  uint32_t VulkanDrawCommandBuffer::get_command_count() const
+  {
+    return m_command_counts[VulkanSwapChain::get_current_frame_index()];
+  }
+
+  uint32_t VulkanDrawCommandBuffer::get_first_command_index() const
+  {
+    return VulkanSwapChain::get_current_frame_index() * m_max_command_count;
+  }
+
+  uint32_t VulkanDrawCommandBuffer::get_count_index() const { return VulkanSwapChain::get_current_frame_index(); }
+
+  VkDeviceSize VulkanDrawCommandBuffer::get_command_offset() const
+  {
+    return static_cast<VkDeviceSize>(get_first_command_index()) * sizeof(VkDrawIndexedIndirectCommand);
+  }
+
+  VkDeviceSize VulkanDrawCommandBuffer::get_count_offset() const
+  {
+    return static_cast<VkDeviceSize>(get_count_index()) * sizeof(uint32_t);
+  }
+} // namespace esp
@@ -0,0 +1,76 @@
+#ifndef VULKAN_RENDER_API_VULKAN_DRAW_COMMAND_BUFFER_HH
+#define VULKAN_RENDER_API_VULKAN_DRAW_COMMAND_BUFFER_HH
+
+#include "Core/RenderAPI/Resources/EspDrawCommandBuffer.hh"
+#include "Platform/Vulkan/Work/VulkanSwapChain.hh"
+#include "VulkanStorageBuffer.hh"
+
+// std
+#include <array>
+
+namespace esp
+{
+  /// @brief Vulkan's buffer of VkDrawIndexedIndirectCommands and their counts. Both are host visible storage
+  /// buffers, so they can be written by the CPU or by compute shaders. Commands of frame i start at offset i * max
+  /// command count.
+  class VulkanDrawCommandBuffer : public EspDrawCommandBuffer
+  {
+   private:
+    std::unique_ptr<VulkanStorageBuffer> m_command_buffer{};
+    std::unique_ptr<VulkanStorageBuffer> m_count_buffer{};
+    std::array<uint32_t, VulkanSwapChain::MAX_FRAMES_IN_FLIGHT> m_command_counts = {};
+
+   public:
+    /// @brief Creates Vulkan's draw command buffer.
+    /// @param max_command_count Maximum number of commands in a single frame.
+    /// @return Unique pointer to instance of draw command buffer.
+    static std::unique_ptr<VulkanDrawCommandBuffer> create(uint32_t max_command_count);
+
+    VulkanDrawCommandBuffer(const VulkanDrawCommandBuffer&)            = delete;
+    VulkanDrawCommandBuffer& operator=(const VulkanDrawCommandBuffer&) = delete;
+
+    /// @brief Virtual destructor.
+    ~VulkanDrawCommandBuffer() override = default;
+
+    /// @brief Returns commands of the current frame.
+    /// @return Pointer to array of max command count commands.
+    virtual EspDrawIndexedCommand* get_commands() override;
+    /// @brief Sets number of commands of the current frame.
+    /// @param count Number of commands.
+    virtual void set_command_count(uint32_t count) override;
+    /// @brief Returns number of commands of the current frame.
+    /// @return Number of commands.
+    virtual uint32_t get_command_count() const override;
+
+    /// @brief Returns commands of all frames in flight as a storage buffer.
+    /// @return Storage buffer of commands.
+    inline virtual EspStorageBuffer* get_command_storage() override { return m_command_buffer.get(); }
+    /// @brief Returns command counts of all frames in flight as a storage buffer.
+    /// @return Storage buffer of counts.
+    inline virtual EspStorageBuffer* get_count_storage() override { return m_count_buffer.get(); }
+    /// @brief Returns index of the current frame's first command in the command storage.
+    /// @return Index of the command.
+    virtual uint32_t get_first_command_index() const override;
+    /// @brief Returns index of the current frame's count in the count storage.
+    /// @return Index of the count.
+    virtual uint32_t get_count_index() const override;
+
+    /// @brief Returns Vulkan's buffer of commands.
+    /// @return Vulkan's buffer of commands.
+    inline VkBuffer get_command_buffer() const { return m_command_buffer->get_buffer(); }
+    /// @brief Returns Vulkan's buffer of command counts.
+    /// @return Vulkan's buffer of command counts.
+    inline VkBuffer get_count_buffer() const { return m_count_buffer->get_buffer(); }
+    /// @brief Returns offset of the current frame's commands in the command buffer.
+    /// @return Offset in bytes.
+    VkDeviceSize get_command_offset() const;
+    /// @brief Returns offset of the current frame's command count in the count buffer.
+    /// @return Offset in bytes.
+    VkDeviceSize get_count_offset() const;
+
+   private:
+    VulkanDrawCommandBuffer() = default;
+  };
+} // namespace esp
+
+#endif // VULKAN_RENDER_API_VULKAN_DRAW_COMMAND_BUFFER_HH
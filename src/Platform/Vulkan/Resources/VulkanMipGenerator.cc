@@ -0,0 +1,354 @@
+#include "VulkanMipGenerator.hh"
+#include "Core/RenderAPI/Work/EspDeletionQueue.hh"
+#include "Core/RenderAPI/Work/EspDispatch.hh"
+#include "Platform/Vulkan/VulkanDevice.hh"
+#include "Platform/Vulkan/Work/VulkanAsyncCompute.hh"
+
+// SPIR-V of Platform/Vulkan/Shaders/mip_generation.comp, generated by the build
+#include "mip_generation.comp.h"
+
+// layout of the shader's push constant block
+struct MipGenerationPush
+{
+  uint32_t m_src_width;
+  uint32_t m_src_height;
+  uint32_t m_level_count;
+  uint32_t m_srgb;
+};
+
+// signatures
+static VkFormat get_storage_format(VkFormat format);
+static VkImageSubresourceRange get_levels(uint32_t base_level, uint32_t level_count);
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  VulkanMipGenerator* VulkanMipGenerator::s_instance = nullptr;
+
+  std::unique_ptr<VulkanMipGenerator> VulkanMipGenerator::create()
+  {
+    ESP_ASSERT(VulkanMipGenerator::s_instance == nullptr, "The vulkan mip generator already exists!");
+    VulkanMipGenerator::s_instance = new VulkanMipGenerator(VulkanDevice::get_logical_device());
+
+    return std::unique_ptr<VulkanMipGenerator>{ VulkanMipGenerator::s_instance };
+  }
+
+  VulkanMipGenerator::VulkanMipGenerator(VkDevice device) : m_device{ device }
+  {
+    // both RGBA8 formats are written through UNORM views
+    m_storage_supported = VulkanDevice::get_format_properties(VK_FORMAT_R8G8B8A8_UNORM).optimalTilingFeatures &
+        VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT;
+    if (!m_storage_supported)
+    {
+      ESP_CORE_WARN("RGBA8 storage images aren't supported, mip levels are generated by blitting.");
+      return;
+    }
+
+    create_pipeline();
+  }
+
+  void VulkanMipGenerator::terminate()
+  {
+    ESP_ASSERT(VulkanMipGenerator::s_instance != nullptr, "The vulkan mip generator is deleted twice!");
+
+    if (!m_requests.empty())
+    {
+      ESP_CORE_WARN("{} textures were destroyed before their mip levels were generated.", m_requests.size());
+    }
+    ESP_CORE_TRACE("Mip generator shutdown ({} textures generated).", m_generated_textures);
+
+    if (m_pipeline != VK_NULL_HANDLE) { vkDestroyPipeline(m_device, m_pipeline, nullptr); }
+    m_pipeline_layout.reset();
+    m_set_layout.reset();
+
+    VulkanMipGenerator::s_instance = nullptr;
+  }
+
+  void VulkanMipGenerator::record()
+  {
+    std::vector<Request> requests;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      requests.swap(m_requests);
+    }
+    if (requests.empty()) { return; }
+
+    ESP_PROFILE_SCOPE("VulkanMipGenerator::record");
+
+    // uploads have finished on the graphics queue, images are shared with the compute queue
+    auto command_buffer = VulkanAsyncCompute::get_command_buffer()->m_command_buffer;
+
+    // 1. every level of every texture is moved to the general layout at once
+    std::vector<VkImageMemoryBarrier> barriers;
+    for (auto& request : requests)
+    {
+      VkImageMemoryBarrier barrier{};
+      barrier.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+      barrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+      barrier.dstAccessMask       = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+      barrier.oldLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+      barrier.newLayout           = VK_IMAGE_LAYOUT_GENERAL;
+      barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+      barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+      barrier.image               = request.m_image;
+      barrier.subresourceRange    = get_levels(0, request.m_mip_levels);
+      barriers.push_back(barrier);
+    }
+    vkCmdPipelineBarrier(command_buffer,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         0,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr,
+                         static_cast<uint32_t>(barriers.size()),
+                         barriers.data());
+
+    // 2. views of single levels, destroyed once the GPU has finished the frame
+    std::vector<std::vector<VkImageView>> views(requests.size());
+    for (size_t i = 0; i < requests.size(); i++)
+    {
+      for (uint32_t level = 0; level < requests[i].m_mip_levels; level++)
+      {
+        views[i].push_back(create_level_view(requests[i].m_image, requests[i].m_format, level));
+      }
+    }
+
+    // 3. every round generates the next four levels of all textures, the barrier between rounds is shared by them
+    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+
+    auto& descriptor_allocator = VulkanDevice::get_descriptor_allocator();
+    for (uint32_t base_level = 0;; base_level += LEVELS_PER_DISPATCH)
+    {
+      bool dispatched = false;
+      for (size_t i = 0; i < requests.size(); i++)
+      {
+        auto& request = requests[i];
+        if (base_level + 1 >= request.m_mip_levels) { continue; }
+
+        uint32_t level_count = std::min(LEVELS_PER_DISPATCH, request.m_mip_levels - base_level - 1);
+
+        // unused bindings point to the last generated level, the shader doesn't write them
+        VkDescriptorImageInfo image_infos[LEVELS_PER_DISPATCH + 1];
+        for (uint32_t binding = 0; binding <= LEVELS_PER_DISPATCH; binding++)
+        {
+          image_infos[binding].sampler     = VK_NULL_HANDLE;
+          image_infos[binding].imageView   = views[i][base_level + std::min(binding, level_count)];
+          image_infos[binding].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+        }
+
+        auto descriptor_set = descriptor_allocator.allocate_frame(m_set_layout->get_descriptor_set_layout());
+
+        VkWriteDescriptorSet writes[LEVELS_PER_DISPATCH + 1];
+        for (uint32_t binding = 0; binding <= LEVELS_PER_DISPATCH; binding++)
+        {
+          writes[binding]                 = {};
+          writes[binding].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+          writes[binding].dstSet          = descriptor_set;
+          writes[binding].dstBinding      = binding;
+          writes[binding].descriptorCount = 1;
+          writes[binding].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+          writes[binding].pImageInfo      = &image_infos[binding];
+        }
+        vkUpdateDescriptorSets(m_device, LEVELS_PER_DISPATCH + 1, writes, 0, nullptr);
+
+        vkCmdBindDescriptorSets(command_buffer,
+                                VK_PIPELINE_BIND_POINT_COMPUTE,
+                                m_pipeline_layout->get_pipeline_layout(),
+                                0,
+                                1,
+                                &descriptor_set,
+                                0,
+                                nullptr);
+
+        MipGenerationPush push{};
+        push.m_src_width   = std::max(request.m_width >> base_level, 1u);
+        push.m_src_height  = std::max(request.m_height >> base_level, 1u);
+        push.m_level_count = level_count;
+        push.m_srgb        = request.m_format == VK_FORMAT_R8G8B8A8_SRGB;
+        vkCmdPushConstants(command_buffer,
+                           m_pipeline_layout->get_pipeline_layout(),
+                           VK_SHADER_STAGE_COMPUTE_BIT,
+                           0,
+                           sizeof(push),
+                           &push);
+
+        // a group of 16x16 invocations covers 16x16 pixels of the first generated level
+        uint32_t first_width  = std::max(push.m_src_width / 2, 1u);
+        uint32_t first_height = std::max(push.m_src_height / 2, 1u);
+        vkCmdDispatch(command_buffer, esp_group_count(first_width, 16), esp_group_count(first_height, 16), 1);
+        dispatched = true;
+      }
+      if (!dispatched) { break; }
+
+      VkMemoryBarrier barrier{};
+      barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+      barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+      barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+      vkCmdPipelineBarrier(command_buffer,
+                           VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                           VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                           0,
+                           1,
+                           &barrier,
+                           0,
+                           nullptr,
+                           0,
+                           nullptr);
+    }
+
+    // 4. textures are sampled by fragment shaders of the frame, which wait for the async compute queue's semaphore
+    bool async = VulkanAsyncCompute::is_async();
+    for (auto& barrier : barriers)
+    {
+      barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+      barrier.dstAccessMask = async ? 0 : VK_ACCESS_SHADER_READ_BIT;
+      barrier.oldLayout     = VK_IMAGE_LAYOUT_GENERAL;
+      barrier.newLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    }
+    vkCmdPipelineBarrier(command_buffer,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         async ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                         0,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr,
+                         static_cast<uint32_t>(barriers.size()),
+                         barriers.data());
+
+    EspDeletionQueue::defer(
+        [device = m_device, views = std::move(views)]()
+        {
+          for (auto& texture_views : views)
+          {
+            for (auto view : texture_views)
+            {
+              vkDestroyImageView(device, view, nullptr);
+            }
+          }
+        });
+
+    m_generated_textures += requests.size();
+  }
+
+  bool VulkanMipGenerator::supports(VkFormat format)
+  {
+    if (!s_instance || !s_instance->m_storage_supported) { return false; }
+    return format == VK_FORMAT_R8G8B8A8_UNORM || format == VK_FORMAT_R8G8B8A8_SRGB;
+  }
+
+  void VulkanMipGenerator::enqueue(VkImage image, VkFormat format, uint32_t width, uint32_t height, uint32_t mip_levels)
+  {
+    ESP_ASSERT(supports(format), "Mip levels of the format can't be generated by the mip generator!");
+
+    std::lock_guard<std::mutex> lock(s_instance->m_mutex);
+    s_instance->m_requests.push_back({ image, format, width, height, mip_levels });
+  }
+
+  void VulkanMipGenerator::cancel(VkImage image)
+  {
+    if (!s_instance) { return; }
+
+    std::lock_guard<std::mutex> lock(s_instance->m_mutex);
+    auto& requests = s_instance->m_requests;
+    requests.erase(std::remove_if(requests.begin(),
+                                  requests.end(),
+                                  [image](const Request& request) { return request.m_image == image; }),
+                   requests.end());
+  }
+
+  void VulkanMipGenerator::create_pipeline()
+  {
+    // source level and the four generated ones
+    std::vector<VkDescriptorSetLayoutBinding> bindings;
+    for (uint32_t binding = 0; binding <= LEVELS_PER_DISPATCH; binding++)
+    {
+      bindings.push_back({ binding, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr });
+    }
+
+    auto& layout_cache = VulkanDevice::get_layout_cache();
+    m_set_layout       = layout_cache.acquire_descriptor_set_layout(bindings);
+    m_pipeline_layout =
+        layout_cache.acquire_pipeline_layout({ m_set_layout },
+                                             { { VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(MipGenerationPush) } });
+
+    VkShaderModuleCreateInfo module_info{};
+    module_info.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    module_info.codeSize = sizeof(mip_generation_comp);
+    module_info.pCode    = mip_generation_comp;
+
+    VkShaderModule shader_module;
+    if (vkCreateShaderModule(m_device, &module_info, nullptr, &shader_module) != VK_SUCCESS)
+    {
+      ESP_CORE_ERROR("Failed to create shader module of mip generator");
+      throw std::runtime_error("Failed to create shader module of mip generator");
+    }
+
+    VkComputePipelineCreateInfo pipeline_info{};
+    pipeline_info.sType        = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipeline_info.stage.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipeline_info.stage.stage  = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipeline_info.stage.module = shader_module;
+    pipeline_info.stage.pName  = "main";
+    pipeline_info.layout       = m_pipeline_layout->get_pipeline_layout();
+
+    auto result = vkCreateComputePipelines(m_device,
+                                           VulkanDevice::get_pipeline_cache().get_pipeline_cache(),
+                                           1,
+                                           &pipeline_info,
+                                           nullptr,
+                                           &m_pipeline);
+    vkDestroyShaderModule(m_device, shader_module, nullptr);
+
+    if (result != VK_SUCCESS)
+    {
+      ESP_CORE_ERROR("Failed to create compute pipeline of mip generator");
+      throw std::runtime_error("Failed to create compute pipeline of mip generator");
+    }
+  }
+
+  VkImageView VulkanMipGenerator::create_level_view(VkImage image, VkFormat format, uint32_t level)
+  {
+    VkImageViewCreateInfo view_info{};
+    view_info.sType            = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    view_info.image            = image;
+    view_info.viewType         = VK_IMAGE_VIEW_TYPE_2D;
+    view_info.format           = get_storage_format(format);
+    view_info.subresourceRange = get_levels(level, 1);
+
+    VkImageView image_view;
+    if (vkCreateImageView(m_device, &view_info, nullptr, &image_view) != VK_SUCCESS)
+    {
+      ESP_CORE_ERROR("Failed to create image view of mip level");
+      throw std::runtime_error("Failed to create image view of mip level");
+    }
+
+    return image_view;
+  }
+} // namespace esp
+
+/* --------------------------------------------------------- */
+/* ------------------ HELPFUL FUNCTIONS -------------------- */
+/* --------------------------------------------------------- */
+
+static VkFormat get_storage_format(VkFormat format)
+{
+  // sRGB formats can't be used for storage images
+  return format == VK_FORMAT_R8G8B8A8_SRGB ? VK_FORMAT_R8G8B8A8_UNORM : format;
+}
+
+static VkImageSubresourceRange get_levels(uint32_t base_level, uint32_t level_count)
+{
+  VkImageSubresourceRange subresource_range{};
+  subresource_range.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+  subresource_range.baseMipLevel   = base_level;
+  subresource_range.levelCount     = level_count;
+  subresource_range.baseArrayLayer = 0;
+  subresource_range.layerCount     = 1;
+  return subresource_range;
+}
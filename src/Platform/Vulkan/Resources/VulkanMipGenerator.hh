@@ -0,0 +1,92 @@
+#ifndef PLATFORM_VULKAN_RENDER_API_VULKAN_MIP_GENERATOR_HH
+#define PLATFORM_VULKAN_RENDER_API_VULKAN_MIP_GENERATOR_HH
+
+#include "esppch.hh"
+
+// Render API Vulkan
+#include "Platform/Vulkan/Uniforms/VulkanLayoutCache.hh"
+
+// std
+#include <mutex>
+
+namespace esp
+{
+  /// @brief Generates mip levels of textures with a compute shader. Textures are queued when they are created and all
+  /// of them are recorded into the next frame's compute work (VulkanAsyncCompute), which is finished before the frame
+  /// samples them. A dispatch generates up to four levels, so most textures need one or two of them. sRGB images are
+  /// filtered in linear space, which linear blitting doesn't do.
+  ///
+  /// Only RGBA8 (UNORM and sRGB) images are supported, their levels are written through UNORM storage views.
+  class VulkanMipGenerator
+  {
+   public:
+    /// @brief Number of levels a single dispatch generates.
+    static constexpr uint32_t LEVELS_PER_DISPATCH = 4;
+
+   private:
+    struct Request
+    {
+      VkImage m_image;
+      VkFormat m_format;
+      uint32_t m_width;
+      uint32_t m_height;
+      uint32_t m_mip_levels;
+    };
+
+    static VulkanMipGenerator* s_instance;
+
+    VkDevice m_device;
+    bool m_storage_supported;
+
+    std::shared_ptr<VulkanDescriptorSetLayout> m_set_layout;
+    std::shared_ptr<VulkanPipelineLayout> m_pipeline_layout;
+    VkPipeline m_pipeline = VK_NULL_HANDLE;
+
+    std::mutex m_mutex;
+    std::vector<Request> m_requests;
+
+    uint64_t m_generated_textures = 0;
+
+   public:
+    /// @brief Creates VulkanMipGenerator singleton instance and its compute pipeline.
+    /// @return Unique pointer to VulkanMipGenerator instance.
+    static std::unique_ptr<VulkanMipGenerator> create();
+
+    PREVENT_COPY(VulkanMipGenerator);
+
+    /// @brief Default destructor.
+    ~VulkanMipGenerator() = default;
+
+    /// @brief Destroys the pipeline. GPU has to be idle. Textures still waiting are left without
+    /// mip levels.
+    void terminate();
+
+    /// @brief Records generation of every queued texture into compute work of the current frame.
+    void record();
+
+    /// @brief Checks if mip levels of images of the format can be generated.
+    /// @param format Format of the image.
+    /// @return True if the format is supported. False if there is no instance.
+    static bool supports(VkFormat format);
+    /// @brief Queues generation of mip levels. Can be called from many threads.
+    /// @param image Image with all levels in VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL and the base level written. It has
+    /// to be created with VK_IMAGE_USAGE_STORAGE_BIT (and VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT if it's sRGB). The image
+    /// is in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL once the generation is done.
+    /// @param format Format of the image.
+    /// @param width Width of the base level.
+    /// @param height Height of the base level.
+    /// @param mip_levels Number of levels of the image.
+    static void enqueue(VkImage image, VkFormat format, uint32_t width, uint32_t height, uint32_t mip_levels);
+    /// @brief Removes image from the queue, it has to be called before a queued image is destroyed.
+    /// @param image Image to be removed.
+    static void cancel(VkImage image);
+
+   private:
+    VulkanMipGenerator(VkDevice device);
+
+    void create_pipeline();
+    VkImageView create_level_view(VkImage image, VkFormat format, uint32_t level);
+  };
+} // namespace esp
+
+#endif // PLATFORM_VULKAN_RENDER_API_VULKAN_MIP_GENERATOR_HH
@@ -1,4 +1,5 @@
 #include "VulkanSampler.hh"
+#include "Core/RenderAPI/Work/EspDeletionQueue.hh"
 #include "Platform/Vulkan/VulkanDevice.hh"
 
 namespace esp
@@ -39,7 +40,10 @@ namespace esp
 
   VulkanSampler::~VulkanSampler()
   {
-    if (this != s_default_sampler.get()) { vkDestroySampler(VulkanDevice::get_logical_device(), m_sampler, nullptr); }
+    if (this == s_default_sampler.get()) { return; }
+
+    EspDeletionQueue::defer([sampler = m_sampler]()
+                            { vkDestroySampler(VulkanDevice::get_logical_device(), sampler, nullptr); });
   }
 
   void VulkanSampler::create_default_sampler() { s_default_sampler = std::make_shared<VulkanSampler>(); }
@@ -3,13 +3,14 @@
 
 namespace esp
 {
-  VulkanShader::VulkanShader(const std::string& name, std::unique_ptr<SpirvResource> spirv_resource) : EspShader(name)
+  VulkanShader::VulkanShader(const std::string& name, std::shared_ptr<SpirvResource> spirv_resource) : EspShader(name)
   {
-    m_worker_builder->set_shaders(std::move(spirv_resource));
+    m_spirv_resource = std::move(spirv_resource);
+    m_worker_builder->set_shaders(m_spirv_resource);
   }
 
   std::shared_ptr<VulkanShader> VulkanShader::create(const std::string name,
-                                                     std::unique_ptr<SpirvResource> spirv_resource)
+                                                     std::shared_ptr<SpirvResource> spirv_resource)
   {
     auto vulkan_shader = std::shared_ptr<VulkanShader>(new VulkanShader(name, std::move(spirv_resource)));
 
@@ -19,7 +19,7 @@ namespace esp
     /// @param name Name of the shader.
     /// @param spirv_resource SpirvResource containing the shader code.
     /// @return Shared pointer to uninitialized VulkanShader.
-    static std::shared_ptr<VulkanShader> create(const std::string name, std::unique_ptr<SpirvResource> spirv_resource);
+    static std::shared_ptr<VulkanShader> create(const std::string name, std::shared_ptr<SpirvResource> spirv_resource);
 
     PREVENT_COPY(VulkanShader);
 
@@ -27,7 +27,7 @@ namespace esp
     ~VulkanShader();
 
    private:
-    VulkanShader(const std::string& name, std::unique_ptr<SpirvResource> spirv_resource);
+    VulkanShader(const std::string& name, std::shared_ptr<SpirvResource> spirv_resource);
   };
 } // namespace esp
 
@@ -0,0 +1,93 @@
+#include "VulkanShaderModuleCache.hh"
+
+// std
+#include <cstring>
+
+// signatures
+static size_t hash_spirv(const esp::SpirvData& code);
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  VulkanShaderModule::VulkanShaderModule(VkDevice device,
+                                         std::shared_ptr<const SpirvData> code,
+                                         size_t hash,
+                                         uint64_t id) :
+      m_device{ device }, m_hash{ hash }, m_id{ id }, m_code{ std::move(code) }
+  {
+    VkShaderModuleCreateInfo create_info{};
+    create_info.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    create_info.codeSize = m_code->size() * sizeof(uint32_t);
+    create_info.pCode    = m_code->data();
+
+    if (vkCreateShaderModule(m_device, &create_info, nullptr, &m_shader_module) != VK_SUCCESS)
+    {
+      ESP_CORE_ERROR("Failed to create shader module");
+      throw std::runtime_error("Failed to create shader module");
+    }
+  }
+
+  VulkanShaderModule::~VulkanShaderModule() { vkDestroyShaderModule(m_device, m_shader_module, nullptr); }
+
+  bool VulkanShaderModule::is_created_from(const SpirvData& code) const
+  {
+    if (m_code.get() == &code) { return true; }
+
+    return m_code->size() == code.size() &&
+        std::memcmp(m_code->data(), code.data(), code.size() * sizeof(uint32_t)) == 0;
+  }
+
+  std::unique_ptr<VulkanShaderModuleCache> VulkanShaderModuleCache::create(VkDevice device)
+  {
+    return std::unique_ptr<VulkanShaderModuleCache>(new VulkanShaderModuleCache(device));
+  }
+
+  VulkanShaderModuleCache::VulkanShaderModuleCache(VkDevice device) : m_device{ device } {}
+
+  void VulkanShaderModuleCache::terminate()
+  {
+    ESP_CORE_TRACE("Shader module cache shutdown ({} created, {} shared).", m_created.load(), m_shared.load());
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_shader_modules.clear();
+  }
+
+  std::shared_ptr<VulkanShaderModule> VulkanShaderModuleCache::acquire(std::shared_ptr<const SpirvData> code)
+  {
+    auto hash = hash_spirv(*code);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto& entry = m_shader_modules[hash];
+    if (auto shader_module = entry.lock(); shader_module && shader_module->is_created_from(*code))
+    {
+      m_shared++;
+      return shader_module;
+    }
+
+    // a colliding module of different code stays valid for its users, but is no longer shared
+    auto shader_module = std::make_shared<VulkanShaderModule>(m_device, std::move(code), hash, m_next_id++);
+    entry              = shader_module;
+    m_created++;
+
+    return shader_module;
+  }
+
+  VulkanShaderModuleCacheStats VulkanShaderModuleCache::get_stats() const
+  {
+    return { m_created.load(), m_shared.load() };
+  }
+} // namespace esp
+
+/* --------------------------------------------------------- */
+/* ------------------ HELPFUL FUNCTIONS -------------------- */
+/* --------------------------------------------------------- */
+
+static size_t hash_spirv(const esp::SpirvData& code)
+{
+  return std::hash<std::string_view>{}(
+      std::string_view(reinterpret_cast<const char*>(code.data()), code.size() * sizeof(uint32_t)));
+}
@@ -0,0 +1,108 @@
+#ifndef VULKAN_RENDER_API_VULKAN_SHADER_MODULE_CACHE_HH
+#define VULKAN_RENDER_API_VULKAN_SHADER_MODULE_CACHE_HH
+
+#include "esppch.hh"
+
+// Core
+#include "Core/Resources/ResourceTypes.hh"
+
+// std
+#include <atomic>
+#include <mutex>
+
+namespace esp
+{
+  /// @brief VkShaderModule shared by all shaders with the same SPIR-V code. It is destroyed with its last reference.
+  class VulkanShaderModule
+  {
+   private:
+    VkDevice m_device;
+    VkShaderModule m_shader_module;
+    size_t m_hash;
+    uint64_t m_id;
+    // code of the shader's resource, compared on cache hits, so different code with the same hash never shares the
+    // module
+    std::shared_ptr<const SpirvData> m_code;
+
+   public:
+    /// @brief Creates shader module from the SPIR-V code.
+    /// @param device Logical device.
+    /// @param code SPIR-V code, kept alive (not copied) by the module.
+    /// @param hash Hash of the SPIR-V code.
+    /// @param id Identifier unique among all modules created by the cache.
+    VulkanShaderModule(VkDevice device, std::shared_ptr<const SpirvData> code, size_t hash, uint64_t id);
+    /// @brief Destroys shader module.
+    ~VulkanShaderModule();
+
+    PREVENT_COPY(VulkanShaderModule);
+
+    /// @brief Returns Vulkan's shader module.
+    /// @return Vulkan's shader module.
+    inline VkShaderModule get_shader_module() const { return m_shader_module; }
+    /// @brief Returns hash of the SPIR-V code the module was created from.
+    /// @return Hash of the SPIR-V code.
+    inline size_t get_hash() const { return m_hash; }
+    /// @brief Returns identifier of the module. Unlike the hash it is never shared by modules of different code, nor
+    /// reused after the module is destroyed, so pipelines are deduplicated by it.
+    /// @return Identifier of the module.
+    inline uint64_t get_id() const { return m_id; }
+    /// @brief Returns size of the SPIR-V code the module was created from.
+    /// @return Size of the SPIR-V code in words.
+    inline size_t get_code_size() const { return m_code->size(); }
+    /// @brief Checks if the module was created from the SPIR-V code.
+    /// @param code SPIR-V code.
+    /// @return True if the code is identical to the module's code.
+    bool is_created_from(const SpirvData& code) const;
+  };
+
+  /// @brief Counters describing the shader module cache since it was created.
+  struct VulkanShaderModuleCacheStats
+  {
+    /// @brief Number of modules created.
+    uint32_t m_created = 0;
+    /// @brief Number of requests served by module that already existed.
+    uint32_t m_shared = 0;
+  };
+
+  /// @brief Cache of shader modules keyed by hash of their SPIR-V code. Modules found by the hash are shared only if
+  /// their code is identical. It keeps only weak references, so modules are destroyed when no shader or pipeline
+  /// compilation uses them.
+  class VulkanShaderModuleCache
+  {
+   private:
+    VkDevice m_device;
+
+    std::mutex m_mutex;
+    std::unordered_map<size_t, std::weak_ptr<VulkanShaderModule>> m_shader_modules;
+    uint64_t m_next_id = 1;
+
+    std::atomic<uint32_t> m_created = 0;
+    std::atomic<uint32_t> m_shared  = 0;
+
+   public:
+    /// @brief Creates empty shader module cache.
+    /// @param device Logical device.
+    /// @return Unique pointer to the shader module cache.
+    static std::unique_ptr<VulkanShaderModuleCache> create(VkDevice device);
+
+    PREVENT_COPY(VulkanShaderModuleCache);
+
+    /// @brief Logs statistics and forgets all modules. Modules still in use stay valid.
+    void terminate();
+
+    /// @brief Returns shader module created from the SPIR-V code. Creates it if it doesn't exist. Can be called from
+    /// many threads.
+    /// @param code SPIR-V code, usually an aliasing pointer to the data of a SpirvResource. The module keeps it alive.
+    /// @return Shared pointer to the shader module.
+    std::shared_ptr<VulkanShaderModule> acquire(std::shared_ptr<const SpirvData> code);
+
+    /// @brief Returns statistics of the cache.
+    /// @return Statistics of the cache.
+    VulkanShaderModuleCacheStats get_stats() const;
+
+   private:
+    VulkanShaderModuleCache(VkDevice device);
+  };
+} // namespace esp
+
+#endif // VULKAN_RENDER_API_VULKAN_SHADER_MODULE_CACHE_HH
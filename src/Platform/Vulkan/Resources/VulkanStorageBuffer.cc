@@ -0,0 +1,116 @@
+#include "VulkanStorageBuffer.hh"
+
+#include "Platform/Vulkan/Work/VulkanWorkOrchestrator.hh"
+
+// transfer usage lets the buffer be filled, cleared and read back
+static constexpr VkBufferUsageFlags STORAGE_BUFFER_USAGE = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+    VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+// stages which may access the buffer before and after an update
+static constexpr VkPipelineStageFlags SHADER_STAGES = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT |
+    VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+namespace esp
+{
+  std::unique_ptr<VulkanStorageBuffer> VulkanStorageBuffer::create(uint32_t size, void* data)
+  {
+    ESP_ASSERT(size > 0, "Storage buffer can't be empty.")
+
+    auto storage_buffer    = std::unique_ptr<VulkanStorageBuffer>(new VulkanStorageBuffer());
+    storage_buffer->m_size = size;
+
+    if (data)
+    {
+      storage_buffer->m_buffer =
+          VulkanBuffer::create_and_fill(data, size, 1, STORAGE_BUFFER_USAGE, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    }
+    else
+    {
+      storage_buffer->m_buffer =
+          std::make_unique<VulkanBuffer>(size, 1, STORAGE_BUFFER_USAGE, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    }
+
+    return storage_buffer;
+  }
+
+  std::unique_ptr<VulkanStorageBuffer> VulkanStorageBuffer::create_host_visible(uint32_t size)
+  {
+    ESP_ASSERT(size > 0, "Storage buffer can't be empty.")
+
+    auto storage_buffer            = std::unique_ptr<VulkanStorageBuffer>(new VulkanStorageBuffer());
+    storage_buffer->m_size         = size;
+    storage_buffer->m_host_visible = true;
+
+    storage_buffer->m_buffer = std::make_unique<VulkanBuffer>(size,
+                                                              1,
+                                                              STORAGE_BUFFER_USAGE,
+                                                              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                                  VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    storage_buffer->m_buffer->map();
+
+    return storage_buffer;
+  }
+
+  void VulkanStorageBuffer::update(uint32_t offset, uint32_t size, const void* data)
+  {
+    ESP_ASSERT(offset + size <= m_size, "Data doesn't fit into the storage buffer.")
+
+    if (m_host_visible)
+    {
+      m_buffer->write_to_buffer(data, size, offset);
+      return;
+    }
+
+    ESP_ASSERT(!VulkanWorkOrchestrator::is_rendering(), "Storage buffer can't be updated inside of a render plan.")
+
+    // destructor defers destruction of the staging buffer until the GPU has finished the frame
+    VulkanBuffer staging_buffer{ size,
+                                 1,
+                                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT };
+    staging_buffer.map();
+    staging_buffer.write_to_buffer(data, size);
+
+    // before the first frame (e.g. while loading a scene) the copy is submitted on its own
+    bool in_frame       = VulkanWorkOrchestrator::is_frame_recording();
+    auto command_buffer = in_frame ? VulkanWorkOrchestrator::get_current_command_buffer()
+                                   : VulkanWorkOrchestrator::begin_single_time_commands();
+
+    // earlier commands may still read or write the buffer
+    VkMemoryBarrier barrier{};
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(command_buffer,
+                         SHADER_STAGES,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0,
+                         1,
+                         &barrier,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr);
+
+    VkBufferCopy copy_region{};
+    copy_region.srcOffset = 0;
+    copy_region.dstOffset = offset;
+    copy_region.size      = size;
+    vkCmdCopyBuffer(command_buffer, staging_buffer.get_buffer(), m_buffer->get_buffer(), 1, &copy_region);
+
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask =
+        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+    vkCmdPipelineBarrier(command_buffer,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         SHADER_STAGES,
+                         0,
+                         1,
+                         &barrier,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr);
+
+    if (!in_frame) { VulkanWorkOrchestrator::end_single_time_commands(command_buffer); }
+  }
+} // namespace esp
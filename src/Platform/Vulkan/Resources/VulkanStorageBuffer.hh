@@ -0,0 +1,53 @@
+#ifndef VULKAN_RENDER_API_VULKAN_STORAGE_BUFFER_HH
+#define VULKAN_RENDER_API_VULKAN_STORAGE_BUFFER_HH
+
+#include "Core/RenderAPI/Resources/EspStorageBuffer.hh"
+#include "VulkanBuffer.hh"
+
+namespace esp
+{
+  /// @brief Vulkan's device local storage buffer. It's shared by the graphics and the async compute queue. Host
+  /// visible ones back buffers written by both the CPU and shaders, e.g. draw command buffers.
+  class VulkanStorageBuffer : public EspStorageBuffer
+  {
+   private:
+    std::unique_ptr<VulkanBuffer> m_buffer{};
+    bool m_host_visible = false;
+
+   public:
+    /// @brief Creates VulkanStorageBuffer.
+    /// @param size Size of the buffer in bytes.
+    /// @param data Raw pointer to initial data, copied through a staging buffer. Can be null.
+    /// @return Unique pointer to instance of storage buffer.
+    static std::unique_ptr<VulkanStorageBuffer> create(uint32_t size, void* data);
+    /// @brief Creates host visible VulkanStorageBuffer, mapped for its whole lifetime.
+    /// @param size Size of the buffer in bytes.
+    /// @return Unique pointer to instance of storage buffer.
+    static std::unique_ptr<VulkanStorageBuffer> create_host_visible(uint32_t size);
+
+    VulkanStorageBuffer(const VulkanStorageBuffer&)            = delete;
+    VulkanStorageBuffer& operator=(const VulkanStorageBuffer&) = delete;
+
+    /// @brief Virtual destructor.
+    ~VulkanStorageBuffer() override = default;
+
+    /// @brief Copies data to the buffer through a staging buffer, which is destroyed once the frame is finished. Host
+    /// visible buffers are written directly.
+    /// @param offset Offset in the buffer in bytes.
+    /// @param size Size of the data in bytes.
+    /// @param data Raw pointer to the data.
+    void update(uint32_t offset, uint32_t size, const void* data) override;
+
+    /// @brief Returns Vulkan's buffer.
+    /// @return Vulkan's buffer.
+    inline VkBuffer get_buffer() const { return m_buffer->get_buffer(); }
+    /// @brief Returns mapped memory of host visible buffer.
+    /// @return Pointer to the contents of the buffer. Null if the buffer is device local.
+    inline void* get_mapped_memory() const { return m_buffer->get_mapped_memory(); }
+
+   private:
+    VulkanStorageBuffer() = default;
+  };
+} // namespace esp
+
+#endif // VULKAN_RENDER_API_VULKAN_STORAGE_BUFFER_HH
@@ -1,4 +1,6 @@
 #include "VulkanTexture.hh"
+#include "Core/RenderAPI/Work/EspDeletionQueue.hh"
+#include "Platform/Vulkan/Resources/VulkanMipGenerator.hh"
 #include "Platform/Vulkan/VulkanDevice.hh"
 #include "Platform/Vulkan/VulkanResourceManager.hh"
 
@@ -142,18 +144,23 @@ namespace esp
     else
     {
       // normal texture
+      VkImageUsageFlags usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+      if (params.storage) { usage |= VK_IMAGE_USAGE_STORAGE_BIT; }
+
+      // storage textures may be written by the async compute queue
       VulkanResourceManager::create_image(vulkan_texture->get_width(),
                                           vulkan_texture->get_height(),
                                           vulkan_texture->get_mip_levels(),
                                           sample_count,
                                           format,
                                           VK_IMAGE_TILING_OPTIMAL,
-                                          VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+                                          usage,
                                           1,
                                           {},
                                           VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                                           vulkan_texture->m_texture_image,
-                                          vulkan_texture->m_texture_image_memory);
+                                          vulkan_texture->m_texture_image_memory,
+                                          params.storage);
 
       vulkan_texture->m_texture_image_view = VulkanResourceManager::create_image_view(vulkan_texture->m_texture_image,
                                                                                       format,
@@ -218,9 +225,17 @@ namespace esp
   {
     if (!m_retrieved_from_block)
     {
-      vkDestroyImageView(VulkanDevice::get_logical_device(), m_texture_image_view, nullptr);
-      vkDestroyImage(VulkanDevice::get_logical_device(), m_texture_image, nullptr);
-      vkFreeMemory(VulkanDevice::get_logical_device(), m_texture_image_memory, nullptr);
+      // the image mustn't be used by mip generation recorded after it's destroyed
+      VulkanMipGenerator::cancel(m_texture_image);
+
+      // frames in flight may still sample the texture
+      EspDeletionQueue::defer(
+          [image_view = m_texture_image_view, image = m_texture_image, memory = m_texture_image_memory]()
+          {
+            vkDestroyImageView(VulkanDevice::get_logical_device(), image_view, nullptr);
+            vkDestroyImage(VulkanDevice::get_logical_device(), image, nullptr);
+            vkFreeMemory(VulkanDevice::get_logical_device(), memory, nullptr);
+          });
     }
   }
 } // namespace esp
\ No newline at end of file
@@ -2,8 +2,10 @@
 
 // platform
 #include "Platform/Vulkan/VulkanDevice.hh"
+#include "VulkanBindlessTextures.hh"
 
 static VkDescriptorSetLayoutBinding create_descriptor_set_layout_binding(esp::EspMetaUniform& data);
+static VkShaderStageFlags get_shader_stage_flags(esp::EspUniformShaderStage stage);
 
 /* --------------------------------------------------------- */
 /* ----------------- EspUniformDataStorage ----------------- */
@@ -21,6 +23,21 @@ namespace esp
 
     for (auto& meta_dsl : m_meta_data->m_meta_descriptor_sets)
     {
+      if (meta_dsl.m_bindless)
+      {
+        if (!EspBindlessTextures::is_enabled())
+        {
+          ESP_CORE_ERROR("Shader uses bindless descriptor set, but bindless textures aren't enabled!");
+          throw std::runtime_error("Shader uses bindless descriptor set, but bindless textures aren't enabled!");
+        }
+
+        // the set is shared by all bindless shaders
+        auto& dsl = VulkanBindlessTextures::get_descriptor_set_layout();
+        m_descriptor_set_layouts.push_back(dsl->get_descriptor_set_layout());
+        m_set_layouts.push_back(dsl);
+        continue;
+      }
+
       std::vector<VkDescriptorSetLayoutBinding> descriptor_set_layout_bindings;
 
       for (auto& meta_uniform : meta_dsl.m_meta_uniforms)
@@ -28,45 +45,22 @@ namespace esp
         descriptor_set_layout_bindings.push_back(create_descriptor_set_layout_binding(meta_uniform));
       }
 
-      VkDescriptorSetLayoutCreateInfo layout_info{};
-      layout_info.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-      layout_info.bindingCount = static_cast<uint32_t>(descriptor_set_layout_bindings.size());
-      layout_info.pBindings    = descriptor_set_layout_bindings.data();
-
-      VkDescriptorSetLayout descriptor_set_layout;
-      if (vkCreateDescriptorSetLayout(VulkanDevice::get_logical_device(),
-                                      &layout_info,
-                                      nullptr,
-                                      &descriptor_set_layout) != VK_SUCCESS)
-      {
-        ESP_CORE_ERROR("Failed to create descriptor set layout!");
-        throw std::runtime_error("Failed to create descriptor set layout!");
-      }
-      m_descriptor_set_layouts.push_back(descriptor_set_layout);
+      // identical sets of different shaders share the layout
+      auto dsl = VulkanDevice::get_layout_cache().acquire_descriptor_set_layout(descriptor_set_layout_bindings);
+      m_descriptor_set_layouts.push_back(dsl->get_descriptor_set_layout());
+      m_set_layouts.push_back(std::move(dsl));
     }
 
     for (auto& push : m_meta_data->m_meta_pushes)
     {
-      auto stage = VK_SHADER_STAGE_VERTEX_BIT;
-      if (push.m_stage == esp::EspUniformShaderStage::ESP_FRAG_STAGE) { stage = VK_SHADER_STAGE_FRAGMENT_BIT; }
-      else if (push.m_stage == esp::EspUniformShaderStage::ESP_ALL_STAGES) { stage = VK_SHADER_STAGE_ALL_GRAPHICS; }
-
       VkPushConstantRange push_constant_range{};
-      push_constant_range.stageFlags = stage;
+      push_constant_range.stageFlags = get_shader_stage_flags(push.m_stage);
       push_constant_range.offset     = push.m_offset;
       push_constant_range.size       = push.m_size;
 
       m_push_constant_ranges.push_back(push_constant_range);
     }
   }
-
-  EspUniformDataStorage::~EspUniformDataStorage()
-  {
-    for (auto& dsl : m_descriptor_set_layouts)
-    {
-      vkDestroyDescriptorSetLayout(VulkanDevice::get_logical_device(), dsl, nullptr);
-    }
-  }
 } // namespace esp
 
 /* --------------------------------------------------------- */
@@ -75,9 +69,7 @@ namespace esp
 
 static VkDescriptorSetLayoutBinding create_descriptor_set_layout_binding(esp::EspMetaUniform& data)
 {
-  auto stage = VK_SHADER_STAGE_VERTEX_BIT;
-  if (data.m_stage == esp::EspUniformShaderStage::ESP_FRAG_STAGE) { stage = VK_SHADER_STAGE_FRAGMENT_BIT; }
-  else if (data.m_stage == esp::EspUniformShaderStage::ESP_ALL_STAGES) { stage = VK_SHADER_STAGE_ALL_GRAPHICS; }
+  auto stage = get_shader_stage_flags(data.m_stage);
 
   switch (data.m_uniform_type)
   {
@@ -91,6 +83,16 @@ static VkDescriptorSetLayoutBinding create_descriptor_set_layout_binding(esp::Es
     ubo_layout_binding.stageFlags         = stage;
     return ubo_layout_binding;
   }
+  case esp::EspUniformType::ESP_DYNAMIC_BUFFER_UNIFORM:
+  {
+    VkDescriptorSetLayoutBinding ubo_layout_binding{};
+    ubo_layout_binding.binding            = data.m_binding;
+    ubo_layout_binding.descriptorCount    = 1;
+    ubo_layout_binding.descriptorType     = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    ubo_layout_binding.pImmutableSamplers = nullptr;
+    ubo_layout_binding.stageFlags         = stage;
+    return ubo_layout_binding;
+  }
   case esp::EspUniformType::ESP_TEXTURE:
   {
     VkDescriptorSetLayoutBinding sampler_layout_binding{};
@@ -101,6 +103,33 @@ static VkDescriptorSetLayoutBinding create_descriptor_set_layout_binding(esp::Es
     sampler_layout_binding.stageFlags         = stage;
     return sampler_layout_binding;
   }
+  case esp::EspUniformType::ESP_STORAGE_BUFFER:
+  {
+    // buffers created by the manager are bound whole
+    if (data.m_size_of_data_chunk > esp::VulkanDevice::get_properties().limits.maxStorageBufferRange)
+    {
+      ESP_CORE_ERROR("Storage buffer at binding {} is larger than the device allows!", data.m_binding);
+      throw std::runtime_error("Storage buffer is larger than the device allows!");
+    }
+
+    VkDescriptorSetLayoutBinding ssbo_layout_binding{};
+    ssbo_layout_binding.binding            = data.m_binding;
+    ssbo_layout_binding.descriptorCount    = data.m_number_of_elements;
+    ssbo_layout_binding.descriptorType     = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    ssbo_layout_binding.pImmutableSamplers = nullptr;
+    ssbo_layout_binding.stageFlags         = stage;
+    return ssbo_layout_binding;
+  }
+  case esp::EspUniformType::ESP_STORAGE_IMAGE:
+  {
+    VkDescriptorSetLayoutBinding image_layout_binding{};
+    image_layout_binding.binding            = data.m_binding;
+    image_layout_binding.descriptorCount    = data.m_number_of_elements;
+    image_layout_binding.descriptorType     = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    image_layout_binding.pImmutableSamplers = nullptr;
+    image_layout_binding.stageFlags         = stage;
+    return image_layout_binding;
+  }
 
   default:
     ESP_CORE_ERROR("Given uniform type doesn't exist!");
@@ -108,3 +137,18 @@ static VkDescriptorSetLayoutBinding create_descriptor_set_layout_binding(esp::Es
     break;
   }
 }
+
+static VkShaderStageFlags get_shader_stage_flags(esp::EspUniformShaderStage stage)
+{
+  switch (stage)
+  {
+  case esp::EspUniformShaderStage::ESP_FRAG_STAGE:
+    return VK_SHADER_STAGE_FRAGMENT_BIT;
+  case esp::EspUniformShaderStage::ESP_ALL_STAGES:
+    return VK_SHADER_STAGE_ALL_GRAPHICS;
+  case esp::EspUniformShaderStage::ESP_COMPUTE_STAGE:
+    return VK_SHADER_STAGE_COMPUTE_BIT;
+  default:
+    return VK_SHADER_STAGE_VERTEX_BIT;
+  }
+}
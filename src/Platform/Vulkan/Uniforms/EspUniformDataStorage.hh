@@ -5,6 +5,7 @@
 
 // platfrom
 #include "Platform/Vulkan/Resources/VulkanBuffer.hh"
+#include "VulkanLayoutCache.hh"
 #include "VulkanUniformMetaData.hh"
 
 // std
@@ -15,6 +16,7 @@ namespace esp
   struct EspUniformDataStorage
   {
    public:
+    std::vector<std::shared_ptr<VulkanDescriptorSetLayout>> m_set_layouts;
     std::vector<VkDescriptorSetLayout> m_descriptor_set_layouts;
     std::vector<VkPushConstantRange> m_push_constant_ranges;
     std::unique_ptr<VulkanUniformMetaData> m_meta_data;
@@ -31,7 +33,6 @@ namespace esp
     EspUniformDataStorage(const EspUniformDataStorage& other)            = delete;
 
     EspUniformDataStorage(std::unique_ptr<VulkanUniformMetaData> meta_data);
-    ~EspUniformDataStorage();
   };
 
 } // namespace esp
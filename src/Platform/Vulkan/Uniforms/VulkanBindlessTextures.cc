@@ -0,0 +1,142 @@
+#include "VulkanBindlessTextures.hh"
+
+// platform
+#include "Platform/Vulkan/Resources/VulkanTexture.hh"
+#include "Platform/Vulkan/VulkanDevice.hh"
+#include "Platform/Vulkan/Work/VulkanSwapChain.hh"
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  std::unique_ptr<VulkanBindlessTextures> VulkanBindlessTextures::create(uint32_t max_textures, uint32_t max_materials)
+  {
+    if (!VulkanDevice::is_bindless_supported())
+    {
+      ESP_CORE_WARN("Device doesn't support bindless textures. Materials use their own descriptor sets.");
+      return nullptr;
+    }
+
+    max_textures = std::min(max_textures, VulkanDevice::get_max_bindless_textures());
+    return std::unique_ptr<VulkanBindlessTextures>(
+        new VulkanBindlessTextures(VulkanDevice::get_logical_device(), max_textures, max_materials));
+  }
+
+  VulkanBindlessTextures::VulkanBindlessTextures(VkDevice device, uint32_t max_textures, uint32_t max_materials) :
+      EspBindlessTextures(max_textures, max_materials, VulkanSwapChain::get_frames_in_flight()), m_device{ device }
+  {
+    std::vector<VkDescriptorSetLayoutBinding> bindings(2);
+    bindings[TEXTURES_BINDING].binding         = TEXTURES_BINDING;
+    bindings[TEXTURES_BINDING].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    bindings[TEXTURES_BINDING].descriptorCount = max_textures;
+    bindings[TEXTURES_BINDING].stageFlags      = VK_SHADER_STAGE_ALL_GRAPHICS;
+
+    bindings[MATERIALS_BINDING].binding         = MATERIALS_BINDING;
+    bindings[MATERIALS_BINDING].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[MATERIALS_BINDING].descriptorCount = 1;
+    bindings[MATERIALS_BINDING].stageFlags      = VK_SHADER_STAGE_ALL_GRAPHICS;
+
+    // unused slots stay unwritten and released ones are rewritten while the set is bound
+    VkDescriptorBindingFlagsEXT textures_flags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT |
+        VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+    std::vector<VkDescriptorBindingFlagsEXT> binding_flags = { textures_flags, 0 };
+
+    // the layout isn't shared, so its hash only has to differ from hashes of the cached layouts
+    size_t hash = 0;
+    hash_combine(hash, std::string("bindless"));
+    hash_combine(hash, max_textures);
+
+    m_set_layout = std::make_shared<VulkanDescriptorSetLayout>(
+        m_device, bindings, hash, VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT, binding_flags);
+
+    std::vector<VkDescriptorPoolSize> pool_sizes = { { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, max_textures },
+                                                     { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1 } };
+
+    VkDescriptorPoolCreateInfo pool_info{};
+    pool_info.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    pool_info.flags         = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+    pool_info.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
+    pool_info.pPoolSizes    = pool_sizes.data();
+    pool_info.maxSets       = 1;
+
+    if (vkCreateDescriptorPool(m_device, &pool_info, nullptr, &m_descriptor_pool) != VK_SUCCESS)
+    {
+      ESP_CORE_ERROR("Failed to create bindless descriptor pool!");
+      throw std::runtime_error("Failed to create bindless descriptor pool!");
+    }
+
+    auto set_layout = m_set_layout->get_descriptor_set_layout();
+
+    VkDescriptorSetAllocateInfo alloc_info{};
+    alloc_info.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    alloc_info.descriptorPool     = m_descriptor_pool;
+    alloc_info.descriptorSetCount = 1;
+    alloc_info.pSetLayouts        = &set_layout;
+
+    if (vkAllocateDescriptorSets(m_device, &alloc_info, &m_descriptor_set) != VK_SUCCESS)
+    {
+      ESP_CORE_ERROR("Failed to allocate bindless descriptor set!");
+      throw std::runtime_error("Failed to allocate bindless descriptor set!");
+    }
+
+    m_material_buffer = std::make_unique<VulkanBuffer>(sizeof(EspBindlessMaterial),
+                                                       max_materials,
+                                                       VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                                       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    m_material_buffer->map();
+
+    VkDescriptorBufferInfo buffer_info{};
+    buffer_info.buffer = m_material_buffer->get_buffer();
+    buffer_info.offset = 0;
+    buffer_info.range  = VK_WHOLE_SIZE;
+
+    VkWriteDescriptorSet descriptor_write{};
+    descriptor_write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptor_write.dstSet          = m_descriptor_set;
+    descriptor_write.dstBinding      = MATERIALS_BINDING;
+    descriptor_write.dstArrayElement = 0;
+    descriptor_write.descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    descriptor_write.descriptorCount = 1;
+    descriptor_write.pBufferInfo     = &buffer_info;
+
+    vkUpdateDescriptorSets(m_device, 1, &descriptor_write, 0, nullptr);
+  }
+
+  VulkanBindlessTextures::~VulkanBindlessTextures() { terminate(); }
+
+  void VulkanBindlessTextures::write_texture(uint32_t index, EspTexture& texture)
+  {
+    auto& vulkan_texture = static_cast<VulkanTexture&>(texture);
+
+    VkDescriptorImageInfo image_info{};
+    image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    image_info.imageView   = vulkan_texture.get_texture_image_view();
+    image_info.sampler     = vulkan_texture.get_sampler();
+
+    VkWriteDescriptorSet descriptor_write{};
+    descriptor_write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptor_write.dstSet          = m_descriptor_set;
+    descriptor_write.dstBinding      = TEXTURES_BINDING;
+    descriptor_write.dstArrayElement = index;
+    descriptor_write.descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    descriptor_write.descriptorCount = 1;
+    descriptor_write.pImageInfo      = &image_info;
+
+    vkUpdateDescriptorSets(m_device, 1, &descriptor_write, 0, nullptr);
+  }
+
+  void VulkanBindlessTextures::write_material(uint32_t index, const EspBindlessMaterial& material)
+  {
+    m_material_buffer->write_to_buffer(&material, sizeof(EspBindlessMaterial), index * sizeof(EspBindlessMaterial));
+  }
+
+  void VulkanBindlessTextures::destroy()
+  {
+    m_material_buffer.reset();
+    vkDestroyDescriptorPool(m_device, m_descriptor_pool, nullptr);
+    m_set_layout.reset();
+  }
+} // namespace esp
@@ -0,0 +1,65 @@
+#ifndef PLATFORM_VULKAN_RENDER_API_VULKAN_BINDLESS_TEXTURES_HH
+#define PLATFORM_VULKAN_RENDER_API_VULKAN_BINDLESS_TEXTURES_HH
+
+#include "esppch.hh"
+
+// Render API
+#include "Core/RenderAPI/Resources/EspBindlessTextures.hh"
+
+// Render API Vulkan
+#include "Platform/Vulkan/Resources/VulkanBuffer.hh"
+#include "VulkanLayoutCache.hh"
+
+namespace esp
+{
+  /// @brief Bindless textures kept in one descriptor set. Binding 0 is a partially bound array of combined image
+  /// samplers updated after bind, binding 1 is the storage buffer of materials. The set is allocated once from its own
+  /// pool and shared by all bindless shaders.
+  class VulkanBindlessTextures : public EspBindlessTextures
+  {
+   public:
+    /// @brief Binding of the texture array.
+    static constexpr uint32_t TEXTURES_BINDING = 0;
+    /// @brief Binding of the material buffer.
+    static constexpr uint32_t MATERIALS_BINDING = 1;
+
+   private:
+    VkDevice m_device;
+    std::shared_ptr<VulkanDescriptorSetLayout> m_set_layout;
+    VkDescriptorPool m_descriptor_pool;
+    VkDescriptorSet m_descriptor_set;
+    std::unique_ptr<VulkanBuffer> m_material_buffer;
+
+   public:
+    /// @brief Creates descriptor set and material buffer.
+    /// @param max_textures Number of textures in the texture array. Clamped to device's limits.
+    /// @param max_materials Number of materials in the material buffer.
+    /// @return Unique pointer to the instance. nullptr if the device doesn't support bindless textures.
+    static std::unique_ptr<VulkanBindlessTextures> create(uint32_t max_textures, uint32_t max_materials);
+    /// @brief Terminates VulkanBindlessTextures.
+    ~VulkanBindlessTextures();
+
+    /// @brief Returns layout of the bindless descriptor set.
+    /// @return Shared pointer to the descriptor set layout.
+    static inline const std::shared_ptr<VulkanDescriptorSetLayout>& get_descriptor_set_layout()
+    {
+      return static_cast<VulkanBindlessTextures*>(s_instance)->m_set_layout;
+    }
+    /// @brief Returns the bindless descriptor set.
+    /// @return Descriptor set.
+    static inline VkDescriptorSet get_descriptor_set()
+    {
+      return static_cast<VulkanBindlessTextures*>(s_instance)->m_descriptor_set;
+    }
+
+   protected:
+    virtual void write_texture(uint32_t index, EspTexture& texture) override;
+    virtual void write_material(uint32_t index, const EspBindlessMaterial& material) override;
+    virtual void destroy() override;
+
+   private:
+    VulkanBindlessTextures(VkDevice device, uint32_t max_textures, uint32_t max_materials);
+  };
+} // namespace esp
+
+#endif // PLATFORM_VULKAN_RENDER_API_VULKAN_BINDLESS_TEXTURES_HH
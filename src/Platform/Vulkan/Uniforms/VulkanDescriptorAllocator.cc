@@ -0,0 +1,90 @@
+#include "VulkanDescriptorAllocator.hh"
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  std::unique_ptr<VulkanDescriptorAllocator> VulkanDescriptorAllocator::create(VkDevice device,
+                                                                              uint32_t frames_in_flight,
+                                                                              bool update_after_bind)
+  {
+    return std::unique_ptr<VulkanDescriptorAllocator>(
+        new VulkanDescriptorAllocator(device, frames_in_flight, update_after_bind));
+  }
+
+  VulkanDescriptorAllocator::VulkanDescriptorAllocator(VkDevice device,
+                                                       uint32_t frames_in_flight,
+                                                       bool update_after_bind) :
+      EspDescriptorAllocator(frames_in_flight),
+      m_device{ device }, m_update_after_bind{ update_after_bind }
+  {
+  }
+
+  uint64_t VulkanDescriptorAllocator::create_pool(uint32_t max_sets)
+  {
+    // number of descriptors of each type per set
+    const std::pair<VkDescriptorType, uint32_t> ratios[] = { { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2 },
+                                                             { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1 },
+                                                             { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4 },
+                                                             { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2 },
+                                                             { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 2 } };
+
+    std::vector<VkDescriptorPoolSize> pool_sizes;
+    for (auto [type, ratio] : ratios)
+    {
+      pool_sizes.push_back({ type, max_sets * ratio });
+    }
+
+    VkDescriptorPoolCreateInfo pool_info{};
+    pool_info.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    pool_info.flags         = m_update_after_bind ? VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT : 0;
+    pool_info.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
+    pool_info.pPoolSizes    = pool_sizes.data();
+    pool_info.maxSets       = max_sets;
+
+    VkDescriptorPool descriptor_pool;
+    if (vkCreateDescriptorPool(m_device, &pool_info, nullptr, &descriptor_pool) != VK_SUCCESS)
+    {
+      ESP_CORE_ERROR("Failed to create descriptor pool!");
+      throw std::runtime_error("Failed to create descriptor pool!");
+    }
+
+    return (uint64_t)descriptor_pool;
+  }
+
+  void VulkanDescriptorAllocator::destroy_pool(uint64_t pool)
+  {
+    vkDestroyDescriptorPool(m_device, (VkDescriptorPool)pool, nullptr);
+  }
+
+  void VulkanDescriptorAllocator::reset_pool(uint64_t pool)
+  {
+    vkResetDescriptorPool(m_device, (VkDescriptorPool)pool, 0);
+  }
+
+  uint64_t VulkanDescriptorAllocator::allocate_set(uint64_t pool, uint64_t layout)
+  {
+    auto set_layout = (VkDescriptorSetLayout)layout;
+
+    VkDescriptorSetAllocateInfo alloc_info{};
+    alloc_info.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    alloc_info.descriptorPool     = (VkDescriptorPool)pool;
+    alloc_info.descriptorSetCount = 1;
+    alloc_info.pSetLayouts        = &set_layout;
+
+    VkDescriptorSet descriptor_set;
+    auto result = vkAllocateDescriptorSets(m_device, &alloc_info, &descriptor_set);
+
+    // the pool is full, the allocator moves to the next one
+    if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL) { return 0; }
+    if (result != VK_SUCCESS)
+    {
+      ESP_CORE_ERROR("Failed to allocate descriptor sets!");
+      throw std::runtime_error("Failed to allocate descriptor sets!");
+    }
+
+    return (uint64_t)descriptor_set;
+  }
+} // namespace esp
@@ -0,0 +1,69 @@
+#ifndef PLATFORM_VULKAN_RENDER_API_VULKAN_DESCRIPTOR_ALLOCATOR_HH
+#define PLATFORM_VULKAN_RENDER_API_VULKAN_DESCRIPTOR_ALLOCATOR_HH
+
+#include "esppch.hh"
+
+// Render API
+#include "Core/RenderAPI/Uniforms/EspDescriptorAllocator.hh"
+
+namespace esp
+{
+  /// @brief Descriptor allocator shared by all uniform managers. Pools are created with room for every descriptor type
+  /// used by the engine, proportionally to the number of sets.
+  class VulkanDescriptorAllocator : public EspDescriptorAllocator
+  {
+   private:
+    VkDevice m_device;
+    bool m_update_after_bind;
+
+   public:
+    /// @brief Creates allocator without any pools.
+    /// @param device Logical device.
+    /// @param frames_in_flight Number of frames the GPU may be working on at once.
+    /// @param update_after_bind Creates pools with VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT, so they can
+    /// hold sets with update-after-bind layouts.
+    /// @return Unique pointer to the allocator.
+    static std::unique_ptr<VulkanDescriptorAllocator> create(VkDevice device,
+                                                             uint32_t frames_in_flight,
+                                                             bool update_after_bind);
+
+    /// @brief Allocates set living until it is freed.
+    /// @param layout Layout of the set.
+    /// @return Descriptor set.
+    inline VkDescriptorSet allocate(VkDescriptorSetLayout layout)
+    {
+      return (VkDescriptorSet)EspDescriptorAllocator::allocate((uint64_t)layout);
+    }
+    /// @brief Returns long-lived set to the allocator.
+    /// @param layout Layout of the set.
+    /// @param set Descriptor set.
+    inline void free(VkDescriptorSetLayout layout, VkDescriptorSet set)
+    {
+      EspDescriptorAllocator::free((uint64_t)layout, (uint64_t)set);
+    }
+    /// @brief Forgets freed sets of the layout before it is destroyed.
+    /// @param layout Layout of the sets.
+    inline void release_layout(VkDescriptorSetLayout layout)
+    {
+      EspDescriptorAllocator::release_layout((uint64_t)layout);
+    }
+    /// @brief Allocates set valid until the current frame index begins again.
+    /// @param layout Layout of the set.
+    /// @return Descriptor set.
+    inline VkDescriptorSet allocate_frame(VkDescriptorSetLayout layout)
+    {
+      return (VkDescriptorSet)EspDescriptorAllocator::allocate_frame((uint64_t)layout);
+    }
+
+   protected:
+    virtual uint64_t create_pool(uint32_t max_sets) override;
+    virtual void destroy_pool(uint64_t pool) override;
+    virtual void reset_pool(uint64_t pool) override;
+    virtual uint64_t allocate_set(uint64_t pool, uint64_t layout) override;
+
+   private:
+    VulkanDescriptorAllocator(VkDevice device, uint32_t frames_in_flight, bool update_after_bind);
+  };
+} // namespace esp
+
+#endif // PLATFORM_VULKAN_RENDER_API_VULKAN_DESCRIPTOR_ALLOCATOR_HH
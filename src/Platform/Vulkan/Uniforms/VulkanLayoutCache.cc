@@ -0,0 +1,218 @@
+#include "VulkanLayoutCache.hh"
+#include "Platform/Vulkan/VulkanDevice.hh"
+
+// signatures
+static size_t hash_bindings(const std::vector<VkDescriptorSetLayoutBinding>& bindings);
+static size_t hash_pipeline_layout(const std::vector<std::shared_ptr<esp::VulkanDescriptorSetLayout>>& set_layouts,
+                                   const std::vector<VkPushConstantRange>& push_ranges);
+static bool are_bindings_equal(const std::vector<VkDescriptorSetLayoutBinding>& a,
+                               const std::vector<VkDescriptorSetLayoutBinding>& b);
+static bool are_push_ranges_equal(const std::vector<VkPushConstantRange>& a,
+                                  const std::vector<VkPushConstantRange>& b);
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  VulkanDescriptorSetLayout::VulkanDescriptorSetLayout(VkDevice device,
+                                                       std::vector<VkDescriptorSetLayoutBinding> bindings,
+                                                       size_t hash,
+                                                       VkDescriptorSetLayoutCreateFlags flags,
+                                                       const std::vector<VkDescriptorBindingFlagsEXT>& binding_flags) :
+      m_device{ device }, m_hash{ hash }, m_bindings{ std::move(bindings) }
+  {
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT binding_flags_info{};
+    binding_flags_info.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+    binding_flags_info.bindingCount  = static_cast<uint32_t>(binding_flags.size());
+    binding_flags_info.pBindingFlags = binding_flags.data();
+
+    VkDescriptorSetLayoutCreateInfo layout_info{};
+    layout_info.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layout_info.pNext        = binding_flags.empty() ? nullptr : &binding_flags_info;
+    layout_info.flags        = flags;
+    layout_info.bindingCount = static_cast<uint32_t>(m_bindings.size());
+    layout_info.pBindings    = m_bindings.data();
+
+    if (vkCreateDescriptorSetLayout(m_device, &layout_info, nullptr, &m_descriptor_set_layout) != VK_SUCCESS)
+    {
+      ESP_CORE_ERROR("Failed to create descriptor set layout!");
+      throw std::runtime_error("Failed to create descriptor set layout!");
+    }
+  }
+
+  VulkanDescriptorSetLayout::~VulkanDescriptorSetLayout()
+  {
+    // the driver may give the handle to a new layout, which mustn't get sets of this one
+    if (VulkanDevice::has_descriptor_allocator())
+    {
+      VulkanDevice::get_descriptor_allocator().release_layout(m_descriptor_set_layout);
+    }
+    vkDestroyDescriptorSetLayout(m_device, m_descriptor_set_layout, nullptr);
+  }
+
+  VulkanPipelineLayout::VulkanPipelineLayout(VkDevice device,
+                                             std::vector<std::shared_ptr<VulkanDescriptorSetLayout>> set_layouts,
+                                             std::vector<VkPushConstantRange> push_ranges,
+                                             size_t hash) :
+      m_device{ device }, m_hash{ hash }, m_set_layouts{ std::move(set_layouts) },
+      m_push_ranges{ std::move(push_ranges) }
+  {
+    std::vector<VkDescriptorSetLayout> vk_set_layouts;
+    for (const auto& set_layout : m_set_layouts)
+    {
+      vk_set_layouts.push_back(set_layout->get_descriptor_set_layout());
+    }
+
+    VkPipelineLayoutCreateInfo pipeline_layout_info{};
+    pipeline_layout_info.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipeline_layout_info.setLayoutCount         = static_cast<uint32_t>(vk_set_layouts.size());
+    pipeline_layout_info.pSetLayouts            = vk_set_layouts.empty() ? nullptr : vk_set_layouts.data();
+    pipeline_layout_info.pushConstantRangeCount = static_cast<uint32_t>(m_push_ranges.size());
+    pipeline_layout_info.pPushConstantRanges    = m_push_ranges.empty() ? nullptr : m_push_ranges.data();
+
+    if (vkCreatePipelineLayout(m_device, &pipeline_layout_info, nullptr, &m_pipeline_layout) != VK_SUCCESS)
+    {
+      ESP_CORE_ERROR("Failed to create pipeline layout");
+      throw std::runtime_error("Failed to create pipeline layout");
+    }
+  }
+
+  VulkanPipelineLayout::~VulkanPipelineLayout() { vkDestroyPipelineLayout(m_device, m_pipeline_layout, nullptr); }
+
+  std::unique_ptr<VulkanLayoutCache> VulkanLayoutCache::create(VkDevice device)
+  {
+    return std::unique_ptr<VulkanLayoutCache>(new VulkanLayoutCache(device));
+  }
+
+  VulkanLayoutCache::VulkanLayoutCache(VkDevice device) : m_device{ device } {}
+
+  void VulkanLayoutCache::terminate()
+  {
+    ESP_CORE_TRACE("Layout cache shutdown (set layouts: {} created, {} shared; pipeline layouts: {} created, {} "
+                   "shared).",
+                   m_set_layouts_created.load(),
+                   m_set_layouts_shared.load(),
+                   m_pipeline_layouts_created.load(),
+                   m_pipeline_layouts_shared.load());
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pipeline_layouts.clear();
+    m_set_layouts.clear();
+  }
+
+  std::shared_ptr<VulkanDescriptorSetLayout> VulkanLayoutCache::acquire_descriptor_set_layout(
+      const std::vector<VkDescriptorSetLayoutBinding>& bindings)
+  {
+    auto hash = hash_bindings(bindings);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto& entry = m_set_layouts[hash];
+    if (auto set_layout = entry.lock(); set_layout && are_bindings_equal(set_layout->get_bindings(), bindings))
+    {
+      m_set_layouts_shared++;
+      return set_layout;
+    }
+
+    auto set_layout = std::make_shared<VulkanDescriptorSetLayout>(m_device, bindings, hash);
+    entry           = set_layout;
+    m_set_layouts_created++;
+
+    return set_layout;
+  }
+
+  std::shared_ptr<VulkanPipelineLayout> VulkanLayoutCache::acquire_pipeline_layout(
+      const std::vector<std::shared_ptr<VulkanDescriptorSetLayout>>& set_layouts,
+      const std::vector<VkPushConstantRange>& push_ranges)
+  {
+    auto hash = hash_pipeline_layout(set_layouts, push_ranges);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // set layouts come from this cache, so identical sets are the same objects
+    auto& entry = m_pipeline_layouts[hash];
+    if (auto pipeline_layout = entry.lock(); pipeline_layout && pipeline_layout->get_set_layouts() == set_layouts &&
+                                             are_push_ranges_equal(pipeline_layout->get_push_ranges(), push_ranges))
+    {
+      m_pipeline_layouts_shared++;
+      return pipeline_layout;
+    }
+
+    auto pipeline_layout = std::make_shared<VulkanPipelineLayout>(m_device, set_layouts, push_ranges, hash);
+    entry                = pipeline_layout;
+    m_pipeline_layouts_created++;
+
+    return pipeline_layout;
+  }
+
+  VulkanLayoutCacheStats VulkanLayoutCache::get_stats() const
+  {
+    return { m_set_layouts_created.load(),
+             m_set_layouts_shared.load(),
+             m_pipeline_layouts_created.load(),
+             m_pipeline_layouts_shared.load() };
+  }
+} // namespace esp
+
+/* --------------------------------------------------------- */
+/* ------------------ HELPFUL FUNCTIONS -------------------- */
+/* --------------------------------------------------------- */
+
+static size_t hash_bindings(const std::vector<VkDescriptorSetLayoutBinding>& bindings)
+{
+  size_t seed = 0;
+  for (const auto& binding : bindings)
+  {
+    esp::hash_combine(seed, binding.binding);
+    esp::hash_combine(seed, binding.descriptorType);
+    esp::hash_combine(seed, binding.descriptorCount);
+    esp::hash_combine(seed, binding.stageFlags);
+  }
+
+  return seed;
+}
+
+static size_t hash_pipeline_layout(const std::vector<std::shared_ptr<esp::VulkanDescriptorSetLayout>>& set_layouts,
+                                   const std::vector<VkPushConstantRange>& push_ranges)
+{
+  size_t seed = 0;
+  for (const auto& set_layout : set_layouts)
+  {
+    esp::hash_combine(seed, set_layout->get_hash());
+  }
+  for (const auto& push_range : push_ranges)
+  {
+    esp::hash_combine(seed, push_range.stageFlags);
+    esp::hash_combine(seed, push_range.offset);
+    esp::hash_combine(seed, push_range.size);
+  }
+
+  return seed;
+}
+
+static bool are_bindings_equal(const std::vector<VkDescriptorSetLayoutBinding>& a,
+                               const std::vector<VkDescriptorSetLayoutBinding>& b)
+{
+  return std::equal(a.begin(),
+                    a.end(),
+                    b.begin(),
+                    b.end(),
+                    [](const VkDescriptorSetLayoutBinding& x, const VkDescriptorSetLayoutBinding& y)
+                    {
+                      return x.binding == y.binding && x.descriptorType == y.descriptorType &&
+                          x.descriptorCount == y.descriptorCount && x.stageFlags == y.stageFlags;
+                    });
+}
+
+static bool are_push_ranges_equal(const std::vector<VkPushConstantRange>& a,
+                                  const std::vector<VkPushConstantRange>& b)
+{
+  return std::equal(a.begin(),
+                    a.end(),
+                    b.begin(),
+                    b.end(),
+                    [](const VkPushConstantRange& x, const VkPushConstantRange& y)
+                    { return x.stageFlags == y.stageFlags && x.offset == y.offset && x.size == y.size; });
+}
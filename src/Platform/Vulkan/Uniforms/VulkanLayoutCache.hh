@@ -0,0 +1,159 @@
+#ifndef PLATFORM_VULKAN_RENDER_API_VULKAN_LAYOUT_CACHE_HH
+#define PLATFORM_VULKAN_RENDER_API_VULKAN_LAYOUT_CACHE_HH
+
+#include "esppch.hh"
+
+// std
+#include <atomic>
+#include <mutex>
+
+namespace esp
+{
+  /// @brief VkDescriptorSetLayout shared by all shaders describing the same set. It is destroyed with its last
+  /// reference.
+  class VulkanDescriptorSetLayout
+  {
+   private:
+    VkDevice m_device;
+    VkDescriptorSetLayout m_descriptor_set_layout;
+    size_t m_hash;
+    std::vector<VkDescriptorSetLayoutBinding> m_bindings;
+
+   public:
+    /// @brief Creates descriptor set layout from the bindings.
+    /// @param device Logical device.
+    /// @param bindings Bindings of the set. Immutable samplers aren't supported.
+    /// @param hash Hash of the bindings.
+    /// @param flags Flags of the layout.
+    /// @param binding_flags Flags of every binding (VK_EXT_descriptor_indexing). Empty if bindings don't have flags.
+    VulkanDescriptorSetLayout(VkDevice device,
+                              std::vector<VkDescriptorSetLayoutBinding> bindings,
+                              size_t hash,
+                              VkDescriptorSetLayoutCreateFlags flags                        = 0,
+                              const std::vector<VkDescriptorBindingFlagsEXT>& binding_flags = {});
+    /// @brief Destroys descriptor set layout.
+    ~VulkanDescriptorSetLayout();
+
+    PREVENT_COPY(VulkanDescriptorSetLayout);
+
+    /// @brief Returns Vulkan's descriptor set layout.
+    /// @return Vulkan's descriptor set layout.
+    inline VkDescriptorSetLayout get_descriptor_set_layout() const { return m_descriptor_set_layout; }
+    /// @brief Returns hash of the bindings the layout was created from.
+    /// @return Hash of the bindings.
+    inline size_t get_hash() const { return m_hash; }
+    /// @brief Returns bindings the layout was created from.
+    /// @return Vector of bindings.
+    inline const std::vector<VkDescriptorSetLayoutBinding>& get_bindings() const { return m_bindings; }
+  };
+
+  /// @brief VkPipelineLayout shared by all shaders with the same descriptor set layouts and push constant ranges. It
+  /// keeps its descriptor set layouts alive and is destroyed with its last reference.
+  class VulkanPipelineLayout
+  {
+   private:
+    VkDevice m_device;
+    VkPipelineLayout m_pipeline_layout;
+    size_t m_hash;
+    std::vector<std::shared_ptr<VulkanDescriptorSetLayout>> m_set_layouts;
+    std::vector<VkPushConstantRange> m_push_ranges;
+
+   public:
+    /// @brief Creates pipeline layout from the descriptor set layouts and push constant ranges.
+    /// @param device Logical device.
+    /// @param set_layouts Descriptor set layouts ordered by set index.
+    /// @param push_ranges Push constant ranges.
+    /// @param hash Hash of the layout's description.
+    VulkanPipelineLayout(VkDevice device,
+                         std::vector<std::shared_ptr<VulkanDescriptorSetLayout>> set_layouts,
+                         std::vector<VkPushConstantRange> push_ranges,
+                         size_t hash);
+    /// @brief Destroys pipeline layout.
+    ~VulkanPipelineLayout();
+
+    PREVENT_COPY(VulkanPipelineLayout);
+
+    /// @brief Returns Vulkan's pipeline layout.
+    /// @return Vulkan's pipeline layout.
+    inline VkPipelineLayout get_pipeline_layout() const { return m_pipeline_layout; }
+    /// @brief Returns hash of the layout's description.
+    /// @return Hash of the layout's description.
+    inline size_t get_hash() const { return m_hash; }
+    /// @brief Returns descriptor set layouts ordered by set index.
+    /// @return Vector of descriptor set layouts.
+    inline const std::vector<std::shared_ptr<VulkanDescriptorSetLayout>>& get_set_layouts() const
+    {
+      return m_set_layouts;
+    }
+    /// @brief Returns push constant ranges.
+    /// @return Vector of push constant ranges.
+    inline const std::vector<VkPushConstantRange>& get_push_ranges() const { return m_push_ranges; }
+  };
+
+  /// @brief Counters describing the layout cache since it was created.
+  struct VulkanLayoutCacheStats
+  {
+    /// @brief Number of descriptor set layouts created.
+    uint32_t m_set_layouts_created = 0;
+    /// @brief Number of descriptor set layout requests served by layout that already existed.
+    uint32_t m_set_layouts_shared = 0;
+    /// @brief Number of pipeline layouts created.
+    uint32_t m_pipeline_layouts_created = 0;
+    /// @brief Number of pipeline layout requests served by layout that already existed.
+    uint32_t m_pipeline_layouts_shared = 0;
+  };
+
+  /// @brief Cache of descriptor set layouts and pipeline layouts keyed by hash of their description. Shaders with the
+  /// same uniforms get the same layouts, so their pipelines are compatible and descriptor sets bound for one of them
+  /// stay valid after binding another. It keeps only weak references, so layouts are destroyed when no shader uses
+  /// them.
+  class VulkanLayoutCache
+  {
+   private:
+    VkDevice m_device;
+
+    std::mutex m_mutex;
+    std::unordered_map<size_t, std::weak_ptr<VulkanDescriptorSetLayout>> m_set_layouts;
+    std::unordered_map<size_t, std::weak_ptr<VulkanPipelineLayout>> m_pipeline_layouts;
+
+    std::atomic<uint32_t> m_set_layouts_created      = 0;
+    std::atomic<uint32_t> m_set_layouts_shared       = 0;
+    std::atomic<uint32_t> m_pipeline_layouts_created = 0;
+    std::atomic<uint32_t> m_pipeline_layouts_shared  = 0;
+
+   public:
+    /// @brief Creates empty layout cache.
+    /// @param device Logical device.
+    /// @return Unique pointer to the layout cache.
+    static std::unique_ptr<VulkanLayoutCache> create(VkDevice device);
+
+    PREVENT_COPY(VulkanLayoutCache);
+
+    /// @brief Logs statistics and forgets all layouts. Layouts still in use stay valid.
+    void terminate();
+
+    /// @brief Returns descriptor set layout with the bindings. Creates it if it doesn't exist. Can be called from
+    /// many threads.
+    /// @param bindings Bindings of the set. Immutable samplers aren't supported.
+    /// @return Shared pointer to the descriptor set layout.
+    std::shared_ptr<VulkanDescriptorSetLayout> acquire_descriptor_set_layout(
+        const std::vector<VkDescriptorSetLayoutBinding>& bindings);
+    /// @brief Returns pipeline layout with the descriptor set layouts and push constant ranges. Creates it if it
+    /// doesn't exist. Can be called from many threads.
+    /// @param set_layouts Descriptor set layouts ordered by set index.
+    /// @param push_ranges Push constant ranges.
+    /// @return Shared pointer to the pipeline layout.
+    std::shared_ptr<VulkanPipelineLayout> acquire_pipeline_layout(
+        const std::vector<std::shared_ptr<VulkanDescriptorSetLayout>>& set_layouts,
+        const std::vector<VkPushConstantRange>& push_ranges);
+
+    /// @brief Returns statistics of the cache.
+    /// @return Statistics of the cache.
+    VulkanLayoutCacheStats get_stats() const;
+
+   private:
+    VulkanLayoutCache(VkDevice device);
+  };
+} // namespace esp
+
+#endif // PLATFORM_VULKAN_RENDER_API_VULKAN_LAYOUT_CACHE_HH
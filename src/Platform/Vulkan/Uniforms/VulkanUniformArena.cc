@@ -0,0 +1,36 @@
+#include "VulkanUniformArena.hh"
+
+// platform
+#include "Platform/Vulkan/VulkanDevice.hh"
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  std::unique_ptr<VulkanUniformArena> VulkanUniformArena::create(uint64_t frame_size, uint32_t frames_in_flight)
+  {
+    auto alignment = VulkanDevice::get_properties().limits.minUniformBufferOffsetAlignment;
+    return std::unique_ptr<VulkanUniformArena>(
+        new VulkanUniformArena(frame_size, std::max<uint64_t>(alignment, 1), frames_in_flight));
+  }
+
+  VulkanUniformArena::VulkanUniformArena(uint64_t frame_size, uint64_t alignment, uint32_t frames_in_flight) :
+      EspUniformArena(frame_size, alignment, frames_in_flight)
+  {
+    m_buffer = std::make_unique<VulkanBuffer>(get_size(),
+                                              1,
+                                              VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                                              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                  VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    m_buffer->map();
+  }
+
+  void VulkanUniformArena::write(uint64_t offset, const void* data, uint32_t size)
+  {
+    m_buffer->write_to_buffer(data, size, offset);
+  }
+
+  void VulkanUniformArena::destroy() { m_buffer.reset(); }
+} // namespace esp
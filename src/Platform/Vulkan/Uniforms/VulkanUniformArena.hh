@@ -0,0 +1,42 @@
+#ifndef PLATFORM_VULKAN_RENDER_API_VULKAN_UNIFORM_ARENA_HH
+#define PLATFORM_VULKAN_RENDER_API_VULKAN_UNIFORM_ARENA_HH
+
+#include "esppch.hh"
+
+// Render API
+#include "Core/RenderAPI/Uniforms/EspUniformArena.hh"
+
+// Render API Vulkan
+#include "Platform/Vulkan/Resources/VulkanBuffer.hh"
+
+namespace esp
+{
+  /// @brief Uniform arena kept in one host visible, coherent and persistently mapped uniform buffer. Allocations are
+  /// aligned to the device's minimal uniform buffer offset alignment, so they can be used as dynamic offsets of
+  /// VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC bindings.
+  class VulkanUniformArena : public EspUniformArena
+  {
+   private:
+    std::unique_ptr<VulkanBuffer> m_buffer;
+
+   public:
+    /// @brief Creates arena and maps its buffer.
+    /// @param frame_size Size of the region of a single frame.
+    /// @param frames_in_flight Number of frames the GPU may be working on at once.
+    /// @return Unique pointer to the arena.
+    static std::unique_ptr<VulkanUniformArena> create(uint64_t frame_size, uint32_t frames_in_flight);
+
+    /// @brief Returns the buffer of the arena.
+    /// @return Buffer dynamic uniform bindings point to.
+    inline VkBuffer get_buffer() const { return m_buffer->get_buffer(); }
+
+   protected:
+    virtual void write(uint64_t offset, const void* data, uint32_t size) override;
+    virtual void destroy() override;
+
+   private:
+    VulkanUniformArena(uint64_t frame_size, uint64_t alignment, uint32_t frames_in_flight);
+  };
+} // namespace esp
+
+#endif // PLATFORM_VULKAN_RENDER_API_VULKAN_UNIFORM_ARENA_HH
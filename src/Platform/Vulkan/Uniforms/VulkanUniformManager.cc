@@ -4,6 +4,7 @@
 #include "Platform/Vulkan/VulkanDevice.hh"
 #include "Platform/Vulkan/VulkanResourceManager.hh"
 #include "Platform/Vulkan/Work/VulkanSwapChain.hh"
+#include "VulkanBindlessTextures.hh"
 
 /* --------------------------------------------------------- */
 /* ----------------- VulkanUniformManager ------------------ */
@@ -11,81 +12,78 @@
 namespace esp
 {
   VulkanUniformManager::VulkanUniformManager(const EspUniformDataStorage& uniform_data_storage,
-                                             const VkPipelineLayout& out_pipeline_layout,
+                                             VkPipelineLayout out_pipeline_layout,
                                              int first_descriptor_set,
-                                             int last_descriptor_set) :
+                                             int last_descriptor_set,
+                                             VkPipelineBindPoint bind_point) :
+      m_bind_point{ bind_point },
       m_out_pipeline_layout{ out_pipeline_layout },
       m_out_uniform_data_storage{ uniform_data_storage }, m_first_descriptor_set{ first_descriptor_set },
       m_last_descriptor_set{ last_descriptor_set }
   {
-    init_pool();
   }
 
   VulkanUniformManager::~VulkanUniformManager()
   {
-    vkDestroyDescriptorPool(VulkanDevice::get_logical_device(), m_descriptor_pool, nullptr);
-
     for (auto& package : m_packages)
     {
       delete package;
     }
   }
 
-  void VulkanUniformManager::init_pool()
+  void VulkanUniformManager::build()
   {
-    auto& meta_data = m_out_uniform_data_storage.m_meta_data;
-    std::vector<VkDescriptorPoolSize> pool_sizes;
+    create_storage_buffers();
 
-    int general_buffer_uniform_counter =
-        meta_data->count_buffer_uniforms(m_first_descriptor_set, m_last_descriptor_set);
-
-    if (general_buffer_uniform_counter != 0)
+    for (uint32_t frame_idx = 0; frame_idx < VulkanSwapChain::get_frames_in_flight(); ++frame_idx)
     {
-      VkDescriptorPoolSize pool_size{};
-      pool_size.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-      pool_size.descriptorCount =
-          static_cast<uint32_t>(general_buffer_uniform_counter * VulkanSwapChain::MAX_FRAMES_IN_FLIGHT);
+      // each frame binds its own copy of read only storage buffers
+      auto storage_buffers = m_storage_buffers;
+      for (auto& [set_binding, owned_buffer] : m_owned_storage_buffers)
+      {
+        auto index = owned_buffer.m_buffers.size() == 1 ? 0 : frame_idx;
+        storage_buffers[set_binding.first][set_binding.second] = { owned_buffer.m_buffers[index].get() };
+      }
 
-      pool_sizes.push_back(pool_size);
+      m_packages.push_back(new EspUniformPackage(m_out_uniform_data_storage,
+                                                 m_textures,
+                                                 storage_buffers,
+                                                 m_first_descriptor_set,
+                                                 m_last_descriptor_set));
     }
+  }
 
-    int general_texture_uniform_counter =
-        meta_data->count_texture_uniforms(m_first_descriptor_set, m_last_descriptor_set);
-    if (general_texture_uniform_counter != 0)
-    {
-      VkDescriptorPoolSize pool_size{};
-      pool_size.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-      pool_size.descriptorCount =
-          static_cast<uint32_t>(general_texture_uniform_counter * VulkanSwapChain::MAX_FRAMES_IN_FLIGHT);
-
-      pool_sizes.push_back(pool_size);
-    }
+  void VulkanUniformManager::create_storage_buffers()
+  {
+    const auto& meta_data = *m_out_uniform_data_storage.m_meta_data;
 
-    VkDescriptorPoolCreateInfo pool_info{};
-    pool_info.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    pool_info.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
-    pool_info.pPoolSizes    = pool_sizes.data();
-    pool_info.maxSets       = static_cast<uint32_t>(
-        (general_buffer_uniform_counter + general_texture_uniform_counter + meta_data->m_general_push_uniform_counter) *
-        VulkanSwapChain::MAX_FRAMES_IN_FLIGHT);
+    int start_ds = m_first_descriptor_set == -1 ? 0 : m_first_descriptor_set;
+    int end_ds   = m_last_descriptor_set == -1 ? meta_data.m_meta_descriptor_sets.size() : (m_last_descriptor_set + 1);
 
-    if (vkCreateDescriptorPool(VulkanDevice::get_logical_device(), &pool_info, nullptr, &m_descriptor_pool) !=
-        VK_SUCCESS)
+    for (int ds_idx = start_ds; ds_idx < end_ds; ds_idx++)
     {
-      ESP_CORE_ERROR("Failed to create descriptor pool!");
-      throw std::runtime_error("Failed to create descriptor pool!");
-    }
-  }
+      const auto& meta_ds = meta_data.m_meta_descriptor_sets[ds_idx];
+      for (auto& uniform : meta_ds.m_meta_uniforms)
+      {
+        // storage buffers without size are loaded by the user
+        if (uniform.m_uniform_type != EspUniformType::ESP_STORAGE_BUFFER || uniform.m_size_of_data_chunk == 0)
+        {
+          continue;
+        }
+        ESP_ASSERT(!m_storage_buffers[meta_ds.m_set_index].contains(uniform.m_binding),
+                   "Storage buffer created by the manager can't be loaded.")
 
-  void VulkanUniformManager::build()
-  {
-    for (int frame_idx = 0; frame_idx < VulkanSwapChain::MAX_FRAMES_IN_FLIGHT; ++frame_idx)
-    {
-      m_packages.push_back(new EspUniformPackage(m_out_uniform_data_storage,
-                                                 m_descriptor_pool,
-                                                 m_textures,
-                                                 m_first_descriptor_set,
-                                                 m_last_descriptor_set));
+        // buffers written by shaders are shared by all frames, so the results persist
+        uint32_t count = uniform.m_access == EspStorageBufferAccess::ESP_READ_ONLY
+            ? VulkanSwapChain::get_frames_in_flight()
+            : 1;
+
+        auto& owned_buffer = m_owned_storage_buffers[{ meta_ds.m_set_index, uniform.m_binding }];
+        for (uint32_t i = 0; i < count; i++)
+        {
+          owned_buffer.m_buffers.push_back(VulkanStorageBuffer::create(uniform.m_size_of_data_chunk, nullptr));
+        }
+      }
     }
   }
 } // namespace esp
@@ -123,44 +121,52 @@ namespace esp
     }
   }
 
-  EspUniformPackage::EspUniformPackage(
-      const EspUniformDataStorage& uniform_data_storage,
-      const VkDescriptorPool& descriptor_pool,
-      std::map<uint32_t, std::map<uint32_t, std::vector<std::shared_ptr<VulkanTexture>>>>& textures,
-      int first_descriptor_set,
-      int last_descriptor_set)
+  EspUniformPackage::EspUniformPackage(const EspUniformDataStorage& uniform_data_storage,
+                                       EspTexturesMap& textures,
+                                       EspStorageBuffersMap& storage_buffers,
+                                       int first_descriptor_set,
+                                       int last_descriptor_set)
   {
     m_first_descriptor_set_idx = first_descriptor_set == -1 ? 0 : first_descriptor_set;
-    auto end_ds      = last_descriptor_set == -1 ? uniform_data_storage.get_layouts_count() : (last_descriptor_set + 1);
-    auto count_of_ds = end_ds - m_first_descriptor_set_idx;
-
-    VkDescriptorSetAllocateInfo alloc_info{};
-    alloc_info.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    alloc_info.descriptorPool     = descriptor_pool;
-    alloc_info.descriptorSetCount = count_of_ds;
-    alloc_info.pSetLayouts        = uniform_data_storage.get_layouts_data() + m_first_descriptor_set_idx;
-
-    m_descriptor_sets.resize(count_of_ds);
-    if (vkAllocateDescriptorSets(VulkanDevice::get_logical_device(), &alloc_info, m_descriptor_sets.data()) !=
-        VK_SUCCESS)
-    {
-      ESP_CORE_ERROR("Failed to allocate descriptor sets!");
-      throw std::runtime_error("Failed to allocate descriptor sets!");
-    }
+    auto end_ds = last_descriptor_set == -1 ? uniform_data_storage.get_layouts_count() : (last_descriptor_set + 1);
 
+    // sets come from pools shared by all managers
+    auto& descriptor_allocator = VulkanDevice::get_descriptor_allocator();
     for (int meta_ds_idx = m_first_descriptor_set_idx; meta_ds_idx < end_ds; meta_ds_idx++)
     {
       const auto& meta_ds = uniform_data_storage.m_meta_data->m_meta_descriptor_sets[meta_ds_idx];
 
+      // the bindless set is owned and updated by VulkanBindlessTextures
+      if (meta_ds.m_bindless)
+      {
+        m_descriptor_set_layouts.push_back(nullptr);
+        m_descriptor_sets.push_back(VulkanBindlessTextures::get_descriptor_set());
+        continue;
+      }
+
+      auto& layout = uniform_data_storage.m_set_layouts[meta_ds_idx];
+      m_descriptor_set_layouts.push_back(layout);
+      m_descriptor_sets.push_back(descriptor_allocator.allocate(layout->get_descriptor_set_layout()));
+
       if (meta_ds.m_buffer_uniform_counter != 0)
       {
         m_set_to_bufferset[meta_ds.m_set_index] = new EspBufferSet(meta_ds.m_meta_uniforms);
       }
 
+      for (auto& uniform : meta_ds.m_meta_uniforms)
+      {
+        if (uniform.m_uniform_type == EspUniformType::ESP_DYNAMIC_BUFFER_UNIFORM)
+        {
+          m_set_binding_to_dynamic_offset[{ meta_ds.m_set_index, uniform.m_binding }] = m_dynamic_offsets.size();
+          m_dynamic_offsets.push_back(0);
+        }
+      }
+
       update_descriptor_set(*(m_set_to_bufferset[meta_ds.m_set_index]),
-                            m_descriptor_sets[meta_ds.m_set_index - m_first_descriptor_set_idx],
+                            m_descriptor_sets.back(),
                             meta_ds.m_meta_uniforms,
-                            textures[meta_ds.m_set_index]);
+                            textures[meta_ds.m_set_index],
+                            storage_buffers[meta_ds.m_set_index]);
     }
   }
 
@@ -170,13 +176,23 @@ namespace esp
     {
       delete val;
     }
+
+    auto& descriptor_allocator = VulkanDevice::get_descriptor_allocator();
+    for (uint32_t i = 0; i < m_descriptor_sets.size(); i++)
+    {
+      if (m_descriptor_set_layouts[i])
+      {
+        descriptor_allocator.free(m_descriptor_set_layouts[i]->get_descriptor_set_layout(), m_descriptor_sets[i]);
+      }
+    }
   }
 
   void EspUniformPackage::update_descriptor_set(
       EspBufferSet& buffer_set,
       const VkDescriptorSet& descriptor,
       const std::vector<EspMetaUniform>& uniforms,
-      std::map<uint32_t, std::vector<std::shared_ptr<VulkanTexture>>>& vec_textures)
+      std::map<uint32_t, std::vector<std::shared_ptr<VulkanTexture>>>& vec_textures,
+      std::map<uint32_t, std::vector<VulkanStorageBuffer*>>& vec_storage_buffers)
   {
     // these objects have to exist until updating ds
     std::vector<VkWriteDescriptorSet> descriptor_writes;
@@ -210,6 +226,26 @@ namespace esp
 
         descriptor_writes.push_back(descriptor_write);
       }
+      else if (uniform.m_uniform_type == EspUniformType::ESP_DYNAMIC_BUFFER_UNIFORM)
+      {
+        // data is selected by the dynamic offset when the set is bound
+        VkDescriptorBufferInfo buffer_info{};
+        buffer_info.buffer = VulkanWorkOrchestrator::get_uniform_arena().get_buffer();
+        buffer_info.offset = 0;
+        buffer_info.range  = uniform.m_size_of_data_chunk;
+        all_buffer_infos.push_back({ buffer_info });
+
+        VkWriteDescriptorSet descriptor_write{};
+        descriptor_write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptor_write.dstSet          = descriptor;
+        descriptor_write.dstBinding      = uniform.m_binding;
+        descriptor_write.dstArrayElement = 0;
+        descriptor_write.descriptorType  = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        descriptor_write.descriptorCount = 1;
+        descriptor_write.pBufferInfo     = all_buffer_infos.back().data();
+
+        descriptor_writes.push_back(descriptor_write);
+      }
       else if (uniform.m_uniform_type == EspUniformType::ESP_TEXTURE)
       {
         std::vector<VkDescriptorImageInfo> image_infos{};
@@ -235,6 +271,60 @@ namespace esp
         descriptor_write.descriptorCount = uniform.m_number_of_elements;
         descriptor_write.pImageInfo      = all_image_infos.back().data();
 
+        descriptor_writes.push_back(descriptor_write);
+      }
+      else if (uniform.m_uniform_type == EspUniformType::ESP_STORAGE_BUFFER)
+      {
+        ESP_ASSERT(vec_storage_buffers[uniform.m_binding].size() >= uniform.m_number_of_elements,
+                   "You forgot to load storage buffers of the binding.")
+        std::vector<VkDescriptorBufferInfo> buffer_infos{};
+
+        for (int elem_idx = 0; elem_idx < uniform.m_number_of_elements; elem_idx++)
+        {
+          VkDescriptorBufferInfo buffer_info{};
+          buffer_info.buffer = vec_storage_buffers[uniform.m_binding][elem_idx]->get_buffer();
+          buffer_info.offset = 0;
+          buffer_info.range  = VK_WHOLE_SIZE;
+          buffer_infos.push_back(buffer_info);
+        }
+        all_buffer_infos.push_back(buffer_infos);
+
+        VkWriteDescriptorSet descriptor_write{};
+        descriptor_write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptor_write.dstSet          = descriptor;
+        descriptor_write.dstBinding      = uniform.m_binding;
+        descriptor_write.dstArrayElement = 0;
+        descriptor_write.descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        descriptor_write.descriptorCount = uniform.m_number_of_elements;
+        descriptor_write.pBufferInfo     = all_buffer_infos.back().data();
+
+        descriptor_writes.push_back(descriptor_write);
+      }
+      else if (uniform.m_uniform_type == EspUniformType::ESP_STORAGE_IMAGE)
+      {
+        ESP_ASSERT(vec_textures[uniform.m_binding].size() >= uniform.m_number_of_elements,
+                   "You forgot to load storage images of the binding.")
+        std::vector<VkDescriptorImageInfo> image_infos{};
+
+        // storage images are accessed without a sampler, in the layout they are written in
+        for (int elem_idx = 0; elem_idx < uniform.m_number_of_elements; elem_idx++)
+        {
+          VkDescriptorImageInfo image_info{};
+          image_info.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+          image_info.imageView   = vec_textures[uniform.m_binding][elem_idx]->get_texture_image_view();
+          image_infos.push_back(image_info);
+        }
+        all_image_infos.push_back(image_infos);
+
+        VkWriteDescriptorSet descriptor_write{};
+        descriptor_write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptor_write.dstSet          = descriptor;
+        descriptor_write.dstBinding      = uniform.m_binding;
+        descriptor_write.dstArrayElement = 0;
+        descriptor_write.descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        descriptor_write.descriptorCount = uniform.m_number_of_elements;
+        descriptor_write.pImageInfo      = all_image_infos.back().data();
+
         descriptor_writes.push_back(descriptor_write);
       }
     }
@@ -9,12 +9,18 @@
 // Render API Vulkan
 #include "EspUniformDataStorage.hh"
 #include "Platform/Vulkan/RenderPlans/VulkanCommandBuffer.hh"
+#include "Platform/Vulkan/Resources/VulkanStorageBuffer.hh"
 #include "Platform/Vulkan/Resources/VulkanTexture.hh"
 #include "Platform/Vulkan/Work/VulkanSwapChain.hh"
 #include "Platform/Vulkan/Work/VulkanWorkOrchestrator.hh"
 
 namespace esp
 {
+  // <set, <binding, vector<texture> >>
+  using EspTexturesMap = std::map<uint32_t, std::map<uint32_t, std::vector<std::shared_ptr<VulkanTexture>>>>;
+  // <set, <binding, vector<storage buffer> >>
+  using EspStorageBuffersMap = std::map<uint32_t, std::map<uint32_t, std::vector<VulkanStorageBuffer*>>>;
+
   struct EspUniformPackage
   {
    private:
@@ -37,6 +43,12 @@ namespace esp
    private:
     std::map<uint32_t, EspBufferSet*> m_set_to_bufferset;
     std::vector<VkDescriptorSet> m_descriptor_sets;
+    // layouts live until the sets are returned to the allocator, whose free-lists are keyed by their handles
+    std::vector<std::shared_ptr<VulkanDescriptorSetLayout>> m_descriptor_set_layouts;
+
+    // Offsets of dynamic buffer uniforms ordered by set and binding, as vkCmdBindDescriptorSets expects them.
+    std::vector<uint32_t> m_dynamic_offsets;
+    std::map<std::pair<uint32_t, uint32_t>, uint32_t> m_set_binding_to_dynamic_offset;
 
     int m_first_descriptor_set_idx;
 
@@ -44,42 +56,61 @@ namespace esp
     void update_descriptor_set(EspBufferSet& buffer_set,
                                const VkDescriptorSet& descriptor,
                                const std::vector<EspMetaUniform>& uniforms,
-                               std::map<uint32_t, std::vector<std::shared_ptr<VulkanTexture>>>& vec_textures);
+                               std::map<uint32_t, std::vector<std::shared_ptr<VulkanTexture>>>& vec_textures,
+                               std::map<uint32_t, std::vector<VulkanStorageBuffer*>>& vec_storage_buffers);
 
    public:
-    inline void attach(const VkPipelineLayout& pipeline_layout) const
+    inline void attach(VkPipelineBindPoint bind_point, const VkPipelineLayout& pipeline_layout) const
     {
-      vkCmdBindDescriptorSets(VulkanWorkOrchestrator::get_current_command_buffer(),
-                              VK_PIPELINE_BIND_POINT_GRAPHICS,
-                              pipeline_layout,
-                              m_first_descriptor_set_idx,
-                              static_cast<uint32_t>(m_descriptor_sets.size()),
-                              m_descriptor_sets.data(),
-                              0,
-                              nullptr);
+      attach(VulkanWorkOrchestrator::get_current_command_buffer(),
+             bind_point,
+             pipeline_layout,
+             m_dynamic_offsets.data(),
+             static_cast<uint32_t>(m_dynamic_offsets.size()));
+    }
+
+    inline void attach(EspCommandBufferId* id,
+                       VkPipelineBindPoint bind_point,
+                       const VkPipelineLayout& pipeline_layout) const
+    {
+      attach(static_cast<VulkanCommandBufferId*>(id)->m_command_buffer,
+             bind_point,
+             pipeline_layout,
+             m_dynamic_offsets.data(),
+             static_cast<uint32_t>(m_dynamic_offsets.size()));
     }
 
-    inline void attach(EspCommandBufferId* id, const VkPipelineLayout& pipeline_layout) const
+    inline void attach(VkCommandBuffer command_buffer,
+                       VkPipelineBindPoint bind_point,
+                       const VkPipelineLayout& pipeline_layout,
+                       const uint32_t* dynamic_offsets,
+                       uint32_t count) const
     {
-      vkCmdBindDescriptorSets(static_cast<VulkanCommandBufferId*>(id)->m_command_buffer,
-                              VK_PIPELINE_BIND_POINT_GRAPHICS,
+      ESP_ASSERT(count == m_dynamic_offsets.size(), "Every dynamic buffer uniform needs an offset.")
+      vkCmdBindDescriptorSets(command_buffer,
+                              bind_point,
                               pipeline_layout,
                               m_first_descriptor_set_idx,
                               static_cast<uint32_t>(m_descriptor_sets.size()),
                               m_descriptor_sets.data(),
-                              0,
-                              nullptr);
+                              count,
+                              dynamic_offsets);
     }
 
     inline EspBufferSet& operator[](int set_idx) { return *(m_set_to_bufferset[set_idx]); }
 
+    inline void set_dynamic_offset(uint32_t set, uint32_t binding, uint32_t offset)
+    {
+      m_dynamic_offsets[m_set_binding_to_dynamic_offset.at({ set, binding })] = offset;
+    }
+
    public:
     EspUniformPackage& operator=(const EspUniformPackage& other) = delete;
     EspUniformPackage(const EspUniformPackage& other)            = delete;
 
     EspUniformPackage(const EspUniformDataStorage& uniform_data_storage,
-                      const VkDescriptorPool& descriptor_pool,
-                      std::map<uint32_t, std::map<uint32_t, std::vector<std::shared_ptr<VulkanTexture>>>>& textures,
+                      EspTexturesMap& textures,
+                      EspStorageBuffersMap& storage_buffers,
                       int first_descriptor_set,
                       int last_descriptor_set);
     ~EspUniformPackage();
@@ -88,16 +119,25 @@ namespace esp
   class VulkanUniformManager : public EspUniformManager
   {
     friend class VulkanWorker;
+    friend class VulkanComputeWorker;
 
    private:
-    // <set, <binding, vector<texture> >>
-    std::map<uint32_t, std::map<uint32_t, std::vector<std::shared_ptr<VulkanTexture>>>> m_textures;
-    std::vector<EspUniformPackage*> m_packages;
+    // Storage buffer created by the manager. Read only buffers have a copy per frame in flight.
+    struct EspOwnedStorageBuffer
+    {
+      std::vector<std::unique_ptr<VulkanStorageBuffer>> m_buffers;
+    };
 
-    VkDescriptorPool m_descriptor_pool;
+   private:
+    EspTexturesMap m_textures;
+    EspStorageBuffersMap m_storage_buffers;
+    // <<set, binding>, buffer>
+    std::map<std::pair<uint32_t, uint32_t>, EspOwnedStorageBuffer> m_owned_storage_buffers;
+    std::vector<EspUniformPackage*> m_packages;
 
-    // These references come from this object's parent pipeline.
-    const VkPipelineLayout& m_out_pipeline_layout;
+    // These come from this object's parent pipeline. The pipeline layout is shared, so it is kept by value.
+    VkPipelineBindPoint m_bind_point;
+    VkPipelineLayout m_out_pipeline_layout;
     const EspUniformDataStorage& m_out_uniform_data_storage;
 
     int m_first_descriptor_set;
@@ -106,24 +146,46 @@ namespace esp
     int m_last_descriptor_set;
 
    private:
-    void init_pool();
-
     VulkanUniformManager(const EspUniformDataStorage& uniform_data_storage,
-                         const VkPipelineLayout& out_pipeline_layout,
+                         VkPipelineLayout out_pipeline_layout,
                          int first_descriptor_set,
-                         int last_descriptor_set);
+                         int last_descriptor_set,
+                         VkPipelineBindPoint bind_point = VK_PIPELINE_BIND_POINT_GRAPHICS);
+
+   private:
+    void create_storage_buffers();
 
    public:
     void build() override;
 
     inline virtual void attach() const override
     {
-      m_packages[VulkanSwapChain::get_current_frame_index()]->attach(m_out_pipeline_layout);
+      m_packages[VulkanSwapChain::get_current_frame_index()]->attach(m_bind_point, m_out_pipeline_layout);
     }
 
     inline virtual void attach(EspCommandBufferId* id) const override
     {
-      m_packages[VulkanSwapChain::get_current_frame_index()]->attach(id, m_out_pipeline_layout);
+      m_packages[VulkanSwapChain::get_current_frame_index()]->attach(id, m_bind_point, m_out_pipeline_layout);
+    }
+
+    inline virtual void attach(const uint32_t* dynamic_offsets, uint32_t count) const override
+    {
+      m_packages[VulkanSwapChain::get_current_frame_index()]->attach(
+          VulkanWorkOrchestrator::get_current_command_buffer(),
+          m_bind_point,
+          m_out_pipeline_layout,
+          dynamic_offsets,
+          count);
+    }
+
+    inline virtual void attach(EspCommandBufferId* id, const uint32_t* dynamic_offsets, uint32_t count) const override
+    {
+      m_packages[VulkanSwapChain::get_current_frame_index()]->attach(
+          static_cast<VulkanCommandBufferId*>(id)->m_command_buffer,
+          m_bind_point,
+          m_out_pipeline_layout,
+          dynamic_offsets,
+          count);
     }
 
     inline virtual EspUniformManager& update_buffer_uniform(uint32_t set,
@@ -144,13 +206,32 @@ namespace esp
                                                          uint32_t size,
                                                          void* data) override
     {
-      for (int frame_idx = 0; frame_idx < VulkanSwapChain::MAX_FRAMES_IN_FLIGHT; frame_idx++)
+      for (uint32_t frame_idx = 0; frame_idx < VulkanSwapChain::get_frames_in_flight(); frame_idx++)
       {
         m_packages[frame_idx]->operator[](set)[binding].write_to_buffer(data, size, offset);
       }
       return *this;
     }
 
+    inline virtual uint32_t update_dynamic_buffer_uniform(uint32_t set,
+                                                          uint32_t binding,
+                                                          uint32_t size,
+                                                          void* data) override
+    {
+      auto offset = VulkanWorkOrchestrator::get_uniform_arena().allocate(data, size);
+      if (offset != EspUniformArena::INVALID_OFFSET)
+      {
+        m_packages[VulkanSwapChain::get_current_frame_index()]->set_dynamic_offset(set, binding, offset);
+      }
+      return offset;
+    }
+
+    inline virtual EspUniformManager& set_dynamic_offset(uint32_t set, uint32_t binding, uint32_t offset) override
+    {
+      m_packages[VulkanSwapChain::get_current_frame_index()]->set_dynamic_offset(set, binding, offset);
+      return *this;
+    }
+
     inline virtual EspUniformManager& load_texture(uint32_t set,
                                                    uint32_t binding,
                                                    std::shared_ptr<EspTexture> texture) override
@@ -161,6 +242,50 @@ namespace esp
       return *this;
     }
 
+    inline virtual EspUniformManager& update_storage_buffer(uint32_t set,
+                                                            uint32_t binding,
+                                                            uint32_t offset,
+                                                            uint32_t size,
+                                                            const void* data) override
+    {
+      auto& buffers = m_owned_storage_buffers.at({ set, binding }).m_buffers;
+      auto index    = buffers.size() == 1 ? 0 : VulkanSwapChain::get_current_frame_index();
+      buffers[index]->update(offset, size, data);
+
+      return *this;
+    }
+
+    inline virtual EspUniformManager& set_storage_buffer(uint32_t set,
+                                                         uint32_t binding,
+                                                         uint32_t offset,
+                                                         uint32_t size,
+                                                         const void* data) override
+    {
+      for (auto& buffer : m_owned_storage_buffers.at({ set, binding }).m_buffers)
+      {
+        buffer->update(offset, size, data);
+      }
+      return *this;
+    }
+
+    inline virtual EspUniformManager& load_storage_buffer(uint32_t set,
+                                                          uint32_t binding,
+                                                          EspStorageBuffer* buffer) override
+    {
+      m_storage_buffers[set][binding].emplace_back(static_cast<VulkanStorageBuffer*>(buffer));
+
+      return *this;
+    }
+
+    inline virtual EspUniformManager& load_storage_image(uint32_t set,
+                                                         uint32_t binding,
+                                                         std::shared_ptr<EspTexture> texture) override
+    {
+      m_textures[set][binding].emplace_back(std::static_pointer_cast<VulkanTexture>(texture));
+
+      return *this;
+    }
+
     inline virtual const EspUniformManager& update_push_uniform(uint32_t index, void* data) const override
     {
       auto& push_range = m_out_uniform_data_storage.m_push_constant_ranges[index];
@@ -174,7 +299,9 @@ namespace esp
       return *this;
     }
 
-    virtual EspUniformManager& update_push_uniform(EspCommandBufferId* id, uint32_t index, void* data) override
+    inline virtual const EspUniformManager& update_push_uniform(EspCommandBufferId* id,
+                                                                uint32_t index,
+                                                                void* data) const override
     {
       auto& push_range = m_out_uniform_data_storage.m_push_constant_ranges[index];
       vkCmdPushConstants(static_cast<VulkanCommandBufferId*>(id)->m_command_buffer,
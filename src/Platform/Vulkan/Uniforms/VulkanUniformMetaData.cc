@@ -11,10 +11,11 @@ namespace esp
                                  uint32_t size_of_data_chunk,
                                  uint32_t count_of_elements,
                                  uint32_t binding,
-                                 EspUniformType uniform_type) :
+                                 EspUniformType uniform_type,
+                                 EspStorageBufferAccess access) :
       m_stage{ stage },
       m_size_of_data_chunk{ size_of_data_chunk }, m_number_of_elements{ count_of_elements }, m_binding{ binding },
-      m_uniform_type{ uniform_type }
+      m_uniform_type{ uniform_type }, m_access{ access }
   {
   }
 
@@ -32,11 +33,23 @@ namespace esp
     return *this;
   }
 
+  EspUniformMetaData& VulkanUniformMetaData::establish_bindless_descriptor_set()
+  {
+    ESP_ASSERT(m_bindless_ds == -1, "Only one descriptor set can be bindless")
+
+    establish_descriptor_set();
+    m_meta_descriptor_sets.back().m_bindless = true;
+    m_bindless_ds                            = m_current_ds_counter;
+
+    return *this;
+  }
+
   EspUniformMetaData& VulkanUniformMetaData::add_buffer_uniform(EspUniformShaderStage stage,
                                                                 uint32_t size_of_data_chunk,
                                                                 uint32_t count_of_data_chunks)
   {
     ESP_ASSERT(m_current_ds_counter != -1, "You forgot to create descriptor set!!!");
+    ESP_ASSERT(!m_meta_descriptor_sets.back().m_bindless, "Bindless descriptor set can't have uniforms")
     push_back_to_current_meta_ds(EspMetaUniform(stage,
                                                 size_of_data_chunk,
                                                 count_of_data_chunks,
@@ -52,10 +65,26 @@ namespace esp
     return *this;
   }
 
+  EspUniformMetaData& VulkanUniformMetaData::add_dynamic_buffer_uniform(EspUniformShaderStage stage,
+                                                                        uint32_t size_of_data_chunk)
+  {
+    ESP_ASSERT(m_current_ds_counter != -1, "You forgot to create descriptor set!!!");
+    ESP_ASSERT(!m_meta_descriptor_sets.back().m_bindless, "Bindless descriptor set can't have uniforms")
+    push_back_to_current_meta_ds(
+        EspMetaUniform(stage, size_of_data_chunk, 1, m_binding_count, EspUniformType::ESP_DYNAMIC_BUFFER_UNIFORM));
+
+    m_binding_count += 1;
+    m_general_buffer_uniform_counter++;
+    m_meta_descriptor_sets.back().m_dynamic_buffer_uniform_counter++;
+
+    return *this;
+  }
+
   EspUniformMetaData& VulkanUniformMetaData::add_texture_uniform(EspUniformShaderStage stage,
                                                                  uint32_t count_of_textures)
   {
     ESP_ASSERT(m_current_ds_counter != -1, "You forgot to create descriptor set!!!");
+    ESP_ASSERT(!m_meta_descriptor_sets.back().m_bindless, "Bindless descriptor set can't have uniforms")
 
     push_back_to_current_meta_ds(
         EspMetaUniform(stage, 0, count_of_textures, m_binding_count, EspUniformType::ESP_TEXTURE));
@@ -67,10 +96,53 @@ namespace esp
     return *this;
   }
 
+  EspUniformMetaData& VulkanUniformMetaData::add_storage_buffer_uniform(EspUniformShaderStage stage,
+                                                                        uint32_t size_of_data_chunk,
+                                                                        uint32_t count_of_data_chunks,
+                                                                        EspStorageBufferAccess access)
+  {
+    ESP_ASSERT(m_current_ds_counter != -1, "You forgot to create descriptor set!!!");
+    ESP_ASSERT(!m_meta_descriptor_sets.back().m_bindless, "Bindless descriptor set can't have uniforms")
+
+    // all chunks of a buffer created by the manager are bound as one buffer
+    uint32_t size_of_buffer   = size_of_data_chunk * count_of_data_chunks;
+    uint32_t count_of_buffers = size_of_data_chunk != 0 ? 1 : count_of_data_chunks;
+
+    push_back_to_current_meta_ds(EspMetaUniform(stage,
+                                                size_of_buffer,
+                                                count_of_buffers,
+                                                m_binding_count,
+                                                EspUniformType::ESP_STORAGE_BUFFER,
+                                                access));
+
+    m_binding_count += 1;
+    m_general_buffer_uniform_counter++;
+    m_meta_descriptor_sets.back().m_storage_buffer_counter += count_of_buffers;
+
+    return *this;
+  }
+
+  EspUniformMetaData& VulkanUniformMetaData::add_storage_image_uniform(EspUniformShaderStage stage,
+                                                                       uint32_t count_of_images)
+  {
+    ESP_ASSERT(m_current_ds_counter != -1, "You forgot to create descriptor set!!!");
+    ESP_ASSERT(!m_meta_descriptor_sets.back().m_bindless, "Bindless descriptor set can't have uniforms")
+
+    push_back_to_current_meta_ds(
+        EspMetaUniform(stage, 0, count_of_images, m_binding_count, EspUniformType::ESP_STORAGE_IMAGE));
+
+    m_binding_count += 1;
+    m_general_texture_uniform_counter++;
+    m_meta_descriptor_sets.back().m_storage_image_counter += count_of_images;
+
+    return *this;
+  }
+
   EspUniformMetaData& VulkanUniformMetaData::add_push_uniform(EspUniformShaderStage stage,
                                                               uint32_t offset,
                                                               uint32_t size)
   {
+    // ESP_ALL_STAGES sets bits of both graphics stages, compute stage gets a bit of its own
     auto stage_mask = (uint32_t)stage + 1;
 
     ESP_ASSERT(!(m_push_shader_stage_mask & stage_mask), "Single shader stage can't have more than 1 push uniform")
@@ -90,7 +162,7 @@ namespace esp
   VulkanUniformMetaData::operator bool() const
   {
     return m_general_buffer_uniform_counter != 0 || m_general_texture_uniform_counter != 0 ||
-        m_general_push_uniform_counter != 0;
+        m_general_push_uniform_counter != 0 || m_bindless_ds != -1;
   }
 
   int VulkanUniformMetaData::count_buffer_uniforms(int start_ds, int end_ds) const
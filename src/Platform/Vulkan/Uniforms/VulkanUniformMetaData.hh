@@ -33,11 +33,15 @@ namespace esp
 
     EspUniformType m_uniform_type;
 
+    // Only storage buffers can be read only.
+    EspStorageBufferAccess m_access;
+
     EspMetaUniform(EspUniformShaderStage stage,
                    uint32_t size_of_data_chunk,
                    uint32_t count_of_elements,
                    uint32_t binding,
-                   EspUniformType uniform_type);
+                   EspUniformType uniform_type,
+                   EspStorageBufferAccess access = EspStorageBufferAccess::ESP_READ_WRITE);
   };
 
   struct EspMetaDescriptorSet
@@ -45,11 +49,17 @@ namespace esp
    public:
     std::vector<EspMetaUniform> m_meta_uniforms;
 
-    uint32_t m_buffer_uniform_counter  = 0;
-    uint32_t m_texture_uniform_counter = 0;
+    uint32_t m_buffer_uniform_counter         = 0;
+    uint32_t m_dynamic_buffer_uniform_counter = 0;
+    uint32_t m_texture_uniform_counter        = 0;
+    uint32_t m_storage_buffer_counter         = 0;
+    uint32_t m_storage_image_counter          = 0;
 
     uint32_t m_set_index;
 
+    // The set is owned by EspBindlessTextures.
+    bool m_bindless = false;
+
    public:
     EspMetaDescriptorSet(uint32_t set_index);
 
@@ -86,13 +96,24 @@ namespace esp
     virtual ~VulkanUniformMetaData();
 
     virtual EspUniformMetaData& establish_descriptor_set() override;
+    virtual EspUniformMetaData& establish_bindless_descriptor_set() override;
     virtual EspUniformMetaData& add_buffer_uniform(EspUniformShaderStage stage,
                                                    uint32_t size_of_data_chunk,
                                                    uint32_t count_of_data_chunks = 1) override;
+    virtual EspUniformMetaData& add_dynamic_buffer_uniform(EspUniformShaderStage stage,
+                                                           uint32_t size_of_data_chunk) override;
 
     virtual EspUniformMetaData& add_texture_uniform(EspUniformShaderStage stage,
                                                     uint32_t count_of_textures = 1) override;
 
+    virtual EspUniformMetaData& add_storage_buffer_uniform(
+        EspUniformShaderStage stage,
+        uint32_t size_of_data_chunk   = 0,
+        uint32_t count_of_data_chunks = 1,
+        EspStorageBufferAccess access = EspStorageBufferAccess::ESP_READ_WRITE) override;
+    virtual EspUniformMetaData& add_storage_image_uniform(EspUniformShaderStage stage,
+                                                          uint32_t count_of_images = 1) override;
+
     virtual EspUniformMetaData& add_push_uniform(EspUniformShaderStage stage, uint32_t offset, uint32_t size) override;
 
     int count_buffer_uniforms(int start_ds, int end_ds) const;
@@ -25,17 +25,44 @@ namespace esp
 {
   VulkanContext* VulkanContext::s_instance = nullptr;
 
-  std::unique_ptr<VulkanContext> VulkanContext::create(EspWindow& window)
+  std::unique_ptr<VulkanContext> VulkanContext::create(EspWindow& window,
+                                                       const fs::path& pipeline_cache_path,
+                                                       uint32_t frames_in_flight)
   {
     ESP_ASSERT(VulkanContext::s_instance == nullptr, "The vulkan context already exists!");
     VulkanContext::s_instance = new VulkanContext();
+
+    auto& context_data                 = VulkanContext::s_instance->m_context_data;
+    context_data.m_pipeline_cache_path = pipeline_cache_path;
+    // known before the device is created, so per-frame resources of every system are sized the same
+    context_data.m_frames_in_flight = EspFramePacer::clamp_frames_in_flight(frames_in_flight);
     VulkanContext::s_instance->init(window);
 
     return std::unique_ptr<VulkanContext>{ VulkanContext::s_instance };
   }
 
+  std::unique_ptr<VulkanContext> VulkanContext::create_headless(uint32_t width,
+                                                                uint32_t height,
+                                                                const fs::path& pipeline_cache_path,
+                                                                uint32_t frames_in_flight)
+  {
+    ESP_ASSERT(VulkanContext::s_instance == nullptr, "The vulkan context already exists!");
+    VulkanContext::s_instance = new VulkanContext();
+
+    auto& context_data                 = VulkanContext::s_instance->m_context_data;
+    context_data.m_pipeline_cache_path = pipeline_cache_path;
+    context_data.m_frames_in_flight    = EspFramePacer::clamp_frames_in_flight(frames_in_flight);
+    context_data.m_headless            = true;
+    context_data.m_offscreen_extent    = { width, height };
+    VulkanContext::s_instance->init_headless();
+
+    return std::unique_ptr<VulkanContext>{ VulkanContext::s_instance };
+  }
+
   VulkanContext::VulkanContext()
   {
+    // needed to query optional device features
+    m_context_data.m_instance_extensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
 #ifdef __APPLE__
     m_context_data.m_instance_extensions.push_back(VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME);
 #endif /* __APPLE__ */
@@ -56,6 +83,16 @@ namespace esp
     create_vulkan_resource_manager();
   }
 
+  void VulkanContext::init_headless()
+  {
+    // same as init(), but there is no window to create a surface for
+    create_instance();
+    create_vulkan_device();
+
+    create_default_sampler();
+    create_vulkan_resource_manager();
+  }
+
   void VulkanContext::terminate()
   {
     ESP_ASSERT(s_instance != nullptr, "You cannot terminate vulkan context because it doesn't exist!");
@@ -68,7 +105,10 @@ namespace esp
 
     m_vulkan_device->terminate();
 
-    vkDestroySurfaceKHR(m_context_data.m_instance, m_context_data.m_surface, nullptr);
+    if (m_context_data.m_surface != VK_NULL_HANDLE)
+    {
+      vkDestroySurfaceKHR(m_context_data.m_instance, m_context_data.m_surface, nullptr);
+    }
     vkDestroyInstance(m_context_data.m_instance, nullptr);
 
     VulkanContext::s_instance = nullptr;
@@ -181,11 +221,17 @@ static bool check_validation_layer_support(esp::VulkanContextData& context_data)
 
 static std::vector<const char*> get_required_extensions(esp::VulkanContextData& context_data)
 {
-  uint32_t glfw_extensions_count = 0;
-  const char** glfw_extensions;
-  glfw_extensions = glfwGetRequiredInstanceExtensions(&glfw_extensions_count);
+  std::vector<const char*> extensions;
 
-  std::vector<const char*> extensions(glfw_extensions, glfw_extensions + glfw_extensions_count);
+  // surface extensions are only needed to present to a window (and glfw isn't initialized without one)
+  if (!context_data.m_headless)
+  {
+    uint32_t glfw_extensions_count = 0;
+    const char** glfw_extensions;
+    glfw_extensions = glfwGetRequiredInstanceExtensions(&glfw_extensions_count);
+
+    extensions.assign(glfw_extensions, glfw_extensions + glfw_extensions_count);
+  }
 
   for (auto instance_extension : context_data.m_instance_extensions)
   {
@@ -43,11 +43,19 @@ namespace esp
     VulkanContext& operator=(const VulkanContext& other) = delete;
 
     void init(EspWindow& window) override;
+    // Initializes vulkan without a surface, rendering is only possible into offscreen images.
+    void init_headless();
     void terminate() override;
 
     /* -------------------------- STATIC METHODS --------------------------- */
    public:
-    static std::unique_ptr<VulkanContext> create(EspWindow& window);
+    static std::unique_ptr<VulkanContext> create(EspWindow& window,
+                                                 const fs::path& pipeline_cache_path,
+                                                 uint32_t frames_in_flight);
+    static std::unique_ptr<VulkanContext> create_headless(uint32_t width,
+                                                          uint32_t height,
+                                                          const fs::path& pipeline_cache_path,
+                                                          uint32_t frames_in_flight);
 
     inline static const VulkanContextData& get_context_data() { return s_instance->m_context_data; }
   };
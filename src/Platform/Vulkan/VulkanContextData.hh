@@ -12,6 +12,9 @@ namespace esp
   {
     std::optional<uint32_t> m_graphics_family;
     std::optional<uint32_t> m_present_family;
+    // families without graphics (and compute) support, their queues run beside the graphics one
+    std::optional<uint32_t> m_compute_family;
+    std::optional<uint32_t> m_transfer_family;
 
     bool is_complete() const { return m_graphics_family.has_value() && m_present_family.has_value(); }
   };
@@ -21,14 +24,23 @@ namespace esp
     VkInstance m_instance;
     VkDebugUtilsMessengerEXT m_debug_messenger;
 
-    VkSurfaceKHR m_surface;
+    VkSurfaceKHR m_surface = VK_NULL_HANDLE;
 
     QueueFamilyIndices m_queue_family_indices;
     VkQueue m_graphics_queue;
     VkQueue m_present_queue;
+    VkQueue m_compute_queue  = VK_NULL_HANDLE;
+    VkQueue m_transfer_queue = VK_NULL_HANDLE;
 
     // VkSampleCountFlagBits m_msaa_samples = VK_SAMPLE_COUNT_1_BIT;
 
+    fs::path m_pipeline_cache_path;
+    uint32_t m_frames_in_flight = 2;
+
+    // without a window there is no surface, frames are rendered into offscreen images of this size
+    bool m_headless               = false;
+    VkExtent2D m_offscreen_extent = {};
+
     const std::vector<const char*> m_validation_layers = { "VK_LAYER_KHRONOS_validation" };
 
     std::vector<const char*> m_instance_extensions = { VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME };
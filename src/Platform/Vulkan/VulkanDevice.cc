@@ -1,6 +1,9 @@
 #include "VulkanDevice.hh"
 #include "Platform/Vulkan/Work/VulkanSwapChain.hh"
 
+// std
+#include <cstring>
+
 namespace esp
 {
   VulkanDevice* VulkanDevice::s_instance = nullptr;
@@ -26,14 +29,41 @@ namespace esp
 
   void VulkanDevice::init(VulkanContextData* context_data)
   {
+    // nothing is presented without a window
+    if (context_data->m_headless)
+    {
+      std::erase_if(m_device_extensions,
+                    [](const char* extension) { return strcmp(extension, VK_KHR_SWAPCHAIN_EXTENSION_NAME) == 0; });
+    }
+
     pick_physical_device(context_data);
     create_logical_device(context_data);
+
+    m_pipeline_cache      = VulkanPipelineCache::create(m_device, m_properties, context_data->m_pipeline_cache_path);
+    m_shader_module_cache = VulkanShaderModuleCache::create(m_device);
+    m_layout_cache        = VulkanLayoutCache::create(m_device);
+
+    m_descriptor_allocator = VulkanDescriptorAllocator::create(m_device,
+                                                               context_data->m_frames_in_flight,
+                                                               m_update_after_bind_supported);
   }
 
   void VulkanDevice::terminate()
   {
     ESP_ASSERT(VulkanDevice::s_instance != nullptr, "VulkanDevice is deleted twice!");
 
+    m_descriptor_allocator->terminate();
+    m_descriptor_allocator.reset();
+
+    m_layout_cache->terminate();
+    m_layout_cache.reset();
+
+    m_shader_module_cache->terminate();
+    m_shader_module_cache.reset();
+
+    m_pipeline_cache->terminate();
+    m_pipeline_cache.reset();
+
     vkDestroyDevice(m_device, nullptr);
 
     VulkanDevice::s_instance = nullptr;
@@ -80,6 +110,8 @@ namespace esp
 
     std::vector<VkDeviceQueueCreateInfo> queue_create_infos;
     std::set<uint32_t> unique_queue_families = { indices.m_graphics_family.value(), indices.m_present_family.value() };
+    if (indices.m_compute_family.has_value()) { unique_queue_families.insert(indices.m_compute_family.value()); }
+    if (indices.m_transfer_family.has_value()) { unique_queue_families.insert(indices.m_transfer_family.value()); }
 
     float queue_priority = 1.0f;
     for (uint32_t queue_family : unique_queue_families)
@@ -97,6 +129,99 @@ namespace esp
     // TODO: let user decide whether he wants higher quality or better performance - put this in some if statement
     // device_features.sampleRateShading        = VK_TRUE; // enable sample shading feature for the device
 
+    // indirect draws work without these features, but then every command needs a separate call
+    VkPhysicalDeviceFeatures supported_features;
+    vkGetPhysicalDeviceFeatures(m_physical_device, &supported_features);
+    device_features.multiDrawIndirect         = supported_features.multiDrawIndirect;
+    device_features.drawIndirectFirstInstance = supported_features.drawIndirectFirstInstance;
+
+    // optional - pipeline statistics of GPU profiler scopes, secondary command buffers executed inside a scope have to
+    // inherit the query
+    device_features.pipelineStatisticsQuery = supported_features.pipelineStatisticsQuery &&
+        supported_features.inheritedQueries;
+    device_features.inheritedQueries = device_features.pipelineStatisticsQuery;
+    m_enabled_features               = device_features;
+
+    // optional - without it the draw count of indirect draws is read on the CPU side
+    if (is_device_extension_available(m_physical_device, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME))
+    {
+      m_device_extensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+      m_draw_indirect_count_supported = true;
+    }
+
+    // optional - lets descriptors be updated after their set is bound, descriptor pools have to be created for it
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptor_indexing_feature = {};
+    descriptor_indexing_feature.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+    if (vkGetPhysicalDeviceFeatures2KHR &&
+        is_device_extension_available(m_physical_device, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME))
+    {
+      VkPhysicalDeviceDescriptorIndexingFeaturesEXT supported_indexing_features = {};
+      supported_indexing_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+
+      VkPhysicalDeviceFeatures2 supported_features2 = {};
+      supported_features2.sType                     = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+      supported_features2.pNext                     = &supported_indexing_features;
+      vkGetPhysicalDeviceFeatures2KHR(m_physical_device, &supported_features2);
+
+      if (supported_indexing_features.descriptorBindingSampledImageUpdateAfterBind)
+      {
+        descriptor_indexing_feature.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        descriptor_indexing_feature.descriptorBindingUniformBufferUpdateAfterBind =
+            supported_indexing_features.descriptorBindingUniformBufferUpdateAfterBind;
+
+        m_device_extensions.push_back(VK_KHR_MAINTENANCE3_EXTENSION_NAME);
+        m_device_extensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+        m_update_after_bind_supported = true;
+
+        // bindless textures - one partially bound array of textures indexed with values that aren't uniform
+        if (supported_indexing_features.descriptorBindingPartiallyBound &&
+            supported_indexing_features.descriptorBindingUpdateUnusedWhilePending &&
+            supported_indexing_features.runtimeDescriptorArray &&
+            supported_indexing_features.shaderSampledImageArrayNonUniformIndexing)
+        {
+          descriptor_indexing_feature.descriptorBindingPartiallyBound           = VK_TRUE;
+          descriptor_indexing_feature.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+          descriptor_indexing_feature.runtimeDescriptorArray                    = VK_TRUE;
+          descriptor_indexing_feature.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+
+          VkPhysicalDeviceDescriptorIndexingPropertiesEXT indexing_properties = {};
+          indexing_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+
+          VkPhysicalDeviceProperties2 properties2 = {};
+          properties2.sType                       = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+          properties2.pNext                       = &indexing_properties;
+          vkGetPhysicalDeviceProperties2KHR(m_physical_device, &properties2);
+
+          m_max_bindless_textures = std::min({ indexing_properties.maxPerStageDescriptorUpdateAfterBindSamplers,
+                                               indexing_properties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                                               indexing_properties.maxDescriptorSetUpdateAfterBindSamplers,
+                                               indexing_properties.maxDescriptorSetUpdateAfterBindSampledImages });
+        }
+      }
+    }
+
+    // optional - frames are paced with a single semaphore whose value grows instead of a fence per frame in flight
+    VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timeline_semaphore_feature = {};
+    timeline_semaphore_feature.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+    if (vkGetPhysicalDeviceFeatures2KHR &&
+        is_device_extension_available(m_physical_device, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME))
+    {
+      VkPhysicalDeviceTimelineSemaphoreFeaturesKHR supported_timeline_features = {};
+      supported_timeline_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+
+      VkPhysicalDeviceFeatures2 supported_features2 = {};
+      supported_features2.sType                     = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+      supported_features2.pNext                     = &supported_timeline_features;
+      vkGetPhysicalDeviceFeatures2KHR(m_physical_device, &supported_features2);
+
+      if (supported_timeline_features.timelineSemaphore)
+      {
+        timeline_semaphore_feature.timelineSemaphore = VK_TRUE;
+        m_device_extensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+        m_timeline_semaphore_supported = true;
+      }
+    }
+
     VkDeviceCreateInfo create_info = {};
     create_info.sType              = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
 
@@ -121,6 +246,13 @@ namespace esp
     VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamic_rendering_feature = {};
     dynamic_rendering_feature.sType            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
     dynamic_rendering_feature.dynamicRendering = VK_TRUE;
+    dynamic_rendering_feature.pNext            = m_update_after_bind_supported ? &descriptor_indexing_feature : nullptr;
+
+    if (m_timeline_semaphore_supported)
+    {
+      timeline_semaphore_feature.pNext = dynamic_rendering_feature.pNext;
+      dynamic_rendering_feature.pNext  = &timeline_semaphore_feature;
+    }
 
     VkPhysicalDeviceFeatures2 physical_device_features2{};
     physical_device_features2.sType    = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
@@ -139,6 +271,16 @@ namespace esp
 
     vkGetDeviceQueue(m_device, indices.m_graphics_family.value(), 0, &context_data->m_graphics_queue);
     vkGetDeviceQueue(m_device, indices.m_present_family.value(), 0, &context_data->m_present_queue);
+    if (indices.m_compute_family.has_value())
+    {
+      vkGetDeviceQueue(m_device, indices.m_compute_family.value(), 0, &context_data->m_compute_queue);
+      ESP_CORE_INFO("Dedicated compute queue family: {0}", indices.m_compute_family.value());
+    }
+    if (indices.m_transfer_family.has_value())
+    {
+      vkGetDeviceQueue(m_device, indices.m_transfer_family.value(), 0, &context_data->m_transfer_queue);
+      ESP_CORE_INFO("Dedicated transfer queue family: {0}", indices.m_transfer_family.value());
+    }
     ESP_INFO("Logic degice created");
   }
 
@@ -148,8 +290,8 @@ namespace esp
 
     bool extensions_supported = check_device_extension_support(device);
 
-    bool swap_chain_adequate = false;
-    if (extensions_supported)
+    bool swap_chain_adequate = context_data->m_headless;
+    if (extensions_supported && !context_data->m_headless)
     {
       auto swap_chain_support = VulkanSwapChain::query_swap_chain_support(device, *context_data);
       swap_chain_adequate     = !swap_chain_support.m_formats.empty() && !swap_chain_support.m_present_modes.empty();
@@ -171,19 +313,27 @@ namespace esp
     std::vector<VkQueueFamilyProperties> queue_families(queue_family_count);
     vkGetPhysicalDeviceQueueFamilyProperties(device, &queue_family_count, queue_families.data());
 
-    int i = 0;
-    for (const auto& queue_family : queue_families)
+    for (uint32_t i = 0; i < queue_family_count; i++)
     {
-      if (queue_family.queueCount > 0 && queue_family.queueFlags & VK_QUEUE_GRAPHICS_BIT)
+      if (queue_families[i].queueCount == 0) { continue; }
+
+      auto flags = queue_families[i].queueFlags;
+      // the first families which make the indices complete are used for rendering, as they always were
+      if (!indices.is_complete())
       {
-        indices.m_graphics_family = i;
+        if (flags & VK_QUEUE_GRAPHICS_BIT) { indices.m_graphics_family = i; }
+        // without a surface the present queue is only used as the graphics one
+        VkBool32 present_support = false;
+        if (context_data->m_headless) { present_support = (flags & VK_QUEUE_GRAPHICS_BIT) != 0; }
+        else { vkGetPhysicalDeviceSurfaceSupportKHR(device, i, context_data->m_surface, &present_support); }
+        if (present_support) { indices.m_present_family = i; }
       }
-      VkBool32 present_support = false;
-      vkGetPhysicalDeviceSurfaceSupportKHR(device, i, context_data->m_surface, &present_support);
-      if (queue_family.queueCount > 0 && present_support) { indices.m_present_family = i; }
-      if (indices.is_complete()) { break; }
 
-      i++;
+      // dedicated families usually map to separate hardware queues, so their work overlaps rendering
+      bool compute_only  = (flags & VK_QUEUE_COMPUTE_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT);
+      bool transfer_only = (flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT));
+      if (compute_only && !indices.m_compute_family.has_value()) { indices.m_compute_family = i; }
+      if (transfer_only && !indices.m_transfer_family.has_value()) { indices.m_transfer_family = i; }
     }
 
     return indices;
@@ -212,6 +362,22 @@ namespace esp
     return required_extensions.empty();
   }
 
+  bool VulkanDevice::is_device_extension_available(VkPhysicalDevice device, const char* extension_name)
+  {
+    uint32_t extensions_count;
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &extensions_count, nullptr);
+
+    std::vector<VkExtensionProperties> available_extensions(extensions_count);
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &extensions_count, available_extensions.data());
+
+    for (const auto& extension : available_extensions)
+    {
+      if (strcmp(extension.extensionName, extension_name) == 0) { return true; }
+    }
+
+    return false;
+  }
+
   VkSampleCountFlagBits VulkanDevice::get_max_usable_sample_count()
   {
     VkSampleCountFlags counts =
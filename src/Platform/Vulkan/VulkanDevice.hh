@@ -5,6 +5,10 @@
 
 // Render API Vulkan
 #include "VulkanContextData.hh"
+#include "Resources/VulkanShaderModuleCache.hh"
+#include "Uniforms/VulkanDescriptorAllocator.hh"
+#include "Uniforms/VulkanLayoutCache.hh"
+#include "VulkanPipelineCache.hh"
 
 // std
 #include <string>
@@ -21,6 +25,16 @@ namespace esp
     VkPhysicalDevice m_physical_device;
     VkDevice m_device;
     VkPhysicalDeviceProperties m_properties;
+    VkPhysicalDeviceFeatures m_enabled_features = {};
+    bool m_draw_indirect_count_supported        = false;
+    bool m_update_after_bind_supported          = false;
+    bool m_timeline_semaphore_supported         = false;
+    uint32_t m_max_bindless_textures            = 0;
+
+    std::unique_ptr<VulkanPipelineCache> m_pipeline_cache{};
+    std::unique_ptr<VulkanShaderModuleCache> m_shader_module_cache{};
+    std::unique_ptr<VulkanLayoutCache> m_layout_cache{};
+    std::unique_ptr<VulkanDescriptorAllocator> m_descriptor_allocator{};
 
     std::vector<const char*> m_device_extensions = { VK_KHR_SWAPCHAIN_EXTENSION_NAME,
                                                      VK_KHR_MAINTENANCE1_EXTENSION_NAME,
@@ -37,6 +51,7 @@ namespace esp
     bool is_device_suitable(VkPhysicalDevice device, VulkanContextData* context_data);
     QueueFamilyIndices find_queue_families(VkPhysicalDevice device, VulkanContextData* context_data);
     bool check_device_extension_support(VkPhysicalDevice device);
+    bool is_device_extension_available(VkPhysicalDevice device, const char* extension_name);
 
    public:
     VulkanDevice();
@@ -57,6 +72,17 @@ namespace esp
     static inline const VkPhysicalDevice& get_physical_device() { return s_instance->m_physical_device; }
     static inline const VkDevice& get_logical_device() { return s_instance->m_device; }
     static inline const VkPhysicalDeviceProperties& get_properties() { return s_instance->m_properties; }
+    static inline const VkPhysicalDeviceFeatures& get_enabled_features() { return s_instance->m_enabled_features; }
+    static inline bool is_draw_indirect_count_supported() { return s_instance->m_draw_indirect_count_supported; }
+    static inline bool is_update_after_bind_supported() { return s_instance->m_update_after_bind_supported; }
+    static inline bool is_timeline_semaphore_supported() { return s_instance->m_timeline_semaphore_supported; }
+    static inline bool is_bindless_supported() { return s_instance->m_max_bindless_textures != 0; }
+    static inline uint32_t get_max_bindless_textures() { return s_instance->m_max_bindless_textures; }
+    static inline VulkanPipelineCache& get_pipeline_cache() { return *s_instance->m_pipeline_cache; }
+    static inline VulkanShaderModuleCache& get_shader_module_cache() { return *s_instance->m_shader_module_cache; }
+    static inline VulkanLayoutCache& get_layout_cache() { return *s_instance->m_layout_cache; }
+    static inline VulkanDescriptorAllocator& get_descriptor_allocator() { return *s_instance->m_descriptor_allocator; }
+    static inline bool has_descriptor_allocator() { return s_instance && s_instance->m_descriptor_allocator; }
     static VkFormatProperties get_format_properties(VkFormat format);
 
     // -------------------------------------- Swap Chain Helper Functions --------------------------------------
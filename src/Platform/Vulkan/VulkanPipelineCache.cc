@@ -0,0 +1,141 @@
+#include "VulkanPipelineCache.hh"
+
+// std
+#include <cstring>
+
+// signatures
+static bool is_vulkan_header_valid(const std::vector<uint8_t>& data, const VkPhysicalDeviceProperties& properties);
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  std::unique_ptr<VulkanPipelineCache> VulkanPipelineCache::create(VkDevice device,
+                                                                   const VkPhysicalDeviceProperties& properties,
+                                                                   const fs::path& path)
+  {
+    return std::unique_ptr<VulkanPipelineCache>(new VulkanPipelineCache(device, properties, path));
+  }
+
+  VulkanPipelineCache::VulkanPipelineCache(VkDevice device,
+                                           const VkPhysicalDeviceProperties& properties,
+                                           const fs::path& path) :
+      m_device{ device }, m_path{ path }
+  {
+    m_identity.m_vendor_id      = properties.vendorID;
+    m_identity.m_device_id      = properties.deviceID;
+    m_identity.m_driver_version = properties.driverVersion;
+    std::memcpy(m_identity.m_cache_uuid.data(), properties.pipelineCacheUUID, VK_UUID_SIZE);
+
+    std::vector<uint8_t> data;
+    if (!m_path.empty())
+    {
+      auto status = EspPipelineCacheFile::load(m_path, m_identity, data);
+      if (status == EspPipelineCacheFile::OK && !is_vulkan_header_valid(data, properties))
+      {
+        status = EspPipelineCacheFile::INCOMPATIBLE;
+      }
+
+      if (status != EspPipelineCacheFile::OK)
+      {
+        ESP_CORE_INFO("Pipeline cache {} not used: {}", m_path.string(), EspPipelineCacheFile::to_string(status));
+        data.clear();
+      }
+    }
+
+    VkPipelineCacheCreateInfo create_info = {};
+    create_info.sType                     = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    create_info.initialDataSize           = data.size();
+    create_info.pInitialData              = data.empty() ? nullptr : data.data();
+
+    if (vkCreatePipelineCache(m_device, &create_info, nullptr, &m_pipeline_cache) != VK_SUCCESS)
+    {
+      // the driver may still reject the data, an empty cache is always valid
+      create_info.initialDataSize = 0;
+      create_info.pInitialData    = nullptr;
+      data.clear();
+
+      if (vkCreatePipelineCache(m_device, &create_info, nullptr, &m_pipeline_cache) != VK_SUCCESS)
+      {
+        ESP_CORE_ERROR("Failed to create pipeline cache");
+        throw std::runtime_error("Failed to create pipeline cache");
+      }
+    }
+
+    m_warm_start  = !data.empty();
+    m_loaded_size = data.size();
+    ESP_CORE_INFO("Pipeline cache created ({} start, {} bytes)", m_warm_start ? "warm" : "cold", m_loaded_size);
+  }
+
+  VulkanPipelineCache::~VulkanPipelineCache()
+  {
+    if (m_pipeline_cache != VK_NULL_HANDLE) { terminate(); }
+  }
+
+  void VulkanPipelineCache::terminate()
+  {
+    ESP_ASSERT(m_pipeline_cache != VK_NULL_HANDLE, "Pipeline cache is terminated twice!")
+
+    auto stats = get_stats();
+    ESP_CORE_INFO("{} pipelines created in {:.2f} ms ({} start)",
+                  stats.m_pipelines_created,
+                  stats.m_creation_time_ms,
+                  stats.m_warm_start ? "warm" : "cold");
+
+    save();
+
+    vkDestroyPipelineCache(m_device, m_pipeline_cache, nullptr);
+    m_pipeline_cache = VK_NULL_HANDLE;
+  }
+
+  bool VulkanPipelineCache::save()
+  {
+    if (m_path.empty()) { return false; }
+
+    size_t size = 0;
+    if (vkGetPipelineCacheData(m_device, m_pipeline_cache, &size, nullptr) != VK_SUCCESS) { return false; }
+
+    std::vector<uint8_t> data(size);
+    if (vkGetPipelineCacheData(m_device, m_pipeline_cache, &size, data.data()) != VK_SUCCESS) { return false; }
+    data.resize(size);
+
+    if (!EspPipelineCacheFile::save(m_path, m_identity, data))
+    {
+      ESP_CORE_WARN("Failed to save pipeline cache to {}", m_path.string());
+      return false;
+    }
+
+    return true;
+  }
+
+  void VulkanPipelineCache::record_pipeline_creation(double creation_time_ms)
+  {
+    m_pipelines_created++;
+    m_creation_time_us += static_cast<uint64_t>(creation_time_ms * 1000.0);
+  }
+
+  VulkanPipelineCacheStats VulkanPipelineCache::get_stats() const
+  {
+    return { m_warm_start, m_loaded_size, m_pipelines_created.load(), m_creation_time_us.load() / 1000.0 };
+  }
+} // namespace esp
+
+/* --------------------------------------------------------- */
+/* ------------------ HELPFUL FUNCTIONS -------------------- */
+/* --------------------------------------------------------- */
+
+static bool is_vulkan_header_valid(const std::vector<uint8_t>& data, const VkPhysicalDeviceProperties& properties)
+{
+  // header written by the driver: length, version, vendor id, device id, cache uuid
+  constexpr size_t HEADER_SIZE = 4 * sizeof(uint32_t) + VK_UUID_SIZE;
+  if (data.size() < HEADER_SIZE) { return false; }
+
+  uint32_t header[4];
+  std::memcpy(header, data.data(), sizeof(header));
+
+  return header[0] >= HEADER_SIZE && header[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+      header[2] == properties.vendorID && header[3] == properties.deviceID &&
+      std::memcmp(data.data() + sizeof(header), properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
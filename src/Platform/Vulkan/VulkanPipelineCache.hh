@@ -0,0 +1,82 @@
+#ifndef VULKAN_RENDER_API_VULKAN_PIPELINE_CACHE_HH
+#define VULKAN_RENDER_API_VULKAN_PIPELINE_CACHE_HH
+
+#include "esppch.hh"
+
+// Render API
+#include "Core/RenderAPI/Work/EspPipelineCacheFile.hh"
+
+// std
+#include <atomic>
+
+namespace esp
+{
+  /// @brief Counters describing pipeline creation since the cache was created.
+  struct VulkanPipelineCacheStats
+  {
+    /// @brief True if the cache was loaded from disk.
+    bool m_warm_start = false;
+    /// @brief Size of data loaded from disk in bytes.
+    size_t m_loaded_size = 0;
+    /// @brief Number of pipelines created with the cache.
+    uint32_t m_pipelines_created = 0;
+    /// @brief Total time spent in pipeline creation in milliseconds.
+    double m_creation_time_ms = 0.0;
+  };
+
+  /// @brief VkPipelineCache shared by all pipelines. It is loaded from disk when created and saved when terminated,
+  /// so pipelines compiled during previous runs don't have to be compiled again.
+  class VulkanPipelineCache
+  {
+   private:
+    VkDevice m_device;
+    VkPipelineCache m_pipeline_cache = VK_NULL_HANDLE;
+
+    fs::path m_path;
+    EspPipelineCacheIdentity m_identity;
+
+    bool m_warm_start    = false;
+    size_t m_loaded_size = 0;
+
+    std::atomic<uint32_t> m_pipelines_created = 0;
+    std::atomic<uint64_t> m_creation_time_us  = 0;
+
+   public:
+    /// @brief Creates pipeline cache and fills it with data saved on disk, if the data was produced by the same
+    /// device and driver.
+    /// @param device Logical device.
+    /// @param properties Properties of the physical device.
+    /// @param path Path to the cache file. Empty path disables loading and saving.
+    /// @return Unique pointer to the pipeline cache.
+    static std::unique_ptr<VulkanPipelineCache> create(VkDevice device,
+                                                       const VkPhysicalDeviceProperties& properties,
+                                                       const fs::path& path);
+
+    /// @brief Terminates the cache if it wasn't done before.
+    ~VulkanPipelineCache();
+
+    PREVENT_COPY(VulkanPipelineCache);
+
+    /// @brief Saves the cache to disk and destroys it.
+    void terminate();
+    /// @brief Saves the cache to disk.
+    /// @return True if the cache was saved. False otherwise.
+    bool save();
+
+    /// @brief Adds pipeline creation to the statistics. Can be called from many threads.
+    /// @param creation_time_ms Time spent in pipeline creation in milliseconds.
+    void record_pipeline_creation(double creation_time_ms);
+
+    /// @brief Returns statistics of the cache.
+    /// @return Statistics of the cache.
+    VulkanPipelineCacheStats get_stats() const;
+    /// @brief Returns Vulkan's pipeline cache.
+    /// @return Vulkan's pipeline cache.
+    inline VkPipelineCache get_pipeline_cache() const { return m_pipeline_cache; }
+
+   private:
+    VulkanPipelineCache(VkDevice device, const VkPhysicalDeviceProperties& properties, const fs::path& path);
+  };
+} // namespace esp
+
+#endif // VULKAN_RENDER_API_VULKAN_PIPELINE_CACHE_HH
@@ -1,7 +1,9 @@
 #include "VulkanResourceManager.hh"
 #include "Platform/Vulkan/Work/VulkanWorkOrchestrator.hh"
 #include "Resources/VulkanBuffer.hh"
+#include "Resources/VulkanMipGenerator.hh"
 #include "VulkanDevice.hh"
+#include "Work/VulkanAsyncCompute.hh"
 
 namespace esp
 {
@@ -28,6 +30,15 @@ namespace esp
     buffer_info.usage       = usage;
     buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
+    // buffers may be written by the async compute queue, sharing them costs nothing on most devices
+    auto& concurrent_families = VulkanAsyncCompute::get_concurrent_families();
+    if (!concurrent_families.empty())
+    {
+      buffer_info.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+      buffer_info.queueFamilyIndexCount = static_cast<uint32_t>(concurrent_families.size());
+      buffer_info.pQueueFamilyIndices   = concurrent_families.data();
+    }
+
     if (vkCreateBuffer(VulkanDevice::get_logical_device(), &buffer_info, nullptr, &buffer) != VK_SUCCESS)
     {
       ESP_CORE_ERROR("Failed to create buffer");
@@ -115,7 +126,8 @@ namespace esp
                                            VkImageCreateFlags flags,
                                            VkMemoryPropertyFlags properties,
                                            VkImage& image,
-                                           VkDeviceMemory& image_memory)
+                                           VkDeviceMemory& image_memory,
+                                           bool shared_with_compute)
   {
     VkImageCreateInfo image_info{};
     image_info.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
@@ -133,6 +145,14 @@ namespace esp
     image_info.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
     image_info.flags         = flags;
 
+    auto& concurrent_families = VulkanAsyncCompute::get_concurrent_families();
+    if (shared_with_compute && !concurrent_families.empty())
+    {
+      image_info.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+      image_info.queueFamilyIndexCount = static_cast<uint32_t>(concurrent_families.size());
+      image_info.pQueueFamilyIndices   = concurrent_families.data();
+    }
+
     if (vkCreateImage(VulkanDevice::get_logical_device(), &image_info, nullptr, &image) != VK_SUCCESS)
     {
       ESP_CORE_ERROR("Failed to create image");
@@ -222,18 +242,31 @@ namespace esp
     staging_buffer.map();
     staging_buffer.write_to_buffer(pixels);
 
+    // levels of RGBA8 images are generated by a compute shader, written through UNORM views of sRGB images
+    bool generate_by_compute = mip_levels > 1 && VulkanMipGenerator::supports(format);
+
+    VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+        VK_IMAGE_USAGE_SAMPLED_BIT;
+    VkImageCreateFlags flags = {};
+    if (generate_by_compute)
+    {
+      usage |= VK_IMAGE_USAGE_STORAGE_BIT;
+      if (format == VK_FORMAT_R8G8B8A8_SRGB) { flags |= VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT; }
+    }
+
     create_image(width,
                  height,
                  mip_levels,
                  VK_SAMPLE_COUNT_1_BIT,
                  format,
                  VK_IMAGE_TILING_OPTIMAL,
-                 VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                 usage,
                  1,
-                 {},
+                 flags,
                  VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                  texture_image,
-                 texture_image_memory);
+                 texture_image_memory,
+                 generate_by_compute);
 
     VkImageSubresourceRange subresource_range;
     subresource_range.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -251,7 +284,9 @@ namespace esp
 
     copy_buffer_to_image(staging_buffer.get_buffer(), texture_image, width, height, 1);
 
-    generate_mipmaps(texture_image, format, width, height, mip_levels);
+    // queued textures are generated together, right before the next frame is rendered
+    if (generate_by_compute) { VulkanMipGenerator::enqueue(texture_image, format, width, height, mip_levels); }
+    else { generate_mipmaps(texture_image, format, width, height, mip_levels); }
   }
 
   void VulkanResourceManager::create_cubemap_image(uint32_t width,
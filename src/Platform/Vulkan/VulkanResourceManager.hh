@@ -52,7 +52,8 @@ namespace esp
                              VkImageCreateFlags flags,
                              VkMemoryPropertyFlags properties,
                              VkImage& image,
-                             VkDeviceMemory& image_memory);
+                             VkDeviceMemory& image_memory,
+                             bool shared_with_compute = false);
 
     static VkImageView create_image_view(VkImage image,
                                          VkFormat format,
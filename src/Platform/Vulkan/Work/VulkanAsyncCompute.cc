@@ -0,0 +1,226 @@
+#include "VulkanAsyncCompute.hh"
+#include "Platform/Vulkan/VulkanContext.hh"
+#include "Platform/Vulkan/VulkanDevice.hh"
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  VulkanAsyncCompute* VulkanAsyncCompute::s_instance = nullptr;
+
+  std::unique_ptr<VulkanAsyncCompute> VulkanAsyncCompute::create(uint32_t frames_in_flight)
+  {
+    ESP_ASSERT(VulkanAsyncCompute::s_instance == nullptr, "The vulkan async compute already exists!");
+    VulkanAsyncCompute::s_instance = new VulkanAsyncCompute(VulkanDevice::get_logical_device(), frames_in_flight);
+
+    return std::unique_ptr<VulkanAsyncCompute>{ VulkanAsyncCompute::s_instance };
+  }
+
+  VulkanAsyncCompute::VulkanAsyncCompute(VkDevice device, uint32_t frames_in_flight) : m_device{ device }
+  {
+    auto& context_data = VulkanContext::get_context_data();
+    auto& indices      = context_data.m_queue_family_indices;
+
+    // graphics submissions can only wait for the previous frame with the timeline semaphore of the frame pacer
+    m_async = indices.m_compute_family.has_value() && VulkanDevice::is_timeline_semaphore_supported();
+    if (m_async)
+    {
+      m_queue               = context_data.m_compute_queue;
+      m_queue_family        = indices.m_compute_family.value();
+      m_concurrent_families = { indices.m_graphics_family.value(), m_queue_family };
+      ESP_CORE_INFO("Compute work is submitted to the async compute queue.");
+    }
+    else
+    {
+      m_queue        = context_data.m_graphics_queue;
+      m_queue_family = indices.m_graphics_family.value();
+    }
+
+    VkCommandPoolCreateInfo pool_info{};
+    pool_info.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    pool_info.flags            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    pool_info.queueFamilyIndex = m_queue_family;
+
+    if (vkCreateCommandPool(m_device, &pool_info, nullptr, &m_command_pool) != VK_SUCCESS)
+    {
+      ESP_CORE_ERROR("Failed to create command pool of async compute");
+      throw std::runtime_error("Failed to create command pool of async compute");
+    }
+
+    std::vector<VkCommandBuffer> command_buffers(frames_in_flight);
+
+    VkCommandBufferAllocateInfo alloc_info{};
+    alloc_info.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    alloc_info.commandPool        = m_command_pool;
+    alloc_info.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    alloc_info.commandBufferCount = frames_in_flight;
+
+    if (vkAllocateCommandBuffers(m_device, &alloc_info, command_buffers.data()) != VK_SUCCESS)
+    {
+      ESP_CORE_ERROR("Failed to allocate command buffers of async compute");
+      throw std::runtime_error("Failed to allocate command buffers of async compute");
+    }
+    for (auto command_buffer : command_buffers)
+    {
+      m_command_buffers.push_back(std::make_unique<VulkanCommandBufferId>(command_buffer, m_async));
+    }
+
+    if (!m_async) { return; }
+
+    VkSemaphoreCreateInfo semaphore_info{};
+    semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    m_finished_semaphores.resize(frames_in_flight);
+    for (auto& semaphore : m_finished_semaphores)
+    {
+      if (vkCreateSemaphore(m_device, &semaphore_info, nullptr, &semaphore) != VK_SUCCESS)
+      {
+        ESP_CORE_ERROR("Failed to create semaphore of async compute");
+        throw std::runtime_error("Failed to create semaphore of async compute");
+      }
+    }
+  }
+
+  void VulkanAsyncCompute::terminate()
+  {
+    ESP_ASSERT(VulkanAsyncCompute::s_instance != nullptr, "The vulkan async compute is deleted twice!");
+    ESP_CORE_TRACE("Async compute shutdown ({} submissions to the compute queue).", m_async_submissions);
+
+    for (auto semaphore : m_finished_semaphores)
+    {
+      vkDestroySemaphore(m_device, semaphore, nullptr);
+    }
+    m_finished_semaphores.clear();
+
+    vkDestroyCommandPool(m_device, m_command_pool, nullptr);
+    m_command_buffers.clear();
+
+    VulkanAsyncCompute::s_instance = nullptr;
+  }
+
+  void VulkanAsyncCompute::begin_frame(uint32_t frame_index)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_frame_index          = frame_index;
+    m_recording            = false;
+    m_after_previous_frame = false;
+  }
+
+  VkCommandBuffer VulkanAsyncCompute::submit(VkSemaphore timeline_semaphore,
+                                             uint64_t frame_value,
+                                             VkSemaphore& wait_semaphore)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    wait_semaphore = VK_NULL_HANDLE;
+    if (!m_recording) { return VK_NULL_HANDLE; }
+    m_recording = false;
+
+    auto command_buffer = m_command_buffers[m_frame_index]->m_command_buffer;
+    if (vkEndCommandBuffer(command_buffer) != VK_SUCCESS)
+    {
+      ESP_CORE_ERROR("Failed to record command buffer of async compute");
+      throw std::runtime_error("Failed to record command buffer of async compute");
+    }
+
+    // the graphics queue runs the buffer in order with the frame, the previous frame has been submitted before it
+    if (!m_async) { return command_buffer; }
+
+    ESP_PROFILE_SCOPE("VulkanAsyncCompute::submit");
+
+    VkSubmitInfo submit_info{};
+    submit_info.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.commandBufferCount   = 1;
+    submit_info.pCommandBuffers      = &command_buffer;
+    submit_info.signalSemaphoreCount = 1;
+    submit_info.pSignalSemaphores    = &m_finished_semaphores[m_frame_index];
+
+    // the previous frame signals its value once all of its graphics work is finished
+    uint64_t wait_value             = frame_value - 1;
+    VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+    uint64_t signal_value           = 0;
+
+    VkTimelineSemaphoreSubmitInfoKHR timeline_info{};
+    timeline_info.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+    timeline_info.waitSemaphoreValueCount   = 1;
+    timeline_info.pWaitSemaphoreValues      = &wait_value;
+    timeline_info.signalSemaphoreValueCount = 1;
+    timeline_info.pSignalSemaphoreValues    = &signal_value;
+    if (m_after_previous_frame && wait_value > 0)
+    {
+      submit_info.waitSemaphoreCount = 1;
+      submit_info.pWaitSemaphores    = &timeline_semaphore;
+      submit_info.pWaitDstStageMask  = &wait_stage;
+      submit_info.pNext              = &timeline_info;
+    }
+
+    if (vkQueueSubmit(m_queue, 1, &submit_info, VK_NULL_HANDLE) != VK_SUCCESS)
+    {
+      ESP_CORE_ERROR("Failed to submit command buffer of async compute");
+      throw std::runtime_error("Failed to submit command buffer of async compute");
+    }
+    m_async_submissions++;
+
+    // the frame pacer waits for the graphics submission, which waits for this one, so the buffer can be reused then
+    wait_semaphore = m_finished_semaphores[m_frame_index];
+    return VK_NULL_HANDLE;
+  }
+
+  const std::vector<uint32_t>& VulkanAsyncCompute::get_concurrent_families()
+  {
+    static const std::vector<uint32_t> s_no_families;
+    return s_instance ? s_instance->m_concurrent_families : s_no_families;
+  }
+
+  VulkanCommandBufferId* VulkanAsyncCompute::get_command_buffer()
+  {
+    // jobs may record compute work of the frame, the first of them begins the buffer
+    std::lock_guard<std::mutex> lock(s_instance->m_mutex);
+
+    auto& command_buffer = s_instance->m_command_buffers[s_instance->m_frame_index];
+    if (s_instance->m_recording) { return command_buffer.get(); }
+
+    // the frame pacer has waited for the previous submission of the frame index
+    vkResetCommandBuffer(command_buffer->m_command_buffer, 0);
+
+    VkCommandBufferBeginInfo begin_info{};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    if (vkBeginCommandBuffer(command_buffer->m_command_buffer, &begin_info) != VK_SUCCESS)
+    {
+      ESP_CORE_ERROR("Failed to begin command buffer of async compute");
+      throw std::runtime_error("Failed to begin command buffer of async compute");
+    }
+
+    s_instance->m_recording = true;
+    return command_buffer.get();
+  }
+
+  void VulkanAsyncCompute::wait_for_previous_frame()
+  {
+    if (s_instance->m_async)
+    {
+      std::lock_guard<std::mutex> lock(s_instance->m_mutex);
+      s_instance->m_after_previous_frame = true;
+      return;
+    }
+
+    // submissions to a single queue only order commands separated by a barrier
+    VkMemoryBarrier barrier{};
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+    vkCmdPipelineBarrier(get_command_buffer()->m_command_buffer,
+                         VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0,
+                         1,
+                         &barrier,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr);
+  }
+} // namespace esp
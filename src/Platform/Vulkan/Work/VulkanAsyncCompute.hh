@@ -0,0 +1,102 @@
+#ifndef PLATFORM_VULKAN_RENDER_API_VULKAN_ASYNC_COMPUTE_HH
+#define PLATFORM_VULKAN_RENDER_API_VULKAN_ASYNC_COMPUTE_HH
+
+#include "esppch.hh"
+
+// Render API Vulkan
+#include "Platform/Vulkan/RenderPlans/VulkanCommandBuffer.hh"
+
+// std
+#include <mutex>
+
+namespace esp
+{
+  /// @brief Compute work of a frame, recorded into a command buffer of its own. If the device has a dedicated compute
+  /// queue family (and timeline semaphores), the buffer is submitted to the compute queue and the frame's graphics
+  /// submission waits for it with a semaphore, only at stages which may consume its results. Rasterization of the
+  /// previous frame overlaps the compute work then. Other devices submit the buffer to the graphics queue, right
+  /// before the frame's one.
+  ///
+  /// Compute work of a frame may run while the previous frame is rendered, so resources it writes have to be
+  /// separate per frame in flight, or the work has to wait for the previous frame (wait_for_previous_frame()).
+  /// Buffers, and textures with mip levels generated by compute, are shared by both queue families
+  /// (VK_SHARING_MODE_CONCURRENT), other images used by the compute queue would need an ownership transfer.
+  class VulkanAsyncCompute
+  {
+   public:
+    /// @brief Stages of the graphics submission which wait for the compute work of the frame.
+    static constexpr VkPipelineStageFlags GRAPHICS_WAIT_STAGES = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT |
+        VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+
+   private:
+    static VulkanAsyncCompute* s_instance;
+
+    VkDevice m_device;
+    bool m_async;
+    VkQueue m_queue;
+    uint32_t m_queue_family;
+    std::vector<uint32_t> m_concurrent_families;
+
+    VkCommandPool m_command_pool = VK_NULL_HANDLE;
+    std::vector<std::unique_ptr<VulkanCommandBufferId>> m_command_buffers;
+    std::vector<VkSemaphore> m_finished_semaphores;
+
+    // guards beginning of the command buffer and the state below
+    std::mutex m_mutex;
+    uint32_t m_frame_index       = 0;
+    bool m_recording             = false;
+    bool m_after_previous_frame  = false;
+    uint64_t m_async_submissions = 0;
+
+   public:
+    /// @brief Creates VulkanAsyncCompute singleton instance, its command buffers and semaphores.
+    /// @param frames_in_flight Number of frames the GPU may be working on at once.
+    /// @return Unique pointer to VulkanAsyncCompute instance.
+    static std::unique_ptr<VulkanAsyncCompute> create(uint32_t frames_in_flight);
+
+    PREVENT_COPY(VulkanAsyncCompute);
+
+    /// @brief Default destructor.
+    ~VulkanAsyncCompute() = default;
+
+    /// @brief Destroys the command buffers and semaphores. GPU has to be idle.
+    void terminate();
+
+    /// @brief Starts compute work of the frame. The frame pacer has to have waited for the previous frame of the index.
+    /// @param frame_index Index of the frame in flight.
+    void begin_frame(uint32_t frame_index);
+    /// @brief Ends the command buffer of the frame and submits it to the compute queue. Has to be called right before
+    /// the frame's graphics submission.
+    /// @param timeline_semaphore Timeline semaphore of the frame pacer.
+    /// @param frame_value Value of the frame being submitted.
+    /// @param wait_semaphore Semaphore the graphics submission has to wait for at GRAPHICS_WAIT_STAGES. VK_NULL_HANDLE
+    /// if there is none.
+    /// @return Command buffer to be submitted to the graphics queue before the frame's one. VK_NULL_HANDLE if there is
+    /// none.
+    VkCommandBuffer submit(VkSemaphore timeline_semaphore, uint64_t frame_value, VkSemaphore& wait_semaphore);
+
+    /// @brief Checks if compute work runs on a queue of its own.
+    /// @return True if a dedicated compute queue is used.
+    inline static bool is_async() { return s_instance->m_async; }
+    /// @brief Returns queue family compute work is submitted to.
+    /// @return Index of the queue family.
+    inline static uint32_t get_queue_family() { return s_instance->m_queue_family; }
+    /// @brief Returns queue families resources used by both queues have to be shared by.
+    /// @return Graphics and compute families. Empty if compute work runs on the graphics queue.
+    static const std::vector<uint32_t>& get_concurrent_families();
+    /// @brief Returns command buffer compute work of the current frame is recorded into, it's begun by the first call
+    /// in the frame. Can be called from any thread, but commands have to be recorded by a single thread at a time.
+    /// @return Command buffer of the current frame.
+    static VulkanCommandBufferId* get_command_buffer();
+    /// @brief Makes compute work of the current frame wait until the previous frame is rendered, e.g. because it reads
+    /// results of the previous frame or writes resources the previous frame reads. Has to be called before the work is
+    /// recorded.
+    static void wait_for_previous_frame();
+
+   private:
+    VulkanAsyncCompute(VkDevice device, uint32_t frames_in_flight);
+  };
+} // namespace esp
+
+#endif // PLATFORM_VULKAN_RENDER_API_VULKAN_ASYNC_COMPUTE_HH
@@ -0,0 +1,115 @@
+#include "VulkanFramePacer.hh"
+
+// platform
+#include "Platform/Vulkan/VulkanDevice.hh"
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  std::unique_ptr<VulkanFramePacer> VulkanFramePacer::create(uint32_t frames_in_flight, EspFramePacingMode mode)
+  {
+    return std::unique_ptr<VulkanFramePacer>(
+        new VulkanFramePacer(VulkanDevice::get_logical_device(), frames_in_flight, mode));
+  }
+
+  VulkanFramePacer::VulkanFramePacer(VkDevice device, uint32_t frames_in_flight, EspFramePacingMode mode) :
+      EspFramePacer(frames_in_flight, mode), m_device{ device }
+  {
+    if (VulkanDevice::is_timeline_semaphore_supported())
+    {
+      VkSemaphoreTypeCreateInfoKHR type_info = {};
+      type_info.sType                        = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+      type_info.semaphoreType                = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+      type_info.initialValue                 = 0;
+
+      VkSemaphoreCreateInfo semaphore_info = {};
+      semaphore_info.sType                 = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+      semaphore_info.pNext                 = &type_info;
+
+      ESP_ASSERT(vkCreateSemaphore(m_device, &semaphore_info, nullptr, &m_timeline_semaphore) == VK_SUCCESS,
+                 "Failed to create timeline semaphore for frame pacer")
+      return;
+    }
+
+    ESP_CORE_WARN("Device doesn't support timeline semaphores. Frames are paced with fences.");
+
+    VkFenceCreateInfo fence_info = {};
+    fence_info.sType             = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+    m_fences.resize(get_frames_in_flight());
+    m_fence_values.resize(get_frames_in_flight(), 0);
+    for (auto& fence : m_fences)
+    {
+      ESP_ASSERT(vkCreateFence(m_device, &fence_info, nullptr, &fence) == VK_SUCCESS,
+                 "Failed to create fences for frame pacer")
+    }
+  }
+
+  VkFence VulkanFramePacer::get_submit_fence()
+  {
+    if (m_timeline_semaphore != VK_NULL_HANDLE) { return VK_NULL_HANDLE; }
+
+    // begin_frame() has waited for the previous frame of this slot, so the fence isn't in use anymore
+    auto frame_index = get_frame_index();
+    vkResetFences(m_device, 1, &m_fences[frame_index]);
+    m_fence_values[frame_index] = get_frame_value();
+
+    return m_fences[frame_index];
+  }
+
+  uint64_t VulkanFramePacer::query_completed_value()
+  {
+    if (m_timeline_semaphore != VK_NULL_HANDLE)
+    {
+      uint64_t value = 0;
+      vkGetSemaphoreCounterValueKHR(m_device, m_timeline_semaphore, &value);
+      return value;
+    }
+
+    // submissions to the queue finish in order, so the newest signaled fence tells about all older frames
+    for (size_t i = 0; i < m_fences.size(); i++)
+    {
+      if (m_fence_values[i] > m_completed_value && vkGetFenceStatus(m_device, m_fences[i]) == VK_SUCCESS)
+      {
+        m_completed_value = m_fence_values[i];
+      }
+    }
+
+    return m_completed_value;
+  }
+
+  void VulkanFramePacer::wait_for_value(uint64_t value)
+  {
+    if (m_timeline_semaphore != VK_NULL_HANDLE)
+    {
+      VkSemaphoreWaitInfoKHR wait_info = {};
+      wait_info.sType                  = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+      wait_info.semaphoreCount         = 1;
+      wait_info.pSemaphores            = &m_timeline_semaphore;
+      wait_info.pValues                = &value;
+
+      vkWaitSemaphoresKHR(m_device, &wait_info, std::numeric_limits<uint64_t>::max());
+      return;
+    }
+
+    auto frame_index = static_cast<uint32_t>((value - 1) % get_frames_in_flight());
+    ESP_ASSERT(m_fence_values[frame_index] == value, "Frame pacer waits for a frame that wasn't submitted")
+
+    vkWaitForFences(m_device, 1, &m_fences[frame_index], VK_TRUE, std::numeric_limits<uint64_t>::max());
+    m_completed_value = std::max(m_completed_value, value);
+  }
+
+  void VulkanFramePacer::destroy()
+  {
+    if (m_timeline_semaphore != VK_NULL_HANDLE) { vkDestroySemaphore(m_device, m_timeline_semaphore, nullptr); }
+    for (auto fence : m_fences)
+    {
+      vkDestroyFence(m_device, fence, nullptr);
+    }
+    m_timeline_semaphore = VK_NULL_HANDLE;
+    m_fences.clear();
+  }
+} // namespace esp
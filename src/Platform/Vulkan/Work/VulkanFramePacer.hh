@@ -0,0 +1,49 @@
+#ifndef PLATFORM_VULKAN_RENDER_API_VULKAN_FRAME_PACER_HH
+#define PLATFORM_VULKAN_RENDER_API_VULKAN_FRAME_PACER_HH
+
+#include "esppch.hh"
+
+// Render API
+#include "Core/RenderAPI/Work/EspFramePacer.hh"
+
+namespace esp
+{
+  /// @brief Frame pacer signaling frame values with a timeline semaphore (VK_KHR_timeline_semaphore). Devices without
+  /// timeline semaphores get a fence per frame in flight, each remembering value of the frame it was submitted with.
+  class VulkanFramePacer : public EspFramePacer
+  {
+   private:
+    VkDevice m_device;
+
+    VkSemaphore m_timeline_semaphore = VK_NULL_HANDLE;
+
+    std::vector<VkFence> m_fences;
+    std::vector<uint64_t> m_fence_values;
+    uint64_t m_completed_value = 0;
+
+   public:
+    /// @brief Creates pacer and its synchronization objects.
+    /// @param frames_in_flight Number of frames the GPU may be working on at once.
+    /// @param mode How far the CPU may get ahead of the GPU.
+    /// @return Unique pointer to the pacer.
+    static std::unique_ptr<VulkanFramePacer> create(uint32_t frames_in_flight, EspFramePacingMode mode);
+
+    /// @brief Returns the timeline semaphore the current frame's submission has to signal with get_frame_value().
+    /// @return Timeline semaphore or VK_NULL_HANDLE if the device doesn't support them.
+    inline VkSemaphore get_timeline_semaphore() const { return m_timeline_semaphore; }
+    /// @brief Returns the fence the current frame's submission has to signal. The fence is reset, so it has to be
+    /// submitted right away.
+    /// @return Fence of the current frame or VK_NULL_HANDLE if the timeline semaphore is used.
+    VkFence get_submit_fence();
+
+   protected:
+    virtual uint64_t query_completed_value() override;
+    virtual void wait_for_value(uint64_t value) override;
+    virtual void destroy() override;
+
+   private:
+    VulkanFramePacer(VkDevice device, uint32_t frames_in_flight, EspFramePacingMode mode);
+  };
+} // namespace esp
+
+#endif // PLATFORM_VULKAN_RENDER_API_VULKAN_FRAME_PACER_HH
@@ -0,0 +1,159 @@
+#include "VulkanGpuProfiler.hh"
+
+// platform
+#include "Platform/Vulkan/VulkanContext.hh"
+#include "Platform/Vulkan/VulkanDevice.hh"
+#include "VulkanWorkOrchestrator.hh"
+
+/* --------------------------------------------------------- */
+/* ---------------- CLASS IMPLEMENTATION ------------------- */
+/* --------------------------------------------------------- */
+
+namespace esp
+{
+  std::unique_ptr<VulkanGpuProfiler> VulkanGpuProfiler::create()
+  {
+    auto& context_data = VulkanContext::get_context_data();
+    auto& properties   = VulkanDevice::get_properties();
+
+    uint32_t queue_family_count = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(VulkanDevice::get_physical_device(), &queue_family_count, nullptr);
+    std::vector<VkQueueFamilyProperties> queue_families(queue_family_count);
+    vkGetPhysicalDeviceQueueFamilyProperties(VulkanDevice::get_physical_device(),
+                                             &queue_family_count,
+                                             queue_families.data());
+
+    auto valid_bits = queue_families[context_data.m_queue_family_indices.m_graphics_family.value()].timestampValidBits;
+    if (valid_bits == 0 || properties.limits.timestampPeriod == 0.0f)
+    {
+      ESP_CORE_WARN("Graphics queue can't write timestamps. GPU profiler is disabled.");
+      return nullptr;
+    }
+
+    return std::unique_ptr<VulkanGpuProfiler>(new VulkanGpuProfiler(VulkanDevice::get_logical_device(),
+                                                                    VulkanSwapChain::get_frames_in_flight(),
+                                                                    properties.limits.timestampPeriod,
+                                                                    valid_bits));
+  }
+
+  VulkanGpuProfiler::VulkanGpuProfiler(VkDevice device,
+                                       uint32_t frames_in_flight,
+                                       double timestamp_period,
+                                       uint32_t valid_bits) :
+      EspGpuProfiler(frames_in_flight, VulkanDevice::get_enabled_features().pipelineStatisticsQuery),
+      m_device{ device }, m_timestamp_period{ timestamp_period },
+      m_timestamp_mask{ valid_bits >= 64 ? UINT64_MAX : (uint64_t{ 1 } << valid_bits) - 1 }
+  {
+    VkQueryPoolCreateInfo timestamp_pool_info = {};
+    timestamp_pool_info.sType                 = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    timestamp_pool_info.queryType             = VK_QUERY_TYPE_TIMESTAMP;
+    timestamp_pool_info.queryCount            = frames_in_flight * MAX_TIMESTAMPS;
+
+    ESP_ASSERT(vkCreateQueryPool(m_device, &timestamp_pool_info, nullptr, &m_timestamp_pool) == VK_SUCCESS,
+               "Failed to create timestamp query pool")
+
+    if (!VulkanDevice::get_enabled_features().pipelineStatisticsQuery) { return; }
+
+    VkQueryPoolCreateInfo statistics_pool_info = {};
+    statistics_pool_info.sType                 = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    statistics_pool_info.queryType             = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+    statistics_pool_info.queryCount            = frames_in_flight * MAX_SCOPES;
+    statistics_pool_info.pipelineStatistics    = PIPELINE_STATISTICS;
+
+    ESP_ASSERT(vkCreateQueryPool(m_device, &statistics_pool_info, nullptr, &m_statistics_pool) == VK_SUCCESS,
+               "Failed to create pipeline statistics query pool")
+  }
+
+  VkQueryPipelineStatisticFlags VulkanGpuProfiler::get_inherited_statistics()
+  {
+    if (!s_instance || !VulkanDevice::get_enabled_features().inheritedQueries) { return 0; }
+    return PIPELINE_STATISTICS;
+  }
+
+  void VulkanGpuProfiler::reset_queries(uint32_t frame_index)
+  {
+    auto command_buffer = VulkanWorkOrchestrator::get_current_command_buffer();
+
+    vkCmdResetQueryPool(command_buffer, m_timestamp_pool, frame_index * MAX_TIMESTAMPS, MAX_TIMESTAMPS);
+    if (m_statistics_pool != VK_NULL_HANDLE)
+    {
+      vkCmdResetQueryPool(command_buffer, m_statistics_pool, frame_index * MAX_SCOPES, MAX_SCOPES);
+    }
+  }
+
+  void VulkanGpuProfiler::write_timestamp(uint32_t frame_index, uint32_t query, bool end)
+  {
+    vkCmdWriteTimestamp(VulkanWorkOrchestrator::get_current_command_buffer(),
+                        end ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                        m_timestamp_pool,
+                        frame_index * MAX_TIMESTAMPS + query);
+  }
+
+  void VulkanGpuProfiler::begin_statistics(uint32_t frame_index, uint32_t scope)
+  {
+    vkCmdBeginQuery(VulkanWorkOrchestrator::get_current_command_buffer(),
+                    m_statistics_pool,
+                    frame_index * MAX_SCOPES + scope,
+                    0);
+  }
+
+  void VulkanGpuProfiler::end_statistics(uint32_t frame_index, uint32_t scope)
+  {
+    vkCmdEndQuery(VulkanWorkOrchestrator::get_current_command_buffer(),
+                  m_statistics_pool,
+                  frame_index * MAX_SCOPES + scope);
+  }
+
+  bool VulkanGpuProfiler::read_timestamps(uint32_t frame_index, uint32_t count, std::vector<double>& timestamps)
+  {
+    // the frame is finished, so the results are read without waiting
+    std::vector<uint64_t> ticks(count);
+    auto result = vkGetQueryPoolResults(m_device,
+                                        m_timestamp_pool,
+                                        frame_index * MAX_TIMESTAMPS,
+                                        count,
+                                        ticks.size() * sizeof(uint64_t),
+                                        ticks.data(),
+                                        sizeof(uint64_t),
+                                        VK_QUERY_RESULT_64_BIT);
+    if (result != VK_SUCCESS) { return false; }
+
+    timestamps.resize(count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+      timestamps[i] = static_cast<double>(ticks[i] & m_timestamp_mask) * m_timestamp_period;
+    }
+    return true;
+  }
+
+  bool VulkanGpuProfiler::read_statistics(uint32_t frame_index, uint32_t scope, EspPipelineStatistics& statistics)
+  {
+    // one value per bit of PIPELINE_STATISTICS, in the same order as fields of EspPipelineStatistics
+    uint64_t values[5] = {};
+
+    auto result = vkGetQueryPoolResults(m_device,
+                                        m_statistics_pool,
+                                        frame_index * MAX_SCOPES + scope,
+                                        1,
+                                        sizeof(values),
+                                        values,
+                                        sizeof(values),
+                                        VK_QUERY_RESULT_64_BIT);
+    if (result != VK_SUCCESS) { return false; }
+
+    statistics.m_input_assembly_vertices     = values[0];
+    statistics.m_input_assembly_primitives   = values[1];
+    statistics.m_vertex_shader_invocations   = values[2];
+    statistics.m_clipping_primitives         = values[3];
+    statistics.m_fragment_shader_invocations = values[4];
+    return true;
+  }
+
+  void VulkanGpuProfiler::destroy()
+  {
+    vkDestroyQueryPool(m_device, m_timestamp_pool, nullptr);
+    if (m_statistics_pool != VK_NULL_HANDLE) { vkDestroyQueryPool(m_device, m_statistics_pool, nullptr); }
+    m_timestamp_pool  = VK_NULL_HANDLE;
+    m_statistics_pool = VK_NULL_HANDLE;
+  }
+} // namespace esp
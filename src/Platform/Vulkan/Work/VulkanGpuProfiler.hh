@@ -0,0 +1,57 @@
+#ifndef PLATFORM_VULKAN_RENDER_API_VULKAN_GPU_PROFILER_HH
+#define PLATFORM_VULKAN_RENDER_API_VULKAN_GPU_PROFILER_HH
+
+#include "esppch.hh"
+
+// Render API
+#include "Core/RenderAPI/Work/EspGpuProfiler.hh"
+
+namespace esp
+{
+  /// @brief GPU profiler writing timestamps and pipeline statistics into query pools. Every frame in flight uses its
+  /// own range of queries of both pools.
+  class VulkanGpuProfiler : public EspGpuProfiler
+  {
+   public:
+    /// @brief Statistics collected for profiler scopes, results are written in order of the bits.
+    static constexpr VkQueryPipelineStatisticFlags PIPELINE_STATISTICS =
+        VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+
+   private:
+    VkDevice m_device;
+
+    VkQueryPool m_timestamp_pool  = VK_NULL_HANDLE;
+    VkQueryPool m_statistics_pool = VK_NULL_HANDLE;
+
+    // nanoseconds per timestamp tick and mask of bits written by the graphics queue
+    double m_timestamp_period;
+    uint64_t m_timestamp_mask;
+
+   public:
+    /// @brief Creates profiler and its query pools.
+    /// @return Unique pointer to the profiler. nullptr if the graphics queue can't write timestamps.
+    static std::unique_ptr<VulkanGpuProfiler> create();
+
+    /// @brief Returns statistics secondary command buffers have to inherit, as they may be executed inside a scope.
+    /// @return Pipeline statistics of scopes or 0 if they aren't collected.
+    static VkQueryPipelineStatisticFlags get_inherited_statistics();
+
+   protected:
+    virtual void reset_queries(uint32_t frame_index) override;
+    virtual void write_timestamp(uint32_t frame_index, uint32_t query, bool end) override;
+    virtual void begin_statistics(uint32_t frame_index, uint32_t scope) override;
+    virtual void end_statistics(uint32_t frame_index, uint32_t scope) override;
+    virtual bool read_timestamps(uint32_t frame_index, uint32_t count, std::vector<double>& timestamps) override;
+    virtual bool read_statistics(uint32_t frame_index, uint32_t scope, EspPipelineStatistics& statistics) override;
+    virtual void destroy() override;
+
+   private:
+    VulkanGpuProfiler(VkDevice device, uint32_t frames_in_flight, double timestamp_period, uint32_t valid_bits);
+  };
+} // namespace esp
+
+#endif // PLATFORM_VULKAN_RENDER_API_VULKAN_GPU_PROFILER_HH
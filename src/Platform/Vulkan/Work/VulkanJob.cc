@@ -1,5 +1,7 @@
 #include "VulkanJob.hh"
 #include "Platform/Vulkan/RenderPlans/VulkanCommandBuffer.hh"
+#include "Platform/Vulkan/Resources/VulkanDrawCommandBuffer.hh"
+#include "Platform/Vulkan/Resources/VulkanStorageBuffer.hh"
 #include "Platform/Vulkan/Resources/VulkanTexture.hh"
 #include "Platform/Vulkan/VulkanDevice.hh"
 #include "VulkanWorkOrchestrator.hh"
@@ -67,6 +69,95 @@ namespace esp
                      0);
   }
 
+  void VulkanJob::draw_indexed_indirect(EspDrawCommandBuffer& buffer, uint32_t first_command, uint32_t draw_count)
+  {
+    draw_indexed_indirect(VulkanWorkOrchestrator::get_current_command_buffer(), buffer, first_command, draw_count);
+  }
+
+  void VulkanJob::draw_indexed_indirect(EspCommandBufferId* id,
+                                        EspDrawCommandBuffer& buffer,
+                                        uint32_t first_command,
+                                        uint32_t draw_count)
+  {
+    draw_indexed_indirect(static_cast<VulkanCommandBufferId*>(id)->m_command_buffer, buffer, first_command, draw_count);
+  }
+
+  void VulkanJob::draw_indexed_indirect_count(EspDrawCommandBuffer& buffer)
+  {
+    draw_indexed_indirect_count(VulkanWorkOrchestrator::get_current_command_buffer(), buffer);
+  }
+
+  void VulkanJob::draw_indexed_indirect_count(EspCommandBufferId* id, EspDrawCommandBuffer& buffer)
+  {
+    draw_indexed_indirect_count(static_cast<VulkanCommandBufferId*>(id)->m_command_buffer, buffer);
+  }
+
+  void VulkanJob::dispatch(uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z)
+  {
+    vkCmdDispatch(VulkanWorkOrchestrator::get_current_command_buffer(), group_count_x, group_count_y, group_count_z);
+  }
+
+  void VulkanJob::dispatch(EspCommandBufferId* id,
+                           uint32_t group_count_x,
+                           uint32_t group_count_y,
+                           uint32_t group_count_z)
+  {
+    vkCmdDispatch(static_cast<VulkanCommandBufferId*>(id)->m_command_buffer,
+                  group_count_x,
+                  group_count_y,
+                  group_count_z);
+  }
+
+  void VulkanJob::dispatch_indirect(EspStorageBuffer& buffer, uint32_t offset)
+  {
+    ESP_ASSERT(offset + sizeof(VkDispatchIndirectCommand) <= buffer.get_size(), "Dispatch is out of the buffer.")
+
+    vkCmdDispatchIndirect(VulkanWorkOrchestrator::get_current_command_buffer(),
+                          static_cast<VulkanStorageBuffer&>(buffer).get_buffer(),
+                          offset);
+  }
+
+  void VulkanJob::dispatch_indirect(EspCommandBufferId* id, EspStorageBuffer& buffer, uint32_t offset)
+  {
+    ESP_ASSERT(offset + sizeof(VkDispatchIndirectCommand) <= buffer.get_size(), "Dispatch is out of the buffer.")
+
+    vkCmdDispatchIndirect(static_cast<VulkanCommandBufferId*>(id)->m_command_buffer,
+                          static_cast<VulkanStorageBuffer&>(buffer).get_buffer(),
+                          offset);
+  }
+
+  void VulkanJob::clear_storage_buffer(EspStorageBuffer& buffer)
+  {
+    vkCmdFillBuffer(VulkanWorkOrchestrator::get_current_command_buffer(),
+                    static_cast<VulkanStorageBuffer&>(buffer).get_buffer(),
+                    0,
+                    VK_WHOLE_SIZE,
+                    0);
+  }
+
+  void VulkanJob::clear_storage_buffer(EspCommandBufferId* id, EspStorageBuffer& buffer)
+  {
+    vkCmdFillBuffer(static_cast<VulkanCommandBufferId*>(id)->m_command_buffer,
+                    static_cast<VulkanStorageBuffer&>(buffer).get_buffer(),
+                    0,
+                    VK_WHOLE_SIZE,
+                    0);
+  }
+
+  void VulkanJob::barrier(EspBarrier barrier)
+  {
+    VulkanJob::barrier(VulkanWorkOrchestrator::get_current_command_buffer(), barrier);
+  }
+
+  void VulkanJob::barrier(EspCommandBufferId* id, EspBarrier barrier)
+  {
+    auto vulkan_id = static_cast<VulkanCommandBufferId*>(id);
+    ESP_ASSERT(!vulkan_id->m_compute_only || esp_barrier_is_compute_queue_compatible(barrier),
+               "Barrier uses graphics stages, which the compute queue doesn't support.")
+
+    VulkanJob::barrier(vulkan_id->m_command_buffer, barrier);
+  }
+
   void VulkanJob::copy_image(EspCommandBufferId* id,
                              std::shared_ptr<EspTexture> src_texture,
                              EspImageLayout src_layout,
@@ -180,6 +271,12 @@ namespace esp
       // Make sure any shader reads from the image have been finished
       image_memory_barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
       break;
+
+    case VK_IMAGE_LAYOUT_GENERAL:
+      // Image is a storage image
+      // Make sure any shader writes to the image have been finished
+      image_memory_barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+      break;
     default:
       // Other source layouts aren't handled (yet)
       break;
@@ -223,6 +320,11 @@ namespace esp
       }
       image_memory_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
       break;
+
+    case VK_IMAGE_LAYOUT_GENERAL:
+      // Image will be read and written by shaders as a storage image
+      image_memory_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+      break;
     default:
       // Other source layouts aren't handled (yet)
       break;
@@ -240,4 +342,113 @@ namespace esp
                          1,
                          &image_memory_barrier);
   }
+
+  /*---------------------------------------------------------------------------*/
+
+  void VulkanJob::draw_indexed_indirect(VkCommandBuffer command_buffer,
+                                        EspDrawCommandBuffer& buffer,
+                                        uint32_t first_command,
+                                        uint32_t draw_count)
+  {
+    ESP_ASSERT(first_command + draw_count <= buffer.get_max_command_count(), "Draw is out of the command buffer.")
+
+    auto& vulkan_buffer = static_cast<VulkanDrawCommandBuffer&>(buffer);
+    uint32_t stride     = sizeof(VkDrawIndexedIndirectCommand);
+    VkDeviceSize offset = vulkan_buffer.get_command_offset() + first_command * stride;
+
+    if (VulkanDevice::get_enabled_features().multiDrawIndirect)
+    {
+      vkCmdDrawIndexedIndirect(command_buffer, vulkan_buffer.get_command_buffer(), offset, draw_count, stride);
+      return;
+    }
+
+    // without multi draw indirect only a single command can be drawn at once
+    for (uint32_t i = 0; i < draw_count; i++)
+    {
+      vkCmdDrawIndexedIndirect(command_buffer, vulkan_buffer.get_command_buffer(), offset + i * stride, 1, stride);
+    }
+  }
+
+  void VulkanJob::draw_indexed_indirect_count(VkCommandBuffer command_buffer, EspDrawCommandBuffer& buffer)
+  {
+    if (!VulkanDevice::is_draw_indirect_count_supported())
+    {
+      // the count was written by the CPU, so it's known while recording
+      draw_indexed_indirect(command_buffer, buffer, 0, buffer.get_command_count());
+      return;
+    }
+
+    auto& vulkan_buffer = static_cast<VulkanDrawCommandBuffer&>(buffer);
+    vkCmdDrawIndexedIndirectCountKHR(command_buffer,
+                                     vulkan_buffer.get_command_buffer(),
+                                     vulkan_buffer.get_command_offset(),
+                                     vulkan_buffer.get_count_buffer(),
+                                     vulkan_buffer.get_count_offset(),
+                                     buffer.get_max_command_count(),
+                                     sizeof(VkDrawIndexedIndirectCommand));
+  }
+
+  void VulkanJob::barrier(VkCommandBuffer command_buffer, EspBarrier barrier)
+  {
+    auto scope = esp_barrier_scope(barrier);
+
+    VkPipelineStageFlags src_stage = 0;
+    VkPipelineStageFlags dst_stage = 0;
+
+    VkMemoryBarrier memory_barrier{};
+    memory_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+
+    // source stages make their writes available
+    if (scope.m_src_stages & ESP_BARRIER_STAGE_TRANSFER)
+    {
+      src_stage |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+      memory_barrier.srcAccessMask |= VK_ACCESS_TRANSFER_WRITE_BIT;
+    }
+    if (scope.m_src_stages & ESP_BARRIER_STAGE_COMPUTE)
+    {
+      src_stage |= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+      memory_barrier.srcAccessMask |= VK_ACCESS_SHADER_WRITE_BIT;
+    }
+    if (scope.m_src_stages & ESP_BARRIER_STAGE_VERTEX)
+    {
+      src_stage |= VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
+      memory_barrier.srcAccessMask |= VK_ACCESS_SHADER_WRITE_BIT;
+    }
+    if (scope.m_src_stages & ESP_BARRIER_STAGE_FRAGMENT)
+    {
+      src_stage |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+      memory_barrier.srcAccessMask |= VK_ACCESS_SHADER_WRITE_BIT;
+    }
+    if (scope.m_src_stages & ESP_BARRIER_STAGE_ATTACHMENT)
+    {
+      src_stage |= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+      memory_barrier.srcAccessMask |= VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    }
+
+    // destination stages wait for them to become visible
+    if (scope.m_dst_stages & ESP_BARRIER_STAGE_COMPUTE)
+    {
+      dst_stage |= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+      memory_barrier.dstAccessMask |= VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    }
+    if (scope.m_dst_stages & ESP_BARRIER_STAGE_INDIRECT)
+    {
+      // indirect dispatches read their commands at the draw indirect stage as well
+      dst_stage |= VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+      memory_barrier.dstAccessMask |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+    }
+    if (scope.m_dst_stages & ESP_BARRIER_STAGE_VERTEX)
+    {
+      dst_stage |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
+      memory_barrier.dstAccessMask |=
+          VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+    }
+    if (scope.m_dst_stages & ESP_BARRIER_STAGE_FRAGMENT)
+    {
+      dst_stage |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+      memory_barrier.dstAccessMask |= VK_ACCESS_SHADER_READ_BIT;
+    }
+
+    vkCmdPipelineBarrier(command_buffer, src_stage, dst_stage, 0, 1, &memory_barrier, 0, nullptr, 0, nullptr);
+  }
 } // namespace esp
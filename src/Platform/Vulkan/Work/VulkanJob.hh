@@ -40,6 +40,28 @@ namespace esp
                              uint32_t instance_count = 1,
                              uint32_t first_index    = 0);
 
+    static void draw_indexed_indirect(EspDrawCommandBuffer& buffer, uint32_t first_command, uint32_t draw_count);
+    static void draw_indexed_indirect(EspCommandBufferId* id,
+                                      EspDrawCommandBuffer& buffer,
+                                      uint32_t first_command,
+                                      uint32_t draw_count);
+    static void draw_indexed_indirect_count(EspDrawCommandBuffer& buffer);
+    static void draw_indexed_indirect_count(EspCommandBufferId* id, EspDrawCommandBuffer& buffer);
+
+    static void dispatch(uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z);
+    static void dispatch(EspCommandBufferId* id,
+                         uint32_t group_count_x,
+                         uint32_t group_count_y,
+                         uint32_t group_count_z);
+    static void dispatch_indirect(EspStorageBuffer& buffer, uint32_t offset);
+    static void dispatch_indirect(EspCommandBufferId* id, EspStorageBuffer& buffer, uint32_t offset);
+
+    static void clear_storage_buffer(EspStorageBuffer& buffer);
+    static void clear_storage_buffer(EspCommandBufferId* id, EspStorageBuffer& buffer);
+
+    static void barrier(EspBarrier barrier);
+    static void barrier(EspCommandBufferId* id, EspBarrier barrier);
+
     static void copy_image(EspCommandBufferId* id,
                            std::shared_ptr<EspTexture> src_texture,
                            EspImageLayout src_layout,
@@ -52,6 +74,15 @@ namespace esp
                                        EspImageLayout old_layout,
                                        EspImageLayout new_layout,
                                        EspImageSubresourceRange image_subresource_range);
+
+    /* -------------------------- PRIVATE METHODS -------------------------- */
+   private:
+    static void draw_indexed_indirect(VkCommandBuffer command_buffer,
+                                      EspDrawCommandBuffer& buffer,
+                                      uint32_t first_command,
+                                      uint32_t draw_count);
+    static void draw_indexed_indirect_count(VkCommandBuffer command_buffer, EspDrawCommandBuffer& buffer);
+    static void barrier(VkCommandBuffer command_buffer, EspBarrier barrier);
   };
 } // namespace esp
 
@@ -41,6 +41,16 @@ namespace esp
 
   void VulkanSwapChain::init(EspPresentationMode presentation_mode)
   {
+    m_presentation_mode = presentation_mode;
+
+    auto& context_data = VulkanContext::get_context_data();
+    m_headless         = context_data.m_headless;
+    if (m_headless)
+    {
+      create_offscreen_targets(context_data.m_offscreen_extent);
+      return;
+    }
+
     create_swap_chain(VK_NULL_HANDLE, presentation_mode);
   }
 
@@ -53,6 +63,7 @@ namespace esp
       buffer.terminate();
     }
     m_swap_chain_buffers.clear();
+    m_offscreen_targets.clear();
 
     if (m_swap_chain != nullptr)
     {
@@ -63,6 +74,31 @@ namespace esp
     VulkanSwapChain::s_instance = nullptr;
   }
 
+  void VulkanSwapChain::recreate()
+  {
+    // a minimized window has nothing to present to, so wait until it's restored
+    int width = 0, height = 0;
+    EspWindow::get_framebuffer_size(width, height);
+    while (width == 0 || height == 0)
+    {
+      glfwWaitEvents();
+      EspWindow::get_framebuffer_size(width, height);
+    }
+
+    for (auto buffer : m_swap_chain_buffers)
+    {
+      buffer.terminate();
+    }
+    m_swap_chain_buffers.clear();
+
+    // images of the old swap chain may be reused by the new one
+    auto old_swap_chain = m_swap_chain;
+    create_swap_chain(old_swap_chain, m_presentation_mode);
+    vkDestroySwapchainKHR(VulkanDevice::get_logical_device(), old_swap_chain, nullptr);
+
+    ESP_CORE_INFO("Swap chain recreated ({}x{}).", m_swap_chain_extent.width, m_swap_chain_extent.height);
+  }
+
   void VulkanSwapChain::create_swap_chain(VkSwapchainKHR old_swap_chain, EspPresentationMode presentation_mode)
   {
     auto& context_data = VulkanContext::get_context_data();
@@ -141,6 +177,28 @@ namespace esp
     m_swap_chain_extent       = extent;
   }
 
+  void VulkanSwapChain::create_offscreen_targets(VkExtent2D extent)
+  {
+    // every frame in flight gets its own target, so finished frames can be read back while the next ones are
+    // rendered. Blocks are created with transfer source usage.
+    for (uint32_t i = 0; i < get_frames_in_flight(); i++)
+    {
+      m_offscreen_targets.push_back(std::make_unique<VulkanBlock>(EspBlockFormat::ESP_FORMAT_R8G8B8A8_UNORM,
+                                                                  EspSampleCountFlag::ESP_SAMPLE_COUNT_1_BIT,
+                                                                  extent.width,
+                                                                  extent.height,
+                                                                  glm::vec3{ 0.0f }));
+    }
+
+    m_swap_chain_image_format = VK_FORMAT_R8G8B8A8_UNORM;
+    m_swap_chain_extent       = extent;
+
+    ESP_CORE_INFO("Rendering headless into {} offscreen targets ({}x{}).",
+                  m_offscreen_targets.size(),
+                  extent.width,
+                  extent.height);
+  }
+
   SwapChainSupportDetails VulkanSwapChain::query_swap_chain_support(const VkPhysicalDevice& device,
                                                                     const VulkanContextData& context_data)
   {
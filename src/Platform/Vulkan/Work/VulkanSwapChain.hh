@@ -4,7 +4,9 @@
 #include "esppch.hh"
 
 #include "Core/EspApplicationParams.hh"
+#include "Core/RenderAPI/Work/EspFramePacer.hh"
 
+#include "Platform/Vulkan/RenderPlans/Block/VulkanBlock.hh"
 #include "Platform/Vulkan/VulkanContext.hh"
 
 namespace esp
@@ -37,22 +39,29 @@ namespace esp
    private:
     static VulkanSwapChain* s_instance;
 
-    VkSwapchainKHR m_swap_chain;
+    VkSwapchainKHR m_swap_chain = VK_NULL_HANDLE;
 
     VkExtent2D m_swap_chain_extent;
     VkFormat m_swap_chain_image_format;
 
     std::vector<VulkanSwapChainBuffer> m_swap_chain_buffers;
+    EspPresentationMode m_presentation_mode;
+
+    // headless mode replaces swap chain images with one offscreen block per frame in flight
+    bool m_headless = false;
+    std::vector<std::unique_ptr<VulkanBlock>> m_offscreen_targets;
 
     uint32_t m_current_frame = 0;
     uint32_t m_image_index   = 0;
 
    public:
-    static constexpr int MAX_FRAMES_IN_FLIGHT = 2;
+    // upper bound used for sizes of per-frame arrays, get_frames_in_flight() returns the number actually used
+    static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = EspFramePacer::MAX_FRAMES_IN_FLIGHT;
 
     /* -------------------------- METHODS ---------------------------------- */
    private:
     void create_swap_chain(VkSwapchainKHR old_swap_chain, EspPresentationMode presentation_mode);
+    void create_offscreen_targets(VkExtent2D extent);
 
    public:
     VulkanSwapChain();
@@ -63,9 +72,19 @@ namespace esp
 
     void init(EspPresentationMode presentation_mode);
     void terminate();
+    // Replaces the swap chain after it got out of date or suboptimal, e.g. when the window was resized. The device
+    // has to be idle.
+    void recreate();
 
     inline VkResult acquire_next_image(std::vector<VkSemaphore>& image_available_semaphores)
     {
+      // the frame pacer has already waited until the offscreen target of this frame is free
+      if (m_headless)
+      {
+        m_image_index = m_current_frame;
+        return VK_SUCCESS;
+      }
+
       return vkAcquireNextImageKHR(VulkanDevice::get_logical_device(),
                                    m_swap_chain,
                                    std::numeric_limits<uint64_t>::max(),
@@ -75,25 +94,32 @@ namespace esp
                                    &m_image_index);
     }
 
-    inline void go_to_next_frame() { m_current_frame = (m_current_frame + 1) % MAX_FRAMES_IN_FLIGHT; }
-
     /* -------------------------- STATIC METHODS --------------------------- */
    public:
     inline static VkImage get_current_image()
     {
+      if (s_instance->m_headless) { return s_instance->m_offscreen_targets[s_instance->m_image_index]->get_image(); }
       return s_instance->m_swap_chain_buffers[s_instance->m_image_index].m_image;
     }
 
     inline static VkImageView get_current_image_view()
     {
+      if (s_instance->m_headless)
+      {
+        return s_instance->m_offscreen_targets[s_instance->m_image_index]->get_image_view();
+      }
       return s_instance->m_swap_chain_buffers[s_instance->m_image_index].m_image_view;
     }
 
+    // true if frames are rendered into offscreen targets instead of swap chain images
+    inline static bool is_headless() { return s_instance->m_headless; }
+
     static std::unique_ptr<VulkanSwapChain> create(EspPresentationMode presentation_mode);
     static SwapChainSupportDetails query_swap_chain_support(const VkPhysicalDevice& device,
                                                             const VulkanContextData& context_data);
     inline static VkFormat* get_swap_chain_image_format() { return &(s_instance->m_swap_chain_image_format); }
     inline static uint32_t get_current_frame_index() { return s_instance->m_current_frame; }
+    inline static uint32_t get_frames_in_flight() { return VulkanContext::get_context_data().m_frames_in_flight; }
   };
 } // namespace esp
 
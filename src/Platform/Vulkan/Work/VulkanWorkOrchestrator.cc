@@ -1,4 +1,6 @@
 #include "VulkanWorkOrchestrator.hh"
+#include "Core/RenderAPI/Resources/EspBindlessTextures.hh"
+#include "Core/RenderAPI/Work/EspGpuProfiler.hh"
 #include "Platform/Vulkan/VulkanContext.hh"
 #include "Platform/Vulkan/VulkanDevice.hh"
 #include "Platform/Vulkan/VulkanResourceManager.hh"
@@ -7,12 +9,16 @@
 namespace esp
 {
   VulkanWorkOrchestrator* VulkanWorkOrchestrator::s_instance = nullptr;
+  uint64_t VulkanWorkOrchestrator::s_generation              = 0;
 
-  std::unique_ptr<VulkanWorkOrchestrator> VulkanWorkOrchestrator::create(EspPresentationMode presentation_mode)
+  std::unique_ptr<VulkanWorkOrchestrator> VulkanWorkOrchestrator::create(EspPresentationMode presentation_mode,
+                                                                         EspFramePacingMode frame_pacing)
   {
     ESP_ASSERT(VulkanWorkOrchestrator::s_instance == nullptr, "The vulkan work orchestrator already exists!");
     VulkanWorkOrchestrator::s_instance = new VulkanWorkOrchestrator();
-    VulkanWorkOrchestrator::s_instance->init(presentation_mode);
+    // thread local pools of the previous orchestrator mustn't be reused
+    VulkanWorkOrchestrator::s_generation++;
+    VulkanWorkOrchestrator::s_instance->init(presentation_mode, frame_pacing);
 
     return std::unique_ptr<VulkanWorkOrchestrator>{ VulkanWorkOrchestrator::s_instance };
   }
@@ -21,14 +27,23 @@ namespace esp
 
   VulkanWorkOrchestrator::~VulkanWorkOrchestrator() {}
 
-  void VulkanWorkOrchestrator::init(EspPresentationMode presentation_mode)
+  void VulkanWorkOrchestrator::init(EspPresentationMode presentation_mode, EspFramePacingMode frame_pacing)
   {
-    m_swap_chain = VulkanSwapChain::create(presentation_mode);
+    m_swap_chain  = VulkanSwapChain::create(presentation_mode);
+    m_frame_pacer = VulkanFramePacer::create(VulkanSwapChain::get_frames_in_flight(), frame_pacing);
+    // before any buffer is created, so all of them are shared with the async compute queue
+    m_async_compute  = VulkanAsyncCompute::create(VulkanSwapChain::get_frames_in_flight());
+    m_deletion_queue = EspDeletionQueue::create();
+    m_uniform_arena  = VulkanUniformArena::create(EspUniformArena::DEFAULT_FRAME_SIZE,
+                                                  VulkanSwapChain::get_frames_in_flight());
+    m_mip_generator  = VulkanMipGenerator::create();
 
     create_command_pool();
     create_command_buffers();
     create_sync_objects();
     load_extension_functions();
+
+    if (VulkanSwapChain::is_headless()) { create_readback_buffers(); }
   }
 
   void VulkanWorkOrchestrator::terminate()
@@ -36,14 +51,46 @@ namespace esp
     ESP_ASSERT(VulkanWorkOrchestrator::s_instance != nullptr, "The vulkan work orchestrator is deleted twice!");
 
     // Idle until all queues have finish their work
+    vkDeviceWaitIdle(VulkanDevice::get_logical_device());
 
-    for (size_t i = 0; i < VulkanSwapChain::MAX_FRAMES_IN_FLIGHT; i++)
+    for (size_t i = 0; i < VulkanSwapChain::get_frames_in_flight(); i++)
     {
       vkDestroySemaphore(VulkanDevice::get_logical_device(), m_render_finished_semaphores[i], nullptr);
       vkDestroySemaphore(VulkanDevice::get_logical_device(), m_image_available_semaphores[i], nullptr);
-      vkDestroyFence(VulkanDevice::get_logical_device(), m_in_flight_fences[i], nullptr);
     }
 
+    m_frame_pacer->terminate();
+    m_frame_pacer.reset();
+
+    m_uniform_arena->terminate();
+    m_uniform_arena.reset();
+
+    m_mip_generator->terminate();
+    m_mip_generator.reset();
+
+    m_async_compute->terminate();
+    m_async_compute.reset();
+
+    // the device is idle, so the last frames can be delivered (oldest first)
+    std::vector<uint32_t> pending_readbacks;
+    for (uint32_t i = 0; i < m_readbacks.size(); i++)
+    {
+      if (m_readbacks[i].m_pending) { pending_readbacks.push_back(i); }
+    }
+    std::sort(pending_readbacks.begin(),
+              pending_readbacks.end(),
+              [this](uint32_t a, uint32_t b) { return m_readbacks[a].m_frame_value < m_readbacks[b].m_frame_value; });
+    for (auto frame_index : pending_readbacks)
+    {
+      deliver_readback(frame_index);
+    }
+    m_readbacks.clear();
+
+    // the device is idle, so everything waiting for frames in flight can be destroyed
+    m_deletion_queue->terminate();
+    m_deletion_queue.reset();
+
+    destroy_thread_command_pools();
     vkDestroyCommandPool(VulkanDevice::get_logical_device(), m_command_pool, nullptr);
     m_swap_chain->terminate();
 
@@ -52,16 +99,32 @@ namespace esp
 
   void VulkanWorkOrchestrator::begin_frame()
   {
-    auto current_frame = m_swap_chain->m_current_frame;
-    vkWaitForFences(VulkanDevice::get_logical_device(),
-                    1,
-                    &m_in_flight_fences[current_frame],
-                    VK_TRUE,
-                    std::numeric_limits<uint64_t>::max());
-    vkResetFences(VulkanDevice::get_logical_device(), 1, &m_in_flight_fences[current_frame]);
-
-    ESP_ASSERT(m_swap_chain->acquire_next_image(m_image_available_semaphores) == VK_SUCCESS,
-               "Failed to acquire swap chain image!");
+    ESP_PROFILE_SCOPE("VulkanWorkOrchestrator::begin_frame");
+
+    // blocks only if the CPU is ahead of the GPU by more than the pacing mode allows
+    auto current_frame            = m_frame_pacer->begin_frame();
+    m_swap_chain->m_current_frame = current_frame;
+
+    m_deletion_queue->begin_frame(m_frame_pacer->get_frame_value(), m_frame_pacer->get_completed_value());
+
+    // the previous frame of this index is finished, so its copy can be handed over before it's overwritten
+    if (VulkanSwapChain::is_headless()) { deliver_readback(current_frame); }
+
+    // GPU is done with the frame, so the secondary command buffers recorded for it can be reused
+    reset_thread_command_pools(current_frame);
+    VulkanDevice::get_descriptor_allocator().begin_frame(current_frame);
+    EspBindlessTextures::begin_frame();
+    m_uniform_arena->begin_frame(current_frame);
+    m_async_compute->begin_frame(current_frame);
+
+    auto result = m_swap_chain->acquire_next_image(m_image_available_semaphores);
+    if (result == VK_ERROR_OUT_OF_DATE_KHR)
+    {
+      recreate_swap_chain();
+      result = m_swap_chain->acquire_next_image(m_image_available_semaphores);
+    }
+    // suboptimal swap chain can still be presented to, it's recreated after presenting
+    ESP_ASSERT(result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR, "Failed to acquire swap chain image!");
     vkResetCommandBuffer(m_command_buffers[current_frame], /*VkCommandBufferResetFlagBits*/ 0);
 
     VkCommandBufferBeginInfo begin_info{};
@@ -69,39 +132,97 @@ namespace esp
 
     ESP_ASSERT(vkBeginCommandBuffer(m_command_buffers[current_frame], &begin_info) == VK_SUCCESS,
                "Failed to begin recording command buffer!");
+    m_frame_recording = true;
+
+    // resolves timings of the previous frame with this index, which the frame pacer has waited for
+    EspGpuProfiler::begin_frame(current_frame, m_frame_pacer->get_frame_value());
   }
 
   void VulkanWorkOrchestrator::end_frame()
   {
+    ESP_PROFILE_SCOPE("VulkanWorkOrchestrator::end_frame");
+
     auto current_frame = m_swap_chain->m_current_frame;
+    EspGpuProfiler::end_frame();
     ESP_ASSERT(vkEndCommandBuffer(m_command_buffers[current_frame]) == VK_SUCCESS, "Failed to record command buffer!");
+    m_frame_recording = false;
 
-    VkSubmitInfo submit_info{};
-    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    // offscreen targets are neither acquired nor presented, only the frame pacer waits for the rendering
+    bool headless = VulkanSwapChain::is_headless();
 
-    VkSemaphore wait_semaphores[]      = { m_image_available_semaphores[current_frame] };
-    VkPipelineStageFlags wait_stages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
-    submit_info.waitSemaphoreCount     = 1;
-    submit_info.pWaitSemaphores        = wait_semaphores;
-    submit_info.pWaitDstStageMask      = wait_stages;
+    // mip levels of textures created since the last frame are generated before the frame samples them
+    m_mip_generator->record();
 
-    submit_info.commandBufferCount = 1;
-    submit_info.pCommandBuffers    = &m_command_buffers[current_frame];
+    // compute work is submitted first, the frame waits for it only where its results may be consumed
+    auto timeline_semaphore      = m_frame_pacer->get_timeline_semaphore();
+    VkSemaphore compute_finished = VK_NULL_HANDLE;
+    auto compute_command_buffer  = m_async_compute->submit(timeline_semaphore,
+                                                          m_frame_pacer->get_frame_value(),
+                                                          compute_finished);
 
-    VkSemaphore signal_semaphores[]  = { m_render_finished_semaphores[current_frame] };
-    submit_info.signalSemaphoreCount = 1;
-    submit_info.pSignalSemaphores    = signal_semaphores;
+    VkSubmitInfo submit_info{};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
-    auto data_context = VulkanContext::get_context_data();
-    ESP_ASSERT(vkQueueSubmit(data_context.m_graphics_queue, 1, &submit_info, m_in_flight_fences[current_frame]) ==
-                   VK_SUCCESS,
-               "Failed to submit draw command buffer!")
+    std::vector<VkSemaphore> wait_semaphores;
+    std::vector<VkPipelineStageFlags> wait_stages;
+    if (!headless)
+    {
+      wait_semaphores.push_back(m_image_available_semaphores[current_frame]);
+      wait_stages.push_back(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+    }
+    if (compute_finished != VK_NULL_HANDLE)
+    {
+      wait_semaphores.push_back(compute_finished);
+      wait_stages.push_back(VulkanAsyncCompute::GRAPHICS_WAIT_STAGES);
+    }
+    submit_info.waitSemaphoreCount = static_cast<uint32_t>(wait_semaphores.size());
+    submit_info.pWaitSemaphores    = wait_semaphores.data();
+    submit_info.pWaitDstStageMask  = wait_stages.data();
+
+    std::vector<VkCommandBuffer> command_buffers;
+    if (compute_command_buffer != VK_NULL_HANDLE) { command_buffers.push_back(compute_command_buffer); }
+    command_buffers.push_back(m_command_buffers[current_frame]);
+    submit_info.commandBufferCount = static_cast<uint32_t>(command_buffers.size());
+    submit_info.pCommandBuffers    = command_buffers.data();
+
+    // the timeline semaphore gets the frame's value, values of binary semaphores are ignored
+    std::vector<VkSemaphore> signal_semaphores;
+    std::vector<uint64_t> signal_values;
+    if (!headless)
+    {
+      signal_semaphores.push_back(m_render_finished_semaphores[current_frame]);
+      signal_values.push_back(0);
+    }
+    if (timeline_semaphore != VK_NULL_HANDLE)
+    {
+      signal_semaphores.push_back(timeline_semaphore);
+      signal_values.push_back(m_frame_pacer->get_frame_value());
+    }
+    submit_info.signalSemaphoreCount = static_cast<uint32_t>(signal_semaphores.size());
+    submit_info.pSignalSemaphores    = signal_semaphores.data();
+
+    std::vector<uint64_t> wait_values(wait_semaphores.size(), 0);
+    VkTimelineSemaphoreSubmitInfoKHR timeline_info{};
+    timeline_info.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+    timeline_info.waitSemaphoreValueCount   = submit_info.waitSemaphoreCount;
+    timeline_info.pWaitSemaphoreValues      = wait_values.data();
+    timeline_info.signalSemaphoreValueCount = submit_info.signalSemaphoreCount;
+    timeline_info.pSignalSemaphoreValues    = signal_values.data();
+    if (timeline_semaphore != VK_NULL_HANDLE) { submit_info.pNext = &timeline_info; }
+
+    // called outside of the assertion, so the frame is submitted in release builds as well
+    auto data_context  = VulkanContext::get_context_data();
+    auto submit_fence  = m_frame_pacer->get_submit_fence();
+    auto submit_result = vkQueueSubmit(data_context.m_graphics_queue, 1, &submit_info, submit_fence);
+    ESP_ASSERT(submit_result == VK_SUCCESS, "Failed to submit draw command buffer!")
+
+    if (headless) { return; }
 
     VkPresentInfoKHR present_info{};
     present_info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
 
     present_info.waitSemaphoreCount = 1;
-    present_info.pWaitSemaphores    = signal_semaphores;
+    present_info.pWaitSemaphores    = &m_render_finished_semaphores[current_frame];
 
     VkSwapchainKHR swap_chains[] = { m_swap_chain->m_swap_chain };
     present_info.swapchainCount  = 1;
@@ -109,9 +230,9 @@ namespace esp
 
     present_info.pImageIndices = &m_swap_chain->m_image_index;
 
-    ESP_ASSERT(vkQueuePresentKHR(data_context.m_present_queue, &present_info) == VK_SUCCESS,
-               "Failed to present swap chain image!");
-    m_swap_chain->go_to_next_frame();
+    auto result = vkQueuePresentKHR(data_context.m_present_queue, &present_info);
+    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) { recreate_swap_chain(); }
+    else { ESP_ASSERT(result == VK_SUCCESS, "Failed to present swap chain image!"); }
   }
 
   void VulkanWorkOrchestrator::create_command_pool()
@@ -131,7 +252,7 @@ namespace esp
 
   void VulkanWorkOrchestrator::create_command_buffers()
   {
-    m_command_buffers.resize(VulkanSwapChain::MAX_FRAMES_IN_FLIGHT);
+    m_command_buffers.resize(VulkanSwapChain::get_frames_in_flight());
 
     VkCommandBufferAllocateInfo alloc_info{};
     alloc_info.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -146,18 +267,14 @@ namespace esp
 
   void VulkanWorkOrchestrator::create_sync_objects()
   {
-    m_image_available_semaphores.resize(VulkanSwapChain::MAX_FRAMES_IN_FLIGHT);
-    m_render_finished_semaphores.resize(VulkanSwapChain::MAX_FRAMES_IN_FLIGHT);
-    m_in_flight_fences.resize(VulkanSwapChain::MAX_FRAMES_IN_FLIGHT);
+    // frames are paced by the frame pacer, these only order acquiring, rendering and presenting
+    m_image_available_semaphores.resize(VulkanSwapChain::get_frames_in_flight());
+    m_render_finished_semaphores.resize(VulkanSwapChain::get_frames_in_flight());
 
     VkSemaphoreCreateInfo semaphore_info = {};
     semaphore_info.sType                 = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-    VkFenceCreateInfo fence_info = {};
-    fence_info.sType             = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-    fence_info.flags             = VK_FENCE_CREATE_SIGNALED_BIT;
-
-    for (size_t i = 0; i < VulkanSwapChain::MAX_FRAMES_IN_FLIGHT; i++)
+    for (size_t i = 0; i < VulkanSwapChain::get_frames_in_flight(); i++)
     {
       ESP_ASSERT(vkCreateSemaphore(VulkanDevice::get_logical_device(),
                                    &semaphore_info,
@@ -170,10 +287,6 @@ namespace esp
                                    nullptr,
                                    &m_render_finished_semaphores[i]) == VK_SUCCESS,
                  "Failed to create semaphores (part 2) for Work Orchestrator");
-
-      ESP_ASSERT(vkCreateFence(VulkanDevice::get_logical_device(), &fence_info, nullptr, &m_in_flight_fences[i]) ==
-                     VK_SUCCESS,
-                 "Failed to create fences for Work Orchestrator")
     }
   }
 
@@ -187,6 +300,87 @@ namespace esp
         vkGetDeviceProcAddr(VulkanDevice::get_logical_device(), "vkCmdEndRenderingKHR"));
   }
 
+  void VulkanWorkOrchestrator::recreate_swap_chain()
+  {
+    // images of the old swap chain may still be used by frames in flight
+    vkDeviceWaitIdle(VulkanDevice::get_logical_device());
+    m_swap_chain->recreate();
+  }
+
+  void VulkanWorkOrchestrator::create_readback_buffers()
+  {
+    auto extent = m_swap_chain->m_swap_chain_extent;
+
+    // coherent memory stays mapped, so a finished frame is read without any further calls
+    m_readbacks.resize(VulkanSwapChain::get_frames_in_flight());
+    for (auto& readback : m_readbacks)
+    {
+      readback.m_buffer = std::make_unique<VulkanBuffer>(4,
+                                                         extent.width * extent.height,
+                                                         VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                             VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+      readback.m_buffer->map();
+    }
+  }
+
+  void VulkanWorkOrchestrator::deliver_readback(uint32_t frame_index)
+  {
+    auto& readback = m_readbacks[frame_index];
+    if (!readback.m_pending) { return; }
+    readback.m_pending = false;
+
+    if (!m_readback_callback) { return; }
+
+    EspFrameReadback frame = {};
+    frame.m_frame_value    = readback.m_frame_value;
+    frame.m_width          = m_swap_chain->m_swap_chain_extent.width;
+    frame.m_height         = m_swap_chain->m_swap_chain_extent.height;
+    frame.m_pixels         = static_cast<const uint8_t*>(readback.m_buffer->get_mapped_memory());
+    m_readback_callback(frame);
+  }
+
+  void VulkanWorkOrchestrator::read_back_current_image()
+  {
+    ESP_ASSERT(VulkanSwapChain::is_headless(), "Only offscreen targets can be read back!")
+
+    auto frame_index    = s_instance->m_swap_chain->m_current_frame;
+    auto extent         = s_instance->m_swap_chain->m_swap_chain_extent;
+    auto command_buffer = s_instance->m_command_buffers[frame_index];
+    auto& readback      = s_instance->m_readbacks[frame_index];
+
+    VkBufferImageCopy region = {};
+    region.imageSubresource  = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+    region.imageExtent       = { extent.width, extent.height, 1 };
+
+    vkCmdCopyImageToBuffer(command_buffer,
+                           VulkanSwapChain::get_current_image(),
+                           VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                           readback.m_buffer->get_buffer(),
+                           1,
+                           &region);
+
+    // waiting for the frame pacer doesn't make transfer writes visible to the host by itself
+    VkMemoryBarrier memory_barrier = {};
+    memory_barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memory_barrier.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+    memory_barrier.dstAccessMask   = VK_ACCESS_HOST_READ_BIT;
+
+    vkCmdPipelineBarrier(command_buffer,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_HOST_BIT,
+                         0,
+                         1,
+                         &memory_barrier,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr);
+
+    readback.m_frame_value = s_instance->m_frame_pacer->get_frame_value();
+    readback.m_pending     = true;
+  }
+
   /* ------------- CHANGE THEM !!!!!!!!!!!! -------------- */
   VkCommandBuffer VulkanWorkOrchestrator::begin_single_time_commands()
   {
@@ -223,4 +417,125 @@ namespace esp
 
     vkFreeCommandBuffers(VulkanDevice::get_logical_device(), s_instance->m_command_pool, 1, &command_buffer);
   }
+
+  VulkanCommandBufferId* VulkanWorkOrchestrator::begin_secondary_command_buffer(
+      const VkCommandBufferInheritanceRenderingInfoKHR& rendering_info)
+  {
+    auto& thread_pool  = s_instance->get_thread_command_pool();
+    auto frame_index   = s_instance->m_swap_chain->m_current_frame;
+    auto& buffers      = thread_pool.m_secondary_buffers[frame_index];
+    auto& used_buffers = thread_pool.m_used_secondary_buffers[frame_index];
+
+    if (used_buffers == buffers.size())
+    {
+      VkCommandBufferAllocateInfo alloc_info{};
+      alloc_info.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+      alloc_info.level              = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+      alloc_info.commandPool        = thread_pool.m_pools[frame_index];
+      alloc_info.commandBufferCount = 1;
+
+      VkCommandBuffer command_buffer;
+      ESP_ASSERT(vkAllocateCommandBuffers(VulkanDevice::get_logical_device(), &alloc_info, &command_buffer) ==
+                     VK_SUCCESS,
+                 "Failed to allocate secondary command buffer!")
+      buffers.push_back(std::make_unique<VulkanCommandBufferId>(command_buffer));
+    }
+
+    auto* id = buffers[used_buffers++].get();
+
+    // the buffer may be executed inside a GPU profiler scope
+    VkCommandBufferInheritanceInfo inheritance_info{};
+    inheritance_info.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritance_info.pNext              = &rendering_info;
+    inheritance_info.pipelineStatistics = VulkanGpuProfiler::get_inherited_statistics();
+
+    VkCommandBufferBeginInfo begin_info{};
+    begin_info.sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.pInheritanceInfo = &inheritance_info;
+    // the buffer is executed inside rendering begun by the primary command buffer
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    ESP_ASSERT(vkBeginCommandBuffer(id->m_command_buffer, &begin_info) == VK_SUCCESS,
+               "Failed to begin recording secondary command buffer!")
+    return id;
+  }
+
+  void VulkanWorkOrchestrator::end_secondary_command_buffer(VkCommandBuffer command_buffer)
+  {
+    ESP_ASSERT(vkEndCommandBuffer(command_buffer) == VK_SUCCESS, "Failed to record secondary command buffer!")
+  }
+
+  void VulkanWorkOrchestrator::execute_secondary_command_buffers(VkCommandBuffer primary_command_buffer,
+                                                                 const std::vector<EspCommandBufferId*>& ids)
+  {
+    if (ids.empty()) { return; }
+
+    std::vector<VkCommandBuffer> command_buffers(ids.size());
+    for (size_t i = 0; i < ids.size(); i++)
+    {
+      command_buffers[i] = static_cast<VulkanCommandBufferId*>(ids[i])->m_command_buffer;
+    }
+
+    vkCmdExecuteCommands(primary_command_buffer, static_cast<uint32_t>(command_buffers.size()), command_buffers.data());
+  }
+
+  VulkanWorkOrchestrator::ThreadCommandPool& VulkanWorkOrchestrator::get_thread_command_pool()
+  {
+    // VkCommandPool can't be used from more than one thread at a time, so every recording thread gets its own
+    // pool which is looked up without locking after the first use.
+    thread_local ThreadCommandPool* t_thread_pool = nullptr;
+    thread_local uint64_t t_generation            = 0;
+
+    if (t_thread_pool && t_generation == s_generation) { return *t_thread_pool; }
+
+    auto& context_data = VulkanContext::get_context_data();
+    auto thread_pool   = std::make_unique<ThreadCommandPool>();
+
+    VkCommandPoolCreateInfo pool_info = {};
+    pool_info.sType                   = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    pool_info.flags                   = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    pool_info.queueFamilyIndex        = context_data.m_queue_family_indices.m_graphics_family.value();
+
+    for (uint32_t frame_index = 0; frame_index < VulkanSwapChain::get_frames_in_flight(); frame_index++)
+    {
+      ESP_ASSERT(vkCreateCommandPool(VulkanDevice::get_logical_device(),
+                                     &pool_info,
+                                     nullptr,
+                                     &thread_pool->m_pools[frame_index]) == VK_SUCCESS,
+                 "Failed to create thread command pool")
+    }
+
+    std::lock_guard<std::mutex> lock(m_thread_pools_mutex);
+    m_thread_pools.push_back(std::move(thread_pool));
+
+    t_thread_pool = m_thread_pools.back().get();
+    t_generation  = s_generation;
+    return *t_thread_pool;
+  }
+
+  void VulkanWorkOrchestrator::reset_thread_command_pools(uint32_t frame_index)
+  {
+    std::lock_guard<std::mutex> lock(m_thread_pools_mutex);
+    for (auto& thread_pool : m_thread_pools)
+    {
+      if (thread_pool->m_used_secondary_buffers[frame_index] == 0) { continue; }
+
+      vkResetCommandPool(VulkanDevice::get_logical_device(), thread_pool->m_pools[frame_index], 0);
+      thread_pool->m_used_secondary_buffers[frame_index] = 0;
+    }
+  }
+
+  void VulkanWorkOrchestrator::destroy_thread_command_pools()
+  {
+    std::lock_guard<std::mutex> lock(m_thread_pools_mutex);
+    for (auto& thread_pool : m_thread_pools)
+    {
+      // command buffers are freed together with their pool, pools of unused frame indices are null
+      for (auto& pool : thread_pool->m_pools)
+      {
+        vkDestroyCommandPool(VulkanDevice::get_logical_device(), pool, nullptr);
+      }
+    }
+    m_thread_pools.clear();
+  }
 } // namespace esp
@@ -5,36 +5,89 @@
 #include "esppch.hh"
 
 // Render API
+#include "Core/RenderAPI/Work/EspDeletionQueue.hh"
 #include "Core/RenderAPI/Work/EspWorkOrchestrator.hh"
+#include "Platform/Vulkan/RenderPlans/VulkanCommandBuffer.hh"
+#include "Platform/Vulkan/Resources/VulkanBuffer.hh"
+#include "Platform/Vulkan/Resources/VulkanMipGenerator.hh"
+#include "Platform/Vulkan/Uniforms/VulkanUniformArena.hh"
+#include "VulkanAsyncCompute.hh"
+#include "VulkanFramePacer.hh"
+#include "VulkanGpuProfiler.hh"
 #include "VulkanJob.hh"
 #include "VulkanSwapChain.hh"
 
+// std
+#include <array>
+#include <mutex>
+
 namespace esp
 {
   class VulkanWorkOrchestrator : public EspWorkOrchestrator
   {
     /* -------------------------- FIELDS ----------------------------------- */
    private:
+    // Command pool of a single recording thread. There is one VkCommandPool per frame in flight, so the pool
+    // of a frame can be reset as a whole once the frame pacer lets the frame index be reused.
+    struct ThreadCommandPool
+    {
+      std::array<VkCommandPool, VulkanSwapChain::MAX_FRAMES_IN_FLIGHT> m_pools = {};
+      std::array<std::vector<std::unique_ptr<VulkanCommandBufferId>>, VulkanSwapChain::MAX_FRAMES_IN_FLIGHT>
+          m_secondary_buffers;
+      std::array<uint32_t, VulkanSwapChain::MAX_FRAMES_IN_FLIGHT> m_used_secondary_buffers = {};
+    };
+
+    // Host visible copy of the offscreen target of a frame in flight (headless mode only). It's delivered to the
+    // readback callback once the frame pacer lets the frame index be reused.
+    struct FrameReadback
+    {
+      std::unique_ptr<VulkanBuffer> m_buffer;
+      uint64_t m_frame_value = 0;
+      bool m_pending         = false;
+    };
+
     static VulkanWorkOrchestrator* s_instance;
+    static uint64_t s_generation;
 
     VkCommandPool m_command_pool;
     std::vector<VkCommandBuffer> m_command_buffers;
 
+    std::mutex m_thread_pools_mutex;
+    std::vector<std::unique_ptr<ThreadCommandPool>> m_thread_pools;
+
     std::vector<VkSemaphore> m_image_available_semaphores;
     std::vector<VkSemaphore> m_render_finished_semaphores;
-    std::vector<VkFence> m_in_flight_fences;
 
     std::unique_ptr<VulkanSwapChain> m_swap_chain;
+    std::unique_ptr<VulkanFramePacer> m_frame_pacer;
+    std::unique_ptr<VulkanAsyncCompute> m_async_compute;
+    std::unique_ptr<EspDeletionQueue> m_deletion_queue;
+    std::unique_ptr<VulkanUniformArena> m_uniform_arena;
+    std::unique_ptr<VulkanMipGenerator> m_mip_generator;
+
+    std::vector<FrameReadback> m_readbacks;
+    EspReadbackCallback m_readback_callback;
 
     PFN_vkCmdBeginRenderingKHR m_vkCmdbeginRenderingKHR;
     PFN_vkCmdEndRenderingKHR m_vkCmdEndRenderingKHR;
 
+    // the frame's command buffer is being recorded and whether a render plan is active in it
+    bool m_frame_recording = false;
+    bool m_rendering       = false;
+
     /* -------------------------- METHODS ---------------------------------- */
    private:
     void create_command_pool();
     void create_command_buffers();
     void create_sync_objects();
     void load_extension_functions();
+    void recreate_swap_chain();
+    void create_readback_buffers();
+    void deliver_readback(uint32_t frame_index);
+
+    ThreadCommandPool& get_thread_command_pool();
+    void reset_thread_command_pools(uint32_t frame_index);
+    void destroy_thread_command_pools();
 
    public:
     VulkanWorkOrchestrator();
@@ -43,7 +96,7 @@ namespace esp
     VulkanWorkOrchestrator(const VulkanWorkOrchestrator& other)            = delete;
     VulkanWorkOrchestrator& operator=(const VulkanWorkOrchestrator& other) = delete;
 
-    virtual void init(EspPresentationMode presentation_mode) override;
+    virtual void init(EspPresentationMode presentation_mode, EspFramePacingMode frame_pacing) override;
     virtual void terminate() override;
 
     virtual void begin_frame() override;
@@ -51,11 +104,32 @@ namespace esp
 
     /* -------------------------- STATIC METHODS --------------------------- */
    public:
-    static std::unique_ptr<VulkanWorkOrchestrator> create(EspPresentationMode presentation_mode);
+    static std::unique_ptr<VulkanWorkOrchestrator> create(EspPresentationMode presentation_mode,
+                                                          EspFramePacingMode frame_pacing);
 
     inline static uint32_t get_number_of_command_buffers() { return s_instance->m_command_buffers.size(); }
+    inline static VulkanUniformArena& get_uniform_arena() { return *s_instance->m_uniform_arena; }
+    inline static VulkanFramePacer& get_frame_pacer() { return *s_instance->m_frame_pacer; }
+    // value the GPU signals once the frame being recorded is finished
+    inline static uint64_t get_frame_value() { return s_instance->m_frame_pacer->get_frame_value(); }
+    inline static uint64_t get_completed_frame_value() { return s_instance->m_frame_pacer->get_completed_value(); }
+    inline static void set_readback_callback(EspReadbackCallback callback)
+    {
+      s_instance->m_readback_callback = std::move(callback);
+    }
+    // Records copy of the current offscreen target, which has to be in VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL layout.
+    static void read_back_current_image();
+    // Commands recorded outside of frames (e.g. while loading) have to use single time commands.
+    inline static bool is_frame_recording() { return s_instance && s_instance->m_frame_recording; }
+    inline static bool is_rendering() { return s_instance && s_instance->m_rendering; }
     static VkCommandBuffer begin_single_time_commands();
     static void end_single_time_commands(VkCommandBuffer command_buffer);
+
+    static VulkanCommandBufferId* begin_secondary_command_buffer(
+        const VkCommandBufferInheritanceRenderingInfoKHR& rendering_info);
+    static void end_secondary_command_buffer(VkCommandBuffer command_buffer);
+    static void execute_secondary_command_buffers(VkCommandBuffer primary_command_buffer,
+                                                  const std::vector<EspCommandBufferId*>& ids);
     inline static std::pair<uint32_t, uint32_t> get_swap_chain_extent()
     {
       return { s_instance->m_swap_chain->m_swap_chain_extent.width,
@@ -130,21 +204,25 @@ namespace esp
     {
       s_instance->m_vkCmdbeginRenderingKHR(s_instance->m_command_buffers[s_instance->m_swap_chain->m_current_frame],
                                            info);
+      s_instance->m_rendering = true;
     }
 
     inline static void end_rendering()
     {
       s_instance->m_vkCmdEndRenderingKHR(s_instance->m_command_buffers[s_instance->m_swap_chain->m_current_frame]);
+      s_instance->m_rendering = false;
     }
 
     inline static void begin_rendering(VkCommandBuffer command_buffer, const VkRenderingInfo* info)
     {
       s_instance->m_vkCmdbeginRenderingKHR(command_buffer, info);
+      s_instance->m_rendering = true;
     }
 
     inline static void end_rendering(VkCommandBuffer command_buffer)
     {
       s_instance->m_vkCmdEndRenderingKHR(command_buffer);
+      s_instance->m_rendering = false;
     }
   };
 } // namespace esp
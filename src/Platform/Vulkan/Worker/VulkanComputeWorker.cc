@@ -0,0 +1,27 @@
+#include "VulkanComputeWorker.hh"
+
+// Platform
+#include "Platform/Vulkan/Uniforms/VulkanUniformManager.hh"
+
+namespace esp
+{
+  VulkanComputeWorker::VulkanComputeWorker(std::shared_ptr<VulkanPipelineLayout> pipeline_layout,
+                                           std::shared_ptr<EspPipelineHandle> compute_pipeline,
+                                           std::unique_ptr<EspUniformDataStorage> uniform_data) :
+      m_pipeline_layout{ std::move(pipeline_layout) },
+      m_compute_pipeline{ std::move(compute_pipeline) }, m_uniform_data{ std::move(uniform_data) }
+  {
+  }
+
+  std::unique_ptr<EspUniformManager> VulkanComputeWorker::create_uniform_manager(int start_managed_ds,
+                                                                                 int end_managed_ds) const
+  {
+    ESP_ASSERT(m_uniform_data, "You cannot create EspUniformManager if you didn't define any Descriptor Set!");
+    auto pipeline_layout = m_pipeline_layout->get_pipeline_layout();
+    return std::unique_ptr<EspUniformManager>{ new VulkanUniformManager(*m_uniform_data,
+                                                                        pipeline_layout,
+                                                                        start_managed_ds,
+                                                                        end_managed_ds,
+                                                                        VK_PIPELINE_BIND_POINT_COMPUTE) };
+  }
+} // namespace esp
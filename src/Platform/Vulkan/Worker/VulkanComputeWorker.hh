@@ -0,0 +1,57 @@
+#ifndef PLATFORM_VULKAN_RENDER_API_VULKAN_COMPUTE_WORKER_HH
+#define PLATFORM_VULKAN_RENDER_API_VULKAN_COMPUTE_WORKER_HH
+
+// Render API
+#include "Core/RenderAPI/Worker/EspComputeWorker.hh"
+#include "Core/RenderAPI/Worker/EspPipelineCompiler.hh"
+
+// Platform
+#include "Platform/Vulkan/RenderPlans/VulkanCommandBuffer.hh"
+#include "Platform/Vulkan/Uniforms/EspUniformDataStorage.hh"
+#include "Platform/Vulkan/Uniforms/VulkanLayoutCache.hh"
+#include "Platform/Vulkan/Work/VulkanWorkOrchestrator.hh"
+
+namespace esp
+{
+  class VulkanComputeWorker : public EspComputeWorker
+  {
+    /* -------------------------- FIELDS ----------------------------------- */
+   private:
+    std::shared_ptr<VulkanPipelineLayout> m_pipeline_layout;
+    std::shared_ptr<EspPipelineHandle> m_compute_pipeline;
+    std::unique_ptr<EspUniformDataStorage> m_uniform_data;
+
+    /* -------------------------- METHODS ---------------------------------- */
+   private:
+    inline VkPipeline get_compute_pipeline() const { return (VkPipeline)m_compute_pipeline->get(); }
+
+   public:
+    VulkanComputeWorker(std::shared_ptr<VulkanPipelineLayout> pipeline_layout,
+                        std::shared_ptr<EspPipelineHandle> compute_pipeline,
+                        std::unique_ptr<EspUniformDataStorage> uniform_data);
+
+    VulkanComputeWorker(const VulkanComputeWorker&)            = delete;
+    VulkanComputeWorker& operator=(const VulkanComputeWorker&) = delete;
+
+    inline virtual bool is_ready() const override { return m_compute_pipeline->is_ready(); }
+
+    inline virtual void attach() const override
+    {
+      vkCmdBindPipeline(VulkanWorkOrchestrator::get_current_command_buffer(),
+                        VK_PIPELINE_BIND_POINT_COMPUTE,
+                        get_compute_pipeline());
+    }
+
+    inline virtual void attach(EspCommandBufferId* id) const override
+    {
+      vkCmdBindPipeline(static_cast<VulkanCommandBufferId*>(id)->m_command_buffer,
+                        VK_PIPELINE_BIND_POINT_COMPUTE,
+                        get_compute_pipeline());
+    }
+
+    virtual std::unique_ptr<EspUniformManager> create_uniform_manager(int start_managed_ds = -1,
+                                                                      int end_managed_ds   = -1) const override;
+  };
+} // namespace esp
+
+#endif /* PLATFORM_VULKAN_RENDER_API_VULKAN_COMPUTE_WORKER_HH */
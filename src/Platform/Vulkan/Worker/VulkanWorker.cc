@@ -10,30 +10,25 @@
 
 namespace esp
 {
-  VulkanWorker::VulkanWorker(VkPipelineLayout pipeline_layout,
-                             VkPipeline graphics_pipeline,
+  VulkanWorker::VulkanWorker(std::shared_ptr<VulkanPipelineLayout> pipeline_layout,
+                             std::shared_ptr<EspPipelineHandle> graphics_pipeline,
                              std::unique_ptr<EspUniformDataStorage> uniform_data) :
-      m_pipeline_layout{ pipeline_layout },
-      m_graphics_pipeline{ graphics_pipeline }, m_uniform_data{ std::move(uniform_data) }
+      m_pipeline_layout{ std::move(pipeline_layout) },
+      m_graphics_pipeline{ std::move(graphics_pipeline) }, m_uniform_data{ std::move(uniform_data) }
   {
   }
 
-  VulkanWorker::~VulkanWorker()
-  {
-    vkDestroyPipelineLayout(VulkanDevice::get_logical_device(), m_pipeline_layout, nullptr);
-    vkDestroyPipeline(VulkanDevice::get_logical_device(), m_graphics_pipeline, nullptr);
-  }
-
   std::unique_ptr<EspUniformManager> VulkanWorker::create_uniform_manager(int start_managed_ds,
                                                                           int end_managed_ds) const
   {
     ESP_ASSERT(m_uniform_data, "You cannot create EspUniformManager if you didn't define any Descriptor Set!");
+    auto pipeline_layout = m_pipeline_layout->get_pipeline_layout();
     return std::unique_ptr<EspUniformManager>{
-      new VulkanUniformManager(*m_uniform_data, m_pipeline_layout, start_managed_ds, end_managed_ds)
+      new VulkanUniformManager(*m_uniform_data, pipeline_layout, start_managed_ds, end_managed_ds)
     };
   }
 
-  void VulkanWorker::set_viewport() const
+  void VulkanWorker::set_viewport(VkCommandBuffer command_buffer) const
   {
     auto [widht, height] = VulkanWorkOrchestrator::get_swap_chain_extent();
 
@@ -45,7 +40,7 @@ namespace esp
     viewport.minDepth = 0.0f;
     viewport.maxDepth = 1.0f;
 
-    vkCmdSetViewport(VulkanWorkOrchestrator::get_current_command_buffer(), 0, 1, &viewport);
+    vkCmdSetViewport(command_buffer, 0, 1, &viewport);
   }
 
   void VulkanWorker::set_viewport(esp::EspViewport viewport)
@@ -82,12 +77,12 @@ namespace esp
     vkCmdSetViewport(static_cast<VulkanCommandBufferId*>(id)->m_command_buffer, 0, 1, &vk_viewport);
   }
 
-  void VulkanWorker::set_scissors() const
+  void VulkanWorker::set_scissors(VkCommandBuffer command_buffer) const
   {
     auto [widht, height] = VulkanWorkOrchestrator::get_swap_chain_extent();
 
     VkRect2D scissor{ { 0, 0 }, { widht, height } };
-    vkCmdSetScissor(VulkanWorkOrchestrator::get_current_command_buffer(), 0, 1, &scissor);
+    vkCmdSetScissor(command_buffer, 0, 1, &scissor);
   }
 
   void VulkanWorker::set_scissors(EspCommandBufferId* id, EspScissorRect scissor_rect)
@@ -2,11 +2,13 @@
 #define PLATFORM_VULKAN_RENDER_API_VULKAN_PIPELINE_HH
 
 // Render API
+#include "Core/RenderAPI/Worker/EspPipelineCompiler.hh"
 #include "Core/RenderAPI/Worker/EspWorker.hh"
 
 // Platform
 #include "Platform/Vulkan/RenderPlans/VulkanCommandBuffer.hh"
 #include "Platform/Vulkan/Uniforms/EspUniformDataStorage.hh"
+#include "Platform/Vulkan/Uniforms/VulkanLayoutCache.hh"
 #include "Platform/Vulkan/Uniforms/VulkanUniformManager.hh"
 #include "Platform/Vulkan/Uniforms/VulkanUniformMetaData.hh"
 #include "Platform/Vulkan/Work/VulkanWorkOrchestrator.hh"
@@ -17,38 +19,52 @@ namespace esp
   {
     /* -------------------------- FIELDS ----------------------------------- */
    private:
-    VkPipelineLayout m_pipeline_layout;
-    VkPipeline m_graphics_pipeline;
+    std::shared_ptr<VulkanPipelineLayout> m_pipeline_layout;
+    std::shared_ptr<EspPipelineHandle> m_graphics_pipeline;
     std::unique_ptr<EspUniformDataStorage> m_uniform_data;
 
     /* -------------------------- METHODS ---------------------------------- */
    private:
-    void set_viewport() const;
-    void set_scissors() const;
+    void set_viewport(VkCommandBuffer command_buffer) const;
+    void set_scissors(VkCommandBuffer command_buffer) const;
+
+    inline VkPipeline get_graphics_pipeline() const { return (VkPipeline)m_graphics_pipeline->get(); }
 
    public:
-    VulkanWorker(VkPipelineLayout pipeline_layout,
-                 VkPipeline graphics_pipeline,
+    VulkanWorker(std::shared_ptr<VulkanPipelineLayout> pipeline_layout,
+                 std::shared_ptr<EspPipelineHandle> graphics_pipeline,
                  std::unique_ptr<EspUniformDataStorage> uniform_data);
-    ~VulkanWorker();
 
     VulkanWorker(const VulkanWorker&)            = delete;
     VulkanWorker& operator=(const VulkanWorker&) = delete;
 
+    inline virtual bool is_ready() const override { return m_graphics_pipeline->is_ready(); }
+
+    inline virtual size_t get_layout_hash() const override { return m_pipeline_layout->get_hash(); }
+    inline virtual const void* get_layout_id() const override { return m_pipeline_layout.get(); }
+
     inline virtual void attach() const override
     {
       vkCmdBindPipeline(VulkanWorkOrchestrator::get_current_command_buffer(),
                         VK_PIPELINE_BIND_POINT_GRAPHICS,
-                        m_graphics_pipeline);
-      set_viewport();
-      set_scissors();
+                        get_graphics_pipeline());
+      set_viewport(VulkanWorkOrchestrator::get_current_command_buffer());
+      set_scissors(VulkanWorkOrchestrator::get_current_command_buffer());
+    }
+
+    inline virtual void attach(EspCommandBufferId* id) const override
+    {
+      auto command_buffer = static_cast<VulkanCommandBufferId*>(id)->m_command_buffer;
+      vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, get_graphics_pipeline());
+      set_viewport(command_buffer);
+      set_scissors(command_buffer);
     }
 
     inline virtual void only_attach() const override
     {
       vkCmdBindPipeline(VulkanWorkOrchestrator::get_current_command_buffer(),
                         VK_PIPELINE_BIND_POINT_GRAPHICS,
-                        m_graphics_pipeline);
+                        get_graphics_pipeline());
     }
 
     virtual void set_viewport(EspViewport viewport) override;
@@ -58,7 +74,7 @@ namespace esp
     {
       vkCmdBindPipeline(static_cast<VulkanCommandBufferId*>(id)->m_command_buffer,
                         VK_PIPELINE_BIND_POINT_GRAPHICS,
-                        m_graphics_pipeline);
+                        get_graphics_pipeline());
     }
 
     virtual void set_viewport(EspCommandBufferId* id, EspViewport viewport) override;
@@ -1,42 +1,45 @@
 #include "VulkanWorkerBuilder.hh"
 
 // std
+#include <chrono>
 #include <fstream>
 
+// Render API
+#include "Core/RenderAPI/Work/EspDeletionQueue.hh"
+#include "Core/RenderAPI/Worker/EspPipelineCompiler.hh"
+
 // Platform
 #include "Platform/Vulkan/Resources/VulkanShaderStage.hh"
 #include "Platform/Vulkan/Uniforms/VulkanUniformMetaData.hh"
 #include "Platform/Vulkan/VulkanDevice.hh"
 #include "Platform/Vulkan/Work/VulkanSwapChain.hh"
+#include "VulkanComputeWorker.hh"
 #include "VulkanWorker.hh"
 
-// signatures
-static VkShaderModule create_shader_module(const esp::SpirvData& code, VkDevice device);
-
 /* --------------------------------------------------------- */
 /* ---------------- CLASS IMPLEMENTATION ------------------- */
 /* --------------------------------------------------------- */
 
 namespace esp
 {
+  VulkanPipelineState::~VulkanPipelineState()
+  {
+    for (auto& it : m_pipeline_stage_data_map)
+    {
+      free(it.second.specialization_data);
+    }
+  }
+
   VulkanWorkerBuilder::VulkanWorkerBuilder() : m_pipeline_stage_data_map{}
   {
     m_color_attachment_formats.push_back(*(VulkanSwapChain::get_swap_chain_image_format()));
-
-    m_vertex_input_info       = {};
-    m_vertex_input_info.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
   }
 
   VulkanWorkerBuilder::~VulkanWorkerBuilder()
   {
     for (auto& it : m_pipeline_stage_data_map)
     {
-      vkDestroyShaderModule(VulkanDevice::get_logical_device(), it.second.shader_module, nullptr);
-    }
-
-    if (m_is_pipeline_layout)
-    {
-      vkDestroyPipelineLayout(VulkanDevice::get_logical_device(), m_pipeline_layout, nullptr);
+      free(it.second.specialization_data);
     }
   }
 
@@ -61,20 +64,21 @@ namespace esp
     }
   }
 
-  void VulkanWorkerBuilder::set_shaders(std::unique_ptr<SpirvResource> spirv_resource)
+  void VulkanWorkerBuilder::set_shaders(std::shared_ptr<SpirvResource> spirv_resource)
   {
     spirv_resource->enumerate_data(
-        [this](EspShaderStage stage, const SpirvData& spirv_data)
+        [this, &spirv_resource](EspShaderStage stage, const SpirvData& spirv_data)
         {
-          m_pipeline_stage_data_map[stage].shader_module =
-              create_shader_module(spirv_data, VulkanDevice::get_logical_device());
+          // modules share the code of the resource instead of copying it
+          auto code = std::shared_ptr<const SpirvData>(spirv_resource, &spirv_data);
+          m_pipeline_stage_data_map[stage].shader_module = VulkanDevice::get_shader_module_cache().acquire(code);
 
           m_pipeline_stage_data_map[stage].shader_stage_create_info = {};
           m_pipeline_stage_data_map[stage].shader_stage_create_info.sType =
               VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
           m_pipeline_stage_data_map[stage].shader_stage_create_info.stage = esp_shader_stage_to_vk(stage);
           m_pipeline_stage_data_map[stage].shader_stage_create_info.module =
-              m_pipeline_stage_data_map.at(stage).shader_module;
+              m_pipeline_stage_data_map.at(stage).shader_module->get_shader_module();
           m_pipeline_stage_data_map[stage].shader_stage_create_info.pName = "main";
         });
   }
@@ -161,49 +165,25 @@ namespace esp
         m_attribute_descriptions.push_back(attribute_description);
       }
     }
-
-    m_vertex_input_info.vertexBindingDescriptionCount   = static_cast<uint32_t>(m_binding_descriptions.size());
-    m_vertex_input_info.vertexAttributeDescriptionCount = static_cast<uint32_t>(m_attribute_descriptions.size());
-    m_vertex_input_info.pVertexBindingDescriptions      = m_binding_descriptions.data();
-    m_vertex_input_info.pVertexAttributeDescriptions    = m_attribute_descriptions.data();
   }
 
   void VulkanWorkerBuilder::set_worker_layout(std::unique_ptr<EspUniformMetaData> uniforms_meta_data)
   {
     std::unique_ptr<VulkanUniformMetaData> meta_data(static_cast<VulkanUniformMetaData*>(uniforms_meta_data.release()));
 
-    VkPipelineLayoutCreateInfo pipeline_layout_info{};
-    pipeline_layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-
+    // shaders with the same uniforms share the pipeline layout, so their descriptor sets are compatible
+    auto& layout_cache = VulkanDevice::get_layout_cache();
     if (*meta_data)
     {
       m_uniform_data_storage = std::make_unique<EspUniformDataStorage>(std::move(meta_data));
-      auto set_layout_count  = m_uniform_data_storage->get_layouts_count();
-      auto pushes_count      = m_uniform_data_storage->get_pushes_count();
-
-      if (set_layout_count > 0)
-      {
-        pipeline_layout_info.setLayoutCount = set_layout_count;
-        pipeline_layout_info.pSetLayouts    = m_uniform_data_storage->get_layouts_data();
-      }
-      if (pushes_count > 0)
-      {
-        pipeline_layout_info.pushConstantRangeCount = pushes_count;
-        pipeline_layout_info.pPushConstantRanges    = m_uniform_data_storage->get_push_data();
-      }
+      m_pipeline_layout      = layout_cache.acquire_pipeline_layout(m_uniform_data_storage->m_set_layouts,
+                                                                    m_uniform_data_storage->m_push_constant_ranges);
     }
-    else { m_uniform_data_storage = nullptr; }
-
-    if (vkCreatePipelineLayout(VulkanDevice::get_logical_device(),
-                               &pipeline_layout_info,
-                               nullptr,
-                               &m_pipeline_layout) != VK_SUCCESS)
+    else
     {
-      ESP_CORE_ERROR("Failed to create graphics pipeline");
-      throw std::runtime_error("Failed to create graphics pipeline");
+      m_uniform_data_storage = nullptr;
+      m_pipeline_layout      = layout_cache.acquire_pipeline_layout({}, {});
     }
-
-    m_is_pipeline_layout = true;
   }
 
   std::unique_ptr<EspWorker> VulkanWorkerBuilder::build_worker()
@@ -240,14 +220,145 @@ namespace esp
                "You cannot create pipeline a without a fragment shader.");
     ESP_ASSERT(m_pipeline_stage_data_map.contains(EspShaderStage::VERTEX),
                "You cannot create pipeline a without a vertex shader.");
-    ESP_ASSERT(m_is_pipeline_layout, "You cannot create a pipeline without a pipeline layout.")
+    ESP_ASSERT(m_pipeline_layout, "You cannot create a pipeline without a pipeline layout.")
     ESP_ASSERT(m_color_attachment_formats.size() != 0, "You cannot create a pipeline  without color attachments.");
 
+    // the state is copied, so the builder doesn't have to outlive the compilation
+    auto state = std::make_shared<VulkanPipelineState>();
+
+    state->m_binding_descriptions     = m_binding_descriptions;
+    state->m_attribute_descriptions   = m_attribute_descriptions;
+    state->m_color_attachment_formats = m_color_attachment_formats;
+    state->m_depth_test_enable        = m_depth_test.m_enable;
+    state->m_depth_compare_op         = m_depth_test.m_compare_op;
+    state->m_depth_format             = m_depth_test.m_format;
+    state->m_sample_count_flag        = m_multisampling.m_sample_count_flag;
+    state->m_pipeline_layout          = m_pipeline_layout;
+
+    auto hash = get_pipeline_state_hash();
+    state->m_pipeline_stage_data_map.swap(m_pipeline_stage_data_map);
+
+    // pipelines with the same state are shared, shader modules of this one are destroyed with the state then
+    auto pipeline = EspPipelineCompiler::compile(
+        hash,
+        [state]() { return (uint64_t)create_pipeline(*state); },
+        [](uint64_t pipeline)
+        {
+          EspDeletionQueue::defer(
+              [pipeline]() { vkDestroyPipeline(VulkanDevice::get_logical_device(), (VkPipeline)pipeline, nullptr); });
+        });
+
+    return std::unique_ptr<EspWorker>{
+      new VulkanWorker(std::move(m_pipeline_layout), std::move(pipeline), std::move(m_uniform_data_storage))
+    };
+  }
+
+  std::unique_ptr<EspComputeWorker> VulkanWorkerBuilder::build_compute_worker()
+  {
+    ESP_ASSERT(m_pipeline_stage_data_map.contains(EspShaderStage::COMPUTE),
+               "You cannot create compute pipeline without a compute shader.");
+    ESP_ASSERT(m_pipeline_layout, "You cannot create a pipeline without a pipeline layout.")
+
+    auto state               = std::make_shared<VulkanPipelineState>();
+    state->m_pipeline_layout = m_pipeline_layout;
+
+    auto hash = get_compute_pipeline_state_hash();
+    state->m_pipeline_stage_data_map.swap(m_pipeline_stage_data_map);
+
+    auto pipeline = EspPipelineCompiler::compile(
+        hash,
+        [state]() { return (uint64_t)create_compute_pipeline(*state); },
+        [](uint64_t pipeline)
+        {
+          EspDeletionQueue::defer(
+              [pipeline]() { vkDestroyPipeline(VulkanDevice::get_logical_device(), (VkPipeline)pipeline, nullptr); });
+        });
+
+    return std::unique_ptr<EspComputeWorker>{
+      new VulkanComputeWorker(std::move(m_pipeline_layout), std::move(pipeline), std::move(m_uniform_data_storage))
+    };
+  }
+
+  void VulkanWorkerBuilder::hash_stage(size_t& seed, EspShaderStage stage) const
+  {
+    const auto& stage_data = m_pipeline_stage_data_map.at(stage);
+    // modules are deduplicated by their code, so their ids identify the code without collisions of its hash
+    hash_combine(seed, stage_data.shader_module->get_id());
+
+    for (const auto& entry : stage_data.specialization_map_entries)
+    {
+      hash_combine(seed, entry.constantID);
+      hash_combine(seed, entry.offset);
+      hash_combine(seed, entry.size);
+    }
+    auto data = static_cast<const char*>(stage_data.specialization_data);
+    hash_combine(seed, std::string_view(data, data ? stage_data.specialization_info.dataSize : 0));
+  }
+
+  size_t VulkanWorkerBuilder::get_pipeline_state_hash() const
+  {
+    size_t seed = 0;
+    for (auto stage : { EspShaderStage::VERTEX, EspShaderStage::FRAGMENT })
+    {
+      hash_stage(seed, stage);
+    }
+
+    for (const auto& binding : m_binding_descriptions)
+    {
+      hash_combine(seed, binding.binding);
+      hash_combine(seed, binding.stride);
+      hash_combine(seed, binding.inputRate);
+    }
+    for (const auto& attribute : m_attribute_descriptions)
+    {
+      hash_combine(seed, attribute.binding);
+      hash_combine(seed, attribute.location);
+      hash_combine(seed, attribute.format);
+      hash_combine(seed, attribute.offset);
+    }
+
+    for (auto format : m_color_attachment_formats)
+    {
+      hash_combine(seed, format);
+    }
+
+    hash_combine(seed, m_depth_test.m_enable);
+    if (m_depth_test.m_enable)
+    {
+      hash_combine(seed, m_depth_test.m_compare_op);
+      hash_combine(seed, m_depth_test.m_format);
+    }
+    hash_combine(seed, m_multisampling.m_sample_count_flag);
+    hash_combine(seed, m_pipeline_layout->get_hash());
+
+    return seed;
+  }
+
+  size_t VulkanWorkerBuilder::get_compute_pipeline_state_hash() const
+  {
+    size_t seed = 0;
+    hash_stage(seed, EspShaderStage::COMPUTE);
+    hash_combine(seed, m_pipeline_layout->get_hash());
+
+    return seed;
+  }
+
+  VkPipeline VulkanWorkerBuilder::create_pipeline(const VulkanPipelineState& state)
+  {
     VkPipelineShaderStageCreateInfo shader_stages[] = {
-      m_pipeline_stage_data_map.at(EspShaderStage::VERTEX).shader_stage_create_info,
-      m_pipeline_stage_data_map.at(EspShaderStage::FRAGMENT).shader_stage_create_info
+      state.m_pipeline_stage_data_map.at(EspShaderStage::VERTEX).shader_stage_create_info,
+      state.m_pipeline_stage_data_map.at(EspShaderStage::FRAGMENT).shader_stage_create_info
     };
 
+    VkPipelineVertexInputStateCreateInfo vertex_input_info{};
+    {
+      vertex_input_info.sType                           = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+      vertex_input_info.vertexBindingDescriptionCount   = static_cast<uint32_t>(state.m_binding_descriptions.size());
+      vertex_input_info.vertexAttributeDescriptionCount = static_cast<uint32_t>(state.m_attribute_descriptions.size());
+      vertex_input_info.pVertexBindingDescriptions      = state.m_binding_descriptions.data();
+      vertex_input_info.pVertexAttributeDescriptions    = state.m_attribute_descriptions.data();
+    }
+
     VkPipelineInputAssemblyStateCreateInfo input_assembly{};
     {
       input_assembly.sType                  = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
@@ -278,7 +389,7 @@ namespace esp
     {
       multisampling.sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
       multisampling.sampleShadingEnable  = VK_FALSE;
-      multisampling.rasterizationSamples = static_cast<VkSampleCountFlagBits>(m_multisampling.m_sample_count_flag);
+      multisampling.rasterizationSamples = static_cast<VkSampleCountFlagBits>(state.m_sample_count_flag);
       //
       // TODO: let user decide whether he wants higher quality or better performance - put this in some if statement
       // multisampling.sampleShadingEnable  = VK_TRUE; // enable sample shading in the pipeline
@@ -288,19 +399,19 @@ namespace esp
 
     VkPipelineDepthStencilStateCreateInfo depth_stencil{};
     VkPipelineDepthStencilStateCreateInfo* p_depth_stencil = nullptr;
-    if (m_depth_test.m_enable)
+    if (state.m_depth_test_enable)
     {
       depth_stencil.sType                 = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
       depth_stencil.depthTestEnable       = VK_TRUE;
       depth_stencil.depthWriteEnable      = VK_TRUE;
-      depth_stencil.depthCompareOp        = static_cast<VkCompareOp>(m_depth_test.m_compare_op);
+      depth_stencil.depthCompareOp        = static_cast<VkCompareOp>(state.m_depth_compare_op);
       depth_stencil.depthBoundsTestEnable = VK_FALSE;
       depth_stencil.stencilTestEnable     = VK_FALSE;
 
       p_depth_stencil = &depth_stencil;
     }
 
-    uint32_t attachment_count    = m_color_attachment_formats.size();
+    uint32_t attachment_count    = state.m_color_attachment_formats.size();
     auto color_blend_attachments = std::vector<VkPipelineColorBlendAttachmentState>(attachment_count);
     VkPipelineColorBlendStateCreateInfo color_blending{};
     {
@@ -314,7 +425,7 @@ namespace esp
       color_blending.sType             = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
       color_blending.logicOpEnable     = VK_FALSE;
       color_blending.logicOp           = VK_LOGIC_OP_COPY;
-      color_blending.attachmentCount   = m_color_attachment_formats.size();
+      color_blending.attachmentCount   = state.m_color_attachment_formats.size();
       color_blending.pAttachments      = color_blend_attachments.data();
       color_blending.blendConstants[0] = 0.0f;
       color_blending.blendConstants[1] = 0.0f;
@@ -332,12 +443,13 @@ namespace esp
 
     VkPipelineRenderingCreateInfoKHR pipeline_rendering_create_info{};
     {
+      const auto& formats                                    = state.m_color_attachment_formats;
       pipeline_rendering_create_info.sType                   = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
-      pipeline_rendering_create_info.colorAttachmentCount    = static_cast<uint32_t>(m_color_attachment_formats.size());
-      pipeline_rendering_create_info.pColorAttachmentFormats = m_color_attachment_formats.data();
-      if (m_depth_test.m_enable)
+      pipeline_rendering_create_info.colorAttachmentCount    = static_cast<uint32_t>(formats.size());
+      pipeline_rendering_create_info.pColorAttachmentFormats = formats.data();
+      if (state.m_depth_test_enable)
       {
-        pipeline_rendering_create_info.depthAttachmentFormat = static_cast<VkFormat>(m_depth_test.m_format);
+        pipeline_rendering_create_info.depthAttachmentFormat = static_cast<VkFormat>(state.m_depth_format);
       }
     }
 
@@ -348,7 +460,7 @@ namespace esp
     pipeline_info.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
     pipeline_info.stageCount          = 2;
     pipeline_info.pStages             = shader_stages;
-    pipeline_info.pVertexInputState   = &m_vertex_input_info;
+    pipeline_info.pVertexInputState   = &vertex_input_info;
     pipeline_info.pInputAssemblyState = &input_assembly;
     pipeline_info.pViewportState      = &viewport_state;
     pipeline_info.pRasterizationState = &rasterizer;
@@ -356,7 +468,7 @@ namespace esp
     pipeline_info.pDepthStencilState  = p_depth_stencil;
     pipeline_info.pColorBlendState    = &color_blending;
     pipeline_info.pDynamicState       = &dynamic_state;
-    pipeline_info.layout              = m_pipeline_layout;
+    pipeline_info.layout              = state.m_pipeline_layout->get_pipeline_layout();
     // !!! IT IS NOT NEEDED ANYMORE !!!! DUE TO DYNAMIC RENDERING ....
     // pipeline_info.renderPass          = VulkanFrameManager::get_swap_chain_render_pass();
     pipeline_info.subpass            = 0;
@@ -365,9 +477,11 @@ namespace esp
     pipeline_info.pNext              = &pipeline_rendering_create_info;
 
     VkPipeline graphics_pipeline;
+    auto& pipeline_cache = VulkanDevice::get_pipeline_cache();
+    auto start           = std::chrono::steady_clock::now();
 
     if (vkCreateGraphicsPipelines(VulkanDevice::get_logical_device(),
-                                  VK_NULL_HANDLE,
+                                  pipeline_cache.get_pipeline_cache(),
                                   1,
                                   &pipeline_info,
                                   nullptr,
@@ -375,41 +489,51 @@ namespace esp
     {
       throw std::runtime_error("failed to create graphics pipeline!\n");
     }
-    else { ESP_CORE_INFO("Graphic pipeline created correctly"); }
-
-    for (auto& it : m_pipeline_stage_data_map)
+    else
     {
-      vkDestroyShaderModule(VulkanDevice::get_logical_device(), it.second.shader_module, nullptr);
+      double creation_time_ms =
+          std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+      pipeline_cache.record_pipeline_creation(creation_time_ms);
+
+      ESP_CORE_INFO("Graphic pipeline created correctly in {:.2f} ms", creation_time_ms);
     }
 
-    std::unordered_map<EspShaderStage, PipelineStageData> empty_pipeline_stage_data_map;
-    m_pipeline_stage_data_map.swap(empty_pipeline_stage_data_map);
+    return graphics_pipeline;
+  }
 
-    m_is_pipeline_layout = false;
+  VkPipeline VulkanWorkerBuilder::create_compute_pipeline(const VulkanPipelineState& state)
+  {
+    const auto& stage_data = state.m_pipeline_stage_data_map.at(EspShaderStage::COMPUTE);
 
-    return std::unique_ptr<EspWorker>{
-      new VulkanWorker(m_pipeline_layout, graphics_pipeline, std::move(m_uniform_data_storage))
-    };
-  }
-} // namespace esp
+    VkComputePipelineCreateInfo pipeline_info{};
+    pipeline_info.sType              = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipeline_info.stage              = stage_data.shader_stage_create_info;
+    pipeline_info.layout             = state.m_pipeline_layout->get_pipeline_layout();
+    pipeline_info.basePipelineIndex  = -1;
+    pipeline_info.basePipelineHandle = VK_NULL_HANDLE;
 
-/* --------------------------------------------------------- */
-/* ------------------ HELPFUL FUNCTIONS -------------------- */
-/* --------------------------------------------------------- */
+    VkPipeline compute_pipeline;
+    auto& pipeline_cache = VulkanDevice::get_pipeline_cache();
+    auto start           = std::chrono::steady_clock::now();
 
-static VkShaderModule create_shader_module(const esp::SpirvData& code, VkDevice device)
-{
-  VkShaderModuleCreateInfo create_info{};
-  create_info.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-  create_info.codeSize = code.size() * sizeof(uint32_t);
-  create_info.pCode    = code.data();
+    if (vkCreateComputePipelines(VulkanDevice::get_logical_device(),
+                                 pipeline_cache.get_pipeline_cache(),
+                                 1,
+                                 &pipeline_info,
+                                 nullptr,
+                                 &compute_pipeline) != VK_SUCCESS)
+    {
+      throw std::runtime_error("failed to create compute pipeline!\n");
+    }
+    else
+    {
+      double creation_time_ms =
+          std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+      pipeline_cache.record_pipeline_creation(creation_time_ms);
 
-  VkShaderModule shader_module;
-  if (vkCreateShaderModule(device, &create_info, nullptr, &shader_module) != VK_SUCCESS)
-  {
-    ESP_CORE_ERROR("Failed to create shader module");
-    throw std::runtime_error("Failed to create shader module");
-  }
+      ESP_CORE_INFO("Compute pipeline created correctly in {:.2f} ms", creation_time_ms);
+    }
 
-  return shader_module;
-}
+    return compute_pipeline;
+  }
+} // namespace esp
@@ -8,32 +8,50 @@
 #include "Core/RenderAPI/Worker/EspWorkerBuilder.hh"
 
 // Platform
+#include "Platform/Vulkan/Resources/VulkanShaderModuleCache.hh"
 #include "Platform/Vulkan/Uniforms/EspUniformDataStorage.hh"
 
 namespace esp
 {
   struct PipelineStageData
   {
-    VkShaderModule shader_module                                     = {};
+    std::shared_ptr<VulkanShaderModule> shader_module                = {};
     VkPipelineShaderStageCreateInfo shader_stage_create_info         = {};
     std::vector<VkSpecializationMapEntry> specialization_map_entries = {};
     void* specialization_data                                        = nullptr;
     VkSpecializationInfo specialization_info                         = {};
   };
 
+  /// @brief Copy of the builder's state that the pipeline is created from. It is owned by the compilation job, so the
+  /// builder can be reused or destroyed before the pipeline is ready.
+  struct VulkanPipelineState
+  {
+    std::unordered_map<EspShaderStage, PipelineStageData> m_pipeline_stage_data_map;
+    std::vector<VkVertexInputBindingDescription> m_binding_descriptions;
+    std::vector<VkVertexInputAttributeDescription> m_attribute_descriptions;
+    std::vector<VkFormat> m_color_attachment_formats;
+
+    bool m_depth_test_enable = false;
+    EspCompareOp m_depth_compare_op;
+    EspDepthBlockFormat m_depth_format;
+    EspSampleCountFlag m_sample_count_flag;
+
+    std::shared_ptr<VulkanPipelineLayout> m_pipeline_layout;
+
+    /// @brief Destroys specialization data.
+    ~VulkanPipelineState();
+  };
+
   class VulkanWorkerBuilder : public EspWorkerBuilder
   {
     /* -------------------------- FIELDS ----------------------------------- */
    private:
     std::unordered_map<EspShaderStage, PipelineStageData> m_pipeline_stage_data_map;
 
-    VkPipelineVertexInputStateCreateInfo m_vertex_input_info;
-    /* These must exist until the pipeline is built. */
     std::vector<VkVertexInputBindingDescription> m_binding_descriptions{};
     std::vector<VkVertexInputAttributeDescription> m_attribute_descriptions{};
 
-    bool m_is_pipeline_layout = false;
-    VkPipelineLayout m_pipeline_layout; /* it will be moved to the graphic pipieline. */
+    std::shared_ptr<VulkanPipelineLayout> m_pipeline_layout; /* it will be moved to the graphic pipieline. */
     std::unique_ptr<EspUniformDataStorage> m_uniform_data_storage;
 
     std::vector<VkFormat> m_color_attachment_formats;
@@ -63,7 +81,7 @@ namespace esp
 
     virtual void set_attachment_formats(std::vector<EspBlockFormat> formats) override;
 
-    virtual void set_shaders(std::unique_ptr<SpirvResource> spirv_resource) override;
+    virtual void set_shaders(std::shared_ptr<SpirvResource> spirv_resource) override;
 
     virtual void set_specialization(const SpecializationConstantMap& spec_const_map) override;
 
@@ -71,6 +89,14 @@ namespace esp
     virtual void set_worker_layout(std::unique_ptr<EspUniformMetaData> uniforms_meta_data) override;
 
     virtual std::unique_ptr<EspWorker> build_worker() override;
+    virtual std::unique_ptr<EspComputeWorker> build_compute_worker() override;
+
+   private:
+    void hash_stage(size_t& seed, EspShaderStage stage) const;
+    size_t get_pipeline_state_hash() const;
+    size_t get_compute_pipeline_state_hash() const;
+    static VkPipeline create_pipeline(const VulkanPipelineState& state);
+    static VkPipeline create_compute_pipeline(const VulkanPipelineState& state);
   };
 } // namespace esp
 
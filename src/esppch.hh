@@ -44,6 +44,7 @@
 
 // espert
 #include "Core/Utils/Logger.hh"
+#include "Core/Utils/Profiler.hh"
 #include "Core/Utils/Utils.hh"
 
 // namespaces
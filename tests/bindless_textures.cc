@@ -0,0 +1,141 @@
+#include <bit>
+#include <catch2/catch_test_macros.hpp>
+#include <map>
+
+#include "Core/RenderAPI/Resources/EspBindlessTextures.hh"
+
+using namespace esp;
+
+namespace
+{
+  class MockTexture : public EspTexture
+  {
+   public:
+    MockTexture() : EspTexture(1, 1) {}
+  };
+
+  class MockBindlessTextures : public EspBindlessTextures
+  {
+   public:
+    std::map<uint32_t, EspTexture*> m_texture_writes;
+    std::map<uint32_t, EspBindlessMaterial> m_material_writes;
+    bool m_destroyed = false;
+
+    MockBindlessTextures(uint32_t max_textures, uint32_t max_materials, uint32_t frames_in_flight) :
+        EspBindlessTextures(max_textures, max_materials, frames_in_flight)
+    {
+    }
+    ~MockBindlessTextures() { terminate(); }
+
+   protected:
+    void write_texture(uint32_t index, EspTexture& texture) override { m_texture_writes[index] = &texture; }
+    void write_material(uint32_t index, const EspBindlessMaterial& material) override
+    {
+      m_material_writes[index] = material;
+    }
+    void destroy() override { m_destroyed = true; }
+  };
+
+  uint32_t slot(EspTextureType type) { return std::countr_zero(static_cast<uint32_t>(type)); }
+} // namespace
+
+TEST_CASE("Bindless textures - disabled", "[bindless_textures]")
+{
+  auto texture = std::make_shared<MockTexture>();
+
+  REQUIRE(!EspBindlessTextures::is_enabled());
+  REQUIRE(EspBindlessTextures::add_material({ { EspTextureType::ALBEDO, texture } }) ==
+          EspBindlessTextures::INVALID_INDEX);
+  EspBindlessTextures::release_material(0);
+  EspBindlessTextures::begin_frame();
+}
+
+TEST_CASE("Bindless textures - materials share textures", "[bindless_textures]")
+{
+  MockBindlessTextures bindless(16, 16, 2);
+  REQUIRE(EspBindlessTextures::is_enabled());
+
+  auto albedo   = std::make_shared<MockTexture>();
+  auto normal_a = std::make_shared<MockTexture>();
+  auto normal_b = std::make_shared<MockTexture>();
+
+  auto a = EspBindlessTextures::add_material({ { EspTextureType::ALBEDO, albedo },
+                                               { EspTextureType::NORMAL, normal_a } });
+  auto b = EspBindlessTextures::add_material({ { EspTextureType::ALBEDO, albedo },
+                                               { EspTextureType::NORMAL, normal_b } });
+  REQUIRE(a != b);
+
+  auto& material_a = bindless.m_material_writes[a];
+  auto& material_b = bindless.m_material_writes[b];
+  REQUIRE(material_a.m_textures[slot(EspTextureType::ALBEDO)] == material_b.m_textures[slot(EspTextureType::ALBEDO)]);
+  REQUIRE(material_a.m_textures[slot(EspTextureType::NORMAL)] != material_b.m_textures[slot(EspTextureType::NORMAL)]);
+  REQUIRE(material_a.m_textures[slot(EspTextureType::AO)] == EspBindlessTextures::INVALID_INDEX);
+
+  // shared texture is written once
+  REQUIRE(bindless.m_texture_writes.size() == 3);
+  REQUIRE(bindless.m_texture_writes[material_a.m_textures[slot(EspTextureType::ALBEDO)]] == albedo.get());
+
+  auto stats = EspBindlessTextures::get_stats();
+  REQUIRE(stats.m_textures == 3);
+  REQUIRE(stats.m_materials == 2);
+  REQUIRE(stats.m_texture_requests == 4);
+
+  EspBindlessTextures::release_material(a);
+  stats = EspBindlessTextures::get_stats();
+  REQUIRE(stats.m_textures == 2);
+  REQUIRE(stats.m_materials == 1);
+
+  bindless.terminate();
+  REQUIRE(bindless.m_destroyed);
+  REQUIRE(!EspBindlessTextures::is_enabled());
+}
+
+TEST_CASE("Bindless textures - slots are reused after frames in flight", "[bindless_textures]")
+{
+  MockBindlessTextures bindless(16, 16, 2);
+
+  auto texture      = std::make_shared<MockTexture>();
+  auto material     = EspBindlessTextures::add_material({ { EspTextureType::ALBEDO, texture } });
+  auto texture_slot = bindless.m_material_writes[material].m_textures[slot(EspTextureType::ALBEDO)];
+
+  // GPU may still read the slots in this and the previous frame, so the texture is kept alive
+  EspBindlessTextures::release_material(material);
+  REQUIRE(texture.use_count() == 2);
+
+  auto other = std::make_shared<MockTexture>();
+  REQUIRE(EspBindlessTextures::add_material({ { EspTextureType::ALBEDO, other } }) != material);
+  EspBindlessTextures::begin_frame();
+  REQUIRE(EspBindlessTextures::add_material({ { EspTextureType::ALBEDO, other } }) != material);
+
+  EspBindlessTextures::begin_frame();
+  REQUIRE(texture.use_count() == 1);
+
+  auto reused = EspBindlessTextures::add_material({ { EspTextureType::ALBEDO, std::make_shared<MockTexture>() } });
+  REQUIRE(reused == material);
+  REQUIRE(bindless.m_material_writes[reused].m_textures[slot(EspTextureType::ALBEDO)] == texture_slot);
+}
+
+TEST_CASE("Bindless textures - full arrays", "[bindless_textures]")
+{
+  MockBindlessTextures bindless(2, 4, 2);
+
+  auto a = std::make_shared<MockTexture>();
+  auto b = std::make_shared<MockTexture>();
+  auto c = std::make_shared<MockTexture>();
+
+  REQUIRE(EspBindlessTextures::add_material({ { EspTextureType::ALBEDO, a }, { EspTextureType::NORMAL, b } }) !=
+          EspBindlessTextures::INVALID_INDEX);
+
+  // material is added, but texture that doesn't fit isn't
+  auto material = EspBindlessTextures::add_material({ { EspTextureType::ALBEDO, c } });
+  REQUIRE(material != EspBindlessTextures::INVALID_INDEX);
+  REQUIRE(bindless.m_material_writes[material].m_textures[slot(EspTextureType::ALBEDO)] ==
+          EspBindlessTextures::INVALID_INDEX);
+  EspBindlessTextures::release_material(material);
+
+  for (uint32_t i = 0; i < 2; i++)
+  {
+    REQUIRE(EspBindlessTextures::add_material({}) != EspBindlessTextures::INVALID_INDEX);
+  }
+  REQUIRE(EspBindlessTextures::add_material({}) == EspBindlessTextures::INVALID_INDEX);
+}
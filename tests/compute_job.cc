@@ -0,0 +1,152 @@
+#include "tests/test_app.hh"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+
+#include "Core/RenderAPI/Work/EspBarrier.hh"
+#include "Core/RenderAPI/Work/EspDispatch.hh"
+#include "Core/RenderAPI/Work/EspJob.hh"
+#include "Core/RenderAPI/Worker/EspWorkerBuilder.hh"
+#include "Core/Resources/ResourceTypes.hh"
+#include "Core/Resources/SpirvReflection.hh"
+#include "Platform/Vulkan/Resources/VulkanStorageBuffer.hh"
+
+// SPIR-V of tests/shaders/compute_round_trip.comp, generated by the build
+#include "compute_round_trip.comp.h"
+
+using namespace esp;
+
+TEST_CASE("Compute job - group counts cover all invocations", "[compute_job]")
+{
+  REQUIRE(esp_group_count(0, 64) == 0);
+  REQUIRE(esp_group_count(1, 64) == 1);
+  REQUIRE(esp_group_count(64, 64) == 1);
+  REQUIRE(esp_group_count(65, 64) == 2);
+  REQUIRE(esp_group_count(1000, 16) == 63);
+  REQUIRE(esp_group_count(UINT32_MAX, 64) == (UINT32_MAX >> 6) + 1);
+}
+
+TEST_CASE("Compute job - barriers synchronize their stages", "[compute_job]")
+{
+  auto scope = esp_barrier_scope(EspBarrier::ESP_BARRIER_COMPUTE_TO_COMPUTE);
+  REQUIRE(scope.m_src_stages == ESP_BARRIER_STAGE_COMPUTE);
+  REQUIRE(scope.m_dst_stages == ESP_BARRIER_STAGE_COMPUTE);
+
+  scope = esp_barrier_scope(EspBarrier::ESP_BARRIER_COMPUTE_TO_INDIRECT);
+  REQUIRE(scope.m_src_stages == ESP_BARRIER_STAGE_COMPUTE);
+  REQUIRE(scope.m_dst_stages == ESP_BARRIER_STAGE_INDIRECT);
+
+  scope = esp_barrier_scope(EspBarrier::ESP_BARRIER_TRANSFER_TO_COMPUTE);
+  REQUIRE(scope.m_src_stages == ESP_BARRIER_STAGE_TRANSFER);
+  REQUIRE(scope.m_dst_stages == ESP_BARRIER_STAGE_COMPUTE);
+
+  scope = esp_barrier_scope(EspBarrier::ESP_BARRIER_GRAPHICS_TO_COMPUTE);
+  REQUIRE(scope.m_src_stages == (ESP_BARRIER_STAGE_VERTEX | ESP_BARRIER_STAGE_FRAGMENT | ESP_BARRIER_STAGE_ATTACHMENT));
+  REQUIRE(scope.m_dst_stages == ESP_BARRIER_STAGE_COMPUTE);
+}
+
+TEST_CASE("Compute job - compute queue supports only compute barriers", "[compute_job]")
+{
+  REQUIRE(esp_barrier_is_compute_queue_compatible(EspBarrier::ESP_BARRIER_COMPUTE_TO_COMPUTE));
+  REQUIRE(esp_barrier_is_compute_queue_compatible(EspBarrier::ESP_BARRIER_COMPUTE_TO_INDIRECT));
+  REQUIRE(esp_barrier_is_compute_queue_compatible(EspBarrier::ESP_BARRIER_TRANSFER_TO_COMPUTE));
+
+  // graphics stages have to be synchronized in the frame's command buffer
+  REQUIRE_FALSE(esp_barrier_is_compute_queue_compatible(EspBarrier::ESP_BARRIER_COMPUTE_TO_VERTEX));
+  REQUIRE_FALSE(esp_barrier_is_compute_queue_compatible(EspBarrier::ESP_BARRIER_COMPUTE_TO_FRAGMENT));
+  REQUIRE_FALSE(esp_barrier_is_compute_queue_compatible(EspBarrier::ESP_BARRIER_GRAPHICS_TO_COMPUTE));
+}
+
+TEST_CASE("Compute job - dispatches write storage buffers read back by the CPU", "[compute_job]")
+{
+  if (!has_vulkan_device())
+  {
+    WARN("No Vulkan device, skipping the compute round trip.");
+    return;
+  }
+
+  // layout of the shader's push constant block
+  struct RoundTripPush
+  {
+    uint32_t m_count;
+    uint32_t m_scale;
+  };
+  constexpr uint32_t LOCAL_SIZE = 64;
+  constexpr uint32_t COUNT      = 1000;
+  constexpr uint32_t SCALE      = 3;
+
+  auto context = EspApplicationContext::create();
+  auto app     = create_headless_test_app();
+  app->set_context(std::move(context));
+
+  {
+    SpirvData code(compute_round_trip_comp,
+                   compute_round_trip_comp + sizeof(compute_round_trip_comp) / sizeof(uint32_t));
+
+    SpirvReflection reflection = {};
+    auto uniforms_meta_data    = EspUniformMetaData::create();
+    REQUIRE(reflection.add_stage(EspShaderStage::COMPUTE, code));
+    REQUIRE(reflection.fill_uniform_meta_data(*uniforms_meta_data));
+    SpirvDataMap spirv_data_map = { { EspShaderStage::COMPUTE, std::move(code) } };
+    auto spirv_resource =
+        std::make_shared<SpirvResource>("compute_round_trip", std::move(spirv_data_map), std::move(reflection));
+
+    auto builder = EspWorkerBuilder::create();
+    builder->set_shaders(std::move(spirv_resource));
+    builder->set_worker_layout(std::move(uniforms_meta_data));
+    auto worker = builder->build_compute_worker();
+
+    std::vector<uint32_t> values(COUNT);
+    for (uint32_t i = 0; i < COUNT; i++)
+    {
+      values[i] = i;
+    }
+    // input is device local and copied through a staging buffer, output is mapped so it can be read back
+    auto input  = EspStorageBuffer::create(COUNT * sizeof(uint32_t), values.data());
+    auto output = VulkanStorageBuffer::create_host_visible(COUNT * sizeof(uint32_t));
+    std::memset(output->get_mapped_memory(), 0, COUNT * sizeof(uint32_t));
+
+    auto uniform_manager = worker->create_uniform_manager();
+    uniform_manager->load_storage_buffer(0, 0, input.get());
+    uniform_manager->load_storage_buffer(0, 1, output.get());
+    uniform_manager->build();
+
+    RoundTripPush push = { COUNT, SCALE };
+    auto group_count   = esp_group_count(COUNT, LOCAL_SIZE);
+
+    SECTION("Direct dispatch")
+    {
+      app->begin_frame();
+      worker->attach();
+      uniform_manager->attach();
+      uniform_manager->update_push_uniform(0, &push);
+      EspJob::dispatch(group_count, 1, 1);
+      app->end_frame();
+    }
+
+    SECTION("Indirect dispatch")
+    {
+      uint32_t group_counts[] = { group_count, 1, 1 };
+      auto dispatch_args      = EspStorageBuffer::create(sizeof(group_counts), group_counts);
+
+      app->begin_frame();
+      worker->attach();
+      uniform_manager->attach();
+      uniform_manager->update_push_uniform(0, &push);
+      EspJob::dispatch_indirect(*dispatch_args);
+      app->end_frame();
+
+      app->wait_idle();
+    }
+
+    app->wait_idle();
+
+    auto results = static_cast<const uint32_t*>(output->get_mapped_memory());
+    for (uint32_t i = 0; i < COUNT; i++)
+    {
+      REQUIRE(results[i] == values[i] * SCALE + 1);
+    }
+  }
+
+  delete app;
+}
@@ -0,0 +1,203 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Core/Renderer/Culling/BoundingVolumeHierarchy.hh"
+
+using namespace esp;
+
+namespace
+{
+  Frustum make_frustum()
+  {
+    // camera at origin looking towards -Z
+    glm::mat4 projection = glm::perspective(glm::radians(90.f), 1.f, .1f, 100.f);
+    glm::mat4 view       = glm::lookAt(glm::vec3(0.f), glm::vec3(0.f, 0.f, -1.f), glm::vec3(0.f, 1.f, 0.f));
+    return Frustum(projection * view);
+  }
+
+  std::vector<AABB> make_random_boxes(uint32_t count, std::mt19937& rng)
+  {
+    std::uniform_real_distribution<float> position(-150.f, 150.f);
+    std::uniform_real_distribution<float> size(.1f, 5.f);
+
+    std::vector<AABB> boxes;
+    for (uint32_t i = 0; i < count; i++)
+    {
+      glm::vec3 min = { position(rng), position(rng), position(rng) };
+      boxes.emplace_back(min, min + glm::vec3(size(rng), size(rng), size(rng)));
+    }
+    return boxes;
+  }
+
+  std::vector<uint32_t> brute_force(const Frustum& frustum, const std::vector<AABB>& boxes)
+  {
+    std::vector<uint32_t> result;
+    for (uint32_t i = 0; i < boxes.size(); i++)
+    {
+      if (frustum.intersects(boxes[i])) { result.push_back(i); }
+    }
+    return result;
+  }
+} // namespace
+
+TEST_CASE("Culling - bounds", "[culling]")
+{
+  AABB aabb;
+  REQUIRE(!aabb.is_valid());
+
+  aabb.expand(glm::vec3(-1.f, 0.f, 0.f));
+  aabb.expand(glm::vec3(1.f, 2.f, 0.f));
+  REQUIRE(aabb.is_valid());
+  REQUIRE(aabb.get_center() == glm::vec3(0.f, 1.f, 0.f));
+
+  auto moved = aabb.transform(glm::translate(glm::mat4(1.f), glm::vec3(10.f, 0.f, 0.f)));
+  REQUIRE(moved.m_min == glm::vec3(9.f, 0.f, 0.f));
+  REQUIRE(moved.m_max == glm::vec3(11.f, 2.f, 0.f));
+
+  // rotation by 90 degrees around Z swaps x and y extents
+  auto rotated = aabb.transform(glm::rotate(glm::mat4(1.f), glm::radians(90.f), glm::vec3(0.f, 0.f, 1.f)));
+  auto extents = rotated.get_extents();
+  REQUIRE(std::abs(extents.x - 1.f) < 1e-4f);
+  REQUIRE(std::abs(extents.y - 1.f) < 1e-4f);
+
+  BoundingSphere sphere{ glm::vec3(0.f), 1.f };
+  auto scaled = sphere.transform(glm::scale(glm::mat4(1.f), glm::vec3(1.f, 3.f, 2.f)));
+  REQUIRE(std::abs(scaled.m_radius - 3.f) < 1e-4f);
+}
+
+TEST_CASE("Culling - frustum", "[culling]")
+{
+  auto frustum = make_frustum();
+
+  REQUIRE(frustum.classify(AABB({ -1.f, -1.f, -11.f }, { 1.f, 1.f, -9.f })) == Frustum::INSIDE);
+  REQUIRE(frustum.classify(AABB({ -1.f, -1.f, 1.f }, { 1.f, 1.f, 3.f })) == Frustum::OUTSIDE);
+  REQUIRE(frustum.classify(AABB({ 20.f, -1.f, -11.f }, { 22.f, 1.f, -9.f })) == Frustum::OUTSIDE);
+  REQUIRE(frustum.classify(AABB({ 9.f, -1.f, -11.f }, { 12.f, 1.f, -9.f })) == Frustum::INTERSECTS);
+  REQUIRE(frustum.classify(AABB({ -1.f, -1.f, -201.f }, { 1.f, 1.f, -199.f })) == Frustum::OUTSIDE);
+
+  REQUIRE(frustum.intersects(BoundingSphere{ { 0.f, 0.f, -5.f }, 1.f }));
+  REQUIRE(!frustum.intersects(BoundingSphere{ { 0.f, 0.f, 5.f }, 1.f }));
+
+  // frustum that contains everything
+  REQUIRE(Frustum().classify(AABB({ 1e6f, 1e6f, 1e6f }, { 1e6f + 1.f, 1e6f + 1.f, 1e6f + 1.f })) == Frustum::INSIDE);
+}
+
+TEST_CASE("Culling - batched test matches scalar test", "[culling]")
+{
+  std::mt19937 rng(7);
+  auto frustum = make_frustum();
+  auto boxes   = make_random_boxes(1003, rng);
+
+  std::vector<uint8_t> visible(boxes.size());
+  uint32_t visible_count = frustum.cull(boxes.data(), static_cast<uint32_t>(boxes.size()), visible.data());
+
+  uint32_t expected_count = 0;
+  for (size_t i = 0; i < boxes.size(); i++)
+  {
+    REQUIRE(visible[i] == (frustum.intersects(boxes[i]) ? 1 : 0));
+    expected_count += visible[i];
+  }
+  REQUIRE(visible_count == expected_count);
+  REQUIRE(visible_count > 0);
+  REQUIRE(visible_count < boxes.size());
+}
+
+TEST_CASE("Culling - bounding volume hierarchy", "[culling]")
+{
+  std::mt19937 rng(42);
+  auto frustum = make_frustum();
+  auto boxes   = make_random_boxes(2000, rng);
+
+  BoundingVolumeHierarchy bvh;
+  std::vector<int32_t> proxies;
+  for (uint32_t i = 0; i < boxes.size(); i++)
+  {
+    proxies.push_back(bvh.insert(boxes[i], i));
+  }
+  REQUIRE(bvh.size() == boxes.size());
+  // balanced tree stays shallow
+  REQUIRE(bvh.get_height() < 32);
+
+  auto check_query = [&]()
+  {
+    std::vector<uint32_t> visible;
+    auto stats = bvh.query(frustum, visible);
+    std::sort(visible.begin(), visible.end());
+
+    std::vector<uint32_t> expected;
+    for (auto i : brute_force(frustum, boxes))
+    {
+      if (proxies[i] != BoundingVolumeHierarchy::NULL_NODE) { expected.push_back(i); }
+    }
+
+    REQUIRE(visible == expected);
+    REQUIRE(stats.m_visible == expected.size());
+    REQUIRE(stats.m_objects == bvh.size());
+  };
+
+  SECTION("Static objects") { check_query(); }
+
+  SECTION("Moving objects")
+  {
+    std::uniform_real_distribution<float> offset(-3.f, 3.f);
+    uint32_t reinserted = 0;
+    for (int frame = 0; frame < 5; frame++)
+    {
+      for (uint32_t i = 0; i < boxes.size(); i += 3)
+      {
+        glm::vec3 d = { offset(rng), offset(rng), offset(rng) };
+        boxes[i]    = AABB(boxes[i].m_min + d, boxes[i].m_max + d);
+        reinserted += bvh.update(proxies[i], boxes[i]) ? 1 : 0;
+      }
+      check_query();
+    }
+    // small moves stay inside fat boxes
+    REQUIRE(reinserted < 5 * boxes.size() / 3);
+  }
+
+  SECTION("Removed objects")
+  {
+    for (uint32_t i = 0; i < boxes.size(); i += 2)
+    {
+      bvh.remove(proxies[i]);
+      proxies[i] = BoundingVolumeHierarchy::NULL_NODE;
+    }
+    REQUIRE(bvh.size() == boxes.size() / 2);
+    check_query();
+
+    // freed nodes are reused
+    proxies[0] = bvh.insert(boxes[0], 0);
+    check_query();
+  }
+}
+
+TEST_CASE("Culling - benchmark", "[culling][.benchmark]")
+{
+  std::mt19937 rng(1);
+  auto frustum = make_frustum();
+  auto boxes   = make_random_boxes(10000, rng);
+
+  BoundingVolumeHierarchy bvh;
+  for (uint32_t i = 0; i < boxes.size(); i++)
+  {
+    bvh.insert(boxes[i], i);
+  }
+
+  std::vector<uint8_t> visible(boxes.size());
+  std::vector<uint32_t> visible_ids;
+  visible_ids.reserve(boxes.size());
+
+  BENCHMARK("Scalar test of 10000 boxes") { return brute_force(frustum, boxes).size(); };
+  BENCHMARK("Batched test of 10000 boxes")
+  {
+    return frustum.cull(boxes.data(), static_cast<uint32_t>(boxes.size()), visible.data());
+  };
+  BENCHMARK("BVH query of 10000 boxes")
+  {
+    visible_ids.clear();
+    return bvh.query(frustum, visible_ids).m_visible;
+  };
+}
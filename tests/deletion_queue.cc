@@ -0,0 +1,59 @@
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+#include "Core/RenderAPI/Work/EspDeletionQueue.hh"
+
+using namespace esp;
+
+TEST_CASE("Deletion queue - destructions wait for their frame", "[deletion_queue]")
+{
+  auto queue = EspDeletionQueue::create();
+  std::vector<int> destroyed;
+
+  // deferred before the first frame, nothing can use it
+  EspDeletionQueue::defer([&destroyed]() { destroyed.push_back(0); });
+  queue->begin_frame(1, 0);
+  REQUIRE(destroyed == std::vector<int>{ 0 });
+
+  EspDeletionQueue::defer([&destroyed]() { destroyed.push_back(1); });
+  queue->begin_frame(2, 0);
+  EspDeletionQueue::defer([&destroyed]() { destroyed.push_back(2); });
+  REQUIRE(EspDeletionQueue::get_pending_count() == 2);
+
+  // frame 1 is done, frame 2 may still use the second object
+  queue->begin_frame(3, 1);
+  REQUIRE(destroyed == std::vector<int>{ 0, 1 });
+
+  queue->begin_frame(4, 3);
+  REQUIRE(destroyed == std::vector<int>{ 0, 1, 2 });
+
+  auto stats = EspDeletionQueue::get_stats();
+  REQUIRE(stats.m_deferred == 3);
+  REQUIRE(stats.m_destroyed == 3);
+  REQUIRE(stats.m_peak_pending == 2);
+}
+
+TEST_CASE("Deletion queue - terminate destroys everything", "[deletion_queue]")
+{
+  std::vector<int> destroyed;
+  {
+    auto queue = EspDeletionQueue::create();
+    queue->begin_frame(1, 0);
+
+    // destruction deferring another one, e.g. an object owning a buffer
+    EspDeletionQueue::defer(
+        [&destroyed]()
+        {
+          destroyed.push_back(1);
+          EspDeletionQueue::defer([&destroyed]() { destroyed.push_back(2); });
+        });
+
+    queue->terminate();
+    REQUIRE(destroyed == std::vector<int>{ 1, 2 });
+  }
+
+  // without an instance objects are destroyed right away
+  EspDeletionQueue::defer([&destroyed]() { destroyed.push_back(3); });
+  REQUIRE(destroyed == std::vector<int>{ 1, 2, 3 });
+  REQUIRE(EspDeletionQueue::get_pending_count() == 0);
+}
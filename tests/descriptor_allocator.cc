@@ -0,0 +1,223 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <set>
+#include <vector>
+
+#include "Core/RenderAPI/Uniforms/EspDescriptorAllocator.hh"
+
+using namespace esp;
+
+namespace
+{
+  class MockDescriptorAllocator : public EspDescriptorAllocator
+  {
+   public:
+    struct Pool
+    {
+      uint32_t m_max_sets;
+      uint32_t m_used   = 0;
+      uint32_t m_resets = 0;
+      bool m_destroyed  = false;
+    };
+
+    std::vector<Pool> m_pools;
+    uint64_t m_next_set = 1;
+
+    MockDescriptorAllocator(uint32_t frames_in_flight) : EspDescriptorAllocator(frames_in_flight) {}
+
+   protected:
+    uint64_t create_pool(uint32_t max_sets) override
+    {
+      m_pools.push_back({ max_sets });
+      return m_pools.size();
+    }
+
+    void destroy_pool(uint64_t pool) override { m_pools[pool - 1].m_destroyed = true; }
+
+    void reset_pool(uint64_t pool) override
+    {
+      m_pools[pool - 1].m_used = 0;
+      m_pools[pool - 1].m_resets++;
+    }
+
+    uint64_t allocate_set(uint64_t pool, uint64_t layout) override
+    {
+      auto& p = m_pools[pool - 1];
+      if (p.m_used == p.m_max_sets) { return 0; }
+
+      p.m_used++;
+      return m_next_set++;
+    }
+  };
+} // namespace
+
+TEST_CASE("Descriptor allocator - pools grow", "[descriptor_allocator]")
+{
+  MockDescriptorAllocator allocator(2);
+
+  std::set<uint64_t> sets;
+  for (uint32_t i = 0; i < 64 + 128 + 1; i++)
+  {
+    sets.insert(allocator.allocate(1));
+  }
+
+  REQUIRE(sets.size() == 64 + 128 + 1);
+  REQUIRE(allocator.m_pools.size() == 3);
+  REQUIRE(allocator.m_pools[0].m_max_sets == EspDescriptorAllocator::MIN_POOL_SIZE);
+  REQUIRE(allocator.m_pools[1].m_max_sets == 2 * EspDescriptorAllocator::MIN_POOL_SIZE);
+  REQUIRE(allocator.m_pools[2].m_max_sets == 4 * EspDescriptorAllocator::MIN_POOL_SIZE);
+
+  auto stats = allocator.get_stats();
+  REQUIRE(stats.m_pools_created == 3);
+  REQUIRE(stats.m_sets_allocated == 64 + 128 + 1);
+  REQUIRE(stats.m_sets_reused == 0);
+
+  allocator.terminate();
+  for (auto& pool : allocator.m_pools)
+  {
+    REQUIRE(pool.m_destroyed);
+  }
+}
+
+TEST_CASE("Descriptor allocator - pool size is limited", "[descriptor_allocator]")
+{
+  MockDescriptorAllocator allocator(2);
+  for (uint32_t i = 0; i < 8 * EspDescriptorAllocator::MAX_POOL_SIZE; i++)
+  {
+    allocator.allocate(1);
+  }
+
+  for (auto& pool : allocator.m_pools)
+  {
+    REQUIRE(pool.m_max_sets <= EspDescriptorAllocator::MAX_POOL_SIZE);
+  }
+  REQUIRE(allocator.m_pools.back().m_max_sets == EspDescriptorAllocator::MAX_POOL_SIZE);
+
+  allocator.terminate();
+}
+
+TEST_CASE("Descriptor allocator - freed sets are reused after frames in flight", "[descriptor_allocator]")
+{
+  MockDescriptorAllocator allocator(2);
+  allocator.begin_frame(0);
+
+  auto set = allocator.allocate(1);
+  allocator.free(1, set);
+
+  // GPU may still use the set in this and the previous frame
+  REQUIRE(allocator.allocate(1) != set);
+  allocator.begin_frame(1);
+  REQUIRE(allocator.allocate(1) != set);
+
+  allocator.begin_frame(0);
+  REQUIRE(allocator.allocate(2) != set); // other layout
+  REQUIRE(allocator.allocate(1) == set);
+  REQUIRE(allocator.get_stats().m_sets_reused == 1);
+
+  allocator.terminate();
+}
+
+TEST_CASE("Descriptor allocator - frame sets are reset in bulk", "[descriptor_allocator]")
+{
+  MockDescriptorAllocator allocator(2);
+
+  allocator.begin_frame(0);
+  for (uint32_t i = 0; i < 100; i++)
+  {
+    allocator.allocate_frame(1);
+  }
+  REQUIRE(allocator.m_pools.size() == 2);
+
+  allocator.begin_frame(1);
+  allocator.allocate_frame(1);
+  REQUIRE(allocator.m_pools.size() == 3);
+
+  // pools of the frame are reused and nothing new is created
+  allocator.begin_frame(0);
+  REQUIRE(allocator.m_pools[0].m_resets == 1);
+  REQUIRE(allocator.m_pools[1].m_resets == 1);
+  REQUIRE(allocator.m_pools[2].m_resets == 0);
+  for (uint32_t i = 0; i < 100; i++)
+  {
+    allocator.allocate_frame(1);
+  }
+  REQUIRE(allocator.m_pools.size() == 3);
+  REQUIRE(allocator.get_stats().m_frame_sets_allocated == 201);
+
+  allocator.terminate();
+}
+
+TEST_CASE("Descriptor allocator - large scene", "[descriptor_allocator]")
+{
+  // every entity has a manager for itself and for its material, each with a set per frame in flight
+  constexpr uint32_t entity_count     = 10000;
+  constexpr uint32_t frames_in_flight = 2;
+  constexpr uint32_t set_count        = entity_count * 2 * frames_in_flight;
+
+  MockDescriptorAllocator allocator(frames_in_flight);
+  std::vector<uint64_t> sets;
+  for (uint32_t i = 0; i < set_count; i++)
+  {
+    sets.push_back(allocator.allocate(1 + i % 2));
+  }
+
+  // 40000 pools when every manager had its own one
+  REQUIRE(allocator.get_stats().m_pools_created < 32);
+
+  // the scene is reloaded, so every set is reused
+  for (uint32_t i = 0; i < set_count; i++)
+  {
+    allocator.free(1 + i % 2, sets[i]);
+  }
+  for (uint32_t i = 0; i < frames_in_flight; i++)
+  {
+    allocator.begin_frame(i);
+  }
+  for (uint32_t i = 0; i < set_count; i++)
+  {
+    allocator.allocate(1 + i % 2);
+  }
+  REQUIRE(allocator.get_stats().m_sets_reused == set_count);
+
+  BENCHMARK("Allocate sets for 10000 entities")
+  {
+    MockDescriptorAllocator scene_allocator(frames_in_flight);
+    for (uint32_t i = 0; i < set_count; i++)
+    {
+      scene_allocator.allocate(1 + i % 2);
+    }
+    scene_allocator.terminate();
+    return scene_allocator.m_pools.size();
+  };
+
+  allocator.terminate();
+}
+
+TEST_CASE("Descriptor allocator - released layouts don't pass their sets on", "[descriptor_allocator]")
+{
+  MockDescriptorAllocator allocator(2);
+  allocator.begin_frame(0);
+
+  auto set = allocator.allocate(1);
+  allocator.free(1, set);
+  allocator.begin_frame(1);
+  allocator.begin_frame(0);
+
+  // the layout is destroyed and the driver gives its handle to a new layout
+  allocator.release_layout(1);
+  REQUIRE(allocator.allocate(1) != set);
+
+  auto stats = allocator.get_stats();
+  REQUIRE(stats.m_sets_dropped == 1);
+  REQUIRE(stats.m_sets_reused == 0);
+
+  // freed sets of other layouts are kept
+  auto other_set = allocator.allocate(2);
+  allocator.free(2, other_set);
+  allocator.release_layout(1);
+  allocator.begin_frame(1);
+  allocator.begin_frame(0);
+  REQUIRE(allocator.allocate(2) == other_set);
+
+  allocator.terminate();
+}
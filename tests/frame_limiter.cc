@@ -0,0 +1,90 @@
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <thread>
+
+#include "Core/Utils/FrameLimiter.hh"
+
+using namespace esp;
+using namespace std::chrono_literals;
+
+namespace
+{
+  double elapsed_ms(std::chrono::steady_clock::time_point begin)
+  {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+  }
+} // namespace
+
+TEST_CASE("Frame limiter - frames are limited to the target rate", "[frame_limiter]")
+{
+  auto limiter = FrameLimiter::create(200.f);
+  REQUIRE(limiter->get_target_frame_rate() == 200.f);
+
+  // the first call only starts the cadence
+  auto begin = std::chrono::steady_clock::now();
+  limiter->wait();
+  REQUIRE(elapsed_ms(begin) < 5.0);
+
+  for (uint32_t i = 0; i < 10; i++)
+  {
+    limiter->wait();
+  }
+  REQUIRE(elapsed_ms(begin) >= 50.0);
+
+  auto& stats = limiter->get_stats();
+  REQUIRE(stats.m_frame_count == 10);
+  REQUIRE(stats.m_missed_deadlines == 0);
+  REQUIRE(stats.m_mean_frame_time > 4.5);
+  REQUIRE(stats.m_mean_frame_time < 10.0);
+  REQUIRE(stats.m_max_frame_time >= stats.m_last_frame_time);
+  REQUIRE(stats.get_standard_deviation() >= 0.0);
+}
+
+TEST_CASE("Frame limiter - late frames are counted and not caught up with", "[frame_limiter]")
+{
+  auto limiter = FrameLimiter::create(200.f);
+  limiter->wait();
+
+  std::this_thread::sleep_for(15ms);
+  limiter->wait();
+  REQUIRE(limiter->get_stats().m_missed_deadlines == 1);
+  REQUIRE(limiter->get_stats().m_last_frame_time >= 15.0);
+
+  // the next frame gets a whole frame time again
+  auto begin = std::chrono::steady_clock::now();
+  limiter->wait();
+  REQUIRE(elapsed_ms(begin) >= 4.5);
+  REQUIRE(limiter->get_stats().m_missed_deadlines == 1);
+
+  limiter->reset_stats();
+  REQUIRE(limiter->get_stats().m_frame_count == 0);
+}
+
+TEST_CASE("Frame limiter - unlimited and externally paced frames are only measured", "[frame_limiter]")
+{
+  auto unlimited = FrameLimiter::create(0.f);
+  REQUIRE(unlimited->get_target_frame_rate() == 0.f);
+
+  auto begin = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < 100; i++)
+  {
+    unlimited->wait();
+  }
+  REQUIRE(elapsed_ms(begin) < 5.0);
+  REQUIRE(unlimited->get_stats().m_frame_count == 99);
+  REQUIRE(unlimited->get_stats().m_missed_deadlines == 0);
+
+  auto paced = FrameLimiter::create(100.f, true);
+  paced->wait();
+
+  // a frame around the target time isn't late, one taking two intervals is
+  std::this_thread::sleep_for(11ms);
+  paced->wait();
+  REQUIRE(paced->get_stats().m_missed_deadlines == 0);
+
+  std::this_thread::sleep_for(25ms);
+  begin = std::chrono::steady_clock::now();
+  paced->wait();
+  REQUIRE(elapsed_ms(begin) < 5.0);
+  REQUIRE(paced->get_stats().m_missed_deadlines == 1);
+}
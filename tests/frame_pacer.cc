@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+#include "Core/RenderAPI/Work/EspFramePacer.hh"
+
+using namespace esp;
+
+namespace
+{
+  class MockFramePacer : public EspFramePacer
+  {
+   public:
+    uint64_t m_completed_value = 0;
+    std::vector<uint64_t> m_waits;
+    bool m_destroyed = false;
+
+    MockFramePacer(uint32_t frames_in_flight, EspFramePacingMode mode) : EspFramePacer(frames_in_flight, mode) {}
+
+    // GPU finishes every frame it is asked about
+    void finish_until(uint64_t value) { m_completed_value = std::max(m_completed_value, value); }
+
+   protected:
+    uint64_t query_completed_value() override { return m_completed_value; }
+    void wait_for_value(uint64_t value) override
+    {
+      m_waits.push_back(value);
+      finish_until(value);
+    }
+    void destroy() override { m_destroyed = true; }
+  };
+} // namespace
+
+TEST_CASE("Frame pacer - waits only when frames in flight are used up", "[frame_pacer]")
+{
+  MockFramePacer pacer(3, ESP_FRAME_PACING_THROUGHPUT);
+
+  REQUIRE(pacer.begin_frame() == 0);
+  REQUIRE(pacer.begin_frame() == 1);
+  REQUIRE(pacer.begin_frame() == 2);
+  REQUIRE(pacer.m_waits.empty());
+  REQUIRE(pacer.get_frame_value() == 3);
+
+  // frame 4 reuses resources of frame 1
+  REQUIRE(pacer.begin_frame() == 0);
+  REQUIRE(pacer.m_waits == std::vector<uint64_t>{ 1 });
+
+  // GPU has caught up, nothing to wait for
+  pacer.finish_until(4);
+  REQUIRE(pacer.begin_frame() == 1);
+  REQUIRE(pacer.begin_frame() == 2);
+  REQUIRE(pacer.m_waits.size() == 1);
+
+  REQUIRE(pacer.get_stats().m_frames == 6);
+  REQUIRE(pacer.get_stats().m_waits == 1);
+
+  pacer.terminate();
+  REQUIRE(pacer.m_destroyed);
+}
+
+TEST_CASE("Frame pacer - low latency waits for the previous frame", "[frame_pacer]")
+{
+  MockFramePacer pacer(3, ESP_FRAME_PACING_LOW_LATENCY);
+
+  pacer.begin_frame();
+  REQUIRE(pacer.m_waits.empty());
+
+  pacer.begin_frame();
+  REQUIRE(pacer.m_waits == std::vector<uint64_t>{ 1 });
+
+  // the previous frame is waited for only when the GPU is behind
+  pacer.finish_until(2);
+  pacer.begin_frame();
+  REQUIRE(pacer.m_waits.size() == 1);
+
+  pacer.begin_frame();
+  REQUIRE(pacer.m_waits == std::vector<uint64_t>{ 1, 3 });
+}
+
+TEST_CASE("Frame pacer - modes differ at two frames in flight", "[frame_pacer]")
+{
+  MockFramePacer throughput(2, ESP_FRAME_PACING_THROUGHPUT);
+  MockFramePacer low_latency(2, ESP_FRAME_PACING_LOW_LATENCY);
+
+  for (int i = 0; i < 4; i++)
+  {
+    throughput.begin_frame();
+    low_latency.begin_frame();
+  }
+
+  // throughput lets the CPU record a frame ahead, low latency doesn't
+  REQUIRE(throughput.m_waits == std::vector<uint64_t>{ 1, 2 });
+  REQUIRE(low_latency.m_waits == std::vector<uint64_t>{ 1, 2, 3 });
+}
+
+TEST_CASE("Frame pacer - frames in flight are clamped", "[frame_pacer]")
+{
+  MockFramePacer none(0, ESP_FRAME_PACING_THROUGHPUT);
+  REQUIRE(none.get_frames_in_flight() == 1);
+
+  none.begin_frame();
+  REQUIRE(none.begin_frame() == 0);
+  REQUIRE(none.m_waits == std::vector<uint64_t>{ 1 });
+
+  MockFramePacer many(16, ESP_FRAME_PACING_THROUGHPUT);
+  REQUIRE(many.get_frames_in_flight() == EspFramePacer::MAX_FRAMES_IN_FLIGHT);
+}
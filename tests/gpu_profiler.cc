@@ -0,0 +1,155 @@
+#include <catch2/catch_test_macros.hpp>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "Core/RenderAPI/Work/EspGpuProfiler.hh"
+
+using namespace esp;
+
+namespace
+{
+  // GPU writing a timestamp every microsecond and counting begun statistics queries
+  class MockGpuProfiler : public EspGpuProfiler
+  {
+   public:
+    std::vector<std::vector<double>> m_timestamps;
+    std::vector<uint32_t> m_statistics;
+    double m_clock   = 0.0;
+    bool m_destroyed = false;
+
+    MockGpuProfiler(uint32_t frames_in_flight, bool statistics_supported) :
+        EspGpuProfiler(frames_in_flight, statistics_supported), m_timestamps(frames_in_flight)
+    {
+    }
+
+   protected:
+    void reset_queries(uint32_t frame_index) override { m_timestamps[frame_index].assign(MAX_TIMESTAMPS, -1.0); }
+    void write_timestamp(uint32_t frame_index, uint32_t query, bool end) override
+    {
+      m_clock += 1000.0;
+      m_timestamps[frame_index][query] = m_clock;
+    }
+    void begin_statistics(uint32_t frame_index, uint32_t scope) override { m_statistics.push_back(scope); }
+    void end_statistics(uint32_t frame_index, uint32_t scope) override {}
+    bool read_timestamps(uint32_t frame_index, uint32_t count, std::vector<double>& timestamps) override
+    {
+      timestamps.assign(m_timestamps[frame_index].begin(), m_timestamps[frame_index].begin() + count);
+      for (auto timestamp : timestamps)
+      {
+        if (timestamp < 0.0) { return false; }
+      }
+      return true;
+    }
+    bool read_statistics(uint32_t frame_index, uint32_t scope, EspPipelineStatistics& statistics) override
+    {
+      statistics.m_vertex_shader_invocations = 3 * (scope + 1);
+      return true;
+    }
+    void destroy() override { m_destroyed = true; }
+  };
+} // namespace
+
+TEST_CASE("GPU profiler - scopes are resolved when the frame index is reused", "[gpu_profiler]")
+{
+  MockGpuProfiler profiler(2, true);
+
+  EspGpuProfiler::begin_frame(0, 1);
+  EspGpuProfiler::begin_scope("shadows");
+  EspGpuProfiler::end_scope();
+  EspGpuProfiler::begin_scope("main");
+  EspGpuProfiler::begin_scope("opaque");
+  EspGpuProfiler::end_scope();
+  EspGpuProfiler::end_scope();
+  EspGpuProfiler::end_frame();
+
+  // nested scope doesn't get a statistics query
+  REQUIRE(profiler.m_statistics == std::vector<uint32_t>{ 0, 1 });
+
+  EspGpuProfiler::begin_frame(1, 2);
+  EspGpuProfiler::end_frame();
+  REQUIRE(EspGpuProfiler::get_last_frame_timings().m_frame_value == 0);
+
+  EspGpuProfiler::begin_frame(0, 3);
+  auto frame = EspGpuProfiler::get_last_frame_timings();
+  REQUIRE(frame.m_frame_value == 1);
+  REQUIRE(frame.m_frame_time == 0.007);
+  REQUIRE(frame.m_scopes.size() == 3);
+
+  REQUIRE(frame.m_scopes[0].m_name == "shadows");
+  REQUIRE(frame.m_scopes[0].m_begin == 0.001);
+  REQUIRE(frame.m_scopes[0].m_time == 0.001);
+  REQUIRE(frame.m_scopes[0].m_has_statistics);
+  REQUIRE(frame.m_scopes[0].m_statistics.m_vertex_shader_invocations == 3);
+
+  REQUIRE(frame.m_scopes[1].m_name == "main");
+  REQUIRE(frame.m_scopes[1].m_depth == 0);
+  REQUIRE(frame.m_scopes[1].m_time == 0.003);
+  REQUIRE(frame.m_scopes[2].m_name == "opaque");
+  REQUIRE(frame.m_scopes[2].m_depth == 1);
+  REQUIRE_FALSE(frame.m_scopes[2].m_has_statistics);
+
+  profiler.terminate();
+  REQUIRE(profiler.m_destroyed);
+  REQUIRE_FALSE(EspGpuProfiler::is_enabled());
+}
+
+TEST_CASE("GPU profiler - scopes outside of frames, above the limit and left open", "[gpu_profiler]")
+{
+  MockGpuProfiler profiler(1, false);
+
+  // nothing is recorded outside of a frame
+  EspGpuProfiler::begin_scope("ignored");
+  EspGpuProfiler::end_scope();
+  REQUIRE(profiler.m_clock == 0.0);
+
+  EspGpuProfiler::begin_frame(0, 1);
+  for (uint32_t i = 0; i < EspGpuProfiler::MAX_SCOPES + 2; i++)
+  {
+    EspGpuProfiler::begin_scope("scope");
+  }
+  // left open scopes are ended with the frame
+  EspGpuProfiler::end_frame();
+
+  EspGpuProfiler::begin_frame(0, 2);
+  auto frame = EspGpuProfiler::get_last_frame_timings();
+  REQUIRE(frame.m_scopes.size() == EspGpuProfiler::MAX_SCOPES);
+  REQUIRE(frame.m_scopes.back().m_depth == EspGpuProfiler::MAX_SCOPES - 1);
+  REQUIRE(profiler.m_statistics.empty());
+  for (auto& scope : frame.m_scopes)
+  {
+    REQUIRE(scope.m_time > 0.0);
+  }
+
+  profiler.terminate();
+}
+
+TEST_CASE("GPU profiler - frames in flight are written to the trace on terminate", "[gpu_profiler]")
+{
+  auto trace_path = fs::temp_directory_path() / "espert_gpu_profiler_test.json";
+  {
+    MockGpuProfiler profiler(2, false);
+    profiler.open_trace(trace_path);
+
+    EspGpuProfiler::begin_frame(0, 1);
+    EspGpuProfiler::begin_scope("plan \"a\"");
+    EspGpuProfiler::end_scope();
+    EspGpuProfiler::end_frame();
+    EspGpuProfiler::begin_frame(1, 2);
+    EspGpuProfiler::end_frame();
+
+    profiler.terminate();
+  }
+
+  std::ifstream file(trace_path);
+  std::stringstream trace;
+  trace << file.rdbuf();
+  auto text = trace.str();
+
+  REQUIRE(text.rfind("{\"traceEvents\":[", 0) == 0);
+  REQUIRE(text.find("\"name\":\"plan \\\"a\\\"\"") != std::string::npos);
+  REQUIRE(text.find("\"frame\":2") != std::string::npos);
+  REQUIRE(text.find("\n]}") != std::string::npos);
+
+  fs::remove(trace_path);
+}
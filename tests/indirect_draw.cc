@@ -0,0 +1,201 @@
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <vector>
+
+#include "Core/Jobs/JobSystem.hh"
+#include "Core/Renderer/Culling/IndirectCullKernel.hh"
+#include "Core/Renderer/Culling/IndirectDrawCuller.hh"
+
+using namespace esp;
+
+namespace
+{
+  class MockDrawCommandBuffer : public EspDrawCommandBuffer
+  {
+   private:
+    std::vector<EspDrawIndexedCommand> m_commands;
+    uint32_t m_count = 0;
+
+   public:
+    MockDrawCommandBuffer(uint32_t max_command_count) : m_commands(max_command_count)
+    {
+      m_max_command_count = max_command_count;
+    }
+
+    EspDrawIndexedCommand* get_commands() override { return m_commands.data(); }
+    void set_command_count(uint32_t count) override { m_count = count; }
+    uint32_t get_command_count() const override { return m_count; }
+  };
+
+  Frustum make_frustum()
+  {
+    glm::mat4 projection = glm::perspective(glm::radians(90.f), 1.f, .1f, 100.f);
+    glm::mat4 view       = glm::lookAt(glm::vec3(0.f), glm::vec3(0.f, 0.f, -1.f), glm::vec3(0.f, 1.f, 0.f));
+    return Frustum(projection * view);
+  }
+
+  // every draw gets its index as first instance, so the written commands can be traced back
+  std::vector<AABB> fill(IndirectDrawCuller& culler, uint32_t count, std::mt19937& rng)
+  {
+    std::uniform_real_distribution<float> position(-150.f, 150.f);
+
+    std::vector<AABB> boxes;
+    for (uint32_t i = 0; i < count; i++)
+    {
+      glm::vec3 min = { position(rng), position(rng), position(rng) };
+      boxes.emplace_back(min, min + glm::vec3(1.f));
+      culler.add(boxes.back(), { .m_index_count = 36, .m_first_index = i * 36, .m_first_instance = i });
+    }
+    return boxes;
+  }
+
+  std::vector<uint32_t> brute_force(const Frustum& frustum, const std::vector<AABB>& boxes)
+  {
+    std::vector<uint32_t> result;
+    for (uint32_t i = 0; i < boxes.size(); i++)
+    {
+      if (frustum.intersects(boxes[i])) { result.push_back(i); }
+    }
+    return result;
+  }
+} // namespace
+
+TEST_CASE("Indirect draw - commands are compacted in order", "[indirect_draw]")
+{
+  std::mt19937 rng(3);
+  auto frustum = make_frustum();
+
+  IndirectDrawCuller culler;
+  auto boxes    = fill(culler, 10007, rng);
+  auto expected = brute_force(frustum, boxes);
+  REQUIRE(!expected.empty());
+
+  auto check = [&]()
+  {
+    MockDrawCommandBuffer buffer(culler.size());
+    uint32_t count = culler.cull(frustum, buffer);
+
+    REQUIRE(count == expected.size());
+    REQUIRE(buffer.get_command_count() == count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+      auto& command = buffer.get_commands()[i];
+      REQUIRE(command.m_first_instance == expected[i]);
+      REQUIRE(command.m_first_index == expected[i] * 36);
+      REQUIRE(command.m_index_count == 36);
+      REQUIRE(command.m_instance_count == 1);
+    }
+  };
+
+  SECTION("Without job system") { check(); }
+
+  SECTION("With job system")
+  {
+    auto job_system = JobSystem::create(3);
+    check();
+  }
+}
+
+TEST_CASE("Indirect draw - output is clamped to capacity", "[indirect_draw]")
+{
+  std::mt19937 rng(5);
+  auto frustum = make_frustum();
+
+  IndirectDrawCuller culler;
+  auto boxes    = fill(culler, 5000, rng);
+  auto expected = brute_force(frustum, boxes);
+  REQUIRE(expected.size() > 10);
+
+  std::vector<EspDrawIndexedCommand> commands(10);
+  REQUIRE(culler.cull(frustum, commands.data(), 10) == 10);
+  for (uint32_t i = 0; i < 10; i++)
+  {
+    REQUIRE(commands[i].m_first_instance == expected[i]);
+  }
+
+  // moved draw stops being visible
+  culler.set_bounds(expected[0], AABB({ -1.f, -1.f, 10.f }, { 1.f, 1.f, 12.f }));
+  REQUIRE(culler.cull(frustum, commands.data(), 10) == 10);
+  REQUIRE(commands[0].m_first_instance == expected[1]);
+
+  culler.clear();
+  REQUIRE(culler.cull(frustum, commands.data(), 10) == 0);
+}
+
+TEST_CASE("Indirect draw - GPU kernel matches the CPU culler", "[indirect_draw]")
+{
+  std::mt19937 rng(7);
+  auto frustum = make_frustum();
+
+  IndirectDrawCuller culler;
+  fill(culler, 10007, rng);
+
+  // boxes the way GpuIndirectDrawCuller uploads them
+  std::vector<indirect_cull_kernel::Bounds> bounds;
+  for (auto& aabb : culler.get_bounds())
+  {
+    bounds.push_back(indirect_cull_kernel::pack_bounds(aabb));
+  }
+
+  // the GPU writes commands in any order, so only sets of draws are compared
+  auto first_instances = [](const std::vector<EspDrawIndexedCommand>& commands, uint32_t count)
+  {
+    std::vector<uint32_t> result;
+    for (uint32_t i = 0; i < count; i++)
+    {
+      result.push_back(commands[i].m_first_instance);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  };
+
+  SECTION("All visible draws fit")
+  {
+    std::vector<EspDrawIndexedCommand> cpu_commands(culler.size());
+    std::vector<EspDrawIndexedCommand> gpu_commands(culler.size());
+
+    uint32_t cpu_count = culler.cull(frustum, cpu_commands.data(), culler.size());
+    uint32_t gpu_count = indirect_cull_kernel::run(
+        frustum, bounds.data(), culler.get_commands().data(), culler.size(), gpu_commands.data(), culler.size());
+
+    REQUIRE(cpu_count > 0);
+    REQUIRE(gpu_count == cpu_count);
+    REQUIRE(first_instances(gpu_commands, gpu_count) == first_instances(cpu_commands, cpu_count));
+  }
+
+  SECTION("Counter grows past the capacity")
+  {
+    std::vector<EspDrawIndexedCommand> cpu_commands(10);
+    std::vector<EspDrawIndexedCommand> gpu_commands(10);
+
+    uint32_t cpu_count = culler.cull(frustum, cpu_commands.data(), 10);
+    uint32_t gpu_count = indirect_cull_kernel::run(
+        frustum, bounds.data(), culler.get_commands().data(), culler.size(), gpu_commands.data(), 10);
+
+    // indirect draws clamp the counter to the maximum draw count
+    REQUIRE(cpu_count == 10);
+    REQUIRE(gpu_count > 10);
+    REQUIRE(std::min(gpu_count, 10u) == cpu_count);
+    for (auto& command : gpu_commands)
+    {
+      REQUIRE(command.m_index_count == 36);
+    }
+  }
+}
+
+TEST_CASE("Indirect draw - benchmark", "[indirect_draw][.benchmark]")
+{
+  std::mt19937 rng(1);
+  auto frustum = make_frustum();
+
+  IndirectDrawCuller culler;
+  fill(culler, 100000, rng);
+  MockDrawCommandBuffer buffer(culler.size());
+
+  BENCHMARK("Cull and compact 100000 draws on one thread") { return culler.cull(frustum, buffer); };
+
+  auto job_system = JobSystem::create();
+  BENCHMARK("Cull and compact 100000 draws with job system") { return culler.cull(frustum, buffer); };
+}
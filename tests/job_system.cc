@@ -0,0 +1,192 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+#include "Core/Jobs/JobSystem.hh"
+
+using namespace esp;
+
+namespace
+{
+  // splits the range in halves until it's small enough, every half is a separate job
+  uint64_t fork_join_sum(const std::vector<uint32_t>& values, uint32_t begin, uint32_t end)
+  {
+    if (end - begin <= 1024)
+    {
+      return std::accumulate(values.begin() + begin, values.begin() + end, uint64_t{ 0 });
+    }
+
+    uint32_t middle = begin + (end - begin) / 2;
+    uint64_t left   = 0;
+
+    JobCounter counter;
+    JobSystem::run([&]() { left = fork_join_sum(values, begin, middle); }, &counter);
+    uint64_t right = fork_join_sum(values, middle, end);
+    JobSystem::wait(counter);
+
+    return left + right;
+  }
+} // namespace
+
+TEST_CASE("Job system - jobs run without job system", "[job_system]")
+{
+  int value = 0;
+  JobCounter counter;
+
+  JobSystem::run([&]() { value++; }, &counter);
+  JobSystem::wait(counter);
+
+  REQUIRE(value == 1);
+  REQUIRE(JobSystem::get_thread_count() == 1);
+}
+
+TEST_CASE("Job system - run and wait", "[job_system]")
+{
+  auto job_system = JobSystem::create(3);
+  REQUIRE(JobSystem::get_thread_count() == 4);
+
+  std::atomic<uint32_t> value = 0;
+  JobCounter counter;
+  for (int i = 0; i < 1000; i++)
+  {
+    JobSystem::run([&]() { value++; }, &counter);
+  }
+  JobSystem::wait(counter);
+
+  REQUIRE(value == 1000);
+  REQUIRE(counter.get_value() == 0);
+  REQUIRE(JobSystem::get_stats().m_executed >= 1000);
+}
+
+TEST_CASE("Job system - parallel for", "[job_system]")
+{
+  auto job_system = JobSystem::create(3);
+
+  std::vector<uint32_t> values(100003, 0);
+  JobSystem::parallel_for(static_cast<uint32_t>(values.size()),
+                          1000,
+                          [&](uint32_t begin, uint32_t end)
+                          {
+                            for (uint32_t i = begin; i < end; i++)
+                            {
+                              values[i]++;
+                            }
+                          });
+
+  // every element is visited exactly once
+  REQUIRE(std::all_of(values.begin(), values.end(), [](uint32_t value) { return value == 1; }));
+}
+
+TEST_CASE("Job system - dependencies", "[job_system]")
+{
+  auto job_system = JobSystem::create(3);
+
+  std::vector<int> order;
+  std::mutex order_mutex;
+  auto record = [&](int step)
+  {
+    std::lock_guard<std::mutex> lock(order_mutex);
+    order.push_back(step);
+  };
+
+  JobCounter first;
+  JobCounter second;
+  JobCounter third;
+
+  // the slow first job makes the other ones wait as continuations of the counters
+  JobSystem::run(
+      [&]()
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        record(1);
+      },
+      &first);
+  for (int i = 0; i < 8; i++)
+  {
+    JobSystem::run_after(first, [&]() { record(2); }, &second);
+  }
+  JobSystem::run_after(second, [&]() { record(3); }, &third);
+
+  JobSystem::wait(third);
+
+  REQUIRE(order.size() == 10);
+  REQUIRE(order.front() == 1);
+  REQUIRE(order.back() == 3);
+}
+
+TEST_CASE("Job system - nested jobs and profiling hook", "[job_system]")
+{
+  auto job_system = JobSystem::create(3);
+
+  std::atomic<uint32_t> begun = 0;
+  std::atomic<uint32_t> ended = 0;
+  JobSystem::set_profiling_hook({ .m_on_begin = [&](const char*, uint32_t) { begun++; },
+                                  .m_on_end   = [&](const char*, uint32_t) { ended++; } });
+
+  std::vector<uint32_t> values(1 << 16);
+  std::iota(values.begin(), values.end(), 0);
+
+  uint64_t expected = std::accumulate(values.begin(), values.end(), uint64_t{ 0 });
+  REQUIRE(fork_join_sum(values, 0, static_cast<uint32_t>(values.size())) == expected);
+
+  // 2^16 / 1024 leaves - 1 forks
+  REQUIRE(begun == 63);
+  REQUIRE(ended == 63);
+}
+
+TEST_CASE("Job system - benchmark", "[job_system][.benchmark]")
+{
+  auto job_system = JobSystem::create();
+
+  std::vector<uint32_t> values(1 << 22);
+  std::iota(values.begin(), values.end(), 0);
+
+  BENCHMARK("Fork/join sum of 4M values") { return fork_join_sum(values, 0, static_cast<uint32_t>(values.size())); };
+
+  BENCHMARK("Serial sum of 4M values") { return std::accumulate(values.begin(), values.end(), uint64_t{ 0 }); };
+
+  BENCHMARK("100000 fine-grained jobs")
+  {
+    std::atomic<uint32_t> value = 0;
+    JobCounter counter;
+    for (int i = 0; i < 100000; i++)
+    {
+      JobSystem::run([&]() { value.fetch_add(1, std::memory_order_relaxed); }, &counter);
+    }
+    JobSystem::wait(counter);
+    return value.load();
+  };
+
+  BENCHMARK("Parallel for over 4M values with batches of 4096")
+  {
+    std::atomic<uint64_t> sum = 0;
+    JobSystem::parallel_for(static_cast<uint32_t>(values.size()),
+                            4096,
+                            [&](uint32_t begin, uint32_t end)
+                            { sum += std::accumulate(values.begin() + begin, values.begin() + end, uint64_t{ 0 }); });
+    return sum.load();
+  };
+
+  BENCHMARK("Contention - every worker submits jobs")
+  {
+    // jobs spawn jobs on all threads at once, so queues are pushed to and stolen from concurrently
+    std::atomic<uint32_t> value = 0;
+    JobCounter counter;
+    for (uint32_t i = 0; i < JobSystem::get_thread_count() * 4; i++)
+    {
+      JobSystem::run(
+          [&]()
+          {
+            for (int j = 0; j < 2500; j++)
+            {
+              JobSystem::run([&]() { value.fetch_add(1, std::memory_order_relaxed); }, &counter);
+            }
+          },
+          &counter);
+    }
+    JobSystem::wait(counter);
+    return value.load();
+  };
+}
@@ -0,0 +1,85 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Core/Utils/Logger.hh"
+
+#include <atomic>
+#include <thread>
+
+using namespace esp;
+
+namespace
+{
+  // argument remembering which thread formatted it
+  struct FormatProbe
+  {
+    int m_value;
+  };
+
+  std::atomic<int> s_formatted_count      = 0;
+  std::atomic<bool> s_formatted_by_caller = false;
+  std::thread::id s_caller;
+} // namespace
+
+template<> struct fmt::formatter<FormatProbe> : fmt::formatter<int>
+{
+  auto format(const FormatProbe& probe, fmt::format_context& context) const
+  {
+    s_formatted_count++;
+    if (std::this_thread::get_id() == s_caller) { s_formatted_by_caller = true; }
+    return fmt::formatter<int>::format(probe.m_value, context);
+  }
+};
+
+TEST_CASE("Logger - categories have their own levels", "[logger]")
+{
+  for (bool async : { true, false })
+  {
+    auto logger = Logger::create(async);
+
+    auto renderer = Logger::create_category("Renderer");
+    REQUIRE(Logger::create_category("Renderer") == renderer);
+    REQUIRE(renderer->level() == spdlog::level::trace);
+
+    Logger::set_level("Renderer", spdlog::level::warn);
+    REQUIRE(renderer->level() == spdlog::level::warn);
+    REQUIRE(Logger::get_core_logger()->level() == spdlog::level::trace);
+    REQUIRE_FALSE(renderer->should_log(spdlog::level::info));
+
+    // unknown category is ignored
+    Logger::set_level("Unknown", spdlog::level::off);
+
+    renderer->warn("Logged by {} logger.", async ? "asynchronous" : "synchronous");
+    Logger::flush();
+  }
+
+  // loggers are released with the instance, so it can be created again
+  REQUIRE(Logger::get_instance() == nullptr);
+}
+
+TEST_CASE("Logger - asynchronous mode formats messages on the background thread", "[logger]")
+{
+  s_caller = std::this_thread::get_id();
+
+  for (bool async : { true, false })
+  {
+    s_formatted_count     = 0;
+    s_formatted_by_caller = false;
+
+    auto logger = Logger::create(async);
+    auto probes = Logger::create_category("Probes");
+
+    constexpr int MESSAGE_COUNT = 100;
+    for (int i = 0; i < MESSAGE_COUNT; i++)
+    {
+      Logger::log(*probes, spdlog::level::info, "Probe {} of {}.", FormatProbe{ i }, MESSAGE_COUNT);
+    }
+
+    // messages below the level aren't formatted in any mode
+    Logger::set_level("Probes", spdlog::level::warn);
+    Logger::log(*probes, spdlog::level::info, "Probe {}.", FormatProbe{ MESSAGE_COUNT });
+
+    Logger::flush();
+    REQUIRE(s_formatted_count == MESSAGE_COUNT);
+    REQUIRE(s_formatted_by_caller == !async);
+  }
+}
@@ -0,0 +1,192 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Core/Jobs/JobSystem.hh"
+#include "Core/Resources/MipGenerator.hh"
+
+using namespace esp;
+
+namespace
+{
+  std::vector<uint8_t> random_image(uint32_t width, uint32_t height, std::mt19937& rng)
+  {
+    std::uniform_int_distribution<uint32_t> value(0, 255);
+
+    std::vector<uint8_t> pixels(width * height * 4);
+    for (auto& pixel : pixels)
+    {
+      pixel = static_cast<uint8_t>(value(rng));
+    }
+    return pixels;
+  }
+
+  double to_linear(uint8_t value)
+  {
+    double c = value / 255.0;
+    return c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+  }
+
+  uint8_t to_srgb(double linear)
+  {
+    double c = linear <= 0.0031308 ? linear * 12.92 : 1.055 * std::pow(linear, 1.0 / 2.4) - 0.055;
+    return static_cast<uint8_t>(std::lround(std::clamp(c, 0.0, 1.0) * 255.0));
+  }
+
+  // straightforward 2x2 box filter the generator is compared with
+  std::vector<uint8_t> reference_downsample(const std::vector<uint8_t>& src, uint32_t width, uint32_t height, bool srgb)
+  {
+    uint32_t dst_width  = std::max(width / 2, 1u);
+    uint32_t dst_height = std::max(height / 2, 1u);
+
+    std::vector<uint8_t> dst(dst_width * dst_height * 4);
+    for (uint32_t y = 0; y < dst_height; y++)
+    {
+      for (uint32_t x = 0; x < dst_width; x++)
+      {
+        uint32_t xs[] = { std::min(2 * x, width - 1), std::min(2 * x + 1, width - 1) };
+        uint32_t ys[] = { std::min(2 * y, height - 1), std::min(2 * y + 1, height - 1) };
+
+        for (uint32_t c = 0; c < 4; c++)
+        {
+          double sum       = 0.0;
+          uint32_t int_sum = 0;
+          for (auto sy : ys)
+          {
+            for (auto sx : xs)
+            {
+              auto value = src[(sy * width + sx) * 4 + c];
+              sum += to_linear(value);
+              int_sum += value;
+            }
+          }
+
+          auto& result = dst[(y * dst_width + x) * 4 + c];
+          result       = srgb && c < 3 ? to_srgb(sum / 4.0) : static_cast<uint8_t>((int_sum + 2) / 4);
+        }
+      }
+    }
+    return dst;
+  }
+
+  // compares every level with the reference filter applied to the previous generated level
+  void check_chain(const MipChain& chain, uint32_t tolerance)
+  {
+    for (uint32_t level = 1; level < chain.m_levels.size(); level++)
+    {
+      auto& src = chain.m_levels[level - 1];
+      auto& dst = chain.m_levels[level];
+      REQUIRE(dst.m_width == std::max(src.m_width / 2, 1u));
+      REQUIRE(dst.m_height == std::max(src.m_height / 2, 1u));
+
+      std::vector<uint8_t> src_pixels(chain.get_level_data(level - 1),
+                                      chain.get_level_data(level - 1) + src.m_width * src.m_height * 4);
+      auto expected = reference_downsample(src_pixels, src.m_width, src.m_height, chain.m_srgb);
+
+      uint32_t max_difference = 0;
+      for (uint32_t i = 0; i < expected.size(); i++)
+      {
+        max_difference = std::max<uint32_t>(max_difference, std::abs(expected[i] - chain.get_level_data(level)[i]));
+      }
+      REQUIRE(max_difference <= tolerance);
+    }
+  }
+} // namespace
+
+TEST_CASE("Mip generator - number of levels", "[mip_generator]")
+{
+  REQUIRE(MipGenerator::get_mip_levels(1, 1) == 1);
+  REQUIRE(MipGenerator::get_mip_levels(256, 256) == 9);
+  REQUIRE(MipGenerator::get_mip_levels(300, 20) == 9);
+  REQUIRE(MipGenerator::get_mip_levels(1, 1024) == 11);
+}
+
+TEST_CASE("Mip generator - levels match the reference filter", "[mip_generator]")
+{
+  std::mt19937 rng(7);
+
+  SECTION("UNORM")
+  {
+    auto pixels = random_image(64, 32, rng);
+    auto chain  = MipGenerator::generate(pixels.data(), 64, 32);
+    REQUIRE(chain.m_levels.size() == 7);
+    REQUIRE(chain.m_levels.back().m_width == 1);
+    REQUIRE(chain.m_levels.back().m_height == 1);
+    REQUIRE(std::equal(pixels.begin(), pixels.end(), chain.get_level_data(0)));
+    check_chain(chain, 0);
+  }
+
+  SECTION("sRGB")
+  {
+    auto pixels = random_image(64, 32, rng);
+    auto chain  = MipGenerator::generate(pixels.data(), 64, 32, true);
+    check_chain(chain, 1);
+  }
+
+  SECTION("Odd and non square sizes")
+  {
+    for (auto [width, height] : { std::pair{ 37u, 11u }, std::pair{ 1u, 9u }, std::pair{ 13u, 1u } })
+    {
+      auto pixels = random_image(width, height, rng);
+      check_chain(MipGenerator::generate(pixels.data(), width, height), 0);
+      check_chain(MipGenerator::generate(pixels.data(), width, height, true), 1);
+    }
+  }
+
+  SECTION("Limited number of levels")
+  {
+    auto pixels = random_image(16, 16, rng);
+    auto chain  = MipGenerator::generate(pixels.data(), 16, 16, false, 3);
+    REQUIRE(chain.m_levels.size() == 3);
+    REQUIRE(chain.m_data.size() == (16 * 16 + 8 * 8 + 4 * 4) * 4);
+  }
+}
+
+TEST_CASE("Mip generator - sRGB images are averaged in linear space", "[mip_generator]")
+{
+  // black and white checkerboard, its average is half of the light
+  std::vector<uint8_t> pixels(4 * 4 * 4);
+  for (uint32_t i = 0; i < 16; i++)
+  {
+    uint8_t value = ((i % 4) + (i / 4)) % 2 ? 255 : 0;
+    std::fill_n(pixels.begin() + i * 4, 3, value);
+    pixels[i * 4 + 3] = value;
+  }
+
+  auto srgb  = MipGenerator::generate(pixels.data(), 4, 4, true);
+  auto unorm = MipGenerator::generate(pixels.data(), 4, 4, false);
+
+  auto srgb_pixel  = srgb.get_level_data(2);
+  auto unorm_pixel = unorm.get_level_data(2);
+  REQUIRE(srgb_pixel[0] == 188);
+  REQUIRE(unorm_pixel[0] == 128);
+  // alpha isn't sRGB encoded
+  REQUIRE(srgb_pixel[3] == 128);
+}
+
+TEST_CASE("Mip generator - batch is generated in parallel", "[mip_generator]")
+{
+  auto job_system = JobSystem::create(3);
+  std::mt19937 rng(11);
+
+  std::vector<std::vector<uint8_t>> images;
+  std::vector<MipSource> sources;
+  for (uint32_t i = 0; i < 8; i++)
+  {
+    uint32_t size = 16u << (i % 4);
+    images.push_back(random_image(size, size / 2, rng));
+    sources.push_back({ images.back().data(), size, size / 2, i % 2 == 1 });
+  }
+
+  auto chains = MipGenerator::generate_batch(sources);
+  REQUIRE(chains.size() == sources.size());
+  for (uint32_t i = 0; i < chains.size(); i++)
+  {
+    auto serial = MipGenerator::generate(sources[i].m_pixels, sources[i].m_width, sources[i].m_height, i % 2 == 1);
+    REQUIRE(chains[i].m_data == serial.m_data);
+    check_chain(chains[i], i % 2 == 1 ? 1 : 0);
+  }
+
+  job_system->terminate();
+}
@@ -0,0 +1,117 @@
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "Core/RenderAPI/Work/EspPipelineCacheFile.hh"
+
+using namespace esp;
+
+namespace
+{
+  EspPipelineCacheIdentity make_identity()
+  {
+    EspPipelineCacheIdentity identity = { 0x10005, 0x1234, 42 };
+    for (uint8_t i = 0; i < identity.m_cache_uuid.size(); i++)
+    {
+      identity.m_cache_uuid[i] = i;
+    }
+    return identity;
+  }
+
+  std::vector<uint8_t> make_data()
+  {
+    std::vector<uint8_t> data(1000);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+      data[i] = static_cast<uint8_t>(i * 7);
+    }
+    return data;
+  }
+} // namespace
+
+TEST_CASE("Pipeline cache - serialization", "[pipeline_cache]")
+{
+  auto identity = make_identity();
+  auto data     = make_data();
+  auto file     = EspPipelineCacheFile::serialize(identity, data);
+
+  std::vector<uint8_t> result;
+
+  SECTION("Round trip")
+  {
+    REQUIRE(EspPipelineCacheFile::deserialize(file, identity, result) == EspPipelineCacheFile::OK);
+    REQUIRE(result == data);
+  }
+
+  SECTION("Different device")
+  {
+    auto other = identity;
+    other.m_device_id++;
+    REQUIRE(EspPipelineCacheFile::deserialize(file, other, result) == EspPipelineCacheFile::INCOMPATIBLE);
+  }
+
+  SECTION("Different driver")
+  {
+    auto other = identity;
+    other.m_driver_version++;
+    REQUIRE(EspPipelineCacheFile::deserialize(file, other, result) == EspPipelineCacheFile::INCOMPATIBLE);
+
+    other = identity;
+    other.m_cache_uuid[15]++;
+    REQUIRE(EspPipelineCacheFile::deserialize(file, other, result) == EspPipelineCacheFile::INCOMPATIBLE);
+  }
+
+  SECTION("Truncated file")
+  {
+    file.resize(file.size() - 1);
+    REQUIRE(EspPipelineCacheFile::deserialize(file, identity, result) == EspPipelineCacheFile::CORRUPTED);
+
+    file.resize(10);
+    REQUIRE(EspPipelineCacheFile::deserialize(file, identity, result) == EspPipelineCacheFile::CORRUPTED);
+  }
+
+  SECTION("Modified data")
+  {
+    file.back() ^= 1;
+    REQUIRE(EspPipelineCacheFile::deserialize(file, identity, result) == EspPipelineCacheFile::CORRUPTED);
+  }
+
+  SECTION("Not a pipeline cache")
+  {
+    file[0] = 'X';
+    REQUIRE(EspPipelineCacheFile::deserialize(file, identity, result) == EspPipelineCacheFile::CORRUPTED);
+  }
+
+  // data is untouched when the file is rejected
+  if (!result.empty()) { REQUIRE(result == data); }
+}
+
+TEST_CASE("Pipeline cache - save and load", "[pipeline_cache]")
+{
+  auto identity = make_identity();
+  auto data     = make_data();
+  fs::path path = fs::temp_directory_path() / "espert_pipeline_cache_test.bin";
+  fs::remove(path);
+
+  std::vector<uint8_t> result;
+  REQUIRE(EspPipelineCacheFile::load(path, identity, result) == EspPipelineCacheFile::MISSING);
+
+  REQUIRE(EspPipelineCacheFile::save(path, identity, data));
+  REQUIRE(!fs::exists(path.string() + ".tmp"));
+  REQUIRE(EspPipelineCacheFile::load(path, identity, result) == EspPipelineCacheFile::OK);
+  REQUIRE(result == data);
+
+  // saving replaces the previous file
+  data.resize(10);
+  REQUIRE(EspPipelineCacheFile::save(path, identity, data));
+  REQUIRE(EspPipelineCacheFile::load(path, identity, result) == EspPipelineCacheFile::OK);
+  REQUIRE(result == data);
+
+  // empty cache is valid
+  REQUIRE(EspPipelineCacheFile::save(path, identity, {}));
+  REQUIRE(EspPipelineCacheFile::load(path, identity, result) == EspPipelineCacheFile::OK);
+  REQUIRE(result.empty());
+
+  fs::remove(path);
+}
@@ -0,0 +1,122 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include "Core/RenderAPI/Worker/EspPipelineCompiler.hh"
+
+using namespace esp;
+
+namespace
+{
+  struct FakeDevice
+  {
+    std::atomic<uint32_t> m_created   = 0;
+    std::atomic<uint32_t> m_destroyed = 0;
+
+    EspPipelineCreateFunction create(uint64_t value)
+    {
+      return [this, value]()
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        m_created++;
+        return value;
+      };
+    }
+
+    EspPipelineDestroyFunction destroy()
+    {
+      return [this](uint64_t) { m_destroyed++; };
+    }
+  };
+} // namespace
+
+TEST_CASE("Pipeline compiler - compiles without compiler", "[pipeline_compiler]")
+{
+  FakeDevice device;
+  {
+    auto first  = EspPipelineCompiler::compile(1, device.create(10), device.destroy());
+    auto second = EspPipelineCompiler::compile(1, device.create(10), device.destroy());
+
+    // pipelines are created immediately and aren't shared
+    REQUIRE(first->is_ready());
+    REQUIRE(first != second);
+    REQUIRE(first->get() == 10);
+    REQUIRE(device.m_created == 2);
+  }
+  REQUIRE(device.m_destroyed == 2);
+}
+
+TEST_CASE("Pipeline compiler - identical states share pipeline", "[pipeline_compiler]")
+{
+  auto job_system        = JobSystem::create(3);
+  auto pipeline_compiler = EspPipelineCompiler::create();
+
+  FakeDevice device;
+  {
+    std::vector<std::shared_ptr<EspPipelineHandle>> handles;
+    for (uint64_t i = 0; i < 64; i++)
+    {
+      handles.push_back(EspPipelineCompiler::compile(i % 8, device.create(100 + i % 8), device.destroy()));
+    }
+
+    for (uint64_t i = 0; i < handles.size(); i++)
+    {
+      REQUIRE(handles[i]->get() == 100 + i % 8);
+      REQUIRE(handles[i] == handles[i % 8]);
+    }
+    REQUIRE(device.m_created == 8);
+
+    auto stats = EspPipelineCompiler::get_stats();
+    REQUIRE(stats.m_requests == 64);
+    REQUIRE(stats.m_compiled == 8);
+    REQUIRE(stats.m_shared == 56);
+    REQUIRE(stats.m_tracked == 8);
+  }
+  REQUIRE(device.m_destroyed == 8);
+
+  // released pipeline is compiled again
+  auto handle = EspPipelineCompiler::compile(0, device.create(7), device.destroy());
+  REQUIRE(handle->get() == 7);
+  REQUIRE(device.m_created == 9);
+
+  // entries of released pipelines are erased
+  REQUIRE(EspPipelineCompiler::get_stats().m_tracked == 1);
+}
+
+TEST_CASE("Pipeline compiler - handle outlives compiler and releases during compilation", "[pipeline_compiler]")
+{
+  auto job_system = JobSystem::create(3);
+
+  FakeDevice device;
+  std::shared_ptr<EspPipelineHandle> handle;
+  {
+    auto pipeline_compiler = EspPipelineCompiler::create();
+    handle                 = EspPipelineCompiler::compile(1, device.create(1), device.destroy());
+
+    // nobody waits for this one, the job keeps it alive
+    EspPipelineCompiler::compile(2, device.create(2), device.destroy());
+  }
+
+  REQUIRE(handle->get() == 1);
+  job_system->terminate();
+  REQUIRE(device.m_created == 2);
+  REQUIRE(device.m_destroyed == 1);
+
+  handle.reset();
+  REQUIRE(device.m_destroyed == 2);
+}
+
+TEST_CASE("Pipeline compiler - errors are rethrown", "[pipeline_compiler]")
+{
+  auto job_system        = JobSystem::create(3);
+  auto pipeline_compiler = EspPipelineCompiler::create();
+
+  auto handle = EspPipelineCompiler::compile(
+      1,
+      []() -> uint64_t { throw std::runtime_error("failed to create graphics pipeline!"); },
+      [](uint64_t) {});
+
+  REQUIRE_THROWS_AS(handle->get(), std::runtime_error);
+  REQUIRE(handle->is_ready());
+}
@@ -0,0 +1,146 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "Core/Utils/Profiler.hh"
+
+using namespace esp;
+
+TEST_CASE("Profiler - zones of all threads are collected at the end of the frame", "[profiler]")
+{
+  auto profiler = Profiler::create();
+
+  {
+    ProfilerScope frame("frame");
+    {
+      ProfilerScope update("update");
+    }
+
+    std::thread worker(
+        []()
+        {
+          Profiler::set_thread_name("Worker");
+          ProfilerScope job("job");
+        });
+    worker.join();
+  }
+  Profiler::end_frame();
+
+  auto zones = Profiler::get_frame_zones();
+  REQUIRE(zones.size() == 3);
+
+  // sorted by their beginning
+  REQUIRE(std::string(zones[0].m_name) == "frame");
+  REQUIRE(zones[0].m_depth == 0);
+  REQUIRE(std::string(zones[1].m_name) == "update");
+  REQUIRE(zones[1].m_depth == 1);
+  REQUIRE(zones[1].m_thread == zones[0].m_thread);
+  REQUIRE(zones[1].m_begin >= zones[0].m_begin);
+  REQUIRE(zones[1].m_end <= zones[0].m_end);
+  REQUIRE(std::string(zones[2].m_name) == "job");
+  REQUIRE(zones[2].m_thread != zones[0].m_thread);
+
+  // collected zones aren't collected again
+  Profiler::end_frame();
+  REQUIRE(Profiler::get_frame_zones().empty());
+  REQUIRE(Profiler::get_frame_time_histogram().m_frame_count == 1);
+
+  profiler->terminate();
+  REQUIRE(Profiler::get_frame_zones().empty());
+}
+
+TEST_CASE("Profiler - zones aren't measured without instance and overflowing zones are dropped", "[profiler]")
+{
+  // zone begun before the profiler exists isn't measured, even if it ends afterwards
+  Profiler::begin_zone("before");
+  auto profiler = Profiler::create();
+  Profiler::end_zone();
+
+  for (uint32_t i = 0; i < Profiler::RING_CAPACITY + 10; i++)
+  {
+    ProfilerScope zone("zone");
+  }
+  Profiler::end_frame();
+  auto zones = Profiler::get_frame_zones();
+  REQUIRE(zones.size() == Profiler::RING_CAPACITY);
+  REQUIRE(std::all_of(zones.begin(), zones.end(), [](auto& zone) { return std::string(zone.m_name) == "zone"; }));
+
+  // zones deeper than the limit aren't measured, the others still are
+  for (uint32_t i = 0; i < Profiler::MAX_DEPTH + 2; i++)
+  {
+    Profiler::begin_zone("nested");
+  }
+  for (uint32_t i = 0; i < Profiler::MAX_DEPTH + 2; i++)
+  {
+    Profiler::end_zone();
+  }
+  Profiler::end_frame();
+  REQUIRE(Profiler::get_frame_zones().size() == Profiler::MAX_DEPTH);
+
+  profiler->terminate();
+}
+
+TEST_CASE("Profiler - frame time histogram", "[profiler]")
+{
+  FrameTimeHistogram histogram;
+  REQUIRE(histogram.get_percentile(0.5) == 0.0);
+  REQUIRE(histogram.get_mean() == 0.0);
+
+  for (uint32_t i = 0; i < 98; i++)
+  {
+    histogram.add(16.2);
+  }
+  histogram.add(33.1);
+  histogram.add(250.0);
+
+  REQUIRE(histogram.m_frame_count == 100);
+  REQUIRE(histogram.m_min == 16.2);
+  REQUIRE(histogram.m_max == 250.0);
+  REQUIRE(histogram.m_buckets[32] == 98);
+  REQUIRE(histogram.m_buckets[66] == 1);
+  REQUIRE(histogram.m_buckets.back() == 1);
+
+  REQUIRE(histogram.get_percentile(0.5) == 16.5);
+  REQUIRE(histogram.get_percentile(0.98) == 16.5);
+  REQUIRE(histogram.get_percentile(0.99) == 33.5);
+  REQUIRE(histogram.get_percentile(1.0) == 250.0);
+}
+
+TEST_CASE("Profiler - trace and histogram files", "[profiler]")
+{
+  auto trace_path     = fs::temp_directory_path() / "espert_profiler_test.json";
+  auto histogram_path = fs::temp_directory_path() / "espert_profiler_test.csv";
+  {
+    auto profiler = Profiler::create(trace_path, histogram_path);
+    Profiler::set_thread_name("Main \"thread\"");
+    {
+      ProfilerScope zone("zone");
+    }
+    Profiler::end_frame();
+    Profiler::end_frame();
+    profiler->terminate();
+  }
+
+  std::ifstream trace_file(trace_path);
+  std::stringstream trace;
+  trace << trace_file.rdbuf();
+  auto text = trace.str();
+
+  REQUIRE(text.rfind("{\"traceEvents\":[", 0) == 0);
+  REQUIRE(text.find("\"name\":\"Main \\\"thread\\\"\"") != std::string::npos);
+  REQUIRE(text.find("\"name\":\"zone\",\"ph\":\"X\"") != std::string::npos);
+  REQUIRE(text.find("\n]}") != std::string::npos);
+
+  std::ifstream histogram_file(histogram_path);
+  std::string header;
+  std::getline(histogram_file, header);
+  REQUIRE(header == "begin_ms,end_ms,frames");
+  std::string row;
+  REQUIRE(std::getline(histogram_file, row));
+
+  fs::remove(trace_path);
+  fs::remove(histogram_path);
+}
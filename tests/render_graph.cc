@@ -0,0 +1,262 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+
+#include "Core/RenderAPI/RenderPlans/EspRenderGraph.hh"
+
+using namespace esp;
+
+namespace
+{
+  // commands recorded by the graph, in order
+  std::vector<std::string> s_commands;
+
+  class MockBlock : public EspBlock
+  {
+   public:
+    MockBlock(uint32_t width, uint32_t height) :
+        EspBlock(EspBlockFormat::ESP_FORMAT_R8G8B8A8_UNORM,
+                 EspSampleCountFlag::ESP_SAMPLE_COUNT_1_BIT,
+                 width,
+                 height,
+                 { 0.f, 0.f, 0.f })
+    {
+    }
+
+    std::shared_ptr<EspTexture> use_as_texture() const override { return nullptr; }
+  };
+
+  class MockDepthBlock : public EspDepthBlock
+  {
+   public:
+    MockDepthBlock(uint32_t width, uint32_t height) :
+        EspDepthBlock(EspDepthBlockFormat::ESP_FORMAT_D32_SFLOAT,
+                      EspSampleCountFlag::ESP_SAMPLE_COUNT_1_BIT,
+                      EspImageUsageFlag::ESP_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+                      width,
+                      height)
+    {
+    }
+
+    void clear() override {}
+  };
+
+  class MockRenderPlan : public EspRenderPlan
+  {
+   public:
+    std::vector<std::shared_ptr<EspBlock>> m_blocks;
+    std::shared_ptr<EspDepthBlock> m_depth_block;
+
+    void add_block(std::shared_ptr<EspBlock> block) override { m_blocks.push_back(block); }
+    void add_depth_block(std::shared_ptr<EspDepthBlock> depth_block) override { m_depth_block = depth_block; }
+
+    void set_command_buffer(EspCommandBufferId* id) override {}
+    void build() override { REQUIRE(m_external_barriers); }
+
+    void begin_plan() override { s_commands.push_back("begin " + m_name); }
+    void end_plan() override { s_commands.push_back("end " + m_name); }
+
+    EspCommandBufferId* begin_secondary() override { return nullptr; }
+    void execute_secondaries(const std::vector<EspCommandBufferId*>& ids) override {}
+
+    const std::vector<bool>& get_load_blocks() const { return m_load_blocks; }
+    bool get_load_depth_block() const { return m_load_depth_block; }
+  };
+
+  // 4 bytes per pixel, depth blocks are placed in other memory than color blocks
+  class MockRenderGraph : public EspRenderGraph
+  {
+   public:
+    std::vector<MockRenderPlan*> m_plans;
+
+   protected:
+    std::unique_ptr<EspRenderPlan> create_plan() override
+    {
+      auto plan = std::make_unique<MockRenderPlan>();
+      m_plans.push_back(plan.get());
+      return plan;
+    }
+    EspTransientRequirements create_transient(EspRenderGraphResource resource,
+                                              const EspTransientBlockDesc& desc) override
+    {
+      return { uint64_t{ desc.m_width } * desc.m_height * 4, 256, desc.m_depth ? 2u : 1u };
+    }
+    void bind_transients(const std::vector<EspTransientHeap>& heaps) override
+    {
+      for (auto& resource : m_resources)
+      {
+        if (!resource.m_transient || resource.m_first_step < 0) { continue; }
+
+        REQUIRE(resource.m_offset % 256 == 0);
+        REQUIRE(resource.m_offset + resource.m_requirements.m_size <= heaps[resource.m_heap].m_size);
+        if (resource.m_desc.m_depth)
+        {
+          resource.m_depth_block = std::make_shared<MockDepthBlock>(resource.m_desc.m_width, resource.m_desc.m_height);
+        }
+        else { resource.m_block = std::make_shared<MockBlock>(resource.m_desc.m_width, resource.m_desc.m_height); }
+      }
+    }
+    void record_barriers(const std::vector<EspRenderGraphBarrier>& barriers) override
+    {
+      s_commands.push_back("barriers " + std::to_string(barriers.size()));
+    }
+  };
+
+  std::function<void(EspRenderPlan*)> record(const std::string& name)
+  {
+    return [name](EspRenderPlan*) { s_commands.push_back("record " + name); };
+  }
+} // namespace
+
+TEST_CASE("Render graph - passes nothing uses are culled", "[render_graph]")
+{
+  MockRenderGraph graph;
+  auto output = graph.import_block(std::make_shared<MockBlock>(64, 64));
+  auto unused = graph.create_block(EspBlockFormat::ESP_FORMAT_R8G8B8A8_UNORM, 64, 64);
+  auto shadow = graph.create_depth_block(EspDepthBlockFormat::ESP_FORMAT_D32_SFLOAT, 64, 64);
+
+  graph.add_pass("shadows", record("shadows")).write_depth(shadow);
+  graph.add_pass("debug", record("debug")).write(unused);
+  graph.add_pass("main", record("main")).read(shadow).write(output);
+  graph.add_pass("screenshot", record("screenshot")).read_transfer(output).set_side_effects();
+  graph.compile();
+
+  REQUIRE(graph.get_executed_passes() == std::vector<std::string>{ "shadows", "main", "screenshot" });
+  REQUIRE(graph.get_stats().m_culled_passes == 1);
+  REQUIRE(graph.get_block(unused) == nullptr);
+  REQUIRE(graph.get_depth_block(shadow) != nullptr);
+
+  s_commands.clear();
+  graph.execute();
+  REQUIRE(s_commands == std::vector<std::string>{ "barriers 1",
+                                                  "begin shadows",
+                                                  "record shadows",
+                                                  "end shadows",
+                                                  "barriers 2",
+                                                  "begin main",
+                                                  "record main",
+                                                  "end main",
+                                                  "barriers 1",
+                                                  "record screenshot",
+                                                  "barriers 1" });
+}
+
+TEST_CASE("Render graph - barriers are recorded only when needed", "[render_graph]")
+{
+  MockRenderGraph graph;
+  auto output  = graph.import_block(std::make_shared<MockBlock>(64, 64));
+  auto fog     = graph.import_block(std::make_shared<MockBlock>(64, 64));
+  auto depth   = graph.import_depth_block(std::make_shared<MockDepthBlock>(64, 64));
+  auto gbuffer = graph.create_block(EspBlockFormat::ESP_FORMAT_R16G16B16A16_SFLOAT, 64, 64);
+
+  graph.add_pass("geometry", record("geometry")).write(gbuffer).write_depth(depth);
+  graph.add_pass("decals", record("decals")).write(gbuffer).write_depth(depth);
+  graph.add_pass("lighting", record("lighting")).read(gbuffer).write(output);
+  graph.add_pass("fog", record("fog")).read(gbuffer).read(output).write(fog);
+  graph.add_pass("post", record("post")).read(gbuffer).write(output);
+  graph.compile();
+
+  SECTION("Transitions")
+  {
+    auto& geometry = graph.get_barriers(0);
+    REQUIRE(geometry.size() == 2);
+    REQUIRE(geometry[0].m_resource == gbuffer);
+    REQUIRE(geometry[0].m_src_access == EspRenderGraphAccess::ESP_ACCESS_NONE);
+    REQUIRE(geometry[0].m_discard);
+    REQUIRE(geometry[1].m_depth);
+
+    // writes wait for previous writes, but keep the contents
+    auto& decals = graph.get_barriers(1);
+    REQUIRE(decals.size() == 2);
+    REQUIRE(decals[0].m_src_access == EspRenderGraphAccess::ESP_ACCESS_COLOR_ATTACHMENT);
+    REQUIRE_FALSE(decals[0].m_discard);
+
+    // the G-buffer is sampled by the three last passes, but transitioned once
+    REQUIRE(graph.get_barriers(2).size() == 2);
+    REQUIRE(graph.get_barriers(3).size() == 2);
+    REQUIRE(graph.get_barriers(3)[0].m_resource == output);
+    REQUIRE(graph.get_barriers(4).size() == 1);
+
+    // imported depth block is left as the last pass used it
+    auto& final_barriers = graph.get_final_barriers();
+    REQUIRE(final_barriers.size() == 2);
+    REQUIRE(final_barriers[0].m_resource == output);
+    REQUIRE(final_barriers[0].m_dst_access == EspRenderGraphAccess::ESP_ACCESS_SHADER_READ);
+  }
+
+  SECTION("Statistics")
+  {
+    auto& stats = graph.get_stats();
+    REQUIRE(stats.m_barriers == 11);
+    REQUIRE(stats.m_barrier_batches == 6);
+    REQUIRE(stats.m_plan_barriers == 18);
+    REQUIRE(stats.m_barriers < stats.m_plan_barriers);
+  }
+
+  SECTION("Attachments written before are loaded")
+  {
+    auto& plans = graph.m_plans;
+    REQUIRE(plans.size() == 5);
+    REQUIRE(plans[0]->get_name() == "geometry");
+    REQUIRE(plans[0]->get_load_blocks() == std::vector<bool>{ false });
+    REQUIRE_FALSE(plans[0]->get_load_depth_block());
+    REQUIRE(plans[1]->get_load_blocks() == std::vector<bool>{ true });
+    REQUIRE(plans[1]->get_load_depth_block());
+    REQUIRE(plans[2]->get_load_blocks() == std::vector<bool>{ false });
+    REQUIRE(plans[4]->get_load_blocks() == std::vector<bool>{ true });
+    REQUIRE(plans[4]->m_blocks[0] == graph.get_block(output));
+  }
+}
+
+TEST_CASE("Render graph - transient blocks not used at the same time share memory", "[render_graph]")
+{
+  MockRenderGraph graph;
+  auto output = graph.import_block(std::make_shared<MockBlock>(256, 256));
+  auto scene  = graph.create_block(EspBlockFormat::ESP_FORMAT_R16G16B16A16_SFLOAT, 256, 256);
+  auto depth  = graph.create_depth_block(EspDepthBlockFormat::ESP_FORMAT_D32_SFLOAT, 256, 256);
+  auto half   = graph.create_block(EspBlockFormat::ESP_FORMAT_R16G16B16A16_SFLOAT, 128, 128);
+  auto blur   = graph.create_block(EspBlockFormat::ESP_FORMAT_R16G16B16A16_SFLOAT, 128, 128);
+  auto bloom  = graph.create_block(EspBlockFormat::ESP_FORMAT_R16G16B16A16_SFLOAT, 256, 256);
+
+  graph.add_pass("scene", record("scene")).write(scene).write_depth(depth);
+  graph.add_pass("downsample", record("downsample")).read(scene).write(half);
+  graph.add_pass("blur", record("blur")).read(half).write(blur);
+  graph.add_pass("upsample", record("upsample")).read(blur).write(bloom);
+  graph.add_pass("composite", record("composite")).read(bloom).write(output);
+  graph.compile();
+
+  // bloom takes the memory of scene, half and blur are used at once after it, depth blocks have their own heap
+  auto& stats = graph.get_stats();
+  REQUIRE(stats.m_transient_blocks == 5);
+  REQUIRE(stats.m_unaliased_transient_memory == 3 * 262144 + 2 * 65536);
+  REQUIRE(stats.m_transient_memory == 262144 + 2 * 65536 + 262144);
+  REQUIRE(graph.get_heaps().size() == 2);
+  REQUIRE(graph.get_block(bloom) != nullptr);
+}
+
+TEST_CASE("Render graph - invalid passes are rejected", "[render_graph]")
+{
+  MockRenderGraph graph;
+  auto output = graph.import_block(std::make_shared<MockBlock>(64, 64));
+  auto color  = graph.create_block(EspBlockFormat::ESP_FORMAT_R8G8B8A8_UNORM, 64, 64);
+
+  SECTION("Reading a block nothing wrote")
+  {
+    graph.add_pass("main", record("main")).read(color).write(output);
+    REQUIRE_THROWS(graph.compile());
+  }
+
+  SECTION("Reading and writing a block at once")
+  {
+    auto history =
+        graph.import_block(std::make_shared<MockBlock>(64, 64), EspRenderGraphAccess::ESP_ACCESS_SHADER_READ);
+    graph.add_pass("main", record("main")).read(history).write(history);
+    REQUIRE_THROWS(graph.compile());
+  }
+
+  SECTION("Color block as the depth attachment")
+  {
+    graph.add_pass("main", record("main")).write_depth(output);
+    REQUIRE_THROWS(graph.compile());
+  }
+}
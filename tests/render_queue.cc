@@ -0,0 +1,304 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+
+#include "Core/Renderer/RenderQueue.hh"
+
+using namespace esp;
+
+namespace
+{
+  // Records emitted commands instead of sending them to EspJob. The queue only compares the handles it gets,
+  // so the tests can use fake addresses that are never dereferenced.
+  class MockCommandSink : public RenderQueueCommandSink
+  {
+   public:
+    std::vector<std::string> m_commands;
+    std::vector<const void*> m_handles;
+    uint32_t m_begin_calls = 0;
+    uint32_t m_end_calls   = 0;
+
+    void begin() override { m_begin_calls++; }
+    void end() override { m_end_calls++; }
+    void bind_shader(EspShader& shader) override { record("shader", &shader); }
+    void bind_geometry(Model& model) override { record("geometry", &model); }
+    void bind_uniforms(const EspUniformManager& manager) override { record("uniforms", &manager); }
+    void bind_uniforms(const EspUniformManager& manager, uint32_t dynamic_offset) override
+    {
+      record("uniforms " + std::to_string(dynamic_offset), &manager);
+    }
+    void push_uniform(const EspUniformManager& manager, void* data) override { record("push", data); }
+    void push_material(const EspUniformManager& manager, uint32_t material_index) override
+    {
+      record("material " + std::to_string(material_index), &manager);
+    }
+    void draw_indexed(uint32_t index_count, uint32_t first_index) override
+    {
+      record("draw " + std::to_string(first_index), nullptr);
+    }
+
+   private:
+    void record(const std::string& command, const void* handle)
+    {
+      m_commands.push_back(command);
+      m_handles.push_back(handle);
+    }
+  };
+
+  char g_handles[16];
+
+  template<typename T> T* fake(int i) { return reinterpret_cast<T*>(&g_handles[i]); }
+
+  RenderQueueItem make_item(int shader, int material, float depth, uint32_t first_index)
+  {
+    RenderQueueItem item    = {};
+    item.m_depth            = depth;
+    item.m_shader           = fake<EspShader>(shader);
+    item.m_model            = fake<Model>(8);
+    item.m_uniform_manager  = fake<EspUniformManager>(9);
+    item.m_material         = fake<Material>(material);
+    item.m_material_manager = fake<EspUniformManager>(material);
+    item.m_index_count      = 3;
+    item.m_first_index      = first_index;
+    return item;
+  }
+} // namespace
+
+TEST_CASE("Render queue - sort key", "[render_queue]")
+{
+  auto near_key = RenderQueue::make_sort_key(0, 1, 1, 1.f);
+  auto far_key  = RenderQueue::make_sort_key(0, 1, 1, 100.f);
+  REQUIRE(near_key < far_key);
+  REQUIRE(RenderQueue::make_sort_key(0, 1, 2, 0.f) > far_key);
+  REQUIRE(RenderQueue::make_sort_key(0, 2, 0, 0.f) > RenderQueue::make_sort_key(0, 1, 0xffff, 1e30f));
+  REQUIRE(RenderQueue::make_sort_key(1, 0, 0, 0.f) > RenderQueue::make_sort_key(0, 0xffff, 0xffff, 1e30f));
+  REQUIRE(RenderQueue::make_sort_key(0, 0, 0, -5.f) == 0);
+}
+
+TEST_CASE("Render queue - state changes", "[render_queue]")
+{
+  RenderQueue queue;
+  MockCommandSink sink;
+
+  queue.begin();
+  queue.submit(make_item(0, 4, 5.f, 0));
+  queue.submit(make_item(1, 5, 1.f, 10));
+  queue.submit(make_item(0, 4, 1.f, 20));
+  queue.submit(make_item(1, 4, 2.f, 30));
+  queue.submit(make_item(0, 5, 3.f, 40));
+  queue.flush(sink);
+
+  // draws grouped by shader (submission order of shaders), then by material, then front to back
+  std::vector<std::string> expected = { "shader",   "geometry", "uniforms", "uniforms", "draw 20", "draw 0",
+                                        "uniforms", "draw 40",  "shader",   "uniforms", "uniforms", "draw 30",
+                                        "uniforms", "draw 10" };
+  REQUIRE(sink.m_commands == expected);
+
+  auto& stats = queue.get_stats();
+  REQUIRE(stats.m_draw_calls == 5);
+  REQUIRE(stats.m_shader_binds == 2);
+  REQUIRE(stats.m_geometry_binds == 1);
+  REQUIRE(stats.m_uniform_binds == 2);
+  REQUIRE(stats.m_material_binds == 4);
+  REQUIRE(stats.m_push_updates == 0);
+
+  SECTION("Queue is reusable")
+  {
+    MockCommandSink second_sink;
+    queue.begin();
+    queue.submit(make_item(2, 6, 1.f, 50));
+    queue.flush(second_sink);
+
+    REQUIRE(second_sink.m_commands ==
+            std::vector<std::string>{ "shader", "geometry", "uniforms", "uniforms", "draw 50" });
+    REQUIRE(queue.get_stats().m_draw_calls == 1);
+  }
+}
+
+TEST_CASE("Render queue - bindless materials", "[render_queue]")
+{
+  RenderQueue queue;
+  MockCommandSink sink;
+
+  // bindless shaders share one material manager and get index of the material pushed
+  auto make_bindless_item = [](int shader, float depth, uint32_t first_index)
+  {
+    auto item               = make_item(shader, 4, depth, first_index);
+    item.m_material_manager = fake<EspUniformManager>(10);
+    item.m_material_index   = 7;
+    return item;
+  };
+
+  queue.begin();
+  queue.submit(make_bindless_item(0, 1.f, 0));
+  queue.submit(make_bindless_item(0, 2.f, 10));
+  queue.submit(make_bindless_item(1, 1.f, 20));
+  queue.flush(sink);
+
+  // index is pushed again after the shader changes
+  std::vector<std::string> expected = { "shader",  "geometry", "uniforms", "uniforms", "material 7", "draw 0",
+                                        "draw 10", "shader",   "uniforms", "uniforms", "material 7", "draw 20" };
+  REQUIRE(sink.m_commands == expected);
+
+  auto& stats = queue.get_stats();
+  REQUIRE(stats.m_material_pushes == 2);
+  REQUIRE(stats.m_material_binds == 2);
+}
+
+TEST_CASE("Render queue - radix sort is stable", "[render_queue]")
+{
+  RenderQueue queue;
+  MockCommandSink sink;
+
+  queue.begin();
+  for (uint32_t i = 0; i < 1000; i++)
+  {
+    queue.submit(make_item(i % 3, 4 + (i % 2), static_cast<float>(i % 7), i));
+  }
+  queue.flush(sink);
+
+  uint64_t last_key   = 0;
+  uint32_t last_index = 0;
+  for (size_t i = 0; i < sink.m_commands.size(); i++)
+  {
+    if (sink.m_commands[i].rfind("draw ", 0) != 0) { continue; }
+
+    uint32_t index = std::stoul(sink.m_commands[i].substr(5));
+    uint64_t key   = RenderQueue::make_sort_key(0, index % 3, index % 2, static_cast<float>(index % 7));
+    REQUIRE(key >= last_key);
+    if (key == last_key) { REQUIRE(index >= last_index); }
+
+    last_key   = key;
+    last_index = index;
+  }
+  REQUIRE(queue.get_stats().m_draw_calls == 1000);
+  REQUIRE(queue.get_stats().m_shader_binds == 3);
+}
+
+TEST_CASE("Render queue - parallel flush", "[render_queue]")
+{
+  RenderQueue queue;
+  MockCommandSink sink;
+
+  queue.begin();
+  for (uint32_t i = 0; i < 1000; i++)
+  {
+    queue.submit(make_item(i % 3, 4 + (i % 2), static_cast<float>(i % 7), i));
+  }
+  queue.flush(sink);
+  auto single_stats = queue.get_stats();
+
+  std::vector<std::string> expected_draws;
+  for (auto& command : sink.m_commands)
+  {
+    if (command.rfind("draw ", 0) == 0) { expected_draws.push_back(command); }
+  }
+
+  std::vector<MockCommandSink> sinks(4);
+  std::vector<RenderQueueCommandSink*> sink_ptrs;
+  for (auto& range_sink : sinks)
+  {
+    sink_ptrs.push_back(&range_sink);
+  }
+  queue.flush(sink_ptrs);
+
+  // ranges keep the sorted order and every range binds its whole state again
+  std::vector<std::string> draws;
+  for (auto& range_sink : sinks)
+  {
+    REQUIRE(range_sink.m_begin_calls == 1);
+    REQUIRE(range_sink.m_end_calls == 1);
+    REQUIRE(range_sink.m_commands.front() == "shader");
+    for (auto& command : range_sink.m_commands)
+    {
+      if (command.rfind("draw ", 0) == 0) { draws.push_back(command); }
+    }
+  }
+  REQUIRE(draws == expected_draws);
+
+  auto& stats = queue.get_stats();
+  REQUIRE(stats.m_draw_calls == 1000);
+  REQUIRE(stats.m_shader_binds >= single_stats.m_shader_binds);
+  REQUIRE(stats.m_shader_binds <= single_stats.m_shader_binds + 3);
+}
+
+TEST_CASE("Render queue - dynamic offsets of a shared uniform manager", "[render_queue]")
+{
+  RenderQueue queue;
+  MockCommandSink sink;
+
+  // offsets are written when the draws are submitted, but bound when they are recorded
+  queue.begin();
+  auto first              = make_item(0, 4, 1.f, 0);
+  first.m_dynamic_offset  = 256;
+  auto second             = make_item(0, 4, 2.f, 3);
+  second.m_dynamic_offset = 512;
+  auto third              = make_item(0, 4, 3.f, 6);
+  third.m_dynamic_offset  = 512;
+  queue.submit(third);
+  queue.submit(first);
+  queue.submit(second);
+  queue.flush(sink);
+
+  REQUIRE(sink.m_commands == std::vector<std::string>{ "shader",
+                                                       "geometry",
+                                                       "uniforms 256",
+                                                       "uniforms",
+                                                       "draw 0",
+                                                       "uniforms 512",
+                                                       "draw 3",
+                                                       "draw 6" });
+  REQUIRE(queue.get_stats().m_uniform_binds == 2);
+}
+
+TEST_CASE("Render queue - shaders sharing a pipeline layout", "[render_queue]")
+{
+  RenderQueue queue;
+  MockCommandSink sink;
+
+  int push           = 0;
+  auto first         = make_item(0, 4, 1.f, 0);
+  auto second        = make_item(1, 4, 1.f, 10);
+  first.m_push_data  = &push;
+  second.m_push_data = &push;
+
+  SECTION("Sets and push constants stay bound")
+  {
+    first.m_layout  = fake<void>(12);
+    second.m_layout = fake<void>(12);
+
+    queue.begin();
+    queue.submit(first);
+    queue.submit(second);
+    queue.flush(sink);
+
+    // the second shader only switches the pipeline
+    REQUIRE(sink.m_commands == std::vector<std::string>{ "shader",
+                                                         "geometry",
+                                                         "uniforms",
+                                                         "push",
+                                                         "uniforms",
+                                                         "draw 0",
+                                                         "shader",
+                                                         "draw 10" });
+    REQUIRE(queue.get_stats().m_shader_binds == 2);
+    REQUIRE(queue.get_stats().m_uniform_binds == 1);
+    REQUIRE(queue.get_stats().m_material_binds == 1);
+    REQUIRE(queue.get_stats().m_push_updates == 1);
+  }
+
+  SECTION("Different layouts bind everything again")
+  {
+    first.m_layout  = fake<void>(12);
+    second.m_layout = fake<void>(13);
+
+    queue.begin();
+    queue.submit(first);
+    queue.submit(second);
+    queue.flush(sink);
+
+    REQUIRE(queue.get_stats().m_uniform_binds == 2);
+    REQUIRE(queue.get_stats().m_material_binds == 2);
+    REQUIRE(queue.get_stats().m_push_updates == 2);
+  }
+}
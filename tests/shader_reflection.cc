@@ -0,0 +1,312 @@
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "Core/RenderAPI/Worker/EspWorkerBuilder.hh"
+#include "Core/Resources/SpirvReflection.hh"
+
+using namespace esp;
+
+namespace
+{
+  std::vector<uint32_t> read_spirv(const std::string& name)
+  {
+    fs::path path = fs::current_path() / ".." / "tests" / "assets" / "Shaders" / name;
+    std::ifstream file(path, std::ios::binary);
+    REQUIRE(file.good());
+
+    std::vector<uint32_t> code(fs::file_size(path) / 4);
+    file.read(reinterpret_cast<char*>(code.data()), code.size() * 4);
+    return code;
+  }
+
+  /* Minimal module with push constant block { mat4; vec4; } and an array of 4 samplers at set 0, binding 0. */
+  std::vector<uint32_t> make_push_constant_spirv()
+  {
+    std::vector<uint32_t> code = { 0x07230203, 0x00010000, 0, 20, 0 };
+    auto op = [&code](uint32_t opcode, std::vector<uint32_t> operands)
+    {
+      code.push_back((static_cast<uint32_t>(operands.size() + 1) << 16) | opcode);
+      code.insert(code.end(), operands.begin(), operands.end());
+    };
+
+    op(72, { 6, 0, 35, 0 });            // OpMemberDecorate %push 0 Offset 0
+    op(72, { 6, 0, 7, 16 });            // OpMemberDecorate %push 0 MatrixStride 16
+    op(72, { 6, 1, 35, 64 });           // OpMemberDecorate %push 1 Offset 64
+    op(71, { 6, 2 });                   // OpDecorate %push Block
+    op(71, { 14, 34, 0 });              // OpDecorate %textures DescriptorSet 0
+    op(71, { 14, 33, 0 });              // OpDecorate %textures Binding 0
+    op(22, { 2, 32 });                  // %float = OpTypeFloat 32
+    op(23, { 3, 2, 4 });                // %vec4 = OpTypeVector %float 4
+    op(24, { 4, 3, 4 });                // %mat4 = OpTypeMatrix %vec4 4
+    op(30, { 6, 4, 3 });                // %push = OpTypeStruct %mat4 %vec4
+    op(32, { 7, 9, 6 });                // %ptr = OpTypePointer PushConstant %push
+    op(59, { 7, 8, 9 });                // %var = OpVariable %ptr PushConstant
+    op(25, { 9, 2, 1, 0, 0, 0, 1, 0 }); // %image = OpTypeImage %float 2D
+    op(27, { 10, 9 });                  // %sampled = OpTypeSampledImage %image
+    op(21, { 11, 32, 0 });              // %uint = OpTypeInt 32 0
+    op(43, { 11, 12, 4 });              // %four = OpConstant %uint 4
+    op(28, { 13, 10, 12 });             // %array = OpTypeArray %sampled %four
+    op(32, { 15, 0, 13 });              // %array_ptr = OpTypePointer UniformConstant %array
+    op(59, { 15, 14, 0 });              // %textures = OpVariable %array_ptr UniformConstant
+
+    return code;
+  }
+
+  /* Minimal module with a sampler at set 0, binding 0 and bindless set 1 with an unsized array of samplers at binding
+     0 and a storage buffer of uints at binding 1. */
+  std::vector<uint32_t> make_bindless_spirv()
+  {
+    std::vector<uint32_t> code = { 0x07230203, 0x00010000, 0, 30, 0 };
+    auto op = [&code](uint32_t opcode, std::vector<uint32_t> operands)
+    {
+      code.push_back((static_cast<uint32_t>(operands.size() + 1) << 16) | opcode);
+      code.insert(code.end(), operands.begin(), operands.end());
+    };
+
+    op(71, { 22, 34, 1 });              // OpDecorate %textures DescriptorSet 1
+    op(71, { 22, 33, 0 });              // OpDecorate %textures Binding 0
+    op(71, { 24, 34, 0 });              // OpDecorate %sampler DescriptorSet 0
+    op(71, { 24, 33, 0 });              // OpDecorate %sampler Binding 0
+    op(72, { 26, 0, 35, 0 });           // OpMemberDecorate %materials 0 Offset 0
+    op(71, { 26, 2 });                  // OpDecorate %materials Block
+    op(71, { 28, 34, 1 });              // OpDecorate %material_buffer DescriptorSet 1
+    op(71, { 28, 33, 1 });              // OpDecorate %material_buffer Binding 1
+    op(22, { 2, 32 });                  // %float = OpTypeFloat 32
+    op(25, { 9, 2, 1, 0, 0, 0, 1, 0 }); // %image = OpTypeImage %float 2D
+    op(27, { 10, 9 });                  // %sampled = OpTypeSampledImage %image
+    op(21, { 11, 32, 0 });              // %uint = OpTypeInt 32 0
+    op(29, { 20, 10 });                 // %array = OpTypeRuntimeArray %sampled
+    op(32, { 21, 0, 20 });              // %array_ptr = OpTypePointer UniformConstant %array
+    op(59, { 21, 22, 0 });              // %textures = OpVariable %array_ptr UniformConstant
+    op(32, { 23, 0, 10 });              // %sampled_ptr = OpTypePointer UniformConstant %sampled
+    op(59, { 23, 24, 0 });              // %sampler = OpVariable %sampled_ptr UniformConstant
+    op(29, { 25, 11 });                 // %uints = OpTypeRuntimeArray %uint
+    op(30, { 26, 25 });                 // %materials = OpTypeStruct %uints
+    op(32, { 27, 12, 26 });             // %materials_ptr = OpTypePointer StorageBuffer %materials
+    op(59, { 27, 28, 12 });             // %material_buffer = OpVariable %materials_ptr StorageBuffer
+
+    return code;
+  }
+
+  /* Minimal module with a readonly storage buffer { vec4; } at set 0, binding 0, an old-style buffer block
+     { uint; uint[]; } at set 0, binding 1 and a storage image at set 0, binding 2. */
+  std::vector<uint32_t> make_storage_spirv()
+  {
+    std::vector<uint32_t> code = { 0x07230203, 0x00010000, 0, 20, 0 };
+    auto op = [&code](uint32_t opcode, std::vector<uint32_t> operands)
+    {
+      code.push_back((static_cast<uint32_t>(operands.size() + 1) << 16) | opcode);
+      code.insert(code.end(), operands.begin(), operands.end());
+    };
+
+    op(72, { 5, 0, 35, 0 });             // OpMemberDecorate %lights 0 Offset 0
+    op(72, { 5, 0, 24 });                // OpMemberDecorate %lights 0 NonWritable
+    op(71, { 5, 2 });                    // OpDecorate %lights Block
+    op(71, { 7, 34, 0 });                // OpDecorate %light_buffer DescriptorSet 0
+    op(71, { 7, 33, 0 });                // OpDecorate %light_buffer Binding 0
+    op(71, { 9, 6, 4 });                 // OpDecorate %uints ArrayStride 4
+    op(72, { 10, 0, 35, 0 });            // OpMemberDecorate %instances 0 Offset 0
+    op(72, { 10, 1, 35, 4 });            // OpMemberDecorate %instances 1 Offset 4
+    op(71, { 10, 3 });                   // OpDecorate %instances BufferBlock
+    op(71, { 12, 34, 0 });               // OpDecorate %instance_buffer DescriptorSet 0
+    op(71, { 12, 33, 1 });               // OpDecorate %instance_buffer Binding 1
+    op(71, { 15, 34, 0 });               // OpDecorate %output DescriptorSet 0
+    op(71, { 15, 33, 2 });               // OpDecorate %output Binding 2
+    op(22, { 2, 32 });                   // %float = OpTypeFloat 32
+    op(23, { 3, 2, 4 });                 // %vec4 = OpTypeVector %float 4
+    op(30, { 5, 3 });                    // %lights = OpTypeStruct %vec4
+    op(32, { 6, 12, 5 });                // %lights_ptr = OpTypePointer StorageBuffer %lights
+    op(59, { 6, 7, 12 });                // %light_buffer = OpVariable %lights_ptr StorageBuffer
+    op(21, { 8, 32, 0 });                // %uint = OpTypeInt 32 0
+    op(29, { 9, 8 });                    // %uints = OpTypeRuntimeArray %uint
+    op(30, { 10, 8, 9 });                // %instances = OpTypeStruct %uint %uints
+    op(32, { 11, 2, 10 });               // %instances_ptr = OpTypePointer Uniform %instances
+    op(59, { 11, 12, 2 });               // %instance_buffer = OpVariable %instances_ptr Uniform
+    op(25, { 13, 2, 1, 0, 0, 0, 2, 1 }); // %image = OpTypeImage %float 2D Rgba32f, without sampler
+    op(32, { 14, 0, 13 });               // %image_ptr = OpTypePointer UniformConstant %image
+    op(59, { 14, 15, 0 });               // %output = OpVariable %image_ptr UniformConstant
+
+    return code;
+  }
+
+  struct MockUniformMetaData : public EspUniformMetaData
+  {
+    std::vector<std::string> m_calls;
+
+    virtual EspUniformMetaData& establish_descriptor_set() override
+    {
+      m_calls.push_back("set");
+      return *this;
+    }
+
+    virtual EspUniformMetaData& establish_bindless_descriptor_set() override
+    {
+      m_calls.push_back("bindless");
+      return *this;
+    }
+
+    virtual EspUniformMetaData& add_buffer_uniform(EspUniformShaderStage stage,
+                                                   uint32_t size_of_data_chunk,
+                                                   uint32_t count_of_data_chunks) override
+    {
+      m_calls.push_back("buffer " + std::to_string((int)stage) + " " + std::to_string(size_of_data_chunk) + " " +
+                        std::to_string(count_of_data_chunks));
+      return *this;
+    }
+
+    virtual EspUniformMetaData& add_dynamic_buffer_uniform(EspUniformShaderStage stage,
+                                                           uint32_t size_of_data_chunk) override
+    {
+      m_calls.push_back("dynamic buffer " + std::to_string((int)stage) + " " + std::to_string(size_of_data_chunk));
+      return *this;
+    }
+
+    virtual EspUniformMetaData& add_texture_uniform(EspUniformShaderStage stage, uint32_t count_of_textures) override
+    {
+      m_calls.push_back("texture " + std::to_string((int)stage) + " " + std::to_string(count_of_textures));
+      return *this;
+    }
+
+    virtual EspUniformMetaData& add_storage_buffer_uniform(EspUniformShaderStage stage,
+                                                           uint32_t size_of_data_chunk,
+                                                           uint32_t count_of_data_chunks,
+                                                           EspStorageBufferAccess access) override
+    {
+      m_calls.push_back("storage buffer " + std::to_string((int)stage) + " " + std::to_string(size_of_data_chunk) +
+                        " " + std::to_string(count_of_data_chunks) + " " + std::to_string((int)access));
+      return *this;
+    }
+
+    virtual EspUniformMetaData& add_storage_image_uniform(EspUniformShaderStage stage,
+                                                          uint32_t count_of_images) override
+    {
+      m_calls.push_back("storage image " + std::to_string((int)stage) + " " + std::to_string(count_of_images));
+      return *this;
+    }
+
+    virtual EspUniformMetaData& add_push_uniform(EspUniformShaderStage stage, uint32_t offset, uint32_t size) override
+    {
+      m_calls.push_back("push " + std::to_string((int)stage) + " " + std::to_string(offset) + " " +
+                        std::to_string(size));
+      return *this;
+    }
+  };
+} // namespace
+
+TEST_CASE("Shader reflection - default shader", "[shader_reflection]")
+{
+  SpirvReflection reflection;
+  REQUIRE(reflection.add_stage(EspShaderStage::VERTEX, read_spirv("default.vert.spv")));
+  REQUIRE(reflection.add_stage(EspShaderStage::FRAGMENT, read_spirv("default.frag.spv")));
+
+  const auto& bindings = reflection.get_bindings();
+  REQUIRE(bindings.size() == 2);
+  REQUIRE(bindings[0].m_set == 0);
+  REQUIRE(bindings[0].m_binding == 0);
+  REQUIRE(bindings[0].m_type == EspUniformType::ESP_BUFFER_UNIFORM);
+  REQUIRE(bindings[0].m_size == 3 * 64);
+  REQUIRE(bindings[0].m_stages == static_cast<EspShaderStageFlags>(EspShaderStage::VERTEX));
+  REQUIRE(bindings[1].m_binding == 1);
+  REQUIRE(bindings[1].m_type == EspUniformType::ESP_TEXTURE);
+  REQUIRE(bindings[1].m_stages == static_cast<EspShaderStageFlags>(EspShaderStage::FRAGMENT));
+  REQUIRE(reflection.get_push_ranges().empty());
+
+  // built-in inputs and outputs aren't vertex inputs
+  const auto& inputs = reflection.get_vertex_inputs();
+  REQUIRE(inputs.size() == 4);
+  for (uint32_t i = 0; i < 3; i++)
+  {
+    REQUIRE(inputs[i].m_location == i);
+    REQUIRE(inputs[i].m_format == ESP_FORMAT_R32G32B32_SFLOAT);
+  }
+  REQUIRE(inputs[3].m_format == ESP_FORMAT_R32G32_SFLOAT);
+
+  MockUniformMetaData meta_data;
+  REQUIRE(reflection.fill_uniform_meta_data(meta_data));
+  REQUIRE(meta_data.m_calls == std::vector<std::string>{ "set", "buffer 0 192 1", "texture 1 1" });
+
+  auto layout = reflection.get_vertex_layout();
+  REQUIRE(layout.m_size == 44);
+  REQUIRE(layout.m_attrs.size() == 4);
+  REQUIRE(layout.m_attrs[3].m_offset == 36);
+  REQUIRE(reflection.is_compatible({ layout }));
+
+  layout.m_attrs[1].m_format = ESP_FORMAT_R32G32_SFLOAT;
+  REQUIRE(!reflection.is_compatible({ layout }));
+  layout.m_attrs.pop_back();
+  REQUIRE(!reflection.is_compatible({ layout }));
+}
+
+TEST_CASE("Shader reflection - push constants and descriptor arrays", "[shader_reflection]")
+{
+  auto code = make_push_constant_spirv();
+
+  SpirvReflection reflection;
+  REQUIRE(reflection.add_stage(EspShaderStage::VERTEX, code));
+  REQUIRE(reflection.add_stage(EspShaderStage::FRAGMENT, code));
+
+  // the same block in both stages is one range
+  const auto& ranges = reflection.get_push_ranges();
+  REQUIRE(ranges.size() == 1);
+  REQUIRE(ranges[0].m_offset == 0);
+  REQUIRE(ranges[0].m_size == 80);
+  REQUIRE(ranges[0].m_stages == (EspShaderStage::VERTEX | EspShaderStage::FRAGMENT));
+
+  MockUniformMetaData meta_data;
+  REQUIRE(reflection.fill_uniform_meta_data(meta_data));
+  REQUIRE(meta_data.m_calls == std::vector<std::string>{ "set", "texture 2 4", "push 2 0 80" });
+}
+
+TEST_CASE("Shader reflection - invalid code", "[shader_reflection]")
+{
+  SpirvReflection reflection;
+  REQUIRE(!reflection.add_stage(EspShaderStage::VERTEX, {}));
+  REQUIRE(!reflection.add_stage(EspShaderStage::VERTEX, { 1, 2, 3, 4, 5 }));
+
+  // instruction longer than the module
+  auto code = make_push_constant_spirv();
+  code.push_back((100u << 16) | 59);
+  REQUIRE(!reflection.add_stage(EspShaderStage::VERTEX, code));
+}
+
+TEST_CASE("Shader reflection - bindless descriptor set", "[shader_reflection]")
+{
+  SpirvReflection reflection;
+  REQUIRE(reflection.add_stage(EspShaderStage::FRAGMENT, make_bindless_spirv()));
+
+  // bindings of the bindless set are owned by EspBindlessTextures
+  REQUIRE(reflection.get_bindless_sets() == std::vector<uint32_t>{ 1 });
+  REQUIRE(reflection.get_bindings().size() == 1);
+  REQUIRE(reflection.get_bindings()[0].m_set == 0);
+
+  MockUniformMetaData meta_data;
+  REQUIRE(reflection.fill_uniform_meta_data(meta_data));
+  REQUIRE(meta_data.m_calls == std::vector<std::string>{ "set", "texture 1 1", "bindless" });
+}
+
+TEST_CASE("Shader reflection - storage buffers and images", "[shader_reflection]")
+{
+  SpirvReflection reflection;
+  REQUIRE(reflection.add_stage(EspShaderStage::COMPUTE, make_storage_spirv()));
+
+  const auto& bindings = reflection.get_bindings();
+  REQUIRE(bindings.size() == 3);
+  REQUIRE(bindings[0].m_type == EspUniformType::ESP_STORAGE_BUFFER);
+  REQUIRE(bindings[0].m_size == 16);
+  REQUIRE(bindings[0].m_read_only);
+
+  // size of the unsized array isn't known, so the buffer is loaded by the user
+  REQUIRE(bindings[1].m_type == EspUniformType::ESP_STORAGE_BUFFER);
+  REQUIRE(bindings[1].m_size == 0);
+  REQUIRE_FALSE(bindings[1].m_read_only);
+  REQUIRE(bindings[2].m_type == EspUniformType::ESP_STORAGE_IMAGE);
+
+  MockUniformMetaData meta_data;
+  REQUIRE(reflection.fill_uniform_meta_data(meta_data));
+  REQUIRE(meta_data.m_calls == std::vector<std::string>{ "set",
+                                                         "storage buffer 3 16 1 0",
+                                                         "storage buffer 3 0 1 1",
+                                                         "storage image 3 1" });
+}
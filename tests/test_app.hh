@@ -7,7 +7,7 @@
 class TestApp : public esp::EspApplication
 {
  public:
-  TestApp() = default;
+  TestApp(esp::EspApplicationParams params = {}) : esp::EspApplication(std::move(params)) {}
 
   inline static void set_asset_base_path(const fs::path& path) { esp::EspApplication::s_asset_base_path = path; }
 
@@ -16,8 +16,51 @@ class TestApp : public esp::EspApplication
     esp::WindowClosedEvent e;
     events_manager(e);
   }
+
+  // lets tests record work into frames without running the application loop
+  inline void begin_frame() { m_renderer.m_work_orchestrator->begin_frame(); }
+  inline void end_frame() { m_renderer.m_work_orchestrator->end_frame(); }
+  inline void wait_idle() { m_renderer.done_all_jobs(); }
 };
 
+// GPU tests are skipped on machines without a Vulkan driver, lavapipe is enough to run them
+inline bool has_vulkan_device()
+{
+  if (volkInitialize() != VK_SUCCESS) { return false; }
+
+  VkInstanceCreateInfo create_info = {};
+  create_info.sType                = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+#ifdef __APPLE__
+  const char* portability_extension   = VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME;
+  create_info.flags                   = VK_INSTANCE_CREATE_ENUMERATE_PORTABILITY_BIT_KHR;
+  create_info.enabledExtensionCount   = 1;
+  create_info.ppEnabledExtensionNames = &portability_extension;
+#endif /* __APPLE__ */
+
+  VkInstance instance = VK_NULL_HANDLE;
+  if (vkCreateInstance(&create_info, nullptr, &instance) != VK_SUCCESS) { return false; }
+  volkLoadInstance(instance);
+
+  uint32_t device_count = 0;
+  vkEnumeratePhysicalDevices(instance, &device_count, nullptr);
+  vkDestroyInstance(instance, nullptr);
+
+  return device_count > 0;
+}
+
+// headless application for tests recording GPU work themselves
+inline TestApp* create_headless_test_app()
+{
+  TestApp::set_asset_base_path(fs::current_path() / ".." / "tests" / "assets");
+
+  esp::EspApplicationParams params;
+  params.m_headless            = true;
+  params.m_width               = 64;
+  params.m_height              = 64;
+  params.m_pipeline_cache_path = {};
+  return new TestApp(params);
+}
+
 inline esp::EspApplication* esp::create_app_instance()
 {
   TestApp::set_asset_base_path(fs::current_path() / ".." / "tests" / "assets");
@@ -0,0 +1,122 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "Core/RenderAPI/Uniforms/EspUniformArena.hh"
+
+using namespace esp;
+
+namespace
+{
+  class MockUniformArena : public EspUniformArena
+  {
+   public:
+    std::vector<uint8_t> m_memory;
+    bool m_destroyed = false;
+
+    MockUniformArena(uint64_t frame_size, uint64_t alignment, uint32_t frames_in_flight) :
+        EspUniformArena(frame_size, alignment, frames_in_flight), m_memory(get_size())
+    {
+    }
+
+   protected:
+    void write(uint64_t offset, const void* data, uint32_t size) override
+    {
+      std::memcpy(m_memory.data() + offset, data, size);
+    }
+    void destroy() override { m_destroyed = true; }
+  };
+} // namespace
+
+TEST_CASE("Uniform arena - allocations are aligned and bumped", "[uniform_arena]")
+{
+  MockUniformArena arena(1000, 256, 2);
+  REQUIRE(arena.get_size() == 2048);
+
+  uint32_t a = 1, b = 2;
+  REQUIRE(arena.allocate(&a, sizeof(a)) == 0);
+  REQUIRE(arena.allocate(&b, sizeof(b)) == 256);
+
+  uint32_t value;
+  std::memcpy(&value, arena.m_memory.data() + 256, sizeof(value));
+  REQUIRE(value == 2);
+
+  // next frame uses its own region
+  arena.begin_frame(1);
+  REQUIRE(arena.allocate(&a, sizeof(a)) == 1024);
+
+  // region of frame 0 is reused once the frame begins again
+  arena.begin_frame(0);
+  REQUIRE(arena.allocate(&a, sizeof(a)) == 0);
+
+  auto stats = arena.get_stats();
+  REQUIRE(stats.m_allocations == 4);
+  REQUIRE(stats.m_failed_allocations == 0);
+  REQUIRE(stats.m_peak_frame_bytes == 512);
+
+  arena.terminate();
+  REQUIRE(arena.m_destroyed);
+}
+
+TEST_CASE("Uniform arena - full region", "[uniform_arena]")
+{
+  MockUniformArena arena(512, 256, 2);
+
+  char data[300] = {};
+  REQUIRE(arena.allocate(data, 300) == 0);
+  REQUIRE(arena.allocate(data, 300) == EspUniformArena::INVALID_OFFSET);
+  REQUIRE(arena.allocate(data, 1) == EspUniformArena::INVALID_OFFSET);
+  REQUIRE(arena.get_stats().m_failed_allocations == 2);
+  REQUIRE(arena.get_stats().m_peak_frame_bytes == 512);
+
+  arena.begin_frame(1);
+  REQUIRE(arena.allocate(data, 300) == 512);
+}
+
+TEST_CASE("Uniform arena - concurrent allocations don't overlap", "[uniform_arena]")
+{
+  constexpr uint32_t THREADS     = 4;
+  constexpr uint32_t ALLOCATIONS = 256;
+
+  MockUniformArena arena(THREADS * ALLOCATIONS * 64, 64, 2);
+  arena.begin_frame(1);
+
+  std::vector<std::vector<uint32_t>> offsets(THREADS);
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < THREADS; t++)
+  {
+    threads.emplace_back(
+        [&arena, &offsets, t]()
+        {
+          for (uint32_t i = 0; i < ALLOCATIONS; i++)
+          {
+            uint32_t value = t * ALLOCATIONS + i;
+            offsets[t].push_back(arena.allocate(&value, sizeof(value)));
+          }
+        });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  std::set<uint32_t> unique_offsets;
+  for (uint32_t t = 0; t < THREADS; t++)
+  {
+    for (uint32_t i = 0; i < ALLOCATIONS; i++)
+    {
+      auto offset = offsets[t][i];
+      REQUIRE(offset != EspUniformArena::INVALID_OFFSET);
+      REQUIRE(offset % 64 == 0);
+      REQUIRE(offset >= arena.get_size() / 2);
+      unique_offsets.insert(offset);
+
+      uint32_t value;
+      std::memcpy(&value, arena.m_memory.data() + offset, sizeof(value));
+      REQUIRE(value == t * ALLOCATIONS + i);
+    }
+  }
+  REQUIRE(unique_offsets.size() == THREADS * ALLOCATIONS);
+}